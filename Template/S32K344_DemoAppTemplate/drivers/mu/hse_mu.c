@@ -106,15 +106,12 @@ extern "C"
 *                                      LOCAL VARIABLES
 ==================================================================================================*/
 
-/* Stores the last channel a request was sent for each MU instance */
-    static uint8_t u8ChannelRef[HSE_NUM_OF_MU_INSTANCES] = {0U};
-
 /*==================================================================================================
 *                                      GLOBAL CONSTANTS
 ==================================================================================================*/
 
     /* Base addresses for each MU instance */
-    uint32_t u32BaseAddr[HSE_NUM_OF_MU_INSTANCES] = {
+    uintptr_t u32BaseAddr[HSE_NUM_OF_MU_INSTANCES] = {
         MU_INSTANCE0, MU_INSTANCE1,
 #if HSE_NUM_OF_MU_INSTANCES > 2
         MU_INSTANCE2, MU_INSTANCE3
@@ -140,40 +137,6 @@ extern "C"
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
 
-/*************************************************************************************************
-* Description:  Returns the next free channel within the MU instance.
-************************************************************************************************/
-uint8_t HSE_MU_GetFreeChannel(uint8_t u8MuInstance)
-{
-    uint8_t u8Count;
-    uint8_t u8Index = u8ChannelRef[u8MuInstance] + 1U;
-    uint8_t u8Channel = HSE_INVALID_CHANNEL;
-
-    /* Finds the next FREE service channel within the MU instance */
-    /* Skip channel 0 (reserved for administration services) HACK for
-        running the test case on K3. Bogdan will fix this*/
-    for (u8Count = 0U; u8Count < (HSE_NUM_OF_CHANNELS_PER_MU - 2U); u8Count++)
-    {
-        if (IS_SERVICE_CHANNEL_BUSY(u8MuInstance, u8Index))
-        {
-            /* Channel BUSY - increment the channel number cyclicly */
-            if ((++u8Index) >= (HSE_NUM_OF_CHANNELS_PER_MU - 1U))
-            {
-                u8Index = 1U;
-            }
-        }
-        else
-        {
-            /* Channel FREE - store it and return */
-            u8Channel = u8Index;
-            u8ChannelRef[u8MuInstance] = u8Channel - 1U;
-            break;
-        }
-    }
-
-    return u8Channel;
-}
-
 /*************************************************************************************************
 * Description:  Returns the channel status (FREE or BUSY).
 ************************************************************************************************/
@@ -222,7 +185,7 @@ bool_t HSE_MU_SendRequest(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t *pHs
 
     if (!IS_SERVICE_CHANNEL_BUSY(u8MuInstance, u8Channel))
     {
-        HSE_MU_SEND_NON_BLOCKING(u8MuInstance, u8Channel, (uint32_t)pHseSrvDescriptor);
+        HSE_MU_SEND_NON_BLOCKING(u8MuInstance, u8Channel, (uintptr_t)pHseSrvDescriptor);
         bTransmitSuccess = TRUE;
     }
 
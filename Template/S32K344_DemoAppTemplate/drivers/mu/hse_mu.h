@@ -35,6 +35,9 @@ extern "C"{
 
 #include "std_typedefs.h"
 #include "hse_platform.h"
+#ifdef HSE_VIRTUAL
+#include "hse_virtual.h"
+#endif /* HSE_VIRTUAL */
 
 /*==================================================================================================
 *                                     FILE VERSION CHECKS
@@ -72,12 +75,22 @@ extern "C"{
 #define MU_REG_WRITE16(address, value)     ((*(volatile uint16_t*)(address))= (value))
 #define MU_REG_WRITE32(address, value)     ((*(volatile uint32_t*)(address))= (value))
 
+#ifdef HSE_VIRTUAL
+/* Host build: TR/RR/GSR accesses go to the virtual HSE (see hse_virtual.h) */
+#define   HSE_MU_SEND_NON_BLOCKING(u8MuIf, u8Channel, value)        HSE_VirtualMuSend((u8MuIf), (u8Channel), (uintptr_t)(value))
+#define   HSE_MU_RECEIVE_NON_BLOCKING(u8MuIf, u8Channel)            HSE_VirtualMuReceive((u8MuIf), (u8Channel))
+#define   HSE_MU_WRITE_GENERAL_STATUS_REGISTER(u8MuIf, value)       HSE_VirtualMuWriteGsr((u8MuIf), (value))
+#else
 /*  Macro to send a message (write to a specific TR register) on a specific MU interface */
 #define   HSE_MU_SEND_NON_BLOCKING(u8MuIf, u8Channel, value)        (MU_REG_WRITE32 ((u32BaseAddr[(u8MuIf)] + MU_TR_OFFSET + (uint32_t)(u8Channel << 2U)), (value)))
 
 /*  Macro to receive a message (read from a specific RR register) on a specific MU interface */
 #define   HSE_MU_RECEIVE_NON_BLOCKING(u8MuIf, u8Channel)            (MU_REG_READ32 (u32BaseAddr[(u8MuIf)] + MU_RR_OFFSET + (uint32_t)(u8Channel << 2U)))
 
+/*  Macro to write to general status register on a specific MU interface */
+#define   HSE_MU_WRITE_GENERAL_STATUS_REGISTER(u8MuIf, value)       (MU_REG_WRITE32 ((u32BaseAddr[(u8MuIf)] + MU_GSR_OFFSET), (value)))
+#endif /* HSE_VIRTUAL */
+
 /*  Macro to read from the flag status register on a specific MU interface */
 #define   HSE_MU_READ_FLAG_STATUS_REGISTER(u8MuIf)                  (MU_REG_READ32 (u32BaseAddr[(u8MuIf)] + MU_FSR_OFFSET))
 
@@ -90,9 +103,6 @@ extern "C"{
 /*  Macro to read the general status register on a specific MU interface */
 #define   HSE_MU_READ_GENERAL_STATUS_REGISTER(u8MuIf)               (MU_REG_READ32 (u32BaseAddr[(u8MuIf)] + MU_GSR_OFFSET))
 
-/*  Macro to write to general status register on a specific MU interface */
-#define   HSE_MU_WRITE_GENERAL_STATUS_REGISTER(u8MuIf, value)       (MU_REG_WRITE32 ((u32BaseAddr[(u8MuIf)] + MU_GSR_OFFSET), (value)))
-
 /* Check whether a HSE status is set */
 #define CHECK_HSE_STATUS(hseStatus) ((hseStatus) == ((hseStatus) & HSE_MU_GetHseStatus(0U)))
 /*==================================================================================================
@@ -122,7 +132,7 @@ typedef enum
 *                                GLOBAL VARIABLE DECLARATIONS
 ==================================================================================================*/
 
-extern uint32_t u32BaseAddr[HSE_NUM_OF_MU_INSTANCES];
+extern uintptr_t u32BaseAddr[HSE_NUM_OF_MU_INSTANCES];
 /* Log the RX interrupts enablement status: Enabled/Disabled */
 extern volatile uint32_t muRxEnabledInterruptMask[HSE_NUM_OF_MU_INSTANCES];
 
@@ -167,18 +177,6 @@ void HSE_MU_SetGeneralStatusReg( uint8_t u8MuInstance, uint32_t u32Mask );
 *                                    FUNCTION PROTOTYPES
 ==================================================================================================*/
 
-/**
-* @brief        Get a free channel.
-* @details      Returns the next free service channel (ch) available in the selected MU instance (MU).
-*               NOTE: Channel 0 is not returned by this function (it is reserved for administrative services).
-*
-* @param[in]    u8MuInstance        The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
-*
-* @return       The index of the free channel (ch): 1 <= ch <= HSE_NUM_OF_CHANNELS_PER_MU.
-*               In case no free channel is available returns HSE_INVALID_CHANNEL.
-*/
-uint8_t HSE_MU_GetFreeChannel( uint8_t u8MuInstance );
-
 /**
 * @brief        Get the channel status.
 * @details      Returns the status (busy / free) of the specified service channel (ch) from MU instance (MU).
@@ -109,6 +109,23 @@ void NVIC_DisableIRQ(uint8 IRQn)
     #endif
 }
 
+/*================================================================================================*/
+/** 
+* @brief Clear Pending External Interrupt
+* @details The function clears the pending bit of a device-specific interrupt in the NVIC interrupt controller
+*/
+/*================================================================================================*/
+void NVIC_ClearPendingIRQ(uint8 IRQn)
+{
+    #ifdef MCAL_ENABLE_USER_MODE_SUPPORT
+        Mcal_goToSupervisor();
+    #endif
+        REG_WRITE32((NVIC_BASEADDR + NVIC_ICPR_OFFSET(IRQn)), 1 << (IRQn % 32));
+    #ifdef MCAL_ENABLE_USER_MODE_SUPPORT
+        Mcal_goToUser();
+    #endif
+}
+
 /*================================================================================================*/
 /** 
 * @brief Set Interrupt Priority
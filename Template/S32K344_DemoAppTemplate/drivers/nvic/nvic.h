@@ -49,6 +49,7 @@ extern "C"
 #define NVIC_BASEADDR 0xE000E100
 #define NVIC_ISER_OFFSET(id) (uint8)((id >> 5) << 2)
 #define NVIC_ICER_OFFSET(id) (0x80 + (uint8)((id >> 5) << 2))
+#define NVIC_ICPR_OFFSET(id) (0x180 + (uint8)((id >> 5) << 2))
 #define NVIC_IPRO_OFFSET(id) (0x300 + (uint8)((id >> 2) << 2))
 #define NVIC_IPRO_MASK(id) (uint32)(0xFF << ((id % 4)*8))
 
@@ -61,6 +62,7 @@ extern "C"
 #define S32_SCB_AIRCR_PRIGROUP_MASK              (0x700UL)
 #define S32_SCB_AIRCR_PRIGROUP_SHIFT             (8U)
 
+#define S32_SCB_SCR_SEVONPEND_MASK               (0x10UL)
 #define S32_SCB_SHPR3_PRI_14_MASK                (0xFF0000UL)
 /*==================================================================================================
 *                                             TYPEDEFS
@@ -106,6 +108,7 @@ volatile    uint32 FPDSCR;                            /**< Floating-point Defaul
 void NVIC_SetPriorityGrouping(uint32 PriorityGroup);
 void NVIC_EnableIRQ(uint8 IRQn);
 void NVIC_DisableIRQ(uint8 IRQn);
+void NVIC_ClearPendingIRQ(uint8 IRQn);
 void NVIC_SetPriority(uint8 IRQn, uint8 priority);
 
 
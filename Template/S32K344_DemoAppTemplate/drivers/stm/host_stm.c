@@ -39,6 +39,13 @@
 #define STM_CR_DISABLE (0x0)     /* Disable STM */
 
 #define STM_CR_CPS_SHIFT (8U)
+
+/* STM Channel Control/Interrupt Register */
+#define STM_CCR_CEN_ENABLE (0x1U) /* Enable channel compare */
+#define STM_CIR_CIF_CLEAR (0x1U)  /* Clear channel interrupt flag (w1c) */
+
+/* Prescaler for a 1 MHz time base: input clock is divided by CPS + 1 */
+#define STM_TIMEBASE_CPS (AIPS_PLAT_CLOCK_PLL_48MHZ - 1U)
 /******************************************************************************
  * Local Typedefs (Structures, Unions, Enums)
  *****************************************************************************/
@@ -203,4 +210,92 @@ void DelayStm(uint32_t delay)
     DisbleStm();
 }
 
+/******************************************************************************
+ * FUNCTION:        EnableStmTimebase
+ *
+ * DESCRIPTION:
+ *   This function starts STM_1 as free running microseconds time base.
+ *   The counter is not reset if the time base is already running.
+ *
+ * Parameters:
+ *      None
+ *
+ * RETURN VALUE:    None
+ *
+ * NOTES:           None
+ *
+ *****************************************************************************/
+void EnableStmTimebase(void)
+{
+    vuint32_t *stmBaseAddr = (vuint32_t *)(STM_1_CR_ADDRESS);
+
+    if (0U == (*stmBaseAddr & STM_CR_TEN_ENABLE))
+    {
+        *stmBaseAddr = (uint32_t)(STM_CR_TEN_ENABLE | STM_CR_FRZ_ENABLE | (STM_TIMEBASE_CPS << STM_CR_CPS_SHIFT));
+    }
+}
+
+/******************************************************************************
+ * FUNCTION:        GetStmTimebaseUs
+ *
+ * DESCRIPTION:
+ *   This function returns the current value of the microseconds time base
+ *
+ * Parameters:
+ *      None
+ *
+ * RETURN VALUE:    The time base counter (wraps around every ~71 minutes)
+ *
+ * NOTES:           EnableStmTimebase must be called first
+ *
+ *****************************************************************************/
+uint32_t GetStmTimebaseUs(void)
+{
+    return (vuint32_t) * ((vuint32_t *)STM_1_CNT_ADDRESS);
+}
+
+/******************************************************************************
+ * FUNCTION:        SetStmTimebaseAlarm
+ *
+ * DESCRIPTION:
+ *   This function arms the channel 0 compare of the time base. The STM_1
+ *   interrupt becomes pending when the delay expires.
+ *
+ * Parameters:
+ *      delayUs: delay in microseconds
+ *
+ * RETURN VALUE:    None
+ *
+ * NOTES:           None
+ *
+ *****************************************************************************/
+void SetStmTimebaseAlarm(uint32_t delayUs)
+{
+    *((vuint32_t *)STM_1_CH0_CCR_ADDRESS) = 0U;
+    *((vuint32_t *)STM_1_CH0_CIR_ADDRESS) = STM_CIR_CIF_CLEAR;
+    *((vuint32_t *)STM_1_CH0_CMP_ADDRESS) = GetStmTimebaseUs() + delayUs;
+    *((vuint32_t *)STM_1_CH0_CCR_ADDRESS) = STM_CCR_CEN_ENABLE;
+}
+
+/******************************************************************************
+ * FUNCTION:        ClearStmTimebaseAlarm
+ *
+ * DESCRIPTION:
+ *   This function disarms the channel 0 compare of the time base and clears
+ *   the channel interrupt flag.
+ *
+ * Parameters:
+ *      None
+ *
+ * RETURN VALUE:    None
+ *
+ * NOTES:           None
+ *
+ *****************************************************************************/
+void ClearStmTimebaseAlarm(void)
+{
+    *((vuint32_t *)STM_1_CH0_CCR_ADDRESS) = 0U;
+    *((vuint32_t *)STM_1_CH0_CIR_ADDRESS) = STM_CIR_CIF_CLEAR;
+}
+
 /*LDRA_ANALYSIS*/
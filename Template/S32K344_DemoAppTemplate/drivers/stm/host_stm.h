@@ -44,6 +44,14 @@
 #define STM_0_CR_ADDRESS            (0x40274000U)
 #define STM_0_CNT_ADDRESS           (0x40274004U)
 
+/* STM_1 is used as free running microseconds time base (not reset by DelayStm) */
+#define STM_1_CR_ADDRESS            (0x40474000U)
+#define STM_1_CNT_ADDRESS           (0x40474004U)
+#define STM_1_CH0_CCR_ADDRESS       (0x40474010U)
+#define STM_1_CH0_CIR_ADDRESS       (0x40474014U)
+#define STM_1_CH0_CMP_ADDRESS       (0x40474018U)
+#define STM_1_IRQ_ID                (40U)
+
 /* FIRC DIV 1 @ 48 MHz */
 #define AIPS_PLAT_CLOCK_PLL_48MHZ  (48U)
 #define FIRC_DIV_1_DELAY_1USEC     (AIPS_PLAT_CLOCK_PLL_48MHZ)
@@ -87,6 +95,18 @@ extern uint32_t GetTimer(void);
 extern void EnableStmDiv(uint32_t divide);
 extern void DelayStm(uint32_t delay);
 
+/* This function starts the free running microseconds time base (STM_1), if not already running */
+extern void EnableStmTimebase(void);
+
+/* This function returns the current value of the microseconds time base */
+extern uint32_t GetStmTimebaseUs(void);
+
+/* This function arms the time base compare to expire in the given number of microseconds */
+extern void SetStmTimebaseAlarm(uint32_t delayUs);
+
+/* This function disarms the time base compare and clears its pending flag */
+extern void ClearStmTimebaseAlarm(void);
+
 
 
 #endif /* HSE__STM_H */
@@ -0,0 +1,223 @@
+/**
+*   @file    hse_virtual.h
+*
+*   @version 1.0.0
+*   @brief   Virtual HSE (software emulated HSE for Linux host builds).
+*   @details The MU registers of each instance are emulated in RAM and served by a device thread
+*            that decodes the service descriptors and executes the common services in software
+*            (OpenSSL libcrypto). The framework and the demo services are built unchanged for
+*            x86-64 with HSE_VIRTUAL defined; this unit also replaces the target only drivers
+*            (interrupt masking, STM timers, NVIC).
+*
+*            Host build: CMakeLists.txt of the project (library hse_virtual, tests of test/).
+*            It compiles the sources of drivers/virtual_hse, drivers/mu, framework and services
+*            (without src/target, drivers/stm and drivers/nvic) with
+*            -DHSE_VIRTUAL -DHSE_SPT_64BIT_ADDR and links with -lcrypto -lpthread.
+*
+*            HSE_SPT_64BIT_ADDR makes HOST_ADDR 64-bit wide, so the host pointers fit in the
+*            descriptors; both sides are built from the same interface headers.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_VIRTUAL_H
+#define HSE_VIRTUAL_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual.h
+*/
+#include "hse_interface.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+#if defined(HSE_VIRTUAL) && !defined(HSE_SPT_64BIT_ADDR)
+    #error "The virtual HSE needs HSE_SPT_64BIT_ADDR (host pointers are 64-bit)"
+#endif
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Size of the emulated register block of a MU instance (covers TR/RR) */
+#define HSE_VIRTUAL_MU_REG_SIZE         (0x300U)
+
+/* Maximum number of services with a latency model */
+#define HSE_VIRTUAL_MAX_LATENCY_ENTRIES (32U)
+
+/* Use as service ID to set the latency of all services without an own entry */
+#define HSE_VIRTUAL_SRV_ID_DEFAULT      ((hseSrvId_t)0xFFFFFFFFUL)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Start the virtual HSE.
+* @details      Maps the MU instances on the emulated registers, reports HSE_STATUS_INIT_OK,
+*               HSE_STATUS_RNG_INIT_OK and HSE_STATUS_CUST_SUPER_USER (CUST_DEL life cycle) and starts
+*               the device thread. HSE_STATUS_INSTALL_OK is reported once the key catalogs are formatted.
+*               Must be called before any HSE request is sent.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_GENERAL_ERROR if the device thread could not be started.
+*/
+hseSrvResponse_t HSE_VirtualInit(void);
+
+/**
+* @brief        Stop the virtual HSE.
+* @details      Stops the device thread. Requests still queued are not executed.
+*
+* @return       NULL
+*/
+void HSE_VirtualDeinit(void);
+
+/**
+* @brief        Set the latency model of a service.
+* @details      The device thread takes (u32FixedUs + inputLength * u32NsPerByte / 1000) microseconds
+*               to execute a request of the service (added to the real software execution time).
+*               A HSE_SRV_ID_CANCEL of the request sent on channel 0 meanwhile ends it (HSE_SRV_RSP_CANCELED).
+*
+* @param[in]    srvId           The service ID, or HSE_VIRTUAL_SRV_ID_DEFAULT for all other services.
+* @param[in]    u32FixedUs      Fixed cost per request (microseconds).
+* @param[in]    u32NsPerByte    Cost per input byte (nanoseconds).
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_NOT_ENOUGH_SPACE if the latency table is full.
+*/
+hseSrvResponse_t HSE_VirtualSetLatency(hseSrvId_t srvId, uint32_t u32FixedUs, uint32_t u32NsPerByte);
+
+/**
+* @brief        Force the response of the next requests of a service.
+* @details      The next u32Count requests of the service are answered with srvResponse without
+*               being executed (error paths of the host code). A new call replaces the previous one,
+*               u32Count = 0 stops the injection.
+*
+* @param[in]    srvId           The service ID.
+* @param[in]    srvResponse     The response to report.
+* @param[in]    u32Count        Number of requests.
+*
+* @return       NULL
+*/
+void HSE_VirtualInjectResponse(hseSrvId_t srvId, hseSrvResponse_t srvResponse, uint32_t u32Count);
+
+/**
+* @brief        Change the HSE status reported in FSR.
+* @details      Used by the emulated services (key catalogs formatting, SYS authorization).
+*
+* @param[in]    setMask         The status bits to set.
+* @param[in]    clearMask       The status bits to clear.
+*
+* @return       NULL
+*/
+void HSE_VirtualSetStatus(hseStatus_t setMask, hseStatus_t clearMask);
+
+/**
+* @brief        Read the HSE status reported in FSR.
+*
+* @return       The HSE status.
+*/
+hseStatus_t HSE_VirtualGetStatus(void);
+
+/**
+* @brief        Write a transmit register (request).
+* @details      Used by HSE_MU_SEND_NON_BLOCKING in virtual builds.
+*
+* @param[in]    u8MuInstance    The MU instance.
+* @param[in]    u8Channel       The channel.
+* @param[in]    descAddr        The address of the service descriptor.
+*
+* @return       NULL
+*/
+void HSE_VirtualMuSend(uint8_t u8MuInstance, uint8_t u8Channel, uintptr_t descAddr);
+
+/**
+* @brief        Read a receive register (response).
+* @details      Used by HSE_MU_RECEIVE_NON_BLOCKING in virtual builds; clears the RSR bit of the channel.
+*
+* @param[in]    u8MuInstance    The MU instance.
+* @param[in]    u8Channel       The channel.
+*
+* @return       The response.
+*/
+uint32_t HSE_VirtualMuReceive(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Write the general status register (write 1 to clear).
+*
+* @param[in]    u8MuInstance    The MU instance.
+* @param[in]    u32Value        The bits to clear.
+*
+* @return       NULL
+*/
+void HSE_VirtualMuWriteGsr(uint8_t u8MuInstance, uint32_t u32Value);
+
+/**
+* @brief        Execute a service request (device thread).
+* @details      Implemented in hse_virtual_srv.c. The steps of a stream must be sent on the channel
+*               of its START, otherwise they are rejected with HSE_SRV_RSP_STREAMING_MODE_FAILURE.
+*
+* @param[in]    u8MuInstance    The MU instance the request was sent on (streaming contexts are per MU).
+* @param[in]    u8Channel       The channel the request was sent on.
+* @param[in]    pSrvDesc        The service descriptor.
+*
+* @return       The HSE response.
+*/
+hseSrvResponse_t HSE_VirtualExecute(uint8_t u8MuInstance, uint8_t u8Channel, const hseSrvDescriptor_t* pSrvDesc);
+
+/**
+* @brief        Input length of a request, used by the latency model.
+*
+* @param[in]    pSrvDesc        The service descriptor.
+*
+* @return       The number of input bytes processed by the request.
+*/
+uint32_t HSE_VirtualInputLength(const hseSrvDescriptor_t* pSrvDesc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_VIRTUAL_H */
+
+/** @} */
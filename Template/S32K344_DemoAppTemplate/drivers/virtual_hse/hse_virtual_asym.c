@@ -0,0 +1,1380 @@
+/**
+*   @file    hse_virtual_asym.c
+*
+*   @brief   Virtual HSE - asymmetric services and system authorization.
+*   @details KEY_GENERATE (random symmetric key, ECC and RSA key pairs), DH_COMPUTE_SHARED_SECRET
+*            (ECDH, X25519), LOAD_ECC_CURVE, BURMESTER_DESMEDT, SIGN (ECDSA, RSASSA-PSS,
+*            RSASSA-PKCS1-v1.5 and pure Ed25519) and SYS_AUTH_REQ/RESP with OpenSSL libcrypto.
+*            ECDSA is computed on the curve group, so the user curves are supported as well.
+*            SIGN runs in streaming mode except for EdDSA; the UPDATE/FINISH steps must be sent
+*            on the channel of the START.
+*
+*   @addtogroup hse_virtual_srv_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_asym.c
+*/
+#include <string.h>
+#include <openssl/bn.h>
+#include <openssl/core_names.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/param_build.h>
+#include <openssl/rand.h>
+#include <openssl/rsa.h>
+#include "hse_virtual_srv.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_VIRTUAL_MAX_COORD_LEN       (66U)   /* secp521r1 */
+#define HSE_VIRTUAL_25519_LEN           (32U)   /* Ed25519 and X25519 keys, half of an Ed25519 signature */
+#define HSE_VIRTUAL_USER_CURVES         (3U)
+
+/* Challenge of a SHE MASTER_ECU_KEY owner (RAND || UID) */
+#define HSE_VIRTUAL_SHE_CHALLENGE_LEN   (HSE_SYS_AUTH_CHALLENGE_LENGTH - 1UL)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Curve loaded with LOAD_ECC_CURVE
+ */
+typedef struct
+{
+    bool_t      bLoaded;
+    uint32_t    u32PLen;                                /* Bytes of p, a, b and of a coordinate of G */
+    uint32_t    u32NLen;                                /* Bytes of n */
+    uint8_t     p[HSE_VIRTUAL_MAX_COORD_LEN];
+    uint8_t     a[HSE_VIRTUAL_MAX_COORD_LEN];
+    uint8_t     b[HSE_VIRTUAL_MAX_COORD_LEN];
+    uint8_t     n[HSE_VIRTUAL_MAX_COORD_LEN];
+    uint8_t     g[2U * HSE_VIRTUAL_MAX_COORD_LEN];      /* x || y */
+} hseVirtualCurve_t;
+
+/*
+ * @brief   ECC key of the key store in OpenSSL form
+ */
+typedef struct
+{
+    EC_GROUP*   pGroup;
+    EC_POINT*   pPub;
+    BIGNUM*     pPriv;                                  /* NULL for a public key */
+    uint32_t    u32CoordLen;
+} hseVirtualEcKey_t;
+
+/*
+ * @brief   Pending system authorization (SYS_AUTH_REQ answered, waiting for SYS_AUTH_RESP)
+ */
+typedef struct
+{
+    bool_t          bPending;
+    hseKeyHandle_t  ownerKeyHandle;
+    hseKeyType_t    ownerKeyType;
+    hseAuthScheme_t authScheme;
+    uint32_t        u32ChallengeLen;
+    uint8_t         challenge[HSE_SYS_AUTH_CHALLENGE_LENGTH];
+} hseVirtualAuth_t;
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseVirtualCurve_t    virtualCurves[HSE_VIRTUAL_USER_CURVES];
+static hseVirtualAuth_t     virtualAuth;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static EC_GROUP* HSE_VirtualEcGroup(hseEccCurveId_t eccCurveId);
+static EC_POINT* HSE_VirtualEcPoint(const EC_GROUP* pGroup, const uint8_t* pRaw, uint32_t u32RawLen);
+static uint32_t HSE_VirtualEcRaw(const EC_GROUP* pGroup, const EC_POINT* pPoint, uint8_t* pRaw);
+static hseSrvResponse_t HSE_VirtualEcKeyLoad(hseKeyHandle_t keyHandle, bool_t bPrivate, hseVirtualEcKey_t* pEcKey);
+static void HSE_VirtualEcKeyFree(hseVirtualEcKey_t* pEcKey);
+static EVP_PKEY* HSE_VirtualRawKey(const hseVirtualKey_t* pKey, int keyId, bool_t bPrivate);
+static EVP_PKEY* HSE_VirtualRsaKey(const hseVirtualKey_t* pKey, bool_t bPrivate);
+static void HSE_VirtualStoreSecret(hseVirtualKey_t* pKey, const uint8_t* pSecret, uint32_t u32SecretLen);
+static hseSrvResponse_t HSE_VirtualEccGenerate(hseVirtualKey_t* pKey, HOST_ADDR pPubKey);
+static hseSrvResponse_t HSE_VirtualRsaGenerate(hseVirtualKey_t* pKey, const hseKeyGenRsaScheme_t* pRsaScheme);
+static hseHashAlgo_t HSE_VirtualSignHashAlgo(const hseSignScheme_t* pScheme);
+static hseSrvResponse_t HSE_VirtualEcdsa(hseKeyHandle_t keyHandle, hseAuthDir_t authDir, const uint8_t* pDigest,
+    uint32_t u32DigestLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2]);
+static hseSrvResponse_t HSE_VirtualRsaSign(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, const uint8_t* pDigest, uint32_t u32DigestLen, uint8_t* pSig, uint32_t* pu32SigLen);
+static hseSrvResponse_t HSE_VirtualEddsa(hseKeyHandle_t keyHandle, hseAuthDir_t authDir, const uint8_t* pInput,
+    uint32_t u32InputLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2]);
+static hseSrvResponse_t HSE_VirtualSignDigest(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, const uint8_t* pDigest, uint32_t u32DigestLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2]);
+static hseSrvResponse_t HSE_VirtualSignInput(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, bool_t bInputIsHashed, const uint8_t* pInput, uint32_t u32InputLen,
+    uint8_t* pSig[2], uint32_t* pu32SigLen[2]);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Group of a standard or loaded user curve (NULL if unknown).
+ ******************************************************************************/
+static EC_GROUP* HSE_VirtualEcGroup(hseEccCurveId_t eccCurveId)
+{
+    const hseVirtualCurve_t* pCurve;
+    BIGNUM* pP = NULL;
+    BIGNUM* pA = NULL;
+    BIGNUM* pB = NULL;
+    BIGNUM* pN = NULL;
+    EC_GROUP* pGroup = NULL;
+    EC_POINT* pG = NULL;
+
+    switch(eccCurveId)
+    {
+        case HSE_EC_SEC_SECP256R1:              return EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+        case HSE_EC_SEC_SECP384R1:              return EC_GROUP_new_by_curve_name(NID_secp384r1);
+        case HSE_EC_SEC_SECP521R1:              return EC_GROUP_new_by_curve_name(NID_secp521r1);
+        case HSE_EC_BRAINPOOL_BRAINPOOLP256R1:  return EC_GROUP_new_by_curve_name(NID_brainpoolP256r1);
+        case HSE_EC_BRAINPOOL_BRAINPOOLP320R1:  return EC_GROUP_new_by_curve_name(NID_brainpoolP320r1);
+        case HSE_EC_BRAINPOOL_BRAINPOOLP384R1:  return EC_GROUP_new_by_curve_name(NID_brainpoolP384r1);
+        case HSE_EC_BRAINPOOL_BRAINPOOLP512R1:  return EC_GROUP_new_by_curve_name(NID_brainpoolP512r1);
+        case HSE_EC_USER_CURVE1:
+        case HSE_EC_USER_CURVE2:
+        case HSE_EC_USER_CURVE3:
+            break;
+        default:
+            return NULL;
+    }
+
+    pCurve = &virtualCurves[eccCurveId - HSE_EC_USER_CURVE1];
+    if(!pCurve->bLoaded)
+    {
+        return NULL;
+    }
+
+    pP = BN_bin2bn(pCurve->p, (int)pCurve->u32PLen, NULL);
+    pA = BN_bin2bn(pCurve->a, (int)pCurve->u32PLen, NULL);
+    pB = BN_bin2bn(pCurve->b, (int)pCurve->u32PLen, NULL);
+    pN = BN_bin2bn(pCurve->n, (int)pCurve->u32NLen, NULL);
+    if((NULL == pP) || (NULL == pA) || (NULL == pB) || (NULL == pN))
+    {
+        goto exit;
+    }
+    pGroup = EC_GROUP_new_curve_GFp(pP, pA, pB, NULL);
+    if(NULL == pGroup)
+    {
+        goto exit;
+    }
+    pG = HSE_VirtualEcPoint(pGroup, pCurve->g, 2UL * pCurve->u32PLen);
+    if((NULL == pG) || (1 != EC_GROUP_set_generator(pGroup, pG, pN, BN_value_one())))
+    {
+        EC_GROUP_free(pGroup);
+        pGroup = NULL;
+    }
+exit:
+    EC_POINT_free(pG);
+    BN_free(pP);
+    BN_free(pA);
+    BN_free(pB);
+    BN_free(pN);
+    return pGroup;
+}
+
+/*******************************************************************************
+ * Description   : Curve point of a raw (x || y) public key, checked to be on the curve.
+ ******************************************************************************/
+static EC_POINT* HSE_VirtualEcPoint(const EC_GROUP* pGroup, const uint8_t* pRaw, uint32_t u32RawLen)
+{
+    uint8_t oct[1U + (2U * HSE_VIRTUAL_MAX_COORD_LEN)];
+    uint32_t u32CoordLen = ((uint32_t)EC_GROUP_get_degree(pGroup) + 7UL) / 8UL;
+    EC_POINT* pPoint;
+
+    if((u32RawLen != (2UL * u32CoordLen)) || (u32CoordLen > HSE_VIRTUAL_MAX_COORD_LEN))
+    {
+        return NULL;
+    }
+
+    oct[0] = 0x04U;
+    memcpy(&oct[1], pRaw, u32RawLen);
+    pPoint = EC_POINT_new(pGroup);
+    if((NULL != pPoint) && (1 != EC_POINT_oct2point(pGroup, pPoint, oct, u32RawLen + 1UL, NULL)))
+    {
+        EC_POINT_free(pPoint);
+        pPoint = NULL;
+    }
+    return pPoint;
+}
+
+/*******************************************************************************
+ * Description   : Raw (x || y) value of a curve point; 0 for the point at infinity.
+ ******************************************************************************/
+static uint32_t HSE_VirtualEcRaw(const EC_GROUP* pGroup, const EC_POINT* pPoint, uint8_t* pRaw)
+{
+    uint8_t oct[1U + (2U * HSE_VIRTUAL_MAX_COORD_LEN)];
+    size_t octLen;
+
+    octLen = EC_POINT_point2oct(pGroup, pPoint, POINT_CONVERSION_UNCOMPRESSED, oct, sizeof(oct), NULL);
+    if(octLen < 3U)
+    {
+        return 0UL;
+    }
+    memcpy(pRaw, &oct[1], octLen - 1U);
+    return (uint32_t)(octLen - 1U);
+}
+
+/*******************************************************************************
+ * Description   : ECC key of a key handle. The public point of a key pair imported
+ *                 without it is computed from the private scalar.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualEcKeyLoad(hseKeyHandle_t keyHandle, bool_t bPrivate, hseVirtualEcKey_t* pEcKey)
+{
+    const hseVirtualKey_t* pKey = HSE_VirtualFindKey(keyHandle);
+
+    memset(pEcKey, 0, sizeof(hseVirtualEcKey_t));
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(((HSE_KEY_TYPE_ECC_PAIR != pKey->keyInfo.keyType) && (HSE_KEY_TYPE_ECC_PUB != pKey->keyInfo.keyType)) ||
+       (bPrivate && ((HSE_KEY_TYPE_ECC_PAIR != pKey->keyInfo.keyType) || (0U == pKey->keyLen[HSE_VIRTUAL_SYM_KEY]))))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    pEcKey->pGroup = HSE_VirtualEcGroup(pKey->keyInfo.specific.eccCurveId);
+    if(NULL == pEcKey->pGroup)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+    pEcKey->u32CoordLen = ((uint32_t)EC_GROUP_get_degree(pEcKey->pGroup) + 7UL) / 8UL;
+
+    if(0U != pKey->keyLen[HSE_VIRTUAL_SYM_KEY])
+    {
+        pEcKey->pPriv = BN_bin2bn(pKey->key[HSE_VIRTUAL_SYM_KEY], (int)pKey->keyLen[HSE_VIRTUAL_SYM_KEY], NULL);
+    }
+    if(0U != pKey->keyLen[HSE_VIRTUAL_PUB_KEY])
+    {
+        pEcKey->pPub = HSE_VirtualEcPoint(pEcKey->pGroup, pKey->key[HSE_VIRTUAL_PUB_KEY],
+                                          pKey->keyLen[HSE_VIRTUAL_PUB_KEY]);
+    }
+    else if(NULL != pEcKey->pPriv)
+    {
+        pEcKey->pPub = EC_POINT_new(pEcKey->pGroup);
+        if((NULL != pEcKey->pPub) &&
+           (1 != EC_POINT_mul(pEcKey->pGroup, pEcKey->pPub, pEcKey->pPriv, NULL, NULL, NULL)))
+        {
+            EC_POINT_free(pEcKey->pPub);
+            pEcKey->pPub = NULL;
+        }
+    }
+
+    if((NULL == pEcKey->pPub) || (bPrivate && (NULL == pEcKey->pPriv)))
+    {
+        HSE_VirtualEcKeyFree(pEcKey);
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Release an ECC key loaded with HSE_VirtualEcKeyLoad.
+ ******************************************************************************/
+static void HSE_VirtualEcKeyFree(hseVirtualEcKey_t* pEcKey)
+{
+    BN_clear_free(pEcKey->pPriv);
+    EC_POINT_free(pEcKey->pPub);
+    EC_GROUP_free(pEcKey->pGroup);
+    memset(pEcKey, 0, sizeof(hseVirtualEcKey_t));
+}
+
+/*******************************************************************************
+ * Description   : Ed25519/X25519 key of the key store (raw values).
+ ******************************************************************************/
+static EVP_PKEY* HSE_VirtualRawKey(const hseVirtualKey_t* pKey, int keyId, bool_t bPrivate)
+{
+    if(bPrivate)
+    {
+        return (HSE_VIRTUAL_25519_LEN == pKey->keyLen[HSE_VIRTUAL_SYM_KEY]) ?
+            EVP_PKEY_new_raw_private_key(keyId, NULL, pKey->key[HSE_VIRTUAL_SYM_KEY], HSE_VIRTUAL_25519_LEN) : NULL;
+    }
+    return (HSE_VIRTUAL_25519_LEN == pKey->keyLen[HSE_VIRTUAL_PUB_KEY]) ?
+        EVP_PKEY_new_raw_public_key(keyId, NULL, pKey->key[HSE_VIRTUAL_PUB_KEY], HSE_VIRTUAL_25519_LEN) : NULL;
+}
+
+/*******************************************************************************
+ * Description   : RSA key of the key store (n, e and d for a private key).
+ ******************************************************************************/
+static EVP_PKEY* HSE_VirtualRsaKey(const hseVirtualKey_t* pKey, bool_t bPrivate)
+{
+    OSSL_PARAM_BLD* pBld = OSSL_PARAM_BLD_new();
+    OSSL_PARAM* pParams = NULL;
+    EVP_PKEY_CTX* pCtx = NULL;
+    EVP_PKEY* pPKey = NULL;
+    BIGNUM* pN;
+    BIGNUM* pE;
+    BIGNUM* pD = NULL;
+
+    pN = BN_bin2bn(pKey->key[HSE_VIRTUAL_PUB_KEY], (int)pKey->keyLen[HSE_VIRTUAL_PUB_KEY], NULL);
+    pE = BN_bin2bn(pKey->key[HSE_VIRTUAL_RSA_EXP], (int)pKey->keyLen[HSE_VIRTUAL_RSA_EXP], NULL);
+    if(bPrivate)
+    {
+        pD = BN_bin2bn(pKey->key[HSE_VIRTUAL_SYM_KEY], (int)pKey->keyLen[HSE_VIRTUAL_SYM_KEY], NULL);
+    }
+    if((NULL == pBld) || (NULL == pN) || (NULL == pE) || (bPrivate && (NULL == pD)) ||
+       (1 != OSSL_PARAM_BLD_push_BN(pBld, OSSL_PKEY_PARAM_RSA_N, pN)) ||
+       (1 != OSSL_PARAM_BLD_push_BN(pBld, OSSL_PKEY_PARAM_RSA_E, pE)) ||
+       (bPrivate && (1 != OSSL_PARAM_BLD_push_BN(pBld, OSSL_PKEY_PARAM_RSA_D, pD))))
+    {
+        goto exit;
+    }
+
+    pParams = OSSL_PARAM_BLD_to_param(pBld);
+    pCtx = EVP_PKEY_CTX_new_from_name(NULL, "RSA", NULL);
+    if((NULL == pParams) || (NULL == pCtx) || (1 != EVP_PKEY_fromdata_init(pCtx)) ||
+       (1 != EVP_PKEY_fromdata(pCtx, &pPKey, bPrivate ? EVP_PKEY_KEYPAIR : EVP_PKEY_PUBLIC_KEY, pParams)))
+    {
+        pPKey = NULL;
+    }
+exit:
+    EVP_PKEY_CTX_free(pCtx);
+    OSSL_PARAM_free(pParams);
+    OSSL_PARAM_BLD_free(pBld);
+    BN_free(pN);
+    BN_free(pE);
+    BN_clear_free(pD);
+    return pPKey;
+}
+
+/*******************************************************************************
+ * Description   : Store a computed shared secret (usable for key derivation only).
+ ******************************************************************************/
+static void HSE_VirtualStoreSecret(hseVirtualKey_t* pKey, const uint8_t* pSecret, uint32_t u32SecretLen)
+{
+    pKey->keyInfo.keyType = HSE_KEY_TYPE_SHARED_SECRET;
+    pKey->keyInfo.keyFlags = HSE_KF_USAGE_DERIVE;
+    pKey->keyInfo.keyBitLen = (hseKeyBits_t)(u32SecretLen * 8UL);
+    pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)u32SecretLen;
+    memcpy(pKey->key[HSE_VIRTUAL_SYM_KEY], pSecret, u32SecretLen);
+}
+
+/*******************************************************************************
+ * Description   : ECC key pair generation; the public key is also written to
+ *                 pPubKey (x || y, or the 32 bytes of an Ed25519 key) if not NULL.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualEccGenerate(hseVirtualKey_t* pKey, HOST_ADDR pPubKey)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    EVP_PKEY* pPKey = NULL;
+    EC_GROUP* pGroup = NULL;
+    EC_POINT* pPub = NULL;
+    BIGNUM* pPriv = NULL;
+    size_t len;
+
+    if(HSE_EC_25519_ED25519 == pKey->keyInfo.specific.eccCurveId)
+    {
+        pPKey = EVP_PKEY_Q_keygen(NULL, NULL, "ED25519");
+        len = HSE_VIRTUAL_25519_LEN;
+        if((NULL == pPKey) ||
+           (1 != EVP_PKEY_get_raw_public_key(pPKey, pKey->key[HSE_VIRTUAL_PUB_KEY], &len)) ||
+           (1 != EVP_PKEY_get_raw_private_key(pPKey, pKey->key[HSE_VIRTUAL_SYM_KEY], &len)))
+        {
+            goto exit;
+        }
+        pKey->keyLen[HSE_VIRTUAL_PUB_KEY] = HSE_VIRTUAL_25519_LEN;
+        pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = HSE_VIRTUAL_25519_LEN;
+    }
+    else
+    {
+        pGroup = HSE_VirtualEcGroup(pKey->keyInfo.specific.eccCurveId);
+        if(NULL == pGroup)
+        {
+            srvResponse = HSE_SRV_RSP_NOT_SUPPORTED;
+            goto exit;
+        }
+        pPriv = BN_secure_new();
+        pPub = EC_POINT_new(pGroup);
+        if((NULL == pPriv) || (NULL == pPub))
+        {
+            goto exit;
+        }
+        do
+        {
+            if(1 != BN_priv_rand_range(pPriv, EC_GROUP_get0_order(pGroup)))
+            {
+                goto exit;
+            }
+        } while(BN_is_zero(pPriv));
+        if(1 != EC_POINT_mul(pGroup, pPub, pPriv, NULL, NULL, NULL))
+        {
+            goto exit;
+        }
+        pKey->keyLen[HSE_VIRTUAL_PUB_KEY] = (uint16_t)HSE_VirtualEcRaw(pGroup, pPub, pKey->key[HSE_VIRTUAL_PUB_KEY]);
+        pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)BN_num_bytes(EC_GROUP_get0_order(pGroup));
+        (void)BN_bn2binpad(pPriv, pKey->key[HSE_VIRTUAL_SYM_KEY], (int)pKey->keyLen[HSE_VIRTUAL_SYM_KEY]);
+    }
+
+    if(0UL != pPubKey)
+    {
+        memcpy(HSE_VIRTUAL_PTR(pPubKey), pKey->key[HSE_VIRTUAL_PUB_KEY], pKey->keyLen[HSE_VIRTUAL_PUB_KEY]);
+    }
+    srvResponse = HSE_SRV_RSP_OK;
+exit:
+    EVP_PKEY_free(pPKey);
+    EC_POINT_free(pPub);
+    EC_GROUP_free(pGroup);
+    BN_clear_free(pPriv);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : RSA key pair generation with the given public exponent; the
+ *                 modulus is also written to pModulus if not NULL.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualRsaGenerate(hseVirtualKey_t* pKey, const hseKeyGenRsaScheme_t* pRsaScheme)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    uint32_t u32ModLen = ((uint32_t)pKey->keyInfo.keyBitLen + 7UL) / 8UL;
+    EVP_PKEY_CTX* pCtx = NULL;
+    EVP_PKEY* pPKey = NULL;
+    BIGNUM* pE = NULL;
+    BIGNUM* pN = NULL;
+    BIGNUM* pD = NULL;
+
+    if((0UL == pRsaScheme->pPubExp) || (0UL == pRsaScheme->pubExpLength) ||
+       (pRsaScheme->pubExpLength > HSE_VIRTUAL_MAX_KEY_LEN) || (u32ModLen > HSE_VIRTUAL_MAX_KEY_LEN))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pE = BN_bin2bn((const uint8_t*)HSE_VIRTUAL_PTR(pRsaScheme->pPubExp), (int)pRsaScheme->pubExpLength, NULL);
+    pCtx = EVP_PKEY_CTX_new_from_name(NULL, "RSA", NULL);
+    if((NULL == pE) || (NULL == pCtx) || (1 != EVP_PKEY_keygen_init(pCtx)) ||
+       (1 != EVP_PKEY_CTX_set_rsa_keygen_bits(pCtx, (int)pKey->keyInfo.keyBitLen)) ||
+       (1 != EVP_PKEY_CTX_set1_rsa_keygen_pubexp(pCtx, pE)) ||
+       (1 != EVP_PKEY_generate(pCtx, &pPKey)) ||
+       (1 != EVP_PKEY_get_bn_param(pPKey, OSSL_PKEY_PARAM_RSA_N, &pN)) ||
+       (1 != EVP_PKEY_get_bn_param(pPKey, OSSL_PKEY_PARAM_RSA_D, &pD)))
+    {
+        goto exit;
+    }
+
+    pKey->keyLen[HSE_VIRTUAL_PUB_KEY] = (uint16_t)u32ModLen;
+    (void)BN_bn2binpad(pN, pKey->key[HSE_VIRTUAL_PUB_KEY], (int)u32ModLen);
+    pKey->keyLen[HSE_VIRTUAL_RSA_EXP] = (uint16_t)pRsaScheme->pubExpLength;
+    memcpy(pKey->key[HSE_VIRTUAL_RSA_EXP], HSE_VIRTUAL_PTR(pRsaScheme->pPubExp), pRsaScheme->pubExpLength);
+    pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)u32ModLen;
+    (void)BN_bn2binpad(pD, pKey->key[HSE_VIRTUAL_SYM_KEY], (int)u32ModLen);
+    if(0UL != pRsaScheme->pModulus)
+    {
+        memcpy(HSE_VIRTUAL_PTR(pRsaScheme->pModulus), pKey->key[HSE_VIRTUAL_PUB_KEY], u32ModLen);
+    }
+    srvResponse = HSE_SRV_RSP_OK;
+exit:
+    EVP_PKEY_CTX_free(pCtx);
+    EVP_PKEY_free(pPKey);
+    BN_free(pE);
+    BN_free(pN);
+    BN_clear_free(pD);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Hash algorithm of a signature scheme (EdDSA: none).
+ ******************************************************************************/
+static hseHashAlgo_t HSE_VirtualSignHashAlgo(const hseSignScheme_t* pScheme)
+{
+    switch(pScheme->signSch)
+    {
+        case HSE_SIGN_ECDSA:            return pScheme->sch.ecdsa.hashAlgo;
+        case HSE_SIGN_RSASSA_PSS:       return pScheme->sch.rsaPss.hashAlgo;
+        case HSE_SIGN_RSASSA_PKCS1_V15: return pScheme->sch.rsaPkcs1v15.hashAlgo;
+        default:                        return HSE_HASH_ALGO_NULL;
+    }
+}
+
+/*******************************************************************************
+ * Description   : ECDSA generate or verify of a digest; r in pSig[0], s in pSig[1],
+ *                 each as long as the curve order.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualEcdsa(hseKeyHandle_t keyHandle, hseAuthDir_t authDir, const uint8_t* pDigest,
+    uint32_t u32DigestLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2])
+{
+    hseSrvResponse_t srvResponse;
+    hseVirtualEcKey_t ecKey;
+    const BIGNUM* pOrder;
+    BN_CTX* pBnCtx = BN_CTX_new();
+    BIGNUM* pE = NULL;
+    BIGNUM* pK = BN_secure_new();
+    BIGNUM* pR = BN_new();
+    BIGNUM* pS = BN_new();
+    BIGNUM* pX = BN_new();
+    BIGNUM* pW = BN_new();
+    EC_POINT* pPoint = NULL;
+    uint32_t u32OrderLen;
+    int orderBits;
+
+    srvResponse = HSE_VirtualEcKeyLoad(keyHandle, (HSE_AUTH_DIR_GENERATE == authDir), &ecKey);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        goto exit;
+    }
+    srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    pOrder = EC_GROUP_get0_order(ecKey.pGroup);
+    orderBits = BN_num_bits(pOrder);
+    u32OrderLen = (uint32_t)BN_num_bytes(pOrder);
+    pPoint = EC_POINT_new(ecKey.pGroup);
+    /* The digest is truncated to the bit length of the order */
+    pE = BN_bin2bn(pDigest, (int)u32DigestLen, NULL);
+    if((NULL == pBnCtx) || (NULL == pE) || (NULL == pK) || (NULL == pR) || (NULL == pS) || (NULL == pX) ||
+       (NULL == pW) || (NULL == pPoint) ||
+       (((int)(u32DigestLen * 8UL) > orderBits) && (1 != BN_rshift(pE, pE, (int)(u32DigestLen * 8UL) - orderBits))))
+    {
+        goto exit;
+    }
+
+    if(HSE_AUTH_DIR_GENERATE == authDir)
+    {
+        if((NULL == pu32SigLen[0]) || (NULL == pu32SigLen[1]) ||
+           (*pu32SigLen[0] < u32OrderLen) || (*pu32SigLen[1] < u32OrderLen))
+        {
+            srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+            goto exit;
+        }
+        do
+        {
+            /* r = (k.G).x mod n, s = k^-1 (e + r.d) mod n */
+            if((1 != BN_priv_rand_range(pK, pOrder)) || BN_is_zero(pK) ||
+               (1 != EC_POINT_mul(ecKey.pGroup, pPoint, pK, NULL, NULL, pBnCtx)) ||
+               (1 != EC_POINT_get_affine_coordinates(ecKey.pGroup, pPoint, pX, NULL, pBnCtx)) ||
+               (1 != BN_nnmod(pR, pX, pOrder, pBnCtx)) ||
+               (1 != BN_mod_mul(pS, pR, ecKey.pPriv, pOrder, pBnCtx)) ||
+               (1 != BN_mod_add(pS, pS, pE, pOrder, pBnCtx)) ||
+               (NULL == BN_mod_inverse(pW, pK, pOrder, pBnCtx)) ||
+               (1 != BN_mod_mul(pS, pS, pW, pOrder, pBnCtx)))
+            {
+                BN_zero(pS);
+            }
+        } while(BN_is_zero(pR) || BN_is_zero(pS));
+        (void)BN_bn2binpad(pR, pSig[0], (int)u32OrderLen);
+        (void)BN_bn2binpad(pS, pSig[1], (int)u32OrderLen);
+        *pu32SigLen[0] = u32OrderLen;
+        *pu32SigLen[1] = u32OrderLen;
+        srvResponse = HSE_SRV_RSP_OK;
+        goto exit;
+    }
+
+    /* (u1.G + u2.Q).x mod n == r, u1 = e.s^-1, u2 = r.s^-1 */
+    srvResponse = HSE_SRV_RSP_VERIFY_FAILED;
+    if((NULL == pu32SigLen[0]) || (NULL == pu32SigLen[1]) ||
+       (NULL == BN_bin2bn(pSig[0], (int)*pu32SigLen[0], pR)) || (NULL == BN_bin2bn(pSig[1], (int)*pu32SigLen[1], pS)) ||
+       BN_is_zero(pR) || BN_is_zero(pS) || (BN_cmp(pR, pOrder) >= 0) || (BN_cmp(pS, pOrder) >= 0) ||
+       (NULL == BN_mod_inverse(pW, pS, pOrder, pBnCtx)) ||
+       (1 != BN_mod_mul(pE, pE, pW, pOrder, pBnCtx)) ||
+       (1 != BN_mod_mul(pW, pR, pW, pOrder, pBnCtx)) ||
+       (1 != EC_POINT_mul(ecKey.pGroup, pPoint, pE, ecKey.pPub, pW, pBnCtx)) ||
+       (1 != EC_POINT_get_affine_coordinates(ecKey.pGroup, pPoint, pX, NULL, pBnCtx)) ||
+       (1 != BN_nnmod(pX, pX, pOrder, pBnCtx)))
+    {
+        goto exit;
+    }
+    if(0 == BN_cmp(pX, pR))
+    {
+        srvResponse = HSE_SRV_RSP_OK;
+    }
+exit:
+    HSE_VirtualEcKeyFree(&ecKey);
+    EC_POINT_free(pPoint);
+    BN_free(pE);
+    BN_clear_free(pK);
+    BN_free(pR);
+    BN_free(pS);
+    BN_free(pX);
+    BN_free(pW);
+    BN_CTX_free(pBnCtx);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : RSASSA-PSS or RSASSA-PKCS1-v1.5 generate or verify of a digest.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualRsaSign(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, const uint8_t* pDigest, uint32_t u32DigestLen, uint8_t* pSig, uint32_t* pu32SigLen)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    const hseVirtualKey_t* pKey = HSE_VirtualFindKey(keyHandle);
+    const EVP_MD* pMd = HSE_VirtualDigest(HSE_VirtualSignHashAlgo(pScheme));
+    bool_t bGenerate = (HSE_AUTH_DIR_GENERATE == authDir);
+    EVP_PKEY_CTX* pCtx = NULL;
+    EVP_PKEY* pPKey = NULL;
+    size_t sigLen;
+    int rc;
+
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(((HSE_KEY_TYPE_RSA_PAIR != pKey->keyInfo.keyType) && (HSE_KEY_TYPE_RSA_PUB != pKey->keyInfo.keyType)) ||
+       (bGenerate && (HSE_KEY_TYPE_RSA_PAIR != pKey->keyInfo.keyType)))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    if((NULL == pMd) || (u32DigestLen != (uint32_t)EVP_MD_get_size(pMd)) || (NULL == pu32SigLen))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pPKey = HSE_VirtualRsaKey(pKey, bGenerate);
+    pCtx = (NULL != pPKey) ? EVP_PKEY_CTX_new_from_pkey(NULL, pPKey, NULL) : NULL;
+    if((NULL == pCtx) || (1 != (bGenerate ? EVP_PKEY_sign_init(pCtx) : EVP_PKEY_verify_init(pCtx))) ||
+       (1 != EVP_PKEY_CTX_set_rsa_padding(pCtx, (HSE_SIGN_RSASSA_PSS == pScheme->signSch) ?
+                                                RSA_PKCS1_PSS_PADDING : RSA_PKCS1_PADDING)) ||
+       (1 != EVP_PKEY_CTX_set_signature_md(pCtx, pMd)) ||
+       ((HSE_SIGN_RSASSA_PSS == pScheme->signSch) &&
+        (1 != EVP_PKEY_CTX_set_rsa_pss_saltlen(pCtx, (int)pScheme->sch.rsaPss.saltLength))))
+    {
+        goto exit;
+    }
+
+    if(bGenerate)
+    {
+        sigLen = *pu32SigLen;
+        if(sigLen < (size_t)EVP_PKEY_get_size(pPKey))
+        {
+            srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+            goto exit;
+        }
+        if(1 == EVP_PKEY_sign(pCtx, pSig, &sigLen, pDigest, u32DigestLen))
+        {
+            *pu32SigLen = (uint32_t)sigLen;
+            srvResponse = HSE_SRV_RSP_OK;
+        }
+    }
+    else
+    {
+        rc = EVP_PKEY_verify(pCtx, pSig, *pu32SigLen, pDigest, u32DigestLen);
+        srvResponse = (1 == rc) ? HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+    }
+exit:
+    EVP_PKEY_CTX_free(pCtx);
+    EVP_PKEY_free(pPKey);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Pure Ed25519 generate or verify of a message; R in pSig[0],
+ *                 S in pSig[1]. HashEdDSA and the EdDSA context are not supported.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualEddsa(hseKeyHandle_t keyHandle, hseAuthDir_t authDir, const uint8_t* pInput,
+    uint32_t u32InputLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2])
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    const hseVirtualKey_t* pKey = HSE_VirtualFindKey(keyHandle);
+    bool_t bGenerate = (HSE_AUTH_DIR_GENERATE == authDir);
+    uint8_t sig[2U * HSE_VIRTUAL_25519_LEN];
+    size_t sigLen = sizeof(sig);
+    EVP_MD_CTX* pMdCtx = NULL;
+    EVP_PKEY* pPKey = NULL;
+
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(((HSE_KEY_TYPE_ECC_PAIR != pKey->keyInfo.keyType) && (HSE_KEY_TYPE_ECC_PUB != pKey->keyInfo.keyType)) ||
+       (HSE_EC_25519_ED25519 != pKey->keyInfo.specific.eccCurveId))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    if((NULL == pu32SigLen[0]) || (NULL == pu32SigLen[1]) ||
+       (*pu32SigLen[0] < HSE_VIRTUAL_25519_LEN) || (*pu32SigLen[1] < HSE_VIRTUAL_25519_LEN))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pPKey = HSE_VirtualRawKey(pKey, EVP_PKEY_ED25519, bGenerate);
+    pMdCtx = EVP_MD_CTX_new();
+    if((NULL == pPKey) || (NULL == pMdCtx) ||
+       (1 != (bGenerate ? EVP_DigestSignInit(pMdCtx, NULL, NULL, NULL, pPKey) :
+                          EVP_DigestVerifyInit(pMdCtx, NULL, NULL, NULL, pPKey))))
+    {
+        goto exit;
+    }
+
+    if(bGenerate)
+    {
+        if(1 == EVP_DigestSign(pMdCtx, sig, &sigLen, pInput, u32InputLen))
+        {
+            memcpy(pSig[0], sig, HSE_VIRTUAL_25519_LEN);
+            memcpy(pSig[1], &sig[HSE_VIRTUAL_25519_LEN], HSE_VIRTUAL_25519_LEN);
+            *pu32SigLen[0] = HSE_VIRTUAL_25519_LEN;
+            *pu32SigLen[1] = HSE_VIRTUAL_25519_LEN;
+            srvResponse = HSE_SRV_RSP_OK;
+        }
+    }
+    else
+    {
+        memcpy(sig, pSig[0], HSE_VIRTUAL_25519_LEN);
+        memcpy(&sig[HSE_VIRTUAL_25519_LEN], pSig[1], HSE_VIRTUAL_25519_LEN);
+        srvResponse = (1 == EVP_DigestVerify(pMdCtx, sig, sizeof(sig), pInput, u32InputLen)) ?
+            HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+    }
+exit:
+    EVP_MD_CTX_free(pMdCtx);
+    EVP_PKEY_free(pPKey);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : ECDSA or RSA signature generate or verify of a digest.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualSignDigest(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, const uint8_t* pDigest, uint32_t u32DigestLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2])
+{
+    switch(pScheme->signSch)
+    {
+        case HSE_SIGN_ECDSA:
+            return HSE_VirtualEcdsa(keyHandle, authDir, pDigest, u32DigestLen, pSig, pu32SigLen);
+        case HSE_SIGN_RSASSA_PSS:
+        case HSE_SIGN_RSASSA_PKCS1_V15:
+            return HSE_VirtualRsaSign(pScheme, keyHandle, authDir, pDigest, u32DigestLen, pSig[0], pu32SigLen[0]);
+        default:
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+}
+
+/*******************************************************************************
+ * Description   : Signature generate or verify of a message (or of its digest).
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualSignInput(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    hseAuthDir_t authDir, bool_t bInputIsHashed, const uint8_t* pInput, uint32_t u32InputLen,
+    uint8_t* pSig[2], uint32_t* pu32SigLen[2])
+{
+    const EVP_MD* pMd = HSE_VirtualDigest(HSE_VirtualSignHashAlgo(pScheme));
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLen = 0U;
+
+    if(HSE_SIGN_EDDSA == pScheme->signSch)
+    {
+        if(pScheme->sch.eddsa.bHashEddsa || (0U != pScheme->sch.eddsa.contextLength))
+        {
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+        }
+        return HSE_VirtualEddsa(keyHandle, authDir, pInput, u32InputLen, pSig, pu32SigLen);
+    }
+    if(bInputIsHashed)
+    {
+        return HSE_VirtualSignDigest(pScheme, keyHandle, authDir, pInput, u32InputLen, pSig, pu32SigLen);
+    }
+    if(NULL == pMd)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+    if(1 != EVP_Digest(pInput, u32InputLen, digest, &digestLen, pMd, NULL))
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    return HSE_VirtualSignDigest(pScheme, keyHandle, authDir, digest, digestLen, pSig, pu32SigLen);
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : One-pass signature generate or verify of a message (key containers).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSignCompute(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
+    const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2])
+{
+    return HSE_VirtualSignInput(pScheme, keyHandle, authDir, FALSE, pInput, u32InputLen, pSig, pu32SigLen);
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_KEY_GENERATE (random symmetric key, ECC and RSA key pairs).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualKeyGenerate(const hseKeyGenerateSrv_t* pKeyGenSrv)
+{
+    hseSrvResponse_t srvResponse;
+    hseVirtualKey_t* pKey;
+    uint32_t u32KeyLen = ((uint32_t)pKeyGenSrv->keyInfo.keyBitLen + 7UL) / 8UL;
+
+    if(HSE_INVALID_KEY_HANDLE == pKeyGenSrv->targetKeyHandle)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    switch(pKeyGenSrv->keyGenScheme)
+    {
+        case HSE_KEY_GEN_SYM_RANDOM_KEY:
+            srvResponse = ((0UL == u32KeyLen) || (u32KeyLen > HSE_VIRTUAL_MAX_KEY_LEN) ||
+                           HSE_VIRTUAL_IS_ASYM(pKeyGenSrv->keyInfo.keyType)) ?
+                HSE_SRV_RSP_INVALID_PARAM : HSE_SRV_RSP_OK;
+            break;
+        case HSE_KEY_GEN_ECC_KEY_PAIR:
+            srvResponse = (HSE_KEY_TYPE_ECC_PAIR == pKeyGenSrv->keyInfo.keyType) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_INVALID_PARAM;
+            break;
+        case HSE_KEY_GEN_RSA_KEY_PAIR:
+            srvResponse = (HSE_KEY_TYPE_RSA_PAIR == pKeyGenSrv->keyInfo.keyType) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_INVALID_PARAM;
+            break;
+        default:
+            srvResponse = HSE_SRV_RSP_NOT_SUPPORTED;
+            break;
+    }
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        return srvResponse;
+    }
+
+    pKey = HSE_VirtualNewKey(pKeyGenSrv->targetKeyHandle);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+    memcpy(&pKey->keyInfo, &pKeyGenSrv->keyInfo, sizeof(hseKeyInfo_t));
+
+    switch(pKeyGenSrv->keyGenScheme)
+    {
+        case HSE_KEY_GEN_ECC_KEY_PAIR:
+            srvResponse = HSE_VirtualEccGenerate(pKey, pKeyGenSrv->sch.eccKey.pPubKey);
+            break;
+        case HSE_KEY_GEN_RSA_KEY_PAIR:
+            srvResponse = HSE_VirtualRsaGenerate(pKey, &pKeyGenSrv->sch.rsaKey);
+            break;
+        default:
+            pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)u32KeyLen;
+            srvResponse = (1 == RAND_bytes(pKey->key[HSE_VIRTUAL_SYM_KEY], (int)u32KeyLen)) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+            break;
+    }
+
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        memset(pKey, 0, sizeof(hseVirtualKey_t));
+    }
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_DH_COMPUTE_SHARED_SECRET: the shared secret is the
+ *                 x coordinate of priv.peerPub (ECDH) or the X25519 output.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualDhCompute(const hseDHComputeSharedSecretSrv_t* pDhSrv)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    const hseVirtualKey_t* pPrivKey = HSE_VirtualFindKey(pDhSrv->privKeyHandle);
+    const hseVirtualKey_t* pPeerKey = HSE_VirtualFindKey(pDhSrv->peerPubKeyHandle);
+    hseVirtualEcKey_t privKey;
+    hseVirtualEcKey_t peerKey;
+    uint8_t secret[2U * HSE_VIRTUAL_MAX_COORD_LEN];
+    size_t secretLen = sizeof(secret);
+    EVP_PKEY_CTX* pCtx = NULL;
+    EVP_PKEY* pPriv = NULL;
+    EVP_PKEY* pPeer = NULL;
+    EC_POINT* pShared = NULL;
+    hseVirtualKey_t* pTarget;
+
+    memset(&privKey, 0, sizeof(privKey));
+    memset(&peerKey, 0, sizeof(peerKey));
+    if((NULL == pPrivKey) || (NULL == pPeerKey))
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(pPrivKey->keyInfo.specific.eccCurveId != pPeerKey->keyInfo.specific.eccCurveId)
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    if(HSE_EC_25519_CURVE25519 == pPrivKey->keyInfo.specific.eccCurveId)
+    {
+        pPriv = HSE_VirtualRawKey(pPrivKey, EVP_PKEY_X25519, TRUE);
+        pPeer = HSE_VirtualRawKey(pPeerKey, EVP_PKEY_X25519, FALSE);
+        pCtx = (NULL != pPriv) ? EVP_PKEY_CTX_new_from_pkey(NULL, pPriv, NULL) : NULL;
+        if((NULL == pPeer) || (NULL == pCtx) || (1 != EVP_PKEY_derive_init(pCtx)) ||
+           (1 != EVP_PKEY_derive_set_peer(pCtx, pPeer)) || (1 != EVP_PKEY_derive(pCtx, secret, &secretLen)))
+        {
+            srvResponse = HSE_SRV_RSP_KEY_INVALID;
+            goto exit;
+        }
+    }
+    else
+    {
+        srvResponse = HSE_VirtualEcKeyLoad(pDhSrv->privKeyHandle, TRUE, &privKey);
+        if(HSE_SRV_RSP_OK == srvResponse)
+        {
+            srvResponse = HSE_VirtualEcKeyLoad(pDhSrv->peerPubKeyHandle, FALSE, &peerKey);
+        }
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            goto exit;
+        }
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        pShared = EC_POINT_new(privKey.pGroup);
+        if((NULL == pShared) ||
+           (1 != EC_POINT_mul(privKey.pGroup, pShared, NULL, peerKey.pPub, privKey.pPriv, NULL)) ||
+           (0UL == HSE_VirtualEcRaw(privKey.pGroup, pShared, secret)))
+        {
+            goto exit;
+        }
+        secretLen = privKey.u32CoordLen;
+    }
+
+    pTarget = HSE_VirtualNewKey(pDhSrv->targetKeyHandle);
+    if(NULL == pTarget)
+    {
+        srvResponse = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+        goto exit;
+    }
+    HSE_VirtualStoreSecret(pTarget, secret, (uint32_t)secretLen);
+    srvResponse = HSE_SRV_RSP_OK;
+exit:
+    OPENSSL_cleanse(secret, sizeof(secret));
+    EVP_PKEY_CTX_free(pCtx);
+    EVP_PKEY_free(pPriv);
+    EVP_PKEY_free(pPeer);
+    EC_POINT_free(pShared);
+    HSE_VirtualEcKeyFree(&privKey);
+    HSE_VirtualEcKeyFree(&peerKey);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_LOAD_ECC_CURVE (user curves, cofactor 1).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualLoadEccCurve(const hseLoadEccCurveSrv_t* pLoadCurveSrv)
+{
+    hseVirtualCurve_t* pCurve;
+    EC_GROUP* pGroup;
+    uint32_t u32PLen = ((uint32_t)pLoadCurveSrv->pBitLen + 7UL) / 8UL;
+    uint32_t u32NLen = ((uint32_t)pLoadCurveSrv->nBitLen + 7UL) / 8UL;
+
+    if((pLoadCurveSrv->eccCurveId < HSE_EC_USER_CURVE1) || (pLoadCurveSrv->eccCurveId > HSE_EC_USER_CURVE3) ||
+       (0UL == u32PLen) || (u32PLen > HSE_VIRTUAL_MAX_COORD_LEN) ||
+       (0UL == u32NLen) || (u32NLen > HSE_VIRTUAL_MAX_COORD_LEN) ||
+       (0UL == pLoadCurveSrv->pA) || (0UL == pLoadCurveSrv->pB) || (0UL == pLoadCurveSrv->pP) ||
+       (0UL == pLoadCurveSrv->pN) || (0UL == pLoadCurveSrv->pG))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pCurve = &virtualCurves[pLoadCurveSrv->eccCurveId - HSE_EC_USER_CURVE1];
+    memset(pCurve, 0, sizeof(hseVirtualCurve_t));
+    pCurve->u32PLen = u32PLen;
+    pCurve->u32NLen = u32NLen;
+    memcpy(pCurve->p, HSE_VIRTUAL_PTR(pLoadCurveSrv->pP), u32PLen);
+    memcpy(pCurve->a, HSE_VIRTUAL_PTR(pLoadCurveSrv->pA), u32PLen);
+    memcpy(pCurve->b, HSE_VIRTUAL_PTR(pLoadCurveSrv->pB), u32PLen);
+    memcpy(pCurve->n, HSE_VIRTUAL_PTR(pLoadCurveSrv->pN), u32NLen);
+    memcpy(pCurve->g, HSE_VIRTUAL_PTR(pLoadCurveSrv->pG), 2UL * u32PLen);
+    pCurve->bLoaded = TRUE;
+
+    /* The parameters must describe a curve with G on it */
+    pGroup = HSE_VirtualEcGroup(pLoadCurveSrv->eccCurveId);
+    if(NULL == pGroup)
+    {
+        memset(pCurve, 0, sizeof(hseVirtualCurve_t));
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    EC_GROUP_free(pGroup);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_BURMESTER_DESMEDT. The public keys are read from the
+ *                 slots following pubKeyHandle: Z(i-1), Z(i+1), X(i), X(i+1)...
+ *                 - step 1: X(i) = a(i).(Z(i+1) - Z(i-1)), written to slot +2
+ *                 - step 2: K = n.a(i).Z(i-1) + sum(j = 0..n-2) (n-1-j).X(i+j),
+ *                   stored as the shared secret K.x || K.y
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualBurmesterDesmedt(const hseBurmesterDesmedtSrv_t* pBdSrv)
+{
+    hseSrvResponse_t srvResponse;
+    hseVirtualEcKey_t devKey;
+    hseVirtualEcKey_t pubKey;
+    const hseVirtualKey_t* pPrevKey;
+    hseVirtualKey_t* pTarget;
+    uint8_t raw[2U * HSE_VIRTUAL_MAX_COORD_LEN];
+    uint32_t u32RawLen = 0UL;
+    BN_CTX* pBnCtx = BN_CTX_new();
+    BIGNUM* pScalar = BN_new();
+    EC_POINT* pSum = NULL;
+    EC_POINT* pTerm = NULL;
+    uint8_t u8Index;
+
+#define HSE_VIRTUAL_BD_SLOT(offset) \
+    GET_KEY_HANDLE(GET_CATALOG_ID(pBdSrv->pubKeyHandle), GET_GROUP_IDX(pBdSrv->pubKeyHandle), \
+                   (uint32_t)GET_SLOT_IDX(pBdSrv->pubKeyHandle) + (uint32_t)(offset))
+
+    memset(&pubKey, 0, sizeof(pubKey));
+    srvResponse = HSE_VirtualEcKeyLoad(pBdSrv->deviceKeyHandle, TRUE, &devKey);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        goto exit;
+    }
+    srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    pSum = EC_POINT_new(devKey.pGroup);
+    pTerm = EC_POINT_new(devKey.pGroup);
+    if((NULL == pBnCtx) || (NULL == pScalar) || (NULL == pSum) || (NULL == pTerm))
+    {
+        goto exit;
+    }
+
+    /* Z(i-1) */
+    pPrevKey = HSE_VirtualFindKey(HSE_VIRTUAL_BD_SLOT(0U));
+    srvResponse = HSE_VirtualEcKeyLoad(HSE_VIRTUAL_BD_SLOT(0U), FALSE, &pubKey);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        goto exit;
+    }
+
+    if(HSE_BD_STEP_COMPUTE_SECOND_PUBLIC_KEY == pBdSrv->bdStep)
+    {
+        (void)EC_POINT_copy(pTerm, pubKey.pPub);
+        HSE_VirtualEcKeyFree(&pubKey);
+        srvResponse = HSE_VirtualEcKeyLoad(HSE_VIRTUAL_BD_SLOT(1U), FALSE, &pubKey);
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            goto exit;
+        }
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        if((1 != EC_POINT_invert(devKey.pGroup, pTerm, pBnCtx)) ||
+           (1 != EC_POINT_add(devKey.pGroup, pTerm, pubKey.pPub, pTerm, pBnCtx)) ||
+           (1 != EC_POINT_mul(devKey.pGroup, pSum, NULL, pTerm, devKey.pPriv, pBnCtx)))
+        {
+            goto exit;
+        }
+        u32RawLen = HSE_VirtualEcRaw(devKey.pGroup, pSum, raw);
+        pTarget = HSE_VirtualNewKey(HSE_VIRTUAL_BD_SLOT(2U));
+        if((0UL == u32RawLen) || (NULL == pTarget))
+        {
+            srvResponse = (NULL == pTarget) ? HSE_SRV_RSP_NOT_ENOUGH_SPACE : HSE_SRV_RSP_GENERAL_ERROR;
+            goto exit;
+        }
+        /* Same attributes as Z(i-1) */
+        memcpy(&pTarget->keyInfo, &pPrevKey->keyInfo, sizeof(hseKeyInfo_t));
+        pTarget->keyInfo.keyType = HSE_KEY_TYPE_ECC_PUB;
+        pTarget->keyLen[HSE_VIRTUAL_PUB_KEY] = (uint16_t)u32RawLen;
+        memcpy(pTarget->key[HSE_VIRTUAL_PUB_KEY], raw, u32RawLen);
+        srvResponse = HSE_SRV_RSP_OK;
+        goto exit;
+    }
+
+    if((HSE_BD_STEP_COMPUTE_SHARED_SECRET != pBdSrv->bdStep) || (pBdSrv->numParticipants < 2U))
+    {
+        srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+        goto exit;
+    }
+
+    /* n.a(i).Z(i-1) */
+    if((1 != BN_set_word(pScalar, pBdSrv->numParticipants)) ||
+       (1 != BN_mod_mul(pScalar, pScalar, devKey.pPriv, EC_GROUP_get0_order(devKey.pGroup), pBnCtx)) ||
+       (1 != EC_POINT_mul(devKey.pGroup, pSum, NULL, pubKey.pPub, pScalar, pBnCtx)))
+    {
+        goto exit;
+    }
+    /* + (n-1-j).X(i+j) */
+    for(u8Index = 0U; u8Index < (pBdSrv->numParticipants - 1U); u8Index++)
+    {
+        HSE_VirtualEcKeyFree(&pubKey);
+        srvResponse = HSE_VirtualEcKeyLoad(HSE_VIRTUAL_BD_SLOT(2U + u8Index), FALSE, &pubKey);
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            goto exit;
+        }
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        if((1 != BN_set_word(pScalar, (BN_ULONG)pBdSrv->numParticipants - 1U - u8Index)) ||
+           (1 != EC_POINT_mul(devKey.pGroup, pTerm, NULL, pubKey.pPub, pScalar, pBnCtx)) ||
+           (1 != EC_POINT_add(devKey.pGroup, pSum, pSum, pTerm, pBnCtx)))
+        {
+            goto exit;
+        }
+    }
+
+    u32RawLen = HSE_VirtualEcRaw(devKey.pGroup, pSum, raw);
+    pTarget = HSE_VirtualNewKey(pBdSrv->sharedSecretKeyHandle);
+    if((0UL == u32RawLen) || (NULL == pTarget))
+    {
+        srvResponse = (NULL == pTarget) ? HSE_SRV_RSP_NOT_ENOUGH_SPACE : HSE_SRV_RSP_GENERAL_ERROR;
+        goto exit;
+    }
+    HSE_VirtualStoreSecret(pTarget, raw, u32RawLen);
+    srvResponse = HSE_SRV_RSP_OK;
+
+#undef HSE_VIRTUAL_BD_SLOT
+exit:
+    OPENSSL_cleanse(raw, sizeof(raw));
+    HSE_VirtualEcKeyFree(&devKey);
+    HSE_VirtualEcKeyFree(&pubKey);
+    EC_POINT_free(pSum);
+    EC_POINT_free(pTerm);
+    BN_clear_free(pScalar);
+    BN_CTX_free(pBnCtx);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SIGN, one pass or streaming (hash of the input in
+ *                 START/UPDATE, signature at FINISH).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSign(uint8_t u8MuInstance, uint8_t u8Channel, const hseSignSrv_t* pSignSrv)
+{
+    hseSrvResponse_t srvResponse;
+    hseVirtualStream_t* pStream = NULL;
+    const EVP_MD* pMd;
+    const uint8_t* pInput = (const uint8_t*)HSE_VIRTUAL_PTR(pSignSrv->pInput);
+    uint8_t* pSig[2];
+    uint32_t* pu32SigLen[2];
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLen = 0U;
+
+    pSig[0] = (uint8_t*)HSE_VIRTUAL_PTR(pSignSrv->pSignature[0]);
+    pSig[1] = (uint8_t*)HSE_VIRTUAL_PTR(pSignSrv->pSignature[1]);
+    pu32SigLen[0] = (uint32_t*)HSE_VIRTUAL_PTR(pSignSrv->pSignatureLength[0]);
+    pu32SigLen[1] = (uint32_t*)HSE_VIRTUAL_PTR(pSignSrv->pSignatureLength[1]);
+
+    switch(pSignSrv->accessMode)
+    {
+        case HSE_ACCESS_MODE_ONE_PASS:
+            return HSE_VirtualSignInput(&pSignSrv->signScheme, pSignSrv->keyHandle, pSignSrv->authDir,
+                                        pSignSrv->bInputIsHashed, pInput, pSignSrv->inputLength, pSig, pu32SigLen);
+        case HSE_ACCESS_MODE_START:
+            pMd = HSE_VirtualDigest(HSE_VirtualSignHashAlgo(&pSignSrv->signScheme));
+            if(NULL == pMd)
+            {
+                /* EdDSA has no streaming mode */
+                return HSE_SRV_RSP_NOT_SUPPORTED;
+            }
+            pStream = HSE_VirtualStreamStart(u8MuInstance, u8Channel, pSignSrv->streamId, HSE_SRV_ID_SIGN);
+            if(NULL == pStream)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            pStream->authDir = pSignSrv->authDir;
+            pStream->keyHandle = pSignSrv->keyHandle;
+            memcpy(&pStream->signScheme, &pSignSrv->signScheme, sizeof(hseSignScheme_t));
+            pStream->pMdCtx = EVP_MD_CTX_new();
+            srvResponse = ((NULL != pStream->pMdCtx) && (1 == EVP_DigestInit_ex(pStream->pMdCtx, pMd, NULL)) &&
+                           (1 == EVP_DigestUpdate(pStream->pMdCtx, pInput, pSignSrv->inputLength))) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+            break;
+        case HSE_ACCESS_MODE_UPDATE:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pSignSrv->streamId, HSE_SRV_ID_SIGN, &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            srvResponse = (1 == EVP_DigestUpdate(pStream->pMdCtx, pInput, pSignSrv->inputLength)) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+            break;
+        case HSE_ACCESS_MODE_FINISH:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pSignSrv->streamId, HSE_SRV_ID_SIGN, &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            if((1 != EVP_DigestUpdate(pStream->pMdCtx, pInput, pSignSrv->inputLength)) ||
+               (1 != EVP_DigestFinal_ex(pStream->pMdCtx, digest, &digestLen)))
+            {
+                srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+            }
+            else
+            {
+                srvResponse = HSE_VirtualSignDigest(&pStream->signScheme, pStream->keyHandle, pStream->authDir,
+                                                    digest, digestLen, pSig, pu32SigLen);
+            }
+            HSE_VirtualStreamEnd(pStream);
+            return srvResponse;
+        default:
+            return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        HSE_VirtualStreamEnd(pStream);
+    }
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Raw (x || y) public key of a compressed one (0x02/0x03 || x).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualEccDecompress(hseEccCurveId_t eccCurveId, const uint8_t* pCompressed, uint32_t u32Len,
+                                         uint8_t* pPubKey, uint16_t* pu16PubKeyLen)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+    EC_GROUP* pGroup = HSE_VirtualEcGroup(eccCurveId);
+    EC_POINT* pPoint = NULL;
+    BIGNUM* pX = NULL;
+    uint32_t u32CoordLen;
+
+    if(NULL == pGroup)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+    u32CoordLen = ((uint32_t)EC_GROUP_get_degree(pGroup) + 7UL) / 8UL;
+    if((u32Len != (u32CoordLen + 1UL)) || ((0x02U != pCompressed[0]) && (0x03U != pCompressed[0])))
+    {
+        goto exit;
+    }
+
+    pX = BN_bin2bn(&pCompressed[1], (int)u32CoordLen, NULL);
+    pPoint = EC_POINT_new(pGroup);
+    if((NULL != pX) && (NULL != pPoint) &&
+       (1 == EC_POINT_set_compressed_coordinates(pGroup, pPoint, pX, (int)(pCompressed[0] & 0x01U), NULL)))
+    {
+        *pu16PubKeyLen = (uint16_t)HSE_VirtualEcRaw(pGroup, pPoint, pPubKey);
+        srvResponse = HSE_SRV_RSP_OK;
+    }
+exit:
+    BN_free(pX);
+    EC_POINT_free(pPoint);
+    EC_GROUP_free(pGroup);
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SYS_AUTH_REQ. USER rights are granted at once; the
+ *                 SUPER_USER rights need a SYS_AUTH_RESP over the returned challenge,
+ *                 authenticated with the owner key (SHE MASTER_ECU_KEY, or a key with
+ *                 the AUTHORIZATION usage).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSysAuthReq(const hseSysAuthorizationReqSrv_t* pAuthReqSrv)
+{
+    hseSrvResponse_t srvResponse;
+    const hseVirtualKey_t* pOwnerKey;
+
+    memset(&virtualAuth, 0, sizeof(virtualAuth));
+    if(HSE_RIGHTS_USER == pAuthReqSrv->sysRights)
+    {
+        HSE_VirtualSetStatus(0U, HSE_STATUS_CUST_SUPER_USER | HSE_STATUS_OEM_SUPER_USER);
+        return HSE_SRV_RSP_OK;
+    }
+    if((HSE_RIGHTS_SUPER_USER != pAuthReqSrv->sysRights) || (0UL == pAuthReqSrv->pChallenge))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pOwnerKey = HSE_VirtualFindKey(pAuthReqSrv->ownerKeyHandle);
+    if(NULL == pOwnerKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(HSE_KEY_TYPE_SHE == pOwnerKey->keyInfo.keyType)
+    {
+        srvResponse = HSE_VirtualSheChallenge(virtualAuth.challenge);
+        virtualAuth.u32ChallengeLen = HSE_VIRTUAL_SHE_CHALLENGE_LEN;
+    }
+    else if(0U == (pOwnerKey->keyInfo.keyFlags & HSE_KF_USAGE_AUTHORIZATION))
+    {
+        srvResponse = HSE_SRV_RSP_NOT_ALLOWED;
+    }
+    else
+    {
+        virtualAuth.u32ChallengeLen = HSE_SYS_AUTH_CHALLENGE_LENGTH;
+        srvResponse = (1 == RAND_bytes(virtualAuth.challenge, (int)virtualAuth.u32ChallengeLen)) ?
+            HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        memset(&virtualAuth, 0, sizeof(virtualAuth));
+        return srvResponse;
+    }
+
+    virtualAuth.bPending = TRUE;
+    virtualAuth.ownerKeyHandle = pAuthReqSrv->ownerKeyHandle;
+    virtualAuth.ownerKeyType = pOwnerKey->keyInfo.keyType;
+    memcpy(&virtualAuth.authScheme, &pAuthReqSrv->authScheme, sizeof(hseAuthScheme_t));
+    memcpy(HSE_VIRTUAL_PTR(pAuthReqSrv->pChallenge), virtualAuth.challenge, virtualAuth.u32ChallengeLen);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SYS_AUTH_RESP: grants the CUST_SUPER_USER rights if
+ *                 the response authenticates the pending challenge.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSysAuthResp(const hseSysAuthorizationRespSrv_t* pAuthRespSrv)
+{
+    hseSrvResponse_t srvResponse;
+    uint8_t* pSig[2];
+    uint32_t u32SigLen[2];
+    uint32_t* pu32SigLen[2];
+
+    if(!virtualAuth.bPending)
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    pSig[0] = (uint8_t*)HSE_VIRTUAL_PTR(pAuthRespSrv->pAuth[0]);
+    pSig[1] = (uint8_t*)HSE_VIRTUAL_PTR(pAuthRespSrv->pAuth[1]);
+    u32SigLen[0] = pAuthRespSrv->authLen[0];
+    u32SigLen[1] = pAuthRespSrv->authLen[1];
+    pu32SigLen[0] = &u32SigLen[0];
+    pu32SigLen[1] = &u32SigLen[1];
+
+    if(NULL == pSig[0])
+    {
+        srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+    }
+    else if(HSE_KEY_TYPE_SHE == virtualAuth.ownerKeyType)
+    {
+        srvResponse = HSE_VirtualSheAuthVerify(virtualAuth.ownerKeyHandle, virtualAuth.challenge, pSig[0],
+                                               u32SigLen[0]);
+    }
+    else
+    {
+        srvResponse = HSE_VirtualSignInput(&virtualAuth.authScheme.sigScheme, virtualAuth.ownerKeyHandle,
+                                           HSE_AUTH_DIR_VERIFY, FALSE, virtualAuth.challenge,
+                                           virtualAuth.u32ChallengeLen, pSig, pu32SigLen);
+    }
+
+    /* One response per challenge */
+    memset(&virtualAuth, 0, sizeof(virtualAuth));
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        return HSE_SRV_RSP_VERIFY_FAILED;
+    }
+    HSE_VirtualSetStatus(HSE_STATUS_CUST_SUPER_USER, HSE_STATUS_OEM_SUPER_USER);
+    return HSE_SRV_RSP_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
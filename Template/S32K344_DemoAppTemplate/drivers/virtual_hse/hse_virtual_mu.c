@@ -0,0 +1,582 @@
+/**
+*   @file    hse_virtual_mu.c
+*
+*   @brief   Virtual HSE - emulated MU registers and device thread.
+*   @details The host writes a descriptor address in TR: the channel becomes busy (FSR bit set,
+*            TSR bit cleared) and the device thread is woken up. The device thread executes the
+*            requests one at a time (like the HSE firmware), applies the latency model, writes
+*            RR and RSR, and calls HSE_ReceiveInterruptHandler() if the RX interrupt of the
+*            channel is enabled (emulated interrupt, serialized with sys_disableAllInterrupts).
+*            A HSE_SRV_ID_CANCEL written on channel 0 during the latency of the running request,
+*            or while the target request is still queued, completes the target request with
+*            HSE_SRV_RSP_CANCELED.
+*
+*   @addtogroup hse_virtual_mu_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_mu.c
+*/
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include "hse_virtual.h"
+#include "hse_virtual_target.h"
+#include "hse_mu.h"
+#include "hse_host.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Latency model of a service
+ */
+typedef struct
+{
+    hseSrvId_t  srvId;
+    uint32_t    u32FixedUs;
+    uint32_t    u32NsPerByte;
+} hseVirtualLatency_t;
+
+/*
+ * @brief   Emulated MU instance
+ */
+typedef struct
+{
+    volatile uint32_t   regs[HSE_VIRTUAL_MU_REG_SIZE / sizeof(uint32_t)];
+    uintptr_t           pendingDesc[HSE_NUM_OF_CHANNELS_PER_MU];
+    uint32_t            u32PendingMask;     /* Requests written in TR, not executed yet */
+} hseVirtualMu_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_VIRTUAL_REG(u8Mu, offset)   (virtualMu[(u8Mu)].regs[(offset) / sizeof(uint32_t)])
+
+/* All channels of a MU instance */
+#define HSE_VIRTUAL_CHANNEL_MASK        (0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU))
+
+/* HSE status reported in the 16 MSB of FSR at start-up: firmware running, key catalogs not formatted
+ * yet (HSE_STATUS_INSTALL_OK is set by the format), CUST_DEL life cycle with super user rights */
+#define HSE_VIRTUAL_STATUS  ((uint32_t)(HSE_STATUS_INIT_OK | HSE_STATUS_RNG_INIT_OK | HSE_STATUS_CUST_SUPER_USER) << 16U)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseVirtualMu_t       virtualMu[HSE_NUM_OF_MU_INSTANCES];
+static hseVirtualLatency_t  virtualLatency[HSE_VIRTUAL_MAX_LATENCY_ENTRIES];
+static uint32_t             u32LatencyEntries = 0UL;
+static hseVirtualLatency_t  defaultLatency = {HSE_VIRTUAL_SRV_ID_DEFAULT, 0UL, 0UL};
+
+/* Response forced on the next requests of a service (HSE_VirtualInjectResponse) */
+static hseSrvId_t           injectSrvId = 0UL;
+static hseSrvResponse_t     injectResponse = HSE_SRV_RSP_OK;
+static uint32_t             u32InjectCount = 0UL;
+
+/* Protects the pending requests, the status registers, the latency table and the injected responses */
+static pthread_mutex_t      deviceLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t       deviceWakeUp = PTHREAD_COND_INITIALIZER;
+static pthread_t            deviceThread;
+static bool_t               bDeviceRunning = FALSE;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static bool_t HSE_VirtualDelay(uint8_t u8Mu, uint8_t u8Channel, const hseSrvDescriptor_t* pSrvDesc);
+static bool_t HSE_VirtualTakeCancel(uint8_t u8Mu, uint8_t u8Channel);
+static bool_t HSE_VirtualCancelQueued(uint8_t u8Mu, const hseSrvDescriptor_t* pSrvDesc);
+static bool_t HSE_VirtualTakeQueuedCancel(uint8_t* pu8Mu, uint8_t* pu8Channel);
+static bool_t HSE_VirtualTakeInjected(hseSrvId_t srvId, hseSrvResponse_t* pResponse);
+static bool_t HSE_VirtualNextRequest(uint8_t* pu8Mu, uint8_t* pu8Channel, uintptr_t* pDesc);
+static void HSE_VirtualComplete(uint8_t u8Mu, uint8_t u8Channel, hseSrvResponse_t response);
+static void* HSE_VirtualDeviceThread(void* pArg);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Apply the latency model of the service.
+ *                 Returns TRUE if the request was canceled meanwhile.
+ ******************************************************************************/
+static bool_t HSE_VirtualDelay(uint8_t u8Mu, uint8_t u8Channel, const hseSrvDescriptor_t* pSrvDesc)
+{
+    hseVirtualLatency_t latency = defaultLatency;
+    uint64_t u64DelayNs;
+    uint64_t u64DeadlineNs;
+    struct timespec deadline;
+    bool_t bCanceled = FALSE;
+    uint32_t u32Index;
+    uint8_t u8CancelMu;
+    uint8_t u8CancelChannel;
+
+    pthread_mutex_lock(&deviceLock);
+    for(u32Index = 0UL; u32Index < u32LatencyEntries; u32Index++)
+    {
+        if(virtualLatency[u32Index].srvId == pSrvDesc->srvId)
+        {
+            latency = virtualLatency[u32Index];
+            break;
+        }
+    }
+
+    u64DelayNs = ((uint64_t)latency.u32FixedUs * 1000ULL) +
+                 ((uint64_t)HSE_VirtualInputLength(pSrvDesc) * latency.u32NsPerByte);
+    if(0ULL != u64DelayNs)
+    {
+        /* Wait on deviceWakeUp: a cancel request written meanwhile ends the wait */
+        (void)clock_gettime(CLOCK_REALTIME, &deadline);
+        u64DeadlineNs = ((uint64_t)deadline.tv_sec * 1000000000ULL) + (uint64_t)deadline.tv_nsec + u64DelayNs;
+        deadline.tv_sec  = (time_t)(u64DeadlineNs / 1000000000ULL);
+        deadline.tv_nsec = (long)(u64DeadlineNs % 1000000000ULL);
+        while(bDeviceRunning && !(bCanceled = HSE_VirtualTakeCancel(u8Mu, u8Channel)))
+        {
+            /* The cancel of a queued request is answered during the latency of the running one */
+            if(HSE_VirtualTakeQueuedCancel(&u8CancelMu, &u8CancelChannel))
+            {
+                pthread_mutex_unlock(&deviceLock);
+                HSE_VirtualComplete(u8CancelMu, u8CancelChannel, HSE_SRV_RSP_CANCELED);
+                HSE_VirtualComplete(u8CancelMu, 0U, HSE_SRV_RSP_OK);
+                pthread_mutex_lock(&deviceLock);
+                continue;
+            }
+            if(ETIMEDOUT == pthread_cond_timedwait(&deviceWakeUp, &deviceLock, &deadline))
+            {
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&deviceLock);
+
+    return bCanceled;
+}
+
+/*******************************************************************************
+ * Description   : Take the cancel request of a channel written on channel 0.
+ *                 Called with deviceLock held.
+ ******************************************************************************/
+static bool_t HSE_VirtualTakeCancel(uint8_t u8Mu, uint8_t u8Channel)
+{
+    const hseSrvDescriptor_t* pCancelDesc = (const hseSrvDescriptor_t*)virtualMu[u8Mu].pendingDesc[0U];
+
+    if((0UL == (virtualMu[u8Mu].u32PendingMask & 1UL)) ||
+       (HSE_SRV_ID_CANCEL != pCancelDesc->srvId) ||
+       (u8Channel != pCancelDesc->hseSrv.cancelSrvReq.muChannelIdx))
+    {
+        return FALSE;
+    }
+
+    virtualMu[u8Mu].u32PendingMask &= ~1UL;
+    HSE_VIRTUAL_REG(u8Mu, MU_TSR_OFFSET) |= 1UL;
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Cancel a request still queued (not started).
+ *                 Returns TRUE if the target request was canceled.
+ ******************************************************************************/
+static bool_t HSE_VirtualCancelQueued(uint8_t u8Mu, const hseSrvDescriptor_t* pSrvDesc)
+{
+    uint8_t u8Channel = pSrvDesc->hseSrv.cancelSrvReq.muChannelIdx;
+    bool_t bQueued = FALSE;
+
+    if((0U == u8Channel) || (u8Channel >= HSE_NUM_OF_CHANNELS_PER_MU))
+    {
+        return FALSE;
+    }
+
+    pthread_mutex_lock(&deviceLock);
+    if(0UL != (virtualMu[u8Mu].u32PendingMask & (1UL << u8Channel)))
+    {
+        virtualMu[u8Mu].u32PendingMask &= ~(1UL << u8Channel);
+        HSE_VIRTUAL_REG(u8Mu, MU_TSR_OFFSET) |= (1UL << u8Channel);
+        bQueued = TRUE;
+    }
+    pthread_mutex_unlock(&deviceLock);
+
+    if(bQueued)
+    {
+        HSE_VirtualComplete(u8Mu, u8Channel, HSE_SRV_RSP_CANCELED);
+    }
+    return bQueued;
+}
+
+/*******************************************************************************
+ * Description   : Take a cancel request written on channel 0 of any MU whose target
+ *                 request is still queued. Called with deviceLock held.
+ ******************************************************************************/
+static bool_t HSE_VirtualTakeQueuedCancel(uint8_t* pu8Mu, uint8_t* pu8Channel)
+{
+    const hseSrvDescriptor_t* pCancelDesc;
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        if(0UL == (virtualMu[u8Mu].u32PendingMask & 1UL))
+        {
+            continue;
+        }
+        pCancelDesc = (const hseSrvDescriptor_t*)virtualMu[u8Mu].pendingDesc[0U];
+        u8Channel = pCancelDesc->hseSrv.cancelSrvReq.muChannelIdx;
+        if((HSE_SRV_ID_CANCEL == pCancelDesc->srvId) && (0U != u8Channel) &&
+           (u8Channel < HSE_NUM_OF_CHANNELS_PER_MU) &&
+           (0UL != (virtualMu[u8Mu].u32PendingMask & (1UL << u8Channel))))
+        {
+            virtualMu[u8Mu].u32PendingMask &= ~(1UL | (1UL << u8Channel));
+            HSE_VIRTUAL_REG(u8Mu, MU_TSR_OFFSET) |= (1UL | (1UL << u8Channel));
+            *pu8Mu = u8Mu;
+            *pu8Channel = u8Channel;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*******************************************************************************
+ * Description   : Take the next request (lowest MU, then lowest channel first).
+ *                 Called with deviceLock held.
+ ******************************************************************************/
+static bool_t HSE_VirtualNextRequest(uint8_t* pu8Mu, uint8_t* pu8Channel, uintptr_t* pDesc)
+{
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+        {
+            if(0UL != (virtualMu[u8Mu].u32PendingMask & (1UL << u8Channel)))
+            {
+                virtualMu[u8Mu].u32PendingMask &= ~(1UL << u8Channel);
+                /* HSE read TR: the transmit register is empty again */
+                HSE_VIRTUAL_REG(u8Mu, MU_TSR_OFFSET) |= (1UL << u8Channel);
+                *pu8Mu = u8Mu;
+                *pu8Channel = u8Channel;
+                *pDesc = virtualMu[u8Mu].pendingDesc[u8Channel];
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+/*******************************************************************************
+ * Description   : Write the response and raise the RX interrupt.
+ ******************************************************************************/
+static void HSE_VirtualComplete(uint8_t u8Mu, uint8_t u8Channel, hseSrvResponse_t response)
+{
+    bool_t bRaiseIrq;
+
+    pthread_mutex_lock(&deviceLock);
+    HSE_VIRTUAL_REG(u8Mu, MU_RR_OFFSET + ((uint32_t)u8Channel << 2U)) = response;
+    HSE_VIRTUAL_REG(u8Mu, MU_FSR_OFFSET) &= ~(1UL << u8Channel);
+    HSE_VIRTUAL_REG(u8Mu, MU_RSR_OFFSET) |= (1UL << u8Channel);
+    bRaiseIrq = (0UL != (HSE_VIRTUAL_REG(u8Mu, MU_RCR_OFFSET) & (1UL << u8Channel)));
+    pthread_mutex_unlock(&deviceLock);
+
+    if(bRaiseIrq)
+    {
+        /* Emulated interrupt: mutually exclusive with the host critical sections */
+        HSE_VirtualEnterIsr();
+        HSE_ReceiveInterruptHandler(u8Mu);
+        HSE_VirtualExitIsr();
+    }
+}
+
+/*******************************************************************************
+ * Description   : Response injected on a request of the service, if any.
+ ******************************************************************************/
+static bool_t HSE_VirtualTakeInjected(hseSrvId_t srvId, hseSrvResponse_t* pResponse)
+{
+    bool_t bInjected = FALSE;
+
+    pthread_mutex_lock(&deviceLock);
+    if((0UL != u32InjectCount) && (injectSrvId == srvId))
+    {
+        u32InjectCount--;
+        *pResponse = injectResponse;
+        bInjected = TRUE;
+    }
+    pthread_mutex_unlock(&deviceLock);
+    return bInjected;
+}
+
+/*******************************************************************************
+ * Description   : Device thread - executes the requests written in TR.
+ ******************************************************************************/
+static void* HSE_VirtualDeviceThread(void* pArg)
+{
+    const hseSrvDescriptor_t* pSrvDesc;
+    hseSrvResponse_t response;
+    uintptr_t descAddr;
+    uint8_t u8Mu = 0U;
+    uint8_t u8Channel = 0U;
+
+    (void)pArg;
+
+    for(;;)
+    {
+        pthread_mutex_lock(&deviceLock);
+        while(bDeviceRunning && !HSE_VirtualNextRequest(&u8Mu, &u8Channel, &descAddr))
+        {
+            pthread_cond_wait(&deviceWakeUp, &deviceLock);
+        }
+        if(!bDeviceRunning)
+        {
+            pthread_mutex_unlock(&deviceLock);
+            break;
+        }
+        pthread_mutex_unlock(&deviceLock);
+
+        pSrvDesc = (const hseSrvDescriptor_t*)descAddr;
+        if((HSE_SRV_ID_CANCEL == pSrvDesc->srvId) && HSE_VirtualCancelQueued(u8Mu, pSrvDesc))
+        {
+            HSE_VirtualComplete(u8Mu, u8Channel, HSE_SRV_RSP_OK);
+            continue;
+        }
+
+        if(!HSE_VirtualTakeInjected(pSrvDesc->srvId, &response))
+        {
+            response = HSE_VirtualExecute(u8Mu, u8Channel, pSrvDesc);
+        }
+        if(HSE_VirtualDelay(u8Mu, u8Channel, pSrvDesc))
+        {
+            /* Canceled during its latency: the cancel request is answered first */
+            HSE_VirtualComplete(u8Mu, 0U, HSE_SRV_RSP_OK);
+            response = HSE_SRV_RSP_CANCELED;
+        }
+        HSE_VirtualComplete(u8Mu, u8Channel, response);
+    }
+
+    return NULL;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Start the virtual HSE.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualInit(void)
+{
+    uint8_t u8Mu;
+
+    pthread_mutex_lock(&deviceLock);
+    if(bDeviceRunning)
+    {
+        pthread_mutex_unlock(&deviceLock);
+        return HSE_SRV_RSP_OK;
+    }
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        u32BaseAddr[u8Mu] = (uintptr_t)virtualMu[u8Mu].regs;
+        virtualMu[u8Mu].u32PendingMask = 0UL;
+        HSE_VIRTUAL_REG(u8Mu, MU_FSR_OFFSET) = HSE_VIRTUAL_STATUS;
+        HSE_VIRTUAL_REG(u8Mu, MU_TSR_OFFSET) = HSE_VIRTUAL_CHANNEL_MASK;
+        HSE_VIRTUAL_REG(u8Mu, MU_RSR_OFFSET) = 0UL;
+        HSE_VIRTUAL_REG(u8Mu, MU_GSR_OFFSET) = 0UL;
+    }
+
+    bDeviceRunning = TRUE;
+    if(0 != pthread_create(&deviceThread, NULL, HSE_VirtualDeviceThread, NULL))
+    {
+        bDeviceRunning = FALSE;
+        pthread_mutex_unlock(&deviceLock);
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    pthread_mutex_unlock(&deviceLock);
+
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Stop the virtual HSE.
+ ******************************************************************************/
+void HSE_VirtualDeinit(void)
+{
+    pthread_mutex_lock(&deviceLock);
+    if(!bDeviceRunning)
+    {
+        pthread_mutex_unlock(&deviceLock);
+        return;
+    }
+    bDeviceRunning = FALSE;
+    pthread_cond_signal(&deviceWakeUp);
+    pthread_mutex_unlock(&deviceLock);
+
+    (void)pthread_join(deviceThread, NULL);
+}
+
+/*******************************************************************************
+ * Description   : Set the latency model of a service.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSetLatency(hseSrvId_t srvId, uint32_t u32FixedUs, uint32_t u32NsPerByte)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_OK;
+    uint32_t u32Index;
+
+    pthread_mutex_lock(&deviceLock);
+    if(HSE_VIRTUAL_SRV_ID_DEFAULT == srvId)
+    {
+        defaultLatency.u32FixedUs = u32FixedUs;
+        defaultLatency.u32NsPerByte = u32NsPerByte;
+    }
+    else
+    {
+        for(u32Index = 0UL; u32Index < u32LatencyEntries; u32Index++)
+        {
+            if(virtualLatency[u32Index].srvId == srvId)
+            {
+                break;
+            }
+        }
+
+        if(u32Index >= HSE_VIRTUAL_MAX_LATENCY_ENTRIES)
+        {
+            srvResponse = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+        }
+        else
+        {
+            virtualLatency[u32Index].srvId = srvId;
+            virtualLatency[u32Index].u32FixedUs = u32FixedUs;
+            virtualLatency[u32Index].u32NsPerByte = u32NsPerByte;
+            if(u32Index == u32LatencyEntries)
+            {
+                u32LatencyEntries++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&deviceLock);
+
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Force the response of the next requests of a service.
+ ******************************************************************************/
+void HSE_VirtualInjectResponse(hseSrvId_t srvId, hseSrvResponse_t srvResponse, uint32_t u32Count)
+{
+    pthread_mutex_lock(&deviceLock);
+    injectSrvId = srvId;
+    injectResponse = srvResponse;
+    u32InjectCount = u32Count;
+    pthread_mutex_unlock(&deviceLock);
+}
+
+/*******************************************************************************
+ * Description   : Change the HSE status bits of all MU instances (device thread).
+ ******************************************************************************/
+void HSE_VirtualSetStatus(hseStatus_t setMask, hseStatus_t clearMask)
+{
+    uint8_t u8Mu;
+
+    pthread_mutex_lock(&deviceLock);
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        HSE_VIRTUAL_REG(u8Mu, MU_FSR_OFFSET) &= ~((uint32_t)clearMask << 16U);
+        HSE_VIRTUAL_REG(u8Mu, MU_FSR_OFFSET) |= ((uint32_t)setMask << 16U);
+    }
+    pthread_mutex_unlock(&deviceLock);
+}
+
+/*******************************************************************************
+ * Description   : Read the reported HSE status.
+ ******************************************************************************/
+hseStatus_t HSE_VirtualGetStatus(void)
+{
+    hseStatus_t status;
+
+    pthread_mutex_lock(&deviceLock);
+    status = (hseStatus_t)(HSE_VIRTUAL_REG(0U, MU_FSR_OFFSET) >> 16U);
+    pthread_mutex_unlock(&deviceLock);
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Host writes TR.
+ ******************************************************************************/
+void HSE_VirtualMuSend(uint8_t u8MuInstance, uint8_t u8Channel, uintptr_t descAddr)
+{
+    pthread_mutex_lock(&deviceLock);
+    virtualMu[u8MuInstance].pendingDesc[u8Channel] = descAddr;
+    virtualMu[u8MuInstance].u32PendingMask |= (1UL << u8Channel);
+    HSE_VIRTUAL_REG(u8MuInstance, MU_TSR_OFFSET) &= ~(1UL << u8Channel);
+    HSE_VIRTUAL_REG(u8MuInstance, MU_FSR_OFFSET) |= (1UL << u8Channel);
+    pthread_cond_signal(&deviceWakeUp);
+    pthread_mutex_unlock(&deviceLock);
+}
+
+/*******************************************************************************
+ * Description   : Host reads RR.
+ ******************************************************************************/
+uint32_t HSE_VirtualMuReceive(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    uint32_t u32Response;
+
+    pthread_mutex_lock(&deviceLock);
+    u32Response = HSE_VIRTUAL_REG(u8MuInstance, MU_RR_OFFSET + ((uint32_t)u8Channel << 2U));
+    HSE_VIRTUAL_REG(u8MuInstance, MU_RSR_OFFSET) &= ~(1UL << u8Channel);
+    pthread_mutex_unlock(&deviceLock);
+
+    return u32Response;
+}
+
+/*******************************************************************************
+ * Description   : Host writes GSR (write 1 to clear).
+ ******************************************************************************/
+void HSE_VirtualMuWriteGsr(uint8_t u8MuInstance, uint32_t u32Value)
+{
+    pthread_mutex_lock(&deviceLock);
+    HSE_VIRTUAL_REG(u8MuInstance, MU_GSR_OFFSET) &= ~u32Value;
+    pthread_mutex_unlock(&deviceLock);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
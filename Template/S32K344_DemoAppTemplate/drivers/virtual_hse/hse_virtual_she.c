@@ -0,0 +1,571 @@
+/**
+*   @file    hse_virtual_she.c
+*
+*   @brief   Virtual HSE - SHE services.
+*   @details Miyaguchi-Preneel compression (SHE KDF), SHE_LOAD_KEY (memory update protocol),
+*            SHE_LOAD_PLAIN_KEY, SHE_EXPORT_RAM_KEY, SHE_GET_ID and the MASTER_ECU_KEY
+*            challenge/response of the system authorization. The device UID is all zero and
+*            SREG is always 0 (no secure boot, no debugger).
+*
+*   @addtogroup hse_virtual_srv_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_she.c
+*/
+#include <string.h>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include "hse_virtual_srv.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_VIRTUAL_SHE_KEY_LEN         (16U)
+#define HSE_VIRTUAL_SHE_UID_LEN         (15U)
+
+/* SHE key IDs */
+#define HSE_VIRTUAL_SHE_SECRET_KEY_ID   (0x0U)
+#define HSE_VIRTUAL_SHE_MASTER_KEY_ID   (0x1U)
+#define HSE_VIRTUAL_SHE_BOOT_MAC_ID     (0x3U)  /* Not a key slot */
+#define HSE_VIRTUAL_SHE_RAM_KEY_ID      (0xEU)
+
+/* SHE key flags (M2) */
+#define HSE_VIRTUAL_SHE_FLAG_WRITE_PROT     (1U << 5U)
+#define HSE_VIRTUAL_SHE_FLAG_KEY_USAGE      (1U << 2U)
+#define HSE_VIRTUAL_SHE_FLAG_VERIFY_ONLY    (1U << 0U)
+
+/* The RAM key slot of SHE */
+#define HSE_VIRTUAL_SHE_RAM_KEY_HANDLE      GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+static const uint8_t virtualSheUid[HSE_VIRTUAL_SHE_UID_LEN] = {0U};
+static const uint8_t virtualSheEmptyKey[HSE_VIRTUAL_SHE_KEY_LEN] = {0U};
+
+/* SECRET_KEY (ROM slot, device unique on the target) */
+static const uint8_t virtualSheSecretKey[HSE_VIRTUAL_SHE_KEY_LEN] =
+    {0x56U, 0x48U, 0x53U, 0x45U, 0x2DU, 0x53U, 0x45U, 0x43U, 0x52U, 0x45U, 0x54U, 0x2DU, 0x4BU, 0x45U, 0x59U, 0x00U};
+
+/* KDF constants of the SHE specification */
+static const uint8_t virtualSheEncC[HSE_VIRTUAL_SHE_KEY_LEN] =
+    {0x01U, 0x01U, 0x53U, 0x48U, 0x45U, 0x00U, 0x80U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0xB0U};
+static const uint8_t virtualSheMacC[HSE_VIRTUAL_SHE_KEY_LEN] =
+    {0x01U, 0x02U, 0x53U, 0x48U, 0x45U, 0x00U, 0x80U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0xB0U};
+static const uint8_t virtualSheDebugC[HSE_VIRTUAL_SHE_KEY_LEN] =
+    {0x01U, 0x03U, 0x53U, 0x48U, 0x45U, 0x00U, 0x80U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0xB0U};
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static hseKeyHandle_t HSE_VirtualSheHandle(hseKeyGroupIdx_t sheGroupIndex, uint8_t u8KeyId);
+static const uint8_t* HSE_VirtualSheKeyValue(hseKeyHandle_t keyHandle);
+static bool_t HSE_VirtualSheKdf(const uint8_t* pKey, const uint8_t* pConst, uint8_t* pOut);
+static bool_t HSE_VirtualSheAes(const uint8_t* pKey, const char* pMode, bool_t bEncrypt, const uint8_t* pInput,
+                                uint32_t u32Len, uint8_t* pOutput);
+static bool_t HSE_VirtualSheCmac(const uint8_t* pKey, const uint8_t* pInput, uint32_t u32Len, uint8_t* pMac);
+static bool_t HSE_VirtualSheMessages(const uint8_t* pAuthKey, uint8_t u8IdAuthId, const uint8_t* pKey,
+    uint32_t u32Counter, uint8_t u8Flags, uint8_t* pM1, uint8_t* pM2, uint8_t* pM3);
+static bool_t HSE_VirtualSheVerification(const uint8_t* pKey, uint8_t u8IdAuthId, uint32_t u32Counter,
+                                         uint8_t* pM4, uint8_t* pM5);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Key handle of a SHE key ID (HSE_INVALID_KEY_HANDLE if none).
+ ******************************************************************************/
+static hseKeyHandle_t HSE_VirtualSheHandle(hseKeyGroupIdx_t sheGroupIndex, uint8_t u8KeyId)
+{
+    if(HSE_VIRTUAL_SHE_SECRET_KEY_ID == u8KeyId)
+    {
+        return GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_ROM, 0U, 0U);
+    }
+    if(HSE_VIRTUAL_SHE_RAM_KEY_ID == u8KeyId)
+    {
+        return HSE_VIRTUAL_SHE_RAM_KEY_HANDLE;
+    }
+    if((HSE_VIRTUAL_SHE_BOOT_MAC_ID == u8KeyId) || (u8KeyId > HSE_VIRTUAL_SHE_RAM_KEY_ID))
+    {
+        return HSE_INVALID_KEY_HANDLE;
+    }
+    /* MASTER_ECU_KEY, BOOT_MAC_KEY, then KEY_1..KEY_10 after the BOOT_MAC */
+    return GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, sheGroupIndex,
+                          (u8KeyId < HSE_VIRTUAL_SHE_BOOT_MAC_ID) ? (u8KeyId - 1U) : (u8KeyId - 2U));
+}
+
+/*******************************************************************************
+ * Description   : Value of a SHE key; an empty slot reads as the all zero key.
+ ******************************************************************************/
+static const uint8_t* HSE_VirtualSheKeyValue(hseKeyHandle_t keyHandle)
+{
+    uint32_t u32KeyLen = 0UL;
+    const uint8_t* pKey;
+
+    if(GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_ROM, 0U, 0U) == keyHandle)
+    {
+        return virtualSheSecretKey;
+    }
+    pKey = HSE_VirtualSymKey(keyHandle, &u32KeyLen);
+    return ((NULL != pKey) && (HSE_VIRTUAL_SHE_KEY_LEN == u32KeyLen)) ? pKey : virtualSheEmptyKey;
+}
+
+/*******************************************************************************
+ * Description   : SHE KDF: MP(key || constant).
+ ******************************************************************************/
+static bool_t HSE_VirtualSheKdf(const uint8_t* pKey, const uint8_t* pConst, uint8_t* pOut)
+{
+    uint8_t input[2U * HSE_VIRTUAL_SHE_KEY_LEN];
+    hseSrvResponse_t srvResponse;
+
+    memcpy(input, pKey, HSE_VIRTUAL_SHE_KEY_LEN);
+    memcpy(&input[HSE_VIRTUAL_SHE_KEY_LEN], pConst, HSE_VIRTUAL_SHE_KEY_LEN);
+    srvResponse = HSE_VirtualMpCompress(input, sizeof(input), pOut);
+    OPENSSL_cleanse(input, sizeof(input));
+    return (HSE_SRV_RSP_OK == srvResponse);
+}
+
+/*******************************************************************************
+ * Description   : AES-128 ECB or CBC (IV 0) on whole blocks.
+ ******************************************************************************/
+static bool_t HSE_VirtualSheAes(const uint8_t* pKey, const char* pMode, bool_t bEncrypt, const uint8_t* pInput,
+                                uint32_t u32Len, uint8_t* pOutput)
+{
+    static const uint8_t iv[HSE_VIRTUAL_SHE_KEY_LEN] = {0U};
+    EVP_CIPHER_CTX* pCtx = EVP_CIPHER_CTX_new();
+    int outLen = 0;
+    bool_t bOk;
+
+    bOk = (NULL != pCtx) &&
+          (1 == EVP_CipherInit_ex(pCtx, HSE_VirtualAesCipher(HSE_VIRTUAL_SHE_KEY_LEN, pMode), NULL, pKey, iv,
+                                  bEncrypt ? 1 : 0)) &&
+          (1 == EVP_CIPHER_CTX_set_padding(pCtx, 0)) &&
+          (1 == EVP_CipherUpdate(pCtx, pOutput, &outLen, pInput, (int)u32Len)) &&
+          ((uint32_t)outLen == u32Len);
+    EVP_CIPHER_CTX_free(pCtx);
+    return bOk;
+}
+
+/*******************************************************************************
+ * Description   : AES-128 CMAC (16 bytes).
+ ******************************************************************************/
+static bool_t HSE_VirtualSheCmac(const uint8_t* pKey, const uint8_t* pInput, uint32_t u32Len, uint8_t* pMac)
+{
+    OSSL_PARAM params[2];
+    EVP_MAC* pMacAlgo = EVP_MAC_fetch(NULL, "CMAC", NULL);
+    EVP_MAC_CTX* pCtx = (NULL != pMacAlgo) ? EVP_MAC_CTX_new(pMacAlgo) : NULL;
+    size_t macLen = 0U;
+    bool_t bOk;
+
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, "AES-128-CBC", 0U);
+    params[1] = OSSL_PARAM_construct_end();
+    bOk = (NULL != pCtx) &&
+          (1 == EVP_MAC_init(pCtx, pKey, HSE_VIRTUAL_SHE_KEY_LEN, params)) &&
+          (1 == EVP_MAC_update(pCtx, pInput, u32Len)) &&
+          (1 == EVP_MAC_final(pCtx, pMac, &macLen, HSE_VIRTUAL_SHE_KEY_LEN));
+    EVP_MAC_CTX_free(pCtx);
+    EVP_MAC_free(pMacAlgo);
+    return bOk;
+}
+
+/*******************************************************************************
+ * Description   : M1..M3 of the memory update protocol:
+ *                 M1 = UID | ID | AuthID
+ *                 M2 = ENC_CBC,K1(counter | flags | 0... | key), K1 = KDF(K_AuthID, KEY_UPDATE_ENC_C)
+ *                 M3 = CMAC_K2(M1 | M2), K2 = KDF(K_AuthID, KEY_UPDATE_MAC_C)
+ ******************************************************************************/
+static bool_t HSE_VirtualSheMessages(const uint8_t* pAuthKey, uint8_t u8IdAuthId, const uint8_t* pKey,
+    uint32_t u32Counter, uint8_t u8Flags, uint8_t* pM1, uint8_t* pM2, uint8_t* pM3)
+{
+    uint8_t k1[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t k2[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t plain[2U * HSE_VIRTUAL_SHE_KEY_LEN] = {0U};
+    uint8_t m1m2[3U * HSE_VIRTUAL_SHE_KEY_LEN];
+    bool_t bOk;
+
+    memcpy(pM1, virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN);
+    pM1[HSE_VIRTUAL_SHE_UID_LEN] = u8IdAuthId;
+
+    plain[0] = (uint8_t)(u32Counter >> 20U);
+    plain[1] = (uint8_t)(u32Counter >> 12U);
+    plain[2] = (uint8_t)(u32Counter >> 4U);
+    plain[3] = (uint8_t)((u32Counter << 4U) | ((uint32_t)u8Flags >> 2U));
+    plain[4] = (uint8_t)(u8Flags << 6U);
+    memcpy(&plain[HSE_VIRTUAL_SHE_KEY_LEN], pKey, HSE_VIRTUAL_SHE_KEY_LEN);
+
+    bOk = HSE_VirtualSheKdf(pAuthKey, virtualSheEncC, k1) &&
+          HSE_VirtualSheKdf(pAuthKey, virtualSheMacC, k2) &&
+          HSE_VirtualSheAes(k1, "CBC", TRUE, plain, sizeof(plain), pM2);
+    if(bOk)
+    {
+        memcpy(m1m2, pM1, HSE_VIRTUAL_SHE_KEY_LEN);
+        memcpy(&m1m2[HSE_VIRTUAL_SHE_KEY_LEN], pM2, 2U * HSE_VIRTUAL_SHE_KEY_LEN);
+        bOk = HSE_VirtualSheCmac(k2, m1m2, sizeof(m1m2), pM3);
+    }
+    OPENSSL_cleanse(k1, sizeof(k1));
+    OPENSSL_cleanse(k2, sizeof(k2));
+    OPENSSL_cleanse(plain, sizeof(plain));
+    return bOk;
+}
+
+/*******************************************************************************
+ * Description   : M4/M5 of the memory update protocol, from the new key:
+ *                 M4 = UID | ID | AuthID | ENC_ECB,K3(counter | 1 | 0...)
+ *                 M5 = CMAC_K4(M4)
+ ******************************************************************************/
+static bool_t HSE_VirtualSheVerification(const uint8_t* pKey, uint8_t u8IdAuthId, uint32_t u32Counter,
+                                         uint8_t* pM4, uint8_t* pM5)
+{
+    uint8_t k3[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t k4[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t counter[HSE_VIRTUAL_SHE_KEY_LEN] = {0U};
+    bool_t bOk;
+
+    counter[0] = (uint8_t)(u32Counter >> 20U);
+    counter[1] = (uint8_t)(u32Counter >> 12U);
+    counter[2] = (uint8_t)(u32Counter >> 4U);
+    counter[3] = (uint8_t)((u32Counter << 4U) | 0x08U);
+    memcpy(pM4, virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN);
+    pM4[HSE_VIRTUAL_SHE_UID_LEN] = u8IdAuthId;
+
+    bOk = HSE_VirtualSheKdf(pKey, virtualSheEncC, k3) &&
+          HSE_VirtualSheKdf(pKey, virtualSheMacC, k4) &&
+          HSE_VirtualSheAes(k3, "ECB", TRUE, counter, sizeof(counter), &pM4[HSE_VIRTUAL_SHE_KEY_LEN]) &&
+          HSE_VirtualSheCmac(k4, pM4, 2U * HSE_VIRTUAL_SHE_KEY_LEN, pM5);
+    OPENSSL_cleanse(k3, sizeof(k3));
+    OPENSSL_cleanse(k4, sizeof(k4));
+    return bOk;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Miyaguchi-Preneel compression with AES-128 (no padding, the input
+ *                 is a multiple of 16 bytes): H(0) = 0, H(i) = E_H(i-1)(M(i)) ^ M(i) ^ H(i-1).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualMpCompress(const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pOutput)
+{
+    uint8_t hash[HSE_VIRTUAL_SHE_KEY_LEN] = {0U};
+    uint8_t block[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint32_t u32Offset;
+    uint32_t u32Index;
+
+    if((0UL == u32InputLen) || (0UL != (u32InputLen % HSE_VIRTUAL_SHE_KEY_LEN)))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    for(u32Offset = 0UL; u32Offset < u32InputLen; u32Offset += HSE_VIRTUAL_SHE_KEY_LEN)
+    {
+        if(!HSE_VirtualSheAes(hash, "ECB", TRUE, &pInput[u32Offset], HSE_VIRTUAL_SHE_KEY_LEN, block))
+        {
+            return HSE_SRV_RSP_GENERAL_ERROR;
+        }
+        for(u32Index = 0UL; u32Index < HSE_VIRTUAL_SHE_KEY_LEN; u32Index++)
+        {
+            hash[u32Index] ^= (uint8_t)(block[u32Index] ^ pInput[u32Offset + u32Index]);
+        }
+    }
+
+    memcpy(pOutput, hash, HSE_VIRTUAL_SHE_KEY_LEN);
+    OPENSSL_cleanse(hash, sizeof(hash));
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SHE_LOAD_KEY: M3 is checked with the AuthID key (an
+ *                 empty slot is the zero key); NVM keys need a greater counter.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheLoadKey(const hseSheLoadKeySrv_t* pLoadKeySrv)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_KEY_UPDATE_ERROR;
+    const uint8_t* pM1 = (const uint8_t*)HSE_VIRTUAL_PTR(pLoadKeySrv->pM1);
+    const uint8_t* pM2 = (const uint8_t*)HSE_VIRTUAL_PTR(pLoadKeySrv->pM2);
+    const uint8_t* pM3 = (const uint8_t*)HSE_VIRTUAL_PTR(pLoadKeySrv->pM3);
+    uint8_t* pM4 = (uint8_t*)HSE_VIRTUAL_PTR(pLoadKeySrv->pM4);
+    uint8_t* pM5 = (uint8_t*)HSE_VIRTUAL_PTR(pLoadKeySrv->pM5);
+    hseKeyHandle_t keyHandle;
+    hseKeyHandle_t authKeyHandle;
+    hseVirtualKey_t* pKey;
+    const uint8_t* pAuthKey;
+    uint8_t k1[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t k2[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t mac[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t m1m2[3U * HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t plain[2U * HSE_VIRTUAL_SHE_KEY_LEN];
+    uint32_t u32Counter;
+    uint8_t u8Flags;
+
+    if((NULL == pM1) || (NULL == pM2) || (NULL == pM3) || (NULL == pM4) || (NULL == pM5))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    keyHandle = HSE_VirtualSheHandle(pLoadKeySrv->sheGroupIndex, (uint8_t)(pM1[HSE_VIRTUAL_SHE_UID_LEN] >> 4U));
+    authKeyHandle = HSE_VirtualSheHandle(pLoadKeySrv->sheGroupIndex, (uint8_t)(pM1[HSE_VIRTUAL_SHE_UID_LEN] & 0x0FU));
+    if((HSE_INVALID_KEY_HANDLE == keyHandle) || (HSE_INVALID_KEY_HANDLE == authKeyHandle) ||
+       (HSE_KEY_CATALOG_ID_ROM == GET_CATALOG_ID(keyHandle)))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    if(0 != memcmp(pM1, virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN))
+    {
+        return HSE_SRV_RSP_KEY_UPDATE_ERROR;
+    }
+
+    /* M3 = CMAC_K2(M1 | M2) */
+    pAuthKey = HSE_VirtualSheKeyValue(authKeyHandle);
+    memcpy(m1m2, pM1, HSE_VIRTUAL_SHE_KEY_LEN);
+    memcpy(&m1m2[HSE_VIRTUAL_SHE_KEY_LEN], pM2, 2U * HSE_VIRTUAL_SHE_KEY_LEN);
+    if(!HSE_VirtualSheKdf(pAuthKey, virtualSheEncC, k1) || !HSE_VirtualSheKdf(pAuthKey, virtualSheMacC, k2) ||
+       !HSE_VirtualSheCmac(k2, m1m2, sizeof(m1m2), mac))
+    {
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        goto exit;
+    }
+    if(0 != CRYPTO_memcmp(mac, pM3, HSE_VIRTUAL_SHE_KEY_LEN))
+    {
+        goto exit;
+    }
+
+    /* M2 = ENC_CBC,K1(counter (28 bits) | flags (6 bits) | 0... | key) */
+    if(!HSE_VirtualSheAes(k1, "CBC", FALSE, pM2, sizeof(plain), plain))
+    {
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        goto exit;
+    }
+    u32Counter = ((uint32_t)plain[0] << 20U) | ((uint32_t)plain[1] << 12U) | ((uint32_t)plain[2] << 4U) |
+                 ((uint32_t)plain[3] >> 4U);
+    u8Flags = (uint8_t)(((plain[3] & 0x0FU) << 2U) | (plain[4] >> 6U));
+
+    pKey = HSE_VirtualFindKey(keyHandle);
+    if((NULL != pKey) && (HSE_KEY_CATALOG_ID_NVM == GET_CATALOG_ID(keyHandle)))
+    {
+        if(0U != (pKey->keyInfo.keyFlags & HSE_KF_ACCESS_WRITE_PROT))
+        {
+            srvResponse = HSE_SRV_RSP_KEY_WRITE_PROTECTED;
+            goto exit;
+        }
+        if(u32Counter <= pKey->keyInfo.keyCounter)
+        {
+            goto exit;
+        }
+    }
+
+    pKey = HSE_VirtualNewKey(keyHandle);
+    if(NULL == pKey)
+    {
+        srvResponse = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+        goto exit;
+    }
+    pKey->keyInfo.keyType = HSE_KEY_TYPE_SHE;
+    pKey->keyInfo.keyBitLen = HSE_VIRTUAL_SHE_KEY_LEN * 8U;
+    pKey->keyInfo.keyCounter = u32Counter;
+    if(0U != (u8Flags & HSE_VIRTUAL_SHE_FLAG_KEY_USAGE))
+    {
+        pKey->keyInfo.keyFlags = (0U != (u8Flags & HSE_VIRTUAL_SHE_FLAG_VERIFY_ONLY)) ?
+            HSE_KF_USAGE_VERIFY : (HSE_KF_USAGE_SIGN | HSE_KF_USAGE_VERIFY);
+    }
+    else
+    {
+        pKey->keyInfo.keyFlags = HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT;
+    }
+    if((0U != (u8Flags & HSE_VIRTUAL_SHE_FLAG_WRITE_PROT)) && (HSE_KEY_CATALOG_ID_NVM == GET_CATALOG_ID(keyHandle)))
+    {
+        pKey->keyInfo.keyFlags |= HSE_KF_ACCESS_WRITE_PROT;
+    }
+    pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = HSE_VIRTUAL_SHE_KEY_LEN;
+    memcpy(pKey->key[HSE_VIRTUAL_SYM_KEY], &plain[HSE_VIRTUAL_SHE_KEY_LEN], HSE_VIRTUAL_SHE_KEY_LEN);
+
+    srvResponse = HSE_VirtualSheVerification(pKey->key[HSE_VIRTUAL_SYM_KEY], pM1[HSE_VIRTUAL_SHE_UID_LEN],
+                                             u32Counter, pM4, pM5) ? HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+exit:
+    OPENSSL_cleanse(k1, sizeof(k1));
+    OPENSSL_cleanse(k2, sizeof(k2));
+    OPENSSL_cleanse(plain, sizeof(plain));
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SHE_LOAD_PLAIN_KEY: the RAM key, exportable afterwards.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheLoadPlainKey(const hseSheLoadPlainKeySrv_t* pLoadPlainKeySrv)
+{
+    hseVirtualKey_t* pKey;
+
+    if(0UL == pLoadPlainKeySrv->pKey)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    pKey = HSE_VirtualNewKey(HSE_VIRTUAL_SHE_RAM_KEY_HANDLE);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+
+    pKey->bPlain = TRUE;
+    pKey->keyInfo.keyType = HSE_KEY_TYPE_SHE;
+    pKey->keyInfo.keyBitLen = HSE_VIRTUAL_SHE_KEY_LEN * 8U;
+    pKey->keyInfo.keyFlags = HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT | HSE_KF_USAGE_SIGN | HSE_KF_USAGE_VERIFY;
+    pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = HSE_VIRTUAL_SHE_KEY_LEN;
+    memcpy(pKey->key[HSE_VIRTUAL_SYM_KEY], HSE_VIRTUAL_PTR(pLoadPlainKeySrv->pKey), HSE_VIRTUAL_SHE_KEY_LEN);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SHE_EXPORT_RAM_KEY: M1..M5 of the RAM key, authorized
+ *                 by the SECRET_KEY. Only a key loaded in plain can be exported.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheExportRamKey(const hseSheExportRamKeySrv_t* pExportRamKeySrv)
+{
+    const hseVirtualKey_t* pKey = HSE_VirtualFindKey(HSE_VIRTUAL_SHE_RAM_KEY_HANDLE);
+    uint8_t u8IdAuthId = (uint8_t)((HSE_VIRTUAL_SHE_RAM_KEY_ID << 4U) | HSE_VIRTUAL_SHE_SECRET_KEY_ID);
+    bool_t bOk;
+
+    if((0UL == pExportRamKeySrv->pM1) || (0UL == pExportRamKeySrv->pM2) || (0UL == pExportRamKeySrv->pM3) ||
+       (0UL == pExportRamKeySrv->pM4) || (0UL == pExportRamKeySrv->pM5))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if((NULL == pKey) || !pKey->bPlain)
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    bOk = HSE_VirtualSheMessages(virtualSheSecretKey, u8IdAuthId, pKey->key[HSE_VIRTUAL_SYM_KEY], 0UL, 0U,
+                                 (uint8_t*)HSE_VIRTUAL_PTR(pExportRamKeySrv->pM1),
+                                 (uint8_t*)HSE_VIRTUAL_PTR(pExportRamKeySrv->pM2),
+                                 (uint8_t*)HSE_VIRTUAL_PTR(pExportRamKeySrv->pM3)) &&
+          HSE_VirtualSheVerification(pKey->key[HSE_VIRTUAL_SYM_KEY], u8IdAuthId, 0UL,
+                                     (uint8_t*)HSE_VIRTUAL_PTR(pExportRamKeySrv->pM4),
+                                     (uint8_t*)HSE_VIRTUAL_PTR(pExportRamKeySrv->pM5));
+    return bOk ? HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SHE_GET_ID: UID, SREG and CMAC_MASTER_ECU_KEY(challenge |
+ *                 UID | SREG); the MAC is zero while MASTER_ECU_KEY is empty.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheGetId(const hseSheGetIdSrv_t* pGetIdSrv)
+{
+    hseKeyHandle_t masterKeyHandle = HSE_VirtualSheHandle(0U, HSE_VIRTUAL_SHE_MASTER_KEY_ID);
+    uint8_t input[2U * HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t* pMac = (uint8_t*)HSE_VIRTUAL_PTR(pGetIdSrv->pMac);
+    uint8_t* pSreg = (uint8_t*)HSE_VIRTUAL_PTR(pGetIdSrv->pSreg);
+
+    if((0UL == pGetIdSrv->pChallenge) || (0UL == pGetIdSrv->pId) || (NULL == pSreg) || (NULL == pMac))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    memcpy(HSE_VIRTUAL_PTR(pGetIdSrv->pId), virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN);
+    *pSreg = 0U;
+    if(NULL == HSE_VirtualFindKey(masterKeyHandle))
+    {
+        memset(pMac, 0, HSE_VIRTUAL_SHE_KEY_LEN);
+        return HSE_SRV_RSP_OK;
+    }
+
+    memcpy(input, HSE_VIRTUAL_PTR(pGetIdSrv->pChallenge), HSE_VIRTUAL_SHE_KEY_LEN);
+    memcpy(&input[HSE_VIRTUAL_SHE_KEY_LEN], virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN);
+    input[HSE_VIRTUAL_SHE_KEY_LEN + HSE_VIRTUAL_SHE_UID_LEN] = *pSreg;
+    return HSE_VirtualSheCmac(HSE_VirtualSheKeyValue(masterKeyHandle), input, sizeof(input), pMac) ?
+        HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+}
+
+/*******************************************************************************
+ * Description   : Challenge of a MASTER_ECU_KEY system authorization: RAND | UID
+ *                 (HSE_SYS_AUTH_CHALLENGE_LENGTH - 1 bytes).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheChallenge(uint8_t* pChallenge)
+{
+    if(1 != RAND_bytes(pChallenge, (int)HSE_VIRTUAL_SHE_KEY_LEN))
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    memcpy(&pChallenge[HSE_VIRTUAL_SHE_KEY_LEN], virtualSheUid, HSE_VIRTUAL_SHE_UID_LEN);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Response of a MASTER_ECU_KEY system authorization:
+ *                 CMAC_K(challenge), K = KDF(MASTER_ECU_KEY, DEBUG_KEY_C).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSheAuthVerify(hseKeyHandle_t ownerKeyHandle, const uint8_t* pChallenge,
+                                          const uint8_t* pAuth, uint32_t u32AuthLen)
+{
+    uint8_t authKey[HSE_VIRTUAL_SHE_KEY_LEN];
+    uint8_t mac[HSE_VIRTUAL_SHE_KEY_LEN];
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_VERIFY_FAILED;
+
+    if(HSE_VIRTUAL_SHE_KEY_LEN != u32AuthLen)
+    {
+        return HSE_SRV_RSP_VERIFY_FAILED;
+    }
+
+    if(!HSE_VirtualSheKdf(HSE_VirtualSheKeyValue(ownerKeyHandle), virtualSheDebugC, authKey) ||
+       !HSE_VirtualSheCmac(authKey, pChallenge, HSE_SYS_AUTH_CHALLENGE_LENGTH - 1UL, mac))
+    {
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    else if(0 == CRYPTO_memcmp(mac, pAuth, HSE_VIRTUAL_SHE_KEY_LEN))
+    {
+        srvResponse = HSE_SRV_RSP_OK;
+    }
+    OPENSSL_cleanse(authKey, sizeof(authKey));
+    return srvResponse;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,1437 @@
+/**
+*   @file    hse_virtual_srv.c
+*
+*   @brief   Virtual HSE - service execution.
+*   @details Decodes the service descriptors and dispatches them to the service units
+*            (hse_virtual_sym.c, hse_virtual_asym.c, hse_virtual_she.c). Owns the key store,
+*            the streams and executes the key management services (IMPORT/EXPORT, plain or
+*            wrapped in an authenticated key container, with the ECC formats, ERASE, KEY_VERIFY,
+*            GET_KEY_INFO, FORMAT_KEY_CATALOGS, KEY_DERIVE SP800-108, KEY_DERIVE_COPY),
+*            GET_RANDOM_NUM, GET/SET_ATTR, the monotonic counters, CMAC_WITH_COUNTER,
+*            PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH and IMPORT_EXPORT_STREAM_CTX.
+*            A stream step sent on another channel than its START is rejected
+*            (HSE_SRV_RSP_STREAMING_MODE_FAILURE). Unknown services answer HSE_SRV_RSP_NOT_SUPPORTED.
+*
+*   @addtogroup hse_virtual_srv_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_srv.c
+*/
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include "hse_virtual_srv.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_VIRTUAL_MAX_ATTRS       (16U)
+#define HSE_VIRTUAL_MAX_ATTR_LEN    (64U)
+
+/* Exported stream contexts kept by the emulator (one per export buffer, the oldest is dropped) */
+#define HSE_VIRTUAL_MAX_EXPORTED_STREAMS    (64U)
+#define HSE_VIRTUAL_STREAM_CTX_MAGIC        (0x53435458UL)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Emulated attribute
+ */
+typedef struct
+{
+    hseAttrId_t     attrId;
+    uint32_t        u32Len;
+    uint8_t         value[HSE_VIRTUAL_MAX_ATTR_LEN];
+} hseVirtualAttr_t;
+
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+/*
+ * @brief   Exported stream context: the blob written to the host holds its index and generation
+ */
+typedef struct
+{
+    const void*         pBlob;          /* Export buffer, NULL if the entry is free */
+    uint32_t            u32Generation;
+    uint8_t             u8MuInstance;   /* MU instance of the START */
+    hseVirtualStream_t  stream;
+} hseVirtualExportedStream_t;
+
+/*
+ * @brief   Header of the blob (MAX_STREAMING_CONTEXT_SIZE bytes)
+ */
+typedef struct
+{
+    uint32_t            u32Magic;
+    uint32_t            u32Index;
+    uint32_t            u32Generation;
+} hseVirtualStreamBlob_t;
+#endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/* Reported by HSE_FW_VERSION_ATTR_ID */
+static const hseAttrFwVersion_t virtualFwVersion =
+{
+    .reserved       = 0U,
+    .socTypeId      = (uint8_t)HSE_PLATFORM,
+    .fwTypeId       = 0U,
+    .majorVersion   = 0U,
+    .minorVersion   = 0U,
+    .patchVersion   = 0U,
+};
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseVirtualKey_t      virtualKeys[HSE_VIRTUAL_MAX_KEYS];
+static hseVirtualAttr_t     virtualAttrs[HSE_VIRTUAL_MAX_ATTRS];
+static hseVirtualStream_t   virtualStreams[HSE_NUM_OF_MU_INSTANCES][HSE_STREAM_COUNT];
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+static hseVirtualExportedStream_t virtualExported[HSE_VIRTUAL_MAX_EXPORTED_STREAMS];
+static uint32_t             u32VirtualExportGeneration = 0UL;
+#endif
+#ifdef HSE_SPT_MONOTONIC_COUNTERS
+static uint64_t             virtualCounters[HSE_NUM_OF_MONOTONIC_COUNTERS];
+static uint8_t              virtualCounterRpBits[HSE_NUM_OF_MONOTONIC_COUNTERS];
+#endif
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static hseSrvResponse_t HSE_VirtualKeyCipher(hseKeyHandle_t cipherKeyHandle, const hseCipherScheme_t* pScheme,
+    hseCipherDir_t cipherDir, const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pOutput);
+static hseSrvResponse_t HSE_VirtualKeyAuth(hseKeyHandle_t authKeyHandle, const hseAuthScheme_t* pScheme,
+    hseAuthDir_t authDir, const uint8_t* pContainer, uint32_t u32ContainerLen, uint8_t* pAuth[2], uint16_t au16AuthLen[2]);
+static hseSrvResponse_t HSE_VirtualImportKey(const hseImportKeySrv_t* pImportSrv);
+static hseSrvResponse_t HSE_VirtualExportEccPub(const hseVirtualKey_t* pKey, hseEccKeyFormat_t eccKeyFormat,
+                                                uint8_t* pOut, uint16_t* pu16KeyLen);
+static hseSrvResponse_t HSE_VirtualExportKey(const hseExportKeySrv_t* pExportSrv);
+static hseSrvResponse_t HSE_VirtualEraseKey(const hseEraseKeySrv_t* pEraseSrv);
+#ifdef HSE_SPT_KEY_VERIFY
+static hseSrvResponse_t HSE_VirtualKeyVerify(const hseKeyVerifySrv_t* pVerifySrv);
+#endif
+#ifdef HSE_SPT_KEY_DERIVE
+static hseSrvResponse_t HSE_VirtualKeyDerive(const hseKeyDeriveSrv_t* pDeriveSrv);
+static hseSrvResponse_t HSE_VirtualKeyDeriveCopy(const hseKeyDeriveCopyKeySrv_t* pCopySrv);
+#endif
+static hseSrvResponse_t HSE_VirtualGetAttr(const hseGetAttrSrv_t* pGetAttrSrv);
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+static void HSE_VirtualNvmKeyUpdated(hseKeyHandle_t keyHandle);
+#endif
+static hseSrvResponse_t HSE_VirtualSetAttr(const hseSetAttrSrv_t* pSetAttrSrv);
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+static bool_t HSE_VirtualStreamCopy(hseVirtualStream_t* pDst, const hseVirtualStream_t* pSrc);
+static hseSrvResponse_t HSE_VirtualStreamCtx(uint8_t u8MuInstance, uint8_t u8Channel,
+                                             const hseImportExportStreamCtxSrv_t* pStreamCtxSrv);
+#endif
+#ifdef HSE_SPT_MONOTONIC_COUNTERS
+static hseSrvResponse_t HSE_VirtualCounter(const hseSrvDescriptor_t* pSrvDesc);
+static hseSrvResponse_t HSE_VirtualCmacWithCounter(const hseCmacWithCounterSrv_t* pCmacSrv);
+#endif
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Key value encrypt or decrypt with a provision key (AES block
+ *                 modes or AEAD, the first byte of the scheme tells them apart).
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualKeyCipher(hseKeyHandle_t cipherKeyHandle, const hseCipherScheme_t* pScheme,
+    hseCipherDir_t cipherDir, const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pOutput)
+{
+    hseSymCipherSrv_t cipherSrv;
+    hseAeadSrv_t aeadSrv;
+
+    if((HSE_AUTH_CIPHER_MODE_CCM == pScheme->aeadCipher.authCipherMode) ||
+       (HSE_AUTH_CIPHER_MODE_GCM == pScheme->aeadCipher.authCipherMode))
+    {
+        memset(&aeadSrv, 0, sizeof(aeadSrv));
+        aeadSrv.accessMode = HSE_ACCESS_MODE_ONE_PASS;
+        aeadSrv.authCipherMode = pScheme->aeadCipher.authCipherMode;
+        aeadSrv.cipherDir = cipherDir;
+        aeadSrv.keyHandle = cipherKeyHandle;
+        aeadSrv.ivLength = pScheme->aeadCipher.ivLength;
+        aeadSrv.pIV = pScheme->aeadCipher.pIV;
+        aeadSrv.aadLength = pScheme->aeadCipher.aadLength;
+        aeadSrv.pAAD = pScheme->aeadCipher.pAAD;
+        aeadSrv.tagLength = pScheme->aeadCipher.tagLength;
+        aeadSrv.pTag = pScheme->aeadCipher.pTag;
+        aeadSrv.inputLength = u32InputLen;
+        aeadSrv.pInput = HSE_VIRTUAL_ADDR(pInput);
+        aeadSrv.pOutput = HSE_VIRTUAL_ADDR(pOutput);
+        aeadSrv.sgtOption = HSE_SGT_OPTION_NONE;
+        return HSE_VirtualAead(0U, 0U, &aeadSrv);
+    }
+    if(HSE_CIPHER_ALGO_AES != pScheme->symCipher.cipherAlgo)
+    {
+        /* RSAES key wrapping */
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    memset(&cipherSrv, 0, sizeof(cipherSrv));
+    cipherSrv.accessMode = HSE_ACCESS_MODE_ONE_PASS;
+    cipherSrv.cipherAlgo = HSE_CIPHER_ALGO_AES;
+    cipherSrv.cipherBlockMode = pScheme->symCipher.cipherBlockMode;
+    cipherSrv.cipherDir = cipherDir;
+    cipherSrv.sgtOption = HSE_SGT_OPTION_NONE;
+    cipherSrv.keyHandle = cipherKeyHandle;
+    cipherSrv.pIV = pScheme->symCipher.pIV;
+    cipherSrv.inputLength = u32InputLen;
+    cipherSrv.pInput = HSE_VIRTUAL_ADDR(pInput);
+    cipherSrv.pOutput = HSE_VIRTUAL_ADDR(pOutput);
+    return HSE_VirtualSymCipher(0U, 0U, &cipherSrv);
+}
+
+/*******************************************************************************
+ * Description   : Key container MAC or signature (generate or verify). The lengths
+ *                 are the uint16_t tag lengths of the import/export services.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualKeyAuth(hseKeyHandle_t authKeyHandle, const hseAuthScheme_t* pScheme,
+    hseAuthDir_t authDir, const uint8_t* pContainer, uint32_t u32ContainerLen, uint8_t* pAuth[2], uint16_t au16AuthLen[2])
+{
+    const hseVirtualKey_t* pAuthKey = HSE_VirtualFindKey(authKeyHandle);
+    uint8_t mac[EVP_MAX_MD_SIZE];
+    uint32_t u32MacLen = 0UL;
+    uint32_t au32SigLen[2];
+    uint32_t* pu32SigLen[2];
+    hseSrvResponse_t srvResponse;
+
+    if(NULL == pAuthKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if((NULL == pContainer) || (0UL == u32ContainerLen) || (NULL == pAuth[0]))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(HSE_VIRTUAL_IS_ASYM(pAuthKey->keyInfo.keyType))
+    {
+        au32SigLen[0] = au16AuthLen[0];
+        au32SigLen[1] = au16AuthLen[1];
+        pu32SigLen[0] = &au32SigLen[0];
+        pu32SigLen[1] = &au32SigLen[1];
+        srvResponse = HSE_VirtualSignCompute(&pScheme->sigScheme, authKeyHandle, authDir, pContainer, u32ContainerLen,
+                                             pAuth, pu32SigLen);
+        au16AuthLen[0] = (uint16_t)au32SigLen[0];
+        au16AuthLen[1] = (uint16_t)au32SigLen[1];
+        return srvResponse;
+    }
+
+    srvResponse = HSE_VirtualMacCompute(&pScheme->macScheme, authKeyHandle, pContainer, u32ContainerLen, mac, &u32MacLen);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        return srvResponse;
+    }
+    if(HSE_AUTH_DIR_VERIFY == authDir)
+    {
+        if((0U == au16AuthLen[0]) || (au16AuthLen[0] > u32MacLen))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        return (0 == CRYPTO_memcmp(mac, pAuth[0], au16AuthLen[0])) ? HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+    }
+    if(au16AuthLen[0] < u32MacLen)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    memcpy(pAuth[0], mac, u32MacLen);
+    au16AuthLen[0] = (uint16_t)u32MacLen;
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_IMPORT_KEY. The key container is verified first, then
+ *                 the private/symmetric value (pKey[2]) is decrypted if a cipher key is given.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualImportKey(const hseImportKeySrv_t* pImportSrv)
+{
+    const hseKeyInfo_t* pKeyInfo = (const hseKeyInfo_t*)HSE_VIRTUAL_PTR(pImportSrv->pKeyInfo);
+    const uint8_t* pPubKey = (const uint8_t*)HSE_VIRTUAL_PTR(pImportSrv->pKey[HSE_VIRTUAL_PUB_KEY]);
+    hseVirtualKey_t* pKey;
+    hseSrvResponse_t srvResponse;
+    uint8_t* pAuth[2];
+    uint16_t au16AuthLen[2];
+    uint32_t u32Index;
+
+    if((HSE_INVALID_KEY_HANDLE == pImportSrv->targetKeyHandle) || (NULL == pKeyInfo))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    for(u32Index = 0UL; u32Index < 3UL; u32Index++)
+    {
+        if(pImportSrv->keyLen[u32Index] > HSE_VIRTUAL_MAX_KEY_LEN)
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+    }
+
+    if(HSE_INVALID_KEY_HANDLE != pImportSrv->keyContainer.authKeyHandle)
+    {
+        pAuth[0] = (uint8_t*)HSE_VIRTUAL_PTR(pImportSrv->keyContainer.pAuth[0]);
+        pAuth[1] = (uint8_t*)HSE_VIRTUAL_PTR(pImportSrv->keyContainer.pAuth[1]);
+        au16AuthLen[0] = pImportSrv->keyContainer.authLen[0];
+        au16AuthLen[1] = pImportSrv->keyContainer.authLen[1];
+        srvResponse = HSE_VirtualKeyAuth(pImportSrv->keyContainer.authKeyHandle, &pImportSrv->keyContainer.authScheme,
+                                         HSE_AUTH_DIR_VERIFY,
+                                         (const uint8_t*)HSE_VIRTUAL_PTR(pImportSrv->keyContainer.pKeyContainer),
+                                         pImportSrv->keyContainer.keyContainerLen, pAuth, au16AuthLen);
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            return srvResponse;
+        }
+    }
+
+    pKey = HSE_VirtualNewKey(pImportSrv->targetKeyHandle);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+    memcpy(&pKey->keyInfo, pKeyInfo, sizeof(hseKeyInfo_t));
+    for(u32Index = 0UL; u32Index < 3UL; u32Index++)
+    {
+        if((0UL == pImportSrv->pKey[u32Index]) || (0U == pImportSrv->keyLen[u32Index]))
+        {
+            continue;
+        }
+        pKey->keyLen[u32Index] = pImportSrv->keyLen[u32Index];
+        memcpy(pKey->key[u32Index], HSE_VIRTUAL_PTR(pImportSrv->pKey[u32Index]), pImportSrv->keyLen[u32Index]);
+    }
+
+    srvResponse = HSE_SRV_RSP_OK;
+    if((HSE_INVALID_KEY_HANDLE != pImportSrv->cipher.cipherKeyHandle) && (0U != pKey->keyLen[HSE_VIRTUAL_SYM_KEY]))
+    {
+        /* The encrypted value may be padded: the key length is given by the key info */
+        srvResponse = HSE_VirtualKeyCipher(pImportSrv->cipher.cipherKeyHandle, &pImportSrv->cipher.cipherScheme,
+                                           HSE_CIPHER_DIR_DECRYPT,
+                                           (const uint8_t*)HSE_VIRTUAL_PTR(pImportSrv->pKey[HSE_VIRTUAL_SYM_KEY]),
+                                           pKey->keyLen[HSE_VIRTUAL_SYM_KEY], pKey->key[HSE_VIRTUAL_SYM_KEY]);
+        if(HSE_BITS_TO_BYTES(pKeyInfo->keyBitLen) < pKey->keyLen[HSE_VIRTUAL_SYM_KEY])
+        {
+            pKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)HSE_BITS_TO_BYTES(pKeyInfo->keyBitLen);
+        }
+    }
+
+    /* ECC public keys are stored raw (x || y) */
+    if((HSE_SRV_RSP_OK == srvResponse) &&
+       ((HSE_KEY_TYPE_ECC_PUB == pKeyInfo->keyType) || (HSE_KEY_TYPE_ECC_PAIR == pKeyInfo->keyType)) &&
+       (NULL != pPubKey) && (0U != pImportSrv->keyLen[HSE_VIRTUAL_PUB_KEY]))
+    {
+        if(HSE_KEY_FORMAT_ECC_PUB_UNCOMPRESSED == pImportSrv->keyFormat.eccKeyFormat)
+        {
+            if(0x04U != pPubKey[0])
+            {
+                srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+            }
+            pKey->keyLen[HSE_VIRTUAL_PUB_KEY] = pImportSrv->keyLen[HSE_VIRTUAL_PUB_KEY] - 1U;
+            memcpy(pKey->key[HSE_VIRTUAL_PUB_KEY], &pPubKey[1], pKey->keyLen[HSE_VIRTUAL_PUB_KEY]);
+        }
+        else if(HSE_KEY_FORMAT_ECC_PUB_COMPRESSED == pImportSrv->keyFormat.eccKeyFormat)
+        {
+            srvResponse = HSE_VirtualEccDecompress(pKeyInfo->specific.eccCurveId, pPubKey,
+                                                   pImportSrv->keyLen[HSE_VIRTUAL_PUB_KEY],
+                                                   pKey->key[HSE_VIRTUAL_PUB_KEY], &pKey->keyLen[HSE_VIRTUAL_PUB_KEY]);
+        }
+    }
+
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        memset(pKey, 0, sizeof(hseVirtualKey_t));
+    }
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : ECC public key in the uncompressed (0x04 || x || y) or compressed
+ *                 (0x02/0x03 || x) format.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualExportEccPub(const hseVirtualKey_t* pKey, hseEccKeyFormat_t eccKeyFormat,
+                                                uint8_t* pOut, uint16_t* pu16KeyLen)
+{
+    const uint16_t u16PubLen = pKey->keyLen[HSE_VIRTUAL_PUB_KEY];
+    const uint16_t u16CoordLen = u16PubLen / 2U;
+
+    if(HSE_KEY_FORMAT_ECC_PUB_COMPRESSED == eccKeyFormat)
+    {
+        if(*pu16KeyLen < (u16CoordLen + 1U))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        pOut[0] = (0U != (pKey->key[HSE_VIRTUAL_PUB_KEY][u16PubLen - 1U] & 0x01U)) ? 0x03U : 0x02U;
+        memcpy(&pOut[1], pKey->key[HSE_VIRTUAL_PUB_KEY], u16CoordLen);
+        *pu16KeyLen = u16CoordLen + 1U;
+    }
+    else
+    {
+        if(*pu16KeyLen < (u16PubLen + 1U))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        pOut[0] = 0x04U;
+        memcpy(&pOut[1], pKey->key[HSE_VIRTUAL_PUB_KEY], u16PubLen);
+        *pu16KeyLen = u16PubLen + 1U;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_EXPORT_KEY. Public parts are exported in plain; the
+ *                 symmetric value of an exportable key is encrypted with the cipher key
+ *                 (zero padded to the AES block), then the key container is authenticated.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualExportKey(const hseExportKeySrv_t* pExportSrv)
+{
+    hseVirtualKey_t* pKey = HSE_VirtualFindKey(pExportSrv->targetKeyHandle);
+    const bool_t bEncrypt = (HSE_INVALID_KEY_HANDLE != pExportSrv->cipher.cipherKeyHandle);
+    const bool_t bAead = bEncrypt &&
+        ((HSE_AUTH_CIPHER_MODE_CCM == pExportSrv->cipher.cipherScheme.aeadCipher.authCipherMode) ||
+         (HSE_AUTH_CIPHER_MODE_GCM == pExportSrv->cipher.cipherScheme.aeadCipher.authCipherMode));
+    uint8_t padded[HSE_VIRTUAL_MAX_KEY_LEN];
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_OK;
+    bool_t bPublic;
+    bool_t bEccPub;
+    uint16_t* pu16KeyLen;
+    uint8_t* pOut;
+    uint8_t* pAuth[2];
+    uint16_t* pu16AuthLen[2];
+    uint16_t au16AuthLen[2];
+    uint32_t u32OutLen;
+    uint32_t u32Index;
+
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+
+    bPublic = HSE_VIRTUAL_IS_ASYM(pKey->keyInfo.keyType);
+    if(!bPublic && (0U == (pKey->keyInfo.keyFlags & HSE_KF_ACCESS_EXPORTABLE)))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    /* The key information is written first: it may be part of the AEAD AAD or of the container */
+    if(0UL != pExportSrv->pKeyInfo)
+    {
+        memcpy(HSE_VIRTUAL_PTR(pExportSrv->pKeyInfo), &pKey->keyInfo, sizeof(hseKeyInfo_t));
+    }
+
+    bEccPub = ((HSE_KEY_TYPE_ECC_PUB == pKey->keyInfo.keyType) || (HSE_KEY_TYPE_ECC_PAIR == pKey->keyInfo.keyType));
+    /* The private part of key pairs (pKey[2]) is never exported */
+    for(u32Index = 0UL; (u32Index < (bPublic ? 2UL : 3UL)) && (HSE_SRV_RSP_OK == srvResponse); u32Index++)
+    {
+        pu16KeyLen = (uint16_t*)HSE_VIRTUAL_PTR(pExportSrv->pKeyLen[u32Index]);
+        pOut = (uint8_t*)HSE_VIRTUAL_PTR(pExportSrv->pKey[u32Index]);
+        if((NULL == pOut) || (NULL == pu16KeyLen))
+        {
+            continue;
+        }
+
+        if(bEccPub && (HSE_VIRTUAL_PUB_KEY == u32Index) &&
+           (HSE_KEY_FORMAT_ECC_PUB_RAW != pExportSrv->keyFormat.eccKeyFormat))
+        {
+            srvResponse = HSE_VirtualExportEccPub(pKey, pExportSrv->keyFormat.eccKeyFormat, pOut, pu16KeyLen);
+        }
+        else if(bEncrypt && (HSE_VIRTUAL_SYM_KEY == u32Index))
+        {
+            /* As on the HSE, the buffer length is checked against the key length: the zero
+               padding up to the AES block is written past it */
+            u32OutLen = bAead ? pKey->keyLen[u32Index] : ((pKey->keyLen[u32Index] + 15UL) & ~15UL);
+            if((*pu16KeyLen < pKey->keyLen[u32Index]) || (u32OutLen > sizeof(padded)))
+            {
+                srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+                continue;
+            }
+            memset(padded, 0, u32OutLen);
+            memcpy(padded, pKey->key[u32Index], pKey->keyLen[u32Index]);
+            srvResponse = HSE_VirtualKeyCipher(pExportSrv->cipher.cipherKeyHandle, &pExportSrv->cipher.cipherScheme,
+                                               HSE_CIPHER_DIR_ENCRYPT, padded, u32OutLen, pOut);
+            OPENSSL_cleanse(padded, u32OutLen);
+            *pu16KeyLen = (uint16_t)u32OutLen;
+        }
+        else
+        {
+            if(*pu16KeyLen < pKey->keyLen[u32Index])
+            {
+                srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+                continue;
+            }
+            memcpy(pOut, pKey->key[u32Index], pKey->keyLen[u32Index]);
+            *pu16KeyLen = pKey->keyLen[u32Index];
+        }
+    }
+
+    if((HSE_SRV_RSP_OK == srvResponse) && (HSE_INVALID_KEY_HANDLE != pExportSrv->keyContainer.authKeyHandle))
+    {
+        for(u32Index = 0UL; u32Index < 2UL; u32Index++)
+        {
+            pAuth[u32Index] = (uint8_t*)HSE_VIRTUAL_PTR(pExportSrv->keyContainer.pAuth[u32Index]);
+            pu16AuthLen[u32Index] = (uint16_t*)HSE_VIRTUAL_PTR(pExportSrv->keyContainer.pAuthLen[u32Index]);
+            au16AuthLen[u32Index] = (NULL != pu16AuthLen[u32Index]) ? *pu16AuthLen[u32Index] : 0U;
+        }
+        srvResponse = HSE_VirtualKeyAuth(pExportSrv->keyContainer.authKeyHandle, &pExportSrv->keyContainer.authScheme,
+                                         HSE_AUTH_DIR_GENERATE,
+                                         (const uint8_t*)HSE_VIRTUAL_PTR(pExportSrv->keyContainer.pKeyContainer),
+                                         pExportSrv->keyContainer.keyContainerLen, pAuth, au16AuthLen);
+        for(u32Index = 0UL; (u32Index < 2UL) && (HSE_SRV_RSP_OK == srvResponse); u32Index++)
+        {
+            if(NULL != pu16AuthLen[u32Index])
+            {
+                *pu16AuthLen[u32Index] = au16AuthLen[u32Index];
+            }
+        }
+    }
+
+    return srvResponse;
+}
+
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+/*******************************************************************************
+ * Description   : An NVM key written or erased stays in the RAM mirror of the
+ *                 keystore until HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH when
+ *                 HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID is set.
+ ******************************************************************************/
+static void HSE_VirtualNvmKeyUpdated(hseKeyHandle_t keyHandle)
+{
+    uint32_t u32Index;
+
+    if(HSE_KEY_CATALOG_ID_NVM != GET_CATALOG_ID(keyHandle))
+    {
+        return;
+    }
+    for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_ATTRS; u32Index++)
+    {
+        if((HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID == virtualAttrs[u32Index].attrId) &&
+           (sizeof(hsePublishNvmKeystoreRamtToFlash_t) == virtualAttrs[u32Index].u32Len) &&
+           (HSE_CFG_YES == *(const hsePublishNvmKeystoreRamtToFlash_t*)virtualAttrs[u32Index].value))
+        {
+            HSE_VirtualSetStatus(HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH, 0U);
+        }
+    }
+}
+#endif /* HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH */
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_ERASE_KEY. NVM keys need the super user rights.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualEraseKey(const hseEraseKeySrv_t* pEraseSrv)
+{
+    hseVirtualKey_t* pKey;
+    hseKeyCatalogId_t catalogId;
+    bool_t bErase;
+    uint32_t u32Index;
+
+    if(HSE_ERASE_NOT_USED == pEraseSrv->eraseKeyOptions)
+    {
+        if((HSE_KEY_CATALOG_ID_NVM == GET_CATALOG_ID(pEraseSrv->keyHandle)) && !HSE_VIRTUAL_SUPER_USER())
+        {
+            return HSE_SRV_RSP_NOT_ALLOWED;
+        }
+        pKey = HSE_VirtualFindKey(pEraseSrv->keyHandle);
+        if(NULL != pKey)
+        {
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+            HSE_VirtualNvmKeyUpdated(pKey->keyHandle);
+#endif
+            memset(pKey, 0, sizeof(hseVirtualKey_t));
+        }
+        return HSE_SRV_RSP_OK;
+    }
+
+    if((HSE_ERASE_ALL_RAM_KEYS_ON_MU_IF != pEraseSrv->eraseKeyOptions) && !HSE_VIRTUAL_SUPER_USER())
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_KEYS; u32Index++)
+    {
+        pKey = &virtualKeys[u32Index];
+        catalogId = GET_CATALOG_ID(pKey->keyHandle);
+        switch(pEraseSrv->eraseKeyOptions)
+        {
+            case HSE_ERASE_ALL_RAM_KEYS_ON_MU_IF:
+                bErase = (HSE_KEY_CATALOG_ID_RAM == catalogId);
+                break;
+            case HSE_ERASE_ALL_NVM_SYM_KEYS_ON_MU_IF:
+                bErase = (HSE_KEY_CATALOG_ID_NVM == catalogId) && !HSE_VIRTUAL_IS_ASYM(pKey->keyInfo.keyType);
+                break;
+            case HSE_ERASE_ALL_NVM_ASYM_KEYS_ON_MU_IF:
+                bErase = (HSE_KEY_CATALOG_ID_NVM == catalogId) && HSE_VIRTUAL_IS_ASYM(pKey->keyInfo.keyType);
+                break;
+            case HSE_ERASE_ALL_NVM_KEYS_ON_MU_IF:
+                bErase = (HSE_KEY_CATALOG_ID_NVM == catalogId);
+                break;
+            case HSE_ERASE_KEYGROUP_ON_MU_IF:
+                bErase = (catalogId == GET_CATALOG_ID(pEraseSrv->keyHandle)) &&
+                         (GET_GROUP_IDX(pKey->keyHandle) == GET_GROUP_IDX(pEraseSrv->keyHandle));
+                break;
+            default:
+                return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        if(pKey->bUsed && bErase)
+        {
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+            HSE_VirtualNvmKeyUpdated(pKey->keyHandle);
+#endif
+            memset(pKey, 0, sizeof(hseVirtualKey_t));
+        }
+    }
+
+    return HSE_SRV_RSP_OK;
+}
+
+#ifdef HSE_SPT_KEY_VERIFY
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_KEY_VERIFY: SHA2 or CMAC (with cmackeyHandle) of a
+ *                 symmetric key, compared with the first tagLen bytes of pTag.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualKeyVerify(const hseKeyVerifySrv_t* pVerifySrv)
+{
+    const uint8_t* pTag = (const uint8_t*)HSE_VIRTUAL_PTR(pVerifySrv->pTag);
+    const uint8_t* pKey;
+    uint8_t tag[EVP_MAX_MD_SIZE];
+    uint32_t u32KeyLen = 0UL;
+    uint32_t u32TagLen = 0UL;
+    unsigned int digestLen = 0U;
+    hseMacScheme_t scheme;
+    hseSrvResponse_t srvResponse;
+
+    if((NULL == pTag) || (pVerifySrv->tagLen < 8U))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(NULL == HSE_VirtualFindKey(pVerifySrv->keyHandle))
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    pKey = HSE_VirtualSymKey(pVerifySrv->keyHandle, &u32KeyLen);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    if(HSE_KEY_VER_CMAC == pVerifySrv->keyVerAlgo)
+    {
+        memset(&scheme, 0, sizeof(scheme));
+        scheme.macAlgo = HSE_MAC_ALGO_CMAC;
+        scheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
+        srvResponse = HSE_VirtualMacCompute(&scheme, pVerifySrv->cmackeyHandle, pKey, u32KeyLen, tag, &u32TagLen);
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            return srvResponse;
+        }
+    }
+    else if((HSE_KEY_VER_SHA256 == pVerifySrv->keyVerAlgo) || (HSE_KEY_VER_SHA384 == pVerifySrv->keyVerAlgo) ||
+            (HSE_KEY_VER_SHA512 == pVerifySrv->keyVerAlgo))
+    {
+        if(1 != EVP_Digest(pKey, u32KeyLen, tag, &digestLen, HSE_VirtualDigest((hseHashAlgo_t)pVerifySrv->keyVerAlgo),
+                           NULL))
+        {
+            return HSE_SRV_RSP_GENERAL_ERROR;
+        }
+        u32TagLen = digestLen;
+    }
+    else
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(pVerifySrv->tagLen > u32TagLen)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    return (0 == CRYPTO_memcmp(tag, pTag, pVerifySrv->tagLen)) ? HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+}
+#endif /* HSE_SPT_KEY_VERIFY */
+
+#ifdef HSE_SPT_KEY_DERIVE
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_KEY_DERIVE (SP800-108 counter mode):
+ *                 K(i) = PRF(Ks, [i] || pInfo), the key material is stored as shared secret.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualKeyDerive(const hseKeyDeriveSrv_t* pDeriveSrv)
+{
+    const hseKdfSP800_108Scheme_t* pScheme = &pDeriveSrv->sch.SP800_108;
+    const hseKdfCommonParams_t* pCommon = &pScheme->kdfCommon;
+    hseVirtualKey_t* pSrcKey = HSE_VirtualFindKey(pCommon->srcKeyHandle);
+    hseVirtualKey_t* pTargetKey;
+    uint8_t keyMat[HSE_VIRTUAL_MAX_KEY_LEN];
+    uint8_t prfInput[4U + 256U + HSE_VIRTUAL_MAX_KEY_LEN];
+    uint8_t prfOutput[EVP_MAX_MD_SIZE];
+    uint32_t u32PrfOutputLen = 0UL;
+    unsigned int digestLen = 0U;
+    uint32_t u32CounterLen;
+    uint32_t u32InputLen;
+    uint32_t u32Offset;
+    uint32_t u32Counter;
+    uint32_t u32Index;
+    hseMacScheme_t macScheme;
+    hseSrvResponse_t srvResponse;
+
+    if((HSE_KDF_ALGO_SP800_108 != pDeriveSrv->kdfAlgo) || (HSE_KDF_SP800_108_COUNTER != pScheme->mode))
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+    if(NULL == pSrcKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if(0U == (pSrcKey->keyInfo.keyFlags & HSE_KF_USAGE_DERIVE))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    if((0U == pCommon->keyMatLen) || (pCommon->keyMatLen > HSE_VIRTUAL_MAX_KEY_LEN) || (pCommon->infoLength > 256UL))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    u32CounterLen = (HSE_KDF_SP800_108_COUNTER_LEN_DEFAULT == pScheme->counterByteLength) ?
+                    4UL : (uint32_t)pScheme->counterByteLength;
+    if(u32CounterLen > 4UL)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    memset(&macScheme, 0, sizeof(macScheme));
+    switch(pCommon->kdfPrf)
+    {
+        case HSE_KDF_PRF_CMAC:
+            macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
+            macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
+            break;
+        case HSE_KDF_PRF_HMAC:
+            macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
+            macScheme.sch.hmac.hashAlgo = pCommon->prfAlgo.hmacHash;
+            break;
+        case HSE_KDF_PRF_HASH:
+            if(NULL == HSE_VirtualDigest(pCommon->prfAlgo.hash))
+            {
+                return HSE_SRV_RSP_NOT_SUPPORTED;
+            }
+            break;
+        default:
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    for(u32Offset = 0UL, u32Counter = 1UL; u32Offset < pCommon->keyMatLen; u32Counter++)
+    {
+        /* [i] is big endian on counterByteLength bytes */
+        for(u32Index = 0UL; u32Index < u32CounterLen; u32Index++)
+        {
+            prfInput[u32Index] = (uint8_t)(u32Counter >> (8UL * (u32CounterLen - 1UL - u32Index)));
+        }
+        u32InputLen = u32CounterLen;
+        if(HSE_KDF_PRF_HASH == pCommon->kdfPrf)
+        {
+            /* Hash PRF: H([i] || secret || info) */
+            memcpy(&prfInput[u32InputLen], pSrcKey->key[HSE_VIRTUAL_SYM_KEY], pSrcKey->keyLen[HSE_VIRTUAL_SYM_KEY]);
+            u32InputLen += pSrcKey->keyLen[HSE_VIRTUAL_SYM_KEY];
+        }
+        memcpy(&prfInput[u32InputLen], HSE_VIRTUAL_PTR(pCommon->pInfo), pCommon->infoLength);
+        u32InputLen += pCommon->infoLength;
+
+        if(HSE_KDF_PRF_HASH == pCommon->kdfPrf)
+        {
+            srvResponse = (1 == EVP_Digest(prfInput, u32InputLen, prfOutput, &digestLen,
+                                           HSE_VirtualDigest(pCommon->prfAlgo.hash), NULL)) ?
+                          HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+            u32PrfOutputLen = digestLen;
+        }
+        else
+        {
+            srvResponse = HSE_VirtualMacCompute(&macScheme, pCommon->srcKeyHandle, prfInput, u32InputLen,
+                                                prfOutput, &u32PrfOutputLen);
+        }
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            return srvResponse;
+        }
+
+        u32Index = pCommon->keyMatLen - u32Offset;
+        if(u32Index > u32PrfOutputLen)
+        {
+            u32Index = u32PrfOutputLen;
+        }
+        memcpy(&keyMat[u32Offset], prfOutput, u32Index);
+        u32Offset += u32Index;
+    }
+
+    pTargetKey = HSE_VirtualNewKey(pCommon->targetKeyHandle);
+    if(NULL == pTargetKey)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+    pTargetKey->keyInfo.keyType = HSE_KEY_TYPE_SHARED_SECRET;
+    pTargetKey->keyInfo.keyFlags = pSrcKey->keyInfo.keyFlags;
+    pTargetKey->keyInfo.keyBitLen = (uint16_t)(pCommon->keyMatLen * 8U);
+    pTargetKey->keyLen[HSE_VIRTUAL_SYM_KEY] = pCommon->keyMatLen;
+    memcpy(pTargetKey->key[HSE_VIRTUAL_SYM_KEY], keyMat, pCommon->keyMatLen);
+    OPENSSL_cleanse(keyMat, sizeof(keyMat));
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_KEY_DERIVE_COPY: extract a key from derived key material.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualKeyDeriveCopy(const hseKeyDeriveCopyKeySrv_t* pCopySrv)
+{
+    hseVirtualKey_t* pSrcKey = HSE_VirtualFindKey(pCopySrv->keyHandle);
+    hseVirtualKey_t* pTargetKey;
+    uint32_t u32KeyLen = ((uint32_t)pCopySrv->keyInfo.keyBitLen + 7UL) / 8UL;
+
+    if(NULL == pSrcKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    if((HSE_KEY_TYPE_SHARED_SECRET != pSrcKey->keyInfo.keyType) || HSE_VIRTUAL_IS_ASYM(pCopySrv->keyInfo.keyType))
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+    if((0UL == u32KeyLen) || (((uint32_t)pCopySrv->startOffset + u32KeyLen) > pSrcKey->keyLen[HSE_VIRTUAL_SYM_KEY]))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pTargetKey = HSE_VirtualNewKey(pCopySrv->targetKeyHandle);
+    if(NULL == pTargetKey)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+    memcpy(&pTargetKey->keyInfo, &pCopySrv->keyInfo, sizeof(hseKeyInfo_t));
+    pTargetKey->keyLen[HSE_VIRTUAL_SYM_KEY] = (uint16_t)u32KeyLen;
+    memcpy(pTargetKey->key[HSE_VIRTUAL_SYM_KEY], &pSrcKey->key[HSE_VIRTUAL_SYM_KEY][pCopySrv->startOffset], u32KeyLen);
+    return HSE_SRV_RSP_OK;
+}
+#endif /* HSE_SPT_KEY_DERIVE */
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_GET_ATTR.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualGetAttr(const hseGetAttrSrv_t* pGetAttrSrv)
+{
+    uint32_t u32Index;
+
+    if(HSE_FW_VERSION_ATTR_ID == pGetAttrSrv->attrId)
+    {
+        if(pGetAttrSrv->attrLen < sizeof(hseAttrFwVersion_t))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        memcpy(HSE_VIRTUAL_PTR(pGetAttrSrv->pAttr), &virtualFwVersion, sizeof(hseAttrFwVersion_t));
+        return HSE_SRV_RSP_OK;
+    }
+
+    /* Attributes never set read as zero */
+    memset(HSE_VIRTUAL_PTR(pGetAttrSrv->pAttr), 0, pGetAttrSrv->attrLen);
+    for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_ATTRS; u32Index++)
+    {
+        if((pGetAttrSrv->attrId == virtualAttrs[u32Index].attrId) && (0UL != virtualAttrs[u32Index].u32Len))
+        {
+            memcpy(HSE_VIRTUAL_PTR(pGetAttrSrv->pAttr), virtualAttrs[u32Index].value,
+                   (pGetAttrSrv->attrLen < virtualAttrs[u32Index].u32Len) ? pGetAttrSrv->attrLen : virtualAttrs[u32Index].u32Len);
+            break;
+        }
+    }
+
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SET_ATTR.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualSetAttr(const hseSetAttrSrv_t* pSetAttrSrv)
+{
+    hseVirtualAttr_t* pAttr = NULL;
+    uint32_t u32Index;
+
+    if((HSE_FW_VERSION_ATTR_ID == pSetAttrSrv->attrId) || (pSetAttrSrv->attrLen > HSE_VIRTUAL_MAX_ATTR_LEN))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_ATTRS; u32Index++)
+    {
+        if((pSetAttrSrv->attrId == virtualAttrs[u32Index].attrId) || (0UL == virtualAttrs[u32Index].u32Len))
+        {
+            pAttr = &virtualAttrs[u32Index];
+            break;
+        }
+    }
+    if(NULL == pAttr)
+    {
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+
+    pAttr->attrId = pSetAttrSrv->attrId;
+    pAttr->u32Len = pSetAttrSrv->attrLen;
+    memcpy(pAttr->value, HSE_VIRTUAL_PTR(pSetAttrSrv->pAttr), pSetAttrSrv->attrLen);
+    return HSE_SRV_RSP_OK;
+}
+
+#ifdef HSE_SPT_MONOTONIC_COUNTERS
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_CONFIG_COUNTER, INCREMENT_COUNTER and READ_COUNTER.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualCounter(const hseSrvDescriptor_t* pSrvDesc)
+{
+    uint32_t u32CounterIdx;
+
+    switch(pSrvDesc->srvId)
+    {
+        case HSE_SRV_ID_CONFIG_COUNTER:
+            u32CounterIdx = pSrvDesc->hseSrv.configSecCounter.counterIndex;
+            if((u32CounterIdx >= HSE_NUM_OF_MONOTONIC_COUNTERS) || (pSrvDesc->hseSrv.configSecCounter.RPBitSize > 64U))
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            virtualCounters[u32CounterIdx] = 0ULL;
+            virtualCounterRpBits[u32CounterIdx] = pSrvDesc->hseSrv.configSecCounter.RPBitSize;
+            return HSE_SRV_RSP_OK;
+        case HSE_SRV_ID_INCREMENT_COUNTER:
+            u32CounterIdx = pSrvDesc->hseSrv.incCounterReq.counterIndex;
+            if(u32CounterIdx >= HSE_NUM_OF_MONOTONIC_COUNTERS)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            if((UINT64_MAX - virtualCounters[u32CounterIdx]) < pSrvDesc->hseSrv.incCounterReq.value)
+            {
+                return HSE_SRV_RSP_COUNTER_OVERFLOW;
+            }
+            virtualCounters[u32CounterIdx] += pSrvDesc->hseSrv.incCounterReq.value;
+            return HSE_SRV_RSP_OK;
+        default:
+            u32CounterIdx = pSrvDesc->hseSrv.readCounterReq.counterIndex;
+            if(u32CounterIdx >= HSE_NUM_OF_MONOTONIC_COUNTERS)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            memcpy(HSE_VIRTUAL_PTR(pSrvDesc->hseSrv.readCounterReq.pCounterVal),
+                   &virtualCounters[u32CounterIdx], sizeof(uint64_t));
+            return HSE_SRV_RSP_OK;
+    }
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_CMAC_WITH_COUNTER: CMAC of (input || SC), SC big endian.
+ *                 The volatile counter is read/written in host byte order.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualCmacWithCounter(const hseCmacWithCounterSrv_t* pCmacSrv)
+{
+    uint8_t* pVolatileCounter = (uint8_t*)HSE_VIRTUAL_PTR(pCmacSrv->pVolatileCounter);
+    uint8_t macInput[HSE_VIRTUAL_MAX_KEY_LEN + sizeof(uint64_t)];
+    uint8_t mac[EVP_MAX_MD_SIZE];
+    uint32_t u32MacLen = 0UL;
+    uint32_t u32InputLen = pCmacSrv->inputBitLength / 8UL;
+    uint32_t u32TagLen = ((uint32_t)pCmacSrv->tagBitLength + 7UL) / 8UL;
+    uint32_t u32VcBytes;
+    uint32_t u32Index;
+    uint64_t u64VcMask;
+    uint64_t u64Vci = 0ULL;
+    uint64_t u64Counter;
+    hseMacScheme_t scheme;
+    hseSrvResponse_t srvResponse;
+
+    if(pCmacSrv->counterIdx >= HSE_NUM_OF_MONOTONIC_COUNTERS)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if((HSE_SGT_OPTION_NONE != pCmacSrv->sgtOption) || (0UL != (pCmacSrv->inputBitLength % 8UL)))
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+    if((u32InputLen > HSE_VIRTUAL_MAX_KEY_LEN) || (0UL == u32TagLen) || (NULL == pVolatileCounter))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    u32VcBytes = (64UL - virtualCounterRpBits[pCmacSrv->counterIdx] + 7UL) / 8UL;
+    u64VcMask = (64U == virtualCounterRpBits[pCmacSrv->counterIdx]) ? 0ULL :
+                ((~0ULL) >> virtualCounterRpBits[pCmacSrv->counterIdx]);
+
+    if(HSE_AUTH_DIR_GENERATE == pCmacSrv->authDir)
+    {
+        if(UINT64_MAX == virtualCounters[pCmacSrv->counterIdx])
+        {
+            return HSE_SRV_RSP_COUNTER_OVERFLOW;
+        }
+        u64Counter = virtualCounters[pCmacSrv->counterIdx] + 1ULL;
+    }
+    else
+    {
+        for(u32Index = 0UL; u32Index < u32VcBytes; u32Index++)
+        {
+            u64Vci |= (uint64_t)pVolatileCounter[u32Index] << (8UL * u32Index);
+        }
+        u64Vci &= u64VcMask;
+        /* ISC = (RP + RPO) || VCI, with RP + 1 when the volatile counter wrapped */
+        u64Counter = (virtualCounters[pCmacSrv->counterIdx] & ~u64VcMask) +
+                     ((uint64_t)pCmacSrv->RPOffset * (u64VcMask + 1ULL));
+        if(u64Vci <= (virtualCounters[pCmacSrv->counterIdx] & u64VcMask))
+        {
+            u64Counter += (u64VcMask + 1ULL);
+        }
+        u64Counter |= u64Vci;
+    }
+
+    memcpy(macInput, HSE_VIRTUAL_PTR(pCmacSrv->pInput), u32InputLen);
+    for(u32Index = 0UL; u32Index < sizeof(uint64_t); u32Index++)
+    {
+        macInput[u32InputLen + u32Index] = (uint8_t)(u64Counter >> (8UL * (7UL - u32Index)));
+    }
+
+    memset(&scheme, 0, sizeof(scheme));
+    scheme.macAlgo = HSE_MAC_ALGO_CMAC;
+    scheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
+    srvResponse = HSE_VirtualMacCompute(&scheme, pCmacSrv->keyHandle, macInput, u32InputLen + sizeof(uint64_t),
+                                        mac, &u32MacLen);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        return srvResponse;
+    }
+    if(u32TagLen > u32MacLen)
+    {
+        u32TagLen = u32MacLen;
+    }
+
+    if(HSE_AUTH_DIR_GENERATE == pCmacSrv->authDir)
+    {
+        memcpy(HSE_VIRTUAL_PTR(pCmacSrv->pTag), mac, u32TagLen);
+        for(u32Index = 0UL; u32Index < u32VcBytes; u32Index++)
+        {
+            pVolatileCounter[u32Index] = (uint8_t)((u64Counter & u64VcMask) >> (8UL * u32Index));
+        }
+    }
+    else if(0 != CRYPTO_memcmp(HSE_VIRTUAL_PTR(pCmacSrv->pTag), mac, u32TagLen))
+    {
+        return HSE_SRV_RSP_VERIFY_FAILED;
+    }
+
+    virtualCounters[pCmacSrv->counterIdx] = u64Counter;
+    return HSE_SRV_RSP_OK;
+}
+#endif /* HSE_SPT_MONOTONIC_COUNTERS */
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Find the slot of a key handle.
+ ******************************************************************************/
+hseVirtualKey_t* HSE_VirtualFindKey(hseKeyHandle_t keyHandle)
+{
+    uint32_t u32Index;
+
+    for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_KEYS; u32Index++)
+    {
+        if(virtualKeys[u32Index].bUsed && (keyHandle == virtualKeys[u32Index].keyHandle))
+        {
+            return &virtualKeys[u32Index];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Description   : Empty slot for a key handle (its current value is overwritten).
+ ******************************************************************************/
+hseVirtualKey_t* HSE_VirtualNewKey(hseKeyHandle_t keyHandle)
+{
+    hseVirtualKey_t* pKey = HSE_VirtualFindKey(keyHandle);
+    uint32_t u32Index;
+
+    for(u32Index = 0UL; (NULL == pKey) && (u32Index < HSE_VIRTUAL_MAX_KEYS); u32Index++)
+    {
+        if(!virtualKeys[u32Index].bUsed)
+        {
+            pKey = &virtualKeys[u32Index];
+        }
+    }
+
+    if(NULL != pKey)
+    {
+        memset(pKey, 0, sizeof(hseVirtualKey_t));
+        pKey->keyHandle = keyHandle;
+        pKey->bUsed = TRUE;
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+        HSE_VirtualNvmKeyUpdated(keyHandle);
+#endif
+    }
+    return pKey;
+}
+
+/*******************************************************************************
+ * Description   : Symmetric key value of a key handle (NULL if empty).
+ ******************************************************************************/
+const uint8_t* HSE_VirtualSymKey(hseKeyHandle_t keyHandle, uint32_t* pu32KeyLen)
+{
+    hseVirtualKey_t* pKey = HSE_VirtualFindKey(keyHandle);
+
+    if(NULL == pKey)
+    {
+        return NULL;
+    }
+
+    *pu32KeyLen = pKey->keyLen[HSE_VIRTUAL_SYM_KEY];
+    return pKey->key[HSE_VIRTUAL_SYM_KEY];
+}
+
+/*******************************************************************************
+ * Description   : Open a stream (START step), a stream still open is restarted.
+ ******************************************************************************/
+hseVirtualStream_t* HSE_VirtualStreamStart(uint8_t u8MuInstance, uint8_t u8Channel, hseStreamId_t streamId,
+                                           hseSrvId_t srvId)
+{
+    hseVirtualStream_t* pStream;
+
+    if(streamId >= HSE_STREAM_COUNT)
+    {
+        return NULL;
+    }
+
+    pStream = &virtualStreams[u8MuInstance][streamId];
+    HSE_VirtualStreamEnd(pStream);
+    pStream->srvId = srvId;
+    pStream->u8Channel = u8Channel;
+    return pStream;
+}
+
+/*******************************************************************************
+ * Description   : Stream of an UPDATE/FINISH step. It must have been started by
+ *                 the same service on the same channel.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualStreamGet(uint8_t u8MuInstance, uint8_t u8Channel, hseStreamId_t streamId,
+                                      hseSrvId_t srvId, hseVirtualStream_t** ppStream)
+{
+    hseVirtualStream_t* pStream;
+
+    if(streamId >= HSE_STREAM_COUNT)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pStream = &virtualStreams[u8MuInstance][streamId];
+    if((srvId != pStream->srvId) || (u8Channel != pStream->u8Channel))
+    {
+        return HSE_SRV_RSP_STREAMING_MODE_FAILURE;
+    }
+
+    *ppStream = pStream;
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Close a stream (FINISH step or failure).
+ ******************************************************************************/
+void HSE_VirtualStreamEnd(hseVirtualStream_t* pStream)
+{
+    EVP_MD_CTX_free(pStream->pMdCtx);
+    EVP_MAC_CTX_free(pStream->pMacCtx);
+    EVP_CIPHER_CTX_free(pStream->pCipherCtx);
+    memset(pStream, 0, sizeof(hseVirtualStream_t));
+}
+
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+/*******************************************************************************
+ * Description   : Duplicate the state of a stream (pDst closed).
+ ******************************************************************************/
+static bool_t HSE_VirtualStreamCopy(hseVirtualStream_t* pDst, const hseVirtualStream_t* pSrc)
+{
+    *pDst = *pSrc;
+    pDst->pMdCtx = NULL;
+    pDst->pMacCtx = NULL;
+    pDst->pCipherCtx = NULL;
+
+    if(NULL != pSrc->pMdCtx)
+    {
+        pDst->pMdCtx = EVP_MD_CTX_new();
+        if((NULL == pDst->pMdCtx) || (1 != EVP_MD_CTX_copy_ex(pDst->pMdCtx, pSrc->pMdCtx)))
+        {
+            return FALSE;
+        }
+    }
+    if(NULL != pSrc->pMacCtx)
+    {
+        pDst->pMacCtx = EVP_MAC_CTX_dup(pSrc->pMacCtx);
+        if(NULL == pDst->pMacCtx)
+        {
+            return FALSE;
+        }
+    }
+    if(NULL != pSrc->pCipherCtx)
+    {
+        pDst->pCipherCtx = EVP_CIPHER_CTX_new();
+        if((NULL == pDst->pCipherCtx) || (1 != EVP_CIPHER_CTX_copy(pDst->pCipherCtx, pSrc->pCipherCtx)))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX. The contexts stay in the
+ *                 emulator, the blob only refers to them: an export reuses the
+ *                 entry of its buffer, an import requires the last blob exported
+ *                 to that buffer and continues the stream on the import channel.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualStreamCtx(uint8_t u8MuInstance, uint8_t u8Channel,
+                                             const hseImportExportStreamCtxSrv_t* pStreamCtxSrv)
+{
+    uint8_t* pBlobBytes = (uint8_t*)HSE_VIRTUAL_PTR(pStreamCtxSrv->pStreamContext);
+    hseVirtualStreamBlob_t blob;
+    hseVirtualExportedStream_t* pEntry;
+    hseVirtualStream_t* pStream;
+    uint32_t u32Index;
+
+    if((NULL == pBlobBytes) || (pStreamCtxSrv->streamId >= HSE_STREAM_COUNT))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    pStream = &virtualStreams[u8MuInstance][pStreamCtxSrv->streamId];
+
+    if(HSE_EXPORT_STREAMING_CONTEXT == pStreamCtxSrv->operation)
+    {
+        if(0UL == pStream->srvId)
+        {
+            return HSE_SRV_RSP_STREAMING_MODE_FAILURE;
+        }
+
+        /* Entry of the buffer, else a free one, else the oldest export */
+        pEntry = &virtualExported[0U];
+        for(u32Index = 0UL; u32Index < HSE_VIRTUAL_MAX_EXPORTED_STREAMS; u32Index++)
+        {
+            if(virtualExported[u32Index].pBlob == pBlobBytes)
+            {
+                pEntry = &virtualExported[u32Index];
+                break;
+            }
+            /* A free entry has generation 0 */
+            if(virtualExported[u32Index].u32Generation < pEntry->u32Generation)
+            {
+                pEntry = &virtualExported[u32Index];
+            }
+        }
+
+        HSE_VirtualStreamEnd(&pEntry->stream);
+        pEntry->pBlob = NULL;
+        pEntry->u32Generation = 0UL;
+        if(!HSE_VirtualStreamCopy(&pEntry->stream, pStream))
+        {
+            HSE_VirtualStreamEnd(&pEntry->stream);
+            return HSE_SRV_RSP_GENERAL_ERROR;
+        }
+        pEntry->pBlob = pBlobBytes;
+        pEntry->u32Generation = ++u32VirtualExportGeneration;
+        pEntry->u8MuInstance = u8MuInstance;
+
+        blob.u32Magic = HSE_VIRTUAL_STREAM_CTX_MAGIC;
+        blob.u32Index = (uint32_t)(pEntry - virtualExported);
+        blob.u32Generation = pEntry->u32Generation;
+        memset(pBlobBytes, 0, MAX_STREAMING_CONTEXT_SIZE);
+        memcpy(pBlobBytes, &blob, sizeof(blob));
+        return HSE_SRV_RSP_OK;
+    }
+
+    if(HSE_IMPORT_STREAMING_CONTEXT == pStreamCtxSrv->operation)
+    {
+        memcpy(&blob, pBlobBytes, sizeof(blob));
+        if((HSE_VIRTUAL_STREAM_CTX_MAGIC != blob.u32Magic) || (blob.u32Index >= HSE_VIRTUAL_MAX_EXPORTED_STREAMS))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        pEntry = &virtualExported[blob.u32Index];
+        if((pEntry->pBlob != pBlobBytes) || (pEntry->u32Generation != blob.u32Generation) ||
+           (pEntry->u8MuInstance != u8MuInstance))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+
+        HSE_VirtualStreamEnd(pStream);
+        if(!HSE_VirtualStreamCopy(pStream, &pEntry->stream))
+        {
+            HSE_VirtualStreamEnd(pStream);
+            return HSE_SRV_RSP_GENERAL_ERROR;
+        }
+        pStream->u8Channel = u8Channel;
+        return HSE_SRV_RSP_OK;
+    }
+
+    return HSE_SRV_RSP_INVALID_PARAM;
+}
+#endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
+
+/*******************************************************************************
+ * Description   : Execute a service request.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualExecute(uint8_t u8MuInstance, uint8_t u8Channel, const hseSrvDescriptor_t* pSrvDesc)
+{
+    hseVirtualKey_t* pKey;
+
+    switch(pSrvDesc->srvId)
+    {
+        case HSE_SRV_ID_HASH:
+            return HSE_VirtualHash(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.hashReq);
+        case HSE_SRV_ID_MAC:
+            return HSE_VirtualMac(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.macReq);
+        case HSE_SRV_ID_FAST_CMAC:
+            return HSE_VirtualFastCmac(&pSrvDesc->hseSrv.fastCmacReq);
+        case HSE_SRV_ID_SYM_CIPHER:
+            return HSE_VirtualSymCipher(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.symCipherReq);
+        case HSE_SRV_ID_AEAD:
+            return HSE_VirtualAead(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.aeadReq);
+        case HSE_SRV_ID_SIGN:
+            return HSE_VirtualSign(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.signReq);
+        case HSE_SRV_ID_GET_RANDOM_NUM:
+            return (1 == RAND_bytes((uint8_t*)HSE_VIRTUAL_PTR(pSrvDesc->hseSrv.getRandomNumReq.pRandomNum),
+                                    (int)pSrvDesc->hseSrv.getRandomNumReq.randomNumLength)) ?
+                HSE_SRV_RSP_OK : HSE_SRV_RSP_GENERAL_ERROR;
+        case HSE_SRV_ID_IMPORT_KEY:
+            return HSE_VirtualImportKey(&pSrvDesc->hseSrv.importKeyReq);
+        case HSE_SRV_ID_EXPORT_KEY:
+            return HSE_VirtualExportKey(&pSrvDesc->hseSrv.exportKeyReq);
+        case HSE_SRV_ID_ERASE_KEY:
+            return HSE_VirtualEraseKey(&pSrvDesc->hseSrv.eraseKeyReq);
+#ifdef HSE_SPT_KEY_VERIFY
+        case HSE_SRV_ID_KEY_VERIFY:
+            return HSE_VirtualKeyVerify(&pSrvDesc->hseSrv.verifyKeyReq);
+#endif
+        case HSE_SRV_ID_GET_KEY_INFO:
+            pKey = HSE_VirtualFindKey(pSrvDesc->hseSrv.getKeyInfoReq.keyHandle);
+            if(NULL == pKey)
+            {
+                return HSE_SRV_RSP_KEY_EMPTY;
+            }
+            memcpy(HSE_VIRTUAL_PTR(pSrvDesc->hseSrv.getKeyInfoReq.pKeyInfo), &pKey->keyInfo, sizeof(hseKeyInfo_t));
+            return HSE_SRV_RSP_OK;
+        case HSE_SRV_ID_FORMAT_KEY_CATALOGS:
+            memset(virtualKeys, 0, sizeof(virtualKeys));
+            HSE_VirtualSetStatus(HSE_STATUS_INSTALL_OK, 0U);
+            return HSE_SRV_RSP_OK;
+        case HSE_SRV_ID_KEY_GENERATE:
+            return HSE_VirtualKeyGenerate(&pSrvDesc->hseSrv.keyGenReq);
+        case HSE_SRV_ID_DH_COMPUTE_SHARED_SECRET:
+            return HSE_VirtualDhCompute(&pSrvDesc->hseSrv.dhComputeSecretReq);
+#ifdef HSE_SPT_ECC_USER_CURVES
+        case HSE_SRV_ID_LOAD_ECC_CURVE:
+            return HSE_VirtualLoadEccCurve(&pSrvDesc->hseSrv.loadEccCurveReq);
+#endif
+#ifdef HSE_SPT_BURMESTER_DESMEDT
+        case HSE_SRV_ID_BURMESTER_DESMEDT:
+            return HSE_VirtualBurmesterDesmedt(&pSrvDesc->hseSrv.burmesterDesmedtReq);
+#endif
+#ifdef HSE_SPT_KEY_DERIVE
+        case HSE_SRV_ID_KEY_DERIVE:
+            return HSE_VirtualKeyDerive(&pSrvDesc->hseSrv.keyDeriveReq);
+        case HSE_SRV_ID_KEY_DERIVE_COPY:
+            return HSE_VirtualKeyDeriveCopy(&pSrvDesc->hseSrv.keyDeriveCopyKeyReq);
+#endif
+#ifdef HSE_SPT_SHE
+        case HSE_SRV_ID_SHE_LOAD_KEY:
+            return HSE_VirtualSheLoadKey(&pSrvDesc->hseSrv.sheLoadKeyReq);
+        case HSE_SRV_ID_SHE_LOAD_PLAIN_KEY:
+            return HSE_VirtualSheLoadPlainKey(&pSrvDesc->hseSrv.sheLoadPlainKeyReq);
+        case HSE_SRV_ID_SHE_EXPORT_RAM_KEY:
+            return HSE_VirtualSheExportRamKey(&pSrvDesc->hseSrv.sheExportRamKeyReq);
+        case HSE_SRV_ID_SHE_GET_ID:
+            return HSE_VirtualSheGetId(&pSrvDesc->hseSrv.sheGetIdReq);
+#endif
+        case HSE_SRV_ID_SYS_AUTH_REQ:
+            return HSE_VirtualSysAuthReq(&pSrvDesc->hseSrv.sysAuthorizationReq);
+        case HSE_SRV_ID_SYS_AUTH_RESP:
+            return HSE_VirtualSysAuthResp(&pSrvDesc->hseSrv.sysAuthorizationResp);
+        case HSE_SRV_ID_GET_ATTR:
+            return HSE_VirtualGetAttr(&pSrvDesc->hseSrv.getAttrReq);
+        case HSE_SRV_ID_SET_ATTR:
+            return HSE_VirtualSetAttr(&pSrvDesc->hseSrv.setAttrReq);
+#ifdef HSE_SPT_MONOTONIC_COUNTERS
+        case HSE_SRV_ID_CONFIG_COUNTER:
+        case HSE_SRV_ID_INCREMENT_COUNTER:
+        case HSE_SRV_ID_READ_COUNTER:
+            return HSE_VirtualCounter(pSrvDesc);
+        case HSE_SRV_ID_CMAC_WITH_COUNTER:
+            return HSE_VirtualCmacWithCounter(&pSrvDesc->hseSrv.cmacWithCounterReq);
+#endif /* HSE_SPT_MONOTONIC_COUNTERS */
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+        case HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH:
+            /* The NVM keys are kept in RAM by the emulator: nothing to write */
+            HSE_VirtualSetStatus(0U, HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH);
+            return HSE_SRV_RSP_OK;
+#endif
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+        case HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX:
+            return HSE_VirtualStreamCtx(u8MuInstance, u8Channel, &pSrvDesc->hseSrv.importExportStreamCtx);
+#endif
+        case HSE_SRV_ID_CANCEL:
+            /* The running request is canceled during its latency, a queued one before it starts
+             * (hse_virtual_mu.c): the target request has already completed */
+            return HSE_SRV_RSP_CANCEL_FAILURE;
+        default:
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+}
+
+/*******************************************************************************
+ * Description   : Input length of a request (latency model).
+ ******************************************************************************/
+uint32_t HSE_VirtualInputLength(const hseSrvDescriptor_t* pSrvDesc)
+{
+    switch(pSrvDesc->srvId)
+    {
+        case HSE_SRV_ID_HASH:           return pSrvDesc->hseSrv.hashReq.inputLength;
+        case HSE_SRV_ID_MAC:            return pSrvDesc->hseSrv.macReq.inputLength;
+        case HSE_SRV_ID_FAST_CMAC:      return pSrvDesc->hseSrv.fastCmacReq.inputBitLength / 8UL;
+        case HSE_SRV_ID_SYM_CIPHER:     return pSrvDesc->hseSrv.symCipherReq.inputLength;
+        case HSE_SRV_ID_AEAD:           return pSrvDesc->hseSrv.aeadReq.inputLength + pSrvDesc->hseSrv.aeadReq.aadLength;
+        case HSE_SRV_ID_SIGN:           return pSrvDesc->hseSrv.signReq.inputLength;
+        case HSE_SRV_ID_GET_RANDOM_NUM: return pSrvDesc->hseSrv.getRandomNumReq.randomNumLength;
+        default:                        return 0UL;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
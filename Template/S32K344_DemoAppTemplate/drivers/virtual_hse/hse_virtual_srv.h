@@ -0,0 +1,158 @@
+/**
+*   @file    hse_virtual_srv.h
+*
+*   @version 1.0.0
+*   @brief   Virtual HSE - interface between the service units.
+*   @details The key store and the streams are owned by hse_virtual_srv.c; the symmetric
+*            (hse_virtual_sym.c), asymmetric (hse_virtual_asym.c) and SHE (hse_virtual_she.c)
+*            services use them from the device thread only, so no locking is needed.
+*            Not to be included by the framework or the tests.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_VIRTUAL_SRV_H
+#define HSE_VIRTUAL_SRV_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_srv.h
+*/
+#include <openssl/evp.h>
+#include "hse_virtual.h"
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+#define HSE_VIRTUAL_MAX_KEYS        (64U)
+#define HSE_VIRTUAL_MAX_KEY_LEN     (512U)
+
+/* Host address in a descriptor to pointer */
+#define HSE_VIRTUAL_PTR(addr)       ((void*)(uintptr_t)(addr))
+/* Pointer to host address (descriptors built by the emulator) */
+#define HSE_VIRTUAL_ADDR(ptr)       ((HOST_ADDR)(uintptr_t)(ptr))
+
+/* Key value indexes (pKey[] of the import/export services) */
+#define HSE_VIRTUAL_PUB_KEY         (0U)    /* ECC public key (x || y), RSA modulus */
+#define HSE_VIRTUAL_RSA_EXP         (1U)    /* RSA public exponent */
+#define HSE_VIRTUAL_SYM_KEY         (2U)    /* Symmetric key, private key */
+
+/* Key types 0x80 and above are asymmetric (ECC, RSA, DH) */
+#define HSE_VIRTUAL_IS_ASYM(keyType)    ((keyType) >= HSE_KEY_TYPE_ECC_PAIR)
+
+/* A super user (CUST or OEM) is authorized */
+#define HSE_VIRTUAL_SUPER_USER() \
+    (0U != (HSE_VirtualGetStatus() & (HSE_STATUS_CUST_SUPER_USER | HSE_STATUS_OEM_SUPER_USER)))
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Emulated key slot
+ */
+typedef struct
+{
+    bool_t          bUsed;
+    bool_t          bPlain;         /* SHE RAM key loaded in plain (exportable with SHE_EXPORT_RAM_KEY) */
+    hseKeyHandle_t  keyHandle;
+    hseKeyInfo_t    keyInfo;
+    uint16_t        keyLen[3];
+    uint8_t         key[3][HSE_VIRTUAL_MAX_KEY_LEN];
+} hseVirtualKey_t;
+
+/*
+ * @brief   Emulated stream (per MU instance and stream ID)
+ */
+typedef struct
+{
+    hseSrvId_t          srvId;          /* Service of the START, 0 if no stream is open */
+    uint8_t             u8Channel;      /* Channel of the START: the other steps must use it */
+    hseAuthDir_t        authDir;
+    hseKeyHandle_t      keyHandle;
+    hseSignScheme_t     signScheme;
+    uint32_t            u32TagLen;      /* AEAD tag length */
+    EVP_MD_CTX*         pMdCtx;         /* HASH, SIGN (message digest) */
+    EVP_MAC_CTX*        pMacCtx;        /* MAC */
+    EVP_CIPHER_CTX*     pCipherCtx;     /* SYM_CIPHER, AEAD */
+} hseVirtualStream_t;
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/* Key store (hse_virtual_srv.c) */
+hseVirtualKey_t* HSE_VirtualFindKey(hseKeyHandle_t keyHandle);
+hseVirtualKey_t* HSE_VirtualNewKey(hseKeyHandle_t keyHandle);
+const uint8_t* HSE_VirtualSymKey(hseKeyHandle_t keyHandle, uint32_t* pu32KeyLen);
+
+/* Streams (hse_virtual_srv.c) */
+hseVirtualStream_t* HSE_VirtualStreamStart(uint8_t u8MuInstance, uint8_t u8Channel, hseStreamId_t streamId,
+                                           hseSrvId_t srvId);
+hseSrvResponse_t HSE_VirtualStreamGet(uint8_t u8MuInstance, uint8_t u8Channel, hseStreamId_t streamId,
+                                      hseSrvId_t srvId, hseVirtualStream_t** ppStream);
+void HSE_VirtualStreamEnd(hseVirtualStream_t* pStream);
+
+/* Symmetric services (hse_virtual_sym.c) */
+const EVP_MD* HSE_VirtualDigest(hseHashAlgo_t hashAlgo);
+const EVP_CIPHER* HSE_VirtualAesCipher(uint32_t u32KeyLen, const char* pMode);
+hseSrvResponse_t HSE_VirtualMacCompute(const hseMacScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pMac, uint32_t* pu32MacLen);
+hseSrvResponse_t HSE_VirtualHash(uint8_t u8MuInstance, uint8_t u8Channel, const hseHashSrv_t* pHashSrv);
+hseSrvResponse_t HSE_VirtualMac(uint8_t u8MuInstance, uint8_t u8Channel, const hseMacSrv_t* pMacSrv);
+hseSrvResponse_t HSE_VirtualFastCmac(const hseFastCMACSrv_t* pFastCmacSrv);
+hseSrvResponse_t HSE_VirtualSymCipher(uint8_t u8MuInstance, uint8_t u8Channel, const hseSymCipherSrv_t* pCipherSrv);
+hseSrvResponse_t HSE_VirtualAead(uint8_t u8MuInstance, uint8_t u8Channel, const hseAeadSrv_t* pAeadSrv);
+
+/* Asymmetric services and system authorization (hse_virtual_asym.c) */
+hseSrvResponse_t HSE_VirtualKeyGenerate(const hseKeyGenerateSrv_t* pKeyGenSrv);
+hseSrvResponse_t HSE_VirtualDhCompute(const hseDHComputeSharedSecretSrv_t* pDhSrv);
+hseSrvResponse_t HSE_VirtualLoadEccCurve(const hseLoadEccCurveSrv_t* pLoadCurveSrv);
+hseSrvResponse_t HSE_VirtualBurmesterDesmedt(const hseBurmesterDesmedtSrv_t* pBdSrv);
+hseSrvResponse_t HSE_VirtualSign(uint8_t u8MuInstance, uint8_t u8Channel, const hseSignSrv_t* pSignSrv);
+hseSrvResponse_t HSE_VirtualSignCompute(const hseSignScheme_t* pScheme, hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
+    const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pSig[2], uint32_t* pu32SigLen[2]);
+hseSrvResponse_t HSE_VirtualEccDecompress(hseEccCurveId_t eccCurveId, const uint8_t* pCompressed, uint32_t u32Len,
+                                         uint8_t* pPubKey, uint16_t* pu16PubKeyLen);
+hseSrvResponse_t HSE_VirtualSysAuthReq(const hseSysAuthorizationReqSrv_t* pAuthReqSrv);
+hseSrvResponse_t HSE_VirtualSysAuthResp(const hseSysAuthorizationRespSrv_t* pAuthRespSrv);
+
+/* SHE services (hse_virtual_she.c) */
+hseSrvResponse_t HSE_VirtualMpCompress(const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pOutput);
+hseSrvResponse_t HSE_VirtualSheLoadKey(const hseSheLoadKeySrv_t* pLoadKeySrv);
+hseSrvResponse_t HSE_VirtualSheLoadPlainKey(const hseSheLoadPlainKeySrv_t* pLoadPlainKeySrv);
+hseSrvResponse_t HSE_VirtualSheExportRamKey(const hseSheExportRamKeySrv_t* pExportRamKeySrv);
+hseSrvResponse_t HSE_VirtualSheGetId(const hseSheGetIdSrv_t* pGetIdSrv);
+hseSrvResponse_t HSE_VirtualSheChallenge(uint8_t* pChallenge);
+hseSrvResponse_t HSE_VirtualSheAuthVerify(hseKeyHandle_t ownerKeyHandle, const uint8_t* pChallenge,
+                                          const uint8_t* pAuth, uint32_t u32AuthLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_VIRTUAL_SRV_H */
+
+/** @} */
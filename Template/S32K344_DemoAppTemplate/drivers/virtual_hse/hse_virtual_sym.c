@@ -0,0 +1,869 @@
+/**
+*   @file    hse_virtual_sym.c
+*
+*   @brief   Virtual HSE - symmetric services.
+*   @details HASH (SHA1, SHA2, SHA3, Miyaguchi-Preneel), MAC (CMAC, HMAC, GMAC), FAST_CMAC,
+*            SYM_CIPHER (AES ECB/CBC/CTR/CFB/OFB) and AEAD (GCM, CCM) with OpenSSL libcrypto.
+*            HASH (except MP), MAC, SYM_CIPHER and AEAD GCM also run in streaming mode; the
+*            UPDATE/FINISH steps must be sent on the channel of the START.
+*
+*   @addtogroup hse_virtual_srv_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_sym.c
+*/
+#include <stdio.h>
+#include <string.h>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include "hse_virtual_srv.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* Miyaguchi-Preneel digest length */
+#define HSE_VIRTUAL_MP_LEN          (16U)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/* OpenSSL mode names of the cipher block modes (index: hseCipherBlockMode_t) */
+static const char* const virtualModeNames[] = {NULL, "CTR", "CBC", "ECB", "CFB", "OFB"};
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static hseSrvResponse_t HSE_VirtualCopyOut(const uint8_t* pValue, uint32_t u32ValueLen, HOST_ADDR pOut,
+                                           HOST_ADDR pOutLen);
+static hseSrvResponse_t HSE_VirtualTagCheck(hseAuthDir_t authDir, const uint8_t* pMac, uint32_t u32MacLen,
+                                            HOST_ADDR pTag, HOST_ADDR pTagLen);
+static EVP_MAC_CTX* HSE_VirtualMacInit(const hseMacScheme_t* pScheme, hseKeyHandle_t keyHandle,
+                                       hseSrvResponse_t* pSrvResponse);
+static hseSrvResponse_t HSE_VirtualCipherInit(const hseSymCipherSrv_t* pCipherSrv, EVP_CIPHER_CTX** ppCtx);
+static hseSrvResponse_t HSE_VirtualAeadOnePass(const hseAeadSrv_t* pAeadSrv);
+static hseSrvResponse_t HSE_VirtualSgtCheck(HOST_ADDR pList, uint32_t u32Length, uint32_t* pu32Entries);
+static bool_t HSE_VirtualDigestUpdate(EVP_MD_CTX* pMdCtx, const hseHashSrv_t* pHashSrv, uint32_t u32Entries);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Write a digest or tag; a smaller buffer gets it truncated.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualCopyOut(const uint8_t* pValue, uint32_t u32ValueLen, HOST_ADDR pOut,
+                                           HOST_ADDR pOutLen)
+{
+    uint32_t* pu32OutLen = (uint32_t*)HSE_VIRTUAL_PTR(pOutLen);
+
+    if((NULL == pu32OutLen) || (0UL == *pu32OutLen))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(*pu32OutLen > u32ValueLen)
+    {
+        *pu32OutLen = u32ValueLen;
+    }
+    memcpy(HSE_VIRTUAL_PTR(pOut), pValue, *pu32OutLen);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Output (generate) or verify a MAC tag.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualTagCheck(hseAuthDir_t authDir, const uint8_t* pMac, uint32_t u32MacLen,
+                                            HOST_ADDR pTag, HOST_ADDR pTagLen)
+{
+    const uint32_t* pu32TagLen = (const uint32_t*)HSE_VIRTUAL_PTR(pTagLen);
+
+    if(HSE_AUTH_DIR_GENERATE == authDir)
+    {
+        return HSE_VirtualCopyOut(pMac, u32MacLen, pTag, pTagLen);
+    }
+    if((NULL == pu32TagLen) || (0UL == *pu32TagLen))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if((*pu32TagLen > u32MacLen) || (0 != CRYPTO_memcmp(HSE_VIRTUAL_PTR(pTag), pMac, *pu32TagLen)))
+    {
+        return HSE_SRV_RSP_VERIFY_FAILED;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : MAC context for a CMAC, HMAC or GMAC scheme and key.
+ ******************************************************************************/
+static EVP_MAC_CTX* HSE_VirtualMacInit(const hseMacScheme_t* pScheme, hseKeyHandle_t keyHandle,
+                                       hseSrvResponse_t* pSrvResponse)
+{
+    OSSL_PARAM params[3];
+    EVP_MAC* pMac = NULL;
+    EVP_MAC_CTX* pCtx = NULL;
+    const uint8_t* pKey;
+    uint32_t u32KeyLen = 0UL;
+    char cipherName[24];
+    const char* pMacName;
+    uint32_t u32Param = 0UL;
+
+    pKey = HSE_VirtualSymKey(keyHandle, &u32KeyLen);
+    if(NULL == pKey)
+    {
+        *pSrvResponse = HSE_SRV_RSP_KEY_EMPTY;
+        return NULL;
+    }
+
+    *pSrvResponse = HSE_SRV_RSP_OK;
+    switch(pScheme->macAlgo)
+    {
+        case HSE_MAC_ALGO_CMAC:
+        case HSE_MAC_ALGO_GMAC:
+            if(NULL == HSE_VirtualAesCipher(u32KeyLen, "CBC"))
+            {
+                *pSrvResponse = HSE_SRV_RSP_KEY_INVALID;
+                break;
+            }
+            pMacName = (HSE_MAC_ALGO_CMAC == pScheme->macAlgo) ? "CMAC" : "GMAC";
+            (void)snprintf(cipherName, sizeof(cipherName), "AES-%u-%s", (unsigned int)(u32KeyLen * 8UL),
+                           (HSE_MAC_ALGO_CMAC == pScheme->macAlgo) ? "CBC" : "GCM");
+            params[u32Param++] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, cipherName, 0U);
+            if(HSE_MAC_ALGO_GMAC == pScheme->macAlgo)
+            {
+                params[u32Param++] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_IV,
+                    HSE_VIRTUAL_PTR(pScheme->sch.gmac.pIV), pScheme->sch.gmac.ivLength);
+            }
+            break;
+        case HSE_MAC_ALGO_HMAC:
+            if(NULL == HSE_VirtualDigest(pScheme->sch.hmac.hashAlgo))
+            {
+                *pSrvResponse = HSE_SRV_RSP_NOT_SUPPORTED;
+                break;
+            }
+            pMacName = "HMAC";
+            params[u32Param++] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                (char*)EVP_MD_get0_name(HSE_VirtualDigest(pScheme->sch.hmac.hashAlgo)), 0U);
+            break;
+        default:
+            *pSrvResponse = HSE_SRV_RSP_NOT_SUPPORTED;
+            break;
+    }
+    if(HSE_SRV_RSP_OK != *pSrvResponse)
+    {
+        return NULL;
+    }
+    params[u32Param] = OSSL_PARAM_construct_end();
+
+    pMac = EVP_MAC_fetch(NULL, pMacName, NULL);
+    pCtx = (NULL != pMac) ? EVP_MAC_CTX_new(pMac) : NULL;
+    EVP_MAC_free(pMac);
+    if((NULL == pCtx) || (1 != EVP_MAC_init(pCtx, pKey, u32KeyLen, params)))
+    {
+        EVP_MAC_CTX_free(pCtx);
+        *pSrvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+        return NULL;
+    }
+    return pCtx;
+}
+
+/*******************************************************************************
+ * Description   : AES cipher context of a SYM_CIPHER request (one-pass or START).
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualCipherInit(const hseSymCipherSrv_t* pCipherSrv, EVP_CIPHER_CTX** ppCtx)
+{
+    const EVP_CIPHER* pCipher;
+    const uint8_t* pKey;
+    uint32_t u32KeyLen = 0UL;
+
+    if((HSE_SGT_OPTION_NONE != pCipherSrv->sgtOption) || (HSE_CIPHER_ALGO_AES != pCipherSrv->cipherAlgo) ||
+       (pCipherSrv->cipherBlockMode >= (sizeof(virtualModeNames) / sizeof(virtualModeNames[0]))) ||
+       (NULL == virtualModeNames[pCipherSrv->cipherBlockMode]))
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    pKey = HSE_VirtualSymKey(pCipherSrv->keyHandle, &u32KeyLen);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    pCipher = HSE_VirtualAesCipher(u32KeyLen, virtualModeNames[pCipherSrv->cipherBlockMode]);
+    if(NULL == pCipher)
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    *ppCtx = EVP_CIPHER_CTX_new();
+    if(NULL == *ppCtx)
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    if((1 != EVP_CipherInit_ex(*ppCtx, pCipher, NULL, pKey, (const uint8_t*)HSE_VIRTUAL_PTR(pCipherSrv->pIV),
+                               (HSE_CIPHER_DIR_ENCRYPT == pCipherSrv->cipherDir) ? 1 : 0)) ||
+       (1 != EVP_CIPHER_CTX_set_padding(*ppCtx, 0)))
+    {
+        EVP_CIPHER_CTX_free(*ppCtx);
+        *ppCtx = NULL;
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_AEAD one-pass (GCM, CCM).
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualAeadOnePass(const hseAeadSrv_t* pAeadSrv)
+{
+    const bool_t bGcm = (HSE_AUTH_CIPHER_MODE_GCM == pAeadSrv->authCipherMode);
+    const int encrypt = (HSE_CIPHER_DIR_ENCRYPT == pAeadSrv->cipherDir) ? 1 : 0;
+    uint8_t* pTag = (uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pTag);
+    uint8_t* pOutput = (uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pOutput);
+    const EVP_CIPHER* pCipher;
+    EVP_CIPHER_CTX* pCtx;
+    const uint8_t* pKey;
+    uint32_t u32KeyLen = 0UL;
+    int outLen = 0;
+    bool_t bOk;
+    bool_t bFinalOk = TRUE;
+
+    pKey = HSE_VirtualSymKey(pAeadSrv->keyHandle, &u32KeyLen);
+    if(NULL == pKey)
+    {
+        return HSE_SRV_RSP_KEY_EMPTY;
+    }
+    pCipher = HSE_VirtualAesCipher(u32KeyLen, bGcm ? "GCM" : "CCM");
+    if(NULL == pCipher)
+    {
+        return HSE_SRV_RSP_KEY_INVALID;
+    }
+
+    pCtx = EVP_CIPHER_CTX_new();
+    if(NULL == pCtx)
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+
+    bOk = (1 == EVP_CipherInit_ex(pCtx, pCipher, NULL, NULL, NULL, encrypt)) &&
+          (1 == EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_SET_IVLEN, (int)pAeadSrv->ivLength, NULL));
+
+    /* CCM: tag length (and expected tag) before the key, then the total length */
+    if(bOk && !bGcm)
+    {
+        bOk = (1 == EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_SET_TAG, (int)pAeadSrv->tagLength,
+                                        (0 == encrypt) ? pTag : NULL));
+    }
+    bOk = bOk && (1 == EVP_CipherInit_ex(pCtx, NULL, NULL, pKey, (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pIV), encrypt));
+    if(bOk && !bGcm)
+    {
+        bOk = (1 == EVP_CipherUpdate(pCtx, NULL, &outLen, NULL, (int)pAeadSrv->inputLength));
+    }
+
+    if(bOk && (0UL != pAeadSrv->aadLength))
+    {
+        bOk = (1 == EVP_CipherUpdate(pCtx, NULL, &outLen, (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pAAD),
+                                     (int)pAeadSrv->aadLength));
+    }
+
+    if(bOk)
+    {
+        /* CCM decryption verifies the tag in this step */
+        bFinalOk = (1 == EVP_CipherUpdate(pCtx, pOutput, &outLen,
+                                          (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pInput), (int)pAeadSrv->inputLength));
+    }
+
+    if(bOk && bFinalOk && bGcm)
+    {
+        if(0 == encrypt)
+        {
+            bOk = (1 == EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_SET_TAG, (int)pAeadSrv->tagLength, pTag));
+        }
+        bFinalOk = bOk && (1 == EVP_CipherFinal_ex(pCtx, pOutput + outLen, &outLen));
+    }
+
+    if(bOk && bFinalOk && (1 == encrypt))
+    {
+        bOk = (1 == EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_GET_TAG, (int)pAeadSrv->tagLength, pTag));
+    }
+    EVP_CIPHER_CTX_free(pCtx);
+
+    if(!bOk)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(!bFinalOk)
+    {
+        return (0 == encrypt) ? HSE_SRV_RSP_VERIFY_FAILED : HSE_SRV_RSP_INVALID_PARAM;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : OpenSSL digest of a hash algorithm.
+ ******************************************************************************/
+const EVP_MD* HSE_VirtualDigest(hseHashAlgo_t hashAlgo)
+{
+    switch(hashAlgo)
+    {
+        case HSE_HASH_ALGO_SHA_1:           return EVP_sha1();
+        case HSE_HASH_ALGO_SHA2_224:        return EVP_sha224();
+        case HSE_HASH_ALGO_SHA2_256:        return EVP_sha256();
+        case HSE_HASH_ALGO_SHA2_384:        return EVP_sha384();
+        case HSE_HASH_ALGO_SHA2_512:        return EVP_sha512();
+        case HSE_HASH_ALGO_SHA2_512_224:    return EVP_sha512_224();
+        case HSE_HASH_ALGO_SHA2_512_256:    return EVP_sha512_256();
+        case HSE_HASH_ALGO_SHA3_224:        return EVP_sha3_224();
+        case HSE_HASH_ALGO_SHA3_256:        return EVP_sha3_256();
+        case HSE_HASH_ALGO_SHA3_384:        return EVP_sha3_384();
+        case HSE_HASH_ALGO_SHA3_512:        return EVP_sha3_512();
+        default:                            return NULL;
+    }
+}
+
+/*******************************************************************************
+ * Description   : OpenSSL AES cipher for a key length and mode name.
+ ******************************************************************************/
+const EVP_CIPHER* HSE_VirtualAesCipher(uint32_t u32KeyLen, const char* pMode)
+{
+    char name[24];
+
+    if((16UL != u32KeyLen) && (24UL != u32KeyLen) && (32UL != u32KeyLen))
+    {
+        return NULL;
+    }
+
+    (void)snprintf(name, sizeof(name), "AES-%u-%s", (unsigned int)(u32KeyLen * 8UL), pMode);
+    return EVP_get_cipherbyname(name);
+}
+
+/*******************************************************************************
+ * Description   : Compute a CMAC, HMAC or GMAC in one pass.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualMacCompute(const hseMacScheme_t* pScheme, hseKeyHandle_t keyHandle,
+    const uint8_t* pInput, uint32_t u32InputLen, uint8_t* pMac, uint32_t* pu32MacLen)
+{
+    hseSrvResponse_t srvResponse;
+    EVP_MAC_CTX* pCtx = HSE_VirtualMacInit(pScheme, keyHandle, &srvResponse);
+    size_t macLen = 0U;
+
+    if(NULL == pCtx)
+    {
+        return srvResponse;
+    }
+    if((1 != EVP_MAC_update(pCtx, pInput, u32InputLen)) ||
+       (1 != EVP_MAC_final(pCtx, pMac, &macLen, EVP_MAX_MD_SIZE)))
+    {
+        srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    EVP_MAC_CTX_free(pCtx);
+
+    *pu32MacLen = (uint32_t)macLen;
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Check a scatter list: at most HSE_MAX_NUM_OF_SGT_ENTRIES entries,
+ *                 the last one marked final, chunk lengths adding up to u32Length.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VirtualSgtCheck(HOST_ADDR pList, uint32_t u32Length, uint32_t* pu32Entries)
+{
+    const hseScatterList_t* pEntries = (const hseScatterList_t*)HSE_VIRTUAL_PTR(pList);
+    uint64_t u64Total = 0ULL;
+    uint32_t i;
+
+    if((NULL == pEntries) || (0UL != ((uintptr_t)pEntries & 3UL)))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    for(i = 0UL; i < HSE_MAX_NUM_OF_SGT_ENTRIES; i++)
+    {
+        u64Total += (pEntries[i].length & ~HSE_SGT_FINAL_CHUNK_BIT_MASK);
+        if(0UL != (pEntries[i].length & HSE_SGT_FINAL_CHUNK_BIT_MASK))
+        {
+            *pu32Entries = i + 1UL;
+            return (u64Total == (uint64_t)u32Length) ? HSE_SRV_RSP_OK : HSE_SRV_RSP_INVALID_PARAM;
+        }
+    }
+    return HSE_SRV_RSP_INVALID_PARAM;
+}
+
+/*******************************************************************************
+ * Description   : Digest the input of a hash request, contiguous or scatter list.
+ ******************************************************************************/
+static bool_t HSE_VirtualDigestUpdate(EVP_MD_CTX* pMdCtx, const hseHashSrv_t* pHashSrv, uint32_t u32Entries)
+{
+    const hseScatterList_t* pEntries = (const hseScatterList_t*)HSE_VIRTUAL_PTR(pHashSrv->pInput);
+    bool_t bOk = TRUE;
+    uint32_t i;
+
+    if(HSE_SGT_OPTION_NONE == pHashSrv->sgtOption)
+    {
+        return (1 == EVP_DigestUpdate(pMdCtx, HSE_VIRTUAL_PTR(pHashSrv->pInput), pHashSrv->inputLength));
+    }
+    for(i = 0UL; bOk && (i < u32Entries); i++)
+    {
+        bOk = (1 == EVP_DigestUpdate(pMdCtx, HSE_VIRTUAL_PTR(pEntries[i].pPtr),
+                                     pEntries[i].length & ~HSE_SGT_FINAL_CHUNK_BIT_MASK));
+    }
+    return bOk;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_HASH.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualHash(uint8_t u8MuInstance, uint8_t u8Channel, const hseHashSrv_t* pHashSrv)
+{
+    const EVP_MD* pMd = HSE_VirtualDigest(pHashSrv->hashAlgo);
+    const uint8_t* pInput = (const uint8_t*)HSE_VIRTUAL_PTR(pHashSrv->pInput);
+    uint32_t* pu32HashLen = (uint32_t*)HSE_VIRTUAL_PTR(pHashSrv->pHashLength);
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLen = 0U;
+    hseVirtualStream_t* pStream = NULL;
+    EVP_MD_CTX* pMdCtx;
+    hseSrvResponse_t srvResponse;
+    uint32_t u32Entries = 0UL;
+    bool_t bOk = TRUE;
+
+    /* The input can be a scatter list (pInput: the hseScatterList_t entries) */
+    if(HSE_SGT_OPTION_INPUT == pHashSrv->sgtOption)
+    {
+        srvResponse = HSE_VirtualSgtCheck(pHashSrv->pInput, pHashSrv->inputLength, &u32Entries);
+        if(HSE_SRV_RSP_OK != srvResponse)
+        {
+            return srvResponse;
+        }
+    }
+    else if(HSE_SGT_OPTION_NONE != pHashSrv->sgtOption)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    /* Miyaguchi-Preneel: one-pass only, the full 16 bytes digest is written */
+    if(HSE_HASH_ALGO_MP == pHashSrv->hashAlgo)
+    {
+        if(HSE_SGT_OPTION_NONE != pHashSrv->sgtOption)
+        {
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+        }
+        if(HSE_ACCESS_MODE_ONE_PASS != pHashSrv->accessMode)
+        {
+            return HSE_SRV_RSP_NOT_SUPPORTED;
+        }
+        if((NULL == pu32HashLen) || (*pu32HashLen < HSE_VIRTUAL_MP_LEN))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+        srvResponse = HSE_VirtualMpCompress(pInput, pHashSrv->inputLength, (uint8_t*)HSE_VIRTUAL_PTR(pHashSrv->pHash));
+        if(HSE_SRV_RSP_OK == srvResponse)
+        {
+            *pu32HashLen = HSE_VIRTUAL_MP_LEN;
+        }
+        return srvResponse;
+    }
+    if(NULL == pMd)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    switch(pHashSrv->accessMode)
+    {
+        case HSE_ACCESS_MODE_ONE_PASS:
+            if(HSE_SGT_OPTION_NONE == pHashSrv->sgtOption)
+            {
+                bOk = (1 == EVP_Digest(pInput, pHashSrv->inputLength, digest, &digestLen, pMd, NULL));
+                break;
+            }
+            pMdCtx = EVP_MD_CTX_new();
+            bOk = (NULL != pMdCtx) &&
+                  (1 == EVP_DigestInit_ex(pMdCtx, pMd, NULL)) &&
+                  HSE_VirtualDigestUpdate(pMdCtx, pHashSrv, u32Entries) &&
+                  (1 == EVP_DigestFinal_ex(pMdCtx, digest, &digestLen));
+            EVP_MD_CTX_free(pMdCtx);
+            break;
+        case HSE_ACCESS_MODE_START:
+            pStream = HSE_VirtualStreamStart(u8MuInstance, u8Channel, pHashSrv->streamId, HSE_SRV_ID_HASH);
+            if(NULL == pStream)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            pStream->pMdCtx = EVP_MD_CTX_new();
+            bOk = (NULL != pStream->pMdCtx) &&
+                  (1 == EVP_DigestInit_ex(pStream->pMdCtx, pMd, NULL)) &&
+                  HSE_VirtualDigestUpdate(pStream->pMdCtx, pHashSrv, u32Entries);
+            break;
+        case HSE_ACCESS_MODE_UPDATE:
+        case HSE_ACCESS_MODE_FINISH:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pHashSrv->streamId, HSE_SRV_ID_HASH, &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            bOk = HSE_VirtualDigestUpdate(pStream->pMdCtx, pHashSrv, u32Entries);
+            if(HSE_ACCESS_MODE_FINISH == pHashSrv->accessMode)
+            {
+                bOk = bOk && (1 == EVP_DigestFinal_ex(pStream->pMdCtx, digest, &digestLen));
+                HSE_VirtualStreamEnd(pStream);
+                pStream = NULL;
+            }
+            break;
+        default:
+            return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(!bOk)
+    {
+        if(NULL != pStream)
+        {
+            HSE_VirtualStreamEnd(pStream);
+        }
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    if(NULL != pStream)
+    {
+        /* START/UPDATE: no output */
+        return HSE_SRV_RSP_OK;
+    }
+    return HSE_VirtualCopyOut(digest, digestLen, pHashSrv->pHash, pHashSrv->pHashLength);
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_MAC.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualMac(uint8_t u8MuInstance, uint8_t u8Channel, const hseMacSrv_t* pMacSrv)
+{
+    const uint8_t* pInput = (const uint8_t*)HSE_VIRTUAL_PTR(pMacSrv->pInput);
+    uint8_t mac[EVP_MAX_MD_SIZE];
+    uint32_t u32MacLen = 0UL;
+    size_t macLen = 0U;
+    hseVirtualStream_t* pStream;
+    hseSrvResponse_t srvResponse;
+
+    if(HSE_SGT_OPTION_NONE != pMacSrv->sgtOption)
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    switch(pMacSrv->accessMode)
+    {
+        case HSE_ACCESS_MODE_ONE_PASS:
+            srvResponse = HSE_VirtualMacCompute(&pMacSrv->macScheme, pMacSrv->keyHandle, pInput,
+                                                pMacSrv->inputLength, mac, &u32MacLen);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            return HSE_VirtualTagCheck(pMacSrv->authDir, mac, u32MacLen, pMacSrv->pTag, pMacSrv->pTagLength);
+        case HSE_ACCESS_MODE_START:
+            pStream = HSE_VirtualStreamStart(u8MuInstance, u8Channel, pMacSrv->streamId, HSE_SRV_ID_MAC);
+            if(NULL == pStream)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            pStream->authDir = pMacSrv->authDir;
+            pStream->pMacCtx = HSE_VirtualMacInit(&pMacSrv->macScheme, pMacSrv->keyHandle, &srvResponse);
+            if((NULL != pStream->pMacCtx) && (1 != EVP_MAC_update(pStream->pMacCtx, pInput, pMacSrv->inputLength)))
+            {
+                srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+            }
+            break;
+        case HSE_ACCESS_MODE_UPDATE:
+        case HSE_ACCESS_MODE_FINISH:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pMacSrv->streamId, HSE_SRV_ID_MAC, &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            if(1 != EVP_MAC_update(pStream->pMacCtx, pInput, pMacSrv->inputLength))
+            {
+                srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+            }
+            else if(HSE_ACCESS_MODE_FINISH == pMacSrv->accessMode)
+            {
+                srvResponse = (1 == EVP_MAC_final(pStream->pMacCtx, mac, &macLen, sizeof(mac))) ?
+                    HSE_VirtualTagCheck(pStream->authDir, mac, (uint32_t)macLen, pMacSrv->pTag, pMacSrv->pTagLength) :
+                    HSE_SRV_RSP_GENERAL_ERROR;
+                HSE_VirtualStreamEnd(pStream);
+                return srvResponse;
+            }
+            break;
+        default:
+            return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        HSE_VirtualStreamEnd(pStream);
+    }
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_FAST_CMAC (byte multiple lengths only).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualFastCmac(const hseFastCMACSrv_t* pFastCmacSrv)
+{
+    hseMacScheme_t scheme;
+    uint8_t mac[EVP_MAX_MD_SIZE];
+    uint32_t u32MacLen = 0UL;
+    uint32_t u32TagLen = (uint32_t)pFastCmacSrv->tagBitLength / 8UL;
+    hseSrvResponse_t srvResponse;
+
+    if((0UL != (pFastCmacSrv->inputBitLength % 8UL)) || (0U != (pFastCmacSrv->tagBitLength % 8U)))
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    memset(&scheme, 0, sizeof(scheme));
+    scheme.macAlgo = HSE_MAC_ALGO_CMAC;
+    scheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
+    srvResponse = HSE_VirtualMacCompute(&scheme, pFastCmacSrv->keyHandle,
+        (const uint8_t*)HSE_VIRTUAL_PTR(pFastCmacSrv->pInput), pFastCmacSrv->inputBitLength / 8UL,
+        mac, &u32MacLen);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        return srvResponse;
+    }
+    if((0UL == u32TagLen) || (u32TagLen > u32MacLen))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(HSE_AUTH_DIR_GENERATE == pFastCmacSrv->authDir)
+    {
+        memcpy(HSE_VIRTUAL_PTR(pFastCmacSrv->pTag), mac, u32TagLen);
+        return HSE_SRV_RSP_OK;
+    }
+    return (0 == CRYPTO_memcmp(HSE_VIRTUAL_PTR(pFastCmacSrv->pTag), mac, u32TagLen)) ?
+        HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_SYM_CIPHER (AES).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualSymCipher(uint8_t u8MuInstance, uint8_t u8Channel, const hseSymCipherSrv_t* pCipherSrv)
+{
+    uint8_t* pOutput = (uint8_t*)HSE_VIRTUAL_PTR(pCipherSrv->pOutput);
+    EVP_CIPHER_CTX* pCtx = NULL;
+    hseVirtualStream_t* pStream = NULL;
+    hseSrvResponse_t srvResponse;
+    int outLen = 0;
+    int finalLen = 0;
+    bool_t bOk;
+
+    switch(pCipherSrv->accessMode)
+    {
+        case HSE_ACCESS_MODE_ONE_PASS:
+            srvResponse = HSE_VirtualCipherInit(pCipherSrv, &pCtx);
+            break;
+        case HSE_ACCESS_MODE_START:
+            pStream = HSE_VirtualStreamStart(u8MuInstance, u8Channel, pCipherSrv->streamId, HSE_SRV_ID_SYM_CIPHER);
+            if(NULL == pStream)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            srvResponse = HSE_VirtualCipherInit(pCipherSrv, &pStream->pCipherCtx);
+            pCtx = pStream->pCipherCtx;
+            break;
+        case HSE_ACCESS_MODE_UPDATE:
+        case HSE_ACCESS_MODE_FINISH:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pCipherSrv->streamId, HSE_SRV_ID_SYM_CIPHER,
+                                               &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            pCtx = pStream->pCipherCtx;
+            break;
+        default:
+            return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        if(NULL != pStream)
+        {
+            HSE_VirtualStreamEnd(pStream);
+        }
+        return srvResponse;
+    }
+
+    bOk = (1 == EVP_CipherUpdate(pCtx, pOutput, &outLen, (const uint8_t*)HSE_VIRTUAL_PTR(pCipherSrv->pInput),
+                                 (int)pCipherSrv->inputLength));
+    if((HSE_ACCESS_MODE_ONE_PASS == pCipherSrv->accessMode) || (HSE_ACCESS_MODE_FINISH == pCipherSrv->accessMode))
+    {
+        /* ECB/CBC/CFB need full blocks, the final step fails otherwise */
+        bOk = bOk && (1 == EVP_CipherFinal_ex(pCtx, pOutput + outLen, &finalLen));
+        if(NULL != pStream)
+        {
+            HSE_VirtualStreamEnd(pStream);
+        }
+        else
+        {
+            EVP_CIPHER_CTX_free(pCtx);
+        }
+    }
+    else if(!bOk)
+    {
+        HSE_VirtualStreamEnd(pStream);
+    }
+
+    return bOk ? HSE_SRV_RSP_OK : HSE_SRV_RSP_INVALID_PARAM;
+}
+
+/*******************************************************************************
+ * Description   : HSE_SRV_ID_AEAD (GCM, CCM one-pass; GCM streaming).
+ ******************************************************************************/
+hseSrvResponse_t HSE_VirtualAead(uint8_t u8MuInstance, uint8_t u8Channel, const hseAeadSrv_t* pAeadSrv)
+{
+    const EVP_CIPHER* pCipher;
+    const uint8_t* pKey;
+    uint8_t* pTag = (uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pTag);
+    uint8_t* pOutput = (uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pOutput);
+    uint32_t u32KeyLen = 0UL;
+    int encrypt;
+    int outLen = 0;
+    int finalLen = 0;
+    hseVirtualStream_t* pStream;
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_OK;
+
+    if((HSE_SGT_OPTION_NONE != pAeadSrv->sgtOption) ||
+       ((HSE_AUTH_CIPHER_MODE_GCM != pAeadSrv->authCipherMode) && (HSE_AUTH_CIPHER_MODE_CCM != pAeadSrv->authCipherMode)))
+    {
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+    }
+
+    switch(pAeadSrv->accessMode)
+    {
+        case HSE_ACCESS_MODE_ONE_PASS:
+            return HSE_VirtualAeadOnePass(pAeadSrv);
+        case HSE_ACCESS_MODE_START:
+            /* IV and AAD; the input is given by the UPDATE/FINISH steps */
+            if(HSE_AUTH_CIPHER_MODE_GCM != pAeadSrv->authCipherMode)
+            {
+                return HSE_SRV_RSP_NOT_SUPPORTED;
+            }
+            pKey = HSE_VirtualSymKey(pAeadSrv->keyHandle, &u32KeyLen);
+            if(NULL == pKey)
+            {
+                return HSE_SRV_RSP_KEY_EMPTY;
+            }
+            pCipher = HSE_VirtualAesCipher(u32KeyLen, "GCM");
+            if(NULL == pCipher)
+            {
+                return HSE_SRV_RSP_KEY_INVALID;
+            }
+            pStream = HSE_VirtualStreamStart(u8MuInstance, u8Channel, pAeadSrv->streamId, HSE_SRV_ID_AEAD);
+            if(NULL == pStream)
+            {
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            encrypt = (HSE_CIPHER_DIR_ENCRYPT == pAeadSrv->cipherDir) ? 1 : 0;
+            pStream->pCipherCtx = EVP_CIPHER_CTX_new();
+            if((NULL == pStream->pCipherCtx) ||
+               (1 != EVP_CipherInit_ex(pStream->pCipherCtx, pCipher, NULL, NULL, NULL, encrypt)) ||
+               (1 != EVP_CIPHER_CTX_ctrl(pStream->pCipherCtx, EVP_CTRL_AEAD_SET_IVLEN, (int)pAeadSrv->ivLength, NULL)) ||
+               (1 != EVP_CipherInit_ex(pStream->pCipherCtx, NULL, NULL, pKey,
+                                       (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pIV), encrypt)) ||
+               ((0UL != pAeadSrv->aadLength) &&
+                (1 != EVP_CipherUpdate(pStream->pCipherCtx, NULL, &outLen,
+                                       (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pAAD), (int)pAeadSrv->aadLength))))
+            {
+                HSE_VirtualStreamEnd(pStream);
+                return HSE_SRV_RSP_INVALID_PARAM;
+            }
+            pStream->authDir = (1 == encrypt) ? HSE_AUTH_DIR_GENERATE : HSE_AUTH_DIR_VERIFY;
+            return HSE_SRV_RSP_OK;
+        case HSE_ACCESS_MODE_UPDATE:
+        case HSE_ACCESS_MODE_FINISH:
+            srvResponse = HSE_VirtualStreamGet(u8MuInstance, u8Channel, pAeadSrv->streamId, HSE_SRV_ID_AEAD, &pStream);
+            if(HSE_SRV_RSP_OK != srvResponse)
+            {
+                return srvResponse;
+            }
+            break;
+        default:
+            return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(1 != EVP_CipherUpdate(pStream->pCipherCtx, pOutput, &outLen,
+                             (const uint8_t*)HSE_VIRTUAL_PTR(pAeadSrv->pInput), (int)pAeadSrv->inputLength))
+    {
+        srvResponse = HSE_SRV_RSP_INVALID_PARAM;
+    }
+    else if(HSE_ACCESS_MODE_FINISH == pAeadSrv->accessMode)
+    {
+        if(HSE_AUTH_DIR_VERIFY == pStream->authDir)
+        {
+            srvResponse = ((1 == EVP_CIPHER_CTX_ctrl(pStream->pCipherCtx, EVP_CTRL_AEAD_SET_TAG,
+                                                     (int)pAeadSrv->tagLength, pTag)) &&
+                           (1 == EVP_CipherFinal_ex(pStream->pCipherCtx, pOutput + outLen, &finalLen))) ?
+                          HSE_SRV_RSP_OK : HSE_SRV_RSP_VERIFY_FAILED;
+        }
+        else
+        {
+            srvResponse = ((1 == EVP_CipherFinal_ex(pStream->pCipherCtx, pOutput + outLen, &finalLen)) &&
+                           (1 == EVP_CIPHER_CTX_ctrl(pStream->pCipherCtx, EVP_CTRL_AEAD_GET_TAG,
+                                                     (int)pAeadSrv->tagLength, pTag))) ?
+                          HSE_SRV_RSP_OK : HSE_SRV_RSP_INVALID_PARAM;
+        }
+        HSE_VirtualStreamEnd(pStream);
+        return srvResponse;
+    }
+
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        HSE_VirtualStreamEnd(pStream);
+    }
+    return srvResponse;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
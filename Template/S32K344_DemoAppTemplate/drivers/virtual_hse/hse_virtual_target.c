@@ -0,0 +1,234 @@
+/**
+*   @file    hse_virtual_target.c
+*
+*   @brief   Virtual HSE - host replacement of the target drivers.
+*   @details Implements the sys_init, host_stm and nvic functions used by the framework and the
+*            demo services on a Linux host. The STM timers are derived from CLOCK_MONOTONIC
+*            (STM_0 counts at 48 MHz as on the target, the timebase counts microseconds).
+*
+*   @addtogroup hse_virtual_target_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_target.c
+*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hse_virtual_target.h"
+#include "host_stm.h"
+#include "nvic.h"
+#include "sys_init.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* STM_0 clock (FIRC 48 MHz) */
+#define HSE_VIRTUAL_STM_TICKS_PER_US    (48ULL)
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Held by the emulated interrupts and by the host critical sections */
+static pthread_mutex_t  irqLock;
+static pthread_once_t   irqLockOnce = PTHREAD_ONCE_INIT;
+
+/* STM_0 start time (EnableStm) */
+static uint64_t         u64StmStartNs = 0ULL;
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static void HSE_VirtualIrqLockInit(void);
+static uint64_t HSE_VirtualNowNs(void);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Create the (recursive) interrupt lock.
+ ******************************************************************************/
+static void HSE_VirtualIrqLockInit(void)
+{
+    pthread_mutexattr_t attr;
+
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutex_init(&irqLock, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+}
+
+/*******************************************************************************
+ * Description   : Monotonic time in nanoseconds.
+ ******************************************************************************/
+static uint64_t HSE_VirtualNowNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Emulated interrupt entry/exit.
+ ******************************************************************************/
+void HSE_VirtualEnterIsr(void)
+{
+    (void)pthread_once(&irqLockOnce, HSE_VirtualIrqLockInit);
+    (void)pthread_mutex_lock(&irqLock);
+}
+
+void HSE_VirtualExitIsr(void)
+{
+    (void)pthread_mutex_unlock(&irqLock);
+}
+
+/*******************************************************************************
+ * Description   : Failed ASSERT (global_defs.h, hse_she_api.h).
+ ******************************************************************************/
+void HSE_VirtualAssert(const char* pCondition, const char* pFile, int line)
+{
+    (void)fprintf(stderr, "%s:%d: ASSERT(%s) failed\n", pFile, line, pCondition);
+    abort();
+}
+
+/*******************************************************************************
+ * Description   : Interrupt masking (sys_init.h).
+ ******************************************************************************/
+void sys_disableAllInterrupts(void)
+{
+    (void)pthread_once(&irqLockOnce, HSE_VirtualIrqLockInit);
+    (void)pthread_mutex_lock(&irqLock);
+}
+
+void sys_enableAllInterrupts(void)
+{
+    /* Fails harmlessly when interrupts were not disabled by this thread (e.g. at start-up) */
+    (void)pthread_once(&irqLockOnce, HSE_VirtualIrqLockInit);
+    (void)pthread_mutex_unlock(&irqLock);
+}
+
+/*******************************************************************************
+ * Description   : STM_0 (host_stm.h).
+ ******************************************************************************/
+void EnableStm(void)
+{
+    u64StmStartNs = HSE_VirtualNowNs();
+}
+
+void DisbleStm(void)
+{
+}
+
+uint32_t MeasureStm(void)
+{
+    return (uint32_t)(((HSE_VirtualNowNs() - u64StmStartNs) * HSE_VIRTUAL_STM_TICKS_PER_US) / 1000ULL);
+}
+
+uint32_t GetTimer(void)
+{
+    return MeasureStm();
+}
+
+void EnableStmDiv(uint32_t divide)
+{
+    (void)divide;
+    EnableStm();
+}
+
+void DelayStm(uint32_t delay)
+{
+    struct timespec delayTime;
+    uint64_t u64DelayNs = ((uint64_t)delay * 1000ULL) / HSE_VIRTUAL_STM_TICKS_PER_US;
+
+    delayTime.tv_sec  = (time_t)(u64DelayNs / 1000000000ULL);
+    delayTime.tv_nsec = (long)(u64DelayNs % 1000000000ULL);
+    (void)nanosleep(&delayTime, NULL);
+}
+
+/*******************************************************************************
+ * Description   : Microseconds time base (host_stm.h).
+ ******************************************************************************/
+void EnableStmTimebase(void)
+{
+}
+
+uint32_t GetStmTimebaseUs(void)
+{
+    /* Let the device thread run while the host is polling */
+    (void)sched_yield();
+    return (uint32_t)(HSE_VirtualNowNs() / 1000ULL);
+}
+
+void SetStmTimebaseAlarm(uint32_t delayUs)
+{
+    /* HSE_WAIT_FOR_EVENT() only yields on the host: the wait loop keeps polling */
+    (void)delayUs;
+}
+
+void ClearStmTimebaseAlarm(void)
+{
+}
+
+/*******************************************************************************
+ * Description   : NVIC (nvic.h). The emulated interrupts are always enabled.
+ ******************************************************************************/
+void NVIC_ClearPendingIRQ(uint8 IRQn)
+{
+    (void)IRQn;
+}
+
+void NVIC_EnableIRQ(uint8 IRQn)
+{
+    (void)IRQn;
+}
+
+void NVIC_DisableIRQ(uint8 IRQn)
+{
+    (void)IRQn;
+}
+
+void NVIC_SetPriority(uint8 IRQn, uint8 priority)
+{
+    (void)IRQn;
+    (void)priority;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,80 @@
+/**
+*   @file    hse_virtual_target.h
+*
+*   @version 1.0.0
+*   @brief   Virtual HSE - host replacement of the target drivers.
+*   @details Interrupt masking, STM timers and NVIC for Linux host builds (HSE_VIRTUAL).
+*            The emulated MU interrupts run on the device thread; sys_disableAllInterrupts()
+*            keeps them out of the host critical sections.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_VIRTUAL_TARGET_H
+#define HSE_VIRTUAL_TARGET_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_virtual_target.h
+*/
+#include "std_typedefs.h"
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Enter an emulated interrupt (waits for the host critical section to end).
+*
+* @return       NULL
+*/
+void HSE_VirtualEnterIsr(void);
+
+/**
+* @brief        Exit an emulated interrupt.
+*
+* @return       NULL
+*/
+void HSE_VirtualExitIsr(void);
+
+/**
+* @brief        Failed ASSERT of the demo services.
+* @details      Reports the condition and aborts, so that a host test fails instead of hanging
+*               in the target endless loop.
+*
+* @param[in]    pCondition      The condition text.
+* @param[in]    pFile           The source file.
+* @param[in]    line            The source line.
+*
+* @return       Does not return.
+*/
+void HSE_VirtualAssert(const char* pCondition, const char* pFile, int line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_VIRTUAL_TARGET_H */
+
+/** @} */
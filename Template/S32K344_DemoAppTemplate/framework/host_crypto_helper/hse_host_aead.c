@@ -33,6 +33,8 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_srv_builders.h"
 #include "string.h"
 
 #include "hse_host_aead.h"
@@ -53,8 +55,6 @@ extern "C"
  *                                      LOCAL VARIABLES
  ==================================================================================================*/
 #if defined(HSE_SPT_AEAD)
-static uint8_t          muIf = 0U;
-static uint8_t          muChannelIdx = 1U;
 
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
@@ -67,26 +67,9 @@ static uint8_t          muChannelIdx = 1U;
 /*==================================================================================================
  *                                   LOCAL FUNCTION PROTOTYPES
  ==================================================================================================*/
-static hseSrvResponse_t AeadReq(
-        hseAccessMode_t accessMode,
-        uint32_t streamId,
-        hseAuthCipherMode_t authCipherMode,
-        hseCipherDir_t cipherDir,
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t* pIV,
-        uint32_t aadLength,
-        const uint8_t* pAAD,
-        uint32_t inputLength,
-        const uint8_t* pInput,
-        uint32_t tagLength,
-        uint8_t* pTag,
-        uint8_t* pOutput,
-        hseSGTOption_t inputSgtType
-        );
-
 #ifdef AEAD_STREAM_SUPPORTED
 static hseSrvResponse_t AeadStartReq(
+        const hseCtx_t* pCtx,
         uint32_t streamId,
         hseAuthCipherMode_t authCipherMode,
         hseCipherDir_t cipherDir,
@@ -97,6 +80,7 @@ static hseSrvResponse_t AeadStartReq(
         const uint8_t* pAAD);
 
 static hseSrvResponse_t AeadUpdateReq(
+        const hseCtx_t* pCtx,
         uint32_t streamId,
         hseAuthCipherMode_t authCipherMode,
         hseCipherDir_t cipherDir,
@@ -105,6 +89,7 @@ static hseSrvResponse_t AeadUpdateReq(
         uint8_t* pOutput);
 
 static hseSrvResponse_t AeadFinishReq(
+        const hseCtx_t* pCtx,
         uint32_t streamId,
         hseAuthCipherMode_t authCipherMode,
         hseCipherDir_t cipherDir,
@@ -118,51 +103,9 @@ static hseSrvResponse_t AeadFinishReq(
  *                                       LOCAL FUNCTIONS
  ==================================================================================================*/
 
-static hseSrvResponse_t AeadReq(
-    hseAccessMode_t accessMode,
-    uint32_t streamId,
-    hseAuthCipherMode_t authCipherMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t ivLength,
-    const uint8_t* pIV,
-    uint32_t aadLength,
-    const uint8_t* pAAD,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint32_t tagLength,
-    uint8_t* pTag,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType)
-{
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseAeadSrv_t* pAeadSrv;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_AEAD;
-    pAeadSrv = &(pHseSrvDesc->hseSrv.aeadReq);
-
-    pAeadSrv->accessMode = accessMode;
-    pAeadSrv->streamId = streamId;
-    pAeadSrv->authCipherMode = authCipherMode;
-    pAeadSrv->cipherDir = cipherDir;
-    pAeadSrv->keyHandle = keyHandle;
-    pAeadSrv->ivLength = ivLength;
-    pAeadSrv->pIV = (HOST_ADDR)pIV;
-    pAeadSrv->aadLength = aadLength;
-    pAeadSrv->pAAD = (HOST_ADDR)pAAD;
-    pAeadSrv->inputLength = inputLength;
-    pAeadSrv->pInput = (HOST_ADDR)pInput;
-    pAeadSrv->tagLength = tagLength;
-    pAeadSrv->pTag = (HOST_ADDR)pTag;
-    pAeadSrv->pOutput = (HOST_ADDR)pOutput;
-    pAeadSrv->sgtOption = inputSgtType;
-
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
-}
-
 #ifdef AEAD_STREAM_SUPPORTED
 static hseSrvResponse_t AeadStartReq(
+    const hseCtx_t* pCtx,
     uint32_t streamId,
     hseAuthCipherMode_t authCipherMode,
     hseCipherDir_t cipherDir,
@@ -172,10 +115,11 @@ static hseSrvResponse_t AeadStartReq(
     uint32_t aadLength,
     const uint8_t* pAAD)
 {
-    return AeadReq(HSE_ACCESS_MODE_START, streamId, authCipherMode, cipherDir, keyHandle, ivLength, pIV, aadLength, pAAD, 0, NULL, 0, NULL, NULL, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_START, streamId, authCipherMode, cipherDir, keyHandle, ivLength, pIV, aadLength, pAAD, 0, NULL, 0, NULL, NULL, 0U);
 }
 
 static hseSrvResponse_t AeadUpdateReq(
+    const hseCtx_t* pCtx,
     uint32_t streamId,
     hseAuthCipherMode_t authCipherMode,
     hseCipherDir_t cipherDir,
@@ -183,10 +127,11 @@ static hseSrvResponse_t AeadUpdateReq(
     const uint8_t* pInput,
     uint8_t* pOutput)
 {
-    return AeadReq(HSE_ACCESS_MODE_UPDATE, streamId, authCipherMode, cipherDir, 0, 0, NULL, 0, NULL, inputLength, pInput, 0, NULL, pOutput, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, authCipherMode, cipherDir, 0, 0, NULL, 0, NULL, inputLength, pInput, 0, NULL, pOutput, 0U);
 }
 
 static hseSrvResponse_t AeadFinishReq(
+    const hseCtx_t* pCtx,
     uint32_t streamId,
     hseAuthCipherMode_t authCipherMode,
     hseCipherDir_t cipherDir,
@@ -196,7 +141,7 @@ static hseSrvResponse_t AeadFinishReq(
     uint8_t* pTag,
     uint8_t* pOutput)
 {
-    return AeadReq(HSE_ACCESS_MODE_FINISH, streamId, authCipherMode, cipherDir, 0, 0, NULL, 0, NULL, inputLength, pInput, tagLength, pTag, pOutput, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, authCipherMode, cipherDir, 0, 0, NULL, 0, NULL, inputLength, pInput, tagLength, pTag, pOutput, 0U);
 }
 #endif
 
@@ -209,129 +154,190 @@ static hseSrvResponse_t AeadFinishReq(
  *                                            GCM
  ******************************************************************************/
 
-/* === AES === */
-hseSrvResponse_t AesGcm(
-        hseCipherDir_t cipherDir,
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pInput,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pOutput)
+hseSrvResponse_t AeadReqCtx(
+    const hseCtx_t* pCtx,
+    hseAccessMode_t accessMode,
+    uint32_t streamId,
+    hseAuthCipherMode_t authCipherMode,
+    hseCipherDir_t cipherDir,
+    hseKeyHandle_t keyHandle,
+    uint32_t ivLength,
+    const uint8_t* pIV,
+    uint32_t aadLength,
+    const uint8_t* pAAD,
+    uint32_t inputLength,
+    const uint8_t* pInput,
+    uint32_t tagLength,
+    uint8_t* pTag,
+    uint8_t* pOutput,
+    hseSGTOption_t inputSgtType)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
-            cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
-            inputLength, pInput, tagLength, pTag, pOutput, 0U);
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, streamId, &muChannelIdx, &hseStatus);
+
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
+
+    HSE_BuildAeadReq(pHseSrvDesc, accessMode, streamId, authCipherMode, cipherDir, keyHandle,
+                     ivLength, pIV, aadLength, pAAD, inputSgtType, inputLength, pInput,
+                     tagLength, pTag, pOutput);
+
+    return HSE_CtxStreamSend(pCtx, accessMode, streamId, muChannelIdx, pHseSrvDesc);
 }
 
-hseSrvResponse_t AesGcmEncrypt(hseKeyHandle_t keyHandle, uint32_t ivLength,
-                               const uint8_t *pIV, uint32_t aadLength,
-                               const uint8_t *pAad, uint32_t inputLength,
-                               const uint8_t *pPlainText, uint32_t tagLength,
-                               uint8_t *pTag, uint8_t *pCipherText, hseSGTOption_t inputSgtType)
+/* === AES === */
+hseSrvResponse_t AesGcmEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength,
+                                  const uint8_t *pAad, uint32_t inputLength,
+                                  const uint8_t *pPlainText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pCipherText, hseSGTOption_t inputSgtType)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
             HSE_CIPHER_DIR_ENCRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
             inputLength, pPlainText, tagLength, pTag, pCipherText, inputSgtType);
 }
 
-hseSrvResponse_t AesGcmDecrypt(
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pCipherText,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pPlainText,
-        hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesGcmDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength,
+                                  const uint8_t *pAad, uint32_t inputLength,
+                                  const uint8_t *pCipherText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pPlainText, hseSGTOption_t inputSgtType)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
             HSE_CIPHER_DIR_DECRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
             inputLength, pCipherText, tagLength, pTag, pPlainText, inputSgtType);
 }
 
+hseSrvResponse_t AesGcmCtx(const hseCtx_t* pCtx, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                           uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                           uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                           uint8_t *pOutput)
+{
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_GCM,
+                      cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pInput, tagLength, pTag, pOutput, 0U);
+}
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesGcm,
+    (hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+     uint32_t aadLength, const uint8_t *pAad, uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+     uint8_t *pTag, uint8_t *pOutput),
+    (cipherDir, keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pInput, tagLength, pTag, pOutput))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesGcmEncrypt,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+     uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength, uint8_t *pTag, uint8_t *pCipherText,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pPlainText, tagLength, pTag, pCipherText,
+     inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesGcmDecrypt,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+     uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength, uint8_t *pTag, uint8_t *pPlainText,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pCipherText, tagLength, pTag, pPlainText,
+     inputSgtType))
+
 #ifdef AEAD_STREAM_SUPPORTED
 /* Streaming for Gcm */
-hseSrvResponse_t AesGcmStream(
-    hseAccessMode_t accessMode,
-    uint32_t streamId,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t ivLength,
-    const uint8_t *pIV,
-    uint32_t aadLength,
-    const uint8_t *pAad,
-    uint32_t inputLength,
-    const uint8_t *pInput,
-    uint32_t tagLength,
-    uint8_t *pTag,
-    uint8_t *pOutput)
+hseSrvResponse_t AesGcmStreamCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                                 hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                 const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                 uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                 uint8_t *pTag, uint8_t *pOutput)
 {
-    return AeadReq(accessMode, streamId, HSE_AUTH_CIPHER_MODE_GCM,
-                   cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
-                   inputLength, pInput, tagLength, pTag, pOutput, 0U);
+    return AeadReqCtx(pCtx, accessMode, streamId, HSE_AUTH_CIPHER_MODE_GCM,
+                      cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pInput, tagLength, pTag, pOutput, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmStream,
+    (hseAccessMode_t accessMode, uint32_t streamId, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+     uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad, uint32_t inputLength,
+     const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput),
+    (accessMode, streamId, cipherDir, keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pInput,
+     tagLength, pTag, pOutput))
+
 /* || */
 
-hseSrvResponse_t AesGcmStartStreamEncrypt(
-    uint32_t streamId,
-    hseKeyHandle_t keyHandle,
-    uint32_t ivLength,
-    const uint8_t *pIV,
-    uint32_t aadLength,
-    const uint8_t *pAad)
+hseSrvResponse_t AesGcmStartStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId,
+                                             hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                             uint32_t aadLength, const uint8_t *pAad)
 {
-    return AeadStartReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
+    return AeadStartReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
                         keyHandle, ivLength, pIV, aadLength, pAad);
 }
 
-hseSrvResponse_t AesGcmUpdateStreamEncrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmStartStreamEncrypt,
+    (uint32_t streamId, hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength,
+     const uint8_t *pAad),
+    (streamId, keyHandle, ivLength, pIV, aadLength, pAad))
+
+hseSrvResponse_t AesGcmUpdateStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint8_t *pOutput)
 {
-    return AeadUpdateReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
+    return AeadUpdateReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
                          inputLength, pInput, pOutput);
 }
 
-hseSrvResponse_t AesGcmFinishStreamEncrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput,
-        uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmUpdateStreamEncrypt,
+    (uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput),
+    (streamId, inputLength, pInput, pOutput))
+
+hseSrvResponse_t AesGcmFinishStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                                              uint8_t *pOutput)
 {
-    return AeadFinishReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
+    return AeadFinishReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_ENCRYPT,
                          inputLength, pInput, tagLength, pTag, pOutput);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmFinishStreamEncrypt,
+    (uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+     uint8_t *pOutput),
+    (streamId, inputLength, pInput, tagLength, pTag, pOutput))
+
 /* || */
 
-hseSrvResponse_t AesGcmStartStreamDecrypt(
-    uint32_t streamId,
-    hseKeyHandle_t keyHandle,
-    uint32_t ivLength,
-    const uint8_t *pIV,
-    uint32_t aadLength,
-    const uint8_t *pAad)
+hseSrvResponse_t AesGcmStartStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId,
+                                             hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                             uint32_t aadLength, const uint8_t *pAad)
 {
-    return AeadStartReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
+    return AeadStartReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
             keyHandle, ivLength, pIV, aadLength, pAad);
 }
 
-hseSrvResponse_t AesGcmUpdateStreamDecrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmStartStreamDecrypt,
+    (uint32_t streamId, hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength,
+     const uint8_t *pAad),
+    (streamId, keyHandle, ivLength, pIV, aadLength, pAad))
+
+hseSrvResponse_t AesGcmUpdateStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint8_t *pOutput)
 {
-    return AeadUpdateReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
+    return AeadUpdateReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
                          inputLength, pInput, pOutput);
 }
 
-hseSrvResponse_t AesGcmFinishStreamDecrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput,
-        uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmUpdateStreamDecrypt,
+    (uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput),
+    (streamId, inputLength, pInput, pOutput))
+
+hseSrvResponse_t AesGcmFinishStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                                              uint8_t *pOutput)
 {
-    return AeadFinishReq(streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
+    return AeadFinishReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_GCM, HSE_CIPHER_DIR_DECRYPT,
                          inputLength, pInput, tagLength, pTag, pOutput);
 }
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGcmFinishStreamDecrypt,
+    (uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+     uint8_t *pOutput),
+    (streamId, inputLength, pInput, tagLength, pTag, pOutput))
 #endif
 
 /*******************************************************************************
@@ -339,108 +345,110 @@ hseSrvResponse_t AesGcmFinishStreamDecrypt(uint32_t streamId, uint32_t inputLeng
  ******************************************************************************/
 
 /* === AES === */
-hseSrvResponse_t AesCcm(
-        hseCipherDir_t cipherDir,
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pInput,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pOutput)
+hseSrvResponse_t AesCcmCtx(const hseCtx_t* pCtx, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                           uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                           uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                           uint8_t *pOutput)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
-            cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
-            inputLength, pInput, tagLength, pTag, pOutput, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
+                      cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pInput, tagLength, pTag, pOutput, 0U);
 }
 
-hseSrvResponse_t AesCcmEncrypt(
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pPlainText,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pCipherText)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCcm,
+    (hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+     uint32_t aadLength, const uint8_t *pAad, uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+     uint8_t *pTag, uint8_t *pOutput),
+    (cipherDir, keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pInput, tagLength, pTag, pOutput))
+
+hseSrvResponse_t AesCcmEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                  uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pCipherText)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
-            HSE_CIPHER_DIR_ENCRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
-            inputLength, pPlainText, tagLength, pTag, pCipherText, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
+                      HSE_CIPHER_DIR_ENCRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pPlainText, tagLength, pTag, pCipherText, 0U);
 }
 
-hseSrvResponse_t AesCcmDecrypt(
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pCipherText,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pPlainText)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCcmEncrypt,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+     uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength, uint8_t *pTag, uint8_t *pCipherText),
+    (keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pPlainText, tagLength, pTag, pCipherText))
+
+hseSrvResponse_t AesCcmDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                  uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pPlainText)
 {
-    return AeadReq(HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
-            HSE_CIPHER_DIR_DECRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
-            inputLength, pCipherText, tagLength, pTag, pPlainText, 0U);
+    return AeadReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, HSE_AUTH_CIPHER_MODE_CCM,
+                      HSE_CIPHER_DIR_DECRYPT, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pCipherText, tagLength, pTag, pPlainText, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCcmDecrypt,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+     uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength, uint8_t *pTag, uint8_t *pPlainText),
+    (keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pCipherText, tagLength, pTag, pPlainText))
+
 #ifdef AEAD_STREAM_SUPPORTED
 /* Streaming for Ccm */
-hseSrvResponse_t AesCcmStream(
-        hseAccessMode_t accessMode,
-        uint32_t streamId,
-        hseCipherDir_t cipherDir,
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad,
-        uint32_t inputLength,
-        const uint8_t *pInput,
-        uint32_t tagLength,
-        uint8_t *pTag,
-        uint8_t *pOutput)
+hseSrvResponse_t AesCcmStreamCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                                 hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                 const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                 uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                 uint8_t *pTag, uint8_t *pOutput)
 {
-    return AeadReq(accessMode, streamId, HSE_AUTH_CIPHER_MODE_CCM,
-            cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
-            inputLength, pInput, tagLength, pTag, pOutput, 0U);
+    return AeadReqCtx(pCtx, accessMode, streamId, HSE_AUTH_CIPHER_MODE_CCM,
+                      cipherDir, keyHandle, ivLength, pIV, aadLength, pAad,
+                      inputLength, pInput, tagLength, pTag, pOutput, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCcmStream,
+    (hseAccessMode_t accessMode, uint32_t streamId, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+     uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad, uint32_t inputLength,
+     const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput),
+    (accessMode, streamId, cipherDir, keyHandle, ivLength, pIV, aadLength, pAad, inputLength, pInput,
+     tagLength, pTag, pOutput))
+
 /* || */
 
-hseSrvResponse_t AesCcmStreamStart(
-        uint32_t streamId,
-        hseCipherDir_t cipherDir,
-        hseKeyHandle_t keyHandle,
-        uint32_t ivLength,
-        const uint8_t *pIV,
-        uint32_t aadLength,
-        const uint8_t *pAad)
+hseSrvResponse_t AesCcmStreamStartCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                      hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                      uint32_t aadLength, const uint8_t *pAad)
 {
-    return AeadStartReq(streamId, HSE_AUTH_CIPHER_MODE_CCM, cipherDir,
+    return AeadStartReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_CCM, cipherDir,
             keyHandle, ivLength, pIV, aadLength, pAad);
 }
 
-hseSrvResponse_t AesCcmStreamUpdate(uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength,
-        uint8_t *pInput, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCcmStreamStart,
+    (uint32_t streamId, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+     const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad),
+    (streamId, cipherDir, keyHandle, ivLength, pIV, aadLength, pAad))
+
+hseSrvResponse_t AesCcmStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                       uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput)
 {
-    return AeadUpdateReq(streamId, HSE_AUTH_CIPHER_MODE_CCM,
+    return AeadUpdateReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_CCM,
             cipherDir, inputLength, pInput, pOutput);
 }
 
-hseSrvResponse_t AesCcmStreamFinish(uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput,
-        uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCcmStreamUpdate,
+    (uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput),
+    (streamId, cipherDir, inputLength, pInput, pOutput))
+
+hseSrvResponse_t AesCcmStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                       uint32_t inputLength, uint8_t *pInput, uint32_t tagLength,
+                                       uint8_t *pTag, uint8_t *pOutput)
 {
-    return AeadFinishReq(streamId, HSE_AUTH_CIPHER_MODE_CCM, cipherDir,
+    return AeadFinishReq(pCtx, streamId, HSE_AUTH_CIPHER_MODE_CCM, cipherDir,
             inputLength, pInput, tagLength, pTag, pOutput);
 }
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCcmStreamFinish,
+    (uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput, uint32_t tagLength,
+     uint8_t *pTag, uint8_t *pOutput),
+    (streamId, cipherDir, inputLength, pInput, tagLength, pTag, pOutput))
 #endif
 #endif
 #ifdef __cplusplus
@@ -15,6 +15,7 @@ extern "C"{
 
 #include "hse_interface.h"
 #include "hse_host_utils.h"
+#include "hse_host_ctx.h"
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
 ==================================================================================================*/
@@ -51,6 +52,17 @@ extern "C"{
 ==================================================================================================*/
 
 
+/* Context variants: MU, channel, TX options and deadline taken from pCtx.
+ * The ...StreamAsync variants are sent on the channel of pStreamCtx (HSE_CtxStreamOpen), see
+ * HSE_CTX_DEFINE_STREAM_ASYNC; the synchronous stream helpers hold a channel of MU0 from START to FINISH */
+hseSrvResponse_t AeadReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                            hseAuthCipherMode_t authCipherMode, hseCipherDir_t cipherDir,
+                            hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t* pIV,
+                            uint32_t aadLength, const uint8_t* pAAD,
+                            uint32_t inputLength, const uint8_t* pInput,
+                            uint32_t tagLength, uint8_t* pTag, uint8_t* pOutput,
+                            hseSGTOption_t inputSgtType);
+
 /*******************************************************************************
  *                                          GCM
  ******************************************************************************/
@@ -62,18 +74,46 @@ hseSrvResponse_t AesGcm(hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
                         uint32_t inputLength, const uint8_t *pInput,
                         uint32_t tagLength, uint8_t *pTag,
                         uint8_t *pOutput);
+hseSrvResponse_t AesGcmCtx(const hseCtx_t* pCtx, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                           uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                           uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                           uint8_t *pOutput);
+hseSrvResponse_t AesGcmAsync(hseTxOptions_t txOptions, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                             uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                             uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                             uint8_t *pOutput);
 
 hseSrvResponse_t AesGcmEncrypt(hseKeyHandle_t keyHandle, uint32_t ivLength,
                                const uint8_t *pIV, uint32_t aadLength,
                                const uint8_t *pAad, uint32_t inputLength,
                                const uint8_t *pPlainText, uint32_t tagLength,
                                uint8_t *pTag, uint8_t *pCipherText, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGcmEncryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                    uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength,
+                                    uint8_t *pTag, uint8_t *pCipherText, hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t AesGcmDecrypt(hseKeyHandle_t keyHandle, uint32_t ivLength,
                                const uint8_t *pIV, uint32_t aadLength,
                                const uint8_t *pAad, uint32_t inputLength,
                                const uint8_t *pCipherText, uint32_t tagLength,
                                uint8_t *pTag, uint8_t *pPlainText, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGcmDecryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                    uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength,
+                                    uint8_t *pTag, uint8_t *pPlainText, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t AesGcmEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength,
+                                  const uint8_t *pAad, uint32_t inputLength,
+                                  const uint8_t *pPlainText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pCipherText, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t AesGcmDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength,
+                                  const uint8_t *pAad, uint32_t inputLength,
+                                  const uint8_t *pCipherText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pPlainText, hseSGTOption_t inputSgtType);
 
 #ifdef AEAD_STREAM_SUPPORTED
 /* Streaming for Gcm */
@@ -83,26 +123,69 @@ hseSrvResponse_t AesGcmStream(hseAccessMode_t accessMode, uint32_t streamId,
                               uint32_t aadLength, const uint8_t *pAad,
                               uint32_t inputLength, const uint8_t *pInput,
                               uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesGcmStreamCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                                 hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                 const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                 uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                 uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesGcmStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                   hseAccessMode_t accessMode, uint32_t streamId,
+                                   hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                   const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                   uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                   uint8_t *pTag, uint8_t *pOutput);
 
 /* || */
 
 hseSrvResponse_t AesGcmStartStreamEncrypt(uint32_t streamId, hseKeyHandle_t keyHandle,
                                           uint32_t ivLength, const uint8_t *pIV,
                                           uint32_t aadLength, const uint8_t *pAad);
+hseSrvResponse_t AesGcmStartStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId,
+                                             hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                             uint32_t aadLength, const uint8_t *pAad);
+hseSrvResponse_t AesGcmStartStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               uint32_t streamId, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                               const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad);
 
 hseSrvResponse_t AesGcmUpdateStreamEncrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesGcmUpdateStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesGcmUpdateStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput);
 
 hseSrvResponse_t AesGcmFinishStreamEncrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput,
                                            uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesGcmFinishStreamEncryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                                              uint8_t *pOutput);
+hseSrvResponse_t AesGcmFinishStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint32_t tagLength,
+                                                uint8_t *pTag, uint8_t *pOutput);
 
 hseSrvResponse_t AesGcmStartStreamDecrypt(uint32_t streamId, hseKeyHandle_t keyHandle,
                                           uint32_t ivLength, const uint8_t *pIV,
                                           uint32_t aadLength, const uint8_t *pAad);
+hseSrvResponse_t AesGcmStartStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId,
+                                             hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                             uint32_t aadLength, const uint8_t *pAad);
+hseSrvResponse_t AesGcmStartStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               uint32_t streamId, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                               const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad);
 
 hseSrvResponse_t AesGcmUpdateStreamDecrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesGcmUpdateStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesGcmUpdateStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput);
 
 hseSrvResponse_t AesGcmFinishStreamDecrypt(uint32_t streamId, uint32_t inputLength, uint8_t *pInput,
                                            uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesGcmFinishStreamDecryptCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t inputLength,
+                                              uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                                              uint8_t *pOutput);
+hseSrvResponse_t AesGcmFinishStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t inputLength, uint8_t *pInput, uint32_t tagLength,
+                                                uint8_t *pTag, uint8_t *pOutput);
 #endif
 
 #ifdef AEAD_TDES_SUPPORTED
@@ -156,18 +239,42 @@ hseSrvResponse_t AesCcm(hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
 		                uint32_t inputLength, const uint8_t *pInput,
 		                uint32_t tagLength, uint8_t *pTag,
 		                uint8_t *pOutput);
+hseSrvResponse_t AesCcmCtx(const hseCtx_t* pCtx, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                           uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                           uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                           uint8_t *pOutput);
+hseSrvResponse_t AesCcmAsync(hseTxOptions_t txOptions, hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                             uint32_t ivLength, const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                             uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength, uint8_t *pTag,
+                             uint8_t *pOutput);
 
 hseSrvResponse_t AesCcmEncrypt(hseKeyHandle_t keyHandle, uint32_t ivLength,
 		                       const uint8_t *pIV, uint32_t aadLength,
 		                       const uint8_t *pAad, uint32_t inputLength,
 		                       const uint8_t *pPlainText, uint32_t tagLength,
 		                       uint8_t *pTag, uint8_t *pCipherText);
+hseSrvResponse_t AesCcmEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                  uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pCipherText);
+hseSrvResponse_t AesCcmEncryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                    uint32_t inputLength, const uint8_t *pPlainText, uint32_t tagLength,
+                                    uint8_t *pTag, uint8_t *pCipherText);
 
 hseSrvResponse_t AesCcmDecrypt(hseKeyHandle_t keyHandle, uint32_t ivLength,
 		                       const uint8_t *pIV, uint32_t aadLength,
 		                       const uint8_t *pAad, uint32_t inputLength,
 		                       const uint8_t *pCipherText, uint32_t tagLength,
 		                       uint8_t *pTag, uint8_t *pPlainText);
+hseSrvResponse_t AesCcmDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                  uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength,
+                                  uint8_t *pTag, uint8_t *pPlainText);
+hseSrvResponse_t AesCcmDecryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                    uint32_t inputLength, const uint8_t *pCipherText, uint32_t tagLength,
+                                    uint8_t *pTag, uint8_t *pPlainText);
 
 #ifdef AEAD_STREAM_SUPPORTED
 /* Streaming for Ccm */
@@ -178,6 +285,17 @@ hseSrvResponse_t AesCcmStream(hseAccessMode_t accessMode, uint32_t streamId,
 		                      uint32_t inputLength, const uint8_t *pInput,
 		                      uint32_t tagLength, uint8_t *pTag,
 		                      uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                                 hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                 const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                 uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                 uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                   hseAccessMode_t accessMode, uint32_t streamId,
+                                   hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                   const uint8_t *pIV, uint32_t aadLength, const uint8_t *pAad,
+                                   uint32_t inputLength, const uint8_t *pInput, uint32_t tagLength,
+                                   uint8_t *pTag, uint8_t *pOutput);
 
 /* || */
 
@@ -185,12 +303,30 @@ hseSrvResponse_t AesCcmStreamStart(uint32_t streamId, hseCipherDir_t cipherDir,
                                    hseKeyHandle_t keyHandle, uint32_t ivLength,
                                    const uint8_t *pIV, uint32_t aadLength,
                                    const uint8_t *pAad);
+hseSrvResponse_t AesCcmStreamStartCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                      hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                      uint32_t aadLength, const uint8_t *pAad);
+hseSrvResponse_t AesCcmStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                        uint32_t streamId, hseCipherDir_t cipherDir,
+                                        hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV,
+                                        uint32_t aadLength, const uint8_t *pAad);
 
 hseSrvResponse_t AesCcmStreamUpdate(uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength,
 		                            uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                       uint32_t inputLength, uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                         uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput,
+                                         uint8_t *pOutput);
 
 hseSrvResponse_t AesCcmStreamFinish(uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput,
 		                            uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, hseCipherDir_t cipherDir,
+                                       uint32_t inputLength, uint8_t *pInput, uint32_t tagLength,
+                                       uint8_t *pTag, uint8_t *pOutput);
+hseSrvResponse_t AesCcmStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                         uint32_t streamId, hseCipherDir_t cipherDir, uint32_t inputLength, uint8_t *pInput,
+                                         uint32_t tagLength, uint8_t *pTag, uint8_t *pOutput);
 #endif
 
 #ifdef AEAD_TDES_SUPPORTED
@@ -0,0 +1,439 @@
+/**
+*   @file    hse_host_aead_pipe.c
+*
+*   @brief   HSE HOST streaming AEAD pipeline.
+*   @details Two stages alternate: a stage is prepared by the calling thread (FREE -> READY), sent
+*            by whoever holds the in-flight token (READY -> BUSY), completed by the callback
+*            (BUSY -> DONE) and collected by the calling thread (DONE -> FREE). The completion of a
+*            stage passes the token to the other stage when it is READY, so consecutive steps are
+*            sent back to back without waiting for the calling thread.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_aead_pipe.c
+*/
+#include <stdatomic.h>
+#include "hse_host_aead_pipe.h"
+#include "hse_host_ctx.h"
+#include "hse_completion_ring.h"
+#include "hse_srv_builders.h"
+#include "host_stm.h"
+#include "string.h"
+
+#if defined(HSE_SPT_AEAD) && defined(AEAD_STREAM_SUPPORTED)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   State of a stage
+ */
+typedef enum
+{
+    HSE_AEAD_PIPE_STAGE_FREE = 0U,  /* Can be prepared */
+    HSE_AEAD_PIPE_STAGE_READY,      /* Prepared, waiting to be sent */
+    HSE_AEAD_PIPE_STAGE_BUSY,       /* Sent to the HSE */
+    HSE_AEAD_PIPE_STAGE_DONE,       /* Processed, output waiting to be collected */
+} hseAeadPipeStageState_t;
+
+/*
+ * @brief   A chunk of the message in the pipeline
+ */
+typedef struct
+{
+    const uint8_t*  pIn;            /* Input read by the HSE */
+    uint8_t*        pOut;           /* Output written by the HSE */
+    uint32_t        u32Offset;      /* Offset of the chunk in the message */
+    uint32_t        u32Length;
+    atomic_uint     state;          /* hseAeadPipeStageState_t */
+} hseAeadPipeStage_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* The pipeline running */
+static const hseAeadPipeConfig_t*   pAeadPipeConfig = NULL;
+static const uint8_t*               pAeadPipeInput = NULL;
+static uint8_t*                     pAeadPipeOutput = NULL;
+static uint32_t                     u32AeadPipeLength = 0UL;
+static uint32_t                     u32AeadPipeTagLength = 0UL;
+static uint8_t*                     pAeadPipeTag = NULL;
+static uint8_t                      u8AeadPipeChannel = HSE_INVALID_CHANNEL;
+static uint32_t                     u32AeadPipeLastUs = 0UL;
+
+/* Stream context holding the channel, released with the RX interrupt once no step is in flight */
+static hseCtx_t                     aeadPipeCtx;
+static bool_t                       bAeadPipeCtxOpen = FALSE;
+static bool_t                       bAeadPipeIrqEnabled = FALSE;   /* RX interrupt enabled by the pipeline */
+
+static atomic_bool                  bAeadPipeActive;
+static atomic_bool                  bAeadPipeInFlight;  /* In-flight token: a step is sent and not completed */
+static atomic_uint                  u32AeadPipeSend;    /* Stage sent next */
+static atomic_uint                  aeadPipeError;      /* First error of a step (hseSrvResponse_t) */
+
+static hseAeadPipeStage_t aeadPipeStage[2];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static bool_t HSE_AeadPipeSendNext(void);
+static void HSE_AeadPipeComplete(hseSrvResponse_t status, void* pArg);
+static void HSE_AeadPipePrepare(hseAeadPipeStage_t* pStage, uint32_t u32Index, uint32_t u32Offset);
+static void HSE_AeadPipeCollect(hseAeadPipeStage_t* pStage, uint32_t u32Index);
+static void HSE_AeadPipeRelease(void);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Send the next stage if it is READY; called by the holder of the
+ *                 in-flight token. Returns FALSE if nothing was sent (stage not
+ *                 prepared yet, or the stream channel still busy in hardware).
+ ******************************************************************************/
+static bool_t HSE_AeadPipeSendNext(void)
+{
+    const hseAeadPipeConfig_t* pConfig = pAeadPipeConfig;
+    uint32_t u32Index = atomic_load(&u32AeadPipeSend);
+    hseAeadPipeStage_t* pStage = &aeadPipeStage[u32Index];
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[pConfig->u8MuInstance][u8AeadPipeChannel];
+    unsigned int expected = HSE_AEAD_PIPE_STAGE_READY;
+    hseTxOptions_t txOptions;
+
+    /* The steps of the stream are sent on the channel of START, held by the stream context */
+    if(!atomic_compare_exchange_strong(&pStage->state, &expected, HSE_AEAD_PIPE_STAGE_BUSY))
+    {
+        return FALSE;
+    }
+
+    if((pStage->u32Offset + pStage->u32Length) == u32AeadPipeLength)
+    {
+        HSE_BuildAeadReq(pHseSrvDesc, HSE_ACCESS_MODE_FINISH, pConfig->streamId, pConfig->authCipherMode,
+                         pConfig->cipherDir, 0UL, 0UL, NULL, 0UL, NULL, HSE_SGT_OPTION_NONE,
+                         pStage->u32Length, pStage->pIn, u32AeadPipeTagLength, pAeadPipeTag, pStage->pOut);
+    }
+    else
+    {
+        HSE_BuildAeadReq(pHseSrvDesc, HSE_ACCESS_MODE_UPDATE, pConfig->streamId, pConfig->authCipherMode,
+                         pConfig->cipherDir, 0UL, 0UL, NULL, 0UL, NULL, HSE_SGT_OPTION_NONE,
+                         pStage->u32Length, pStage->pIn, 0UL, NULL, pStage->pOut);
+    }
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_AeadPipeComplete;
+    txOptions.pCallbackpArg   = (void*)pStage;
+    if(HSE_SRV_RSP_OK != HSE_SendOnClaimed(pConfig->u8MuInstance, u8AeadPipeChannel, txOptions, pHseSrvDesc,
+                                           HSE_WAIT_DEFAULT_TIMEOUT_US))
+    {
+        atomic_store(&pStage->state, HSE_AEAD_PIPE_STAGE_READY);
+        return FALSE;
+    }
+    atomic_store(&u32AeadPipeSend, 1U - u32Index);
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Step completion callback (MU RX interrupt or HSE_PollCompletions).
+ *                 Passes the in-flight token to the other stage if it is ready.
+ ******************************************************************************/
+static void HSE_AeadPipeComplete(hseSrvResponse_t status, void* pArg)
+{
+    hseAeadPipeStage_t* pStage = (hseAeadPipeStage_t*)pArg;
+    unsigned int expected = (unsigned int)HSE_SRV_RSP_OK;
+
+    atomic_store(&pStage->state, HSE_AEAD_PIPE_STAGE_DONE);
+    if(HSE_SRV_RSP_OK != status)
+    {
+        (void)atomic_compare_exchange_strong(&aeadPipeError, &expected, (unsigned int)status);
+    }
+    /* No step is sent after an error or a timeout */
+    if((HSE_SRV_RSP_OK == (hseSrvResponse_t)atomic_load(&aeadPipeError)) && HSE_AeadPipeSendNext())
+    {
+        return;
+    }
+    atomic_store(&bAeadPipeInFlight, false);
+}
+
+/*******************************************************************************
+ * Description   : Prepare chunk u32Index of the message in a FREE stage.
+ ******************************************************************************/
+static void HSE_AeadPipePrepare(hseAeadPipeStage_t* pStage, uint32_t u32Index, uint32_t u32Offset)
+{
+    const hseAeadPipeConfig_t* pConfig = pAeadPipeConfig;
+    uint32_t u32Left = u32AeadPipeLength - u32Offset;
+
+    pStage->u32Offset = u32Offset;
+    pStage->u32Length = (u32Left < pConfig->u32ChunkSize) ? u32Left : pConfig->u32ChunkSize;
+
+    if(NULL == pConfig->pStage[0])
+    {
+        pStage->pIn  = &pAeadPipeInput[u32Offset];
+        pStage->pOut = &pAeadPipeOutput[u32Offset];
+    }
+    else
+    {
+        /* Processed in place in the staging buffer */
+        (void)memcpy(pConfig->pStage[u32Index], &pAeadPipeInput[u32Offset], pStage->u32Length);
+        pStage->pIn  = pConfig->pStage[u32Index];
+        pStage->pOut = pConfig->pStage[u32Index];
+    }
+    atomic_store(&pStage->state, HSE_AEAD_PIPE_STAGE_READY);
+}
+
+/*******************************************************************************
+ * Description   : Collect the output of a DONE stage and free it.
+ ******************************************************************************/
+static void HSE_AeadPipeCollect(hseAeadPipeStage_t* pStage, uint32_t u32Index)
+{
+    if(NULL != pAeadPipeConfig->pStage[0])
+    {
+        (void)memcpy(&pAeadPipeOutput[pStage->u32Offset], pAeadPipeConfig->pStage[u32Index], pStage->u32Length);
+    }
+    atomic_store(&pStage->state, HSE_AEAD_PIPE_STAGE_FREE);
+}
+
+/*******************************************************************************
+ * Description   : Close the stream context and restore the RX interrupt of its
+ *                 channel; no step may be in flight.
+ ******************************************************************************/
+static void HSE_AeadPipeRelease(void)
+{
+    if(bAeadPipeIrqEnabled)
+    {
+        HSE_MU_DisableInterrupts(aeadPipeCtx.u8MuInstance, HSE_INT_RESPONSE, 1UL << aeadPipeCtx.u8MuChannel);
+        bAeadPipeIrqEnabled = FALSE;
+    }
+    if(bAeadPipeCtxOpen)
+    {
+        HSE_CtxStreamClose(&aeadPipeCtx);
+        bAeadPipeCtxOpen = FALSE;
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Encrypt/decrypt a message through the AEAD pipeline.
+ ******************************************************************************/
+hseSrvResponse_t HSE_AeadPipeRun(const hseAeadPipeConfig_t* pConfig, uint32_t u32Length,
+                                 const uint8_t* pInput, uint8_t* pOutput,
+                                 uint32_t u32TagLength, uint8_t* pTag, uint32_t u32TimeoutUs)
+{
+    hseSrvResponse_t status;
+    hseCtx_t ctx;
+    uint32_t u32Start;
+    uint32_t u32ElapsedUs;
+    uint32_t u32Prepare = 0UL;      /* Stage prepared next */
+    uint32_t u32Offset = 0UL;       /* Offset of the next chunk to prepare */
+    uint32_t u32Collected = 0UL;    /* Bytes collected */
+    bool_t bFinishPrepared = FALSE;
+    bool expected = false;
+    unsigned int expectedError;
+    uint32_t i;
+
+    if((NULL == pConfig) || (pConfig->u8MuInstance >= HSE_NUM_OF_MU_INSTANCES) ||
+       (0UL == pConfig->u32ChunkSize) || (0UL != (pConfig->u32ChunkSize % HSE_AEAD_PIPE_BLOCK_LENGTH)) ||
+       ((NULL == pConfig->pStage[0]) != (NULL == pConfig->pStage[1])) ||
+       (((NULL == pInput) || (NULL == pOutput)) && (0UL != u32Length)) || (NULL == pTag))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    /* The last step of a timed out pipeline may still use the stages */
+    if(atomic_load(&bAeadPipeInFlight) || !atomic_compare_exchange_strong(&bAeadPipeActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    /* The step in flight of a timed out pipeline has completed since */
+    HSE_AeadPipeRelease();
+
+    /* Claim and hold a channel for the stream (waits for a free channel up to the timeout) */
+    ctx = HSE_CtxOnChannel(pConfig->u8MuInstance, HSE_INVALID_CHANNEL, gSyncTxOption);
+    ctx.u32TimeoutUs = u32TimeoutUs;
+    if(HSE_SRV_RSP_OK != HSE_CtxStreamOpen(&ctx, &aeadPipeCtx))
+    {
+        atomic_store(&bAeadPipeActive, false);
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    bAeadPipeCtxOpen = TRUE;
+    u8AeadPipeChannel = aeadPipeCtx.u8MuChannel;
+
+    pAeadPipeConfig      = pConfig;
+    pAeadPipeInput       = pInput;
+    pAeadPipeOutput      = pOutput;
+    u32AeadPipeLength    = u32Length;
+    u32AeadPipeTagLength = u32TagLength;
+    pAeadPipeTag         = pTag;
+    atomic_store(&bAeadPipeInFlight, false);
+    atomic_store(&u32AeadPipeSend, 0U);
+    atomic_store(&aeadPipeError, (unsigned int)HSE_SRV_RSP_OK);
+    for(i = 0UL; i < 2UL; i++)
+    {
+        atomic_store(&aeadPipeStage[i].state, HSE_AEAD_PIPE_STAGE_FREE);
+    }
+    /* Steps complete in the RX interrupt; restored when the stream context is closed */
+    if(0UL == (muRxEnabledInterruptMask[pConfig->u8MuInstance] & (1UL << u8AeadPipeChannel)))
+    {
+        HSE_MU_EnableInterrupts(pConfig->u8MuInstance, HSE_INT_RESPONSE, 1UL << u8AeadPipeChannel);
+        bAeadPipeIrqEnabled = TRUE;
+    }
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    /* START (synchronous) on the held channel, the channel of all the following steps */
+    status = AeadReqCtx(&aeadPipeCtx, HSE_ACCESS_MODE_START, pConfig->streamId, pConfig->authCipherMode,
+                        pConfig->cipherDir, pConfig->keyHandle, pConfig->ivLength, pConfig->pIV,
+                        pConfig->aadLength, pConfig->pAAD, 0UL, NULL, 0UL, NULL, NULL, HSE_SGT_OPTION_NONE);
+
+    while((HSE_SRV_RSP_OK == status) && (!bFinishPrepared || (u32Collected < u32Length) ||
+                                         (HSE_AEAD_PIPE_STAGE_FREE != atomic_load(&aeadPipeStage[0].state)) ||
+                                         (HSE_AEAD_PIPE_STAGE_FREE != atomic_load(&aeadPipeStage[1].state))))
+    {
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        status = (hseSrvResponse_t)atomic_load(&aeadPipeError);
+        if(HSE_SRV_RSP_OK != status)
+        {
+            break;
+        }
+
+        /* Collect the processed chunks, then prepare the next ones while the HSE works */
+        for(i = 0UL; i < 2UL; i++)
+        {
+            if(HSE_AEAD_PIPE_STAGE_DONE == atomic_load(&aeadPipeStage[i].state))
+            {
+                u32Collected += aeadPipeStage[i].u32Length;
+                HSE_AeadPipeCollect(&aeadPipeStage[i], i);
+            }
+        }
+        if(!bFinishPrepared && (HSE_AEAD_PIPE_STAGE_FREE == atomic_load(&aeadPipeStage[u32Prepare].state)))
+        {
+            HSE_AeadPipePrepare(&aeadPipeStage[u32Prepare], u32Prepare, u32Offset);
+            u32Offset += aeadPipeStage[u32Prepare].u32Length;
+            bFinishPrepared = (u32Offset == u32Length) ? TRUE : FALSE;
+            u32Prepare = 1UL - u32Prepare;
+        }
+
+        /* Nothing in flight: the last completion found the next stage not prepared yet */
+        expected = false;
+        if(atomic_compare_exchange_strong(&bAeadPipeInFlight, &expected, true))
+        {
+            if(!HSE_AeadPipeSendNext())
+            {
+                atomic_store(&bAeadPipeInFlight, false);
+            }
+        }
+
+        /* The timebase is read on every pass, also without timeout (the host emulation yields there) */
+        u32ElapsedUs = GetStmTimebaseUs() - u32Start;
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && (u32ElapsedUs >= u32TimeoutUs))
+        {
+            /* Stops the completions from sending the next step, then cancels the step in flight */
+            expectedError = (unsigned int)HSE_SRV_RSP_OK;
+            (void)atomic_compare_exchange_strong(&aeadPipeError, &expectedError, (unsigned int)HSE_SRV_RSP_HOST_TIMEOUT);
+            status = HSE_SRV_RSP_HOST_TIMEOUT;
+            if(atomic_load(&bAeadPipeInFlight))
+            {
+                HSE_CancelAsync(pConfig->u8MuInstance, u8AeadPipeChannel);
+            }
+        }
+    }
+
+    u32AeadPipeLastUs = GetStmTimebaseUs() - u32Start;
+
+    /* After an error, wait for the step in flight (it is not followed by another one);
+     * after a timeout, for its canceled response, at most HSE_WAIT_CANCEL_TIMEOUT_US */
+    u32Start = GetStmTimebaseUs();
+    while(atomic_load(&bAeadPipeInFlight) &&
+          ((HSE_SRV_RSP_HOST_TIMEOUT != status) || ((GetStmTimebaseUs() - u32Start) < HSE_WAIT_CANCEL_TIMEOUT_US)))
+    {
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+    }
+
+    /* Still in flight: the channel and its interrupt are released by the next run */
+    if(!atomic_load(&bAeadPipeInFlight))
+    {
+        HSE_AeadPipeRelease();
+    }
+
+    atomic_store(&bAeadPipeActive, false);
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Duration of the last HSE_AeadPipeRun().
+ ******************************************************************************/
+uint32_t HSE_AeadPipeLastRunUs(void)
+{
+    return u32AeadPipeLastUs;
+}
+
+/*******************************************************************************
+ * Description   : Check whether a step of HSE_AeadPipeRun() is in flight.
+ ******************************************************************************/
+bool_t HSE_AeadPipeBusy(void)
+{
+    return atomic_load(&bAeadPipeInFlight) ? TRUE : FALSE;
+}
+
+#endif /* defined(HSE_SPT_AEAD) && defined(AEAD_STREAM_SUPPORTED) */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,156 @@
+/**
+*   @file    hse_host_aead_pipe.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST streaming AEAD pipeline.
+*   @details Encrypts/decrypts a large message as an AEAD stream split in chunks, with two stages
+*            in flight: while the HSE processes the chunk of one stage, the host prepares the next
+*            chunk in the other stage and collects the output of the previous one.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_AEAD_PIPE_H
+#define HSE_HOST_AEAD_PIPE_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_aead_pipe.h
+*/
+#include "hse_host.h"
+#include "hse_host_aead.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Chunks (except the last one) must be a multiple of the AES block length */
+#define HSE_AEAD_PIPE_BLOCK_LENGTH      (16UL)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   AEAD pipeline configuration
+ */
+typedef struct
+{
+    uint8_t                 u8MuInstance;       /**< @brief    The MU instance of the stream. */
+    hseStreamId_t           streamId;           /**< @brief    The stream (< HSE_STREAM_COUNT). */
+    hseAuthCipherMode_t     authCipherMode;     /**< @brief    HSE_AUTH_CIPHER_MODE_GCM or HSE_AUTH_CIPHER_MODE_CCM. */
+    hseCipherDir_t          cipherDir;          /**< @brief    Encryption or decryption. */
+    hseKeyHandle_t          keyHandle;          /**< @brief    The key. */
+    uint32_t                ivLength;           /**< @brief    The IV/nonce length. */
+    const uint8_t*          pIV;                /**< @brief    The IV/nonce. */
+    uint32_t                aadLength;          /**< @brief    The AAD length (can be 0). */
+    const uint8_t*          pAAD;               /**< @brief    The AAD. */
+    uint32_t                u32ChunkSize;       /**< @brief    Bytes per UPDATE step, a non-zero multiple of HSE_AEAD_PIPE_BLOCK_LENGTH. */
+    uint8_t*                pStage[2];          /**< @brief    Staging buffers of u32ChunkSize bytes, or NULL: the HSE then
+                                                               works on the message directly. Use them when the message is not
+                                                               accessible to the HSE (e.g. in TCM). */
+} hseAeadPipeConfig_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#if defined(HSE_SPT_AEAD) && defined(AEAD_STREAM_SUPPORTED)
+/**
+* @brief        Encrypt/decrypt a message through the AEAD pipeline.
+* @details      Sends START, then one UPDATE per chunk and FINISH with the last chunk and the tag,
+*               on a channel held for the stream (HSE_CtxStreamOpen(); streaming steps must use the
+*               channel of START). The RX interrupt of the channel is enabled while the pipeline runs.
+*               Each step completion sends the next prepared chunk at once (MU RX interrupt, or
+*               HSE_PollCompletions() with deferred completions); the calling thread prepares the
+*               chunks: with staging buffers it copies the next input chunk in and the output of
+*               the processed chunk out while the HSE works on the other stage. In-place operation
+*               (pInput == pOutput) is supported. Only one pipeline can run at a time.
+*               On decryption, the output is released before the tag is verified: discard it
+*               unless HSE_SRV_RSP_OK is returned.
+*
+* @param[in]    pConfig         The pipeline configuration.
+* @param[in]    u32Length       The message length in bytes (can be 0).
+* @param[in]    pInput          The plaintext (encryption) or ciphertext (decryption).
+* @param[out]   pOutput         The ciphertext (encryption) or plaintext (decryption); can be pInput.
+* @param[in]    u32TagLength    The tag length.
+* @param[in,out] pTag           The tag: output on encryption, input on decryption.
+* @param[in]    u32TimeoutUs    The timeout in microseconds, or HSE_WAIT_INFINITE.
+*
+* @return       HSE_SRV_RSP_OK, HSE errors of the steps,
+*               HSE_SRV_RSP_INVALID_PARAM if a parameter is invalid,
+*               HSE_SRV_RSP_NOT_ALLOWED if another pipeline is running,
+*               HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel was freed before the timeout,
+*               HSE_SRV_RSP_HOST_TIMEOUT if the message was not processed in time. The step in flight
+*               is then canceled (HSE_CancelAsync()); if its response is not received within
+*               HSE_WAIT_CANCEL_TIMEOUT_US, the message, tag and staging buffers must stay valid
+*               until HSE_AeadPipeBusy() returns FALSE.
+*/
+hseSrvResponse_t HSE_AeadPipeRun(const hseAeadPipeConfig_t* pConfig, uint32_t u32Length,
+                                 const uint8_t* pInput, uint8_t* pOutput,
+                                 uint32_t u32TagLength, uint8_t* pTag, uint32_t u32TimeoutUs);
+
+/**
+* @brief        Duration of the last HSE_AeadPipeRun(), from START to the end of FINISH.
+* @details      Used to pick the chunk size: throughput = u32Length / duration.
+*
+* @return       The duration in microseconds.
+*/
+uint32_t HSE_AeadPipeLastRunUs(void);
+
+/**
+* @brief        Check whether a step of HSE_AeadPipeRun() is in flight.
+*
+* @return       TRUE if a step was sent and its response not received, FALSE otherwise.
+*/
+bool_t HSE_AeadPipeBusy(void);
+#endif /* defined(HSE_SPT_AEAD) && defined(AEAD_STREAM_SUPPORTED) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_AEAD_PIPE_H */
+
+/** @} */
@@ -9,6 +9,8 @@ extern "C"{
 
 #include "string.h"
 #include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_srv_builders.h"
 
 #include "hse_host_cipher.h"
 
@@ -31,9 +33,6 @@ extern "C"{
 *                                      LOCAL VARIABLES
 ==================================================================================================*/
 
-static uint8_t          muIf = 0U;
-static uint8_t          muChannelIdx = 1U;
-
 /*==================================================================================================
 *                                      GLOBAL CONSTANTS
 ==================================================================================================*/
@@ -47,7 +46,8 @@ static uint8_t          muChannelIdx = 1U;
 /*==================================================================================================
 *                                   LOCAL FUNCTION PROTOTYPES
 ==================================================================================================*/
-static hseSrvResponse_t SymCipherReq(
+static hseSrvResponse_t SymCipherStreamReq(
+    const hseCtx_t* pCtx,
     hseAccessMode_t accessMode,
     hseCipherAlgo_t cipherAlgo,
     hseCipherBlockMode_t cipherBlockMode,
@@ -59,42 +59,12 @@ static hseSrvResponse_t SymCipherReq(
     uint8_t* pOutput,
     hseSGTOption_t inputSgtType);
 
-static hseSrvResponse_t SymCipherStartReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    const uint8_t* pIV,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType);
-
-static hseSrvResponse_t SymCipherUpdateReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType);
-
-static hseSrvResponse_t SymCipherFinishReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType);
-
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
 ==================================================================================================*/
 
-static hseSrvResponse_t SymCipherReq(
+static hseSrvResponse_t SymCipherStreamReq(
+    const hseCtx_t* pCtx,
     hseAccessMode_t accessMode,
     hseCipherAlgo_t cipherAlgo,
     hseCipherBlockMode_t cipherBlockMode,
@@ -106,30 +76,20 @@ static hseSrvResponse_t SymCipherReq(
     uint8_t* pOutput,
     hseSGTOption_t inputSgtType)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseSymCipherSrv_t* pSymCipherReq;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId              = HSE_SRV_ID_SYM_CIPHER;
-    pSymCipherReq                   = &pHseSrvDesc->hseSrv.symCipherReq;
-
-    pSymCipherReq->accessMode       = accessMode;
-    pSymCipherReq->cipherAlgo       = cipherAlgo;
-    pSymCipherReq->cipherBlockMode  = cipherBlockMode;
-    pSymCipherReq->cipherDir        = cipherDir;
-    pSymCipherReq->keyHandle        = keyHandle;
+    return SymCipherReqCtx(pCtx, accessMode, 0U, cipherAlgo, cipherBlockMode, cipherDir,
+                           keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
+}
 
-    pSymCipherReq->pIV              = (HOST_ADDR)pIV;
-    pSymCipherReq->inputLength      = inputLength;
-    pSymCipherReq->pInput           = (HOST_ADDR)pInput;
-    pSymCipherReq->pOutput          = (HOST_ADDR)pOutput;
-    pSymCipherReq->sgtOption        = inputSgtType;
+/* TODO: AES XTS */
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
-}
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
 
-static hseSrvResponse_t SymCipherMuReq(
+hseSrvResponse_t SymCipherReqCtx(
+    const hseCtx_t* pCtx,
     hseAccessMode_t accessMode,
+    uint32_t streamId,
     hseCipherAlgo_t cipherAlgo,
     hseCipherBlockMode_t cipherBlockMode,
     hseCipherDir_t cipherDir,
@@ -138,170 +98,160 @@ static hseSrvResponse_t SymCipherMuReq(
     uint32_t inputLength,
     const uint8_t* pInput,
     uint8_t* pOutput,
-    hseSGTOption_t inputSgtType,
-    uint8_t mu)
+    hseSGTOption_t inputSgtType)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[mu][muChannelIdx];
-    hseSymCipherSrv_t* pSymCipherReq;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, streamId, &muChannelIdx, &hseStatus);
 
-    pHseSrvDesc->srvId              = HSE_SRV_ID_SYM_CIPHER;
-    pSymCipherReq                   = &pHseSrvDesc->hseSrv.symCipherReq;
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
 
-    pSymCipherReq->accessMode       = accessMode;
-    pSymCipherReq->cipherAlgo       = cipherAlgo;
-    pSymCipherReq->cipherBlockMode  = cipherBlockMode;
-    pSymCipherReq->cipherDir        = cipherDir;
-    pSymCipherReq->keyHandle        = keyHandle;
+    HSE_BuildSymCipherReq(pHseSrvDesc, accessMode, streamId, cipherAlgo, cipherBlockMode, cipherDir,
+                          inputSgtType, keyHandle, pIV, inputLength, pInput, pOutput);
 
-    pSymCipherReq->pIV              = (HOST_ADDR)pIV;
-    pSymCipherReq->inputLength      = inputLength;
-    pSymCipherReq->pInput           = (HOST_ADDR)pInput;
-    pSymCipherReq->pOutput          = (HOST_ADDR)pOutput;
-    pSymCipherReq->sgtOption        = inputSgtType;
-
-    return HSE_Send(mu, muChannelIdx, gSyncTxOption, pHseSrvDesc);
-}
-
-static hseSrvResponse_t SymCipherStartReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    const uint8_t *pIV,
-    uint32_t inputLength,
-    const uint8_t *pInput,
-    uint8_t *pOutput,
-    hseSGTOption_t inputSgtType)
-{
-    return SymCipherReq(HSE_ACCESS_MODE_START, cipherAlgo,
-                        cipherBlockMode, cipherDir, keyHandle,
-                        pIV, inputLength, pInput, pOutput, inputSgtType);
+    return HSE_CtxStreamSend(pCtx, accessMode, streamId, muChannelIdx, pHseSrvDesc);
 }
 
-static hseSrvResponse_t SymCipherUpdateReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType)
+/* ==== AES ====*/
+hseSrvResponse_t AesEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                               const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                               uint8_t* pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherReq(HSE_ACCESS_MODE_UPDATE, cipherAlgo,
-                        cipherBlockMode, cipherDir, keyHandle,
-                        0, inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_CIPHER_ALGO_AES,
+                           cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT,
+                           keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
 }
 
-static hseSrvResponse_t SymCipherFinishReq(
-    hseCipherAlgo_t cipherAlgo,
-    hseCipherBlockMode_t cipherBlockMode,
-    hseCipherDir_t cipherDir,
-    hseKeyHandle_t keyHandle,
-    uint32_t inputLength,
-    const uint8_t* pInput,
-    uint8_t* pOutput,
-    hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                               const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                               uint8_t* pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherReq(HSE_ACCESS_MODE_FINISH, cipherAlgo,
-                        cipherBlockMode, cipherDir, keyHandle,
-                        0, inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_CIPHER_ALGO_AES,
+                           cipherBlockMode, HSE_CIPHER_DIR_DECRYPT,
+                           keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
 }
 
-/* TODO: AES XTS */
-
-/*==================================================================================================
-*                                       GLOBAL FUNCTIONS
-==================================================================================================*/
-
-/* ==== AES ====*/
-hseSrvResponse_t AesCrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                            hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
-                            const uint8_t* pInput, uint8_t* pOutput)
+hseSrvResponse_t AesCryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                             hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
+                             const uint8_t* pInput, uint8_t* pOutput)
 {
-    return SymCipherReq(HSE_ACCESS_MODE_ONE_PASS, HSE_CIPHER_ALGO_AES,
-                        cipherBlockMode, cipherDir,
-                        keyHandle, pIV, inputLength, pInput, pOutput, 0U);
+    return SymCipherReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_CIPHER_ALGO_AES,
+                           cipherBlockMode, cipherDir,
+                           keyHandle, pIV, inputLength, pInput, pOutput, 0U);
 }
 hseSrvResponse_t AesCryptMu(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                             hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
                             const uint8_t* pInput, uint8_t* pOutput, uint8_t mu)
 {
-    return SymCipherMuReq(HSE_ACCESS_MODE_ONE_PASS, HSE_CIPHER_ALGO_AES,
-                          cipherBlockMode, cipherDir,
-                          keyHandle,pIV, inputLength, pInput, pOutput, 0U, mu);
-}
-hseSrvResponse_t AesEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, 
-                            const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput, 
-                            uint8_t* pOutput, hseSGTOption_t inputSgtType)
-{
-    return SymCipherReq(HSE_ACCESS_MODE_ONE_PASS, HSE_CIPHER_ALGO_AES,
-                        cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT,
-                        keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
-}
+    const hseCtx_t ctx = HSE_CTX_INIT(mu);
 
-hseSrvResponse_t AesDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, 
-                            const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput, 
-                            uint8_t* pOutput,  hseSGTOption_t inputSgtType)
-{
-    return SymCipherReq(HSE_ACCESS_MODE_ONE_PASS, HSE_CIPHER_ALGO_AES,
-                        cipherBlockMode, HSE_CIPHER_DIR_DECRYPT,
-                        keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
+    return AesCryptCtx(&ctx, keyHandle, cipherBlockMode, cipherDir, pIV, inputLength, pInput, pOutput);
 }
 
-hseSrvResponse_t AesStartStreamEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                       const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
-                                       uint8_t* pOutput, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, hseCipherDir_t cipherDir,
+     const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput),
+    (keyHandle, cipherBlockMode, cipherDir, pIV, inputLength, pInput, pOutput))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesEncrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, const uint8_t *pIV,
+     uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, pIV, inputLength, pInput, pOutput, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesDecrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, const uint8_t *pIV,
+     uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, pIV, inputLength, pInput, pOutput, inputSgtType))
+
+hseSrvResponse_t AesStartStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                          const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                                          uint8_t* pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherStartReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT, keyHandle,
-                             pIV, inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_START, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT,
+                              keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
 }
 
-hseSrvResponse_t AesUpdateStreamEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                      uint32_t inputLength, const uint8_t *pInput,
-                                      uint8_t *pOutput, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesUpdateStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput,
+                                           uint8_t *pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherUpdateReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT, keyHandle,
-                             inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_UPDATE, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT,
+                              keyHandle, NULL, inputLength, pInput, pOutput, inputSgtType);
 }
 
-hseSrvResponse_t AesFinishStreamEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                        uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesFinishStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput,
+                                           uint8_t *pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherFinishReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT, keyHandle,
-                             inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_FINISH, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_ENCRYPT,
+                              keyHandle, NULL, inputLength, pInput, pOutput, inputSgtType);
 }
 
-hseSrvResponse_t AesStartStreamDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                       const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
-                                       uint8_t *pOutput, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesStartStreamEncrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, const uint8_t *pIV,
+     uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, pIV, inputLength, pInput, pOutput, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesUpdateStreamEncrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+     uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, inputLength, pInput, pOutput, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesFinishStreamEncrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+     uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, inputLength, pInput, pOutput, inputSgtType))
+
+hseSrvResponse_t AesStartStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                          const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                                          uint8_t* pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherStartReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT, keyHandle,
-                             pIV, inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_START, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT,
+                              keyHandle, pIV, inputLength, pInput, pOutput, inputSgtType);
 }
 
-hseSrvResponse_t AesUpdateStreamDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                      uint32_t inputLength, const uint8_t *pInput,
-                                      uint8_t *pOutput, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesUpdateStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput,
+                                           uint8_t *pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherUpdateReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT, keyHandle,
-                             inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_UPDATE, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT,
+                              keyHandle, NULL, inputLength, pInput, pOutput, inputSgtType);
 }
 
-hseSrvResponse_t AesFinishStreamDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
-                                        uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesFinishStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput,
+                                           uint8_t *pOutput, hseSGTOption_t inputSgtType)
 {
-    return SymCipherFinishReq(HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT, keyHandle,
-                             inputLength, pInput, pOutput, inputSgtType);
+    return SymCipherStreamReq(pCtx, HSE_ACCESS_MODE_FINISH, HSE_CIPHER_ALGO_AES, cipherBlockMode, HSE_CIPHER_DIR_DECRYPT,
+                              keyHandle, NULL, inputLength, pInput, pOutput, inputSgtType);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesStartStreamDecrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode, const uint8_t *pIV,
+     uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, pIV, inputLength, pInput, pOutput, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesUpdateStreamDecrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+     uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, inputLength, pInput, pOutput, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesFinishStreamDecrypt,
+    (hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+     uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType),
+    (keyHandle, cipherBlockMode, inputLength, pInput, pOutput, inputSgtType))
+
 #ifdef HSE_SPT_XTS_AES
 hseSrvResponse_t AesXtsEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                                const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
                                uint8_t *pOutput)
 {
     hseSrvResponse_t hseResponse;
+    hseSrvDescriptor_t* pHseSrvDesc;
+    uint8_t muChannelIdx;
     (void)keyHandle;
     (void)cipherBlockMode;
     (void)pIV;
@@ -309,9 +259,14 @@ hseSrvResponse_t AesXtsEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t ci
     (void)pInput;
     (void)pOutput;
 
-    memset(&gHseSrvDesc[muIf][muChannelIdx], 0, sizeof(hseSrvDescriptor_t));
-    gHseSrvDesc[muIf][muChannelIdx].srvId = HSE_SRV_ID_XTS_AES_CIPHER;
-    hseResponse = HSE_Send(muIf, muChannelIdx, gSyncTxOption, &gHseSrvDesc[muIf][muChannelIdx]);
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_XTS_AES_CIPHER;
+    hseResponse = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
 
     return hseResponse;
 }
@@ -321,6 +276,8 @@ hseSrvResponse_t AesXtsDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t ci
                             uint8_t* pOutput)
 {
     hseSrvResponse_t hseResponse;
+    hseSrvDescriptor_t* pHseSrvDesc;
+    uint8_t muChannelIdx;
     (void)keyHandle;
     (void)cipherBlockMode;
     (void)pIV;
@@ -328,9 +285,14 @@ hseSrvResponse_t AesXtsDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t ci
     (void)pInput;
     (void)pOutput;
 
-    memset(&gHseSrvDesc[muIf][muChannelIdx], 0, sizeof(hseSrvDescriptor_t));
-    gHseSrvDesc[muIf][muChannelIdx].srvId = HSE_SRV_ID_XTS_AES_CIPHER;
-    hseResponse = HSE_Send(muIf, muChannelIdx, gSyncTxOption, &gHseSrvDesc[muIf][muChannelIdx]);
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_XTS_AES_CIPHER;
+    hseResponse = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
 
     return hseResponse;
 }
@@ -15,6 +15,7 @@ extern "C" {
 
 #include "hse_interface.h"
 #include "hse_host_utils.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
  *                              SOURCE FILE VERSION INFORMATION
@@ -51,6 +52,37 @@ extern "C" {
 
 /* ==== AES ====*/
 /* General */
+/* Context variants: MU, channel, TX options and deadline taken from pCtx */
+hseSrvResponse_t SymCipherReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                                 hseCipherAlgo_t cipherAlgo, hseCipherBlockMode_t cipherBlockMode,
+                                 hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle, const uint8_t* pIV,
+                                 uint32_t inputLength, const uint8_t* pInput, uint8_t* pOutput,
+                                 hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                               const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                               uint8_t* pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                               const uint8_t *pIV, uint32_t inputLength, const uint8_t* pInput,
+                               uint8_t* pOutput, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t AesCryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                             hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
+                             const uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesStartStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                          const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                          uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesUpdateStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesFinishStreamEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesStartStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                          const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                          uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesUpdateStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesFinishStreamDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                           uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+
 hseSrvResponse_t AesCrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                           hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
                           const uint8_t *pInput, uint8_t *pOutput);
@@ -66,6 +98,8 @@ hseSrvResponse_t AesDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t ciphe
                             const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
                             uint8_t *pOutput, hseSGTOption_t inputSgtType);
 
+/* Streaming on gHseDefaultCtx: the START claims a channel of MU0, held for the stream until its FINISH
+ * or a failed step (see HSE_CtxStreamAcquire) */
 hseSrvResponse_t AesStartStreamEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                                        const uint8_t *pIV,
                                        uint32_t inputLength, const uint8_t *pInput,
@@ -89,6 +123,40 @@ hseSrvResponse_t AesUpdateStreamDecrypt(hseKeyHandle_t keyHandle, hseCipherBlock
 hseSrvResponse_t AesFinishStreamDecrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                                         uint32_t inputLength, const uint8_t *pInput,
                                         uint8_t *pOutput, hseSGTOption_t inputSgtType);
+
+/* Asynchronous variants: sent on a free channel of MU0 with txOptions (see HSE_CTX_DEFINE_SYNC_ASYNC) */
+hseSrvResponse_t AesCryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                               hseCipherDir_t cipherDir, const uint8_t *pIV, uint32_t inputLength,
+                               const uint8_t *pInput, uint8_t *pOutput);
+hseSrvResponse_t AesEncryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                 const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                 uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesDecryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                 const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                 uint8_t *pOutput, hseSGTOption_t inputSgtType);
+/* Asynchronous streaming variants: sent on the channel of pStreamCtx (HSE_CtxStreamOpen) with txOptions
+ * (see HSE_CTX_DEFINE_STREAM_ASYNC); close pStreamCtx after the callback of the FINISH */
+hseSrvResponse_t AesStartStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                            hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                            const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                            uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesUpdateStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                             uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesFinishStreamEncryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                             uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesStartStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                            hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                            const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
+                                            uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesUpdateStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                             uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesFinishStreamDecryptAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
+                                             uint32_t inputLength, const uint8_t *pInput, uint8_t *pOutput, hseSGTOption_t inputSgtType);
+
 #ifdef HSE_SPT_XTS_AES
 hseSrvResponse_t AesXtsEncrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t cipherBlockMode,
                                const uint8_t *pIV, uint32_t inputLength, const uint8_t *pInput,
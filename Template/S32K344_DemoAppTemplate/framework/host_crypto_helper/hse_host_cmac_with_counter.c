@@ -29,6 +29,7 @@ extern "C"{
 ==================================================================================================*/
 #include "string.h"
 #include "hse_host.h"
+#include "hse_host_ctx.h"
 #include "hse_host_cmac_with_counter.h"
 
 #ifdef HSE_SPT_CMAC_WITH_COUNTER
@@ -45,9 +46,6 @@ extern "C"{
 *                                      LOCAL CONSTANTS
 ==================================================================================================*/
 
-static const uint8_t muInstance = 0U;
-static const uint8_t muChIdx = 1U;
-
 /*==================================================================================================
 *                                      LOCAL VARIABLES
 ==================================================================================================*/
@@ -72,13 +70,20 @@ static const uint8_t muChIdx = 1U;
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
 
-hseSrvResponse_t CmacWithCounter(hseKeyHandle_t keyHandle, hseAuthDir_t authDir, uint32_t cntIndex, uint8_t rpOffset,
-                                 uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag, 
-                                 uint32_t *pVolatileCnt, hseSGTOption_t inputSgtType)
+hseSrvResponse_t CmacWithCounterCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
+                                    uint32_t cntIndex, uint8_t rpOffset,
+                                    uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag,
+                                    uint32_t *pVolatileCnt, hseSGTOption_t inputSgtType)
 {
-    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muInstance][muChIdx];
+    uint8_t muChIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChIdx);
     hseCmacWithCounterSrv_t *pCMacWithCounterSrv;
 
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
     pHseSrvDesc->srvId                    = HSE_SRV_ID_CMAC_WITH_COUNTER;
@@ -95,9 +100,15 @@ hseSrvResponse_t CmacWithCounter(hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
     pCMacWithCounterSrv->pVolatileCounter = (HOST_ADDR)pVolatileCnt;
     pCMacWithCounterSrv->sgtOption        = inputSgtType;
 
-    return HSE_Send(muInstance, muChIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChIdx, pHseSrvDesc);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(CmacWithCounter,
+    (hseKeyHandle_t keyHandle, hseAuthDir_t authDir, uint32_t cntIndex, uint8_t rpOffset, uint32_t msgLength,
+     const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag, uint32_t *pVolatileCnt,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, authDir, cntIndex, rpOffset, msgLength, pMsg, tagLength, pTag, pVolatileCnt, inputSgtType))
+
 #endif /* HSE_SPT_CMAC_WITH_COUNTER */
 
 #ifdef __cplusplus
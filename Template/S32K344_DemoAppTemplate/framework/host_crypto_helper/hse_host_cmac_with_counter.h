@@ -32,6 +32,7 @@ extern "C"{
 ==================================================================================================*/
 #include "hse_interface.h"
 #include "hse_host_utils.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
 *                                          CONSTANTS
@@ -62,6 +63,17 @@ hseSrvResponse_t CmacWithCounter(hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
                                  uint32_t msgLength, const uint8_t *pMsg,
                                  uint8_t tagLength, const uint8_t *pTag,
                                  uint32_t *pVolatileCnt, hseSGTOption_t inputSgtType);
+hseSrvResponse_t CmacWithCounterAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                      hseAuthDir_t authDir, uint32_t cntIndex, uint8_t rpOffset,
+                                      uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength,
+                                      const uint8_t *pTag, uint32_t *pVolatileCnt, hseSGTOption_t inputSgtType);
+
+/* Context variant: MU, channel, TX options and deadline taken from pCtx */
+hseSrvResponse_t CmacWithCounterCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseAuthDir_t authDir,
+                                    uint32_t cntIndex, uint8_t rpOffset,
+                                    uint32_t msgLength, const uint8_t *pMsg,
+                                    uint8_t tagLength, const uint8_t *pTag,
+                                    uint32_t *pVolatileCnt, hseSGTOption_t inputSgtType);
 
 #ifdef __cplusplus
 }
@@ -8,14 +8,23 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_srv_builders.h"
 #include "hse_keys_allocator.h"
 #include "string.h"
 
 #include "hse_host_hash.h"
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+#include "hse_host_sha2.h"
+#include "host_stm.h"
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
 /*==================================================================================================
 *                                       LOCAL MACROS
 ==================================================================================================*/
 
+/* Hashes per timed path and input length in HashHostCalibrate() */
+#define HASH_HOST_CALIBRATION_RUNS      (8UL)
+
 /*==================================================================================================
 *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
 ==================================================================================================*/
@@ -27,8 +36,14 @@ extern "C"{
 /*==================================================================================================
 *                                      LOCAL VARIABLES
 ==================================================================================================*/
-static uint8_t          localMuIf = 0U;
-static uint8_t          localMuChannelIdx = 1U;
+
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+/* Host path threshold of SHA2_256 and SHA2_512: inputs shorter than it are hashed on the host */
+static uint32_t hashHostThreshold[2] = { HASH_HOST_DEFAULT_THRESHOLD, HASH_HOST_DEFAULT_THRESHOLD };
+
+/* Input of the calibration, also read by the HSE */
+static uint8_t hashCalibrationInput[HASH_HOST_CALIBRATION_MAX];
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
 
 /*==================================================================================================
 *                                      GLOBAL CONSTANTS
@@ -42,76 +57,127 @@ static uint8_t          localMuChannelIdx = 1U;
 *                                   LOCAL FUNCTION PROTOTYPES
 ==================================================================================================*/
 
-#ifdef HASH_STREAM_SUPPORTED
-static hseSrvResponse_t HashDataStreamStart(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
-                                           const uint8_t muChannelIdx, uint32_t streamId);
-
-static hseSrvResponse_t HashDataStreamUpdate(hseHashAlgo_t hashAlgo, const uint8_t muIf,
-                                             const uint8_t muChannelIdx, uint32_t streamId,
-                                             uint32_t inputLength, const uint8_t *pInput);
-
-static hseSrvResponse_t HashDataStreamFinish(hseHashAlgo_t hashAlgo, const uint8_t muIf,
-                                             const uint8_t muChannelIdx, uint32_t streamId,
-                                             uint32_t inputLength, const uint8_t *pInput, 
-                                             uint32_t *pHashLength, uint8_t *pHash);
-#endif
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
 ==================================================================================================*/
 
-hseSrvResponse_t HashReq(hseAccessMode_t accessMode, const uint8_t muIf,
-                                const uint8_t muChannelIdx, hseHashAlgo_t hashAlgo,
-                                uint32_t streamId, uint32_t inputLength,
-                                const uint8_t* pInput, uint32_t* pHashLength,
-                                uint8_t* pHash, hseTxOptions_t txOptions, hseSGTOption_t inputSgtType)
+/* TODO: SHAKE */
+
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+/* Index of the host path threshold of an algorithm, -1 if it has no host path */
+static int32_t HashHostIndex(hseHashAlgo_t hashAlgo)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseHashSrv_t* pHashSrv;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    if(HSE_HASH_ALGO_SHA2_256 == hashAlgo)
+    {
+        return 0;
+    }
+    if(HSE_HASH_ALGO_SHA2_512 == hashAlgo)
+    {
+        return 1;
+    }
+    return -1;
+}
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_HASH;
-    pHashSrv = &(pHseSrvDesc->hseSrv.hashReq);
+/* Host digest of index HashHostIndex(); returns the digest length */
+static uint32_t HashHostDigest(int32_t index, const uint8_t* pInput, uint32_t inputLength, uint8_t* pDigest)
+{
+    if(0 == index)
+    {
+        HostSha256(pInput, inputLength, pDigest);
+        return HOST_SHA256_DIGEST_LENGTH;
+    }
+    HostSha512(pInput, inputLength, pDigest);
+    return HOST_SHA512_DIGEST_LENGTH;
+}
+
+/* Time HASH_HOST_CALIBRATION_RUNS host and HSE hashes of one length; the host digest must match */
+static hseSrvResponse_t HashHostTime(int32_t index, uint32_t length, bool_t* pHostFaster)
+{
+    static const hseHashAlgo_t hashAlgo[2] = { HSE_HASH_ALGO_SHA2_256, HSE_HASH_ALGO_SHA2_512 };
+    hseSrvResponse_t hseStatus = HSE_SRV_RSP_OK;
+    uint8_t hostDigest[HOST_SHA512_DIGEST_LENGTH];
+    uint8_t hseDigest[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t digestLength = 0UL;
+    uint32_t hseLength = 0UL;
+    uint32_t hostUs;
+    uint32_t hseUs;
+    uint32_t start;
+    uint32_t i;
+
+    start = GetStmTimebaseUs();
+    for(i = 0UL; i < HASH_HOST_CALIBRATION_RUNS; i++)
+    {
+        digestLength = HashHostDigest(index, hashCalibrationInput, length, hostDigest);
+    }
+    hostUs = GetStmTimebaseUs() - start;
 
-    pHashSrv->accessMode    = accessMode;
-    pHashSrv->hashAlgo      = hashAlgo;
-    pHashSrv->streamId      = streamId;
-    pHashSrv->inputLength   = inputLength;
-    pHashSrv->pInput        = (HOST_ADDR)pInput;
-    pHashSrv->pHashLength   = (HOST_ADDR)pHashLength;
-    pHashSrv->pHash         = (HOST_ADDR)pHash;
-    pHashSrv->sgtOption     = inputSgtType;
+    start = GetStmTimebaseUs();
+    for(i = 0UL; (i < HASH_HOST_CALIBRATION_RUNS) && (HSE_SRV_RSP_OK == hseStatus); i++)
+    {
+        hseLength = sizeof(hseDigest);
+        hseStatus = HashDataCtx(&gHseDefaultCtx, hashAlgo[index], length, hashCalibrationInput,
+                                &hseLength, hseDigest, HSE_SGT_OPTION_NONE);
+    }
+    hseUs = GetStmTimebaseUs() - start;
 
-    return HSE_Send(muIf, muChannelIdx, txOptions, pHseSrvDesc);
+    if((HSE_SRV_RSP_OK == hseStatus) &&
+       ((hseLength != digestLength) || (0 != memcmp(hostDigest, hseDigest, digestLength))))
+    {
+        hseStatus = HSE_SRV_RSP_VERIFY_FAILED;
+    }
+    *pHostFaster = (hostUs <= hseUs) ? TRUE : FALSE;
+    return hseStatus;
 }
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
 
-#ifdef HASH_STREAM_SUPPORTED
-static hseSrvResponse_t HashDataStreamStart(hseHashAlgo_t hashAlgo, const uint8_t muIf,
-                                            const uint8_t muChannelIdx, uint32_t streamId)
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+hseSrvResponse_t HashReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode,
+                            hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t inputLength,
+                            const uint8_t* pInput, uint32_t* pHashLength,
+                            uint8_t* pHash, hseSGTOption_t inputSgtType)
 {
-    return HashReq(HSE_ACCESS_MODE_START, muIf, muChannelIdx, hashAlgo, streamId, 0, NULL, 0, NULL, gSyncTxOption, 0U);
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, streamId, &muChannelIdx, &hseStatus);
+
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
+
+    HSE_BuildHashReq(pHseSrvDesc, accessMode, streamId, hashAlgo, inputSgtType,
+                     inputLength, pInput, pHashLength, pHash);
+
+    return HSE_CtxStreamSend(pCtx, accessMode, streamId, muChannelIdx, pHseSrvDesc);
 }
 
-static hseSrvResponse_t HashDataStreamUpdate(hseHashAlgo_t hashAlgo, const uint8_t muIf,
-                                             const uint8_t muChannelIdx, uint32_t streamId,
-                                             uint32_t inputLength, const uint8_t* pInput)
+hseSrvResponse_t HashReq(hseAccessMode_t accessMode, const uint8_t muIf,
+                                const uint8_t muChannelIdx, hseHashAlgo_t hashAlgo,
+                                uint32_t streamId, uint32_t inputLength,
+                                const uint8_t* pInput, uint32_t* pHashLength,
+                                uint8_t* pHash, hseTxOptions_t txOptions, hseSGTOption_t inputSgtType)
 {
-    return HashReq(HSE_ACCESS_MODE_UPDATE, muIf, muChannelIdx, hashAlgo, streamId, inputLength, pInput, 0, NULL, gSyncTxOption, 0U);
+    hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, txOptions);
+
+    return HashReqCtx(&ctx, accessMode, hashAlgo, streamId, inputLength, pInput,
+                      pHashLength, pHash, inputSgtType);
 }
 
-static hseSrvResponse_t HashDataStreamFinish(hseHashAlgo_t hashAlgo, const uint8_t muIf,
-                                             const uint8_t muChannelIdx, uint32_t streamId,
-                                             uint32_t inputLength, const uint8_t* pInput,
-                                             uint32_t* pHashLength, uint8_t* pHash)
+hseSrvResponse_t HashDataCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t inputLength,
+                             const uint8_t* pInput, uint32_t* pHashLength,
+                             uint8_t* pHash, hseSGTOption_t inputSgtType)
 {
-    return HashReq(HSE_ACCESS_MODE_FINISH, muIf, muChannelIdx, hashAlgo, streamId, inputLength, pInput, pHashLength, pHash, gSyncTxOption, 0U);
+    return HashReqCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, hashAlgo, 0U,
+                      inputLength, pInput, pHashLength, pHash, inputSgtType);
 }
-#endif
 
-/* TODO: SHAKE */
+HSE_CTX_DEFINE_ASYNC(HashData,
+    (hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput, uint32_t* pHashLength,
+     uint8_t* pHash, hseSGTOption_t inputSgtType),
+    (hashAlgo, inputLength, pInput, pHashLength, pHash, inputSgtType))
 
-/*==================================================================================================
-*                                       GLOBAL FUNCTIONS
-==================================================================================================*/
 hseSrvResponse_t HashDataSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
                              const uint8_t muChannelIdx, uint32_t inputLength, 
                              const uint8_t * pInput, uint32_t* pHashLength, 
@@ -125,7 +191,7 @@ hseSrvResponse_t HashDataDefSrv(hseHashAlgo_t hashAlgo, uint32_t inputLength,
                              const uint8_t *pInput, uint32_t *pHashLength, 
                              uint8_t *pHash, hseSGTOption_t inputSgtType)
 {
-    return HashDataSrv(hashAlgo, localMuIf, localMuChannelIdx, inputLength, pInput, pHashLength, pHash, gSyncTxOption, inputSgtType);
+    return HashDataCtx(&gHseDefaultCtx, hashAlgo, inputLength, pInput, pHashLength, pHash, inputSgtType);
 }
 
 hseSrvResponse_t HashDataAsyncSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
@@ -136,28 +202,64 @@ hseSrvResponse_t HashDataAsyncSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf,
     return HashDataSrv(hashAlgo, muIf, muChannelIdx, inputLength, pInput, pHashLength, pHash, txOptions, 0U);
 }
 
+#ifdef HASH_STREAM_SUPPORTED
+hseSrvResponse_t HashDataStartStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId)
+{
+    return HashReqCtx(pCtx, HSE_ACCESS_MODE_START, hashAlgo, streamId, 0, NULL, 0, NULL, 0U);
+}
+
+HSE_CTX_DEFINE_STREAM_ASYNC(HashDataStartStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId),
+    (hashAlgo, streamId))
+
+hseSrvResponse_t HashDataUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                         uint32_t inputLength, const uint8_t* pInput)
+{
+    return HashReqCtx(pCtx, HSE_ACCESS_MODE_UPDATE, hashAlgo, streamId, inputLength, pInput, 0, NULL, 0U);
+}
+
+HSE_CTX_DEFINE_STREAM_ASYNC(HashDataUpdateStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t inputLength, const uint8_t* pInput),
+    (hashAlgo, streamId, inputLength, pInput))
+
+hseSrvResponse_t HashDataFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                         uint32_t inputLength, const uint8_t* pInput,
+                                         uint32_t* pHashLength, uint8_t* pHash)
+{
+    return HashReqCtx(pCtx, HSE_ACCESS_MODE_FINISH, hashAlgo, streamId, inputLength, pInput, pHashLength, pHash, 0U);
+}
+
+HSE_CTX_DEFINE_STREAM_ASYNC(HashDataFinishStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t inputLength, const uint8_t* pInput,
+     uint32_t* pHashLength, uint8_t* pHash),
+    (hashAlgo, streamId, inputLength, pInput, pHashLength, pHash))
+
 hseSrvResponse_t HashDataStartStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
                                         const uint8_t muChannelIdx, uint32_t streamId)
 {
-    return HashDataStreamStart(hashAlgo, muIf, muChannelIdx, streamId);
+    hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, gSyncTxOption);
+
+    return HashDataStartStreamCtx(&ctx, hashAlgo, streamId);
 }
 
 hseSrvResponse_t HashDataStartStreamDefSrv(hseHashAlgo_t hashAlgo, uint32_t streamId)
 {
-    return HashDataStartStreamSrv(hashAlgo, localMuIf, localMuChannelIdx, streamId);
+    return HashDataStartStreamCtx(&gHseDefaultCtx, hashAlgo, streamId);
 }
 
 hseSrvResponse_t HashDataUpdateStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
                                          const uint8_t muChannelIdx, uint32_t streamId, 
                                          uint32_t inputLength, const uint8_t* pInput)
 {
-    return  HashDataStreamUpdate(hashAlgo, muIf, muChannelIdx, streamId, inputLength, pInput);
+    hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, gSyncTxOption);
+
+    return HashDataUpdateStreamCtx(&ctx, hashAlgo, streamId, inputLength, pInput);
 }
 
 hseSrvResponse_t HashDataUpdateStreamDefSrv(hseHashAlgo_t hashAlgo, uint32_t streamId, 
                                             uint32_t inputLength, const uint8_t* pInput)
 {
-    return HashDataUpdateStreamSrv(hashAlgo, localMuIf, localMuChannelIdx, streamId, inputLength, pInput);
+    return HashDataUpdateStreamCtx(&gHseDefaultCtx, hashAlgo, streamId, inputLength, pInput);
 }
 
 hseSrvResponse_t HashDataFinishStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
@@ -165,26 +267,130 @@ hseSrvResponse_t HashDataFinishStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t m
                                          uint32_t inputLength, const uint8_t* pInput, 
                                          uint32_t* pHashLength, uint8_t* tagOutput)
 {
-    return HashDataStreamFinish(hashAlgo, muIf, 
-                                muChannelIdx, streamId,
-                                inputLength, pInput,
-                                pHashLength, tagOutput);
+    hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, gSyncTxOption);
+
+    return HashDataFinishStreamCtx(&ctx, hashAlgo, streamId, inputLength, pInput,
+                                   pHashLength, tagOutput);
 }
 
 hseSrvResponse_t HashDataFinishStreamDefSrv(hseHashAlgo_t hashAlgo, uint32_t streamId, 
                                             uint32_t inputLength, const uint8_t* pInput, 
                                             uint32_t* pHashLength, uint8_t* tagOutput)
 {
-    return HashDataFinishStreamSrv(hashAlgo, localMuIf, localMuChannelIdx, streamId, inputLength, pInput, 
+    return HashDataFinishStreamCtx(&gHseDefaultCtx, hashAlgo, streamId, inputLength, pInput,
                                    pHashLength, tagOutput);
 }
+#endif /* HASH_STREAM_SUPPORTED */
+
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+hseSrvResponse_t HashPublicData(hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+                                uint32_t* pHashLength, uint8_t* pHash)
+{
+    uint8_t digest[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t digestLength;
+    int32_t index = HashHostIndex(hashAlgo);
+
+    if((index >= 0) && (inputLength < hashHostThreshold[index]))
+    {
+        if((NULL == pHashLength) || (0UL == *pHashLength) || (NULL == pHash) ||
+           ((NULL == pInput) && (0UL != inputLength)))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+
+        /* Truncated to the buffer size, as done by the HSE */
+        digestLength = HashHostDigest(index, pInput, inputLength, digest);
+        if(*pHashLength > digestLength)
+        {
+            *pHashLength = digestLength;
+        }
+        memcpy(pHash, digest, *pHashLength);
+        return HSE_SRV_RSP_OK;
+    }
+
+    return HashDataCtx(&gHseDefaultCtx, hashAlgo, inputLength, pInput, pHashLength, pHash, HSE_SGT_OPTION_NONE);
+}
+
+hseSrvResponse_t HashHostCalibrate(void)
+{
+    hseSrvResponse_t hseStatus = HSE_SRV_RSP_OK;
+    uint32_t threshold[2] = { 0UL, 0UL };
+    uint32_t length;
+    uint32_t i;
+    int32_t index;
+    bool_t hostFaster;
+
+    /* HSE only until the host digests are known to be right */
+    hashHostThreshold[0] = 0UL;
+    hashHostThreshold[1] = 0UL;
+    if(!HostSha2SelfTest())
+    {
+        return HSE_SRV_RSP_VERIFY_FAILED;
+    }
+
+    for(i = 0UL; i < HASH_HOST_CALIBRATION_MAX; i++)
+    {
+        hashCalibrationInput[i] = (uint8_t)((i * 31UL) + 7UL);
+    }
+    EnableStmTimebase();
+
+    for(index = 0; (index < 2) && (HSE_SRV_RSP_OK == hseStatus); index++)
+    {
+        /* Every length is timed, up to the first one the host loses */
+        hostFaster = TRUE;
+        for(length = 16UL; hostFaster && (length <= HASH_HOST_CALIBRATION_MAX) && (HSE_SRV_RSP_OK == hseStatus);
+            length++)
+        {
+            hseStatus = HashHostTime(index, length, &hostFaster);
+            /* A loss is timed again: an interrupt during the host runs must not end the calibration */
+            if((HSE_SRV_RSP_OK == hseStatus) && !hostFaster)
+            {
+                hseStatus = HashHostTime(index, length, &hostFaster);
+            }
+
+            /* The crossover: the host path covers the lengths up to the first one it loses */
+            if((HSE_SRV_RSP_OK == hseStatus) && hostFaster)
+            {
+                threshold[index] = length + 1UL;
+            }
+        }
+    }
+
+    if(HSE_SRV_RSP_OK == hseStatus)
+    {
+        hashHostThreshold[0] = threshold[0];
+        hashHostThreshold[1] = threshold[1];
+    }
+    return hseStatus;
+}
+
+hseSrvResponse_t HashHostSetThreshold(hseHashAlgo_t hashAlgo, uint32_t threshold)
+{
+    int32_t index = HashHostIndex(hashAlgo);
+
+    if(index < 0)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    hashHostThreshold[index] = threshold;
+    return HSE_SRV_RSP_OK;
+}
+
+uint32_t HashHostGetThreshold(hseHashAlgo_t hashAlgo)
+{
+    int32_t index = HashHostIndex(hashAlgo);
+
+    return (index < 0) ? 0UL : hashHostThreshold[index];
+}
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
 #ifdef HSE_SPT_HMAC
 hseSrvResponse_t GenerateHmacKey(hseKeyHandle_t *pTargetKeyHandle, uint8_t isNvmKey, uint16_t keyBitLen,
                                  hseKeyFlags_t keyFlags)
 {
     hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
+    hseSrvDescriptor_t* pHseSrvDesc;
     hseKeyGenerateSrv_t* pKeyGenSrv;
+    uint8_t muChannelIdx;
 
     hseStatus = HKF_AllocKeySlot(isNvmKey, HSE_KEY_TYPE_HMAC, keyBitLen, pTargetKeyHandle);
     if(HSE_SRV_RSP_OK != hseStatus)
@@ -192,6 +398,14 @@ hseSrvResponse_t GenerateHmacKey(hseKeyHandle_t *pTargetKeyHandle, uint8_t isNvm
         goto exit;
     }
 
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        HKF_FreeKeySlot(pTargetKeyHandle);
+        hseStatus = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+        goto exit;
+    }
+
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_GENERATE;
@@ -203,7 +417,7 @@ hseSrvResponse_t GenerateHmacKey(hseKeyHandle_t *pTargetKeyHandle, uint8_t isNvm
     pKeyGenSrv->keyInfo.keyFlags = keyFlags;
     pKeyGenSrv->keyGenScheme = HSE_KEY_GEN_SYM_RANDOM_KEY;
 
-    hseStatus = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
+    hseStatus = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
     if(HSE_SRV_RSP_OK != hseStatus)
     {
         HKF_FreeKeySlot(pTargetKeyHandle);
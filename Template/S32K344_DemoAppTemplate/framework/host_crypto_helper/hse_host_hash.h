@@ -15,6 +15,7 @@ extern "C"{
 
 #include "hse_interface.h"
 #include "hse_host_utils.h"
+#include "hse_host_ctx.h"
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
 ==================================================================================================*/
@@ -33,6 +34,21 @@ extern "C"{
 
 #define HASH_STREAM_SUPPORTED
 
+/* SHA-256/SHA-512 of short public data on the host CPU (see HashPublicData) */
+#define HASH_HOST_FAST_PATH_SUPPORTED
+
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+/* Inputs shorter than this are hashed on the host until HashHostCalibrate() runs (0: HSE only) */
+#ifndef HASH_HOST_DEFAULT_THRESHOLD
+#define HASH_HOST_DEFAULT_THRESHOLD     (0UL)
+#endif
+
+/* Longest input timed by HashHostCalibrate() (lengths 16, 32, ... up to this one) */
+#ifndef HASH_HOST_CALIBRATION_MAX
+#define HASH_HOST_CALIBRATION_MAX       (2048UL)
+#endif
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
+
 /*==================================================================================================
 *                                             ENUMS
 ==================================================================================================*/
@@ -85,6 +101,41 @@ typedef enum
                                      FUNCTION PROTOTYPES
 ==================================================================================================*/
 
+/* Context variants: MU, channel, TX options and deadline taken from pCtx */
+hseSrvResponse_t HashReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode,
+                            hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t inputLength,
+                            const uint8_t* pInput, uint32_t* pHashLength,
+                            uint8_t* pHash, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t HashDataCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t inputLength,
+                             const uint8_t* pInput, uint32_t* pHashLength,
+                             uint8_t* pHash, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t HashDataStartStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId);
+
+hseSrvResponse_t HashDataUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                         uint32_t inputLength, const uint8_t* pInput);
+
+hseSrvResponse_t HashDataFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                         uint32_t inputLength, const uint8_t* pInput,
+                                         uint32_t* pHashLength, uint8_t* pHash);
+
+/* Asynchronous variant: sent on a free channel of MU0 with txOptions (see HSE_CTX_DEFINE_ASYNC) */
+hseSrvResponse_t HashDataAsync(hseTxOptions_t txOptions, hseHashAlgo_t hashAlgo, uint32_t inputLength,
+                               const uint8_t* pInput, uint32_t* pHashLength, uint8_t* pHash,
+                               hseSGTOption_t inputSgtType);
+/* Asynchronous streaming variants: sent on the channel of pStreamCtx (HSE_CtxStreamOpen) with txOptions
+ * (see HSE_CTX_DEFINE_STREAM_ASYNC); close pStreamCtx after the callback of the FINISH */
+hseSrvResponse_t HashDataStartStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                          hseHashAlgo_t hashAlgo, uint32_t streamId);
+hseSrvResponse_t HashDataUpdateStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                           hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t inputLength, const uint8_t* pInput);
+hseSrvResponse_t HashDataFinishStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                           hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t inputLength, const uint8_t* pInput,
+                                           uint32_t* pHashLength, uint8_t* pHash);
+
 hseSrvResponse_t HashReq(hseAccessMode_t accessMode, const uint8_t muIf,
                                 const uint8_t muChannelIdx, hseHashAlgo_t hashAlgo,
                                 uint32_t streamId, uint32_t inputLength, 
@@ -108,6 +159,8 @@ hseSrvResponse_t HashDataAsyncSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf,
 hseSrvResponse_t HashDataStartStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
                                         const uint8_t muChannelIdx, uint32_t streamId);
 
+/* Streaming on gHseDefaultCtx: the START claims a channel of MU0, held for the stream until its FINISH
+ * or a failed step (see HSE_CtxStreamAcquire) */
 hseSrvResponse_t HashDataStartStreamDefSrv(hseHashAlgo_t hashAlgo, uint32_t streamId);
 
 hseSrvResponse_t HashDataUpdateStreamSrv(hseHashAlgo_t hashAlgo, const uint8_t muIf, 
@@ -126,6 +179,41 @@ hseSrvResponse_t HashDataFinishStreamDefSrv(hseHashAlgo_t hashAlgo, uint32_t str
                                             uint32_t inputLength, const uint8_t* pInput, 
                                             uint32_t* pHashLength, uint8_t* tagOutput);
 
+#ifdef HASH_HOST_FAST_PATH_SUPPORTED
+/*******************************************************************************
+ * Function:    HashPublicData
+ *
+ * Description: One pass hash of NON-SECRET data. SHA2_256 and SHA2_512 inputs
+ *              shorter than the threshold of the algorithm are hashed on the host
+ *              CPU (same digest and *pHashLength truncation as the HSE); all
+ *              other inputs are sent to the HSE (HashDataCtx, gHseDefaultCtx).
+ *              The host code is not protected against side channels.
+ *
+ * Returns:     As HashDataCtx
+ ******************************************************************************/
+hseSrvResponse_t HashPublicData(hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+                                uint32_t* pHashLength, uint8_t* pHash);
+
+/*******************************************************************************
+ * Function:    HashHostCalibrate
+ *
+ * Description: Run the host known answer tests, then time the host and the HSE
+ *              on each input length from 16 bytes up to the first length the host
+ *              hashes slower (at most HASH_HOST_CALIBRATION_MAX bytes), and set the
+ *              threshold of each algorithm to that length. Every timed digest of the
+ *              host is compared with the HSE one.
+ *
+ * Returns:     HSE_SRV_RSP_OK
+ *              HSE_SRV_RSP_VERIFY_FAILED   A host digest is wrong (host path disabled)
+ *              HSE errors of the timed HSE requests (host path disabled)
+ ******************************************************************************/
+hseSrvResponse_t HashHostCalibrate(void);
+
+/* Set/get the host path threshold of SHA2_256 or SHA2_512 (0 disables the host path) */
+hseSrvResponse_t HashHostSetThreshold(hseHashAlgo_t hashAlgo, uint32_t threshold);
+uint32_t HashHostGetThreshold(hseHashAlgo_t hashAlgo);
+#endif /* HASH_HOST_FAST_PATH_SUPPORTED */
+
 hseSrvResponse_t GenerateHmacKey(uint32_t *pTargetKeyHandle, uint8_t isNvmKey, uint16_t keyBitLen,
                                  hseKeyFlags_t opType);
 
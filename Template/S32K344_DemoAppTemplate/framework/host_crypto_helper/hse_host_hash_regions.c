@@ -0,0 +1,441 @@
+/**
+*   @file    hse_host_hash_regions.c
+*
+*   @brief   HSE HOST multi-region hashing.
+*   @details Drives one hash stream per region and interleaves the streaming steps of all regions
+*            on the free channels of all MU instances; the completions only flag the step done and
+*            the calling thread sends the next step of each region.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_hash_regions.c
+*/
+#include <stdatomic.h>
+#include "hse_host_hash_regions.h"
+#include "hse_host_ctx.h"
+#include "hse_completion_ring.h"
+#include "host_stm.h"
+
+#ifdef HSE_SPT_HASH
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Progress of a region
+ */
+typedef struct
+{
+    uint32_t            u32Offset;      /* Bytes hashed by the completed steps */
+    uint32_t            u32StepLength;  /* Bytes of the last step sent */
+    hseAccessMode_t     accessMode;     /* Access mode of the last step sent */
+    uint8_t             u8Stream;       /* Index in the stream pool, or HSE_HASH_REGION_NO_STREAM */
+    hseCtx_t            streamCtx;      /* Channel held for the stream (valid with a stream) */
+    bool_t              bStepSent;      /* A step was sent and its result not processed yet */
+    bool_t              bDone;
+    atomic_bool         bInFlight;      /* Cleared by the completion callback */
+    hseSrvResponse_t    stepStatus;     /* Written by the completion callback before bInFlight is cleared */
+} hseHashRegionState_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* All service channels, except channel 0 (reserved for administration services) */
+#define HSE_HASH_REGION_CHANNEL_MASK    ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* Stream pool: HSE_STREAM_COUNT streams on each MU instance */
+#define HSE_HASH_REGION_STREAMS         (HSE_NUM_OF_MU_INSTANCES * HSE_STREAM_COUNT)
+#define HSE_HASH_REGION_NO_STREAM       (0xFFU)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static atomic_bool                  bHashRegionsActive;
+static atomic_uint_least32_t        u32HashRegionsInFlight;     /* Steps sent, response not received */
+
+static hseHashRegionState_t hashRegionState[HSE_HASH_REGIONS_MAX];
+static bool_t bHashRegionStreamBusy[HSE_HASH_REGION_STREAMS];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static uint32_t HSE_HashRegionChunkSize(hseHashAlgo_t hashAlgo);
+static void HSE_HashRegionComplete(hseSrvResponse_t status, void* pArg);
+static hseSrvResponse_t HSE_HashRegionNext(hseHashRegion_t* pRegion, hseHashRegionState_t* pState,
+                                           uint8_t u8MuInstance);
+static void HSE_HashRegionReleaseStream(hseHashRegionState_t* pState);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Bytes hashed per streaming step: HSE_HASH_REGION_CHUNK_SIZE rounded
+ *                 down to a multiple of the block length (START and UPDATE only take
+ *                 whole blocks). 0 if the algorithm cannot be streamed.
+ ******************************************************************************/
+static uint32_t HSE_HashRegionChunkSize(hseHashAlgo_t hashAlgo)
+{
+    uint32_t u32BlockLength;
+
+    switch(hashAlgo)
+    {
+        case HSE_HASH_ALGO_SHA_1:
+        case HSE_HASH_ALGO_SHA2_224:
+        case HSE_HASH_ALGO_SHA2_256:
+            u32BlockLength = 64UL;
+            break;
+        case HSE_HASH_ALGO_SHA2_384:
+        case HSE_HASH_ALGO_SHA2_512:
+        case HSE_HASH_ALGO_SHA2_512_224:
+        case HSE_HASH_ALGO_SHA2_512_256:
+            u32BlockLength = 128UL;
+            break;
+        case HSE_HASH_ALGO_SHA3_224:
+            u32BlockLength = 144UL;
+            break;
+        case HSE_HASH_ALGO_SHA3_256:
+            u32BlockLength = 136UL;
+            break;
+        case HSE_HASH_ALGO_SHA3_384:
+            u32BlockLength = 104UL;
+            break;
+        case HSE_HASH_ALGO_SHA3_512:
+            u32BlockLength = 72UL;
+            break;
+        default:
+            /* Miyaguchi-Preneel: one pass only */
+            return 0UL;
+    }
+    return HSE_HASH_REGION_CHUNK_SIZE - (HSE_HASH_REGION_CHUNK_SIZE % u32BlockLength);
+}
+
+/*******************************************************************************
+ * Description   : Completion callback (MU RX interrupt or HSE_PollCompletions).
+ ******************************************************************************/
+static void HSE_HashRegionComplete(hseSrvResponse_t status, void* pArg)
+{
+    hseHashRegionState_t* pState = (hseHashRegionState_t*)pArg;
+
+    pState->stepStatus = status;
+    atomic_store(&pState->bInFlight, false);
+    (void)atomic_fetch_sub(&u32HashRegionsInFlight, 1U);
+}
+
+/*******************************************************************************
+ * Description   : Send the next step of a region: one pass or START first, then
+ *                 UPDATE per chunk and FINISH with the rest. One pass steps are
+ *                 sent on u8MuInstance, streaming steps on the channel held for
+ *                 the stream (all the steps of a stream must use one channel).
+ *                 Returns HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel or no
+ *                 stream is free (retry later).
+ ******************************************************************************/
+static hseSrvResponse_t HSE_HashRegionNext(hseHashRegion_t* pRegion, hseHashRegionState_t* pState,
+                                           uint8_t u8MuInstance)
+{
+    hseSrvResponse_t status;
+    hseTxOptions_t txOptions;
+    hseCtx_t ctx;
+    hseAccessMode_t accessMode;
+    uint32_t u32Remaining = pRegion->u32Length - pState->u32Offset;
+    uint32_t u32StepLength = u32Remaining;
+    uint32_t u32StreamId = 0UL;
+    uint8_t u8MuChannel = HSE_INVALID_CHANNEL;
+    uint8_t u8Stream;
+#ifdef HASH_STREAM_SUPPORTED
+    uint32_t u32ChunkSize = HSE_HashRegionChunkSize(pRegion->hashAlgo);
+#else
+    uint32_t u32ChunkSize = 0UL;
+#endif /* HASH_STREAM_SUPPORTED */
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_HashRegionComplete;
+    txOptions.pCallbackpArg   = (void*)pState;
+
+    if((0UL == pState->u32Offset) && ((0UL == u32ChunkSize) || (u32Remaining <= u32ChunkSize)))
+    {
+        accessMode = HSE_ACCESS_MODE_ONE_PASS;
+    }
+    else
+    {
+        if(HSE_HASH_REGION_NO_STREAM == pState->u8Stream)
+        {
+            for(u8Stream = 0U; u8Stream < HSE_HASH_REGION_STREAMS; u8Stream++)
+            {
+                if(!bHashRegionStreamBusy[u8Stream])
+                {
+                    break;
+                }
+            }
+            if(HSE_HASH_REGION_STREAMS == u8Stream)
+            {
+                return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+            }
+            ctx = HSE_CtxOnChannel((uint8_t)(u8Stream / HSE_STREAM_COUNT), HSE_INVALID_CHANNEL, txOptions);
+            if(HSE_SRV_RSP_OK != HSE_CtxStreamOpen(&ctx, &pState->streamCtx))
+            {
+                return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+            }
+            bHashRegionStreamBusy[u8Stream] = TRUE;
+            pState->u8Stream = u8Stream;
+        }
+
+        u8MuInstance = pState->streamCtx.u8MuInstance;
+        u8MuChannel  = pState->streamCtx.u8MuChannel;
+        u32StreamId  = (uint32_t)pState->u8Stream % HSE_STREAM_COUNT;
+        if(0UL == pState->u32Offset)
+        {
+            accessMode    = HSE_ACCESS_MODE_START;
+            u32StepLength = u32ChunkSize;
+        }
+        else if(u32Remaining > u32ChunkSize)
+        {
+            accessMode    = HSE_ACCESS_MODE_UPDATE;
+            u32StepLength = u32ChunkSize;
+        }
+        else
+        {
+            accessMode = HSE_ACCESS_MODE_FINISH;
+        }
+    }
+
+    ctx = HSE_CtxOnChannel(u8MuInstance, u8MuChannel, txOptions);
+    /* The channel of a stream is held by HSE_CtxStreamOpen */
+    ctx.bHeldChannel = (HSE_INVALID_CHANNEL != u8MuChannel);
+
+    pState->accessMode    = accessMode;
+    pState->u32StepLength = u32StepLength;
+    /* The response may be received before HashReqCtx returns */
+    atomic_store(&pState->bInFlight, true);
+    (void)atomic_fetch_add(&u32HashRegionsInFlight, 1U);
+
+    if((HSE_ACCESS_MODE_ONE_PASS == accessMode) || (HSE_ACCESS_MODE_FINISH == accessMode))
+    {
+        status = HashReqCtx(&ctx, accessMode, pRegion->hashAlgo, u32StreamId, u32StepLength,
+                            &pRegion->pData[pState->u32Offset], &pRegion->u32HashLength, pRegion->pHash,
+                            HSE_SGT_OPTION_NONE);
+    }
+    else
+    {
+        status = HashReqCtx(&ctx, accessMode, pRegion->hashAlgo, u32StreamId, u32StepLength,
+                            &pRegion->pData[pState->u32Offset], NULL, NULL, HSE_SGT_OPTION_NONE);
+    }
+
+    if(HSE_SRV_RSP_OK == status)
+    {
+        pState->bStepSent = TRUE;
+    }
+    else
+    {
+        atomic_store(&pState->bInFlight, false);
+        (void)atomic_fetch_sub(&u32HashRegionsInFlight, 1U);
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Give back the stream of a region and the channel held for it.
+ *                 No step of the region may be in flight.
+ ******************************************************************************/
+static void HSE_HashRegionReleaseStream(hseHashRegionState_t* pState)
+{
+    if(HSE_HASH_REGION_NO_STREAM != pState->u8Stream)
+    {
+        HSE_CtxStreamClose(&pState->streamCtx);
+        bHashRegionStreamBusy[pState->u8Stream] = FALSE;
+        pState->u8Stream = HSE_HASH_REGION_NO_STREAM;
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Hash a list of memory regions concurrently.
+ ******************************************************************************/
+hseSrvResponse_t HSE_HashRegions(hseHashRegion_t* pRegions, uint32_t u32Count, uint32_t u32TimeoutUs)
+{
+    hseHashRegionState_t* pState;
+    hseSrvResponse_t status;
+    hseSrvResponse_t firstError = HSE_SRV_RSP_OK;
+    uint32_t u32Pending = u32Count;
+    uint32_t u32Start;
+    uint32_t i;
+    uint8_t u8MuInstance;
+    bool expected = false;
+
+    if((NULL == pRegions) || (0UL == u32Count) || (u32Count > HSE_HASH_REGIONS_MAX))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    for(i = 0UL; i < u32Count; i++)
+    {
+        if(((NULL == pRegions[i].pData) && (0UL != pRegions[i].u32Length)) || (NULL == pRegions[i].pHash))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+    }
+
+    /* Steps of a timed out call may still use the region states */
+    if((0UL != atomic_load(&u32HashRegionsInFlight)) ||
+       !atomic_compare_exchange_strong(&bHashRegionsActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    /* Streams of the regions in flight when a previous call timed out */
+    for(i = 0UL; i < HSE_HASH_REGIONS_MAX; i++)
+    {
+        HSE_HashRegionReleaseStream(&hashRegionState[i]);
+    }
+    for(i = 0UL; i < u32Count; i++)
+    {
+        pState = &hashRegionState[i];
+        pState->u32Offset = 0UL;
+        pState->bStepSent = FALSE;
+        pState->bDone     = FALSE;
+        atomic_store(&pState->bInFlight, false);
+        pRegions[i].status = HSE_SRV_RSP_HOST_TIMEOUT;
+    }
+
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        /* Completions are driven by the RX interrupt */
+        HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HSE_HASH_REGION_CHANNEL_MASK);
+    }
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    while(u32Pending > 0UL)
+    {
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        for(i = 0UL; i < u32Count; i++)
+        {
+            pState = &hashRegionState[i];
+            if(pState->bDone || atomic_load(&pState->bInFlight))
+            {
+                continue;
+            }
+
+            status = HSE_SRV_RSP_OK;
+            if(pState->bStepSent)
+            {
+                pState->bStepSent = FALSE;
+                status = pState->stepStatus;
+                if(HSE_SRV_RSP_OK == status)
+                {
+                    pState->u32Offset += pState->u32StepLength;
+                    if((HSE_ACCESS_MODE_ONE_PASS == pState->accessMode) ||
+                       (HSE_ACCESS_MODE_FINISH == pState->accessMode))
+                    {
+                        pState->bDone = TRUE;
+                    }
+                }
+            }
+
+            if((HSE_SRV_RSP_OK == status) && !pState->bDone)
+            {
+                /* One pass regions are spread over the MU instances */
+                status = HSE_HashRegionNext(&pRegions[i], pState, (uint8_t)(i % HSE_NUM_OF_MU_INSTANCES));
+                if(HSE_SRV_RSP_HOST_CHANNEL_BUSY == status)
+                {
+                    continue;
+                }
+            }
+
+            if((HSE_SRV_RSP_OK != status) || pState->bDone)
+            {
+                pState->bDone = TRUE;
+                pRegions[i].status = status;
+                HSE_HashRegionReleaseStream(pState);
+                if((HSE_SRV_RSP_OK != status) && (HSE_SRV_RSP_OK == firstError))
+                {
+                    firstError = status;
+                }
+                u32Pending--;
+            }
+        }
+
+        if((u32Pending > 0UL) && (HSE_WAIT_INFINITE != u32TimeoutUs) &&
+           ((GetStmTimebaseUs() - u32Start) >= u32TimeoutUs))
+        {
+            firstError = HSE_SRV_RSP_HOST_TIMEOUT;
+            break;
+        }
+    }
+
+    /* After a timeout, the streams of the steps still in flight are released by the next call */
+    for(i = 0UL; i < u32Count; i++)
+    {
+        if(!atomic_load(&hashRegionState[i].bInFlight))
+        {
+            HSE_HashRegionReleaseStream(&hashRegionState[i]);
+        }
+    }
+
+    atomic_store(&bHashRegionsActive, false);
+    return firstError;
+}
+
+/*******************************************************************************
+ * Description   : Check whether requests of HSE_HashRegions() are in flight.
+ ******************************************************************************/
+bool_t HSE_HashRegionsBusy(void)
+{
+    return (0UL != atomic_load(&u32HashRegionsInFlight)) ? TRUE : FALSE;
+}
+
+#endif /* HSE_SPT_HASH */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,140 @@
+/**
+*   @file    hse_host_hash_regions.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST multi-region hashing.
+*   @details Hashes a list of memory regions at once: every region gets its own hash stream and
+*            the streaming steps of all regions are interleaved on the free channels of all MU
+*            instances, so the regions progress together instead of one after another.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_HASH_REGIONS_H
+#define HSE_HOST_HASH_REGIONS_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_hash_regions.h
+*/
+#include "hse_host.h"
+#include "hse_host_hash.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Maximum number of regions of one HSE_HashRegions() call */
+#ifndef HSE_HASH_REGIONS_MAX
+#define HSE_HASH_REGIONS_MAX            (8UL)
+#endif
+
+/* Bytes hashed per streaming step; rounded down to a multiple of the block length of the algorithm.
+ * Regions up to this length are hashed in one pass. */
+#ifndef HSE_HASH_REGION_CHUNK_SIZE
+#define HSE_HASH_REGION_CHUNK_SIZE      (16384UL)
+#endif
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   A memory region to hash
+ */
+typedef struct
+{
+    const uint8_t*      pData;          /**< @brief    The region. */
+    uint32_t            u32Length;      /**< @brief    The region length in bytes. */
+    hseHashAlgo_t       hashAlgo;       /**< @brief    The hash algorithm (HSE_HASH_ALGO_MP is hashed in one pass). */
+    uint8_t*            pHash;          /**< @brief    The digest. */
+    uint32_t            u32HashLength;  /**< @brief    Input: size of pHash; output: length of the digest. */
+    hseSrvResponse_t    status;         /**< @brief    Output: status of the region. */
+} hseHashRegion_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#ifdef HSE_SPT_HASH
+/**
+* @brief        Hash a list of memory regions concurrently.
+* @details      Regions longer than HSE_HASH_REGION_CHUNK_SIZE are hashed with a stream of their own
+*               (START with the first chunk, UPDATE per chunk, FINISH with the rest); the others in
+*               one pass. The steps are sent asynchronously on free channels of all MU instances and
+*               driven from the calling thread, which also runs the deferred completions; a stream
+*               holds one channel from its START to its FINISH (HSE_CtxStreamOpen).
+*               While the call is in progress it owns all hash streams of all MU instances
+*               (HSE_STREAM_COUNT per MU); regions waiting for a stream start when one is released.
+*               Only one call can be in progress at a time.
+*
+* @param[in,out] pRegions       The regions; the digest, digest length and status of each region
+*                               are written back.
+* @param[in]    u32Count        Number of regions: 0 < u32Count <= HSE_HASH_REGIONS_MAX.
+* @param[in]    u32TimeoutUs    The timeout in microseconds, or HSE_WAIT_INFINITE.
+*
+* @return       HSE_SRV_RSP_OK if all regions were hashed, otherwise the status of the first
+*               region that failed,
+*               HSE_SRV_RSP_INVALID_PARAM if a parameter is invalid,
+*               HSE_SRV_RSP_NOT_ALLOWED if requests of a previous call are still in flight,
+*               HSE_SRV_RSP_HOST_TIMEOUT if not all regions were hashed in time. The regions and
+*               digests must then stay valid until HSE_HashRegionsBusy() returns FALSE.
+*/
+hseSrvResponse_t HSE_HashRegions(hseHashRegion_t* pRegions, uint32_t u32Count, uint32_t u32TimeoutUs);
+
+/**
+* @brief        Check whether requests of HSE_HashRegions() are in flight.
+*
+* @return       TRUE if a request was sent and its response not received, FALSE otherwise.
+*/
+bool_t HSE_HashRegionsBusy(void);
+#endif /* HSE_SPT_HASH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_HASH_REGIONS_H */
+
+/** @} */
@@ -8,6 +8,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_srv_builders.h"
 #include "string.h"
 #ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
 #include "hse_host_impex_stream.h"
@@ -54,17 +55,8 @@ hseSrvResponse_t StreamCtxImport(hseStreamId_t streamId, const uint8_t* pStreami
 {
     hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
     hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
-    hseImportExportStreamCtxSrv_t* pStreamImpexSrv;
 
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX;
-
-    pStreamImpexSrv = &(pHseSrvDesc->hseSrv.importExportStreamCtx);
-
-    pStreamImpexSrv->operation   = HSE_IMPORT_STREAMING_CONTEXT;
-    pStreamImpexSrv->streamId = streamId;
-    pStreamImpexSrv->pStreamContext = (HOST_ADDR)pStreamingContext;
+    HSE_BuildStreamCtxReq(pHseSrvDesc, HSE_IMPORT_STREAMING_CONTEXT, streamId, pStreamingContext);
 
     hseStatus = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
     return hseStatus;
@@ -74,17 +66,8 @@ hseSrvResponse_t StreamCtxExport(hseStreamId_t streamId, uint8_t* pStreamingCont
 {
     hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
     hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
-    hseImportExportStreamCtxSrv_t* pStreamImpexSrv;
-
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX;
-
-    pStreamImpexSrv = &(pHseSrvDesc->hseSrv.importExportStreamCtx);
-
-    pStreamImpexSrv->operation   = HSE_EXPORT_STREAMING_CONTEXT;
-    pStreamImpexSrv->streamId = streamId;
-    pStreamImpexSrv->pStreamContext = (HOST_ADDR)pStreamingContext;
+    HSE_BuildStreamCtxReq(pHseSrvDesc, HSE_EXPORT_STREAMING_CONTEXT, streamId, pStreamingContext);
 
     hseStatus = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
     return hseStatus;
@@ -94,37 +77,34 @@ hseSrvResponse_t StreamCtxOp(hseStreamContextOp_t op, hseStreamId_t streamId, ui
 {
     hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
     hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
-    hseImportExportStreamCtxSrv_t* pStreamImpexSrv;
 
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    HSE_BuildStreamCtxReq(pHseSrvDesc, op, streamId, pStreamingContext);
+
+    hseStatus = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return hseStatus;
+}
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX;
+hseSrvResponse_t StreamCtxOpCtx(const hseCtx_t* pCtx, hseStreamContextOp_t op, hseStreamId_t streamId, uint8_t* pStreamingContext)
+{
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
 
-    pStreamImpexSrv = &(pHseSrvDesc->hseSrv.importExportStreamCtx);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
 
-    pStreamImpexSrv->operation   = op;
-    pStreamImpexSrv->streamId = streamId;
-    pStreamImpexSrv->pStreamContext = (HOST_ADDR)pStreamingContext;
+    HSE_BuildStreamCtxReq(pHseSrvDesc, op, streamId, pStreamingContext);
 
-    hseStatus = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
-    return hseStatus;
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
 
 hseSrvResponse_t StreamCtxOpMuInstance(hseStreamContextOp_t op, hseStreamId_t streamId, uint8_t* pStreamingContext, uint8_t muInstance)
 {
     hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
     hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muInstance][localMuChannelIdx];
-    hseImportExportStreamCtxSrv_t* pStreamImpexSrv;
-
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX;
-
-    pStreamImpexSrv = &(pHseSrvDesc->hseSrv.importExportStreamCtx);
 
-    pStreamImpexSrv->operation   = op;
-    pStreamImpexSrv->streamId = streamId;
-    pStreamImpexSrv->pStreamContext = (HOST_ADDR)pStreamingContext;
+    HSE_BuildStreamCtxReq(pHseSrvDesc, op, streamId, pStreamingContext);
 
     hseStatus = HSE_Send(muInstance, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
     return hseStatus;
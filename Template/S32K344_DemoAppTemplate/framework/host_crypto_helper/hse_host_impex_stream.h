@@ -1,6 +1,6 @@
 
-#ifndef HSE_HOST_HASH_H
-#define HSE_HOST_HASH_H
+#ifndef HSE_HOST_IMPEX_STREAM_H
+#define HSE_HOST_IMPEX_STREAM_H
 
 #ifdef __cplusplus
 extern "C"{
@@ -14,6 +14,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_interface.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -52,6 +53,7 @@ extern "C"{
 hseSrvResponse_t StreamCtxImport(hseStreamId_t streamId, const uint8_t* pStreamingContext);
 hseSrvResponse_t StreamCtxExport(hseStreamId_t streamId, uint8_t* pStreamingContext);
 hseSrvResponse_t StreamCtxOp(hseStreamContextOp_t op, hseStreamId_t streamId, uint8_t* pStreamingContext);
+hseSrvResponse_t StreamCtxOpCtx(const hseCtx_t* pCtx, hseStreamContextOp_t op, hseStreamId_t streamId, uint8_t* pStreamingContext);
 hseSrvResponse_t StreamCtxOpMuInstance(hseStreamContextOp_t op, hseStreamId_t streamId, uint8_t* pStreamingContext, uint8_t muInstance);
 
 #endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
@@ -60,6 +62,6 @@ hseSrvResponse_t StreamCtxOpMuInstance(hseStreamContextOp_t op, hseStreamId_t st
 }
 #endif
 
-#endif /* HSE_HOST_HASH_H */
+#endif /* HSE_HOST_IMPEX_STREAM_H */
 
 /** @} */
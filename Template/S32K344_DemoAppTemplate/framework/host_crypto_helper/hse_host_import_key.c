@@ -11,6 +11,7 @@ extern "C"
 #include "hse_host.h"
 #include "hse_host_import_key.h"
 #include "hse_keys_allocator.h"
+#include "hse_srv_builders.h"
 #include "string.h"
 #include "hse_default_config.h"
 #include "hse_common_test.h"
@@ -107,6 +108,7 @@ uint8_t gDecryptedExportKeyContainer[MAX_KEY_CONTAINER_LENGTH] = {0};
  *                                   LOCAL FUNCTION PROTOTYPES
  ==================================================================================================*/
 #ifdef HSE_SPT_IMPORT_KEY
+static void BuildImportKeyReq(hseSrvDescriptor_t *pHseSrvDesc, const hseKeyImportParams_t *pImportKeyParams);
 static void SetupAuthRawKey(hseKeyImportParams_t *pImportKeyParams);
 static void CleanUpAuthRawKey(hseKeyImportParams_t *pImportKeyParams);
 #endif
@@ -201,6 +203,45 @@ static bool_t MustCopyKeyInfoInAuthContainer(hseKeyInfo_t *pKeyInfo, hseKeyHandl
 #endif
 #if defined(HSE_SPT_IMPORT_KEY)
 
+static void BuildImportKeyReq(hseSrvDescriptor_t *pHseSrvDesc, const hseKeyImportParams_t *pImportKeyParams)
+{
+    hseImportKeySrv_t *pImportKeyReq = &pHseSrvDesc->hseSrv.importKeyReq;
+
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_KEY;
+
+    pImportKeyReq->targetKeyHandle = pImportKeyParams->pKey->keyHandle;
+    pImportKeyReq->pKeyInfo = (HOST_ADDR)pImportKeyParams->pKey->pKeyInfo;
+
+    pImportKeyReq->pKey[0] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey0;
+    pImportKeyReq->keyLen[0] = pImportKeyParams->pKey->keyValue.keyLen0;
+    pImportKeyReq->pKey[1] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey1;
+    pImportKeyReq->keyLen[1] = pImportKeyParams->pKey->keyValue.keyLen1;
+    pImportKeyReq->pKey[2] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey2;
+    pImportKeyReq->keyLen[2] = pImportKeyParams->pKey->keyValue.keyLen2;
+
+    pImportKeyReq->cipher.cipherKeyHandle = HSE_INVALID_KEY_HANDLE;
+    if(NULL != pImportKeyParams->cipherParams.pKeyHandle && HSE_INVALID_KEY_HANDLE != *pImportKeyParams->cipherParams.pKeyHandle)
+    {
+        pImportKeyReq->cipher.cipherKeyHandle = *pImportKeyParams->cipherParams.pKeyHandle;
+        memcpy(&pImportKeyReq->cipher.cipherScheme, pImportKeyParams->cipherParams.pCipherScheme, sizeof(hseCipherScheme_t));
+    }
+
+    pImportKeyReq->keyContainer.authKeyHandle = HSE_INVALID_KEY_HANDLE;
+    if(NULL != pImportKeyParams->authParams.pKeyHandle && HSE_INVALID_KEY_HANDLE != *pImportKeyParams->authParams.pKeyHandle)
+    {
+        pImportKeyReq->keyContainer.authKeyHandle = *pImportKeyParams->authParams.pKeyHandle;
+        memcpy(&pImportKeyReq->keyContainer.authScheme, pImportKeyParams->authParams.pAuthScheme, sizeof(hseAuthScheme_t));
+        pImportKeyReq->keyContainer.pAuth[0] = (HOST_ADDR)pImportKeyParams->authParams.pSign0;
+        pImportKeyReq->keyContainer.authLen[0] = pImportKeyParams->authParams.signLen0;
+        pImportKeyReq->keyContainer.pAuth[1] = (HOST_ADDR)pImportKeyParams->authParams.pSign1;
+        pImportKeyReq->keyContainer.authLen[1] = pImportKeyParams->authParams.signLen1;
+
+    }
+    pImportKeyReq->keyContainer.pKeyContainer = (HOST_ADDR)pImportKeyParams->authParams.pKeyContainer;
+    pImportKeyReq->keyContainer.keyContainerLen = (uint16_t)pImportKeyParams->authParams.keyContainerLength;
+}
+
 static void SetupAuthRawKey(hseKeyImportParams_t *pImportKeyParams)
 {
     if ((HSE_IMPORT_USE_AUTH_KEY_CONTAINER == (pImportKeyParams->options & HSE_IMPORT_USE_AUTH_KEY_CONTAINER))
@@ -388,8 +429,6 @@ hseSrvResponse_t ImportKeyReqMuChannelWithoutErase(uint8_t muInstance, uint8_t m
     #if defined(HSE_SPT_IMPORT_KEY)
     hseSrvResponse_t hseSrvResponse;
     hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muInstance][muChannel];
-    hseImportKeySrv_t *pImportKeyReq = &pHseSrvDesc->hseSrv.importKeyReq;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     if(bEraseKeyBeforeImport)
     {
         /* Erase NVM key before import (ensure the key slot is empty) */
@@ -402,42 +441,11 @@ hseSrvResponse_t ImportKeyReqMuChannelWithoutErase(uint8_t muInstance, uint8_t m
     /* Setup for Raw keys - Authenticated keys can be imported only from a key container */
     SetupAuthRawKey(pImportKeyParams);
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_IMPORT_KEY;
-
     /* Increase the keyCounter only key is imported without authentication */
     pImportKeyParams->pKey->pKeyInfo->keyCounter = (TRUE == MustCopyKeyInfoInAuthContainer(pImportKeyParams->pKey->pKeyInfo, pImportKeyParams->pKey->keyHandle)) ? gKeySecCount :
         (HSE_KEY_CATALOG_ID_NVM == GET_CATALOG_ID(pImportKeyParams->pKey->keyHandle)) ? (++gKeySecCount) : 0UL;
 
-    pImportKeyReq->targetKeyHandle = pImportKeyParams->pKey->keyHandle;
-    pImportKeyReq->pKeyInfo = (HOST_ADDR)pImportKeyParams->pKey->pKeyInfo;
-
-    pImportKeyReq->pKey[0] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey0;
-    pImportKeyReq->keyLen[0] = pImportKeyParams->pKey->keyValue.keyLen0;
-    pImportKeyReq->pKey[1] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey1;
-    pImportKeyReq->keyLen[1] = pImportKeyParams->pKey->keyValue.keyLen1;
-    pImportKeyReq->pKey[2] = (HOST_ADDR)pImportKeyParams->pKey->keyValue.pKey2;
-    pImportKeyReq->keyLen[2] = pImportKeyParams->pKey->keyValue.keyLen2;
-
-    pImportKeyReq->cipher.cipherKeyHandle = HSE_INVALID_KEY_HANDLE;
-    if(NULL != pImportKeyParams->cipherParams.pKeyHandle && HSE_INVALID_KEY_HANDLE != *pImportKeyParams->cipherParams.pKeyHandle)
-    {
-        pImportKeyReq->cipher.cipherKeyHandle = *pImportKeyParams->cipherParams.pKeyHandle;
-        memcpy(&pImportKeyReq->cipher.cipherScheme, pImportKeyParams->cipherParams.pCipherScheme, sizeof(hseCipherScheme_t));
-    }
-
-    pImportKeyReq->keyContainer.authKeyHandle = HSE_INVALID_KEY_HANDLE;
-    if(NULL != pImportKeyParams->authParams.pKeyHandle && HSE_INVALID_KEY_HANDLE != *pImportKeyParams->authParams.pKeyHandle)
-    {
-        pImportKeyReq->keyContainer.authKeyHandle = *pImportKeyParams->authParams.pKeyHandle;
-        memcpy(&pImportKeyReq->keyContainer.authScheme, pImportKeyParams->authParams.pAuthScheme, sizeof(hseAuthScheme_t));
-        pImportKeyReq->keyContainer.pAuth[0] = (HOST_ADDR)pImportKeyParams->authParams.pSign0;
-        pImportKeyReq->keyContainer.authLen[0] = pImportKeyParams->authParams.signLen0;
-        pImportKeyReq->keyContainer.pAuth[1] = (HOST_ADDR)pImportKeyParams->authParams.pSign1;
-        pImportKeyReq->keyContainer.authLen[1] = pImportKeyParams->authParams.signLen1;
-
-    }
-    pImportKeyReq->keyContainer.pKeyContainer = (HOST_ADDR)pImportKeyParams->authParams.pKeyContainer;
-    pImportKeyReq->keyContainer.keyContainerLen = (uint16_t)pImportKeyParams->authParams.keyContainerLength;
+    BuildImportKeyReq(pHseSrvDesc, pImportKeyParams);
 
     hseSrvResponse = HSE_Send(muInstance, muChannel, gSyncTxOption, pHseSrvDesc);
 
@@ -454,6 +462,56 @@ exit:
 #endif
 }
 
+hseSrvResponse_t ImportKeyCtx(const hseCtx_t* pCtx, const hseKeyImportParams_t *pImportKeyParams)
+{
+    #if defined(HSE_SPT_IMPORT_KEY)
+    uint8_t u8MuChannel;
+    hseSrvDescriptor_t* pHseSrvDesc;
+
+    /* Raw keys are copied into a single shared container (see SetupAuthRawKey) */
+    if((HSE_IMPORT_USE_AUTH_KEY_CONTAINER == (pImportKeyParams->options & HSE_IMPORT_USE_AUTH_KEY_CONTAINER))
+        && (NULL == pImportKeyParams->authParams.pKeyContainer))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pHseSrvDesc = HSE_CtxAcquire(pCtx, &u8MuChannel);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
+    BuildImportKeyReq(pHseSrvDesc, pImportKeyParams);
+
+    return HSE_CtxSend(pCtx, u8MuChannel, pHseSrvDesc);
+    #else
+    (void)pCtx;
+    (void)pImportKeyParams;
+    return HSE_SRV_RSP_NOT_SUPPORTED;
+    #endif
+}
+
+hseSrvResponse_t PublishNvmKeystoreCtx(const hseCtx_t* pCtx)
+{
+    #if defined(HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)
+    uint8_t u8MuChannel;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(pCtx, &u8MuChannel);
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
+    /* The service has no parameters */
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH);
+
+    return HSE_CtxSend(pCtx, u8MuChannel, pHseSrvDesc);
+    #else
+    (void)pCtx;
+    return HSE_SRV_RSP_NOT_SUPPORTED;
+    #endif
+}
+
 hseSrvResponse_t ExportKeyReq(hseKeyExportParams_t *pExportKeyParams)
 {
     return ExportKeyReqMuChannel(muIf, muChannelIdx, pExportKeyParams);
@@ -498,7 +556,7 @@ hseSrvResponse_t ExportKeyReqMuChannel(uint8_t muInstance, uint8_t muChannel, hs
         &&((HSE_AUTH_CIPHER_MODE_CCM == pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.authCipherMode)
         ||(HSE_AUTH_CIPHER_MODE_GCM == pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.authCipherMode)))
         {
-            pExportKeyReq->pKeyInfo = (HOST_ADDR) &((uint8_t *)((uint32_t)pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.pAAD))[pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.aadLength];
+            pExportKeyReq->pKeyInfo = HSE_PTR_TO_HOST_ADDR(&((uint8_t *)(uintptr_t)pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.pAAD)[pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.aadLength]);
             pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.aadLength += sizeof(hseKeyInfo_t);
         }
 
@@ -623,16 +681,16 @@ hseSrvResponse_t ExportKeyReqMuChannel(uint8_t muInstance, uint8_t muChannel, hs
         /* Decrypt payload with default cipher scheme */
         hseSrvResponse = AesDecrypt(copyProvKeyAes256.keyHandle, HSE_CIPHER_BLOCK_MODE_ECB,
                                     NULL, pExportKeyReq->keyContainer.keyContainerLen - sizeof(hseKeyInfo_t),
-                                    &((uint8_t *)((uint32_t)pExportKeyReq->keyContainer.pKeyContainer))[sizeof(hseKeyInfo_t)],
+                                    &((uint8_t *)(uintptr_t)pExportKeyReq->keyContainer.pKeyContainer)[sizeof(hseKeyInfo_t)],
                                     gDecryptedExportKeyContainer, 0U);
         if(hseSrvResponse != HSE_SRV_RSP_OK)
         {
             goto exit;
         }
 
-        pExportKeyParams->pKey->keyValue.keyLen2 = BITS_TO_BYTES(((hseKeyInfo_t *)(uint32_t)pExportKeyReq->pKeyInfo)->keyBitLen);
+        pExportKeyParams->pKey->keyValue.keyLen2 = BITS_TO_BYTES(((hseKeyInfo_t *)(uintptr_t)pExportKeyReq->pKeyInfo)->keyBitLen);
         (void)memcpy(pExportKeyParams->pKey->keyValue.pKey2, gDecryptedExportKeyContainer, pExportKeyParams->pKey->keyValue.keyLen2);
-        (void)memcpy(pExportKeyParams->pKey->pKeyInfo, (uint8_t *)(uint32_t)pExportKeyReq->pKeyInfo, sizeof(hseKeyInfo_t));
+        (void)memcpy(pExportKeyParams->pKey->pKeyInfo, (uint8_t *)(uintptr_t)pExportKeyReq->pKeyInfo, sizeof(hseKeyInfo_t));
     }
     else
     {
@@ -640,7 +698,7 @@ hseSrvResponse_t ExportKeyReqMuChannel(uint8_t muInstance, uint8_t muChannel, hs
         &&((HSE_AUTH_CIPHER_MODE_CCM == pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.authCipherMode)
         ||(HSE_AUTH_CIPHER_MODE_GCM == pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.authCipherMode)))
         {
-            (void)memcpy(pExportKeyParams->pKey->pKeyInfo, (uint8_t *)(uint32_t)pExportKeyReq->pKeyInfo, sizeof(hseKeyInfo_t));
+            (void)memcpy(pExportKeyParams->pKey->pKeyInfo, (uint8_t *)(uintptr_t)pExportKeyReq->pKeyInfo, sizeof(hseKeyInfo_t));
             pExportKeyParams->cipherParams.pCipherScheme->aeadCipher.aadLength -= sizeof(hseKeyInfo_t);
         }
     }
@@ -1620,18 +1678,28 @@ hseSrvResponse_t GetKeyInfo(hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo)
 
 hseSrvResponse_t GetKeyInfoMuChannel(uint8_t u8MuInstance, uint8_t u8MuChannel,
      hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo)
+{
+    hseCtx_t ctx = HSE_CtxOnChannel(u8MuInstance, u8MuChannel, gSyncTxOption);
+
+    return GetKeyInfoCtx(&ctx, keyHandle, reqKeyInfo);
+}
+
+hseSrvResponse_t GetKeyInfoCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo)
 {
     #if defined(HSE_SPT_GET_KEY_INFO)
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[u8MuInstance][u8MuChannel];
-    hseGetKeyInfoSrv_t*  pGetKeyInfoReq = &pHseSrvDesc->hseSrv.getKeyInfoReq;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-    pHseSrvDesc->srvId = HSE_SRV_ID_GET_KEY_INFO;
-    pGetKeyInfoReq->keyHandle = keyHandle;
-    pGetKeyInfoReq->pKeyInfo = (HOST_ADDR)reqKeyInfo;
-    return HSE_Send(u8MuInstance, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+    uint8_t u8MuChannel;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(pCtx, &u8MuChannel);
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
+    HSE_BuildGetKeyInfoReq(pHseSrvDesc, keyHandle, reqKeyInfo);
+
+    return HSE_CtxSend(pCtx, u8MuChannel, pHseSrvDesc);
     #else
-    (void)u8MuInstance;
-    (void)u8MuChannel;
+    (void)pCtx;
     (void)keyHandle;
     (void)reqKeyInfo;
     return HSE_SRV_RSP_NOT_SUPPORTED;
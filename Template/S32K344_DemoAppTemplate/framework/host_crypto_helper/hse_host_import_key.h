@@ -123,6 +123,15 @@ hseSrvResponse_t ImportKeyReqMuChannel(uint8_t muInstance, uint8_t muChannel, hs
 hseSrvResponse_t ImportKeyReqMuChannelWithoutErase(uint8_t muInstance, uint8_t muChannel, bool_t bEraseKeyBeforeImport, hseKeyImportParams_t *pImportKeyParams);
 hseSrvResponse_t ExportKeyReqMuChannel(uint8_t muInstance, uint8_t muChannel, hseKeyExportParams_t *pExportKeyParams);
 
+/* Import a key with the request context (e.g. asynchronously). The key slot is not erased and
+ * the key info is sent as it is (keyCounter included). Authenticated raw keys are not supported:
+ * HSE_IMPORT_USE_AUTH_KEY_CONTAINER needs authParams.pKeyContainer. */
+hseSrvResponse_t ImportKeyCtx(const hseCtx_t* pCtx, const hseKeyImportParams_t *pImportKeyParams);
+
+/* Write the NVM keys updated in the HSE RAM mirror to the data flash
+ * (see HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID). */
+hseSrvResponse_t PublishNvmKeystoreCtx(const hseCtx_t* pCtx);
+
 /*******************************************************************************
  *                      Symmetric keys Import/Export
  ******************************************************************************/
@@ -434,6 +443,7 @@ hseSrvResponse_t EraseNVMDataReq(void);
 hseSrvResponse_t GetKeyInfo(hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo);
 hseSrvResponse_t GetKeyInfoMuChannel(uint8_t u8MuInstance, uint8_t u8MuChannel,
      hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo);
+hseSrvResponse_t GetKeyInfoCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseKeyInfo_t* reqKeyInfo);
 
 #ifdef HSE_SPT_KEY_VERIFY
 hseSrvResponse_t VerifySHA
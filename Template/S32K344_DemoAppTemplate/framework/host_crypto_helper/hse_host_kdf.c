@@ -35,6 +35,7 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
 #include "hse_host_kdf.h"
 #include "hse_keys_allocator.h"
 
@@ -56,8 +57,6 @@ extern "C"
  *                                      LOCAL VARIABLES
  ==================================================================================================*/
 #ifdef HSE_SPT_KEY_DERIVE
-static uint8_t muIf = 0U;
-static uint8_t muChannelIdx = 1U;
 #endif
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
@@ -79,13 +78,21 @@ static uint8_t muChannelIdx = 1U;
  *                                       GLOBAL FUNCTIONS
  ==================================================================================================*/
 #ifdef HSE_SPT_KDF_IKEV2
-hseSrvResponse_t HSEKeyDeriveIKEv2Req
+hseSrvResponse_t HSEKeyDeriveIKEv2ReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfIKEV2Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t* pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -93,8 +100,12 @@ hseSrvResponse_t HSEKeyDeriveIKEv2Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_IKEV2;
     memcpy(&pDeriveKeySrv->sch.IKEv2, pKdfScheme, sizeof(hseKdfIKEV2Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKeyDeriveIKEv2Req,
+    (hseKdfIKEV2Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KEY_DERIVE
 hseSrvResponse_t HSEKeyDeriveExtractKeyReq
@@ -107,8 +118,9 @@ hseSrvResponse_t HSEKeyDeriveExtractKeyReq
 )
 {
     hseSrvResponse_t hseResponse = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveCopyKeySrv_t *pExtractKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveCopyKeyReq);
+    hseSrvDescriptor_t *pHseSrvDesc;
+    hseKeyDeriveCopyKeySrv_t *pExtractKeySrv;
+    uint8_t muChannelIdx;
 
     hseResponse = HKF_AllocKeySlot(isNvmKey, keyInfo.keyType, keyInfo.keyBitLen, pTargetKeyHandle);
     if(HSE_SRV_RSP_OK != hseResponse)
@@ -116,6 +128,15 @@ hseSrvResponse_t HSEKeyDeriveExtractKeyReq
         goto exit;
     }
 
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        HKF_FreeKeySlot(pTargetKeyHandle);
+        hseResponse = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+        goto exit;
+    }
+    pExtractKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveCopyKeyReq);
+
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE_COPY;
 
@@ -124,7 +145,7 @@ hseSrvResponse_t HSEKeyDeriveExtractKeyReq
     pExtractKeySrv->targetKeyHandle = *pTargetKeyHandle;
     pExtractKeySrv->keyInfo = keyInfo;
 
-    hseResponse = HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    hseResponse = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
     if(HSE_SRV_RSP_OK != hseResponse)
     {
         HKF_FreeKeySlot(pTargetKeyHandle);
@@ -134,13 +155,21 @@ exit:
 }
 #endif
 #ifdef HSE_SPT_KDF_ISO18033_KDF1
-hseSrvResponse_t HSEKdfISO_KDF1Req
+hseSrvResponse_t HSEKdfISO_KDF1ReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfISO18033_KDF1Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t* pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -148,17 +177,29 @@ hseSrvResponse_t HSEKdfISO_KDF1Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_ISO18033_KDF1;
     memcpy(&pDeriveKeySrv->sch.ISO18033_KDF1, pKdfScheme, sizeof(hseKdfISO18033_KDF1Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfISO_KDF1Req,
+    (hseKdfISO18033_KDF1Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_ISO18033_KDF2
-hseSrvResponse_t HSEKdfISO_KDF2Req
+hseSrvResponse_t HSEKdfISO_KDF2ReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfISO18033_KDF2Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t* pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -166,17 +207,29 @@ hseSrvResponse_t HSEKdfISO_KDF2Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_ISO18033_KDF2;
     memcpy(&pDeriveKeySrv->sch.ISO18033_KDF2, pKdfScheme, sizeof(hseKdfISO18033_KDF2Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfISO_KDF2Req,
+    (hseKdfISO18033_KDF2Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_NXP_GENERIC
-hseSrvResponse_t HSEKdfNXP_KDFReq
+hseSrvResponse_t HSEKdfNXP_KDFReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfNxpGenericScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t* pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -184,17 +237,29 @@ hseSrvResponse_t HSEKdfNXP_KDFReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_NXP_GENERIC;
     memcpy(&pDeriveKeySrv->sch.nxpGeneric, pKdfScheme, sizeof(hseKdfNxpGenericScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfNXP_KDFReq,
+    (hseKdfNxpGenericScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_SP800_56C_ONESTEP
-hseSrvResponse_t HSEKdfSP800_56COneStepReq
+hseSrvResponse_t HSEKdfSP800_56COneStepReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfSP800_56COneStepScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t* pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -202,17 +267,29 @@ hseSrvResponse_t HSEKdfSP800_56COneStepReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_SP800_56C_ONE_STEP;
     memcpy(&pDeriveKeySrv->sch.SP800_56COneStep, pKdfScheme, sizeof(hseKdfSP800_56COneStepScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfSP800_56COneStepReq,
+    (hseKdfSP800_56COneStepScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_ANS_X963
-hseSrvResponse_t HSEKdfANS_X963Req
+hseSrvResponse_t HSEKdfANS_X963ReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfANSX963Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -220,17 +297,29 @@ hseSrvResponse_t HSEKdfANS_X963Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_ANS_X963;
     memcpy(&pDeriveKeySrv->sch.ANS_X963, pKdfScheme, sizeof(hseKdfANSX963Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfANS_X963Req,
+    (hseKdfANSX963Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_SP800_56C_TWOSTEP
-hseSrvResponse_t HSEKdfSP800_56C_TwoStepReq
+hseSrvResponse_t HSEKdfSP800_56C_TwoStepReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfSP800_56CTwoStepScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -238,17 +327,29 @@ hseSrvResponse_t HSEKdfSP800_56C_TwoStepReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_SP800_56C_TWO_STEP;
     memcpy(&pDeriveKeySrv->sch.SP800_56CTwoStep, pKdfScheme, sizeof(hseKdfSP800_56CTwoStepScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfSP800_56C_TwoStepReq,
+    (hseKdfSP800_56CTwoStepScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_SP800_108
-hseSrvResponse_t HSEKdfSP800_108Req
+hseSrvResponse_t HSEKdfSP800_108ReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfSP800_108Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -256,17 +357,29 @@ hseSrvResponse_t HSEKdfSP800_108Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_SP800_108;
     memcpy(&pDeriveKeySrv->sch.SP800_108, pKdfScheme, sizeof(hseKdfSP800_108Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfSP800_108Req,
+    (hseKdfSP800_108Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
  #ifdef HSE_SPT_KEY_DERIVE
-hseSrvResponse_t HSEKdfExtract_StepReq
+hseSrvResponse_t HSEKdfExtract_StepReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfExtractStepScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -274,17 +387,29 @@ hseSrvResponse_t HSEKdfExtract_StepReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_EXTRACT_STEP;
     memcpy(&pDeriveKeySrv->sch.extractStep, pKdfScheme, sizeof(hseKdfExtractStepScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSEKdfExtract_StepReq,
+    (hseKdfExtractStepScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_PBKDF2
-hseSrvResponse_t HSE_PBKDF2Req
+hseSrvResponse_t HSE_PBKDF2ReqCtx
 (
+    const hseCtx_t* pCtx,
     hsePBKDF2Scheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -292,17 +417,29 @@ hseSrvResponse_t HSE_PBKDF2Req
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_PBKDF2HMAC;
     memcpy(&pDeriveKeySrv->sch.PBKDF2, pKdfScheme, sizeof(hsePBKDF2Scheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSE_PBKDF2Req,
+    (hsePBKDF2Scheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_KDF_TLS12_PRF
-hseSrvResponse_t HSE_TLS12_PRFReq
+hseSrvResponse_t HSE_TLS12_PRFReqCtx
 (
+    const hseCtx_t* pCtx,
     hseKdfTLS12PrfScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -310,17 +447,29 @@ hseSrvResponse_t HSE_TLS12_PRFReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_TLS12PRF;
     memcpy(&pDeriveKeySrv->sch.TLS12Prf, pKdfScheme, sizeof(hseKdfTLS12PrfScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSE_TLS12_PRFReq,
+    (hseKdfTLS12PrfScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef HSE_SPT_HKDF
-hseSrvResponse_t HSE_HKDFReq
+hseSrvResponse_t HSE_HKDFReqCtx
 (
+    const hseCtx_t* pCtx,
     hseHKDF_ExpandScheme_t *pKdfScheme
 )
 {
-    hseSrvDescriptor_t *pHseSrvDesc  = &gHseSrvDesc[muIf][muChannelIdx];
-    hseKeyDeriveSrv_t *pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
+    hseKeyDeriveSrv_t* pDeriveKeySrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    pDeriveKeySrv = &(pHseSrvDesc->hseSrv.keyDeriveReq);
 
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
     pHseSrvDesc->srvId = HSE_SRV_ID_KEY_DERIVE;
@@ -328,8 +477,12 @@ hseSrvResponse_t HSE_HKDFReq
     pDeriveKeySrv->kdfAlgo = HSE_KDF_ALGO_HKDF_EXPAND;
     memcpy(&pDeriveKeySrv->sch.HKDF_Expand, pKdfScheme, sizeof(hseHKDF_ExpandScheme_t));
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
+
+HSE_CTX_DEFINE_SYNC_ASYNC(HSE_HKDFReq,
+    (hseHKDF_ExpandScheme_t *pKdfScheme),
+    (pKdfScheme))
 #endif
 #ifdef __cplusplus
 }
@@ -14,6 +14,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_interface.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -51,6 +52,16 @@ hseSrvResponse_t HSEKeyDeriveIKEv2Req
 (
     hseKdfIKEV2Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKeyDeriveIKEv2ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfIKEV2Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKeyDeriveIKEv2ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfIKEV2Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KEY_DERIVE
 hseSrvResponse_t HSEKeyDeriveExtractKeyReq
@@ -67,66 +78,176 @@ hseSrvResponse_t HSEKdfISO_KDF1Req
 (
     hseKdfISO18033_KDF1Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfISO_KDF1ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfISO18033_KDF1Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfISO_KDF1ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfISO18033_KDF1Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_ISO18033_KDF2
 hseSrvResponse_t HSEKdfISO_KDF2Req
 (
     hseKdfISO18033_KDF2Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfISO_KDF2ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfISO18033_KDF2Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfISO_KDF2ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfISO18033_KDF2Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_NXP_GENERIC
 hseSrvResponse_t HSEKdfNXP_KDFReq
 (
     hseKdfNxpGenericScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfNXP_KDFReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfNxpGenericScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfNXP_KDFReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfNxpGenericScheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_SP800_56C_ONESTEP
 hseSrvResponse_t HSEKdfSP800_56COneStepReq
 (
     hseKdfSP800_56COneStepScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfSP800_56COneStepReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfSP800_56COneStepScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfSP800_56COneStepReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfSP800_56COneStepScheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_ANS_X963
 hseSrvResponse_t HSEKdfANS_X963Req
 (
     hseKdfANSX963Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfANS_X963ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfANSX963Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfANS_X963ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfANSX963Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_SP800_56C_TWOSTEP
 hseSrvResponse_t HSEKdfSP800_56C_TwoStepReq
 (
     hseKdfSP800_56CTwoStepScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfSP800_56C_TwoStepReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfSP800_56CTwoStepScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfSP800_56C_TwoStepReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfSP800_56CTwoStepScheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_SP800_108
 hseSrvResponse_t HSEKdfSP800_108Req
 (
     hseKdfSP800_108Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfSP800_108ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfSP800_108Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfSP800_108ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfSP800_108Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KEY_DERIVE
 hseSrvResponse_t HSEKdfExtract_StepReq
 (
     hseKdfExtractStepScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSEKdfExtract_StepReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfExtractStepScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSEKdfExtract_StepReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfExtractStepScheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_PBKDF2
 hseSrvResponse_t HSE_PBKDF2Req
 (
     hsePBKDF2Scheme_t *pKdfScheme
 );
+hseSrvResponse_t HSE_PBKDF2ReqCtx
+(
+    const hseCtx_t* pCtx,
+    hsePBKDF2Scheme_t *pKdfScheme
+);
+hseSrvResponse_t HSE_PBKDF2ReqAsync
+(
+    hseTxOptions_t txOptions,
+    hsePBKDF2Scheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_KDF_TLS12_PRF
 hseSrvResponse_t HSE_TLS12_PRFReq
 (
     hseKdfTLS12PrfScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSE_TLS12_PRFReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseKdfTLS12PrfScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSE_TLS12_PRFReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseKdfTLS12PrfScheme_t *pKdfScheme
+);
 #endif
 #ifdef HSE_SPT_HKDF
 hseSrvResponse_t HSE_HKDFReq
 (
     hseHKDF_ExpandScheme_t *pKdfScheme
 );
+hseSrvResponse_t HSE_HKDFReqCtx
+(
+    const hseCtx_t* pCtx,
+    hseHKDF_ExpandScheme_t *pKdfScheme
+);
+hseSrvResponse_t HSE_HKDFReqAsync
+(
+    hseTxOptions_t txOptions,
+    hseHKDF_ExpandScheme_t *pKdfScheme
+);
 #endif
 #ifdef __cplusplus
 }
@@ -37,6 +37,8 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_srv_builders.h"
 #include "string.h"
 
 #include "hse_host_mac.h"
@@ -56,8 +58,6 @@ extern "C"
 /*==================================================================================================
  *                                      LOCAL VARIABLES
  ==================================================================================================*/
-static const uint8_t muIf = 0U;
-static const uint8_t muChannelIdx = 1U;
 
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
@@ -79,489 +79,618 @@ static const uint8_t muChannelIdx = 1U;
  *                                       GLOBAL FUNCTIONS
  ==================================================================================================*/
 
-hseSrvResponse_t MacSignSrv(hseAccessMode_t accessMode, uint32_t streamId,
-                            hseMacScheme_t macScheme, hseKeyHandle_t keyHandle,
+hseSrvResponse_t MacSignCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                            const hseMacScheme_t* pMacScheme, hseKeyHandle_t keyHandle,
                             uint32_t inputLength, const uint8_t* pInput,
                             uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseMacSrv_t* pMacSrv;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, streamId, &muChannelIdx, &hseStatus);
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_MAC;
-    pMacSrv = &(pHseSrvDesc->hseSrv.macReq);
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
 
-    pMacSrv->accessMode = accessMode;
-    pMacSrv->streamId = streamId;
-    pMacSrv->macScheme = macScheme;
-    pMacSrv->authDir = HSE_AUTH_DIR_GENERATE;
-    pMacSrv->keyHandle = keyHandle;
-    pMacSrv->inputLength = inputLength;
-    pMacSrv->pInput = (HOST_ADDR)pInput;
-    pMacSrv->pTagLength = (HOST_ADDR)pTagLength;
-    pMacSrv->pTag = (HOST_ADDR)pTag;
-    pMacSrv->sgtOption = inputSgtType;
+    HSE_BuildMacReq(pHseSrvDesc, accessMode, streamId, HSE_AUTH_DIR_GENERATE, inputSgtType, pMacScheme,
+                    keyHandle, inputLength, pInput, pTagLength, pTag);
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxStreamSend(pCtx, accessMode, streamId, muChannelIdx, pHseSrvDesc);
 }
 
-hseSrvResponse_t MacVerSrv(hseAccessMode_t accessMode, uint32_t streamId,
-                           hseMacScheme_t macScheme, hseKeyHandle_t keyHandle,
+hseSrvResponse_t MacVerCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                           const hseMacScheme_t* pMacScheme, hseKeyHandle_t keyHandle,
                            uint32_t inputLength, const uint8_t* pInput,
                            const uint32_t* pTagLength, const uint8_t* pTag, hseSGTOption_t inputSgtType)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseMacSrv_t* pMacSrv;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, streamId, &muChannelIdx, &hseStatus);
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_MAC;
-    pMacSrv = &(pHseSrvDesc->hseSrv.macReq);
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
 
-    pMacSrv->accessMode     = accessMode;
-    pMacSrv->streamId       = streamId;
-    pMacSrv->macScheme      = macScheme;
-    pMacSrv->authDir        = HSE_AUTH_DIR_VERIFY;
-    pMacSrv->keyHandle      = keyHandle;
-    pMacSrv->inputLength    = inputLength;
-    pMacSrv->pInput         = (HOST_ADDR)pInput;
-    pMacSrv->pTagLength     = (HOST_ADDR)pTagLength;
-    pMacSrv->pTag           = (HOST_ADDR)pTag;
-    pMacSrv->sgtOption      = inputSgtType;
+    HSE_BuildMacReq(pHseSrvDesc, accessMode, streamId, HSE_AUTH_DIR_VERIFY, inputSgtType, pMacScheme,
+                    keyHandle, inputLength, pInput, pTagLength, pTag);
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxStreamSend(pCtx, accessMode, streamId, muChannelIdx, pHseSrvDesc);
 }
 
-hseSrvResponse_t AesKmCmacGen(uint8_t u8MuInstance, hseKeyHandle_t keyHandle, uint32_t messageLength, const uint8_t * pMessage, uint8_t* tag,
-        uint32_t tagsize, uint32_t streamId, hseAccessMode_t accessMode)
+hseSrvResponse_t MacSignSrv(hseAccessMode_t accessMode, uint32_t streamId,
+                            hseMacScheme_t macScheme, hseKeyHandle_t keyHandle,
+                            uint32_t inputLength, const uint8_t* pInput,
+                            uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType)
 {
+    return MacSignCtx(&gHseDefaultCtx, accessMode, streamId, &macScheme, keyHandle,
+                      inputLength, pInput, pTagLength, pTag, inputSgtType);
+}
 
-    uint8_t u8MuChannel;
-    hseSrvResponse_t hseSrvResponse = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t* pHseSrvDesc;
-    hseMacSrv_t* pMacSrv;
-
-    u8MuChannel = HSE_MU_GetFreeChannel(u8MuInstance);
-    if (HSE_INVALID_CHANNEL == u8MuChannel)
-    {
-        goto exit;
-    }
-
-    pHseSrvDesc = &gHseSrvDesc[u8MuInstance][u8MuChannel];
-    pMacSrv = &(pHseSrvDesc->hseSrv.macReq);
-
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_MAC;
+hseSrvResponse_t MacVerSrv(hseAccessMode_t accessMode, uint32_t streamId,
+                           hseMacScheme_t macScheme, hseKeyHandle_t keyHandle,
+                           uint32_t inputLength, const uint8_t* pInput,
+                           const uint32_t* pTagLength, const uint8_t* pTag, hseSGTOption_t inputSgtType)
+{
+    return MacVerCtx(&gHseDefaultCtx, accessMode, streamId, &macScheme, keyHandle,
+                     inputLength, pInput, pTagLength, pTag, inputSgtType);
+}
 
-    pMacSrv->accessMode = accessMode;
-    pMacSrv->streamId = streamId;
-    pMacSrv->macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
-    pMacSrv->macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    pMacSrv->authDir = HSE_AUTH_DIR_GENERATE;
-    pMacSrv->keyHandle = keyHandle;
-    pMacSrv->pInput = (HOST_ADDR) pMessage;
-    pMacSrv->inputLength = messageLength;
-    pMacSrv->pTag = (HOST_ADDR) tag;
-    pMacSrv->pTagLength = (HOST_ADDR) &tagsize;
-    pMacSrv->sgtOption = 0U;
+hseSrvResponse_t AesKmCmacGen(uint8_t u8MuInstance, hseKeyHandle_t keyHandle, uint32_t messageLength, const uint8_t * pMessage, uint8_t* tag,
+        uint32_t tagsize, uint32_t streamId, hseAccessMode_t accessMode)
+{
+    const hseCtx_t ctx = HSE_CTX_INIT(u8MuInstance);
+    const hseMacScheme_t macScheme = { .macAlgo = HSE_MAC_ALGO_CMAC, .sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES };
 
-    hseSrvResponse = HSE_Send(u8MuInstance, u8MuChannel, gSyncTxOption, pHseSrvDesc);
-exit:
-    return hseSrvResponse;
+    return MacSignCtx(&ctx, accessMode, streamId, &macScheme, keyHandle,
+                      messageLength, pMessage, &tagsize, tag, 0U);
 }
 
 /*******************************************************************************
  *                                  XCBC_MAC
  ******************************************************************************/
 
-hseSrvResponse_t AesXCbcmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                                    const uint8_t *pMsg, uint32_t* pTagLength,
-                                    uint8_t *pTag)
+hseSrvResponse_t AesXCbcmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                       const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacSignSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                                  const uint8_t *pMsg, const uint32_t* pTagLength,
-                                  const uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesXCbcmacGenerate,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag),
+    (keyHandle, msgLength, pMsg, pTagLength, pTag))
+
+hseSrvResponse_t AesXCbcmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                     const uint8_t *pMsg, const uint32_t* pTagLength, const uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacVerSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                      msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                               uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesXCbcmacVerify,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, const uint32_t* pTagLength,
+     const uint8_t *pTag),
+    (keyHandle, msgLength, pMsg, pTagLength, pTag))
+
+hseSrvResponse_t AesXCbcmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacSignSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacGenerateStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                                uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacGenerateStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesXCbcmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacSignSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacGenerateStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                                uint32_t msgLength, const uint8_t *pMsg,
-                                                uint32_t* pTagLength, uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacGenerateStreamUpdate,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesXCbcmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                   uint32_t* pTagLength, uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacSignSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                               uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacGenerateStreamFinish,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+     uint32_t* pTagLength, uint8_t *pTag),
+    (keyHandle, streamId, msgLength, pMsg, pTagLength, pTag))
+
+hseSrvResponse_t AesXCbcmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacVerSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacVerifyStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                                uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacVerifyStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesXCbcmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacVerSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesXCbcmacVerifyStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                              uint32_t msgLength, const uint8_t *pMsg,
-                                              const uint32_t* pTagLength, const uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacVerifyStreamUpdate,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesXCbcmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                 const uint32_t* pTagLength, const uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_XCBC_MAC;
-    return MacVerSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesXCbcmacVerifyStreamFinish,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+     const uint32_t* pTagLength, const uint8_t *pTag),
+    (keyHandle, streamId, msgLength, pMsg, pTagLength, pTag))
+
 
 /*******************************************************************************
  *                                  FAST CMAC
  ******************************************************************************/
 #ifdef HSE_SPT_FAST_CMAC
 
-hseSrvResponse_t AesFastCmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                                     const uint8_t *pMsg, uint8_t tagLength, uint8_t *pTag)
+hseSrvResponse_t AesFastCmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                        const uint8_t *pMsg, uint8_t tagLength, uint8_t *pTag)
 {
-    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseFastCMACSrv_t *pFastCMacSrv;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
 
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_FAST_CMAC;
-    pFastCMacSrv       = &(pHseSrvDesc->hseSrv.fastCmacReq);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
 
-    pFastCMacSrv->authDir        = HSE_AUTH_DIR_GENERATE;
-    pFastCMacSrv->keyHandle      = keyHandle;
-    pFastCMacSrv->inputBitLength = msgLength;
-    pFastCMacSrv->pInput         = (HOST_ADDR)pMsg;
-    pFastCMacSrv->tagBitLength   = tagLength;
-    pFastCMacSrv->pTag           = (HOST_ADDR)pTag;
+    HSE_BuildFastCmacReq(pHseSrvDesc, HSE_AUTH_DIR_GENERATE, keyHandle, msgLength, pMsg, tagLength, pTag);
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
 
-hseSrvResponse_t AesFastCmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                                   const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag)
+hseSrvResponse_t AesFastCmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                      const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag)
 {
-    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseFastCMACSrv_t *pFastCMacSrv;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t *pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
 
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-    pHseSrvDesc->srvId = HSE_SRV_ID_FAST_CMAC;
-    pFastCMacSrv       = &(pHseSrvDesc->hseSrv.fastCmacReq);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
 
-    pFastCMacSrv->authDir        = HSE_AUTH_DIR_VERIFY;
-    pFastCMacSrv->keyHandle      = keyHandle;
-    pFastCMacSrv->inputBitLength = msgLength;
-    pFastCMacSrv->pInput         = (HOST_ADDR)pMsg;
-    pFastCMacSrv->tagBitLength   = tagLength;
-    pFastCMacSrv->pTag           = (HOST_ADDR)pTag;
+    HSE_BuildFastCmacReq(pHseSrvDesc, HSE_AUTH_DIR_VERIFY, keyHandle, msgLength, pMsg, tagLength, pTag);
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(AesFastCmacGenerate,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength, uint8_t *pTag),
+    (keyHandle, msgLength, pMsg, tagLength, pTag))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesFastCmacVerify,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag),
+    (keyHandle, msgLength, pMsg, tagLength, pTag))
+
 #endif
 
 /*******************************************************************************
  *                                  CMAC
  ******************************************************************************/
-hseSrvResponse_t AesCmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                                 const uint8_t *pMsg, uint32_t* pTagLength,
-                                 uint8_t *pTag, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesCmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                    const uint8_t *pMsg, uint32_t* pTagLength,
+                                    uint8_t *pTag, hseSGTOption_t inputSgtType)
 {
-    hseMacScheme_t macScheme;
-    macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
-    macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacSignSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    const hseMacScheme_t macScheme = { .macAlgo = HSE_MAC_ALGO_CMAC, .sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES };
+
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
-                               const uint8_t *pMsg, const uint32_t* pTagLength,
-                               const uint8_t *pTag, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesCmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                  const uint8_t *pMsg, const uint32_t* pTagLength,
+                                  const uint8_t *pTag, hseSGTOption_t inputSgtType)
 {
-    hseMacScheme_t macScheme;
-    macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
-    macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacVerSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    const hseMacScheme_t macScheme = { .macAlgo = HSE_MAC_ALGO_CMAC, .sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES };
+
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                      msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                            uint32_t msgLength, const uint8_t* pMsg, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCmacGenerate,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(AesCmacVerify,
+    (hseKeyHandle_t keyHandle, uint32_t msgLength, const uint8_t *pMsg, const uint32_t* pTagLength,
+     const uint8_t *pTag, hseSGTOption_t inputSgtType),
+    (keyHandle, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
+hseSrvResponse_t AesCmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                               hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacSignSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacGenerateStreamUpdate(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacGenerateStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, streamId, msgLength, pMsg, inputSgtType))
+
+hseSrvResponse_t AesCmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                                const uint8_t *pMsg, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacSignSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, 0,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, 0,
                       msgLength, pMsg, 0, 0, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacGenerateStreamFinish(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
-                                             uint32_t *pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacGenerateStreamUpdate,
+    (uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType),
+    (streamId, msgLength, pMsg, inputSgtType))
+
+hseSrvResponse_t AesCmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                                const uint8_t *pMsg, uint32_t *pTagLength, uint8_t *pTag,
+                                                hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacSignSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, 0,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, 0,
                       msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                          uint32_t msgLength, const uint8_t* pMsg, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacGenerateStreamFinish,
+    (uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, uint32_t *pTagLength, uint8_t *pTag,
+     hseSGTOption_t inputSgtType),
+    (streamId, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
+hseSrvResponse_t AesCmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                             hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacVerSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacVerifyStreamUpdate(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacVerifyStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+     hseSGTOption_t inputSgtType),
+    (keyHandle, streamId, msgLength, pMsg, inputSgtType))
+
+hseSrvResponse_t AesCmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                              const uint8_t *pMsg, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacVerSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, 0,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, 0,
                       msgLength, pMsg, 0, 0, inputSgtType);
 }
 
-hseSrvResponse_t AesCmacVerifyStreamFinish(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
-                                           const uint32_t *pTagLength, const uint8_t *pTag, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacVerifyStreamUpdate,
+    (uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType),
+    (streamId, msgLength, pMsg, inputSgtType))
+
+hseSrvResponse_t AesCmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                              const uint8_t *pMsg, const uint32_t *pTagLength,
+                                              const uint8_t *pTag, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
     macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
-    return MacVerSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, 0,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, 0,
                      msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesCmacVerifyStreamFinish,
+    (uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, const uint32_t *pTagLength,
+     const uint8_t *pTag, hseSGTOption_t inputSgtType),
+    (streamId, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
 /*******************************************************************************
  *                                  GMAC
  ******************************************************************************/
 
 /* === AES === */
-hseSrvResponse_t AesGmacGenerate(hseKeyHandle_t keyHandle, uint32_t ivLength,
-                                 const uint8_t *pIV, uint32_t msgLength,
-                                 const uint8_t *pMsg, uint32_t* pTagLength,
-                                 uint8_t *pTag, hseSGTOption_t inputSgtType)
+hseSrvResponse_t AesGmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+                                    uint32_t* pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
     macScheme.sch.gmac.ivLength = ivLength;
     macScheme.sch.gmac.pIV = (HOST_ADDR)pIV;
-    return MacSignSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                      msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
-hseSrvResponse_t AesGmacVerify(hseKeyHandle_t keyHandle, uint32_t ivLength,
-                               const uint8_t *pIV, uint32_t msgLength,
-                               const uint8_t *pMsg, const uint32_t* pTagLength,
-                               const uint8_t *pTag, hseSGTOption_t inputSgtType)
+HSE_CTX_DEFINE_SYNC_ASYNC(AesGmacGenerate,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+     uint32_t* pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType),
+    (keyHandle, ivLength, pIV, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
+hseSrvResponse_t AesGmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                  const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+                                  const uint32_t* pTagLength, const uint8_t *pTag, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
     macScheme.sch.gmac.ivLength = ivLength;
     macScheme.sch.gmac.pIV = (HOST_ADDR)pIV;
-    return MacVerSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, keyHandle,
                      msgLength, pMsg, pTagLength, pTag, inputSgtType);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(AesGmacVerify,
+    (hseKeyHandle_t keyHandle, uint32_t ivLength, const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+     const uint32_t* pTagLength, const uint8_t *pTag, hseSGTOption_t inputSgtType),
+    (keyHandle, ivLength, pIV, msgLength, pMsg, pTagLength, pTag, inputSgtType))
+
 /* Streaming for Gmac ? */
-hseSrvResponse_t AesGmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                            uint32_t ivLength, const uint8_t* pIV,
-                                            uint32_t msgLength, const uint8_t* pMsg)
+hseSrvResponse_t AesGmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                               uint32_t msgLength, const uint8_t* pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
     macScheme.sch.gmac.ivLength = ivLength;
     macScheme.sch.gmac.pIV = (HOST_ADDR)pIV;
-    return MacSignSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesGmacGenerateStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                             uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacGenerateStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t ivLength, const uint8_t* pIV, uint32_t msgLength,
+     const uint8_t* pMsg),
+    (keyHandle, streamId, ivLength, pIV, msgLength, pMsg))
+
+hseSrvResponse_t AesGmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
-    return MacSignSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesGmacGenerateStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                             uint32_t msgLength, const uint8_t *pMsg,
-                                             uint32_t *pTagLength, uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacGenerateStreamUpdate,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesGmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                uint32_t *pTagLength, uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
-    return MacSignSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t AesGmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                          uint32_t ivLength, const uint8_t* pIV,
-                                          uint32_t msgLength, const uint8_t* pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacGenerateStreamFinish,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+     uint32_t *pTagLength, uint8_t *pTag),
+    (keyHandle, streamId, msgLength, pMsg, pTagLength, pTag))
+
+hseSrvResponse_t AesGmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                             uint32_t msgLength, const uint8_t* pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
     macScheme.sch.gmac.ivLength = ivLength;
     macScheme.sch.gmac.pIV = (HOST_ADDR)pIV;
-    return MacVerSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesGmacVerifyStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                           uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacVerifyStreamStart,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t ivLength, const uint8_t* pIV, uint32_t msgLength,
+     const uint8_t* pMsg),
+    (keyHandle, streamId, ivLength, pIV, msgLength, pMsg))
+
+hseSrvResponse_t AesGmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                              uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
-    return MacVerSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t AesGmacVerifyStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
-                                           uint32_t msgLength, const uint8_t *pMsg,
-                                           const uint32_t *pTagLength, const uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacVerifyStreamUpdate,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (keyHandle, streamId, msgLength, pMsg))
+
+hseSrvResponse_t AesGmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                              uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                              const uint32_t *pTagLength, const uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_GMAC;
-    return MacVerSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(AesGmacVerifyStreamFinish,
+    (hseKeyHandle_t keyHandle, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+     const uint32_t *pTagLength, const uint8_t *pTag),
+    (keyHandle, streamId, msgLength, pMsg, pTagLength, pTag))
+
 
 /*******************************************************************************
  *                                  HMAC
  ******************************************************************************/
-hseSrvResponse_t HmacGenerate(hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
-                              uint32_t inputLength, const uint8_t* pInput,
-                              uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType)
+hseSrvResponse_t HmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
+                                 uint32_t inputLength, const uint8_t* pInput, uint32_t* pTagLength,
+                                 uint8_t* pTag, hseSGTOption_t inputSgtType)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacSignSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, authKeyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, authKeyHandle,
                       inputLength, pInput, pTagLength, pTag, inputSgtType);
 }
 
-hseSrvResponse_t HmacVerify(hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
-                            uint32_t inputLength, const uint8_t* pInput,
-                            const uint32_t* pTagLength, const uint8_t* pTag)
+HSE_CTX_DEFINE_SYNC_ASYNC(HmacGenerate,
+    (hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+     uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType),
+    (authKeyHandle, hashAlgo, inputLength, pInput, pTagLength, pTag, inputSgtType))
+
+hseSrvResponse_t HmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
+                               uint32_t inputLength, const uint8_t* pInput, const uint32_t* pTagLength,
+                               const uint8_t* pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacVerSrv(HSE_ACCESS_MODE_ONE_PASS, 0, macScheme, authKeyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_ONE_PASS, 0, &macScheme, authKeyHandle,
                       inputLength, pInput, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t HmacGenerateStartStream(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                         uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_ASYNC(HmacVerify,
+    (hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+     const uint32_t* pTagLength, const uint8_t* pTag),
+    (authKeyHandle, hashAlgo, inputLength, pInput, pTagLength, pTag))
+
+hseSrvResponse_t HmacGenerateStartStreamCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                            hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                            const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacSignSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t HmacGenerateUpdateStream(hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacGenerateStartStream,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+     const uint8_t *pMsg),
+    (keyHandle, hashAlgo, streamId, msgLength, pMsg))
+
+hseSrvResponse_t HmacGenerateUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                             uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacSignSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, 0,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, 0,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t HmacGenerateFinishStream(hseHashAlgo_t hashAlgo, uint32_t streamId,
-                                          uint32_t msgLength, const uint8_t *pMsg,
-                                          uint32_t *pTagLength, uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacGenerateUpdateStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (hashAlgo, streamId, msgLength, pMsg))
+
+hseSrvResponse_t HmacGenerateFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                             uint32_t msgLength, const uint8_t *pMsg, uint32_t *pTagLength,
+                                             uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacSignSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, 0,
+    return MacSignCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, 0,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
-hseSrvResponse_t HmacVerifyStartStream(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                       uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacGenerateFinishStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, uint32_t *pTagLength,
+     uint8_t *pTag),
+    (hashAlgo, streamId, msgLength, pMsg, pTagLength, pTag))
+
+hseSrvResponse_t HmacVerifyStartStreamCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                          hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                          const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacVerSrv(HSE_ACCESS_MODE_START, streamId, macScheme, keyHandle,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_START, streamId, &macScheme, keyHandle,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t HmacVerifyUpdateStream(hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacVerifyStartStream,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+     const uint8_t *pMsg),
+    (keyHandle, hashAlgo, streamId, msgLength, pMsg))
+
+hseSrvResponse_t HmacVerifyUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t msgLength, const uint8_t *pMsg)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacVerSrv(HSE_ACCESS_MODE_UPDATE, streamId, macScheme, 0,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_UPDATE, streamId, &macScheme, 0,
                       msgLength, pMsg, 0, 0, 0U);
 }
 
-hseSrvResponse_t HmacVerifyFinishStream(hseHashAlgo_t hashAlgo, uint32_t streamId,
-                                        uint32_t msgLength, const uint8_t *pMsg,
-                                        const uint32_t *pTagLength, const uint8_t *pTag)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacVerifyUpdateStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg),
+    (hashAlgo, streamId, msgLength, pMsg))
+
+hseSrvResponse_t HmacVerifyFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t msgLength, const uint8_t *pMsg,
+                                           const uint32_t *pTagLength, const uint8_t *pTag)
 {
     hseMacScheme_t macScheme;
     macScheme.macAlgo = HSE_MAC_ALGO_HMAC;
     macScheme.sch.hmac.hashAlgo = hashAlgo;
-    return MacVerSrv(HSE_ACCESS_MODE_FINISH, streamId, macScheme, 0,
+    return MacVerCtx(pCtx, HSE_ACCESS_MODE_FINISH, streamId, &macScheme, 0,
                       msgLength, pMsg, pTagLength, pTag, 0U);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(HmacVerifyFinishStream,
+    (hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+     const uint32_t *pTagLength, const uint8_t *pTag),
+    (hashAlgo, streamId, msgLength, pMsg, pTagLength, pTag))
+
 /* ======================================================================================== */
 
 #ifdef __cplusplus
@@ -15,6 +15,7 @@ extern "C"{
 
 #include "hse_interface.h"
 #include "hse_host_utils.h"
+#include "hse_host_ctx.h"
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
 ==================================================================================================*/
@@ -47,6 +48,19 @@ extern "C"{
                                      FUNCTION PROTOTYPES
 ==================================================================================================*/
 
+/* Context variants: MU, channel, TX options and deadline taken from pCtx.
+ * The ...StreamAsync variants are sent on the channel of pStreamCtx (HSE_CtxStreamOpen), see
+ * HSE_CTX_DEFINE_STREAM_ASYNC; the synchronous stream helpers hold a channel of MU0 from START to FINISH */
+hseSrvResponse_t MacSignCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                            const hseMacScheme_t* pMacScheme, hseKeyHandle_t keyHandle,
+                            uint32_t inputLength, const uint8_t* pInput,
+                            uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t MacVerCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+                           const hseMacScheme_t* pMacScheme, hseKeyHandle_t keyHandle,
+                           uint32_t inputLength, const uint8_t* pInput,
+                           const uint32_t* pTagLength, const uint8_t* pTag, hseSGTOption_t inputSgtType);
+
 hseSrvResponse_t MacSignSrv(hseAccessMode_t accessMode, uint32_t streamId,
                             hseMacScheme_t macScheme, hseKeyHandle_t keyHandle,
                             uint32_t inputLength, const uint8_t* pInput,
@@ -68,30 +82,74 @@ hseSrvResponse_t AesXCbcmac(hseAuthDir_t authDir, uint32_t streamId,
 hseSrvResponse_t AesXCbcmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                     const uint8_t *pMsg, uint32_t* pTagLength,
                                     uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                       const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacGenerateAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                         uint32_t msgLength, const uint8_t *pMsg, uint32_t* pTagLength,
+                                         uint8_t *pTag);
 
 hseSrvResponse_t AesXCbcmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                   const uint8_t *pMsg, const uint32_t* pTagLength,
                                   const uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                     const uint8_t *pMsg, const uint32_t* pTagLength, const uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                       const uint8_t *pMsg, const uint32_t* pTagLength, const uint8_t *pTag);
 
 hseSrvResponse_t AesXCbcmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                                uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacGenerateStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                    hseKeyHandle_t keyHandle,
+                                                    uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t AesXCbcmacGenerateStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
                                                 uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacGenerateStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                     hseKeyHandle_t keyHandle,
+                                                     uint32_t streamId, uint32_t msgLength,
+                                                     const uint8_t *pMsg);
 
 hseSrvResponse_t AesXCbcmacGenerateStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
                                                 uint32_t msgLength, const uint8_t *pMsg,
                                                 uint32_t* pTagLength, uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                   uint32_t* pTagLength, uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacGenerateStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                     hseKeyHandle_t keyHandle,
+                                                     uint32_t streamId, uint32_t msgLength,
+                                                     const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag);
 
 hseSrvResponse_t AesXCbcmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                                uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacVerifyStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                  hseKeyHandle_t keyHandle,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t AesXCbcmacVerifyStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
                                                 uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesXCbcmacVerifyStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                   hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t AesXCbcmacVerifyStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
                                               uint32_t msgLength, const uint8_t *pMsg,
                                               const uint32_t* pTagLength, const uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                 const uint32_t* pTagLength, const uint8_t *pTag);
+hseSrvResponse_t AesXCbcmacVerifyStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                   hseKeyHandle_t keyHandle,
+                                                   uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                   const uint32_t* pTagLength, const uint8_t *pTag);
 
 /*******************************************************************************
  *                                  CMAC
@@ -106,29 +164,90 @@ hseSrvResponse_t AesCmac(hseAuthDir_t authDir, uint32_t streamId,
 hseSrvResponse_t AesCmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                  const uint8_t *pMsg, uint32_t* pTagLength,
                                  uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                      const uint8_t *pMsg, uint32_t* pTagLength, uint8_t *pTag,
+                                      hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t AesFastCmacGenerate(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                  const uint8_t *pMsg, uint8_t tagLength,
                                  uint8_t *pTag);
+hseSrvResponse_t AesFastCmacGenerateAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                          uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength,
+                                          uint8_t *pTag);
 hseSrvResponse_t AesFastCmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                  const uint8_t *pMsg, uint8_t tagLength,
                                  const uint8_t *pTag);
+hseSrvResponse_t AesFastCmacVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                        uint32_t msgLength, const uint8_t *pMsg, uint8_t tagLength,
+                                        const uint8_t *pTag);
 
 hseSrvResponse_t AesCmacVerify(hseKeyHandle_t keyHandle, uint32_t msgLength,
                                const uint8_t *pMsg, const uint32_t* tagLength,
                                const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                    const uint8_t *pMsg, const uint32_t* tagLength, const uint8_t *pTag,
+                                    hseSGTOption_t inputSgtType);
+
+hseSrvResponse_t AesCmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                    const uint8_t *pMsg, uint32_t* pTagLength,
+                                    uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                  const uint8_t *pMsg, const uint32_t* pTagLength,
+                                  const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesFastCmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                        const uint8_t *pMsg, uint8_t tagLength, uint8_t *pTag);
+hseSrvResponse_t AesFastCmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t msgLength,
+                                      const uint8_t *pMsg, uint8_t tagLength, const uint8_t *pTag);
 
 hseSrvResponse_t AesCmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                             uint32_t msgLength, const uint8_t* pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                               hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                 hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                                 hseSGTOption_t inputSgtType);
 hseSrvResponse_t AesCmacGenerateStreamUpdate(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                                const uint8_t *pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                  hseSGTOption_t inputSgtType);
 hseSrvResponse_t AesCmacGenerateStreamFinish(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
                                              uint32_t *pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                                const uint8_t *pMsg, uint32_t *pTagLength, uint8_t *pTag,
+                                                hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacGenerateStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                  uint32_t *pTagLength, uint8_t *pTag,
+                                                  hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t AesCmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                           uint32_t msgLength, const uint8_t* pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                             hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t msgLength, const uint8_t* pMsg,
+                                               hseSGTOption_t inputSgtType);
 hseSrvResponse_t AesCmacVerifyStreamUpdate(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                              const uint8_t *pMsg, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                hseSGTOption_t inputSgtType);
 hseSrvResponse_t AesCmacVerifyStreamFinish(uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
                                            const uint32_t *pTagLength, const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, uint32_t streamId, uint32_t msgLength,
+                                              const uint8_t *pMsg, const uint32_t *pTagLength,
+                                              const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesCmacVerifyStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                const uint32_t *pTagLength, const uint8_t *pTag,
+                                                hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t AesKmCmacGen(uint8_t u8MuInstance, hseKeyHandle_t keyHandle, uint32_t messageLength, const uint8_t *pMessage, uint8_t *tag,
                               uint32_t tagsize, uint32_t streamId, hseAccessMode_t accessMode);
@@ -142,35 +261,86 @@ hseSrvResponse_t AesGmacGenerate(hseKeyHandle_t keyHandle, uint32_t ivLength,
                                  const uint8_t *pIV, uint32_t msgLength,
                                  const uint8_t *pMsg, uint32_t* pTagLength,
                                  uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                    const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+                                    uint32_t* pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGmacGenerateAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t ivLength,
+                                      const uint8_t *pIV, uint32_t msgLength, const uint8_t *pMsg,
+                                      uint32_t* pTagLength, uint8_t *pTag, hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t AesGmacVerify(hseKeyHandle_t keyHandle, const uint32_t ivLength,
                                const uint8_t* pIV, uint32_t msgLength,
                                const uint8_t *pMsg, const uint32_t* pTagLength,
                                const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, const uint32_t ivLength,
+                                  const uint8_t* pIV, uint32_t msgLength, const uint8_t *pMsg,
+                                  const uint32_t* pTagLength, const uint8_t *pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t AesGmacVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                    const uint32_t ivLength, const uint8_t* pIV, uint32_t msgLength,
+                                    const uint8_t *pMsg, const uint32_t* pTagLength, const uint8_t *pTag,
+                                    hseSGTOption_t inputSgtType);
 
 /* Streaming for Gmac ? */
 hseSrvResponse_t AesGmacGenerateStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                             uint32_t ivLength, const uint8_t* pIV,
                                             uint32_t msgLength, const uint8_t* pMsg);
+hseSrvResponse_t AesGmacGenerateStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                               uint32_t msgLength, const uint8_t* pMsg);
+hseSrvResponse_t AesGmacGenerateStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                 hseKeyHandle_t keyHandle,
+                                                 uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                                 uint32_t msgLength, const uint8_t* pMsg);
 
 hseSrvResponse_t AesGmacGenerateStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
                                              uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesGmacGenerateStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesGmacGenerateStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                  hseKeyHandle_t keyHandle,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 
 hseSrvResponse_t AesGmacGenerateStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
                                              uint32_t msgLength, const uint8_t *pMsg,
                                              uint32_t *pTagLength, uint8_t *pTag);
+hseSrvResponse_t AesGmacGenerateStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                uint32_t *pTagLength, uint8_t *pTag);
+hseSrvResponse_t AesGmacGenerateStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                  hseKeyHandle_t keyHandle,
+                                                  uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                  uint32_t *pTagLength, uint8_t *pTag);
 
 hseSrvResponse_t AesGmacVerifyStreamStart(hseKeyHandle_t keyHandle, uint32_t streamId,
                                           uint32_t ivLength, const uint8_t* pIV,
                                           uint32_t msgLength, const uint8_t* pMsg);
+hseSrvResponse_t AesGmacVerifyStreamStartCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                             uint32_t msgLength, const uint8_t* pMsg);
+hseSrvResponse_t AesGmacVerifyStreamStartAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               hseKeyHandle_t keyHandle,
+                                               uint32_t streamId, uint32_t ivLength, const uint8_t* pIV,
+                                               uint32_t msgLength, const uint8_t* pMsg);
 
 hseSrvResponse_t AesGmacVerifyStreamUpdate(hseKeyHandle_t keyHandle, uint32_t streamId,
                                            uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesGmacVerifyStreamUpdateCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                              uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t AesGmacVerifyStreamUpdateAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t AesGmacVerifyStreamFinish(hseKeyHandle_t keyHandle, uint32_t streamId,
                                            uint32_t msgLength, const uint8_t *pMsg,
                                            const uint32_t *pTagLength, const uint8_t *pTag);
+hseSrvResponse_t AesGmacVerifyStreamFinishCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                              uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                              const uint32_t *pTagLength, const uint8_t *pTag);
+hseSrvResponse_t AesGmacVerifyStreamFinishAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                hseKeyHandle_t keyHandle,
+                                                uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                                const uint32_t *pTagLength, const uint8_t *pTag);
 
 /*******************************************************************************
  *                                  HMAC
@@ -179,10 +349,22 @@ hseSrvResponse_t AesGmacVerifyStreamFinish(hseKeyHandle_t keyHandle, uint32_t st
 hseSrvResponse_t HmacGenerate(hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
                               uint32_t inputLength, const uint8_t* pInput,
                               uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t HmacGenerateCtx(const hseCtx_t* pCtx, hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
+                                 uint32_t inputLength, const uint8_t* pInput, uint32_t* pTagLength,
+                                 uint8_t* pTag, hseSGTOption_t inputSgtType);
+hseSrvResponse_t HmacGenerateAsync(hseTxOptions_t txOptions, hseKeyHandle_t authKeyHandle,
+                                   hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+                                   uint32_t* pTagLength, uint8_t* pTag, hseSGTOption_t inputSgtType);
 
 hseSrvResponse_t HmacVerify(hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
                             uint32_t inputLength, const uint8_t* pInput,
                             const uint32_t* tagLength, const uint8_t* pTag);
+hseSrvResponse_t HmacVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t authKeyHandle, hseHashAlgo_t hashAlgo,
+                               uint32_t inputLength, const uint8_t* pInput, const uint32_t* tagLength,
+                               const uint8_t* pTag);
+hseSrvResponse_t HmacVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t authKeyHandle,
+                                 hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+                                 const uint32_t* tagLength, const uint8_t* pTag);
 
 /* Streaming */
 hseSrvResponse_t HmacStream(
@@ -199,21 +381,59 @@ hseSrvResponse_t HmacStream(
 
 hseSrvResponse_t HmacGenerateStartStream(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                          uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacGenerateStartStreamCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                            hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                            const uint8_t *pMsg);
+hseSrvResponse_t HmacGenerateStartStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                              hseKeyHandle_t keyHandle,
+                                              hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                              const uint8_t *pMsg);
 
 hseSrvResponse_t HmacGenerateUpdateStream(hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacGenerateUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                             uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacGenerateUpdateStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               hseHashAlgo_t hashAlgo,
+                                               uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t HmacGenerateFinishStream(hseHashAlgo_t hashAlgo, uint32_t streamId,
                                           uint32_t msgLength, const uint8_t *pMsg,
                                           uint32_t *pTagLength, uint8_t *pTag);
+hseSrvResponse_t HmacGenerateFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                             uint32_t msgLength, const uint8_t *pMsg, uint32_t *pTagLength,
+                                             uint8_t *pTag);
+hseSrvResponse_t HmacGenerateFinishStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               hseHashAlgo_t hashAlgo,
+                                               uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                               uint32_t *pTagLength, uint8_t *pTag);
 
 hseSrvResponse_t HmacVerifyStartStream(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                        uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacVerifyStartStreamCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                          hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                          const uint8_t *pMsg);
+hseSrvResponse_t HmacVerifyStartStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                            hseKeyHandle_t keyHandle,
+                                            hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength,
+                                            const uint8_t *pMsg);
 
 hseSrvResponse_t HmacVerifyUpdateStream(hseHashAlgo_t hashAlgo, uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacVerifyUpdateStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t msgLength, const uint8_t *pMsg);
+hseSrvResponse_t HmacVerifyUpdateStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseHashAlgo_t hashAlgo,
+                                             uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg);
 
 hseSrvResponse_t HmacVerifyFinishStream(hseHashAlgo_t hashAlgo, uint32_t streamId,
                                         uint32_t msgLength, const uint8_t *pMsg,
                                         const uint32_t *pTagLength, const uint8_t *pTag);
+hseSrvResponse_t HmacVerifyFinishStreamCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t streamId,
+                                           uint32_t msgLength, const uint8_t *pMsg,
+                                           const uint32_t *pTagLength, const uint8_t *pTag);
+hseSrvResponse_t HmacVerifyFinishStreamAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                             hseHashAlgo_t hashAlgo,
+                                             uint32_t streamId, uint32_t msgLength, const uint8_t *pMsg,
+                                             const uint32_t *pTagLength, const uint8_t *pTag);
 
 /* ======================================================================================== */
 
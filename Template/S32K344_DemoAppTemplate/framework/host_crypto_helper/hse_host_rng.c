@@ -37,7 +37,10 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_srv_builders.h"
 #include "hse_interface.h"
+#include "hse_host_rng.h"
 #include "string.h"
 /*==================================================================================================
  *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
@@ -54,8 +57,6 @@ extern "C"
 /*==================================================================================================
  *                                      LOCAL VARIABLES
  ==================================================================================================*/
-static uint8_t muIf = 0U;
-static uint8_t muChannelIdx = 1U;
 
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
@@ -106,23 +107,30 @@ static uint8_t muChannelIdx = 1U;
  * HSE_SRV_RSP_GENERAL_ERROR             This error code is returned if an error not covered by
  *                                 the error codes above is detected inside HSE
  ******************************************************************************/
-hseSrvResponse_t GetRngNum(uint8_t *rngNum, uint32_t rngNumSize, hseRngClass_t rngClass)
-{
-    hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-    hseGetRandomNumSrv_t* pGetRndSrv;
+HSE_CTX_DEFINE_SYNC_ASYNC(GetRngNum,
+    (uint8_t *rngNum, uint32_t rngNumSize, hseRngClass_t rngClass),
+    (rngNum, rngNumSize, rngClass))
 
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-    pHseSrvDesc->srvId = HSE_SRV_ID_GET_RANDOM_NUM;
+/*******************************************************************************
+ * Function:    GetRngNumCtx
+ *
+ * Description: Same as GetRngNum, sent on the MU/channel of the request context.
+ *
+ * Returns:     As GetRngNum, or HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel is free
+ ******************************************************************************/
+hseSrvResponse_t GetRngNumCtx(const hseCtx_t* pCtx, uint8_t *rngNum, uint32_t rngNumSize, hseRngClass_t rngClass)
+{
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(pCtx, &muChannelIdx);
 
-    pGetRndSrv = &(pHseSrvDesc->hseSrv.getRandomNumReq);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
 
-    pGetRndSrv->rngClass = rngClass;
-    pGetRndSrv->pRandomNum = (HOST_ADDR)rngNum;
-    pGetRndSrv->randomNumLength = rngNumSize;
+    HSE_BuildGetRandomNumReq(pHseSrvDesc, rngClass, rngNumSize, rngNum);
 
-    hseStatus = HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
-    return hseStatus;
+    return HSE_CtxSend(pCtx, muChannelIdx, pHseSrvDesc);
 }
 
 /*==================================================================================================
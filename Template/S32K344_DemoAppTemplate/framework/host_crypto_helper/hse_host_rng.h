@@ -39,6 +39,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_interface.h"
+#include "hse_host_ctx.h"
 
 
 /*==================================================================================================
@@ -66,6 +67,11 @@ extern "C"{
 ==================================================================================================*/
 
 hseSrvResponse_t GetRngNum(uint8_t *rngNum, uint32_t rngNumSize, hseRngClass_t rngClass);
+hseSrvResponse_t GetRngNumAsync(hseTxOptions_t txOptions, uint8_t *rngNum, uint32_t rngNumSize,
+                                hseRngClass_t rngClass);
+
+/* Context variant: MU, channel, TX options and deadline taken from pCtx */
+hseSrvResponse_t GetRngNumCtx(const hseCtx_t* pCtx, uint8_t *rngNum, uint32_t rngNumSize, hseRngClass_t rngClass);
 
 /*******************************************************************************
  * Function:    GetRngDRG3Num
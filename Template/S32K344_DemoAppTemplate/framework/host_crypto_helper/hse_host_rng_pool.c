@@ -0,0 +1,377 @@
+/**
+*   @file    hse_host_rng_pool.c
+*
+*   @brief   HSE HOST random number prefetch pool.
+*   @details Double-buffered DRG3/DRG4 cache: requests are copied from the served block and wiped
+*            from it; the spare block is refilled asynchronously once the served block runs low,
+*            and the blocks are swapped when the served block is used up.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_rng_pool.c
+*/
+#include <stdatomic.h>
+#include "hse_host_rng_pool.h"
+#include "hse_host_ctx.h"
+#include "hse_completion_ring.h"
+#include "hse_mu.h"
+#include "host_compiler_api.h"
+#include "host_stm.h"
+#include "string.h"
+
+#ifdef HSE_SPT_RANDOM
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   State of the spare block
+ */
+typedef enum
+{
+    HSE_RNG_POOL_SPARE_EMPTY = 0U,  /* Used up and wiped */
+    HSE_RNG_POOL_SPARE_FILLING,     /* Refill request in flight */
+    HSE_RNG_POOL_SPARE_READY,       /* Filled by the HSE */
+} hseRngPoolSpareState_t;
+
+/*
+ * @brief   Pool of a RNG class
+ */
+typedef struct
+{
+    uint8_t                 au8Block[2][HSE_RNG_POOL_BLOCK_SIZE];
+    uint32_t                u32Served;      /* Index of the block served */
+    uint32_t                u32Offset;      /* Next unread byte of the block served */
+    atomic_uint             u32SpareState;  /* hseRngPoolSpareState_t of the other block */
+    atomic_flag             lock;           /* Held by the caller serving from the pool */
+    atomic_uint_least32_t   u32Hits;
+    atomic_uint_least32_t   u32Misses;
+    atomic_uint_least32_t   u32Refills;
+    atomic_uint_least32_t   u32RefillErrors;
+} hseRngPool_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* All service channels, except channel 0 (reserved for administration services) */
+#define HSE_RNG_POOL_CHANNEL_MASK       ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* Cached classes: HSE_RNG_CLASS_DRG3 and HSE_RNG_CLASS_DRG4, indexed by the class */
+#define HSE_RNG_POOL_COUNT              (2U)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseRngPool_t rngPool[HSE_RNG_POOL_COUNT];
+static uint8_t u8RngPoolMuInstance = 0U;
+static atomic_bool bRngPoolReady;
+/* RX interrupts of u8RngPoolMuInstance enabled by the pool, disabled again by HSE_RngPoolDeinit */
+static uint32_t u32RngPoolIrqEnabled = 0UL;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static void HSE_RngPoolRefillDone(hseSrvResponse_t status, void* pArg);
+static void HSE_RngPoolRefill(hseRngPool_t* pPool, hseRngClass_t rngClass);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Refill completion callback (MU RX interrupt or HSE_PollCompletions).
+ ******************************************************************************/
+static void HSE_RngPoolRefillDone(hseSrvResponse_t status, void* pArg)
+{
+    hseRngPool_t* pPool = (hseRngPool_t*)pArg;
+
+    if(HSE_SRV_RSP_OK == status)
+    {
+        (void)atomic_fetch_add(&pPool->u32Refills, 1U);
+        atomic_store(&pPool->u32SpareState, HSE_RNG_POOL_SPARE_READY);
+    }
+    else
+    {
+        (void)atomic_fetch_add(&pPool->u32RefillErrors, 1U);
+        atomic_store(&pPool->u32SpareState, HSE_RNG_POOL_SPARE_EMPTY);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Start the refill of the spare block if it is empty.
+ *                 A refill that cannot be sent is retried by the next request.
+ ******************************************************************************/
+static void HSE_RngPoolRefill(hseRngPool_t* pPool, hseRngClass_t rngClass)
+{
+    unsigned int expected = HSE_RNG_POOL_SPARE_EMPTY;
+    hseTxOptions_t txOptions;
+    hseCtx_t ctx;
+    hseSrvResponse_t status;
+
+    if(!atomic_compare_exchange_strong(&pPool->u32SpareState, &expected, HSE_RNG_POOL_SPARE_FILLING))
+    {
+        return;
+    }
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_RngPoolRefillDone;
+    txOptions.pCallbackpArg   = (void*)pPool;
+    ctx = HSE_CtxOnChannel(u8RngPoolMuInstance, HSE_INVALID_CHANNEL, txOptions);
+
+    status = GetRngNumCtx(&ctx, pPool->au8Block[1UL - pPool->u32Served], HSE_RNG_POOL_BLOCK_SIZE, rngClass);
+    if(HSE_SRV_RSP_OK != status)
+    {
+        if(HSE_SRV_RSP_HOST_CHANNEL_BUSY != status)
+        {
+            (void)atomic_fetch_add(&pPool->u32RefillErrors, 1U);
+        }
+        atomic_store(&pPool->u32SpareState, HSE_RNG_POOL_SPARE_EMPTY);
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Fill the DRG3 and DRG4 pools.
+ ******************************************************************************/
+hseSrvResponse_t HSE_RngPoolInit(uint8_t u8MuInstance)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    const hseCtx_t ctx = HSE_CTX_INIT(u8MuInstance);
+    hseRngPool_t* pPool;
+    uint8_t u8Class;
+
+    if(u8MuInstance >= HSE_NUM_OF_MU_INSTANCES)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    /* Refill requests of a previous initialization may still be in flight */
+    for(u8Class = 0U; u8Class < HSE_RNG_POOL_COUNT; u8Class++)
+    {
+        if(HSE_RNG_POOL_SPARE_FILLING == atomic_load(&rngPool[u8Class].u32SpareState))
+        {
+            return HSE_SRV_RSP_NOT_ALLOWED;
+        }
+    }
+
+    atomic_store(&bRngPoolReady, false);
+    /* The interrupts enabled by a previous initialization on another MU are disabled again */
+    if((u8MuInstance != u8RngPoolMuInstance) && (0UL != u32RngPoolIrqEnabled))
+    {
+        HSE_MU_DisableInterrupts(u8RngPoolMuInstance, HSE_INT_RESPONSE, u32RngPoolIrqEnabled);
+        u32RngPoolIrqEnabled = 0UL;
+    }
+    u8RngPoolMuInstance = u8MuInstance;
+    /* Refills complete in the RX interrupt; the interrupts not enabled before are kept until HSE_RngPoolDeinit */
+    u32RngPoolIrqEnabled |= HSE_RNG_POOL_CHANNEL_MASK & ~muRxEnabledInterruptMask[u8MuInstance];
+    HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HSE_RNG_POOL_CHANNEL_MASK);
+
+    for(u8Class = 0U; (u8Class < HSE_RNG_POOL_COUNT) && (HSE_SRV_RSP_OK == status); u8Class++)
+    {
+        pPool = &rngPool[u8Class];
+        atomic_flag_clear(&pPool->lock);
+        atomic_store(&pPool->u32Hits, 0U);
+        atomic_store(&pPool->u32Misses, 0U);
+        atomic_store(&pPool->u32Refills, 0U);
+        atomic_store(&pPool->u32RefillErrors, 0U);
+        atomic_store(&pPool->u32SpareState, HSE_RNG_POOL_SPARE_EMPTY);
+        pPool->u32Served = 0UL;
+        pPool->u32Offset = 0UL;
+
+        status = GetRngNumCtx(&ctx, pPool->au8Block[0], HSE_RNG_POOL_BLOCK_SIZE, (hseRngClass_t)u8Class);
+        if(HSE_SRV_RSP_OK == status)
+        {
+            HSE_RngPoolRefill(pPool, (hseRngClass_t)u8Class);
+        }
+    }
+
+    if(HSE_SRV_RSP_OK == status)
+    {
+        atomic_store(&bRngPoolReady, true);
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Stop serving from the pools, wait for the refills in flight,
+ *                 wipe the blocks and disable the RX interrupts the pools enabled.
+ ******************************************************************************/
+hseSrvResponse_t HSE_RngPoolDeinit(void)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    uint32_t u32Start;
+    uint8_t u8Class;
+
+    atomic_store(&bRngPoolReady, false);
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    for(u8Class = 0U; u8Class < HSE_RNG_POOL_COUNT; u8Class++)
+    {
+        /* A caller still serving from the pool may start one more refill */
+        while(atomic_flag_test_and_set(&rngPool[u8Class].lock))
+        {
+            HSE_WAIT_FOR_EVENT();
+        }
+        while((HSE_RNG_POOL_SPARE_FILLING == atomic_load(&rngPool[u8Class].u32SpareState)) &&
+              ((GetStmTimebaseUs() - u32Start) < HSE_WAIT_DEFAULT_TIMEOUT_US))
+        {
+            if(HSE_CompletionsDeferred())
+            {
+                (void)HSE_PollCompletions(0UL);
+            }
+            HSE_WAIT_FOR_EVENT();
+        }
+        if(HSE_RNG_POOL_SPARE_FILLING == atomic_load(&rngPool[u8Class].u32SpareState))
+        {
+            /* The HSE still writes the spare block: its interrupts stay enabled */
+            status = HSE_SRV_RSP_HOST_TIMEOUT;
+        }
+        else
+        {
+            (void)memset(rngPool[u8Class].au8Block, 0, sizeof(rngPool[u8Class].au8Block));
+            atomic_store(&rngPool[u8Class].u32SpareState, HSE_RNG_POOL_SPARE_EMPTY);
+        }
+        atomic_flag_clear(&rngPool[u8Class].lock);
+    }
+
+    if((HSE_SRV_RSP_OK == status) && (0UL != u32RngPoolIrqEnabled))
+    {
+        HSE_MU_DisableInterrupts(u8RngPoolMuInstance, HSE_INT_RESPONSE, u32RngPoolIrqEnabled);
+        u32RngPoolIrqEnabled = 0UL;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Get random bytes from the pool of a class.
+ ******************************************************************************/
+hseSrvResponse_t HSE_RngPoolGet(uint8_t* pRngNum, uint32_t u32RngNumSize, hseRngClass_t rngClass)
+{
+    hseRngPool_t* pPool;
+    uint8_t* pBlock;
+    uint32_t u32Left;
+    bool_t bServed = FALSE;
+
+    if((NULL == pRngNum) || (0UL == u32RngNumSize))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if((rngClass >= HSE_RNG_POOL_COUNT) || !atomic_load(&bRngPoolReady))
+    {
+        return GetRngNum(pRngNum, u32RngNumSize, rngClass);
+    }
+
+    pPool = &rngPool[rngClass];
+    if((u32RngNumSize <= HSE_RNG_POOL_BLOCK_SIZE) && !atomic_flag_test_and_set(&pPool->lock))
+    {
+        u32Left = HSE_RNG_POOL_BLOCK_SIZE - pPool->u32Offset;
+        if((u32Left >= u32RngNumSize) ||
+           (HSE_RNG_POOL_SPARE_READY == atomic_load(&pPool->u32SpareState)))
+        {
+            pBlock = &pPool->au8Block[pPool->u32Served][pPool->u32Offset];
+            if(u32Left < u32RngNumSize)
+            {
+                /* Use up the served block and continue from the spare one */
+                (void)memcpy(pRngNum, pBlock, u32Left);
+                (void)memset(pBlock, 0, u32Left);
+                pPool->u32Served = 1UL - pPool->u32Served;
+                pPool->u32Offset = 0UL;
+                atomic_store(&pPool->u32SpareState, HSE_RNG_POOL_SPARE_EMPTY);
+                pRngNum       = &pRngNum[u32Left];
+                u32RngNumSize -= u32Left;
+                pBlock = &pPool->au8Block[pPool->u32Served][0];
+            }
+            (void)memcpy(pRngNum, pBlock, u32RngNumSize);
+            (void)memset(pBlock, 0, u32RngNumSize);
+            pPool->u32Offset += u32RngNumSize;
+            bServed = TRUE;
+        }
+
+        if((HSE_RNG_POOL_BLOCK_SIZE - pPool->u32Offset) <= HSE_RNG_POOL_LOW_WATER)
+        {
+            HSE_RngPoolRefill(pPool, rngClass);
+        }
+        atomic_flag_clear(&pPool->lock);
+    }
+
+    if(bServed)
+    {
+        (void)atomic_fetch_add(&pPool->u32Hits, 1U);
+        return HSE_SRV_RSP_OK;
+    }
+    (void)atomic_fetch_add(&pPool->u32Misses, 1U);
+    return GetRngNum(pRngNum, u32RngNumSize, rngClass);
+}
+
+/*******************************************************************************
+ * Description   : Get the statistics of the pool of a class.
+ ******************************************************************************/
+hseSrvResponse_t HSE_RngPoolGetStats(hseRngClass_t rngClass, hseRngPoolStats_t* pStats)
+{
+    hseRngPool_t* pPool;
+
+    if((rngClass >= HSE_RNG_POOL_COUNT) || (NULL == pStats))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pPool = &rngPool[rngClass];
+    pStats->u32Hits         = atomic_load(&pPool->u32Hits);
+    pStats->u32Misses       = atomic_load(&pPool->u32Misses);
+    pStats->u32Refills      = atomic_load(&pPool->u32Refills);
+    pStats->u32RefillErrors = atomic_load(&pPool->u32RefillErrors);
+    return HSE_SRV_RSP_OK;
+}
+
+#endif /* HSE_SPT_RANDOM */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,155 @@
+/**
+*   @file    hse_host_rng_pool.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST random number prefetch pool.
+*   @details Caches DRG3/DRG4 random numbers in RAM: each class has two blocks, one served to the
+*            application and one refilled asynchronously by the HSE, so small requests are served
+*            without a MU round trip.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_RNG_POOL_H
+#define HSE_HOST_RNG_POOL_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_rng_pool.h
+*/
+#include "hse_host.h"
+#include "hse_host_rng.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Bytes of a pool block, fetched by one request (at most 512, see hseGetRandomNumSrv_t) */
+#ifndef HSE_RNG_POOL_BLOCK_SIZE
+#define HSE_RNG_POOL_BLOCK_SIZE         (512UL)
+#endif
+
+/* The refill of the spare block starts when fewer bytes are left in the block being served */
+#ifndef HSE_RNG_POOL_LOW_WATER
+#define HSE_RNG_POOL_LOW_WATER          (HSE_RNG_POOL_BLOCK_SIZE / 2UL)
+#endif
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Statistics of a pool
+ */
+typedef struct
+{
+    uint32_t    u32Hits;            /**< @brief    Requests served from the pool. */
+    uint32_t    u32Misses;          /**< @brief    Requests forwarded to the HSE (pool empty, busy, or request too long). */
+    uint32_t    u32Refills;         /**< @brief    Blocks refilled. */
+    uint32_t    u32RefillErrors;    /**< @brief    Refills that failed (or could not be sent). */
+} hseRngPoolStats_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#ifdef HSE_SPT_RANDOM
+/**
+* @brief        Fill the DRG3 and DRG4 pools.
+* @details      Fetches the first block of each pool synchronously and starts the refill of the
+*               spare blocks. The refills complete in the MU RX interrupt, or in
+*               HSE_PollCompletions() with deferred completions: the RX interrupts of the service
+*               channels of the MU stay enabled until HSE_RngPoolDeinit().
+*
+* @param[in]    u8MuInstance    The MU instance the refills are sent on.
+*
+* @return       HSE_SRV_RSP_OK, or the error of the first block fetch.
+*/
+hseSrvResponse_t HSE_RngPoolInit(uint8_t u8MuInstance);
+
+/**
+* @brief        Stop the DRG3 and DRG4 pools.
+* @details      HSE_RngPoolGet() forwards all the requests to GetRngNum() again. Waits for the
+*               refills in flight, wipes the pools and disables the RX interrupts enabled by
+*               HSE_RngPoolInit() (the ones enabled before are left as they were).
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_HOST_TIMEOUT if a refill did not complete within
+*               HSE_WAIT_DEFAULT_TIMEOUT_US (its interrupts are left enabled, call it again).
+*/
+hseSrvResponse_t HSE_RngPoolDeinit(void);
+
+/**
+* @brief        Get random bytes from the pool of a class.
+* @details      Copies the bytes from the pool and wipes them from the pool, then starts the refill
+*               of the spare block if the low-water mark was reached. Requests longer than
+*               HSE_RNG_POOL_BLOCK_SIZE, requests of other classes, requests the pool cannot serve
+*               yet and requests made while the pool is used by another caller are forwarded to
+*               GetRngNum() (synchronous). Can be called from several tasks.
+*
+* @param[out]   pRngNum         The random bytes.
+* @param[in]    u32RngNumSize   Number of bytes.
+* @param[in]    rngClass        HSE_RNG_CLASS_DRG3 or HSE_RNG_CLASS_DRG4 (other classes are not cached).
+*
+* @return       HSE_SRV_RSP_OK, or the error of GetRngNum().
+*/
+hseSrvResponse_t HSE_RngPoolGet(uint8_t* pRngNum, uint32_t u32RngNumSize, hseRngClass_t rngClass);
+
+/**
+* @brief        Get the statistics of the pool of a class.
+*
+* @param[in]    rngClass        HSE_RNG_CLASS_DRG3 or HSE_RNG_CLASS_DRG4.
+* @param[out]   pStats          The statistics.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_INVALID_PARAM if the class is not cached.
+*/
+hseSrvResponse_t HSE_RngPoolGetStats(hseRngClass_t rngClass, hseRngPoolStats_t* pStats);
+#endif /* HSE_SPT_RANDOM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_RNG_POOL_H */
+
+/** @} */
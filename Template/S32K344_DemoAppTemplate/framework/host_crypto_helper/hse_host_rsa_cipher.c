@@ -33,6 +33,7 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
 #include "string.h"
 
 #include "hse_host_hash.h"
@@ -70,21 +71,19 @@ static uint8_t muChannelIdx = 1U;
 /*==================================================================================================
  *                                   LOCAL FUNCTION PROTOTYPES
  ==================================================================================================*/
-static hseSrvResponse_t RsaCipherReq(hseCipherDir_t cipherDir, hseRsaCipherScheme_t rsaScheme,
-                                     hseKeyHandle_t keyHandle, uint32_t inLength,
-                                     HOST_ADDR pInput, HOST_ADDR pOutLength,
-                                     HOST_ADDR pOutput);
-
-/*==================================================================================================
- *                                       LOCAL FUNCTIONS
- ==================================================================================================*/
-
-static hseSrvResponse_t RsaCipherReq(hseCipherDir_t cipherDir, hseRsaCipherScheme_t rsaScheme,
-                                     hseKeyHandle_t keyHandle, uint32_t inLength,
-                                     HOST_ADDR pInput, HOST_ADDR pOutLength,
-                                     HOST_ADDR pOutput)
+static hseSrvResponse_t RsaCipherReqCtx(const hseCtx_t* pCtx,
+                                        hseCipherDir_t cipherDir, hseRsaCipherScheme_t rsaScheme,
+                                        hseKeyHandle_t keyHandle, uint32_t inLength,
+                                        HOST_ADDR pInput, HOST_ADDR pOutLength,
+                                        HOST_ADDR pOutput)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
+    uint8_t u8MuChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(pCtx, &u8MuChannelIdx);
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
 
     pHseSrvDesc->srvId = HSE_SRV_ID_RSA_CIPHER;
     hseRsaCipherSrv_t *pRsaCipherSrv = &(pHseSrvDesc->hseSrv.rsaCipherReq);
@@ -99,7 +98,7 @@ static hseSrvResponse_t RsaCipherReq(hseCipherDir_t cipherDir, hseRsaCipherSchem
     pRsaCipherSrv->pOutput = pOutput;
     pRsaCipherSrv->pOutputLength = pOutLength;
 
-    return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(pCtx, u8MuChannelIdx, pHseSrvDesc);
 }
 
 static hseSrvResponse_t RsaCipherReqAsync(
@@ -109,22 +108,10 @@ static hseSrvResponse_t RsaCipherReqAsync(
     const uint8_t u8MuIf, const uint8_t u8MuChannelIdx,
     hseTxOptions_t asyncTxOptions)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[u8MuIf][u8MuChannelIdx];
+    const hseCtx_t ctx = HSE_CtxOnChannel(u8MuIf, u8MuChannelIdx, asyncTxOptions);
 
-    pHseSrvDesc->srvId = HSE_SRV_ID_RSA_CIPHER;
-    hseRsaCipherSrv_t *pRsaCipherSrv = &(pHseSrvDesc->hseSrv.rsaCipherReq);
-    memset(pRsaCipherSrv, 0, sizeof(hseRsaCipherSrv_t));
-
-    pRsaCipherSrv->cipherDir = cipherDir;
-    pRsaCipherSrv->rsaScheme = rsaScheme;
-    pRsaCipherSrv->keyHandle = keyHandle;
-
-    pRsaCipherSrv->pInput = pInput;
-    pRsaCipherSrv->inputLength = inLength;
-    pRsaCipherSrv->pOutput = pOutput;
-    pRsaCipherSrv->pOutputLength = pOutLength;
-
-    return HSE_Send(u8MuIf, u8MuChannelIdx, asyncTxOptions, pHseSrvDesc);
+    return RsaCipherReqCtx(&ctx, cipherDir, rsaScheme, keyHandle, inLength,
+                           pInput, pOutLength, pOutput);
 }
 
 /*==================================================================================================
@@ -213,15 +200,22 @@ exit:
 }
 #endif
 
-hseSrvResponse_t RsaEncrypt(hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle, uint32_t plaintextLength,
-                            uint8_t *pPlaintext, uint32_t *pCiphertextLength, uint8_t *pCiphertext)
+hseSrvResponse_t RsaEncryptCtx(const hseCtx_t* pCtx, hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle,
+                               uint32_t plaintextLength, uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                               uint8_t *pCiphertext)
 {
-    return RsaCipherReq(HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength, (HOST_ADDR)pPlaintext,
-                        (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength,
+                           (HOST_ADDR)pPlaintext, (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
 }
 
-hseSrvResponse_t RsaDecrypt
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaEncrypt,
+    (hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle, uint32_t plaintextLength, uint8_t *pPlaintext,
+     uint32_t *pCiphertextLength, uint8_t *pCiphertext),
+    (rsaScheme, keyHandle, plaintextLength, pPlaintext, pCiphertextLength, pCiphertext))
+
+hseSrvResponse_t RsaDecryptCtx
 (
+    const hseCtx_t* pCtx,
     hseRsaCipherScheme_t rsaScheme,
     hseKeyHandle_t keyHandle,
     uint32_t ciphertextLength,
@@ -230,13 +224,19 @@ hseSrvResponse_t RsaDecrypt
     uint8_t *pPlaintext
 )
 {
-    return RsaCipherReq(HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength, (HOST_ADDR)pCiphertext,
-                        (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength,
+                           (HOST_ADDR)pCiphertext, (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaDecrypt,
+    (hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle, uint32_t ciphertextLength,
+     uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext),
+    (rsaScheme, keyHandle, ciphertextLength, pCiphertext, pPlaintextLength, pPlaintext))
+
 /* HSE_RSA_ALGO_NO_PADDING */
-hseSrvResponse_t RsaNoPaddEncrypt
+hseSrvResponse_t RsaNoPaddEncryptCtx
 (
+    const hseCtx_t* pCtx,
     hseKeyHandle_t keyHandle,
     uint32_t plaintextLength,
     const uint8_t *pPlaintext,
@@ -247,13 +247,19 @@ hseSrvResponse_t RsaNoPaddEncrypt
     hseRsaCipherScheme_t rsaScheme;
     rsaScheme.rsaAlgo = HSE_RSA_ALGO_NO_PADDING;
 
-    return RsaCipherReq(HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength, (HOST_ADDR)pPlaintext,
-                        (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength,
+                           (HOST_ADDR)pPlaintext, (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaNoPaddEncrypt,
+    (hseKeyHandle_t keyHandle, uint32_t plaintextLength, const uint8_t *pPlaintext,
+     uint32_t *pCiphertextLength, uint8_t *pCiphertext),
+    (keyHandle, plaintextLength, pPlaintext, pCiphertextLength, pCiphertext))
+
 /* HSE_RSA_ALGO_RSAES_OAEP */
-hseSrvResponse_t RsaOaepEncrypt
+hseSrvResponse_t RsaOaepEncryptCtx
 (
+    const hseCtx_t* pCtx,
     hseHashAlgo_t hashAlgo,
     uint32_t labelLength,
     uint8_t *pLabel,
@@ -270,15 +276,20 @@ hseSrvResponse_t RsaOaepEncrypt
     rsaScheme.sch.rsaOAEP.labelLength = labelLength;
     rsaScheme.sch.rsaOAEP.pLabel = (HOST_ADDR)pLabel;
 
-    return RsaCipherReq(HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength, (HOST_ADDR)pPlaintext,
-                        (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength,
+                           (HOST_ADDR)pPlaintext, (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaOaepEncrypt,
+    (hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel, hseKeyHandle_t keyHandle,
+     uint32_t plaintextLength, const uint8_t *pPlaintext, uint32_t *pCiphertextLength, uint8_t *pCiphertext),
+    (hashAlgo, labelLength, pLabel, keyHandle, plaintextLength, pPlaintext, pCiphertextLength, pCiphertext))
+
 /* HSE_RSA_ALGO_RSAES_PKCS1_V15 */
-hseSrvResponse_t RsaPkcs1V15Encrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                    uint32_t labelLength, uint8_t *pLabel,
-                                    uint32_t plaintextLength, const uint8_t *pPlaintext, 
-                                    uint32_t *pCiphertextLength, uint8_t *pCiphertext)
+hseSrvResponse_t RsaPkcs1V15EncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t labelLength, uint8_t *pLabel, uint32_t plaintextLength,
+                                       const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                                       uint8_t *pCiphertext)
 {
     hseRsaCipherScheme_t rsaScheme;
     rsaScheme.rsaAlgo = HSE_RSA_ALGO_RSAES_PKCS1_V15;
@@ -289,14 +300,18 @@ hseSrvResponse_t RsaPkcs1V15Encrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hash
        rsaScheme.sch.rsaOAEP.pLabel = (HOST_ADDR)pLabel; 
     }
 
-    return RsaCipherReq(HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength, (HOST_ADDR)pPlaintext,
-                        (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_ENCRYPT, rsaScheme, keyHandle, plaintextLength,
+                           (HOST_ADDR)pPlaintext, (HOST_ADDR)pCiphertextLength, (HOST_ADDR)pCiphertext);
 }
 
-hseSrvResponse_t RsaPkcs1V15Decrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                    uint32_t labelLength, uint8_t *pLabel,
-                                    uint32_t ciphertextLength, uint8_t *pCiphertext, 
-                                    uint32_t *pPlaintextLength, uint8_t *pPlaintext)
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPkcs1V15Encrypt,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel,
+     uint32_t plaintextLength, const uint8_t *pPlaintext, uint32_t *pCiphertextLength, uint8_t *pCiphertext),
+    (keyHandle, hashAlgo, labelLength, pLabel, plaintextLength, pPlaintext, pCiphertextLength, pCiphertext))
+
+hseSrvResponse_t RsaPkcs1V15DecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t labelLength, uint8_t *pLabel, uint32_t ciphertextLength,
+                                       uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext)
 {
     hseRsaCipherScheme_t rsaScheme;
     rsaScheme.rsaAlgo = HSE_RSA_ALGO_RSAES_PKCS1_V15;
@@ -307,10 +322,15 @@ hseSrvResponse_t RsaPkcs1V15Decrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hash
        rsaScheme.sch.rsaOAEP.pLabel = (HOST_ADDR)pLabel; 
     }
 
-    return RsaCipherReq(HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength, (HOST_ADDR)pCiphertext,
-                        (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength,
+                           (HOST_ADDR)pCiphertext, (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPkcs1V15Decrypt,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel,
+     uint32_t ciphertextLength, uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext),
+    (keyHandle, hashAlgo, labelLength, pLabel, ciphertextLength, pCiphertext, pPlaintextLength, pPlaintext))
+
 hseSrvResponse_t RsaPkcs1v15DecryptAsyncSrv(hseKeyHandle_t keyHandle,
                                             uint32_t ciphertextLength, const uint8_t *pCiphertext,
                                             uint32_t *pPlaintextLength, uint8_t *pPlaintext,
@@ -326,8 +346,9 @@ hseSrvResponse_t RsaPkcs1v15DecryptAsyncSrv(hseKeyHandle_t keyHandle,
 }
 
 /* HSE_RSA_ALGO_NO_PADDING */
-hseSrvResponse_t RsaNoPaddDecrypt
+hseSrvResponse_t RsaNoPaddDecryptCtx
 (
+    const hseCtx_t* pCtx,
     hseKeyHandle_t keyHandle,
     uint32_t ciphertextLength,
     const uint8_t *pCiphertext,
@@ -338,13 +359,19 @@ hseSrvResponse_t RsaNoPaddDecrypt
     hseRsaCipherScheme_t rsaScheme;
     rsaScheme.rsaAlgo = HSE_RSA_ALGO_NO_PADDING;
 
-    return RsaCipherReq(HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength, (HOST_ADDR)pCiphertext,
-                        (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength,
+                           (HOST_ADDR)pCiphertext, (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaNoPaddDecrypt,
+    (hseKeyHandle_t keyHandle, uint32_t ciphertextLength, const uint8_t *pCiphertext,
+     uint32_t *pPlaintextLength, uint8_t *pPlaintext),
+    (keyHandle, ciphertextLength, pCiphertext, pPlaintextLength, pPlaintext))
+
 /* HSE_RSA_ALGO_RSAES_OAEP */
-hseSrvResponse_t RsaOaepDecrypt
+hseSrvResponse_t RsaOaepDecryptCtx
 (
+    const hseCtx_t* pCtx,
     hseHashAlgo_t hashAlgo,
     uint32_t labelLength,
     uint8_t *pLabel,
@@ -361,10 +388,15 @@ hseSrvResponse_t RsaOaepDecrypt
     rsaScheme.sch.rsaOAEP.labelLength = labelLength;
     rsaScheme.sch.rsaOAEP.pLabel = (HOST_ADDR)pLabel;
 
-    return RsaCipherReq(HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength, (HOST_ADDR)pCiphertext,
-                        (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
+    return RsaCipherReqCtx(pCtx, HSE_CIPHER_DIR_DECRYPT, rsaScheme, keyHandle, ciphertextLength,
+                           (HOST_ADDR)pCiphertext, (HOST_ADDR)pPlaintextLength, (HOST_ADDR)pPlaintext);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaOaepDecrypt,
+    (hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel, hseKeyHandle_t keyHandle,
+     uint32_t ciphertextLength, uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext),
+    (hashAlgo, labelLength, pLabel, keyHandle, ciphertextLength, pCiphertext, pPlaintextLength, pPlaintext))
+
 #endif /* HSE_SPT_RSA */
 
 #ifdef __cplusplus
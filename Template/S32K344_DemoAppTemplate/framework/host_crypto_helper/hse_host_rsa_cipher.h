@@ -15,6 +15,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_interface.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -57,21 +58,49 @@ hseSrvResponse_t GenerateRsaPreMasterTLS(hseKeyHandle_t* targetKeyHandle);
 hseSrvResponse_t RsaEncrypt(hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle,
                             uint32_t plaintextLength, uint8_t *pPlaintext,
                             uint32_t *pCiphertextLength, uint8_t *pCiphertext);
+hseSrvResponse_t RsaEncryptCtx(const hseCtx_t* pCtx, hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle,
+                               uint32_t plaintextLength, uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                               uint8_t *pCiphertext);
+hseSrvResponse_t RsaEncryptAsync(hseTxOptions_t txOptions, hseRsaCipherScheme_t rsaScheme,
+                                 hseKeyHandle_t keyHandle, uint32_t plaintextLength, uint8_t *pPlaintext,
+                                 uint32_t *pCiphertextLength, uint8_t *pCiphertext);
 
 /* Specific */
 hseSrvResponse_t RsaNoPaddEncrypt(hseKeyHandle_t keyHandle, uint32_t plaintextLength,
                                   const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
                                   uint8_t *pCiphertext);
+hseSrvResponse_t RsaNoPaddEncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t plaintextLength,
+                                     const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                                     uint8_t *pCiphertext);
+hseSrvResponse_t RsaNoPaddEncryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                       uint32_t plaintextLength, const uint8_t *pPlaintext,
+                                       uint32_t *pCiphertextLength, uint8_t *pCiphertext);
 
 hseSrvResponse_t RsaOaepEncrypt(hseHashAlgo_t hashAlgo, uint32_t labelLength,
                                 uint8_t *pLabel, hseKeyHandle_t keyHandle,
                                 uint32_t plaintextLength, const uint8_t *pPlaintext,
                                 uint32_t *pCiphertextLength, uint8_t *pCiphertext);
+hseSrvResponse_t RsaOaepEncryptCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t labelLength,
+                                   uint8_t *pLabel, hseKeyHandle_t keyHandle, uint32_t plaintextLength,
+                                   const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                                   uint8_t *pCiphertext);
+hseSrvResponse_t RsaOaepEncryptAsync(hseTxOptions_t txOptions, hseHashAlgo_t hashAlgo, uint32_t labelLength,
+                                     uint8_t *pLabel, hseKeyHandle_t keyHandle, uint32_t plaintextLength,
+                                     const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                                     uint8_t *pCiphertext);
 
 hseSrvResponse_t RsaPkcs1V15Encrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                     uint32_t labelLength, uint8_t *pLabel,
                                     uint32_t plaintextLength, const uint8_t *pPlaintext, 
                                     uint32_t *pCiphertextLength, uint8_t *pCiphertext);
+hseSrvResponse_t RsaPkcs1V15EncryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t labelLength, uint8_t *pLabel, uint32_t plaintextLength,
+                                       const uint8_t *pPlaintext, uint32_t *pCiphertextLength,
+                                       uint8_t *pCiphertext);
+hseSrvResponse_t RsaPkcs1V15EncryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                         hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel,
+                                         uint32_t plaintextLength, const uint8_t *pPlaintext,
+                                         uint32_t *pCiphertextLength, uint8_t *pCiphertext);
 
 hseSrvResponse_t RsaPkcs1v15DecryptAsyncSrv(hseKeyHandle_t keyHandle,
                                             uint32_t ciphertextLength, const uint8_t *pCiphertext,
@@ -83,21 +112,47 @@ hseSrvResponse_t RsaPkcs1v15DecryptAsyncSrv(hseKeyHandle_t keyHandle,
 hseSrvResponse_t RsaDecrypt(hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle,
                             uint32_t ciphertextLength, uint8_t *pCiphertext,
                             uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaDecryptCtx(const hseCtx_t* pCtx, hseRsaCipherScheme_t rsaScheme, hseKeyHandle_t keyHandle,
+                               uint32_t ciphertextLength, uint8_t *pCiphertext, uint32_t *pPlaintextLength,
+                               uint8_t *pPlaintext);
+hseSrvResponse_t RsaDecryptAsync(hseTxOptions_t txOptions, hseRsaCipherScheme_t rsaScheme,
+                                 hseKeyHandle_t keyHandle, uint32_t ciphertextLength, uint8_t *pCiphertext,
+                                 uint32_t *pPlaintextLength, uint8_t *pPlaintext);
 
 /* Specific */
 hseSrvResponse_t RsaNoPaddDecrypt(hseKeyHandle_t keyHandle, uint32_t ciphertextLength,
                                   const uint8_t *pCiphertext, uint32_t *pPlaintextLength,
                                   uint8_t *pPlaintext);
+hseSrvResponse_t RsaNoPaddDecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                     uint32_t ciphertextLength, const uint8_t *pCiphertext,
+                                     uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaNoPaddDecryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                       uint32_t ciphertextLength, const uint8_t *pCiphertext,
+                                       uint32_t *pPlaintextLength, uint8_t *pPlaintext);
 
 hseSrvResponse_t RsaOaepDecrypt(hseHashAlgo_t hashAlgo, uint32_t labelLength,
                                 uint8_t *pLabel, hseKeyHandle_t keyHandle,
                                 uint32_t ciphertextLength, const uint8_t *pCiphertext,
                                 uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaOaepDecryptCtx(const hseCtx_t* pCtx, hseHashAlgo_t hashAlgo, uint32_t labelLength,
+                                   uint8_t *pLabel, hseKeyHandle_t keyHandle, uint32_t ciphertextLength,
+                                   const uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaOaepDecryptAsync(hseTxOptions_t txOptions, hseHashAlgo_t hashAlgo, uint32_t labelLength,
+                                     uint8_t *pLabel, hseKeyHandle_t keyHandle, uint32_t ciphertextLength,
+                                     const uint8_t *pCiphertext, uint32_t *pPlaintextLength,
+                                     uint8_t *pPlaintext);
 
 hseSrvResponse_t RsaPkcs1V15Decrypt(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                     uint32_t labelLength, uint8_t *pLabel, 
                                     uint32_t ciphertextLength, uint8_t *pCiphertext, 
                                     uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaPkcs1V15DecryptCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t labelLength, uint8_t *pLabel, uint32_t ciphertextLength,
+                                       uint8_t *pCiphertext, uint32_t *pPlaintextLength, uint8_t *pPlaintext);
+hseSrvResponse_t RsaPkcs1V15DecryptAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                         hseHashAlgo_t hashAlgo, uint32_t labelLength, uint8_t *pLabel,
+                                         uint32_t ciphertextLength, uint8_t *pCiphertext,
+                                         uint32_t *pPlaintextLength, uint8_t *pPlaintext);
 
 /* ======================================================================================== */
 
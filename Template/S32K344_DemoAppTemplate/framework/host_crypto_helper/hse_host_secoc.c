@@ -0,0 +1,421 @@
+/**
+*   @file    hse_host_secoc.c
+*
+*   @brief   HSE HOST batched SecOC MAC verification.
+*   @details Keeps every free channel of all MU instances loaded with PDU verifications; each
+*            completion records its result and sends the next PDU on the channel it just freed,
+*            rewriting only the PDU fields of the descriptor.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_secoc.c
+*/
+#include <stdatomic.h>
+#include "hse_host_secoc.h"
+#include "hse_completion_ring.h"
+#include "hse_srv_builders.h"
+#include "host_stm.h"
+
+#if defined(HSE_SPT_FAST_CMAC) || defined(HSE_SPT_CMAC_WITH_COUNTER)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   PDU verified on a channel
+ */
+typedef struct
+{
+    uint8_t     u8MuInstance;
+    uint8_t     u8MuChannel;
+    bool_t      bPrepared;          /* The descriptor holds a request of this verification (channel held since) */
+    uint32_t    u32Index;
+} hseSecOcSlot_t;
+
+/* The pass bitmap words are updated with atomic OR */
+typedef uint8_t hseSecOcMapCheck_t[(sizeof(atomic_uint_least32_t) == sizeof(uint32_t)) ? 1 : -1];
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* All service channels, except channel 0 (reserved for administration services) */
+#define HSE_SECOC_CHANNEL_MASK      ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* The verification in progress */
+static const hseSecOcPdu_t*         pSecOcPdus = NULL;
+static atomic_uint_least32_t*       pSecOcPassMap = NULL;
+static uint32_t                     u32SecOcCount = 0UL;
+
+static atomic_bool                  bSecOcActive;
+static atomic_uint_least32_t        u32SecOcNext;       /* Next PDU to send */
+static atomic_uint_least32_t        u32SecOcDone;       /* PDUs processed */
+static atomic_uint_least32_t        u32SecOcFailed;     /* PDUs not verified successfully */
+static atomic_uint_least32_t        u32SecOcInFlight;   /* PDUs sent, response not received */
+
+static hseSecOcSlot_t secOcSlot[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static void HSE_SecOcRecord(uint32_t u32Index, hseSrvResponse_t status);
+static hseSrvResponse_t HSE_SecOcBuild(hseSecOcSlot_t* pSlot, const hseSecOcPdu_t* pPdu);
+static bool_t HSE_SecOcSendNext(uint8_t u8MuInstance, uint8_t u8MuChannel);
+static void HSE_SecOcComplete(hseSrvResponse_t status, void* pArg);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Record the result of a PDU; the last one ends the verification.
+ ******************************************************************************/
+static void HSE_SecOcRecord(uint32_t u32Index, hseSrvResponse_t status)
+{
+    if(HSE_SRV_RSP_OK == status)
+    {
+        (void)atomic_fetch_or(&pSecOcPassMap[u32Index / 32UL], 1UL << (u32Index % 32UL));
+    }
+    else
+    {
+        (void)atomic_fetch_add(&u32SecOcFailed, 1U);
+    }
+
+    if((atomic_fetch_add(&u32SecOcDone, 1U) + 1UL) == u32SecOcCount)
+    {
+        atomic_store(&bSecOcActive, false);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Write the request of a PDU in the descriptor of a channel.
+ *                 A descriptor already holding a request of the same service for
+ *                 this verification only gets the PDU fields rewritten.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_SecOcBuild(hseSecOcSlot_t* pSlot, const hseSecOcPdu_t* pPdu)
+{
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[pSlot->u8MuInstance][pSlot->u8MuChannel];
+
+    if(HSE_SECOC_NO_COUNTER == pPdu->u32CounterIdx)
+    {
+#ifdef HSE_SPT_FAST_CMAC
+        hseFastCMACSrv_t* pFastCmacReq = &pHseSrvDesc->hseSrv.fastCmacReq;
+
+        if(pSlot->bPrepared && (HSE_SRV_ID_FAST_CMAC == pHseSrvDesc->srvId))
+        {
+            pFastCmacReq->keyHandle      = pPdu->keyHandle;
+            pFastCmacReq->pInput         = (HOST_ADDR)pPdu->pMsg;
+            pFastCmacReq->inputBitLength = pPdu->u32MsgBitLength;
+            pFastCmacReq->tagBitLength   = pPdu->u8TagBitLength;
+            pFastCmacReq->pTag           = (HOST_ADDR)pPdu->pTag;
+        }
+        else
+        {
+            HSE_BuildFastCmacReq(pHseSrvDesc, HSE_AUTH_DIR_VERIFY, pPdu->keyHandle, pPdu->u32MsgBitLength,
+                                 pPdu->pMsg, pPdu->u8TagBitLength, pPdu->pTag);
+        }
+#else
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+#endif /* HSE_SPT_FAST_CMAC */
+    }
+    else
+    {
+#ifdef HSE_SPT_CMAC_WITH_COUNTER
+        hseCmacWithCounterSrv_t* pCmacReq = &pHseSrvDesc->hseSrv.cmacWithCounterReq;
+
+        if(pSlot->bPrepared && (HSE_SRV_ID_CMAC_WITH_COUNTER == pHseSrvDesc->srvId))
+        {
+            pCmacReq->keyHandle        = pPdu->keyHandle;
+            pCmacReq->counterIdx       = pPdu->u32CounterIdx;
+            pCmacReq->RPOffset         = pPdu->u8RpOffset;
+            pCmacReq->inputBitLength   = pPdu->u32MsgBitLength;
+            pCmacReq->pInput           = (HOST_ADDR)pPdu->pMsg;
+            pCmacReq->tagBitLength     = pPdu->u8TagBitLength;
+            pCmacReq->pTag             = (HOST_ADDR)pPdu->pTag;
+            pCmacReq->pVolatileCounter = (HOST_ADDR)pPdu->pVolatileCounter;
+        }
+        else
+        {
+            HSE_BuildCmacWithCounterReq(pHseSrvDesc, HSE_AUTH_DIR_VERIFY, pPdu->keyHandle, pPdu->u32CounterIdx,
+                                        pPdu->u8RpOffset, HSE_SGT_OPTION_NONE, pPdu->u32MsgBitLength,
+                                        pPdu->pMsg, pPdu->u8TagBitLength, pPdu->pTag, pPdu->pVolatileCounter);
+        }
+#else
+        return HSE_SRV_RSP_NOT_SUPPORTED;
+#endif /* HSE_SPT_CMAC_WITH_COUNTER */
+    }
+
+    pSlot->bPrepared = TRUE;
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Send the next PDU on a channel of the MU: u8MuChannel, the held
+ *                 channel whose response was just received (its descriptor is
+ *                 reused), or a newly claimed channel with HSE_INVALID_CHANNEL.
+ *                 The channel is held until no PDU is left, so no other request
+ *                 can overwrite the prepared descriptor between two PDUs.
+ *                 Returns FALSE if no channel is free or all PDUs were sent.
+ ******************************************************************************/
+static bool_t HSE_SecOcSendNext(uint8_t u8MuInstance, uint8_t u8MuChannel)
+{
+    hseSecOcSlot_t* pSlot;
+    hseTxOptions_t txOptions;
+    hseSrvResponse_t status;
+    uint32_t u32Index;
+
+    if(HSE_INVALID_CHANNEL == u8MuChannel)
+    {
+        if(atomic_load(&u32SecOcNext) >= u32SecOcCount)
+        {
+            return FALSE;
+        }
+        u8MuChannel = HSE_ChannelClaim(u8MuInstance);
+        if(HSE_INVALID_CHANNEL == u8MuChannel)
+        {
+            return FALSE;
+        }
+        HSE_ChannelHold(u8MuInstance, u8MuChannel);
+        /* The descriptor may have been used by another request since */
+        secOcSlot[u8MuInstance][u8MuChannel].bPrepared = FALSE;
+    }
+
+    pSlot = &secOcSlot[u8MuInstance][u8MuChannel];
+    pSlot->u8MuInstance = u8MuInstance;
+    pSlot->u8MuChannel  = u8MuChannel;
+
+    /* Take the PDU only once the channel is owned; skip the PDUs that cannot be built */
+    for(;;)
+    {
+        u32Index = atomic_fetch_add(&u32SecOcNext, 1U);
+        if(u32Index >= u32SecOcCount)
+        {
+            HSE_ChannelUnhold(u8MuInstance, u8MuChannel);
+            return FALSE;
+        }
+        if(HSE_SRV_RSP_OK == HSE_SecOcBuild(pSlot, &pSecOcPdus[u32Index]))
+        {
+            break;
+        }
+        HSE_SecOcRecord(u32Index, HSE_SRV_RSP_NOT_SUPPORTED);
+    }
+    pSlot->u32Index = u32Index;
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_SecOcComplete;
+    txOptions.pCallbackpArg   = (void*)pSlot;
+
+    (void)atomic_fetch_add(&u32SecOcInFlight, 1U);
+    status = HSE_SendOnClaimed(u8MuInstance, u8MuChannel, txOptions, &gHseSrvDesc[u8MuInstance][u8MuChannel],
+                               HSE_WAIT_DEFAULT_TIMEOUT_US);
+    if(HSE_SRV_RSP_OK != status)
+    {
+        /* Busy in hardware (HSE_SRV_RSP_HOST_CHANNEL_BUSY): the PDU is reported failed */
+        pSlot->bPrepared = FALSE;
+        HSE_ChannelUnhold(u8MuInstance, u8MuChannel);
+        (void)atomic_fetch_sub(&u32SecOcInFlight, 1U);
+        HSE_SecOcRecord(u32Index, status);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Completion callback (MU RX interrupt or HSE_PollCompletions).
+ ******************************************************************************/
+static void HSE_SecOcComplete(hseSrvResponse_t status, void* pArg)
+{
+    hseSecOcSlot_t* pSlot = (hseSecOcSlot_t*)pArg;
+    uint32_t u32Index = pSlot->u32Index;
+
+    /* Count the next PDU in flight before this one is done, so the waiter never sees a stall */
+    (void)HSE_SecOcSendNext(pSlot->u8MuInstance, pSlot->u8MuChannel);
+    (void)atomic_fetch_sub(&u32SecOcInFlight, 1U);
+    HSE_SecOcRecord(u32Index, status);
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Start the verification of a list of PDUs on all free channels.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SecOcVerifyStart(const hseSecOcPdu_t* pPdus, uint32_t u32Count, uint32_t* pu32PassMap)
+{
+    uint8_t u8MuInstance;
+    uint8_t u8MuChannel;
+    uint32_t u32Word;
+    bool_t bScheduled;
+    bool expected = false;
+
+    if((NULL == pPdus) || (NULL == pu32PassMap) || (0UL == u32Count))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(!atomic_compare_exchange_strong(&bSecOcActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    pSecOcPdus    = pPdus;
+    pSecOcPassMap = (atomic_uint_least32_t*)pu32PassMap;
+    u32SecOcCount = u32Count;
+    for(u32Word = 0UL; u32Word < HSE_SECOC_PASS_MAP_WORDS(u32Count); u32Word++)
+    {
+        atomic_store(&pSecOcPassMap[u32Word], 0U);
+    }
+    atomic_store(&u32SecOcNext, 0U);
+    atomic_store(&u32SecOcDone, 0U);
+    atomic_store(&u32SecOcFailed, 0U);
+    atomic_store(&u32SecOcInFlight, 0U);
+
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        for(u8MuChannel = 0U; u8MuChannel < HSE_NUM_OF_CHANNELS_PER_MU; u8MuChannel++)
+        {
+            secOcSlot[u8MuInstance][u8MuChannel].bPrepared = FALSE;
+        }
+        /* Completions are driven by the RX interrupt */
+        HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HSE_SECOC_CHANNEL_MASK);
+    }
+
+    /* Fill one channel per MU at a time, so the load is spread over all MU instances */
+    do
+    {
+        bScheduled = FALSE;
+        for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+        {
+            if(HSE_SecOcSendNext(u8MuInstance, HSE_INVALID_CHANNEL))
+            {
+                bScheduled = TRUE;
+            }
+        }
+    } while(bScheduled);
+
+    if((0UL == atomic_load(&u32SecOcInFlight)) && atomic_load(&bSecOcActive))
+    {
+        /* Nothing could be sent and not all PDUs were rejected */
+        atomic_store(&bSecOcActive, false);
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Wait for the verification in progress to complete.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SecOcWait(uint32_t u32TimeoutUs, uint32_t* pu32Failed)
+{
+    uint8_t u8MuInstance;
+    uint32_t u32Start;
+    uint32_t u32ElapsedUs;
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    while(atomic_load(&bSecOcActive))
+    {
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        /* No channel was free for the remaining PDUs: restart from a free one */
+        if(0UL == atomic_load(&u32SecOcInFlight))
+        {
+            for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+            {
+                (void)HSE_SecOcSendNext(u8MuInstance, HSE_INVALID_CHANNEL);
+            }
+        }
+
+        /* The timebase is read on every pass, also without timeout (the host emulation yields there) */
+        u32ElapsedUs = GetStmTimebaseUs() - u32Start;
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && (u32ElapsedUs >= u32TimeoutUs))
+        {
+            return HSE_SRV_RSP_HOST_TIMEOUT;
+        }
+    }
+
+    if(NULL != pu32Failed)
+    {
+        *pu32Failed = atomic_load(&u32SecOcFailed);
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Verify a list of PDUs and wait for the result.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SecOcVerify(const hseSecOcPdu_t* pPdus, uint32_t u32Count, uint32_t* pu32PassMap,
+                                 uint32_t u32TimeoutUs, uint32_t* pu32Failed)
+{
+    hseSrvResponse_t status = HSE_SecOcVerifyStart(pPdus, u32Count, pu32PassMap);
+
+    if(HSE_SRV_RSP_OK == status)
+    {
+        status = HSE_SecOcWait(u32TimeoutUs, pu32Failed);
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Check whether a verification is in progress.
+ ******************************************************************************/
+bool_t HSE_SecOcIsActive(void)
+{
+    return atomic_load(&bSecOcActive) ? TRUE : FALSE;
+}
+
+#endif /* defined(HSE_SPT_FAST_CMAC) || defined(HSE_SPT_CMAC_WITH_COUNTER) */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,157 @@
+/**
+*   @file    hse_host_secoc.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST batched SecOC MAC verification.
+*   @details Verifies a list of authenticated PDUs (FAST CMAC, or CMAC with counter) on all free
+*            channels of all MU instances and reports the result of each PDU in a pass bitmap.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_SECOC_H
+#define HSE_HOST_SECOC_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_secoc.h
+*/
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* u32CounterIdx of a PDU verified with FAST CMAC (no freshness counter) */
+#define HSE_SECOC_NO_COUNTER            (0xFFFFFFFFUL)
+
+/* Number of 32-bit words of the pass bitmap of u32Count PDUs */
+#define HSE_SECOC_PASS_MAP_WORDS(u32Count)  (((u32Count) + 31UL) / 32UL)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   An authenticated PDU to verify
+ */
+typedef struct
+{
+    hseKeyHandle_t      keyHandle;          /**< @brief    The CMAC key. */
+    const uint8_t*      pMsg;               /**< @brief    The authenticated data. */
+    uint32_t            u32MsgBitLength;    /**< @brief    The authenticated data length in bits. */
+    const uint8_t*      pTag;               /**< @brief    The (truncated) MAC. */
+    uint8_t             u8TagBitLength;     /**< @brief    The MAC length in bits. */
+    uint8_t             u8RpOffset;         /**< @brief    CMAC with counter: rollover protection offset. */
+    uint32_t            u32CounterIdx;      /**< @brief    CMAC with counter: the secure counter, or HSE_SECOC_NO_COUNTER. */
+    const uint32_t*     pVolatileCounter;   /**< @brief    CMAC with counter: the volatile counter bits of the PDU. */
+} hseSecOcPdu_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#if defined(HSE_SPT_FAST_CMAC) || defined(HSE_SPT_CMAC_WITH_COUNTER)
+/**
+* @brief        Start the verification of a list of PDUs.
+* @details      Claims every free channel of all MU instances and keeps them loaded: each
+*               completion (MU RX interrupt, or HSE_PollCompletions() with deferred completions)
+*               records the result of its PDU and sends the next PDU on the same channel. The
+*               channels are held (HSE_ChannelHold()) until no PDU is left, so the descriptor of a
+*               channel is built once and only the fields of the PDU are rewritten for the following
+*               PDUs. Only one verification can be in progress at a time.
+*
+* @param[in]    pPdus           The PDUs. Must stay valid until the verification completed.
+* @param[in]    u32Count        Number of PDUs (> 0).
+* @param[out]   pu32PassMap     HSE_SECOC_PASS_MAP_WORDS(u32Count) words: bit (i % 32) of word
+*                               (i / 32) is set if PDU i was verified successfully.
+*                               Valid once the verification completed.
+*
+* @return       HSE_SRV_RSP_OK if the verification was started,
+*               HSE_SRV_RSP_INVALID_PARAM if a parameter is invalid,
+*               HSE_SRV_RSP_NOT_ALLOWED if another verification is in progress,
+*               HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel is free.
+*/
+hseSrvResponse_t HSE_SecOcVerifyStart(const hseSecOcPdu_t* pPdus, uint32_t u32Count, uint32_t* pu32PassMap);
+
+/**
+* @brief        Wait for the verification in progress to complete.
+*
+* @param[in]    u32TimeoutUs    The timeout in microseconds, or HSE_WAIT_INFINITE.
+* @param[out]   pu32Failed      Number of PDUs not verified successfully (can be NULL).
+*
+* @return       HSE_SRV_RSP_OK once all PDUs were processed (see the pass bitmap),
+*               HSE_SRV_RSP_HOST_TIMEOUT if the verification did not complete in time (it keeps running).
+*/
+hseSrvResponse_t HSE_SecOcWait(uint32_t u32TimeoutUs, uint32_t* pu32Failed);
+
+/**
+* @brief        Verify a list of PDUs (HSE_SecOcVerifyStart() + HSE_SecOcWait()).
+*
+* @param[in]    pPdus           The PDUs.
+* @param[in]    u32Count        Number of PDUs (> 0).
+* @param[out]   pu32PassMap     The pass bitmap (see HSE_SecOcVerifyStart()).
+* @param[in]    u32TimeoutUs    The timeout in microseconds, or HSE_WAIT_INFINITE.
+* @param[out]   pu32Failed      Number of PDUs not verified successfully (can be NULL).
+*
+* @return       See HSE_SecOcVerifyStart() and HSE_SecOcWait().
+*/
+hseSrvResponse_t HSE_SecOcVerify(const hseSecOcPdu_t* pPdus, uint32_t u32Count, uint32_t* pu32PassMap,
+                                 uint32_t u32TimeoutUs, uint32_t* pu32Failed);
+
+/**
+* @brief        Check whether a verification is in progress.
+*
+* @return       TRUE if PDUs are queued or in flight, FALSE otherwise.
+*/
+bool_t HSE_SecOcIsActive(void);
+#endif /* defined(HSE_SPT_FAST_CMAC) || defined(HSE_SPT_CMAC_WITH_COUNTER) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_SECOC_H */
+
+/** @} */
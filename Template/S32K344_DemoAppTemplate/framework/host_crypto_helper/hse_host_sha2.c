@@ -0,0 +1,448 @@
+/**
+*   @file    hse_host_sha2.c
+*
+*   @brief   Host CPU SHA-256/SHA-512.
+*   @details Compression functions unrolled by 8 rounds (the working variables rotate through the
+*            round macro arguments instead of being moved), with the message schedule kept in a
+*            16-word circular buffer so it stays in registers/DTCM on the Cortex-M7.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_sha2.c
+*/
+#include "hse_host_sha2.h"
+#include "string.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Known answer test
+ */
+typedef struct
+{
+    bool_t          bSha512;
+    const char*     pMessage;
+    uint8_t         au8Digest[HOST_SHA512_DIGEST_LENGTH];
+} hostSha2Kat_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define ROTR32(x, n)    (((x) >> (n)) | ((x) << (32U - (n))))
+#define ROTR64(x, n)    (((x) >> (n)) | ((x) << (64U - (n))))
+
+#define CH(x, y, z)     (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define SHA256_S0(x)    (ROTR32((x), 2U) ^ ROTR32((x), 13U) ^ ROTR32((x), 22U))
+#define SHA256_S1(x)    (ROTR32((x), 6U) ^ ROTR32((x), 11U) ^ ROTR32((x), 25U))
+#define SHA256_s0(x)    (ROTR32((x), 7U) ^ ROTR32((x), 18U) ^ ((x) >> 3U))
+#define SHA256_s1(x)    (ROTR32((x), 17U) ^ ROTR32((x), 19U) ^ ((x) >> 10U))
+
+#define SHA512_S0(x)    (ROTR64((x), 28U) ^ ROTR64((x), 34U) ^ ROTR64((x), 39U))
+#define SHA512_S1(x)    (ROTR64((x), 14U) ^ ROTR64((x), 18U) ^ ROTR64((x), 41U))
+#define SHA512_s0(x)    (ROTR64((x), 1U) ^ ROTR64((x), 8U) ^ ((x) >> 7U))
+#define SHA512_s1(x)    (ROTR64((x), 19U) ^ ROTR64((x), 61U) ^ ((x) >> 6U))
+
+/* Next word of the message schedule, in place in the 16-word circular buffer W */
+#define SHA_SCHEDULE(W, s0, s1, i)                                                      \
+    ((W)[(i) & 15U] += s1((W)[((i) - 2U) & 15U]) + (W)[((i) - 7U) & 15U] + s0((W)[((i) - 15U) & 15U]))
+
+/* One round; the caller rotates the roles of a..h instead of moving the variables */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, k, w)                                      \
+    do {                                                                                \
+        uint32_t t1 = (h) + SHA256_S1(e) + CH((e), (f), (g)) + (k) + (w);               \
+        (d) += t1;                                                                      \
+        (h)  = t1 + SHA256_S0(a) + MAJ((a), (b), (c));                                  \
+    } while(0)
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, k, w)                                      \
+    do {                                                                                \
+        uint64_t t1 = (h) + SHA512_S1(e) + CH((e), (f), (g)) + (k) + (w);               \
+        (d) += t1;                                                                      \
+        (h)  = t1 + SHA512_S0(a) + MAJ((a), (b), (c));                                  \
+    } while(0)
+
+#define SHA256_BLOCK_LENGTH     (64UL)
+#define SHA512_BLOCK_LENGTH     (128UL)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+static const uint32_t sha256K[64] =
+{
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+    0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+    0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+    0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+    0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+    0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+    0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL,
+};
+
+static const uint32_t sha256Iv[8] =
+{
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL,
+};
+
+static const uint64_t sha512K[80] =
+{
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint64_t sha512Iv[8] =
+{
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+/* Known answer tests (FIPS 180-4 examples) */
+static const hostSha2Kat_t hostSha2Kat[] =
+{
+    /* SHA-256, empty message */
+    { FALSE, "",
+      {
+        0xe3U, 0xb0U, 0xc4U, 0x42U, 0x98U, 0xfcU, 0x1cU, 0x14U, 0x9aU, 0xfbU, 0xf4U, 0xc8U, 0x99U, 0x6fU, 0xb9U, 0x24U,
+        0x27U, 0xaeU, 0x41U, 0xe4U, 0x64U, 0x9bU, 0x93U, 0x4cU, 0xa4U, 0x95U, 0x99U, 0x1bU, 0x78U, 0x52U, 0xb8U, 0x55U,
+      } },
+    /* SHA-256, one block */
+    { FALSE, "abc",
+      {
+        0xbaU, 0x78U, 0x16U, 0xbfU, 0x8fU, 0x01U, 0xcfU, 0xeaU, 0x41U, 0x41U, 0x40U, 0xdeU, 0x5dU, 0xaeU, 0x22U, 0x23U,
+        0xb0U, 0x03U, 0x61U, 0xa3U, 0x96U, 0x17U, 0x7aU, 0x9cU, 0xb4U, 0x10U, 0xffU, 0x61U, 0xf2U, 0x00U, 0x15U, 0xadU,
+      } },
+    /* SHA-256, padding in a second block */
+    { FALSE, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+      {
+        0x24U, 0x8dU, 0x6aU, 0x61U, 0xd2U, 0x06U, 0x38U, 0xb8U, 0xe5U, 0xc0U, 0x26U, 0x93U, 0x0cU, 0x3eU, 0x60U, 0x39U,
+        0xa3U, 0x3cU, 0xe4U, 0x59U, 0x64U, 0xffU, 0x21U, 0x67U, 0xf6U, 0xecU, 0xedU, 0xd4U, 0x19U, 0xdbU, 0x06U, 0xc1U,
+      } },
+    /* SHA-512, empty message */
+    { TRUE, "",
+      {
+        0xcfU, 0x83U, 0xe1U, 0x35U, 0x7eU, 0xefU, 0xb8U, 0xbdU, 0xf1U, 0x54U, 0x28U, 0x50U, 0xd6U, 0x6dU, 0x80U, 0x07U,
+        0xd6U, 0x20U, 0xe4U, 0x05U, 0x0bU, 0x57U, 0x15U, 0xdcU, 0x83U, 0xf4U, 0xa9U, 0x21U, 0xd3U, 0x6cU, 0xe9U, 0xceU,
+        0x47U, 0xd0U, 0xd1U, 0x3cU, 0x5dU, 0x85U, 0xf2U, 0xb0U, 0xffU, 0x83U, 0x18U, 0xd2U, 0x87U, 0x7eU, 0xecU, 0x2fU,
+        0x63U, 0xb9U, 0x31U, 0xbdU, 0x47U, 0x41U, 0x7aU, 0x81U, 0xa5U, 0x38U, 0x32U, 0x7aU, 0xf9U, 0x27U, 0xdaU, 0x3eU,
+      } },
+    /* SHA-512, one block */
+    { TRUE, "abc",
+      {
+        0xddU, 0xafU, 0x35U, 0xa1U, 0x93U, 0x61U, 0x7aU, 0xbaU, 0xccU, 0x41U, 0x73U, 0x49U, 0xaeU, 0x20U, 0x41U, 0x31U,
+        0x12U, 0xe6U, 0xfaU, 0x4eU, 0x89U, 0xa9U, 0x7eU, 0xa2U, 0x0aU, 0x9eU, 0xeeU, 0xe6U, 0x4bU, 0x55U, 0xd3U, 0x9aU,
+        0x21U, 0x92U, 0x99U, 0x2aU, 0x27U, 0x4fU, 0xc1U, 0xa8U, 0x36U, 0xbaU, 0x3cU, 0x23U, 0xa3U, 0xfeU, 0xebU, 0xbdU,
+        0x45U, 0x4dU, 0x44U, 0x23U, 0x64U, 0x3cU, 0xe8U, 0x0eU, 0x2aU, 0x9aU, 0xc9U, 0x4fU, 0xa5U, 0x4cU, 0xa4U, 0x9fU,
+      } },
+    /* SHA-512, padding in a second block */
+    { TRUE, "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+      "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+      {
+        0x8eU, 0x95U, 0x9bU, 0x75U, 0xdaU, 0xe3U, 0x13U, 0xdaU, 0x8cU, 0xf4U, 0xf7U, 0x28U, 0x14U, 0xfcU, 0x14U, 0x3fU,
+        0x8fU, 0x77U, 0x79U, 0xc6U, 0xebU, 0x9fU, 0x7fU, 0xa1U, 0x72U, 0x99U, 0xaeU, 0xadU, 0xb6U, 0x88U, 0x90U, 0x18U,
+        0x50U, 0x1dU, 0x28U, 0x9eU, 0x49U, 0x00U, 0xf7U, 0xe4U, 0x33U, 0x1bU, 0x99U, 0xdeU, 0xc4U, 0xb5U, 0x43U, 0x3aU,
+        0xc7U, 0xd3U, 0x29U, 0xeeU, 0xb6U, 0xddU, 0x26U, 0x54U, 0x5eU, 0x96U, 0xe5U, 0x5bU, 0x87U, 0x4bU, 0xe9U, 0x09U,
+      } },
+};
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static inline uint32_t HostSha2Load32(const uint8_t* p);
+static inline uint64_t HostSha2Load64(const uint8_t* p);
+static inline void HostSha2Store32(uint8_t* p, uint32_t x);
+static inline void HostSha2Store64(uint8_t* p, uint64_t x);
+static void HostSha256Blocks(uint32_t* pState, const uint8_t* pInput, uint32_t u32Blocks);
+static void HostSha512Blocks(uint64_t* pState, const uint8_t* pInput, uint32_t u32Blocks);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/* Big endian loads/stores; byte accesses, as the input may be unaligned (compiled to LDR + REV) */
+static inline uint32_t HostSha2Load32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24U) | ((uint32_t)p[1] << 16U) | ((uint32_t)p[2] << 8U) | (uint32_t)p[3];
+}
+
+static inline uint64_t HostSha2Load64(const uint8_t* p)
+{
+    return ((uint64_t)HostSha2Load32(p) << 32U) | (uint64_t)HostSha2Load32(&p[4]);
+}
+
+static inline void HostSha2Store32(uint8_t* p, uint32_t x)
+{
+    p[0] = (uint8_t)(x >> 24U);
+    p[1] = (uint8_t)(x >> 16U);
+    p[2] = (uint8_t)(x >> 8U);
+    p[3] = (uint8_t)x;
+}
+
+static inline void HostSha2Store64(uint8_t* p, uint64_t x)
+{
+    HostSha2Store32(p, (uint32_t)(x >> 32U));
+    HostSha2Store32(&p[4], (uint32_t)x);
+}
+
+/*******************************************************************************
+ * Description   : SHA-256 compression of u32Blocks 64-byte blocks.
+ ******************************************************************************/
+static void HostSha256Blocks(uint32_t* pState, const uint8_t* pInput, uint32_t u32Blocks)
+{
+    uint32_t W[16];
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t i;
+
+    while(u32Blocks-- > 0UL)
+    {
+        a = pState[0]; b = pState[1]; c = pState[2]; d = pState[3];
+        e = pState[4]; f = pState[5]; g = pState[6]; h = pState[7];
+
+        for(i = 0UL; i < 16UL; i += 8UL)
+        {
+            W[i]     = HostSha2Load32(&pInput[4UL * i]);
+            W[i + 1] = HostSha2Load32(&pInput[4UL * (i + 1UL)]);
+            W[i + 2] = HostSha2Load32(&pInput[4UL * (i + 2UL)]);
+            W[i + 3] = HostSha2Load32(&pInput[4UL * (i + 3UL)]);
+            W[i + 4] = HostSha2Load32(&pInput[4UL * (i + 4UL)]);
+            W[i + 5] = HostSha2Load32(&pInput[4UL * (i + 5UL)]);
+            W[i + 6] = HostSha2Load32(&pInput[4UL * (i + 6UL)]);
+            W[i + 7] = HostSha2Load32(&pInput[4UL * (i + 7UL)]);
+            SHA256_ROUND(a, b, c, d, e, f, g, h, sha256K[i],     W[i]);
+            SHA256_ROUND(h, a, b, c, d, e, f, g, sha256K[i + 1], W[i + 1]);
+            SHA256_ROUND(g, h, a, b, c, d, e, f, sha256K[i + 2], W[i + 2]);
+            SHA256_ROUND(f, g, h, a, b, c, d, e, sha256K[i + 3], W[i + 3]);
+            SHA256_ROUND(e, f, g, h, a, b, c, d, sha256K[i + 4], W[i + 4]);
+            SHA256_ROUND(d, e, f, g, h, a, b, c, sha256K[i + 5], W[i + 5]);
+            SHA256_ROUND(c, d, e, f, g, h, a, b, sha256K[i + 6], W[i + 6]);
+            SHA256_ROUND(b, c, d, e, f, g, h, a, sha256K[i + 7], W[i + 7]);
+        }
+        for(; i < 64UL; i += 8UL)
+        {
+            SHA256_ROUND(a, b, c, d, e, f, g, h, sha256K[i],     SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i));
+            SHA256_ROUND(h, a, b, c, d, e, f, g, sha256K[i + 1], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 1U));
+            SHA256_ROUND(g, h, a, b, c, d, e, f, sha256K[i + 2], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 2U));
+            SHA256_ROUND(f, g, h, a, b, c, d, e, sha256K[i + 3], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 3U));
+            SHA256_ROUND(e, f, g, h, a, b, c, d, sha256K[i + 4], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 4U));
+            SHA256_ROUND(d, e, f, g, h, a, b, c, sha256K[i + 5], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 5U));
+            SHA256_ROUND(c, d, e, f, g, h, a, b, sha256K[i + 6], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 6U));
+            SHA256_ROUND(b, c, d, e, f, g, h, a, sha256K[i + 7], SHA_SCHEDULE(W, SHA256_s0, SHA256_s1, i + 7U));
+        }
+
+        pState[0] += a; pState[1] += b; pState[2] += c; pState[3] += d;
+        pState[4] += e; pState[5] += f; pState[6] += g; pState[7] += h;
+        pInput = &pInput[SHA256_BLOCK_LENGTH];
+    }
+}
+
+/*******************************************************************************
+ * Description   : SHA-512 compression of u32Blocks 128-byte blocks.
+ ******************************************************************************/
+static void HostSha512Blocks(uint64_t* pState, const uint8_t* pInput, uint32_t u32Blocks)
+{
+    uint64_t W[16];
+    uint64_t a, b, c, d, e, f, g, h;
+    uint32_t i;
+
+    while(u32Blocks-- > 0UL)
+    {
+        a = pState[0]; b = pState[1]; c = pState[2]; d = pState[3];
+        e = pState[4]; f = pState[5]; g = pState[6]; h = pState[7];
+
+        for(i = 0UL; i < 16UL; i += 8UL)
+        {
+            W[i]     = HostSha2Load64(&pInput[8UL * i]);
+            W[i + 1] = HostSha2Load64(&pInput[8UL * (i + 1UL)]);
+            W[i + 2] = HostSha2Load64(&pInput[8UL * (i + 2UL)]);
+            W[i + 3] = HostSha2Load64(&pInput[8UL * (i + 3UL)]);
+            W[i + 4] = HostSha2Load64(&pInput[8UL * (i + 4UL)]);
+            W[i + 5] = HostSha2Load64(&pInput[8UL * (i + 5UL)]);
+            W[i + 6] = HostSha2Load64(&pInput[8UL * (i + 6UL)]);
+            W[i + 7] = HostSha2Load64(&pInput[8UL * (i + 7UL)]);
+            SHA512_ROUND(a, b, c, d, e, f, g, h, sha512K[i],     W[i]);
+            SHA512_ROUND(h, a, b, c, d, e, f, g, sha512K[i + 1], W[i + 1]);
+            SHA512_ROUND(g, h, a, b, c, d, e, f, sha512K[i + 2], W[i + 2]);
+            SHA512_ROUND(f, g, h, a, b, c, d, e, sha512K[i + 3], W[i + 3]);
+            SHA512_ROUND(e, f, g, h, a, b, c, d, sha512K[i + 4], W[i + 4]);
+            SHA512_ROUND(d, e, f, g, h, a, b, c, sha512K[i + 5], W[i + 5]);
+            SHA512_ROUND(c, d, e, f, g, h, a, b, sha512K[i + 6], W[i + 6]);
+            SHA512_ROUND(b, c, d, e, f, g, h, a, sha512K[i + 7], W[i + 7]);
+        }
+        for(; i < 80UL; i += 8UL)
+        {
+            SHA512_ROUND(a, b, c, d, e, f, g, h, sha512K[i],     SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i));
+            SHA512_ROUND(h, a, b, c, d, e, f, g, sha512K[i + 1], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 1U));
+            SHA512_ROUND(g, h, a, b, c, d, e, f, sha512K[i + 2], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 2U));
+            SHA512_ROUND(f, g, h, a, b, c, d, e, sha512K[i + 3], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 3U));
+            SHA512_ROUND(e, f, g, h, a, b, c, d, sha512K[i + 4], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 4U));
+            SHA512_ROUND(d, e, f, g, h, a, b, c, sha512K[i + 5], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 5U));
+            SHA512_ROUND(c, d, e, f, g, h, a, b, sha512K[i + 6], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 6U));
+            SHA512_ROUND(b, c, d, e, f, g, h, a, sha512K[i + 7], SHA_SCHEDULE(W, SHA512_s0, SHA512_s1, i + 7U));
+        }
+
+        pState[0] += a; pState[1] += b; pState[2] += c; pState[3] += d;
+        pState[4] += e; pState[5] += f; pState[6] += g; pState[7] += h;
+        pInput = &pInput[SHA512_BLOCK_LENGTH];
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : SHA-256 of a message.
+ ******************************************************************************/
+void HostSha256(const uint8_t* pInput, uint32_t u32InputLength, uint8_t* pDigest)
+{
+    uint32_t state[8];
+    uint8_t  tail[2UL * SHA256_BLOCK_LENGTH];
+    uint32_t u32Full = u32InputLength / SHA256_BLOCK_LENGTH;
+    uint32_t u32Rest = u32InputLength % SHA256_BLOCK_LENGTH;
+    uint32_t u32TailLength = (u32Rest < (SHA256_BLOCK_LENGTH - 8UL)) ? SHA256_BLOCK_LENGTH : (2UL * SHA256_BLOCK_LENGTH);
+    uint32_t i;
+
+    (void)memcpy(state, sha256Iv, sizeof(state));
+    HostSha256Blocks(state, pInput, u32Full);
+
+    /* Padding: 0x80, zeros, 64-bit message bit length */
+    (void)memset(tail, 0, sizeof(tail));
+    if(u32Rest > 0UL)
+    {
+        (void)memcpy(tail, &pInput[u32Full * SHA256_BLOCK_LENGTH], u32Rest);
+    }
+    tail[u32Rest] = 0x80U;
+    HostSha2Store64(&tail[u32TailLength - 8UL], (uint64_t)u32InputLength << 3U);
+    HostSha256Blocks(state, tail, u32TailLength / SHA256_BLOCK_LENGTH);
+
+    for(i = 0UL; i < 8UL; i++)
+    {
+        HostSha2Store32(&pDigest[4UL * i], state[i]);
+    }
+}
+
+/*******************************************************************************
+ * Description   : SHA-512 of a message.
+ ******************************************************************************/
+void HostSha512(const uint8_t* pInput, uint32_t u32InputLength, uint8_t* pDigest)
+{
+    uint64_t state[8];
+    uint8_t  tail[2UL * SHA512_BLOCK_LENGTH];
+    uint32_t u32Full = u32InputLength / SHA512_BLOCK_LENGTH;
+    uint32_t u32Rest = u32InputLength % SHA512_BLOCK_LENGTH;
+    uint32_t u32TailLength = (u32Rest < (SHA512_BLOCK_LENGTH - 16UL)) ? SHA512_BLOCK_LENGTH : (2UL * SHA512_BLOCK_LENGTH);
+    uint32_t i;
+
+    (void)memcpy(state, sha512Iv, sizeof(state));
+    HostSha512Blocks(state, pInput, u32Full);
+
+    /* Padding: 0x80, zeros, 128-bit message bit length (upper 64 bits are zero) */
+    (void)memset(tail, 0, sizeof(tail));
+    if(u32Rest > 0UL)
+    {
+        (void)memcpy(tail, &pInput[u32Full * SHA512_BLOCK_LENGTH], u32Rest);
+    }
+    tail[u32Rest] = 0x80U;
+    HostSha2Store64(&tail[u32TailLength - 8UL], (uint64_t)u32InputLength << 3U);
+    HostSha512Blocks(state, tail, u32TailLength / SHA512_BLOCK_LENGTH);
+
+    for(i = 0UL; i < 8UL; i++)
+    {
+        HostSha2Store64(&pDigest[8UL * i], state[i]);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Run the known answer tests of HostSha256 and HostSha512.
+ ******************************************************************************/
+bool_t HostSha2SelfTest(void)
+{
+    uint8_t digest[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t u32Length;
+    uint32_t i;
+
+    for(i = 0UL; i < (sizeof(hostSha2Kat) / sizeof(hostSha2Kat[0])); i++)
+    {
+        if(hostSha2Kat[i].bSha512)
+        {
+            HostSha512((const uint8_t*)hostSha2Kat[i].pMessage, (uint32_t)strlen(hostSha2Kat[i].pMessage), digest);
+            u32Length = HOST_SHA512_DIGEST_LENGTH;
+        }
+        else
+        {
+            HostSha256((const uint8_t*)hostSha2Kat[i].pMessage, (uint32_t)strlen(hostSha2Kat[i].pMessage), digest);
+            u32Length = HOST_SHA256_DIGEST_LENGTH;
+        }
+        if(0 != memcmp(digest, hostSha2Kat[i].au8Digest, u32Length))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,112 @@
+/**
+*   @file    hse_host_sha2.h
+*
+*   @version 1.0.0
+*   @brief   Host CPU SHA-256/SHA-512.
+*   @details Software hash of short public data, used by HashPublicData() below the calibrated
+*            threshold. Must not be used on secret data: it is not protected against side channels.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_SHA2_H
+#define HSE_HOST_SHA2_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_sha2.h
+*/
+#include "std_typedefs.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+#define HOST_SHA256_DIGEST_LENGTH       (32UL)
+#define HOST_SHA512_DIGEST_LENGTH       (64UL)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        SHA-256 of a message (FIPS 180-4).
+*
+* @param[in]    pInput          The message (can be NULL if u32InputLength is 0).
+* @param[in]    u32InputLength  The message length in bytes.
+* @param[out]   pDigest         HOST_SHA256_DIGEST_LENGTH bytes.
+*
+* @return       NULL
+*/
+void HostSha256(const uint8_t* pInput, uint32_t u32InputLength, uint8_t* pDigest);
+
+/**
+* @brief        SHA-512 of a message (FIPS 180-4).
+*
+* @param[in]    pInput          The message (can be NULL if u32InputLength is 0).
+* @param[in]    u32InputLength  The message length in bytes.
+* @param[out]   pDigest         HOST_SHA512_DIGEST_LENGTH bytes.
+*
+* @return       NULL
+*/
+void HostSha512(const uint8_t* pInput, uint32_t u32InputLength, uint8_t* pDigest);
+
+/**
+* @brief        Run the known answer tests of HostSha256() and HostSha512().
+*
+* @return       TRUE if all digests match, FALSE otherwise.
+*/
+bool_t HostSha2SelfTest(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_SHA2_H */
+
+/** @} */
@@ -9,6 +9,7 @@ extern "C"
  ==================================================================================================*/
 
 #include "hse_host.h"
+#include "hse_host_ctx.h"
 #include "string.h"
 
 #include "hse_host_sign.h"
@@ -31,8 +32,6 @@ extern "C"
  ==================================================================================================*/
 #ifdef HSE_SPT_SIGN
 
-static uint8_t localMuIf = 0U;
-static uint8_t localMuChannelIdx = 1U;
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
  ==================================================================================================*/
@@ -45,35 +44,36 @@ static uint8_t localMuChannelIdx = 1U;
  *                                   LOCAL FUNCTION PROTOTYPES
  ==================================================================================================*/
 static hseSrvResponse_t SignReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                                hseKeyHandle_t keyHandle, const uint8_t muIf,
-                                const uint8_t muChannelIdx, uint32_t inputLength,
+                                hseKeyHandle_t keyHandle, const hseCtx_t* pCtx, uint32_t inputLength,
                                 const uint8_t* pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                 uint32_t* pSignatureLength0, uint8_t* pSignature0,
-                                uint32_t* pSignatureLength1, uint8_t* pSignature1,
-                                hseTxOptions_t txOptions);
+                                uint32_t* pSignatureLength1, uint8_t* pSignature1);
 
 static hseSrvResponse_t VerReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                               hseKeyHandle_t keyHandle, const uint8_t muIf,
-                               const uint8_t muChannelIdx, uint32_t inputLength,
+                               hseKeyHandle_t keyHandle, const hseCtx_t* pCtx, uint32_t inputLength,
                                const uint8_t* pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                const uint32_t* pSignatureLength0, const uint8_t* pSignature0,
-                               const uint32_t* pSignatureLength1, const uint8_t* pSignature1,
-                               hseTxOptions_t txOptions);
+                               const uint32_t* pSignatureLength1, const uint8_t* pSignature1);
 
 /*==================================================================================================
  *                                       LOCAL FUNCTIONS
  ==================================================================================================*/
 
 static hseSrvResponse_t SignReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                                hseKeyHandle_t keyHandle, const uint8_t muIf,
-                                const uint8_t muChannelIdx, uint32_t inputLength,
+                                hseKeyHandle_t keyHandle, const hseCtx_t* pCtx, uint32_t inputLength,
                                 const uint8_t* pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                 uint32_t* pSignatureLength0, uint8_t* pSignature0,
-                                uint32_t* pSignatureLength1, uint8_t* pSignature1,
-                                hseTxOptions_t txOptions)
+                                uint32_t* pSignatureLength1, uint8_t* pSignature1)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, 0U, &muChannelIdx, &hseStatus);
     hseSignSrv_t* pSignSrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
     pHseSrvDesc->srvId = HSE_SRV_ID_SIGN;
@@ -92,19 +92,24 @@ static hseSrvResponse_t SignReq(hseAccessMode_t accessMode, hseSignScheme_t sign
     pSignSrv->pSignatureLength[1] = (HOST_ADDR)pSignatureLength1;
     pSignSrv->pSignature[1]       = (HOST_ADDR)pSignature1;
 
-    return HSE_Send(muIf, muChannelIdx, txOptions, pHseSrvDesc);
+    return HSE_CtxStreamSend(pCtx, accessMode, 0U, muChannelIdx, pHseSrvDesc);
 }
 
 static hseSrvResponse_t VerReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                               hseKeyHandle_t keyHandle, const uint8_t muIf,
-                               const uint8_t muChannelIdx, uint32_t inputLength,
+                               hseKeyHandle_t keyHandle, const hseCtx_t* pCtx, uint32_t inputLength,
                                const uint8_t* pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                const uint32_t* pSignatureLength0, const uint8_t* pSignature0,
-                               const uint32_t* pSignatureLength1, const uint8_t* pSignature1,
-                               hseTxOptions_t txOptions)
+                               const uint32_t* pSignatureLength1, const uint8_t* pSignature1)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
+    hseSrvResponse_t hseStatus;
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxStreamAcquire(pCtx, accessMode, 0U, &muChannelIdx, &hseStatus);
     hseSignSrv_t* pSignSrv;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return hseStatus;
+    }
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
     pHseSrvDesc->srvId = HSE_SRV_ID_SIGN;
@@ -123,7 +128,7 @@ static hseSrvResponse_t VerReq(hseAccessMode_t accessMode, hseSignScheme_t signS
     pSignSrv->pSignatureLength[1] = (HOST_ADDR)pSignatureLength1;
     pSignSrv->pSignature[1]       = (HOST_ADDR)pSignature1;
 
-    return HSE_Send(muIf, muChannelIdx, txOptions, pHseSrvDesc);
+    return HSE_CtxStreamSend(pCtx, accessMode, 0U, muChannelIdx, pHseSrvDesc);
 }
 
 /*==================================================================================================
@@ -134,36 +139,49 @@ static hseSrvResponse_t VerReq(hseAccessMode_t accessMode, hseSignScheme_t signS
   *                                     Global Sign Services
   ************************************************************************************************/
 
-hseSrvResponse_t SignSrvReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                            hseKeyHandle_t keyHandle, uint32_t inputLength,
-                            const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                            uint32_t *pSignatureLength0, uint8_t *pSignature0,
-                            uint32_t *pSignatureLength1, uint8_t *pSignature1)
+hseSrvResponse_t SignSrvReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, hseSignScheme_t signScheme,
+                               hseKeyHandle_t keyHandle, uint32_t inputLength,
+                               const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                               uint32_t *pSignatureLength0, uint8_t *pSignature0,
+                               uint32_t *pSignatureLength1, uint8_t *pSignature1)
 {
-    return SignReq(accessMode,signScheme, keyHandle,
-                   localMuIf, localMuChannelIdx,
+    return SignReq(accessMode, signScheme, keyHandle, pCtx,
                    inputLength, pInput, bInputIsHashed, sgtOption,
                    pSignatureLength0, pSignature0,
-                   pSignatureLength1, pSignature1, gSyncTxOption);
+                   pSignatureLength1, pSignature1);
 }
 
-hseSrvResponse_t VerSrvReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
-                           hseKeyHandle_t keyHandle, uint32_t inputLength,
-                           const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                           const uint32_t* pSignatureLength0, const uint8_t *pSignature0,
-                           const uint32_t* pSignatureLength1, const uint8_t *pSignature1)
+hseSrvResponse_t VerSrvReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, hseSignScheme_t signScheme,
+                              hseKeyHandle_t keyHandle, uint32_t inputLength,
+                              const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                              const uint32_t* pSignatureLength0, const uint8_t *pSignature0,
+                              const uint32_t* pSignatureLength1, const uint8_t *pSignature1)
 {
-    return VerReq(accessMode,signScheme, keyHandle,
-                  localMuIf, localMuChannelIdx,
+    return VerReq(accessMode, signScheme, keyHandle, pCtx,
                   inputLength, pInput, bInputIsHashed, sgtOption,
                   pSignatureLength0, pSignature0,
-                  pSignatureLength1, pSignature1, gSyncTxOption);
+                  pSignatureLength1, pSignature1);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(SignSrvReq,
+    (hseAccessMode_t accessMode, hseSignScheme_t signScheme, hseKeyHandle_t keyHandle, uint32_t inputLength,
+     const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t *pSignatureLength0,
+     uint8_t *pSignature0, uint32_t *pSignatureLength1, uint8_t *pSignature1),
+    (accessMode, signScheme, keyHandle, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength0,
+     pSignature0, pSignatureLength1, pSignature1))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(VerSrvReq,
+    (hseAccessMode_t accessMode, hseSignScheme_t signScheme, hseKeyHandle_t keyHandle, uint32_t inputLength,
+     const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+     const uint32_t* pSignatureLength0, const uint8_t *pSignature0, const uint32_t* pSignatureLength1,
+     const uint8_t *pSignature1),
+    (accessMode, signScheme, keyHandle, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength0,
+     pSignature0, pSignatureLength1, pSignature1))
+
 /********************************************************************************
  *                           ECDSA(generate/verify)
  *******************************************************************************/
-hseSrvResponse_t EcdsaSign(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+hseSrvResponse_t EcdsaSignCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                               uint32_t inputLength, const uint8_t* pInput,
                               bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                               uint32_t* pRLen, uint8_t* pR,
@@ -173,36 +191,47 @@ hseSrvResponse_t EcdsaSign(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
     signScheme.signSch = HSE_SIGN_ECDSA;
     signScheme.sch.ecdsa.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_ONE_PASS, signScheme,
-                   keyHandle, localMuIf, localMuChannelIdx,
+                   keyHandle, pCtx,
                    inputLength, pInput, bInputIsHashed, sgtOption,
                    pRLen, pR,
-                   pSLen, pS, gSyncTxOption);
+                   pSLen, pS);
 }
 
-hseSrvResponse_t EcdsaVerify(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                             uint32_t inputLength, const uint8_t* pInput,
-                             bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                             const uint32_t* pRLen, const uint8_t* pR,
-                             const uint32_t* pSLen, const uint8_t* pS)
+hseSrvResponse_t EcdsaVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                uint32_t inputLength, const uint8_t* pInput,
+                                bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                const uint32_t* pRLen, const uint8_t* pR,
+                                const uint32_t* pSLen, const uint8_t* pS)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_ECDSA;
     signScheme.sch.ecdsa.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_ONE_PASS, signScheme,
-                  keyHandle, localMuIf, localMuChannelIdx,
+                  keyHandle, pCtx,
                   inputLength, pInput, bInputIsHashed, sgtOption,
                   pRLen, pR,
-                  pSLen, pS, gSyncTxOption);
+                  pSLen, pS);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(EcdsaSign,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+     bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t* pRLen, uint8_t* pR, uint32_t* pSLen,
+     uint8_t* pS),
+    (keyHandle, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pRLen, pR, pSLen, pS))
+
+HSE_CTX_DEFINE_SYNC_ASYNC(EcdsaVerify,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t* pInput,
+     bool_t bInputIsHashed, hseSGTOption_t sgtOption, const uint32_t* pRLen, const uint8_t* pR,
+     const uint32_t* pSLen, const uint8_t* pS),
+    (keyHandle, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pRLen, pR, pSLen, pS))
+
 /******************************************************************************
  *                              EdDSA(generate/verify)
  *****************************************************************************/
-hseSrvResponse_t EddsaSign(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+hseSrvResponse_t EddsaSignCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
                               uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
-                              uint8_t userContextLength, const uint8_t* pUserContext,
-                              uint32_t* pRLen, uint8_t* pR,
-                              uint32_t* pSLen, uint8_t* pS)
+                              uint8_t userContextLength, const uint8_t* pUserContext, uint32_t* pRLen,
+                              uint8_t* pR, uint32_t* pSLen, uint8_t* pS)
 {
     hseSignScheme_t signScheme;
 
@@ -212,17 +241,23 @@ hseSrvResponse_t EddsaSign(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
     signScheme.sch.eddsa.pContext      = (HOST_ADDR)pUserContext;
 
     return SignReq(HSE_ACCESS_MODE_ONE_PASS, signScheme,
-                   keyHandle, localMuIf, localMuChannelIdx,
+                   keyHandle, pCtx,
                    inputLength, pInput, bInputIsHashed, 0,
                    pRLen, pR,
-                   pSLen, pS, gSyncTxOption);
+                   pSLen, pS);
 }
 
-hseSrvResponse_t EddsaVerify(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
-                             uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
-                             uint8_t userContextLength, const uint8_t* pUserContext,
-                             const uint32_t* pRLen, const uint8_t* pR,
-                             const uint32_t* pSLen, const uint8_t* pS)
+HSE_CTX_DEFINE_SYNC_ASYNC(EddsaSign,
+    (hseKeyHandle_t keyHandle, bool_t bHashEddsa, uint32_t inputLength, const uint8_t* pInput,
+     bool_t bInputIsHashed, uint8_t userContextLength, const uint8_t* pUserContext, uint32_t* pRLen,
+     uint8_t* pR, uint32_t* pSLen, uint8_t* pS),
+    (keyHandle, bHashEddsa, inputLength, pInput, bInputIsHashed, userContextLength, pUserContext, pRLen, pR,
+     pSLen, pS))
+
+hseSrvResponse_t EddsaVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+                                uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                uint8_t userContextLength, const uint8_t* pUserContext, const uint32_t* pRLen,
+                                const uint8_t* pR, const uint32_t* pSLen, const uint8_t* pS)
 {
     hseSignScheme_t signScheme;
 
@@ -232,158 +267,215 @@ hseSrvResponse_t EddsaVerify(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
     signScheme.sch.eddsa.pContext      = (HOST_ADDR)pUserContext;
 
     return VerReq(HSE_ACCESS_MODE_ONE_PASS, signScheme,
-                  keyHandle, localMuIf, localMuChannelIdx,
+                  keyHandle, pCtx,
                   inputLength, pInput, bInputIsHashed, 0,
                   pRLen, pR,
-                  pSLen, pS, gSyncTxOption);
+                  pSLen, pS);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(EddsaVerify,
+    (hseKeyHandle_t keyHandle, bool_t bHashEddsa, uint32_t inputLength, const uint8_t* pInput,
+     bool_t bInputIsHashed, uint8_t userContextLength, const uint8_t* pUserContext, const uint32_t* pRLen,
+     const uint8_t* pR, const uint32_t* pSLen, const uint8_t* pS),
+    (keyHandle, bHashEddsa, inputLength, pInput, bInputIsHashed, userContextLength, pUserContext, pRLen, pR,
+     pSLen, pS))
+
 /**********************************************************************************
  *                         RSA SA PSS(generate/verify)
  *********************************************************************************/
-hseSrvResponse_t RsaPssSignSrv(hseKeyHandle_t keyHandle, uint32_t saltLength,
-                               hseHashAlgo_t hashAlgo, uint32_t inputLength,
-                               const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                               uint32_t *pSignatureLength, uint8_t *pSignature)
+hseSrvResponse_t RsaPssSignSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                  hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                  bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t *pSignatureLength,
+                                  uint8_t *pSignature)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PSS;
     signScheme.sch.rsaPss.saltLength = saltLength;
     signScheme.sch.rsaPss.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, bInputIsHashed, sgtOption,
-                   pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                   pCtx, inputLength, pInput, bInputIsHashed, sgtOption,
+                   pSignatureLength, pSignature, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssVerSrv(hseKeyHandle_t keyHandle, uint32_t saltLength,
-                              hseHashAlgo_t hashAlgo, uint32_t inputLength,
-                              const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                              const uint32_t* pSignatureLength, const uint8_t *pSignature)
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPssSignSrv,
+    (hseKeyHandle_t keyHandle, uint32_t saltLength, hseHashAlgo_t hashAlgo, uint32_t inputLength,
+     const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t *pSignatureLength,
+     uint8_t *pSignature),
+    (keyHandle, saltLength, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength,
+     pSignature))
+
+hseSrvResponse_t RsaPssVerSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                 hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                 bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                 const uint32_t* pSignatureLength, const uint8_t *pSignature)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PSS;
     signScheme.sch.rsaPss.saltLength = saltLength;
     signScheme.sch.rsaPss.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                  localMuIf, localMuChannelIdx, inputLength, pInput, bInputIsHashed, sgtOption,
-                  pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                  pCtx, inputLength, pInput, bInputIsHashed, sgtOption,
+                  pSignatureLength, pSignature, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssSignStreamStartSrv(hseKeyHandle_t keyHandle,
-                                          hseHashAlgo_t hashAlgo,
-                                          uint32_t saltLength)
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPssVerSrv,
+    (hseKeyHandle_t keyHandle, uint32_t saltLength, hseHashAlgo_t hashAlgo, uint32_t inputLength,
+     const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption, const uint32_t* pSignatureLength,
+     const uint8_t *pSignature),
+    (keyHandle, saltLength, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength,
+     pSignature))
+
+hseSrvResponse_t RsaPssSignStreamStartSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             hseHashAlgo_t hashAlgo, uint32_t saltLength)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PSS;
     signScheme.sch.rsaPss.saltLength = saltLength;
     signScheme.sch.rsaPss.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_START, signScheme, keyHandle,
-                   localMuIf, localMuChannelIdx, 0, NULL, FALSE, 0,
-                   0, NULL, 0, NULL, gSyncTxOption);
+                   pCtx, 0, NULL, FALSE, 0,
+                   0, NULL, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssSignStreamUpdateSrv(uint32_t inputLength, const uint8_t *pInput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssSignStreamStartSrv,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t saltLength),
+    (keyHandle, hashAlgo, saltLength))
+
+hseSrvResponse_t RsaPssSignStreamUpdateSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                              const uint8_t *pInput)
 {
     hseSignScheme_t signScheme = {0};
     return SignReq(HSE_ACCESS_MODE_UPDATE, signScheme, 0,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                   0, NULL, 0, NULL, gSyncTxOption);
+                   pCtx, inputLength, pInput, FALSE, 0,
+                   0, NULL, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssSignStreamFinishSrv(uint32_t inputLength,
-                                           const uint8_t *pInput,
-                                           uint32_t *pSignatureLength,
-                                           uint8_t *pSignature)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssSignStreamUpdateSrv,
+    (uint32_t inputLength, const uint8_t *pInput),
+    (inputLength, pInput))
+
+hseSrvResponse_t RsaPssSignStreamFinishSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                              const uint8_t *pInput, uint32_t *pSignatureLength,
+                                              uint8_t *pSignature)
 {
     hseSignScheme_t signScheme = {0};
     return SignReq(HSE_ACCESS_MODE_FINISH, signScheme, 0,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                   pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                   pCtx, inputLength, pInput, FALSE, 0,
+                   pSignatureLength, pSignature, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssVerStreamStartSrv(hseKeyHandle_t keyHandle,
-                                         hseHashAlgo_t hashAlgo,
-                                         uint32_t saltLength)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssSignStreamFinishSrv,
+    (uint32_t inputLength, const uint8_t *pInput, uint32_t *pSignatureLength, uint8_t *pSignature),
+    (inputLength, pInput, pSignatureLength, pSignature))
+
+hseSrvResponse_t RsaPssVerStreamStartSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                            hseHashAlgo_t hashAlgo, uint32_t saltLength)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PSS;
     signScheme.sch.rsaPss.saltLength = saltLength;
     signScheme.sch.rsaPss.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_START, signScheme, keyHandle,
-                  localMuIf, localMuChannelIdx, 0, NULL, FALSE, 0,
-                  0, NULL, 0, NULL, gSyncTxOption);
+                  pCtx, 0, NULL, FALSE, 0,
+                  0, NULL, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssVerStreamUpdateSrv(uint32_t inputLength, const uint8_t *pInput)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssVerStreamStartSrv,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t saltLength),
+    (keyHandle, hashAlgo, saltLength))
+
+hseSrvResponse_t RsaPssVerStreamUpdateSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength, const uint8_t *pInput)
 {
     hseSignScheme_t signScheme = {0};
     return VerReq(HSE_ACCESS_MODE_UPDATE, signScheme, 0,
-                  localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                  0, NULL, 0, NULL, gSyncTxOption);
+                  pCtx, inputLength, pInput, FALSE, 0,
+                  0, NULL, 0, NULL);
 }
 
-hseSrvResponse_t RsaPssVerStreamFinishSrv(uint32_t inputLength,
-                                          const uint8_t *pInput,
-                                          const uint32_t* pSignatureLength,
-                                          const uint8_t *pSignature)
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssVerStreamUpdateSrv,
+    (uint32_t inputLength, const uint8_t *pInput),
+    (inputLength, pInput))
+
+hseSrvResponse_t RsaPssVerStreamFinishSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                             const uint8_t *pInput, const uint32_t* pSignatureLength,
+                                             const uint8_t *pSignature)
 {
     hseSignScheme_t signScheme = {0};
     return VerReq(HSE_ACCESS_MODE_FINISH, signScheme, 0,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                   pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                   pCtx, inputLength, pInput, FALSE, 0,
+                   pSignatureLength, pSignature, 0, NULL);
 }
 
+HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(RsaPssVerStreamFinishSrv,
+    (uint32_t inputLength, const uint8_t *pInput, const uint32_t* pSignatureLength, const uint8_t *pSignature),
+    (inputLength, pInput, pSignatureLength, pSignature))
+
 /******************************************************************************************
  *                              RSA SA PKCS1 V15(generate/verify)
  *****************************************************************************************/
-hseSrvResponse_t RsaPkcs1v15SignSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                    uint32_t inputLength, uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                                    uint32_t *pSignatureLength, uint8_t *pSignature)
+hseSrvResponse_t RsaPkcs1v15SignSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t inputLength, uint8_t *pInput, bool_t bInputIsHashed,
+                                       hseSGTOption_t sgtOption, uint32_t *pSignatureLength,
+                                       uint8_t *pSignature)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, bInputIsHashed, sgtOption,
-                   pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                   pCtx, inputLength, pInput, bInputIsHashed, sgtOption,
+                   pSignatureLength, pSignature, 0, NULL);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPkcs1v15SignSrv,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, uint8_t *pInput,
+     bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t *pSignatureLength, uint8_t *pSignature),
+    (keyHandle, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength, pSignature))
+
 hseSrvResponse_t RsaPkcs1v15SignAsyncSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                          const uint8_t muIf, const uint8_t muChannelIdx,
                                          uint32_t inputLength, uint8_t *pInput,
                                          uint32_t *pSignatureLength, uint8_t *pSignature,
                                          hseTxOptions_t asyncTxOptions)
 {
+    const hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, asyncTxOptions);
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                   muIf, muChannelIdx, inputLength, pInput, FALSE, 0, pSignatureLength, pSignature, 0, NULL, asyncTxOptions);
+                   &ctx, inputLength, pInput, FALSE, 0, pSignatureLength, pSignature, 0, NULL);
 }
 
-hseSrvResponse_t RsaPkcs1v15VerSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
-                                   uint32_t inputLength, const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
-                                   const uint32_t* pSignatureLength, const uint8_t *pSignature)
+hseSrvResponse_t RsaPkcs1v15VerSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                      uint32_t inputLength, const uint8_t *pInput, bool_t bInputIsHashed,
+                                      hseSGTOption_t sgtOption, const uint32_t* pSignatureLength,
+                                      const uint8_t *pSignature)
 {
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                  localMuIf, localMuChannelIdx, inputLength, pInput, bInputIsHashed, sgtOption,
-                  pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                  pCtx, inputLength, pInput, bInputIsHashed, sgtOption,
+                  pSignatureLength, pSignature, 0, NULL);
 }
 
+HSE_CTX_DEFINE_SYNC_ASYNC(RsaPkcs1v15VerSrv,
+    (hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+     bool_t bInputIsHashed, hseSGTOption_t sgtOption, const uint32_t* pSignatureLength,
+     const uint8_t *pSignature),
+    (keyHandle, hashAlgo, inputLength, pInput, bInputIsHashed, sgtOption, pSignatureLength, pSignature))
+
 hseSrvResponse_t RsaPkcs1v15VerAsyncSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                         const uint8_t muIf, const uint8_t muChannelIdx,
                                         uint32_t inputLength, const uint8_t *pInput,
                                         const uint32_t* pSignatureLength, const uint8_t *pSignature,
                                         hseTxOptions_t asyncTxOptions)
 {
+    const hseCtx_t ctx = HSE_CtxOnChannel(muIf, muChannelIdx, asyncTxOptions);
     hseSignScheme_t signScheme;
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_ONE_PASS, signScheme, keyHandle,
-                  muIf, muChannelIdx, inputLength, pInput, FALSE, 0, pSignatureLength, pSignature, 0, NULL, asyncTxOptions);
+                  &ctx, inputLength, pInput, FALSE, 0, pSignatureLength, pSignature, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15SignStreamStart(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo)
@@ -392,16 +484,16 @@ hseSrvResponse_t RsaPkcs1v15SignStreamStart(hseKeyHandle_t keyHandle, hseHashAlg
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return SignReq(HSE_ACCESS_MODE_START, signScheme, keyHandle,
-                   localMuIf, localMuChannelIdx, 0, NULL, FALSE, 0,
-                   0, NULL, 0, NULL, gSyncTxOption);
+                   &gHseDefaultCtx, 0, NULL, FALSE, 0,
+                   0, NULL, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15SignStreamUpdate(uint32_t inputLength, const uint8_t *pInput)
 {
     hseSignScheme_t signScheme = {0};
     return SignReq(HSE_ACCESS_MODE_UPDATE, signScheme, 0,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                   0, NULL, 0, NULL, gSyncTxOption);
+                   &gHseDefaultCtx, inputLength, pInput, FALSE, 0,
+                   0, NULL, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15SignStreamFinish(uint32_t inputLength, const uint8_t *pInput,
@@ -409,8 +501,8 @@ hseSrvResponse_t RsaPkcs1v15SignStreamFinish(uint32_t inputLength, const uint8_t
 {
     hseSignScheme_t signScheme = {0};
     return SignReq(HSE_ACCESS_MODE_FINISH, signScheme, 0,
-                   localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                   pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                   &gHseDefaultCtx, inputLength, pInput, FALSE, 0,
+                   pSignatureLength, pSignature, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15VerSha1StreamStart(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo)
@@ -419,16 +511,16 @@ hseSrvResponse_t RsaPkcs1v15VerSha1StreamStart(hseKeyHandle_t keyHandle, hseHash
     signScheme.signSch = HSE_SIGN_RSASSA_PKCS1_V15;
     signScheme.sch.rsaPkcs1v15.hashAlgo = hashAlgo;
     return VerReq(HSE_ACCESS_MODE_START, signScheme, keyHandle,
-                  localMuIf, localMuChannelIdx, 0, NULL, FALSE, 0,
-                  0, NULL, 0, NULL, gSyncTxOption);
+                  &gHseDefaultCtx, 0, NULL, FALSE, 0,
+                  0, NULL, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15VerSha1StreamUpdate(uint32_t inputLength, const uint8_t *pInput)
 {
     hseSignScheme_t signScheme = {0};
     return VerReq(HSE_ACCESS_MODE_UPDATE, signScheme, 0,
-                  localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                  0, NULL, 0, NULL, gSyncTxOption);
+                  &gHseDefaultCtx, inputLength, pInput, FALSE, 0,
+                  0, NULL, 0, NULL);
 }
 
 hseSrvResponse_t RsaPkcs1v15VerSha1StreamFinish(uint32_t inputLength, const uint8_t *pInput,
@@ -436,8 +528,8 @@ hseSrvResponse_t RsaPkcs1v15VerSha1StreamFinish(uint32_t inputLength, const uint
 {
     hseSignScheme_t signScheme = {0};
     return VerReq(HSE_ACCESS_MODE_FINISH, signScheme, 0,
-                  localMuIf, localMuChannelIdx, inputLength, pInput, FALSE, 0,
-                  pSignatureLength, pSignature, 0, NULL, gSyncTxOption);
+                  &gHseDefaultCtx, inputLength, pInput, FALSE, 0,
+                  pSignatureLength, pSignature, 0, NULL);
 }
 
 #endif /*HSE_SPT_SIGN*/
@@ -451,9 +543,9 @@ hseSrvResponse_t DHSharedSecretCompute(hseKeyHandle_t pubKeyHandle, hseKeyHandle
 {
 #ifdef HSE_SPT_COMPUTE_DH
     hseSrvResponse_t hseResponse = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
+    hseSrvDescriptor_t* pHseSrvDesc;
     hseDHComputeSharedSecretSrv_t *pDhSrv;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    uint8_t muChannelIdx;
 
     hseResponse = HKF_AllocKeySlot(isNvmKey, HSE_KEY_TYPE_SHARED_SECRET, maxBitLength, pTargetKeyHandle);
     if(HSE_SRV_RSP_OK != hseResponse)
@@ -461,13 +553,22 @@ hseSrvResponse_t DHSharedSecretCompute(hseKeyHandle_t pubKeyHandle, hseKeyHandle
         goto exit;
     }
 
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        HKF_FreeKeySlot(pTargetKeyHandle);
+        hseResponse = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+        goto exit;
+    }
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+
     pHseSrvDesc->srvId = HSE_SRV_ID_DH_COMPUTE_SHARED_SECRET;
     pDhSrv = &(pHseSrvDesc->hseSrv.dhComputeSecretReq);
     pDhSrv->privKeyHandle    = privKeyHandle;
     pDhSrv->peerPubKeyHandle = pubKeyHandle;
     pDhSrv->targetKeyHandle  = *pTargetKeyHandle;
 
-    hseResponse = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
+    hseResponse = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
     if(HSE_SRV_RSP_OK != hseResponse)
     {
         HKF_FreeKeySlot(pTargetKeyHandle);
@@ -491,8 +592,14 @@ exit:
 #ifdef HSE_SPT_BURMESTER_DESMEDT
 hseSrvResponse_t BDComputeSecondPubKey(hseKeyHandle_t deviceKeyHandle, hseKeyHandle_t pubKeyHandle)
 {
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
+    uint8_t muChannelIdx;
+    hseSrvDescriptor_t* pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
     hseBurmesterDesmedtSrv_t *pBdReq;
+
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
     memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
 
     pHseSrvDesc->srvId = HSE_SRV_ID_BURMESTER_DESMEDT;
@@ -502,16 +609,16 @@ hseSrvResponse_t BDComputeSecondPubKey(hseKeyHandle_t deviceKeyHandle, hseKeyHan
     pBdReq->deviceKeyHandle       = deviceKeyHandle;
     pBdReq->pubKeyHandle          = pubKeyHandle;
 
-    return HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
+    return HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
 }
 
 hseSrvResponse_t BDComputeSharedSecret(hseKeyHandle_t deviceKeyHandle, hseKeyHandle_t pubKeyHandle,
                                        uint8_t numParticipants, hseKeyHandle_t *pSharedSecretKeyHandle, uint8_t isNvmKey, uint16_t sharedSecretLength)
 {
     hseSrvResponse_t hseResponse = HSE_SRV_RSP_GENERAL_ERROR;
-    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[localMuIf][localMuChannelIdx];
+    hseSrvDescriptor_t* pHseSrvDesc;
     hseBurmesterDesmedtSrv_t *pBdReq;
-    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    uint8_t muChannelIdx;
 
     hseResponse = HKF_AllocKeySlot(isNvmKey, HSE_KEY_TYPE_SHARED_SECRET, sharedSecretLength, pSharedSecretKeyHandle);
     if(HSE_SRV_RSP_OK != hseResponse)
@@ -519,6 +626,15 @@ hseSrvResponse_t BDComputeSharedSecret(hseKeyHandle_t deviceKeyHandle, hseKeyHan
         goto exit;
     }
 
+    pHseSrvDesc = HSE_CtxAcquire(&gHseDefaultCtx, &muChannelIdx);
+    if(NULL == pHseSrvDesc)
+    {
+        HKF_FreeKeySlot(pSharedSecretKeyHandle);
+        hseResponse = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+        goto exit;
+    }
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+
     pHseSrvDesc->srvId = HSE_SRV_ID_BURMESTER_DESMEDT;
     pBdReq = &(pHseSrvDesc->hseSrv.burmesterDesmedtReq);
 
@@ -528,7 +644,7 @@ hseSrvResponse_t BDComputeSharedSecret(hseKeyHandle_t deviceKeyHandle, hseKeyHan
     pBdReq->sharedSecretKeyHandle = *pSharedSecretKeyHandle;
     pBdReq->numParticipants       = numParticipants;
 
-    hseResponse = HSE_Send(localMuIf, localMuChannelIdx, gSyncTxOption, pHseSrvDesc);
+    hseResponse = HSE_CtxSend(&gHseDefaultCtx, muChannelIdx, pHseSrvDesc);
     if(HSE_SRV_RSP_OK != hseResponse)
     {
         HKF_FreeKeySlot(pSharedSecretKeyHandle);
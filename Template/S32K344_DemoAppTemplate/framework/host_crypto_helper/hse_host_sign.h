@@ -14,6 +14,7 @@ extern "C"{
 ==================================================================================================*/
 
 #include "hse_interface.h"
+#include "hse_host_ctx.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -51,12 +52,37 @@ hseSrvResponse_t SignSrvReq(hseAccessMode_t accessMode, hseSignScheme_t signSche
                             const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                             uint32_t *pSignatureLength0, uint8_t *pSignature0,  
                             uint32_t *pSignatureLength1, uint8_t *pSignature1);
+hseSrvResponse_t SignSrvReqAsync(hseTxOptions_t txOptions, hseAccessMode_t accessMode,
+                                 hseSignScheme_t signScheme, hseKeyHandle_t keyHandle, uint32_t inputLength,
+                                 const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                 uint32_t *pSignatureLength0, uint8_t *pSignature0,
+                                 uint32_t *pSignatureLength1, uint8_t *pSignature1);
 
 hseSrvResponse_t VerSrvReq(hseAccessMode_t accessMode, hseSignScheme_t signScheme,
                            hseKeyHandle_t keyHandle, uint32_t inputLength,
                            const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                            const uint32_t* pSignatureLength0, const uint8_t *pSignature0, 
                            const uint32_t* pSignatureLength1, const uint8_t *pSignature1);
+hseSrvResponse_t VerSrvReqAsync(hseTxOptions_t txOptions, hseAccessMode_t accessMode,
+                                hseSignScheme_t signScheme, hseKeyHandle_t keyHandle, uint32_t inputLength,
+                                const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                const uint32_t* pSignatureLength0, const uint8_t *pSignature0,
+                                const uint32_t* pSignatureLength1, const uint8_t *pSignature1);
+
+/* Context variants: MU, channel, TX options and deadline taken from pCtx.
+ * The ...StreamAsync variants are sent on the channel of pStreamCtx (HSE_CtxStreamOpen), see
+ * HSE_CTX_DEFINE_STREAM_ASYNC; the synchronous stream helpers hold a channel of MU0 from START to FINISH */
+hseSrvResponse_t SignSrvReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, hseSignScheme_t signScheme,
+                               hseKeyHandle_t keyHandle, uint32_t inputLength,
+                               const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                               uint32_t *pSignatureLength0, uint8_t *pSignature0,
+                               uint32_t *pSignatureLength1, uint8_t *pSignature1);
+
+hseSrvResponse_t VerSrvReqCtx(const hseCtx_t* pCtx, hseAccessMode_t accessMode, hseSignScheme_t signScheme,
+                              hseKeyHandle_t keyHandle, uint32_t inputLength,
+                              const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                              const uint32_t* pSignatureLength0, const uint8_t *pSignature0,
+                              const uint32_t* pSignatureLength1, const uint8_t *pSignature1);
  /*************************************************************************************
   *                                         ECDSA
   ************************************************************************************/                          
@@ -66,12 +92,32 @@ hseSrvResponse_t EcdsaSign(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                               bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                               uint32_t* pRLen, uint8_t* pR, 
                               uint32_t* pSLen, uint8_t* pS);
+hseSrvResponse_t EcdsaSignAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                hseSGTOption_t sgtOption, uint32_t* pRLen, uint8_t* pR, uint32_t* pSLen,
+                                uint8_t* pS);
 
 hseSrvResponse_t EcdsaVerify(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                              uint32_t inputLength, const uint8_t* pInput,
                              bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                              const uint32_t* pRLen, const uint8_t* pR,
                              const uint32_t* pSLen, const uint8_t* pS);
+hseSrvResponse_t EcdsaVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                  uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                  hseSGTOption_t sgtOption, const uint32_t* pRLen, const uint8_t* pR,
+                                  const uint32_t* pSLen, const uint8_t* pS);
+
+hseSrvResponse_t EcdsaSignCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                              uint32_t inputLength, const uint8_t* pInput,
+                              bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                              uint32_t* pRLen, uint8_t* pR,
+                              uint32_t* pSLen, uint8_t* pS);
+
+hseSrvResponse_t EcdsaVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                uint32_t inputLength, const uint8_t* pInput,
+                                bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                const uint32_t* pRLen, const uint8_t* pR,
+                                const uint32_t* pSLen, const uint8_t* pS);
 
 /*******************************************************************************************
  *                                          EdDSA
@@ -81,12 +127,29 @@ hseSrvResponse_t EddsaSign(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
                               uint8_t userContextLength, const uint8_t* pUserContext,
                               uint32_t* pRLen, uint8_t* pR,
                               uint32_t* pSLen, uint8_t* pS);
+hseSrvResponse_t EddsaSignCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+                              uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                              uint8_t userContextLength, const uint8_t* pUserContext, uint32_t* pRLen,
+                              uint8_t* pR, uint32_t* pSLen, uint8_t* pS);
+hseSrvResponse_t EddsaSignAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+                                uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                uint8_t userContextLength, const uint8_t* pUserContext, uint32_t* pRLen,
+                                uint8_t* pR, uint32_t* pSLen, uint8_t* pS);
 
 hseSrvResponse_t EddsaVerify(hseKeyHandle_t keyHandle, bool_t bHashEddsa,
                              uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
                              uint8_t userContextLength, const uint8_t* pUserContext,
                              const uint32_t* pRLen, const uint8_t* pR,
                              const uint32_t* pSLen, const uint8_t* pS);
+hseSrvResponse_t EddsaVerifyCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+                                uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                uint8_t userContextLength, const uint8_t* pUserContext, const uint32_t* pRLen,
+                                const uint8_t* pR, const uint32_t* pSLen, const uint8_t* pS);
+hseSrvResponse_t EddsaVerifyAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, bool_t bHashEddsa,
+                                  uint32_t inputLength, const uint8_t* pInput, bool_t bInputIsHashed,
+                                  uint8_t userContextLength, const uint8_t* pUserContext,
+                                  const uint32_t* pRLen, const uint8_t* pR, const uint32_t* pSLen,
+                                  const uint8_t* pS);
 
 /******************************************************************************************* 
  *                                        RSA SA PSS
@@ -95,33 +158,82 @@ hseSrvResponse_t RsaPssSignSrv(hseKeyHandle_t keyHandle, uint32_t saltLength,
                                hseHashAlgo_t hashAlgo, uint32_t inputLength,
                                const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                uint32_t *pSignatureLength, uint8_t *pSignature);
+hseSrvResponse_t RsaPssSignSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                  hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                  bool_t bInputIsHashed, hseSGTOption_t sgtOption, uint32_t *pSignatureLength,
+                                  uint8_t *pSignature);
+hseSrvResponse_t RsaPssSignSrvAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                    hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                    bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                    uint32_t *pSignatureLength, uint8_t *pSignature);
 
 hseSrvResponse_t RsaPssVerSrv(hseKeyHandle_t keyHandle, uint32_t saltLength, 
                               hseHashAlgo_t hashAlgo, uint32_t inputLength,
                               const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                               const uint32_t* pSignatureLength, const uint8_t *pSignature);
+hseSrvResponse_t RsaPssVerSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                 hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                 bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                 const uint32_t* pSignatureLength, const uint8_t *pSignature);
+hseSrvResponse_t RsaPssVerSrvAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle, uint32_t saltLength,
+                                   hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                   bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                   const uint32_t* pSignatureLength, const uint8_t *pSignature);
 
 hseSrvResponse_t RsaPssSignStreamStartSrv(hseKeyHandle_t keyHandle, 
                                           hseHashAlgo_t hashAlgo, 
                                           uint32_t saltLength);
+hseSrvResponse_t RsaPssSignStreamStartSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                             hseHashAlgo_t hashAlgo, uint32_t saltLength);
+hseSrvResponse_t RsaPssSignStreamStartSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               hseKeyHandle_t keyHandle,
+                                               hseHashAlgo_t hashAlgo, uint32_t saltLength);
 
 hseSrvResponse_t RsaPssSignStreamUpdateSrv(uint32_t inputLength, const uint8_t *pInput);
+hseSrvResponse_t RsaPssSignStreamUpdateSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                              const uint8_t *pInput);
+hseSrvResponse_t RsaPssSignStreamUpdateSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t inputLength,
+                                                const uint8_t *pInput);
 
 hseSrvResponse_t RsaPssSignStreamFinishSrv(uint32_t inputLength, 
                                            const uint8_t *pInput, 
                                            uint32_t *pSignatureLength, 
                                            uint8_t *pSignature);
+hseSrvResponse_t RsaPssSignStreamFinishSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                              const uint8_t *pInput, uint32_t *pSignatureLength,
+                                              uint8_t *pSignature);
+hseSrvResponse_t RsaPssSignStreamFinishSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                                uint32_t inputLength,
+                                                const uint8_t *pInput, uint32_t *pSignatureLength,
+                                                uint8_t *pSignature);
 
 hseSrvResponse_t RsaPssVerStreamStartSrv(hseKeyHandle_t keyHandle, 
                                          hseHashAlgo_t hashAlgo, 
                                          uint32_t saltLength);
+hseSrvResponse_t RsaPssVerStreamStartSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle,
+                                            hseHashAlgo_t hashAlgo, uint32_t saltLength);
+hseSrvResponse_t RsaPssVerStreamStartSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                              hseKeyHandle_t keyHandle,
+                                              hseHashAlgo_t hashAlgo, uint32_t saltLength);
 
 hseSrvResponse_t RsaPssVerStreamUpdateSrv(uint32_t inputLength, const uint8_t *pInput);
+hseSrvResponse_t RsaPssVerStreamUpdateSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength, const uint8_t *pInput);
+hseSrvResponse_t RsaPssVerStreamUpdateSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               uint32_t inputLength,
+                                               const uint8_t *pInput);
 
 hseSrvResponse_t RsaPssVerStreamFinishSrv(uint32_t inputLength, 
                                           const uint8_t *pInput, 
                                           const uint32_t* pSignatureLength, 
                                           const uint8_t *pSignature);
+hseSrvResponse_t RsaPssVerStreamFinishSrvCtx(const hseCtx_t* pCtx, uint32_t inputLength,
+                                             const uint8_t *pInput, const uint32_t* pSignatureLength,
+                                             const uint8_t *pSignature);
+hseSrvResponse_t RsaPssVerStreamFinishSrvAsync(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions,
+                                               uint32_t inputLength,
+                                               const uint8_t *pInput, const uint32_t* pSignatureLength,
+                                               const uint8_t *pSignature);
 
 /******************************************************************************************
  *                              RSA SA PKCS1 V15(generate/verify)
@@ -129,6 +241,14 @@ hseSrvResponse_t RsaPssVerStreamFinishSrv(uint32_t inputLength,
 hseSrvResponse_t RsaPkcs1v15SignSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, 
                                     uint32_t inputLength, uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                     uint32_t *pSignatureLength, uint8_t *pSignature);
+hseSrvResponse_t RsaPkcs1v15SignSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                       uint32_t inputLength, uint8_t *pInput, bool_t bInputIsHashed,
+                                       hseSGTOption_t sgtOption, uint32_t *pSignatureLength,
+                                       uint8_t *pSignature);
+hseSrvResponse_t RsaPkcs1v15SignSrvAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                         hseHashAlgo_t hashAlgo, uint32_t inputLength, uint8_t *pInput,
+                                         bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                         uint32_t *pSignatureLength, uint8_t *pSignature);
 
 hseSrvResponse_t RsaPkcs1v15SignAsyncSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, 
                                          const uint8_t muIf,  const uint8_t muChannelIdx,
@@ -139,6 +259,14 @@ hseSrvResponse_t RsaPkcs1v15SignAsyncSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t
 hseSrvResponse_t RsaPkcs1v15VerSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                    uint32_t inputLength, const uint8_t *pInput, bool_t bInputIsHashed, hseSGTOption_t sgtOption,
                                    const uint32_t* pSignatureLength, const uint8_t *pSignature);
+hseSrvResponse_t RsaPkcs1v15VerSrvCtx(const hseCtx_t* pCtx, hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
+                                      uint32_t inputLength, const uint8_t *pInput, bool_t bInputIsHashed,
+                                      hseSGTOption_t sgtOption, const uint32_t* pSignatureLength,
+                                      const uint8_t *pSignature);
+hseSrvResponse_t RsaPkcs1v15VerSrvAsync(hseTxOptions_t txOptions, hseKeyHandle_t keyHandle,
+                                        hseHashAlgo_t hashAlgo, uint32_t inputLength, const uint8_t *pInput,
+                                        bool_t bInputIsHashed, hseSGTOption_t sgtOption,
+                                        const uint32_t* pSignatureLength, const uint8_t *pSignature);
 
 hseSrvResponse_t RsaPkcs1v15VerAsyncSrv(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo,
                                         const uint8_t muIf, const uint8_t muChannelIdx,
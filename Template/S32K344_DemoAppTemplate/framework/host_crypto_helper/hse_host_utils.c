@@ -81,10 +81,10 @@ void ReverseMemCpy(uint8_t* dst, const uint8_t* src, uint32_t len)
  * Prepare a scatter gather list using blocks from the message
  ******************************************************************************/
 #ifdef HSE_SPT_SGT_OPTION
-void HSE_PrepareSgtList(uint16_t plainTextLen, hseScatterList_t *pSgtList, uint8_t chunksize, const uint8_t *plaintext)
+void HSE_PrepareSgtList(uint32_t plainTextLen, hseScatterList_t *pSgtList, uint32_t chunksize, const uint8_t *plaintext)
 {
     uint32_t index              = 0;
-    uint16_t tempPlainTextLen   = plainTextLen;
+    uint32_t tempPlainTextLen   = plainTextLen;
 
 
     while(tempPlainTextLen != 0)
@@ -106,6 +106,149 @@ void HSE_PrepareSgtList(uint16_t plainTextLen, hseScatterList_t *pSgtList, uint8
         index++;
     }
 }
+
+/*******************************************************************************
+ * Start a scatter list in a caller-provided entry array
+ ******************************************************************************/
+hseSrvResponse_t HSE_SgtInit(hseSgtBuilder_t* pBuilder, hseScatterList_t* pEntries,
+                             uint32_t u32MaxEntries, uint32_t u32ChunkAlign)
+{
+    pBuilder->pEntries       = pEntries;
+    pBuilder->u32MaxEntries  = u32MaxEntries;
+    pBuilder->u32NumEntries  = 0UL;
+    pBuilder->u32TotalLength = 0UL;
+    pBuilder->u32ChunkAlign  = u32ChunkAlign;
+    pBuilder->status         = HSE_SRV_RSP_OK;
+
+    if((NULL == pEntries) || (0UL != ((uintptr_t)pEntries & 3UL)) ||
+       (0UL == u32MaxEntries) || (u32MaxEntries > HSE_MAX_NUM_OF_SGT_ENTRIES) || (0UL == u32ChunkAlign))
+    {
+        pBuilder->status = HSE_SRV_RSP_INVALID_PARAM;
+    }
+    return pBuilder->status;
+}
+
+/*******************************************************************************
+ * Append a fragment (merged with the previous entry when contiguous)
+ ******************************************************************************/
+hseSrvResponse_t HSE_SgtAppend(hseSgtBuilder_t* pBuilder, const void* pData, uint32_t u32Length)
+{
+    HOST_ADDR pPtr = (HOST_ADDR)pData;
+    hseScatterList_t* pLast;
+    uint32_t u32Chunk;
+
+    if((HSE_SRV_RSP_OK != pBuilder->status) || (0UL == u32Length))
+    {
+        return pBuilder->status;
+    }
+    if((NULL == pData) || (u32Length > (0xFFFFFFFFUL - pBuilder->u32TotalLength)))
+    {
+        pBuilder->status = HSE_SRV_RSP_INVALID_PARAM;
+        return pBuilder->status;
+    }
+
+    while(0UL != u32Length)
+    {
+        pLast = (0UL == pBuilder->u32NumEntries) ? NULL : &pBuilder->pEntries[pBuilder->u32NumEntries - 1UL];
+        if((NULL != pLast) && ((pLast->pPtr + pLast->length) == pPtr) &&
+           (pLast->length < HSE_SGT_MAX_CHUNK_LENGTH))
+        {
+            /* Contiguous with the previous entry */
+            u32Chunk = HSE_SGT_MAX_CHUNK_LENGTH - pLast->length;
+            u32Chunk = (u32Length < u32Chunk) ? u32Length : u32Chunk;
+            pLast->length += u32Chunk;
+        }
+        else
+        {
+            if(pBuilder->u32NumEntries >= pBuilder->u32MaxEntries)
+            {
+                pBuilder->status = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+                return pBuilder->status;
+            }
+            u32Chunk = (u32Length < HSE_SGT_MAX_CHUNK_LENGTH) ? u32Length : HSE_SGT_MAX_CHUNK_LENGTH;
+            pBuilder->pEntries[pBuilder->u32NumEntries].length = u32Chunk;
+            pBuilder->pEntries[pBuilder->u32NumEntries].pPtr   = pPtr;
+            pBuilder->u32NumEntries++;
+        }
+        pBuilder->u32TotalLength += u32Chunk;
+        pPtr += u32Chunk;
+        u32Length -= u32Chunk;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Append a list of fragments
+ ******************************************************************************/
+hseSrvResponse_t HSE_SgtAppendFragments(hseSgtBuilder_t* pBuilder, const hseSgtFragment_t* pFragments,
+                                        uint32_t u32NumFragments)
+{
+    uint32_t i;
+
+    for(i = 0UL; (i < u32NumFragments) && (HSE_SRV_RSP_OK == pBuilder->status); i++)
+    {
+        (void)HSE_SgtAppend(pBuilder, pFragments[i].pData, pFragments[i].u32Length);
+    }
+    return pBuilder->status;
+}
+
+/*******************************************************************************
+ * Append a span of a ring buffer (two entries if it wraps around)
+ ******************************************************************************/
+hseSrvResponse_t HSE_SgtAppendRing(hseSgtBuilder_t* pBuilder, const uint8_t* pRing, uint32_t u32RingSize,
+                                   uint32_t u32Offset, uint32_t u32Length)
+{
+    uint32_t u32Head;
+
+    if((HSE_SRV_RSP_OK == pBuilder->status) &&
+       ((NULL == pRing) || (u32Offset >= u32RingSize) || (u32Length > u32RingSize)))
+    {
+        pBuilder->status = HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(HSE_SRV_RSP_OK != pBuilder->status)
+    {
+        return pBuilder->status;
+    }
+
+    u32Head = u32RingSize - u32Offset;
+    if(u32Length <= u32Head)
+    {
+        return HSE_SgtAppend(pBuilder, &pRing[u32Offset], u32Length);
+    }
+    (void)HSE_SgtAppend(pBuilder, &pRing[u32Offset], u32Head);
+    return HSE_SgtAppend(pBuilder, pRing, u32Length - u32Head);
+}
+
+/*******************************************************************************
+ * Mark the final chunk and check the chunk lengths
+ ******************************************************************************/
+hseSrvResponse_t HSE_SgtFinalize(hseSgtBuilder_t* pBuilder, uint32_t* pu32TotalLength)
+{
+    uint32_t i;
+
+    if((HSE_SRV_RSP_OK == pBuilder->status) && (0UL == pBuilder->u32NumEntries))
+    {
+        pBuilder->status = HSE_SRV_RSP_INVALID_PARAM;
+    }
+    for(i = 0UL; (HSE_SRV_RSP_OK == pBuilder->status) && ((i + 1UL) < pBuilder->u32NumEntries); i++)
+    {
+        if(0UL != (pBuilder->pEntries[i].length % pBuilder->u32ChunkAlign))
+        {
+            pBuilder->status = HSE_SRV_RSP_INVALID_PARAM;
+        }
+    }
+    if(HSE_SRV_RSP_OK != pBuilder->status)
+    {
+        return pBuilder->status;
+    }
+
+    pBuilder->pEntries[pBuilder->u32NumEntries - 1UL].length |= HSE_SGT_FINAL_CHUNK_BIT_MASK;
+    if(NULL != pu32TotalLength)
+    {
+        *pu32TotalLength = pBuilder->u32TotalLength;
+    }
+    return HSE_SRV_RSP_OK;
+}
 #endif /* HSE_SPT_SGT_OPTION */
 
 /*******************************************************************************
@@ -49,6 +49,14 @@ extern "C"{
 *                                      DEFINES AND MACROS
 ==================================================================================================*/
 #define SGT_SET_FINAL_BIT_MASK (0x40000000UL)    
+
+#ifdef HSE_SPT_SGT_OPTION
+/* Largest chunk of a scatter list entry (length below 2^30) */
+#define HSE_SGT_MAX_CHUNK_LENGTH    (HSE_SGT_FINAL_CHUNK_BIT_MASK - 1UL)
+
+/* The list built by an SGT builder, to pass as pInput/pOutput with HSE_SGT_OPTION_INPUT/OUTPUT */
+#define HSE_SGT_LIST(pBuilder)      ((const uint8_t*)(pBuilder)->pEntries)
+#endif /* HSE_SPT_SGT_OPTION */
 /*==================================================================================================
 *                                             ENUMS
 ==================================================================================================*/
@@ -56,6 +64,31 @@ extern "C"{
 /*==================================================================================================
                                  STRUCTURES AND OTHER TYPEDEFS
 ==================================================================================================*/
+#ifdef HSE_SPT_SGT_OPTION
+/*
+ * @brief   One fragment of a message (e.g. a CAN frame payload)
+ */
+typedef struct
+{
+    const void*         pData;          /**< @brief    The fragment. */
+    uint32_t            u32Length;      /**< @brief    The fragment length in bytes. */
+} hseSgtFragment_t;
+
+/*
+ * @brief   Scatter list builder.
+ * @details Entries are written in place in a caller-provided hseScatterList_t array; the fragments
+ *          are referenced, not copied. The first error is kept until HSE_SgtInit() is called again.
+ */
+typedef struct
+{
+    hseScatterList_t*   pEntries;       /**< @brief    The list (caller-provided). */
+    uint32_t            u32MaxEntries;  /**< @brief    The list capacity (at most HSE_MAX_NUM_OF_SGT_ENTRIES). */
+    uint32_t            u32NumEntries;  /**< @brief    The entries used. */
+    uint32_t            u32TotalLength; /**< @brief    Sum of the chunk lengths. */
+    uint32_t            u32ChunkAlign;  /**< @brief    Length multiple required for the non-final chunks (1 = any). */
+    hseSrvResponse_t    status;         /**< @brief    HSE_SRV_RSP_OK, or the first error. */
+} hseSgtBuilder_t;
+#endif /* HSE_SPT_SGT_OPTION */
 
 /*==================================================================================================
                                  GLOBAL VARIABLE DECLARATIONS
@@ -71,7 +104,76 @@ extern "C"{
 void ReverseMemCpy(uint8_t* dst, const uint8_t* src, uint32_t len);
 
 #ifdef HSE_SPT_SGT_OPTION
-void HSE_PrepareSgtList(uint16_t plainTextLen, hseScatterList_t *pSgtList, uint8_t chunksize, const uint8_t *plaintext);
+void HSE_PrepareSgtList(uint32_t plainTextLen, hseScatterList_t *pSgtList, uint32_t chunksize, const uint8_t *plaintext);
+
+/**
+* @brief        Start a scatter list.
+* @details      The list must stay valid, unchanged, until the HSE completed the request using it.
+*
+* @param[out]   pBuilder        The builder.
+* @param[in]    pEntries        The list entries (4-byte aligned).
+* @param[in]    u32MaxEntries   The number of entries of pEntries (1 .. HSE_MAX_NUM_OF_SGT_ENTRIES).
+* @param[in]    u32ChunkAlign   Length multiple required for all chunks but the last one
+*                               (e.g. 16 for AES ECB/CBC), 1 for no constraint.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_INVALID_PARAM.
+*/
+hseSrvResponse_t HSE_SgtInit(hseSgtBuilder_t* pBuilder, hseScatterList_t* pEntries,
+                             uint32_t u32MaxEntries, uint32_t u32ChunkAlign);
+
+/**
+* @brief        Append a fragment to a scatter list.
+* @details      Empty fragments are skipped; a fragment contiguous with the previous entry extends
+*               that entry. Fragments longer than HSE_SGT_MAX_CHUNK_LENGTH use several entries.
+*
+* @param[in,out] pBuilder       The builder.
+* @param[in]    pData           The fragment.
+* @param[in]    u32Length       The fragment length in bytes.
+*
+* @return       HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM (NULL fragment, total length overflow) or
+*               HSE_SRV_RSP_NOT_ENOUGH_SPACE (more than u32MaxEntries entries).
+*/
+hseSrvResponse_t HSE_SgtAppend(hseSgtBuilder_t* pBuilder, const void* pData, uint32_t u32Length);
+
+/**
+* @brief        Append a list of fragments (e.g. CAN frame payloads).
+*
+* @param[in,out] pBuilder       The builder.
+* @param[in]    pFragments      The fragments.
+* @param[in]    u32NumFragments The number of fragments.
+*
+* @return       See HSE_SgtAppend().
+*/
+hseSrvResponse_t HSE_SgtAppendFragments(hseSgtBuilder_t* pBuilder, const hseSgtFragment_t* pFragments,
+                                        uint32_t u32NumFragments);
+
+/**
+* @brief        Append u32Length bytes of a ring buffer starting at u32Offset (wrap-around included).
+*
+* @param[in,out] pBuilder       The builder.
+* @param[in]    pRing           The ring buffer.
+* @param[in]    u32RingSize     The ring buffer size in bytes.
+* @param[in]    u32Offset       The offset of the first byte (< u32RingSize).
+* @param[in]    u32Length       The number of bytes (<= u32RingSize).
+*
+* @return       See HSE_SgtAppend().
+*/
+hseSrvResponse_t HSE_SgtAppendRing(hseSgtBuilder_t* pBuilder, const uint8_t* pRing, uint32_t u32RingSize,
+                                   uint32_t u32Offset, uint32_t u32Length);
+
+/**
+* @brief        Terminate a scatter list.
+* @details      Sets HSE_SGT_FINAL_CHUNK_BIT_MASK on the last entry and checks the chunk alignment.
+*               The list is then passed as HSE_SGT_LIST(pBuilder) with the total length and
+*               HSE_SGT_OPTION_INPUT (or HSE_SGT_OPTION_OUTPUT) to the cipher/MAC/hash/AEAD helpers.
+*
+* @param[in,out] pBuilder       The builder.
+* @param[out]   pu32TotalLength The message length (sum of all chunks); can be NULL.
+*
+* @return       HSE_SRV_RSP_OK, the first error of the builder, or HSE_SRV_RSP_INVALID_PARAM
+*               (empty list, misaligned chunk).
+*/
+hseSrvResponse_t HSE_SgtFinalize(hseSgtBuilder_t* pBuilder, uint32_t* pu32TotalLength);
 #endif /* HSE_SPT_SGT_OPTION */
 
 /*******************************************************************************
@@ -0,0 +1,387 @@
+/**
+*   @file    hse_host_vstream.c
+*
+*   @brief   HSE HOST virtual streams.
+*   @details Each logical stream is either idle (no context), resident on a HSE stream, or swapped
+*            out to its block of the pool. The HSE stream of the resident stream acquired the
+*            longest time ago is reused when no HSE stream is free.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_vstream.c
+*/
+#include <stdatomic.h>
+#include "hse_host_vstream.h"
+#include "hse_host_impex_stream.h"
+#include "host_stm.h"
+#include "string.h"
+
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   State of a logical stream
+ */
+typedef enum
+{
+    HSE_VSTREAM_UNUSED = 0U,        /* Not open */
+    HSE_VSTREAM_IDLE,               /* Open, no context */
+    HSE_VSTREAM_RESIDENT,           /* Context on a HSE stream */
+    HSE_VSTREAM_SWAPPED,            /* Context in the pool */
+} hseVStreamState_t;
+
+/*
+ * @brief   Logical stream
+ */
+typedef struct
+{
+    hseVStreamState_t       state;
+    hseStreamId_t           streamId;       /* HSE stream, when resident */
+    uint32_t                u32LastUse;     /* Acquire stamp, for the LRU choice */
+} hseVStream_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* Words of a pool block (the HSE reads/writes the context as a 32-bit aligned buffer) */
+#define HSE_VSTREAM_CTX_WORDS           ((MAX_STREAMING_CONTEXT_SIZE + 3UL) / 4UL)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseVStream_t vStream[HSE_VSTREAM_MAX_STREAMS];
+/* Swap pool: one block per logical stream */
+static uint32_t au32VStreamPool[HSE_VSTREAM_MAX_STREAMS][HSE_VSTREAM_CTX_WORDS];
+/* Logical stream resident on each HSE stream, or HSE_VSTREAM_INVALID */
+static hseVStreamHandle_t vStreamOwner[HSE_STREAM_COUNT];
+static uint8_t u8VStreamMuInstance = 0U;
+static uint8_t u8VStreamChannel = HSE_INVALID_CHANNEL;
+static uint32_t u32VStreamClock = 0UL;
+static hseVStreamStats_t vStreamStats;
+/* Held from HSE_VStreamAcquire() to HSE_VStreamRelease(), and by Init/Open/Close */
+static atomic_bool bVStreamActive;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static hseSrvResponse_t HSE_VStreamTransfer(hseStreamContextOp_t op, hseVStreamHandle_t handle);
+static hseSrvResponse_t HSE_VStreamGetSlot(hseStreamId_t* pStreamId);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Export/import the context of a logical stream to/from its pool block.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VStreamTransfer(hseStreamContextOp_t op, hseVStreamHandle_t handle)
+{
+    const hseCtx_t ctx = HSE_CtxOnChannel(u8VStreamMuInstance, u8VStreamChannel, gSyncTxOption);
+    hseSrvResponse_t status;
+    uint32_t u32Start;
+
+    u32Start = GetStmTimebaseUs();
+    status = StreamCtxOpCtx(&ctx, op, vStream[handle].streamId, (uint8_t*)au32VStreamPool[handle]);
+    vStreamStats.u32SwapUs += GetStmTimebaseUs() - u32Start;
+
+    if(HSE_SRV_RSP_OK != status)
+    {
+        vStreamStats.u32SwapErrors++;
+    }
+    else if(HSE_EXPORT_STREAMING_CONTEXT == op)
+    {
+        vStreamStats.u32SwapOuts++;
+    }
+    else
+    {
+        vStreamStats.u32SwapIns++;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Get a free HSE stream, swapping out the least recently used
+ *                 resident stream if all are used.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_VStreamGetSlot(hseStreamId_t* pStreamId)
+{
+    hseSrvResponse_t status;
+    hseVStreamHandle_t victim;
+    hseStreamId_t lru = 0U;
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_STREAM_COUNT; i++)
+    {
+        if(HSE_VSTREAM_INVALID == vStreamOwner[i])
+        {
+            *pStreamId = (hseStreamId_t)i;
+            return HSE_SRV_RSP_OK;
+        }
+        /* Oldest stamp (wrap-around safe) */
+        if((int32_t)(vStream[vStreamOwner[i]].u32LastUse - vStream[vStreamOwner[lru]].u32LastUse) < 0)
+        {
+            lru = (hseStreamId_t)i;
+        }
+    }
+
+    victim = vStreamOwner[lru];
+    status = HSE_VStreamTransfer(HSE_EXPORT_STREAMING_CONTEXT, victim);
+    if(HSE_SRV_RSP_OK == status)
+    {
+        vStream[victim].state = HSE_VSTREAM_SWAPPED;
+        vStreamOwner[lru] = HSE_VSTREAM_INVALID;
+        *pStreamId = lru;
+    }
+    return status;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Initialize the virtual streams of a MU instance.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VStreamInit(uint8_t u8MuInstance, uint8_t u8MuChannel)
+{
+    bool expected = false;
+    uint32_t i;
+
+    if((u8MuInstance >= HSE_NUM_OF_MU_INSTANCES) ||
+       (0U == u8MuChannel) || (u8MuChannel >= HSE_NUM_OF_CHANNELS_PER_MU))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(!atomic_compare_exchange_strong(&bVStreamActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    u8VStreamMuInstance = u8MuInstance;
+    u8VStreamChannel    = u8MuChannel;
+    u32VStreamClock     = 0UL;
+    for(i = 0UL; i < HSE_VSTREAM_MAX_STREAMS; i++)
+    {
+        vStream[i].state = HSE_VSTREAM_UNUSED;
+    }
+    for(i = 0UL; i < HSE_STREAM_COUNT; i++)
+    {
+        vStreamOwner[i] = HSE_VSTREAM_INVALID;
+    }
+    (void)memset(au32VStreamPool, 0, sizeof(au32VStreamPool));
+    (void)memset(&vStreamStats, 0, sizeof(vStreamStats));
+    EnableStmTimebase();
+
+    atomic_store(&bVStreamActive, false);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Open a logical stream.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VStreamOpen(hseVStreamHandle_t* pHandle)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    bool expected = false;
+    uint32_t i;
+
+    if((NULL == pHandle) || (HSE_INVALID_CHANNEL == u8VStreamChannel))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(!atomic_compare_exchange_strong(&bVStreamActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    *pHandle = HSE_VSTREAM_INVALID;
+    for(i = 0UL; i < HSE_VSTREAM_MAX_STREAMS; i++)
+    {
+        if(HSE_VSTREAM_UNUSED == vStream[i].state)
+        {
+            vStream[i].state      = HSE_VSTREAM_IDLE;
+            vStream[i].u32LastUse = u32VStreamClock;
+            *pHandle = (hseVStreamHandle_t)i;
+            status = HSE_SRV_RSP_OK;
+            break;
+        }
+    }
+
+    atomic_store(&bVStreamActive, false);
+    return status;
+}
+
+/*******************************************************************************
+ * Description   : Acquire a logical stream for the next step.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VStreamAcquire(hseVStreamHandle_t handle, hseCtx_t* pCtx, hseStreamId_t* pStreamId)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    hseStreamId_t streamId;
+    bool expected = false;
+
+    if((handle >= HSE_VSTREAM_MAX_STREAMS) || (NULL == pCtx) || (NULL == pStreamId))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(!atomic_compare_exchange_strong(&bVStreamActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    switch(vStream[handle].state)
+    {
+        case HSE_VSTREAM_RESIDENT:
+            vStreamStats.u32Hits++;
+            break;
+        case HSE_VSTREAM_IDLE:
+            status = HSE_VStreamGetSlot(&streamId);
+            if(HSE_SRV_RSP_OK == status)
+            {
+                vStream[handle].streamId = streamId;
+            }
+            break;
+        case HSE_VSTREAM_SWAPPED:
+            status = HSE_VStreamGetSlot(&streamId);
+            if(HSE_SRV_RSP_OK == status)
+            {
+                vStream[handle].streamId = streamId;
+                status = HSE_VStreamTransfer(HSE_IMPORT_STREAMING_CONTEXT, handle);
+            }
+            break;
+        default:
+            status = HSE_SRV_RSP_INVALID_PARAM;
+            break;
+    }
+
+    if(HSE_SRV_RSP_OK != status)
+    {
+        atomic_store(&bVStreamActive, false);
+        return status;
+    }
+
+    vStream[handle].state      = HSE_VSTREAM_RESIDENT;
+    vStream[handle].u32LastUse = ++u32VStreamClock;
+    vStreamOwner[vStream[handle].streamId] = handle;
+    vStreamStats.u32Acquires++;
+
+    *pCtx      = HSE_CtxOnChannel(u8VStreamMuInstance, u8VStreamChannel, gSyncTxOption);
+    *pStreamId = vStream[handle].streamId;
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Release the logical stream after its step.
+ ******************************************************************************/
+void HSE_VStreamRelease(hseVStreamHandle_t handle, bool_t bEnded)
+{
+    if((handle < HSE_VSTREAM_MAX_STREAMS) && bEnded && (HSE_VSTREAM_RESIDENT == vStream[handle].state))
+    {
+        vStreamOwner[vStream[handle].streamId] = HSE_VSTREAM_INVALID;
+        vStream[handle].state = HSE_VSTREAM_IDLE;
+    }
+    atomic_store(&bVStreamActive, false);
+}
+
+/*******************************************************************************
+ * Description   : Close a logical stream.
+ ******************************************************************************/
+hseSrvResponse_t HSE_VStreamClose(hseVStreamHandle_t handle)
+{
+    bool expected = false;
+
+    if(handle >= HSE_VSTREAM_MAX_STREAMS)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    if(!atomic_compare_exchange_strong(&bVStreamActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    if(HSE_VSTREAM_RESIDENT == vStream[handle].state)
+    {
+        vStreamOwner[vStream[handle].streamId] = HSE_VSTREAM_INVALID;
+    }
+    else if(HSE_VSTREAM_SWAPPED == vStream[handle].state)
+    {
+        (void)memset(au32VStreamPool[handle], 0, sizeof(au32VStreamPool[handle]));
+    }
+    else
+    {
+        /* Idle or not open: nothing to free */
+    }
+    vStream[handle].state = HSE_VSTREAM_UNUSED;
+
+    atomic_store(&bVStreamActive, false);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Get the statistics of the virtual streams.
+ ******************************************************************************/
+void HSE_VStreamGetStats(hseVStreamStats_t* pStats)
+{
+    if(NULL != pStats)
+    {
+        *pStats = vStreamStats;
+    }
+}
+
+/*******************************************************************************
+ * Description   : Reset the statistics of the virtual streams.
+ ******************************************************************************/
+void HSE_VStreamResetStats(void)
+{
+    (void)memset(&vStreamStats, 0, sizeof(vStreamStats));
+}
+
+#endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
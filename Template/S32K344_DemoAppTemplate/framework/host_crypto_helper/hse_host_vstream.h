@@ -0,0 +1,192 @@
+/**
+*   @file    hse_host_vstream.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST virtual streams.
+*   @details Maps more logical streams than the HSE provides onto the HSE_STREAM_COUNT streams of
+*            a MU instance: the context of the least recently used stream is exported to a RAM pool
+*            when a stream is needed, and imported back when that stream is used again.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_VSTREAM_H
+#define HSE_HOST_VSTREAM_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_vstream.h
+*/
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Logical streams; each one reserves MAX_STREAMING_CONTEXT_SIZE bytes of the swap pool */
+#ifndef HSE_VSTREAM_MAX_STREAMS
+#define HSE_VSTREAM_MAX_STREAMS         (32U)
+#endif
+
+/* No logical stream */
+#define HSE_VSTREAM_INVALID             ((hseVStreamHandle_t)0xFFU)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/* Handle of a logical stream */
+typedef uint8_t hseVStreamHandle_t;
+
+/*
+ * @brief   Statistics of the virtual streams
+ */
+typedef struct
+{
+    uint32_t    u32Acquires;        /**< @brief    Calls of HSE_VStreamAcquire() that succeeded. */
+    uint32_t    u32Hits;            /**< @brief    Acquires of a stream already on the HSE. */
+    uint32_t    u32SwapOuts;        /**< @brief    Contexts exported to the pool (evictions). */
+    uint32_t    u32SwapIns;         /**< @brief    Contexts imported from the pool. */
+    uint32_t    u32SwapErrors;      /**< @brief    Exports/imports that failed. */
+    uint32_t    u32SwapUs;          /**< @brief    Time spent exporting/importing contexts (microseconds). */
+} hseVStreamStats_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+/**
+* @brief        Initialize the virtual streams of a MU instance.
+* @details      The manager owns all the streams of the MU instance from here on: no other code
+*               must start streams on it. All the steps of the logical streams, and the context
+*               exports/imports, are sent on u8MuChannel, which must be reserved for the manager
+*               (a stream must be continued on the channel of its START step).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8MuChannel     The channel: 0 < channel < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM, or
+*               HSE_SRV_RSP_NOT_ALLOWED if a logical stream is acquired.
+*/
+hseSrvResponse_t HSE_VStreamInit(uint8_t u8MuInstance, uint8_t u8MuChannel);
+
+/**
+* @brief        Open a logical stream.
+* @details      The stream uses no HSE stream until it is acquired.
+*
+* @param[out]   pHandle         The handle of the logical stream.
+*
+* @return       HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM, HSE_SRV_RSP_NOT_ALLOWED if a logical
+*               stream is acquired, or HSE_SRV_RSP_NOT_ENOUGH_SPACE if HSE_VSTREAM_MAX_STREAMS are open.
+*/
+hseSrvResponse_t HSE_VStreamOpen(hseVStreamHandle_t* pHandle);
+
+/**
+* @brief        Acquire a logical stream for the next step (START, UPDATE or FINISH).
+* @details      Makes the stream resident on the HSE: if no HSE stream is free, the context of the
+*               least recently used stream is exported to the pool; the context of the stream is
+*               imported from the pool if it was swapped out. The step must then be sent with the
+*               returned context and stream (e.g. HashDataUpdateStreamCtx(&ctx, ..., streamId, ...)),
+*               and HSE_VStreamRelease() called. Only one logical stream can be acquired at a time.
+*
+* @param[in]    handle          The logical stream.
+* @param[out]   pCtx            The synchronous context the step must be sent with.
+* @param[out]   pStreamId       The HSE stream the step must be sent on.
+*
+* @return       HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM,
+*               HSE_SRV_RSP_NOT_ALLOWED if a logical stream is acquired, or the error of the
+*               export/import (the stream is then not acquired).
+*/
+hseSrvResponse_t HSE_VStreamAcquire(hseVStreamHandle_t handle, hseCtx_t* pCtx, hseStreamId_t* pStreamId);
+
+/**
+* @brief        Release the logical stream after its step.
+*
+* @param[in]    handle          The logical stream acquired.
+* @param[in]    bEnded          TRUE if the step ended the stream (FINISH, or a step that failed):
+*                               its HSE stream is freed without exporting the context.
+*
+* @return       NULL
+*/
+void HSE_VStreamRelease(hseVStreamHandle_t handle, bool_t bEnded);
+
+/**
+* @brief        Close a logical stream.
+* @details      Frees its HSE stream and wipes its context from the pool.
+*
+* @param[in]    handle          The logical stream (not acquired).
+*
+* @return       HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM, or
+*               HSE_SRV_RSP_NOT_ALLOWED if a logical stream is acquired.
+*/
+hseSrvResponse_t HSE_VStreamClose(hseVStreamHandle_t handle);
+
+/**
+* @brief        Get the statistics of the virtual streams.
+* @details      The swap rate is u32SwapOuts / u32Acquires; u32SwapUs / (u32SwapOuts + u32SwapIns)
+*               is the cost of one context transfer, to compare with restarting a stream.
+*
+* @param[out]   pStats          The statistics.
+*
+* @return       NULL
+*/
+void HSE_VStreamGetStats(hseVStreamStats_t* pStats);
+
+/**
+* @brief        Reset the statistics of the virtual streams.
+*
+* @return       NULL
+*/
+void HSE_VStreamResetStats(void);
+#endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_VSTREAM_H */
+
+/** @} */
@@ -61,6 +61,33 @@ extern "C" {
 #define HSE_ALIGN_4BYTES
 #endif
 
+/* Alignment on a Cortex-M7 D-cache line */
+#if defined(__ghs__) || defined(__GNUC__)
+#define HSE_ALIGN_CACHE_LINE __attribute__((aligned(32)))
+#else
+#define HSE_ALIGN_CACHE_LINE
+#endif
+
+/* Low-power wait for an event (interrupt pending with SEVONPEND set, or SEV) */
+#if defined(__ghs__)
+#define HSE_WAIT_FOR_EVENT()    __asm(" dsb\n wfe")
+#elif defined(__GNUC__) && defined(__arm__)
+#define HSE_WAIT_FOR_EVENT()    __asm volatile ("dsb\n wfe" ::: "memory")
+#elif defined(HSE_VIRTUAL)
+#include <sched.h>
+/* Host emulation: let the device thread run */
+#define HSE_WAIT_FOR_EVENT()    ((void)sched_yield())
+#else
+#define HSE_WAIT_FOR_EVENT()
+#endif
+
+/* Compiler memory barrier (no instruction emitted) */
+#if defined(__GNUC__)
+#define HSE_COMPILER_BARRIER()  __asm volatile ("" ::: "memory")
+#else
+#define HSE_COMPILER_BARRIER()
+#endif
+
 /*==================================================================================================
 *                                             ENUMS
 *  ===============================================================================================*/
@@ -0,0 +1,254 @@
+/**
+*   @file    hse_channel_mgr.c
+*
+*   @brief   HSE HOST channel manager.
+*   @details Lock-free ownership of the MU service channels. Each MU instance has one atomic
+*            bitmap (bit n set = channel n owned); claim and release are single atomic
+*            read-modify-write operations (LDREX/STREX on Cortex-M7), so no global interrupt
+*            masking is needed and the same channel cannot be handed out twice.
+*            A held channel (bit set in a second bitmap) stays owned across its responses,
+*            so the steps of a stream go out on the same channel.
+*
+*   @addtogroup hse_channel_mgr_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_channel_mgr.c
+*/
+#include <stdatomic.h>
+#include "hse_channel_mgr.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Channel ownership and occupancy counters of one MU instance
+ */
+typedef struct
+{
+    atomic_uint_least32_t   u32Owned;           /**< @brief    Bit n set = channel n owned. */
+    atomic_uint_least32_t   u32Held;            /**< @brief    Bit n set = channel n not released by HSE_ChannelRelease(). */
+    atomic_uint_least32_t   u32PeakInUse;
+    atomic_uint_least32_t   u32Claims;
+    atomic_uint_least32_t   u32ClaimFailures;
+    volatile uint8_t        u8NextChannel;      /**< @brief    Round robin start (hint only). */
+} hseChannelCtx_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_CHANNEL_BIT(u8Channel)      (1UL << (u8Channel))
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseChannelCtx_t channelCtx[HSE_NUM_OF_MU_INSTANCES];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static uint32_t HSE_ChannelCount(uint32_t u32Bitmap);
+static void HSE_ChannelUpdatePeak(hseChannelCtx_t* pCtx, uint32_t u32Bitmap);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Number of bits set (channels owned).
+ ******************************************************************************/
+static uint32_t HSE_ChannelCount(uint32_t u32Bitmap)
+{
+    uint32_t u32Count = 0UL;
+
+    while(0UL != u32Bitmap)
+    {
+        u32Bitmap &= (u32Bitmap - 1UL);
+        u32Count++;
+    }
+
+    return u32Count;
+}
+
+/*******************************************************************************
+ * Description   : Record the peak occupancy.
+ ******************************************************************************/
+static void HSE_ChannelUpdatePeak(hseChannelCtx_t* pCtx, uint32_t u32Bitmap)
+{
+    uint_least32_t u32InUse = HSE_ChannelCount(u32Bitmap);
+    uint_least32_t u32Peak = atomic_load(&pCtx->u32PeakInUse);
+
+    while((u32InUse > u32Peak) &&
+          (!atomic_compare_exchange_weak(&pCtx->u32PeakInUse, &u32Peak, u32InUse)))
+    {
+        /* u32Peak reloaded by the failed exchange */
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Atomically take ownership of a channel.
+ ******************************************************************************/
+bool_t HSE_ChannelTryAcquire(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    hseChannelCtx_t* pCtx = &channelCtx[u8MuInstance];
+    uint32_t u32Previous;
+
+    u32Previous = atomic_fetch_or(&pCtx->u32Owned, HSE_CHANNEL_BIT(u8Channel));
+    if(0UL != (u32Previous & HSE_CHANNEL_BIT(u8Channel)))
+    {
+        return FALSE;
+    }
+
+    HSE_ChannelUpdatePeak(pCtx, u32Previous | HSE_CHANNEL_BIT(u8Channel));
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Claim the next free channel (channel 0 excluded).
+ ******************************************************************************/
+uint8_t HSE_ChannelClaim(uint8_t u8MuInstance)
+{
+    hseChannelCtx_t* pCtx = &channelCtx[u8MuInstance];
+    uint8_t u8Count;
+    uint8_t u8Index = pCtx->u8NextChannel;
+
+    for(u8Count = 0U; u8Count < (HSE_NUM_OF_CHANNELS_PER_MU - 1U); u8Count++)
+    {
+        if((u8Index < 1U) || (u8Index >= HSE_NUM_OF_CHANNELS_PER_MU))
+        {
+            u8Index = 1U;
+        }
+
+        /* Skip channels still busy in hardware (e.g. used by another core) */
+        if((MU_CHANNEL_FREE == HSE_MU_GetChannelStatus(u8MuInstance, u8Index)) &&
+           HSE_ChannelTryAcquire(u8MuInstance, u8Index))
+        {
+            pCtx->u8NextChannel = u8Index + 1U;
+            (void)atomic_fetch_add(&pCtx->u32Claims, 1U);
+            return u8Index;
+        }
+        u8Index++;
+    }
+
+    (void)atomic_fetch_add(&pCtx->u32ClaimFailures, 1U);
+    return HSE_INVALID_CHANNEL;
+}
+
+/*******************************************************************************
+ * Description   : Atomically release a channel.
+ ******************************************************************************/
+void HSE_ChannelRelease(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    /* A held channel is released by HSE_ChannelUnhold() */
+    if(0UL == (atomic_load(&channelCtx[u8MuInstance].u32Held) & HSE_CHANNEL_BIT(u8Channel)))
+    {
+        (void)atomic_fetch_and(&channelCtx[u8MuInstance].u32Owned, ~HSE_CHANNEL_BIT(u8Channel));
+    }
+}
+
+/*******************************************************************************
+ * Description   : Keep an owned channel across its responses.
+ ******************************************************************************/
+void HSE_ChannelHold(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    (void)atomic_fetch_or(&channelCtx[u8MuInstance].u32Held, HSE_CHANNEL_BIT(u8Channel));
+}
+
+/*******************************************************************************
+ * Description   : Release a held channel.
+ ******************************************************************************/
+void HSE_ChannelUnhold(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    (void)atomic_fetch_and(&channelCtx[u8MuInstance].u32Held, ~HSE_CHANNEL_BIT(u8Channel));
+    (void)atomic_fetch_and(&channelCtx[u8MuInstance].u32Owned, ~HSE_CHANNEL_BIT(u8Channel));
+}
+
+/*******************************************************************************
+ * Description   : Check whether a channel is held.
+ ******************************************************************************/
+bool_t HSE_ChannelIsHeld(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    return (0UL != (atomic_load(&channelCtx[u8MuInstance].u32Held) & HSE_CHANNEL_BIT(u8Channel)));
+}
+
+/*******************************************************************************
+ * Description   : Check whether a channel is owned.
+ ******************************************************************************/
+bool_t HSE_ChannelIsBusy(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    return (0UL != (atomic_load(&channelCtx[u8MuInstance].u32Owned) & HSE_CHANNEL_BIT(u8Channel)));
+}
+
+/*******************************************************************************
+ * Description   : Get the occupancy counters.
+ ******************************************************************************/
+void HSE_ChannelGetStats(uint8_t u8MuInstance, hseChannelStats_t* pStats)
+{
+    hseChannelCtx_t* pCtx = &channelCtx[u8MuInstance];
+
+    pStats->u32InUse         = HSE_ChannelCount(atomic_load(&pCtx->u32Owned));
+    pStats->u32PeakInUse     = atomic_load(&pCtx->u32PeakInUse);
+    pStats->u32Claims        = atomic_load(&pCtx->u32Claims);
+    pStats->u32ClaimFailures = atomic_load(&pCtx->u32ClaimFailures);
+}
+
+/*******************************************************************************
+ * Description   : Reset the occupancy counters.
+ ******************************************************************************/
+void HSE_ChannelResetStats(uint8_t u8MuInstance)
+{
+    hseChannelCtx_t* pCtx = &channelCtx[u8MuInstance];
+
+    atomic_store(&pCtx->u32PeakInUse, HSE_ChannelCount(atomic_load(&pCtx->u32Owned)));
+    atomic_store(&pCtx->u32Claims, 0U);
+    atomic_store(&pCtx->u32ClaimFailures, 0U);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
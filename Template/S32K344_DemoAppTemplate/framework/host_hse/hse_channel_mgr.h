@@ -0,0 +1,191 @@
+/**
+*   @file    hse_channel_mgr.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST channel manager.
+*   @details Lock-free ownership of the MU service channels (one atomic bitmap per MU instance).
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_CHANNEL_MGR_H
+#define HSE_CHANNEL_MGR_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_channel_mgr.h
+*/
+#include "hse_interface.h"
+#include "hse_mu.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Channel occupancy counters (per MU instance)
+ */
+typedef struct
+{
+    uint32_t    u32InUse;           /**< @brief    Number of channels currently owned. */
+    uint32_t    u32PeakInUse;       /**< @brief    Highest number of channels owned at the same time. */
+    uint32_t    u32Claims;          /**< @brief    Number of successful claims. */
+    uint32_t    u32ClaimFailures;   /**< @brief    Number of claims that found no free channel. */
+} hseChannelStats_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Try to take ownership of a channel.
+* @details      Atomically marks the channel as owned (LDREX/STREX, no interrupt masking).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       TRUE if the channel was free and is now owned by the caller, FALSE otherwise.
+*/
+bool_t HSE_ChannelTryAcquire(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Claim a free channel.
+* @details      Claims the next free service channel (round robin). Channel 0 is never returned
+*               (it is reserved for administrative services). The same channel cannot be handed
+*               out twice: it stays owned until HSE_ChannelRelease() or until the response of the
+*               request sent on it is received.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+*
+* @return       The claimed channel: 1 <= ch < HSE_NUM_OF_CHANNELS_PER_MU,
+*               or HSE_INVALID_CHANNEL if no channel is free.
+*/
+uint8_t HSE_ChannelClaim(uint8_t u8MuInstance);
+
+/**
+* @brief        Release a channel.
+* @details      Atomically marks the channel as free (a held channel stays owned, see HSE_ChannelHold()).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       NULL
+*/
+void HSE_ChannelRelease(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Hold a channel.
+* @details      The channel stays owned when the responses of its requests are received
+*               (HSE_ChannelRelease() has no effect on it) until HSE_ChannelUnhold().
+*               Used to send all the steps of a stream on one channel.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch), owned by the caller and idle.
+*
+* @return       NULL
+*/
+void HSE_ChannelHold(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Release a held channel.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch), held by the caller and idle
+*                               (no request in progress, the response of the last one received).
+*
+* @return       NULL
+*/
+void HSE_ChannelUnhold(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Check whether a channel is held.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       TRUE if the channel is held, FALSE otherwise.
+*/
+bool_t HSE_ChannelIsHeld(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Check whether a channel is owned.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       TRUE if the channel is owned, FALSE otherwise.
+*/
+bool_t HSE_ChannelIsBusy(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Get the occupancy counters of a MU instance.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[out]   pStats          The occupancy counters.
+*
+* @return       NULL
+*/
+void HSE_ChannelGetStats(uint8_t u8MuInstance, hseChannelStats_t* pStats);
+
+/**
+* @brief        Reset the occupancy counters of a MU instance.
+* @details      Clears the peak, claim and failure counters (the in-use count is kept).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+*
+* @return       NULL
+*/
+void HSE_ChannelResetStats(uint8_t u8MuInstance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_CHANNEL_MGR_H */
+
+/** @} */
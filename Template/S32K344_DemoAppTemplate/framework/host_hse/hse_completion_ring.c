@@ -0,0 +1,260 @@
+/**
+*   @file    hse_completion_ring.c
+*
+*   @brief   HSE HOST deferred completion queue.
+*   @details One single-producer/single-consumer ring per MU instance: the RX interrupt of the
+*            MU is the only producer, HSE_PollCompletions() the only consumer. Indexes are free
+*            running and published with release/acquire ordering, so no locking is needed.
+*
+*   @addtogroup hse_completion_ring_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_completion_ring.c
+*/
+#include <stdatomic.h>
+#include "hse_completion_ring.h"
+#include "hse_host_arena.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Completion pushed by the RX interrupt
+ */
+typedef struct
+{
+    pfAsyncCallback_t   pfCallback;
+    void*               pArg;
+    hseSrvResponse_t    response;
+    uint32_t            u32ArenaBlocks;
+    uint8_t             u8MuChannel;
+} hseCompletion_t;
+
+/*
+ * @brief   Completion ring of one MU instance
+ */
+typedef struct
+{
+    hseCompletion_t         entries[HSE_COMPLETION_RING_SIZE];
+    atomic_uint_least32_t   u32Head;        /* Written by the consumer only */
+    atomic_uint_least32_t   u32Tail;        /* Written by the producer only */
+    uint32_t                u32Peak;        /* Written by the producer only */
+    uint32_t                u32Dropped;     /* Written by the producer only */
+} hseCompletionRing_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_COMPLETION_RING_MASK    (HSE_COMPLETION_RING_SIZE - 1U)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseCompletionRing_t  completionRing[HSE_NUM_OF_MU_INSTANCES];
+static volatile bool_t      bDeferred = FALSE;
+static volatile uint32_t    u32RingHighWater = HSE_COMPLETION_RING_SIZE;
+/* Set while a consumer drains the rings: the other callers of HSE_PollCompletions() return at once */
+static atomic_flag          bConsumerActive = ATOMIC_FLAG_INIT;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Enable/disable deferred completions.
+ ******************************************************************************/
+hseSrvResponse_t HSE_EnableDeferredCompletions(bool_t bEnable, uint32_t u32HighWater)
+{
+    if((0UL == u32HighWater) || (u32HighWater > HSE_COMPLETION_RING_SIZE))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    u32RingHighWater = u32HighWater;
+    bDeferred = bEnable;
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Check whether completions are deferred.
+ ******************************************************************************/
+bool_t HSE_CompletionsDeferred(void)
+{
+    return bDeferred;
+}
+
+/*******************************************************************************
+ * Description   : Push a completion (RX interrupt of u8MuInstance only).
+ ******************************************************************************/
+bool_t HSE_CompletionPush(uint8_t u8MuInstance, uint8_t u8MuChannel, hseSrvResponse_t response,
+    pfAsyncCallback_t pfCallback, void* pArg, uint32_t u32ArenaBlocks)
+{
+    hseCompletionRing_t* pRing = &completionRing[u8MuInstance];
+    uint32_t u32Tail = atomic_load_explicit(&pRing->u32Tail, memory_order_relaxed);
+    uint32_t u32Used = u32Tail - atomic_load_explicit(&pRing->u32Head, memory_order_acquire);
+    hseCompletion_t* pEntry;
+
+    if(u32Used >= u32RingHighWater)
+    {
+        pRing->u32Dropped++;
+        return FALSE;
+    }
+
+    pEntry = &pRing->entries[u32Tail & HSE_COMPLETION_RING_MASK];
+    pEntry->pfCallback      = pfCallback;
+    pEntry->pArg            = pArg;
+    pEntry->response        = response;
+    pEntry->u32ArenaBlocks  = u32ArenaBlocks;
+    pEntry->u8MuChannel     = u8MuChannel;
+
+    /* Publish the entry */
+    atomic_store_explicit(&pRing->u32Tail, u32Tail + 1U, memory_order_release);
+
+    if((u32Used + 1UL) > pRing->u32Peak)
+    {
+        pRing->u32Peak = u32Used + 1UL;
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Run the callbacks of the queued completions.
+ ******************************************************************************/
+uint32_t HSE_PollCompletions(uint32_t u32Max)
+{
+    hseCompletionRing_t* pRing;
+    hseCompletion_t completion;
+    uint32_t u32Head;
+    uint32_t u32Done = 0UL;
+    bool_t bProgress;
+    uint8_t u8MuInstance;
+
+    /* Single consumer: the library waits poll from several tasks, only one of them drains the rings */
+    if(atomic_flag_test_and_set_explicit(&bConsumerActive, memory_order_acquire))
+    {
+        return 0UL;
+    }
+
+    /* Take one completion per MU at a time, so no MU is starved when u32Max is reached */
+    do
+    {
+        bProgress = FALSE;
+        for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+        {
+            if((0UL != u32Max) && (u32Done >= u32Max))
+            {
+                goto exit;
+            }
+
+            pRing = &completionRing[u8MuInstance];
+            u32Head = atomic_load_explicit(&pRing->u32Head, memory_order_relaxed);
+            if(u32Head == atomic_load_explicit(&pRing->u32Tail, memory_order_acquire))
+            {
+                continue;
+            }
+
+            /* Copy and free the entry before the callback, which may send a new request */
+            completion = pRing->entries[u32Head & HSE_COMPLETION_RING_MASK];
+            atomic_store_explicit(&pRing->u32Head, u32Head + 1U, memory_order_release);
+
+            completion.pfCallback(completion.response, completion.pArg);
+            HSE_ARENA_RELEASE(u8MuInstance, completion.u8MuChannel, completion.u32ArenaBlocks);
+            u32Done++;
+            bProgress = TRUE;
+        }
+    } while(bProgress);
+
+exit:
+    atomic_flag_clear_explicit(&bConsumerActive, memory_order_release);
+    return u32Done;
+}
+
+/*******************************************************************************
+ * Description   : Get the completion ring counters.
+ ******************************************************************************/
+void HSE_GetCompletionStats(hseCompletionStats_t* pStats)
+{
+    hseCompletionRing_t* pRing;
+    uint8_t u8MuInstance;
+
+    pStats->u32Pending = 0UL;
+    pStats->u32Peak    = 0UL;
+    pStats->u32Dropped = 0UL;
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        pRing = &completionRing[u8MuInstance];
+        pStats->u32Pending += atomic_load(&pRing->u32Tail) - atomic_load(&pRing->u32Head);
+        pStats->u32Dropped += pRing->u32Dropped;
+        if(pRing->u32Peak > pStats->u32Peak)
+        {
+            pStats->u32Peak = pRing->u32Peak;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Description   : Reset the peak and drop counters.
+ ******************************************************************************/
+void HSE_ResetCompletionStats(void)
+{
+    uint8_t u8MuInstance;
+
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        completionRing[u8MuInstance].u32Peak = 0UL;
+        completionRing[u8MuInstance].u32Dropped = 0UL;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
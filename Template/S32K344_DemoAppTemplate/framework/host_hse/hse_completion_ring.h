@@ -0,0 +1,171 @@
+/**
+*   @file    hse_completion_ring.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST deferred completion queue.
+*   @details Moves the asynchronous callbacks out of the MU RX interrupt: the interrupt only
+*            pushes the completion, HSE_PollCompletions() runs the callbacks from thread context.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_COMPLETION_RING_H
+#define HSE_COMPLETION_RING_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_completion_ring.h
+*/
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Number of entries of the completion ring of each MU instance (must be a power of 2) */
+#define HSE_COMPLETION_RING_SIZE    16U
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Completion ring counters (all MU instances)
+ */
+typedef struct
+{
+    uint32_t    u32Pending;         /**< @brief    Completions waiting for HSE_PollCompletions(). */
+    uint32_t    u32Peak;            /**< @brief    Highest number of completions waiting in one ring. */
+    uint32_t    u32Dropped;         /**< @brief    Completions dropped because the ring reached the high-water mark
+                                                   (their callback is never called). */
+} hseCompletionStats_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Enable or disable deferred completions.
+* @details      When enabled, the MU RX interrupt frees the channel and pushes
+*               (MU, channel, response, callback, argument) in the completion ring of the MU;
+*               the asynchronous callbacks are called by HSE_PollCompletions().
+*               When disabled (default), the callbacks are called from the interrupt.
+*               Synchronous requests are not affected.
+*
+* @param[in]    bEnable         TRUE to defer the callbacks, FALSE to call them from the interrupt.
+* @param[in]    u32HighWater    Maximum number of completions waiting in a ring:
+*                               1 <= u32HighWater <= HSE_COMPLETION_RING_SIZE.
+*                               Further completions are dropped and counted (u32Dropped):
+*                               their callback is never called, so whatever waits for it
+*                               (dispatch, batch, key provisioning, ...) is released only
+*                               by its own timeout. Size the ring for the requests that can
+*                               complete between two drains.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_INVALID_PARAM if u32HighWater is out of range.
+*
+* @pre          No asynchronous request is in flight.
+*/
+hseSrvResponse_t HSE_EnableDeferredCompletions(bool_t bEnable, uint32_t u32HighWater);
+
+/**
+* @brief        Check whether completions are deferred.
+*
+* @return       TRUE if the callbacks are called by HSE_PollCompletions(), FALSE otherwise.
+*/
+bool_t HSE_CompletionsDeferred(void);
+
+/**
+* @brief        Push a completion (MU RX interrupt context).
+* @details      Single producer per MU instance: only the RX interrupt of the MU pushes in its ring.
+*
+* @param[in]    u8MuInstance    The MU instance the response was received on.
+* @param[in]    u8MuChannel     The channel the response was received on.
+* @param[in]    response        The HSE response.
+* @param[in]    pfCallback      The callback of the request.
+* @param[in]    pArg            The callback argument (request tag).
+* @param[in]    u32ArenaBlocks  The arena blocks of the request, released after the callback.
+*
+* @return       TRUE if the completion was queued, FALSE if it was dropped.
+*/
+bool_t HSE_CompletionPush(uint8_t u8MuInstance, uint8_t u8MuChannel, hseSrvResponse_t response,
+    pfAsyncCallback_t pfCallback, void* pArg, uint32_t u32ArenaBlocks);
+
+/**
+* @brief        Run the callbacks of the queued completions.
+* @details      Drains the completion rings of all MU instances, oldest first within a MU.
+*               The rings have a single consumer: the call runs the callbacks only if no other
+*               call is in progress, otherwise it returns 0 at once and the completions are run
+*               by the caller already draining. So any task may poll, as the library waits do
+*               (HSE_BatchWait, HSE_SecOcWait, HKF_ProvisionKeys, ...). A call from a callback
+*               run by HSE_PollCompletions() returns 0.
+*
+* @param[in]    u32Max          Maximum number of callbacks to run (0 = all queued).
+*
+* @return       The number of callbacks run by this call.
+*/
+uint32_t HSE_PollCompletions(uint32_t u32Max);
+
+/**
+* @brief        Get the completion ring counters.
+*
+* @param[out]   pStats          The counters.
+*
+* @return       NULL
+*/
+void HSE_GetCompletionStats(hseCompletionStats_t* pStats);
+
+/**
+* @brief        Reset the peak and drop counters.
+*
+* @return       NULL
+*/
+void HSE_ResetCompletionStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_COMPLETION_RING_H */
+
+/** @} */
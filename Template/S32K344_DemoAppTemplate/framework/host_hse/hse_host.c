@@ -34,6 +34,14 @@ extern "C"{
 * @file           hse_host.c
 */
 #include "hse_host.h"
+#include "hse_channel_mgr.h"
+#include "hse_completion_ring.h"
+#include "hse_host_arena.h"
+#include "hse_host_stats.h"
+#include "hse_tracing.h"
+#include "host_compiler_api.h"
+#include "host_stm.h"
+#include "nvic.h"
 #include "string.h"
 #include "sys_init.h"
 
@@ -53,14 +61,13 @@ typedef struct
         };
         hseSrvResponse_t response;                 /**< @brief    Service response written in the callback (in case of sync with interrupt mode). */
     };
+    bool_t             bResponsePending;           /**< @brief    Sync with interrupt mode: response not written yet (a held channel stays owned after it). */
 } hseCallbackInfo_t;
 
 /*==================================================================================================
 *                                       LOCAL MACROS
 ==================================================================================================*/
 
-/* Timeout for blocking send/receive */
-#define HSE_MU_TIMEOUT_DURATION ((uint32_t)0xFFFFFFFFUL)
 /* Shared memeory address */
 #define HSE_SHARED_MEM_ADDR      0x22C00000UL
 #define HSE_SHARED_MEM_CHUNK_ADDR(idx) ((uintptr_t)(HSE_SHARED_MEM_ADDR + ((idx)*HSE_SHARED_MEM_CHUNK_SIZE)))
@@ -78,16 +85,9 @@ static volatile hseCallbackInfo_t            hseCallbackInfo[HSE_NUM_OF_MU_INSTA
 
 /* This is used to store all callbacks for HSE events notification handling */
 static pfGeneralPurposeCallback_t     hseNotifEventsCallbacks[HSE_NUM_OF_MU_INSTANCES] = {0};
-static uint8_t                        u8ChannelRef[HSE_NUM_OF_MU_INSTANCES] = {
-    1, 1,
-    #if (HSE_NUM_OF_MU_INSTANCES > 2)
-    1, 1
-    #endif
-    #if (HSE_NUM_OF_MU_INSTANCES > 4)
-    , 1, 1, 1, 1
-    #endif /* (HSE_NUM_OF_MU_INSTANCES > 4) */
-};
-static uint8_t volatile               hseBusyChannel[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+
+/* Busy-wait window before low-power wait */
+static uint32_t                       u32WaitSpinUs = HSE_WAIT_SPIN_US;
 
 #if defined(HSE_ENABLE_SHARED_MEM)
 
@@ -148,7 +148,13 @@ const hseTxOptions_t gSyncTxOption = {HSE_TX_SYNCHRONOUS, NULL, NULL};
 ==================================================================================================*/
 
 static void HSE_IrqAsyncSignal(uint8_t u8MuIf, uint8_t u8Channel, hseSrvResponse_t status);
-static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking(uint8_t u8MuInstance, uint8_t u8Channel);
+static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32TimeoutUs);
+static bool_t HSE_WaitResponse(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bIrqMode, uint32_t u32TimeoutUs);
+static void HSE_WaitLowPower(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32RemainingUs);
+static void HSE_CancelRequest(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bIrqMode);
+static uint32_t HSE_ServiceTimeoutUs(hseSrvId_t srvId, uint32_t u32TimeoutUs);
+static hseSrvResponse_t HSE_SendRequest(uint8_t u8MuInstance, uint8_t u8MuChannel, hseTxOptions_t txOptions,
+    hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs, bool_t bClaimed);
 
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
@@ -159,39 +165,58 @@ static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking(uint8_t u8MuInstance, uin
 static void HSE_IrqAsyncSignal(uint8_t u8MuIf, uint8_t u8Channel, hseSrvResponse_t status)
 {
     volatile hseCallbackInfo_t *pHseCallbackInfo = &hseCallbackInfo[u8MuIf][u8Channel];
+    pfAsyncCallback_t pfAsyncCallback;
+    void* pCallbackpArg;
+    uint32_t u32ArenaBlocks;
+
+    HSE_TRACE_COMPLETE(u8MuIf, u8Channel, status);
+    HSE_STATS_COMPLETE(u8MuIf, u8Channel, status);
 
     if(HSE_TX_ASYNCHRONOUS == pHseCallbackInfo->txOp) {
-        /* Invoke the callback */
-        pHseCallbackInfo->pfAsyncCallback(status, pHseCallbackInfo->pCallbackpArg);
+        pfAsyncCallback = pHseCallbackInfo->pfAsyncCallback;
+        pCallbackpArg = pHseCallbackInfo->pCallbackpArg;
 
-        /* Clear callback */
+        /* Clear callback and free the channel before invoking the callback,
+         * so that the callback is allowed to send a new request on this channel */
         pHseCallbackInfo->txOp = HSE_TX_SYNCHRONOUS;
         pHseCallbackInfo->pfAsyncCallback = NULL;
         pHseCallbackInfo->pCallbackpArg = NULL;
+        /* The arena buffers of the request stay allocated until the callback returns */
+        u32ArenaBlocks = HSE_ARENA_COMPLETE(u8MuIf, u8Channel);
+        HSE_ChannelRelease(u8MuIf, u8Channel);
+
+        /* Invoke the callback, or leave it to HSE_PollCompletions() */
+        if(HSE_CompletionsDeferred())
+        {
+            if(!HSE_CompletionPush(u8MuIf, u8Channel, status, pfAsyncCallback, pCallbackpArg, u32ArenaBlocks))
+            {
+                /* Dropped: the callback will not be called */
+                HSE_ARENA_RELEASE(u8MuIf, u8Channel, u32ArenaBlocks);
+            }
+        }
+        else
+        {
+            pfAsyncCallback(status, pCallbackpArg);
+            HSE_ARENA_RELEASE(u8MuIf, u8Channel, u32ArenaBlocks);
+        }
     } else {
         pHseCallbackInfo->response = status;
-    }
+        pHseCallbackInfo->bResponsePending = FALSE;
 
-    /* Mark channel as free */
-    hseBusyChannel[u8MuIf][u8Channel] = FALSE;
+        /* Mark channel as free */
+        HSE_ChannelRelease(u8MuIf, u8Channel);
+    }
 }
 
 /*******************************************************************************
-* Description:  Waits TIMEOUT_DURATION until the response is received.
+* Description:  Waits until the response is received or the deadline passed.
  ******************************************************************************/
-static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking( uint8_t u8MuInstance, uint8_t u8Channel )
+static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking( uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32TimeoutUs )
 {
-    uint32_t u32TimeOutCount = HSE_MU_TIMEOUT_DURATION;
-    hseSrvResponse_t u32HseMuResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    hseSrvResponse_t u32HseMuResponse = HSE_SRV_RSP_HOST_TIMEOUT;
 
     /* Wait until HSE process the request and send the response */
-    while((0UL < u32TimeOutCount) && (FALSE ==  HSE_MU_IsResponseReady(u8MuInstance, u8Channel)))
-    {
-        u32TimeOutCount--;
-    }
-
-    /* Response received if TIMEOUT did not occur */
-    if(u32TimeOutCount > 0UL)
+    if(HSE_WaitResponse(u8MuInstance, u8Channel, FALSE, u32TimeoutUs))
     {
         /* Get HSE response */
         u32HseMuResponse = HSE_MU_ReceiveResponse(u8MuInstance, u8Channel);
@@ -201,23 +226,183 @@ static hseSrvResponse_t HSE_MU_ReceiveResponseBlocking( uint8_t u8MuInstance, ui
     return u32HseMuResponse;
 }
 
-/*==================================================================================================
-*                                       GLOBAL FUNCTIONS
-==================================================================================================*/
+/*******************************************************************************
+* Description:  Waits for the response on a channel until the deadline.
+*               Spins for the spin window, then waits in low-power mode
+*               (interrupt mode only - in polling mode no event wakes the core).
+*               Returns TRUE if the response was received.
+ ******************************************************************************/
+static bool_t HSE_WaitResponse(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bIrqMode, uint32_t u32TimeoutUs)
+{
+    uint32_t u32Start;
+    uint32_t u32Elapsed;
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    for(;;)
+    {
+        if(bIrqMode ? (FALSE == hseCallbackInfo[u8MuInstance][u8Channel].bResponsePending)
+                    : HSE_MU_IsResponseReady(u8MuInstance, u8Channel))
+        {
+            return TRUE;
+        }
+
+        u32Elapsed = GetStmTimebaseUs() - u32Start;
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && (u32Elapsed >= u32TimeoutUs))
+        {
+            return FALSE;
+        }
+
+        if(bIrqMode && (u32Elapsed >= u32WaitSpinUs))
+        {
+            HSE_WaitLowPower(u8MuInstance, u8Channel,
+                (HSE_WAIT_INFINITE == u32TimeoutUs) ? HSE_WAIT_INFINITE : (u32TimeoutUs - u32Elapsed));
+        }
+    }
+}
 
 /*******************************************************************************
- * Description   : Send the request to HSE.
+* Description:  Low-power wait until the RX interrupt or the deadline.
+*               With SEVONPEND set, any interrupt becoming pending wakes WFE,
+*               including the STM_1 compare which is not enabled in NVIC.
  ******************************************************************************/
-hseSrvResponse_t HSE_Send(uint8_t u8MuInstance, uint8_t u8MuChannel,
-    hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc)
+static void HSE_WaitLowPower(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32RemainingUs)
+{
+#ifndef HSE_VIRTUAL
+    S32_SCB->SCR |= S32_SCB_SCR_SEVONPEND_MASK;
+#endif /* HSE_VIRTUAL */
+
+    if(HSE_WAIT_INFINITE != u32RemainingUs)
+    {
+        NVIC_ClearPendingIRQ(STM_1_IRQ_ID);
+        SetStmTimebaseAlarm(u32RemainingUs);
+    }
+
+    /* The RX interrupt pending after this check sets the event register, so WFE returns at once */
+    if(hseCallbackInfo[u8MuInstance][u8Channel].bResponsePending)
+    {
+        HSE_WAIT_FOR_EVENT();
+    }
+
+    if(HSE_WAIT_INFINITE != u32RemainingUs)
+    {
+        ClearStmTimebaseAlarm();
+        NVIC_ClearPendingIRQ(STM_1_IRQ_ID);
+    }
+}
+
+/*******************************************************************************
+* Description:  Cancel the request running on a channel (deadline passed).
+*               The cancel request is sent on channel 0 (administrative services),
+*               once channel 0 is owned; if another context keeps it for the whole
+*               cancel deadline, the request is not canceled.
+ ******************************************************************************/
+static void HSE_CancelRequest(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bIrqMode)
+{
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[u8MuInstance][0U];
+    uint32_t u32Start;
+
+    /* Cancel requests cannot be canceled */
+    if(0U == u8Channel)
+    {
+        return;
+    }
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+    while(!HSE_ChannelTryAcquire(u8MuInstance, 0U))
+    {
+        if((GetStmTimebaseUs() - u32Start) >= HSE_WAIT_CANCEL_TIMEOUT_US)
+        {
+            return;
+        }
+    }
+
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_CANCEL;
+    pHseSrvDesc->hseSrv.cancelSrvReq.muChannelIdx = u8Channel;
+    /* Channel 0 is released with the response of the cancel request */
+    if(HSE_SRV_RSP_HOST_CHANNEL_BUSY ==
+       HSE_SendRequest(u8MuInstance, 0U, gSyncTxOption, pHseSrvDesc, HSE_WAIT_CANCEL_TIMEOUT_US, TRUE))
+    {
+        HSE_ChannelRelease(u8MuInstance, 0U);
+    }
+
+    /* Consume the response of the canceled request (in interrupt mode the handler does it) */
+    if((FALSE == bIrqMode) && HSE_WaitResponse(u8MuInstance, u8Channel, FALSE, HSE_WAIT_CANCEL_TIMEOUT_US))
+    {
+        (void)HSE_MU_ReceiveResponse(u8MuInstance, u8Channel);
+    }
+}
+
+/*******************************************************************************
+* Description:  Deadline of a request: HSE_WAIT_DEFAULT_TIMEOUT_US is extended
+*               for the services that program the data flash or generate keys.
+ ******************************************************************************/
+static uint32_t HSE_ServiceTimeoutUs(hseSrvId_t srvId, uint32_t u32TimeoutUs)
+{
+    if(HSE_WAIT_DEFAULT_TIMEOUT_US != u32TimeoutUs)
+    {
+        return u32TimeoutUs;
+    }
+
+    switch(srvId)
+    {
+#ifdef HSE_SRV_ID_FIRMWARE_UPDATE
+        case HSE_SRV_ID_FIRMWARE_UPDATE:
+#endif
+#ifdef HSE_SRV_ID_ACTIVATE_PASSIVE_BLOCK
+        case HSE_SRV_ID_ACTIVATE_PASSIVE_BLOCK:
+#endif
+#ifdef HSE_SRV_ID_SBAF_UPDATE
+        case HSE_SRV_ID_SBAF_UPDATE:
+#endif
+#ifdef HSE_SRV_ID_ERASE_HSE_NVM_DATA
+        case HSE_SRV_ID_ERASE_HSE_NVM_DATA:
+#endif
+#ifdef HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+        case HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH:
+#endif
+        case HSE_SRV_ID_FORMAT_KEY_CATALOGS:
+        case HSE_SRV_ID_KEY_GENERATE:
+            return HSE_WAIT_LONG_TIMEOUT_US;
+        default:
+            return u32TimeoutUs;
+    }
+}
+
+/*******************************************************************************
+ * Description   : Send the request to HSE and wait the response until the deadline.
+ *                 bClaimed: the channel was claimed (or is held) by the caller.
+ ******************************************************************************/
+static hseSrvResponse_t HSE_SendRequest(uint8_t u8MuInstance, uint8_t u8MuChannel,
+    hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs, bool_t bClaimed)
 {
     hseSrvResponse_t srvResponse;
+    bool_t bAcquired;
 
     /* The MU instance and channel assumed to be in range */
-    /* Assuming the channel is free */
-	/*This logic is added to avoid the syncronization issue. HOst should send the next command
-	when receive buffer is full and channel busy status is clear */
-	
+    /* The channel is owned until the response is received: taken here if free.
+     * An owned channel is used only when the caller states it claimed it: otherwise it is
+     * owned by another context (e.g. claimed and its descriptor not sent yet) */
+    bAcquired = HSE_ChannelTryAcquire(u8MuInstance, u8MuChannel);
+    if((FALSE == bAcquired) && (FALSE == bClaimed))
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
+    /* A request still in progress on the channel (e.g. not canceled after a timeout) */
+    if(MU_CHANNEL_BUSY == HSE_MU_GetChannelStatus(u8MuInstance, u8MuChannel))
+    {
+        if(bAcquired)
+        {
+            HSE_ChannelRelease(u8MuInstance, u8MuChannel);
+        }
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    u32TimeoutUs = HSE_ServiceTimeoutUs(pHseSrvDesc->srvId, u32TimeoutUs);
+
     /* Send the request sync/async */
     if(HSE_TX_SYNCHRONOUS == txOptions.txOp)
     {
@@ -225,76 +410,118 @@ hseSrvResponse_t HSE_Send(uint8_t u8MuInstance, uint8_t u8MuChannel,
         if(0UL == (muRxEnabledInterruptMask[u8MuInstance] & (1UL << u8MuChannel))) 
         {
             /* No - send request non-blocking and wait for the HSE response blocking (polling on RSR) */
+            HSE_TRACE_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+            HSE_STATS_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+            HSE_ARENA_SUBMIT(u8MuInstance, u8MuChannel, FALSE);
             HSE_MU_SEND_NON_BLOCKING(u8MuInstance, u8MuChannel, (uintptr_t )pHseSrvDesc);
-            srvResponse = HSE_MU_ReceiveResponseBlocking(u8MuInstance, u8MuChannel);
+            srvResponse = HSE_MU_ReceiveResponseBlocking(u8MuInstance, u8MuChannel, u32TimeoutUs);
+            HSE_TRACE_COMPLETE(u8MuInstance, u8MuChannel, srvResponse);
+            HSE_STATS_COMPLETE(u8MuInstance, u8MuChannel, srvResponse);
+            if(HSE_SRV_RSP_HOST_TIMEOUT == srvResponse)
+            {
+                HSE_CancelRequest(u8MuInstance, u8MuChannel, FALSE);
+            }
+            HSE_ChannelRelease(u8MuInstance, u8MuChannel);
         } else {
             /* Yes - send request non-blocking and wait for the HSE response blocking (with interrupts) */
 
             /* Sends the request non-blocking */
-            sys_disableAllInterrupts();
-            hseBusyChannel[u8MuInstance][u8MuChannel] = TRUE;
+            hseCallbackInfo[u8MuInstance][u8MuChannel].bResponsePending = TRUE;
+            HSE_TRACE_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+            HSE_STATS_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+            HSE_ARENA_SUBMIT(u8MuInstance, u8MuChannel, FALSE);
             HSE_MU_SEND_NON_BLOCKING(u8MuInstance, u8MuChannel, (uintptr_t )pHseSrvDesc);
-            sys_enableAllInterrupts();
 
-            /* Wait the request to be done - the channel will be freed in callback */
-            while(FALSE != hseBusyChannel[u8MuInstance][u8MuChannel]);
-
-            /* Update the status to the one written in callback */
-            sys_disableAllInterrupts();
-            srvResponse = hseCallbackInfo[u8MuInstance][u8MuChannel].response;
-            sys_enableAllInterrupts();
+            /* Wait the response written by the handler - the channel is freed there, unless it is held */
+            if(HSE_WaitResponse(u8MuInstance, u8MuChannel, TRUE, u32TimeoutUs))
+            {
+                /* Update the status to the one written in callback */
+                srvResponse = hseCallbackInfo[u8MuInstance][u8MuChannel].response;
+            }
+            else
+            {
+                /* The handler frees the channel when the canceled response arrives */
+                HSE_CancelRequest(u8MuInstance, u8MuChannel, TRUE);
+                srvResponse = HSE_SRV_RSP_HOST_TIMEOUT;
+            }
         }
 
     } else { /* HSE_TX_ASYNCHRONOUS */
         volatile hseCallbackInfo_t *pHseCallbackInfo = &hseCallbackInfo[u8MuInstance][u8MuChannel];
 
-        sys_disableAllInterrupts();
-        /* Initialize callback */
+        /* Initialize callback (the RX interrupt of this channel cannot fire before the request is sent) */
         pHseCallbackInfo->txOp = HSE_TX_ASYNCHRONOUS;
         pHseCallbackInfo->pfAsyncCallback = txOptions.pfAsyncCallback;
         pHseCallbackInfo->pCallbackpArg = txOptions.pCallbackpArg;
 
         /* Sends the request non-blocking */
-        hseBusyChannel[u8MuInstance][u8MuChannel] = TRUE;
+        HSE_TRACE_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+        HSE_STATS_SUBMIT(u8MuInstance, u8MuChannel, pHseSrvDesc->srvId);
+        HSE_ARENA_SUBMIT(u8MuInstance, u8MuChannel, TRUE);
         HSE_MU_SEND_NON_BLOCKING(u8MuInstance, u8MuChannel, (uintptr_t )pHseSrvDesc);
         srvResponse = HSE_SRV_RSP_OK;
-
-        sys_enableAllInterrupts();
     }
 
     return srvResponse;
 }
 
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
 /*******************************************************************************
- * Description   : Get available channel to send request to HSE.
+ * Description   : Send the request to HSE.
  ******************************************************************************/
-uint8_t HSE_GetFreeChannel(uint8_t u8MuInstance)
+hseSrvResponse_t HSE_Send(uint8_t u8MuInstance, uint8_t u8MuChannel,
+    hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc)
 {
-    uint8_t u8Count;
-    uint8_t u8Index = u8ChannelRef[u8MuInstance];
-    uint8_t u8Channel = HSE_INVALID_CHANNEL;
+    return HSE_SendWithTimeout(u8MuInstance, u8MuChannel, txOptions, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
+}
 
-    /* Finds the next available channel from host point of view (finished callbacks for async) */
-    /* Skip channel 0 (reserved for administration services) */
-    sys_disableAllInterrupts();
-    for(u8Count = 0U; u8Count < (HSE_NUM_OF_CHANNELS_PER_MU - 1U); u8Count++)
-    {
-        if(hseBusyChannel[u8MuInstance][u8Index])
-        {
-            if((++u8Index) >= HSE_NUM_OF_CHANNELS_PER_MU)
-            {
-                u8Index = 1U;
-            }
-            continue;
-        }
+/*******************************************************************************
+ * Description   : Send the request to HSE and wait the response until the deadline.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SendWithTimeout(uint8_t u8MuInstance, uint8_t u8MuChannel,
+    hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs)
+{
+    return HSE_SendRequest(u8MuInstance, u8MuChannel, txOptions, pHseSrvDesc, u32TimeoutUs, FALSE);
+}
 
-        u8Channel = u8Index;
-        u8ChannelRef[u8MuInstance] = u8Channel;
-        break;
-    }
-    sys_enableAllInterrupts();
+/*******************************************************************************
+ * Description   : Send the request to HSE on a channel claimed by the caller.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SendOnClaimed(uint8_t u8MuInstance, uint8_t u8MuChannel,
+    hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs)
+{
+    return HSE_SendRequest(u8MuInstance, u8MuChannel, txOptions, pHseSrvDesc, u32TimeoutUs, TRUE);
+}
+
+
+/*******************************************************************************
+ * Description   : Cancel an asynchronous request in flight.
+ ******************************************************************************/
+void HSE_CancelAsync(uint8_t u8MuInstance, uint8_t u8MuChannel)
+{
+    /* The response of the canceled request is consumed by the RX interrupt handler */
+    HSE_CancelRequest(u8MuInstance, u8MuChannel, TRUE);
+}
+
+/*******************************************************************************
+ * Description   : Claim an available channel to send request to HSE.
+ ******************************************************************************/
+uint8_t HSE_GetFreeChannel(uint8_t u8MuInstance)
+{
+    /* Claims the next available channel from host point of view (finished callbacks for async) */
+    /* Skip channel 0 (reserved for administration services) */
+    return HSE_ChannelClaim(u8MuInstance);
+}
 
-    return u8Channel;
+/*******************************************************************************
+ * Description   : Set the busy-wait window before low-power wait.
+ ******************************************************************************/
+void HSE_SetWaitSpinWindow(uint32_t u32SpinUs)
+{
+    u32WaitSpinUs = u32SpinUs;
 }
 
 /*******************************************************************************
@@ -303,7 +530,8 @@ uint8_t HSE_GetFreeChannel(uint8_t u8MuInstance)
 void HSE_ReceiveInterruptHandler(uint8_t u8Mu)
 {
     uint8_t u8Ch = 0U;
-    uint32_t u32RSR = HSE_MU_READ_RECEIVE_STATUS_REGISTER(u8Mu);
+    /* The responses of the polled channels (e.g. a cancel request on channel 0) are left to their sender */
+    uint32_t u32RSR = HSE_MU_READ_RECEIVE_STATUS_REGISTER(u8Mu) & muRxEnabledInterruptMask[u8Mu];
     hseSrvResponse_t srvResponse;
 
     /* Determine the service channel on which HSE wrote the response */
@@ -38,6 +38,7 @@ extern "C"{
 */
 #include "hse_interface.h"
 #include "hse_mu.h"
+#include "hse_channel_mgr.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -67,6 +68,24 @@ extern "C"{
 #define HSE_SHARED_MEM_CHUNK_SIZE  4096U
 #endif 
 
+/* Host-side response: HSE did not answer before the deadline, the request was canceled */
+#define HSE_SRV_RSP_HOST_TIMEOUT        ((hseSrvResponse_t)0x5AA5D17EUL)
+/* Host-side response: no free channel to send the request on, nothing was sent */
+#define HSE_SRV_RSP_HOST_CHANNEL_BUSY   ((hseSrvResponse_t)0x5AA5C8B5UL)
+
+/* Wait forever (no deadline) */
+#define HSE_WAIT_INFINITE               (0xFFFFFFFFUL)
+/* Default deadline of the synchronous requests (microseconds). The services that program the
+ * data flash or search RSA primes get HSE_WAIT_LONG_TIMEOUT_US instead (see HSE_SendWithTimeout). */
+#define HSE_WAIT_DEFAULT_TIMEOUT_US     (5000000UL)
+/* Deadline of the long services: firmware update, key catalog format, NVM keystore publish,
+ * key generation (microseconds) */
+#define HSE_WAIT_LONG_TIMEOUT_US        (60000000UL)
+/* Deadline for the cancel request sent after a timeout (microseconds) */
+#define HSE_WAIT_CANCEL_TIMEOUT_US      (10000UL)
+/* Default busy-wait window before entering low-power wait (microseconds) */
+#define HSE_WAIT_SPIN_US                (20UL)
+
 /*==================================================================================================
 *                                             ENUMS
 ==================================================================================================*/
@@ -125,18 +144,97 @@ extern volatile uint32_t gHseEvents;
 * 
 * @return       hseSrvResponse_t  HSE available errors
 *
-* @pre          The channel must be a free channel (Use HSE_GetFreeChannel).
+* @pre          The channel must be free: its ownership is taken here. An owned channel (claimed by any
+*               context, e.g. with HSE_GetFreeChannel, and not sent yet) is rejected with
+*               HSE_SRV_RSP_HOST_CHANNEL_BUSY and its descriptor is not sent; a channel claimed by the caller
+*               is sent with HSE_SendOnClaimed. A channel whose previous request is still in progress in the
+*               HSE is also rejected with HSE_SRV_RSP_HOST_CHANNEL_BUSY.
+*               The gHseSrvDesc[] entry of an owned channel belongs to its owner: the helpers with a fixed
+*               channel must not share it with the channels claimed by the other contexts.
 *               For asynchronous transmission, a callback function (pfAsyncCallback) must be set; but pCallbackpArg can be NULL.
 *               The application must fill the HSE message fields (e.g selecting the HSE command, priority etc).
 *                                
 */
 hseSrvResponse_t HSE_Send(uint8_t u8MuInstance, uint8_t u8MuChannel, hseTxOptions_t txOptions, hseSrvDescriptor_t* pHseSrvDesc);
 
+/**
+* @brief        Send an HSE message with a deadline.
+* @details      Same as HSE_Send, but a synchronous request is waited at most u32TimeoutUs microseconds
+*               (measured on the STM_1 time base). The host busy-waits for the spin window
+*               (see HSE_SetWaitSpinWindow) and then, if the RX interrupt is enabled on the channel,
+*               waits in low-power mode (WFE) until the response interrupt or the deadline.
+*               When the deadline passes, the request is canceled with HSE_SRV_ID_CANCEL (sent on channel 0,
+*               which is acquired for it; the cancel is skipped if channel 0 stays owned by another context).
+*               With u32TimeoutUs = HSE_WAIT_DEFAULT_TIMEOUT_US, the long services (flash programming,
+*               key generation) are waited HSE_WAIT_LONG_TIMEOUT_US.
+*
+* @param[in]    u8MuInstance    HSE MU Instance.
+* @param[in]    u8MuChannel     The channel index.
+* @param[in]    txOptions       Tx options: synchronous or asynchronous (the deadline is ignored for asynchronous).
+* @param[in]    pHseSrvDesc     Pointer to HSE message.
+* @param[in]    u32TimeoutUs    Deadline in microseconds, or HSE_WAIT_INFINITE.
+*
+* @return       hseSrvResponse_t  HSE available errors, HSE_SRV_RSP_HOST_TIMEOUT if the deadline passed,
+*               or HSE_SRV_RSP_HOST_CHANNEL_BUSY if the channel has a request in progress (nothing was sent).
+*
+* @pre          Same as HSE_Send. STM_1 is reserved for the time base and its interrupt must not be enabled in NVIC.
+*/
+hseSrvResponse_t HSE_SendWithTimeout(uint8_t u8MuInstance, uint8_t u8MuChannel, hseTxOptions_t txOptions,
+    hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs);
+
+/**
+* @brief        Send an HSE message on a channel claimed by the caller.
+* @details      Same as HSE_SendWithTimeout, for a channel the caller owns: claimed with HSE_GetFreeChannel
+*               or HSE_ChannelClaim, or held for a stream (HSE_ChannelHold). A free channel is taken as in
+*               HSE_SendWithTimeout. The ownership is not checked: the caller states it owns the channel.
+*
+* @param[in]    u8MuInstance    HSE MU Instance.
+* @param[in]    u8MuChannel     The channel claimed by the caller.
+* @param[in]    txOptions       Tx options: synchronous or asynchronous (the deadline is ignored for asynchronous).
+* @param[in]    pHseSrvDesc     Pointer to HSE message.
+* @param[in]    u32TimeoutUs    Deadline in microseconds, or HSE_WAIT_INFINITE.
+*
+* @return       hseSrvResponse_t  Same as HSE_SendWithTimeout. On HSE_SRV_RSP_HOST_CHANNEL_BUSY the channel
+*               stays owned by the caller, who releases it (HSE_ChannelRelease).
+*/
+hseSrvResponse_t HSE_SendOnClaimed(uint8_t u8MuInstance, uint8_t u8MuChannel, hseTxOptions_t txOptions,
+    hseSrvDescriptor_t* pHseSrvDesc, uint32_t u32TimeoutUs);
+
+/**
+* @brief        Cancel an asynchronous request.
+* @details      Sends HSE_SRV_ID_CANCEL for the request in flight on the channel (on channel 0, waited
+*               at most HSE_WAIT_CANCEL_TIMEOUT_US). The callback of the request is then called with
+*               HSE_SRV_RSP_CANCELED, or with its own response if it completed first.
+*
+* @param[in]    u8MuInstance        The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8MuChannel         The channel of the request: 1 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       NULL
+*
+* @pre          The request was sent with HSE_TX_ASYNCHRONOUS and the RX interrupt of the channel is enabled.
+*/
+void HSE_CancelAsync(uint8_t u8MuInstance, uint8_t u8MuChannel);
+
+/**
+* @brief        Set the busy-wait window.
+* @details      Sets how long a synchronous request is busy-waited before the host enters low-power wait.
+*               It should be calibrated to the latency of the short services (e.g. fast CMAC),
+*               which then complete without the WFE wake-up latency.
+*
+* @param[in]    u32SpinUs       Spin window in microseconds.
+*
+* @return       NULL
+*/
+void HSE_SetWaitSpinWindow(uint32_t u32SpinUs);
+
 /**
 * @brief        Get a free channel.
-* @details      Returns the next free service channel (ch) available from the HOST point of view.
+* @details      Claims the next free service channel (ch) available from the HOST point of view (HSE_ChannelClaim).
 *               NOTE: Channel 0 is not returned by this function (it is reserved for administrative services).
-                      A channel is considered free only after the response is received or the callback function executed.
+*                     A channel is considered free only after the response is received or the callback function executed.
+*                     The channel is owned by the caller until the response of the request sent on it
+*                     (with HSE_SendOnClaimed) is received; if no request is sent, it must be given back with
+*                     HSE_ChannelRelease().
 *
 * @param[in]    u8MuInstance        The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
 *
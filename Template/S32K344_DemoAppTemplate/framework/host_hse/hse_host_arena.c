@@ -0,0 +1,271 @@
+/**
+*   @file    hse_host_arena.c
+*
+*   @version 1.0.0
+*   @brief   HSE HOST payload buffer arena.
+*   @details One atomic bitmap of allocated blocks per channel; allocation and release are single
+*            atomic read-modify-write operations, so buffers can be allocated from thread context
+*            and released from the MU RX interrupt without masking interrupts.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_arena.c
+*/
+#include <stdatomic.h>
+#include "hse_host_arena.h"
+#include "hse_channel_mgr.h"
+#include "host_compiler_api.h"
+
+#ifdef HSE_ARENA
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Pool state of one channel (bit n = block n)
+ */
+typedef struct
+{
+    atomic_uint_least32_t   u32Allocated;
+    atomic_uint_least32_t   u32RunStarts;       /**< @brief    First block of each live buffer. */
+    atomic_uint_least32_t   u32Pending;         /**< @brief    Blocks allocated since the last request sent. */
+    atomic_uint_least32_t   u32Bound;           /**< @brief    Blocks of the asynchronous request in flight. */
+    atomic_uint_least32_t   u32Releasing;       /**< @brief    Blocks of a completed async request, callback not returned. */
+    uint8_t                 u8RunBlocks[HSE_ARENA_BLOCKS_PER_CHANNEL];  /**< @brief    Buffer size, at its first block. */
+} hseArenaChannel_t;
+
+/* The allocation bitmap is 32 bits wide */
+typedef uint8_t hseArenaSizeCheck_t[((HSE_ARENA_BLOCKS_PER_CHANNEL > 0UL) && (HSE_ARENA_BLOCKS_PER_CHANNEL <= 32UL)) ? 1 : -1];
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#if defined(HSE_ENABLE_SHARED_MEM)
+/* The pools follow the service descriptors in the chunk of the MU */
+#define HSE_ARENA_POOL(u8MuInstance, u8Channel) \
+    ((uint8_t*)gHseSrvDesc[(u8MuInstance)] + HSE_ARENA_DESC_AREA_SIZE + ((u8Channel) * HSE_ARENA_CHANNEL_POOL_SIZE))
+#else
+#define HSE_ARENA_POOL(u8MuInstance, u8Channel)     (arenaPool[(u8MuInstance)][(u8Channel)])
+#endif /* defined(HSE_ENABLE_SHARED_MEM) */
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseArenaChannel_t arenaChannels[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+
+#if !defined(HSE_ENABLE_SHARED_MEM)
+/* Pools placed in system RAM */
+static uint8_t arenaPool[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU][HSE_ARENA_CHANNEL_POOL_SIZE] HSE_ALIGN_CACHE_LINE;
+#endif /* !defined(HSE_ENABLE_SHARED_MEM) */
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static uint32_t HSE_ArenaRunMask(uint32_t u32First, uint32_t u32Blocks);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Bits of u32Blocks blocks starting at block u32First.
+ ******************************************************************************/
+static uint32_t HSE_ArenaRunMask(uint32_t u32First, uint32_t u32Blocks)
+{
+    uint32_t u32Mask = (u32Blocks >= 32UL) ? 0xFFFFFFFFUL : ((1UL << u32Blocks) - 1UL);
+
+    return u32Mask << u32First;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Allocate contiguous blocks (first fit).
+ ******************************************************************************/
+void* HSE_ArenaAlloc(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32Size)
+{
+    hseArenaChannel_t* pChannel = &arenaChannels[u8MuInstance][u8Channel];
+    uint32_t u32Blocks = (u32Size + (HSE_ARENA_BLOCK_SIZE - 1UL)) / HSE_ARENA_BLOCK_SIZE;
+    uint_least32_t u32Allocated;
+    uint32_t u32First;
+    uint32_t u32Mask = 0UL;
+
+    /* The buffers of a channel belong to its owner */
+    if((0UL == u32Size) || (u32Blocks > HSE_ARENA_BLOCKS_PER_CHANNEL) || !HSE_ChannelIsBusy(u8MuInstance, u8Channel))
+    {
+        return NULL;
+    }
+
+    u32Allocated = atomic_load(&pChannel->u32Allocated);
+    do
+    {
+        for(u32First = 0UL; u32First <= (HSE_ARENA_BLOCKS_PER_CHANNEL - u32Blocks); u32First++)
+        {
+            u32Mask = HSE_ArenaRunMask(u32First, u32Blocks);
+            if(0UL == (u32Allocated & u32Mask))
+            {
+                break;
+            }
+        }
+        if(u32First > (HSE_ARENA_BLOCKS_PER_CHANNEL - u32Blocks))
+        {
+            return NULL;
+        }
+        /* u32Allocated reloaded by a failed exchange */
+    } while(!atomic_compare_exchange_weak(&pChannel->u32Allocated, &u32Allocated, u32Allocated | u32Mask));
+
+    pChannel->u8RunBlocks[u32First] = (uint8_t)u32Blocks;
+    (void)atomic_fetch_or(&pChannel->u32RunStarts, 1UL << u32First);
+    (void)atomic_fetch_or(&pChannel->u32Pending, u32Mask);
+    return HSE_ARENA_POOL(u8MuInstance, u8Channel) + (u32First * HSE_ARENA_BLOCK_SIZE);
+}
+
+/*******************************************************************************
+ * Description   : Release a buffer.
+ ******************************************************************************/
+void HSE_ArenaFree(uint8_t u8MuInstance, uint8_t u8Channel, const void* pBuffer)
+{
+    hseArenaChannel_t* pChannel = &arenaChannels[u8MuInstance][u8Channel];
+    const uint8_t* pPool = HSE_ARENA_POOL(u8MuInstance, u8Channel);
+    uint32_t u32Offset;
+    uint32_t u32First;
+    uint32_t u32Mask;
+
+    if((NULL == pBuffer) || ((const uint8_t*)pBuffer < pPool))
+    {
+        return;
+    }
+    u32Offset = (uint32_t)((const uint8_t*)pBuffer - pPool);
+    if((u32Offset >= HSE_ARENA_CHANNEL_POOL_SIZE) || (0UL != (u32Offset % HSE_ARENA_BLOCK_SIZE)))
+    {
+        return;
+    }
+
+    /* Only the start of a live buffer: an interior or already released pointer is ignored */
+    u32First = u32Offset / HSE_ARENA_BLOCK_SIZE;
+    if(0UL == (atomic_load(&pChannel->u32RunStarts) & (1UL << u32First)))
+    {
+        return;
+    }
+    u32Mask = HSE_ArenaRunMask(u32First, pChannel->u8RunBlocks[u32First]);
+
+    /* The blocks of an async request are released by the driver */
+    if(0UL != (u32Mask & ((uint32_t)atomic_load(&pChannel->u32Bound) | (uint32_t)atomic_load(&pChannel->u32Releasing))))
+    {
+        return;
+    }
+    /* A concurrent free of the same buffer releases it once */
+    if(0UL == (atomic_fetch_and(&pChannel->u32RunStarts, ~(1UL << u32First)) & (1UL << u32First)))
+    {
+        return;
+    }
+
+    (void)atomic_fetch_and(&pChannel->u32Pending, ~u32Mask);
+    (void)atomic_fetch_and(&pChannel->u32Allocated, ~u32Mask);
+}
+
+/*******************************************************************************
+ * Description   : Number of free blocks of a channel.
+ ******************************************************************************/
+uint32_t HSE_ArenaFreeBlocks(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    uint32_t u32Allocated = atomic_load(&arenaChannels[u8MuInstance][u8Channel].u32Allocated);
+    uint32_t u32Count = 0UL;
+
+    while(0UL != u32Allocated)
+    {
+        u32Allocated &= (u32Allocated - 1UL);
+        u32Count++;
+    }
+
+    return HSE_ARENA_BLOCKS_PER_CHANNEL - u32Count;
+}
+
+/*******************************************************************************
+ * Description   : Bind the allocated blocks to the request being sent.
+ ******************************************************************************/
+void HSE_ArenaSubmit(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bAsync)
+{
+    hseArenaChannel_t* pChannel = &arenaChannels[u8MuInstance][u8Channel];
+    uint32_t u32Blocks = atomic_exchange(&pChannel->u32Pending, 0U);
+
+    /* The blocks of a synchronous request stay allocated until HSE_ArenaFree() */
+    if(bAsync)
+    {
+        atomic_store(&pChannel->u32Bound, u32Blocks);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Detach the blocks of a completed asynchronous request.
+ ******************************************************************************/
+uint32_t HSE_ArenaComplete(uint8_t u8MuInstance, uint8_t u8Channel)
+{
+    hseArenaChannel_t* pChannel = &arenaChannels[u8MuInstance][u8Channel];
+    uint32_t u32Blocks = atomic_exchange(&pChannel->u32Bound, 0U);
+
+    (void)atomic_fetch_or(&pChannel->u32Releasing, u32Blocks);
+    return u32Blocks;
+}
+
+/*******************************************************************************
+ * Description   : Release the blocks of a completed asynchronous request.
+ ******************************************************************************/
+void HSE_ArenaRelease(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32Blocks)
+{
+    hseArenaChannel_t* pChannel = &arenaChannels[u8MuInstance][u8Channel];
+
+    (void)atomic_fetch_and(&pChannel->u32RunStarts, ~u32Blocks);
+    (void)atomic_fetch_and(&pChannel->u32Allocated, ~u32Blocks);
+    (void)atomic_fetch_and(&pChannel->u32Releasing, ~u32Blocks);
+}
+
+#endif /* HSE_ARENA */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,200 @@
+/**
+*   @file    hse_host_arena.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST payload buffer arena.
+*   @details Fixed-block allocator for the input/output/tag/length buffers of the requests. Each
+*            channel has its own pool of HSE_ARENA_BLOCK_SIZE blocks (one Cortex-M7 D-cache line).
+*            With HSE_ENABLE_SHARED_MEM the pools follow the service descriptors of the MU in its
+*            HSE_SHARED_MEM_CHUNK_SIZE chunk of the shared memory window, otherwise they are placed
+*            in system RAM.
+*
+*            Buffers are allocated on a channel owned by the caller (HSE_ChannelClaim(),
+*            HSE_GetFreeChannel(), HSE_CtxAcquire()) and belong to the next request sent on it:
+*            - asynchronous request: released when its callback returns;
+*            - synchronous request: still valid after HSE_Send() returns, released by the caller
+*              with HSE_ArenaFree(). Another request sent on the channel does not release them.
+*              Unlike the asynchronous case they are not released on completion: the caller reads
+*              the outputs from them after HSE_Send() returned, and only the caller knows when it
+*              is done with them.
+*
+*            Not active by default: the pools take HSE_ARENA_CHANNEL_POOL_SIZE bytes per channel
+*            (6.5 KB of system RAM for 2 MUs of 4 channels without HSE_ENABLE_SHARED_MEM).
+*            Define HSE_ARENA to use it.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_ARENA_H
+#define HSE_HOST_ARENA_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_arena.h
+*/
+#include "hse_interface.h"
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Activate/Deactivate the buffer arena (the driver hooks compile to nothing when not defined) */
+// #define HSE_ARENA
+
+/* Block size: one D-cache line, so a buffer never shares a line with another buffer */
+#define HSE_ARENA_BLOCK_SIZE            (32UL)
+
+/* Service descriptors of one MU, rounded up to a block */
+#define HSE_ARENA_DESC_AREA_SIZE        ((((uint32_t)HSE_NUM_OF_CHANNELS_PER_MU * sizeof(hseSrvDescriptor_t)) + \
+                                        (HSE_ARENA_BLOCK_SIZE - 1UL)) & ~(HSE_ARENA_BLOCK_SIZE - 1UL))
+/* Blocks of one channel: the rest of the MU chunk split between its channels (at most 32) */
+#define HSE_ARENA_BLOCKS_PER_CHANNEL    ((((uint32_t)HSE_SHARED_MEM_CHUNK_SIZE - HSE_ARENA_DESC_AREA_SIZE) / \
+                                        HSE_NUM_OF_CHANNELS_PER_MU) / HSE_ARENA_BLOCK_SIZE)
+#define HSE_ARENA_CHANNEL_POOL_SIZE     (HSE_ARENA_BLOCKS_PER_CHANNEL * HSE_ARENA_BLOCK_SIZE)
+
+#ifdef HSE_ARENA
+/* Driver hooks */
+#define HSE_ARENA_SUBMIT(u8MuInstance, u8Channel, bAsync)       HSE_ArenaSubmit((u8MuInstance), (u8Channel), (bAsync))
+#define HSE_ARENA_COMPLETE(u8MuInstance, u8Channel)             HSE_ArenaComplete((u8MuInstance), (u8Channel))
+#define HSE_ARENA_RELEASE(u8MuInstance, u8Channel, u32Blocks)   HSE_ArenaRelease((u8MuInstance), (u8Channel), (u32Blocks))
+#else
+#define HSE_ARENA_SUBMIT(u8MuInstance, u8Channel, bAsync)
+#define HSE_ARENA_COMPLETE(u8MuInstance, u8Channel)             (0UL)
+#define HSE_ARENA_RELEASE(u8MuInstance, u8Channel, u32Blocks)   ((void)(u32Blocks))
+#endif /* HSE_ARENA */
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#ifdef HSE_ARENA
+/**
+* @brief        Allocate a buffer from the pool of a channel.
+* @details      The buffer is aligned on HSE_ARENA_BLOCK_SIZE and its size is rounded up to blocks.
+*               Lock-free; may be called from an asynchronous callback.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The channel the request will be sent on, owned by the caller.
+* @param[in]    u32Size         The buffer size in bytes (1 .. HSE_ARENA_CHANNEL_POOL_SIZE).
+*
+* @return       The buffer, or NULL if the channel is not owned or there are not enough
+*               contiguous free blocks.
+*/
+void* HSE_ArenaAlloc(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32Size);
+
+/**
+* @brief        Release a buffer.
+* @details      Releases a buffer not sent yet or used by a synchronous request. Ignored for the
+*               buffers of an asynchronous request until its callback returned (these are released
+*               by the driver), and for a pointer that is not the start of a live buffer (inside a
+*               buffer, or a buffer already released).
+*
+* @param[in]    u8MuInstance    The MU instance the buffer was allocated on.
+* @param[in]    u8Channel       The channel the buffer was allocated on.
+* @param[in]    pBuffer         The buffer returned by HSE_ArenaAlloc (NULL is ignored).
+*
+* @return       NULL
+*/
+void HSE_ArenaFree(uint8_t u8MuInstance, uint8_t u8Channel, const void* pBuffer);
+
+/**
+* @brief        Number of free blocks in the pool of a channel.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       The free blocks (not necessarily contiguous).
+*/
+uint32_t HSE_ArenaFreeBlocks(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Bind the buffers of a channel to the request being sent (called by the host driver).
+* @details      The buffers allocated since the last request of the channel belong to this request:
+*               released by the driver after the callback of an asynchronous request, left to the
+*               caller (HSE_ArenaFree()) for a synchronous one.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+* @param[in]    bAsync          TRUE for an asynchronous request.
+*
+* @return       NULL
+*/
+void HSE_ArenaSubmit(uint8_t u8MuInstance, uint8_t u8Channel, bool_t bAsync);
+
+/**
+* @brief        Detach the buffers of a completed asynchronous request (called by the host driver).
+* @details      The buffers stay allocated until HSE_ArenaRelease() is called with the returned mask,
+*               after the callback of the request returned.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+*
+* @return       The blocks of the request.
+*/
+uint32_t HSE_ArenaComplete(uint8_t u8MuInstance, uint8_t u8Channel);
+
+/**
+* @brief        Release the blocks returned by HSE_ArenaComplete() (called by the host driver).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+* @param[in]    u32Blocks       The blocks to release.
+*
+* @return       NULL
+*/
+void HSE_ArenaRelease(uint8_t u8MuInstance, uint8_t u8Channel, uint32_t u32Blocks);
+#endif /* HSE_ARENA */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_ARENA_H */
+
+/** @} */
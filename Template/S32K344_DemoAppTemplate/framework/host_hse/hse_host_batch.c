@@ -0,0 +1,480 @@
+/**
+*   @file    hse_host_batch.c
+*
+*   @brief   HSE HOST batch submission.
+*   @details Fans a batch of requests out to all free channels of all MU instances and refills
+*            each channel from the MU RX interrupt as soon as its response is received.
+*
+*   @addtogroup hse_host_batch_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_batch.c
+*/
+#include <stdatomic.h>
+#include "hse_host_batch.h"
+#include "hse_completion_ring.h"
+#include "host_stm.h"
+#include "string.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* All service channels, except channel 0 (reserved for administration services) */
+#define HSE_BATCH_CHANNEL_MASK      ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* Callback argument of a request: batch generation (16 bits), MU instance and request index.
+ * The completions of an aborted batch carry an old generation and are dropped. */
+#define HSE_BATCH_ARG(u32Gen, u8Mu, u32Index) \
+    ((void*)(uintptr_t)((((uintptr_t)(u32Gen) & 0xFFFFU) << 16U) | ((uintptr_t)(u8Mu) << 8U) | (uintptr_t)(u32Index)))
+#define HSE_BATCH_ARG_GEN(pArg)     ((uint32_t)(((uintptr_t)(pArg) >> 16U) & 0xFFFFU))
+#define HSE_BATCH_ARG_MU(pArg)      ((uint8_t)(((uintptr_t)(pArg) >> 8U) & 0xFFU))
+#define HSE_BATCH_ARG_INDEX(pArg)   ((uint32_t)((uintptr_t)(pArg) & 0xFFU))
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* The batch in progress */
+static const hseSrvDescriptor_t*    pBatchDescs = NULL;
+static hseSrvResponse_t*            pBatchResponses = NULL;
+static volatile uint32_t*           pBatchUserMask = NULL;
+static uint32_t                     u32BatchCount = 0UL;
+
+static atomic_bool                  bBatchActive;
+static atomic_uint_least32_t        u32BatchGen;        /* Generation of the batch in progress */
+static atomic_uint_least32_t        u32BatchNext;       /* Next request to send */
+static atomic_uint_least32_t        u32BatchRequeued;   /* Requests to send again (their send failed) */
+static atomic_uint_least32_t        u32BatchSent;       /* Requests sent, response not received */
+static atomic_uint_least32_t        u32BatchInCallback; /* Completions running HSE_BatchComplete */
+static atomic_uint_least32_t        u32BatchMask;       /* Completed requests */
+static atomic_bool                  bBatchAborted;      /* The completions record their response only */
+
+/* Channel of each request sent, to cancel it on abort */
+static uint8_t                      au8BatchMu[HSE_BATCH_MAX_REQUESTS];
+static uint8_t                      au8BatchChannel[HSE_BATCH_MAX_REQUESTS];
+/* RX interrupts of each MU enabled by the batch, disabled again when it ends */
+static uint32_t                     au32BatchIrqEnabled[HSE_NUM_OF_MU_INSTANCES];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static bool_t HSE_BatchTakeIndex(uint32_t* pu32Index);
+static bool_t HSE_BatchSendNext(uint8_t u8MuInstance);
+static uint32_t HSE_BatchFill(void);
+static void HSE_BatchComplete(hseSrvResponse_t status, void* pArg);
+static void HSE_BatchEnd(uint32_t u32Pending);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Take the next request to send: a requeued one first.
+ *                 Returns FALSE if all requests were sent.
+ ******************************************************************************/
+static bool_t HSE_BatchTakeIndex(uint32_t* pu32Index)
+{
+    uint_least32_t u32Requeued = atomic_load(&u32BatchRequeued);
+    uint32_t u32Bit;
+
+    while(0U != u32Requeued)
+    {
+        u32Bit = (uint32_t)u32Requeued & (~(uint32_t)u32Requeued + 1UL);
+        if(atomic_compare_exchange_weak(&u32BatchRequeued, &u32Requeued, u32Requeued & ~u32Bit))
+        {
+            for(*pu32Index = 0UL; (1UL << *pu32Index) != u32Bit; (*pu32Index)++)
+            {
+            }
+            return TRUE;
+        }
+    }
+
+    *pu32Index = atomic_fetch_add(&u32BatchNext, 1U);
+    return (*pu32Index < u32BatchCount) ? TRUE : FALSE;
+}
+
+/*******************************************************************************
+ * Description   : Send the next request of the batch on a free channel of the MU.
+ *                 Returns FALSE if no channel is free or all requests were sent.
+ ******************************************************************************/
+static bool_t HSE_BatchSendNext(uint8_t u8MuInstance)
+{
+    hseTxOptions_t txOptions;
+    uint32_t u32Index;
+    uint8_t u8MuChannel;
+
+    if((0U == atomic_load(&u32BatchRequeued)) && (atomic_load(&u32BatchNext) >= u32BatchCount))
+    {
+        return FALSE;
+    }
+
+    u8MuChannel = HSE_ChannelClaim(u8MuInstance);
+    if(HSE_INVALID_CHANNEL == u8MuChannel)
+    {
+        return FALSE;
+    }
+
+    /* Take the request index only once the channel is owned */
+    if(!HSE_BatchTakeIndex(&u32Index))
+    {
+        HSE_ChannelRelease(u8MuInstance, u8MuChannel);
+        return FALSE;
+    }
+
+    memcpy(&gHseSrvDesc[u8MuInstance][u8MuChannel], &pBatchDescs[u32Index], sizeof(hseSrvDescriptor_t));
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_BatchComplete;
+    txOptions.pCallbackpArg   = HSE_BATCH_ARG(atomic_load(&u32BatchGen), u8MuInstance, u32Index);
+
+    au8BatchMu[u32Index]      = u8MuInstance;
+    au8BatchChannel[u32Index] = u8MuChannel;
+    (void)atomic_fetch_or(&u32BatchSent, 1UL << u32Index);
+    if(HSE_SRV_RSP_OK != HSE_SendOnClaimed(u8MuInstance, u8MuChannel, txOptions, &gHseSrvDesc[u8MuInstance][u8MuChannel],
+                                           HSE_WAIT_DEFAULT_TIMEOUT_US))
+    {
+        /* A request not answered yet on the channel (HSE_SRV_RSP_HOST_CHANNEL_BUSY):
+         * give the channel back and send the request later */
+        (void)atomic_fetch_and(&u32BatchSent, ~(1UL << u32Index));
+        HSE_ChannelRelease(u8MuInstance, u8MuChannel);
+        (void)atomic_fetch_or(&u32BatchRequeued, 1UL << u32Index);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*******************************************************************************
+ * Description   : Send requests on the free channels, one per MU at a time so the
+ *                 load is spread over all MU instances. Returns the number sent.
+ ******************************************************************************/
+static uint32_t HSE_BatchFill(void)
+{
+    uint32_t u32Sent = 0UL;
+    uint32_t u32Round;
+    uint8_t u8MuInstance;
+
+    do
+    {
+        u32Round = 0UL;
+        for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+        {
+            if(HSE_BatchSendNext(u8MuInstance))
+            {
+                u32Round++;
+            }
+        }
+        u32Sent += u32Round;
+    } while(0UL != u32Round);
+
+    return u32Sent;
+}
+
+/*******************************************************************************
+ * Description   : Completion callback (MU RX interrupt context).
+ ******************************************************************************/
+static void HSE_BatchComplete(hseSrvResponse_t status, void* pArg)
+{
+    uint32_t u32Index = HSE_BATCH_ARG_INDEX(pArg);
+    uint32_t u32Bit = 1UL << u32Index;
+    uint32_t u32Mask;
+
+    (void)atomic_fetch_add(&u32BatchInCallback, 1U);
+
+    /* Response of a request of an aborted batch */
+    if(HSE_BATCH_ARG_GEN(pArg) != (atomic_load(&u32BatchGen) & 0xFFFFU))
+    {
+        goto exit;
+    }
+
+    pBatchResponses[u32Index] = status;
+    u32Mask = atomic_fetch_or(&u32BatchMask, u32Bit) | u32Bit;
+    (void)atomic_fetch_and(&u32BatchSent, ~u32Bit);
+
+    /* Publish the mask; repeat if a completion on the other MU preempted the store */
+    if(NULL != pBatchUserMask)
+    {
+        do
+        {
+            u32Mask = atomic_load(&u32BatchMask);
+            *pBatchUserMask = u32Mask;
+        } while(u32Mask != atomic_load(&u32BatchMask));
+    }
+
+    /* HSE_BatchAbort() waits for the requests in flight and ends the batch */
+    if(atomic_load(&bBatchAborted))
+    {
+        goto exit;
+    }
+
+    if(HSE_BATCH_FULL_MASK(u32BatchCount) == u32Mask)
+    {
+        HSE_BatchEnd(0UL);
+        goto exit;
+    }
+
+    /* Refill the channel that was just freed; if another context took it meanwhile,
+     * the request is sent by HSE_BatchWait() once nothing is in flight */
+    (void)HSE_BatchSendNext(HSE_BATCH_ARG_MU(pArg));
+exit:
+    (void)atomic_fetch_sub(&u32BatchInCallback, 1U);
+}
+
+/*******************************************************************************
+ * Description   : End the batch: disable the RX interrupts it enabled, except on
+ *                 the channels of the requests still pending (their response frees
+ *                 the channel in the interrupt); these are disabled by the next batch.
+ ******************************************************************************/
+static void HSE_BatchEnd(uint32_t u32Pending)
+{
+    uint32_t au32Keep[HSE_NUM_OF_MU_INSTANCES] = {0UL};
+    uint32_t u32Index;
+    uint8_t u8MuInstance;
+
+    for(u32Index = 0UL; u32Index < u32BatchCount; u32Index++)
+    {
+        if(0UL != (u32Pending & (1UL << u32Index)))
+        {
+            au32Keep[au8BatchMu[u32Index]] |= 1UL << au8BatchChannel[u32Index];
+        }
+    }
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        if(0UL != (au32BatchIrqEnabled[u8MuInstance] & ~au32Keep[u8MuInstance]))
+        {
+            HSE_MU_DisableInterrupts(u8MuInstance, HSE_INT_RESPONSE,
+                                     au32BatchIrqEnabled[u8MuInstance] & ~au32Keep[u8MuInstance]);
+        }
+        au32BatchIrqEnabled[u8MuInstance] &= au32Keep[u8MuInstance];
+    }
+
+    atomic_store(&bBatchActive, false);
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Send a batch of requests on all free channels.
+ ******************************************************************************/
+hseSrvResponse_t HSE_SendBatch(const hseSrvDescriptor_t* pDescs, uint32_t u32Count,
+    hseSrvResponse_t* pResponses, volatile uint32_t* pu32CompletionMask)
+{
+    uint8_t u8MuInstance;
+    bool expected = false;
+
+    if((NULL == pDescs) || (NULL == pResponses) ||
+       (0UL == u32Count) || (u32Count > HSE_BATCH_MAX_REQUESTS))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    if(!atomic_compare_exchange_strong(&bBatchActive, &expected, true))
+    {
+        return HSE_SRV_RSP_NOT_ALLOWED;
+    }
+
+    pBatchDescs     = pDescs;
+    pBatchResponses = pResponses;
+    pBatchUserMask  = pu32CompletionMask;
+    u32BatchCount   = u32Count;
+    atomic_store(&u32BatchMask, 0U);
+    atomic_store(&u32BatchNext, 0U);
+    atomic_store(&u32BatchRequeued, 0U);
+    atomic_store(&u32BatchSent, 0U);
+    atomic_store(&bBatchAborted, false);
+    if(NULL != pu32CompletionMask)
+    {
+        *pu32CompletionMask = 0UL;
+    }
+
+    /* Completions are driven by the RX interrupt; the interrupts not enabled before
+     * are disabled again when the batch ends, so the synchronous requests poll again */
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        au32BatchIrqEnabled[u8MuInstance] |= HSE_BATCH_CHANNEL_MASK & ~muRxEnabledInterruptMask[u8MuInstance];
+        HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HSE_BATCH_CHANNEL_MASK);
+    }
+
+    if(0UL == HSE_BatchFill())
+    {
+        HSE_BatchEnd(0UL);
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Wait for the batch in progress to complete.
+ ******************************************************************************/
+hseSrvResponse_t HSE_BatchWait(uint32_t u32TimeoutUs)
+{
+    uint32_t u32Start;
+    uint32_t u32ElapsedUs;
+    uint32_t u32Index;
+
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+
+    while(atomic_load(&bBatchActive))
+    {
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        /* A refill lost its channel to another context: nothing left to refill the batch */
+        if(0U == atomic_load(&u32BatchSent))
+        {
+            (void)HSE_BatchFill();
+        }
+
+        /* The timebase is read on every pass, also without timeout (the host emulation yields there) */
+        u32ElapsedUs = GetStmTimebaseUs() - u32Start;
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && (u32ElapsedUs >= u32TimeoutUs))
+        {
+            HSE_BatchAbort();
+            return HSE_SRV_RSP_HOST_TIMEOUT;
+        }
+    }
+
+    for(u32Index = 0UL; u32Index < u32BatchCount; u32Index++)
+    {
+        if(HSE_SRV_RSP_OK != pBatchResponses[u32Index])
+        {
+            return pBatchResponses[u32Index];
+        }
+    }
+
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Abort the batch in progress.
+ ******************************************************************************/
+void HSE_BatchAbort(void)
+{
+    uint32_t u32Canceled = 0UL;
+    uint32_t u32Pending;
+    uint32_t u32Mask;
+    uint32_t u32Index;
+    uint32_t u32Start;
+
+    if(!atomic_load(&bBatchActive))
+    {
+        return;
+    }
+
+    /* No request is sent any more; a completion refilling its channel finishes first */
+    atomic_store(&bBatchAborted, true);
+    atomic_store(&u32BatchNext, u32BatchCount);
+    atomic_store(&u32BatchRequeued, 0U);
+    while(0U != atomic_load(&u32BatchInCallback))
+    {
+    }
+
+    /* Cancel the requests in flight and wait for their responses: the HSE no longer
+     * writes to the buffers of the batch and their channels are free again */
+    EnableStmTimebase();
+    u32Start = GetStmTimebaseUs();
+    u32Pending = atomic_load(&u32BatchSent);
+    while(0UL != u32Pending)
+    {
+        for(u32Index = 0UL; u32Index < u32BatchCount; u32Index++)
+        {
+            if(0UL != (u32Pending & ~u32Canceled & (1UL << u32Index)))
+            {
+                HSE_CancelAsync(au8BatchMu[u32Index], au8BatchChannel[u32Index]);
+                u32Canceled |= 1UL << u32Index;
+                u32Start = GetStmTimebaseUs();
+            }
+        }
+
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+        /* The timebase is read on every pass (the host emulation yields there) */
+        if((GetStmTimebaseUs() - u32Start) >= HSE_WAIT_CANCEL_TIMEOUT_US)
+        {
+            break;
+        }
+        u32Pending = atomic_load(&u32BatchSent);
+    }
+
+    /* The responses still missing are dropped when they arrive */
+    (void)atomic_fetch_add(&u32BatchGen, 1U);
+    while(0U != atomic_load(&u32BatchInCallback))
+    {
+    }
+    u32Pending = atomic_load(&u32BatchSent);
+
+    u32Mask = atomic_load(&u32BatchMask);
+    for(u32Index = 0UL; u32Index < u32BatchCount; u32Index++)
+    {
+        if(0UL == (u32Mask & (1UL << u32Index)))
+        {
+            pBatchResponses[u32Index] = HSE_SRV_RSP_CANCELED;
+        }
+    }
+    atomic_store(&u32BatchSent, 0U);
+    HSE_BatchEnd(u32Pending);
+}
+
+/*******************************************************************************
+ * Description   : Check whether a batch is in progress.
+ ******************************************************************************/
+bool_t HSE_BatchIsActive(void)
+{
+    return atomic_load(&bBatchActive) ? TRUE : FALSE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
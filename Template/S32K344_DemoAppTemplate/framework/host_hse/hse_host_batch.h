@@ -0,0 +1,152 @@
+/**
+*   @file    hse_host_batch.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST batch submission.
+*   @details Sends a set of independent service requests on all free channels of all MU instances.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_BATCH_H
+#define HSE_HOST_BATCH_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_batch.h
+*/
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Maximum number of requests in a batch (one bit per request in the completion mask) */
+#define HSE_BATCH_MAX_REQUESTS      32U
+
+/* Completion mask of a batch of u32Count requests */
+#define HSE_BATCH_FULL_MASK(u32Count)   \
+    (((u32Count) >= HSE_BATCH_MAX_REQUESTS) ? 0xFFFFFFFFUL : ((1UL << (u32Count)) - 1UL))
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Send a batch of requests.
+* @details      Loads every free service channel of all MU instances with requests of the batch
+*               and returns. Each completion (MU RX interrupt) writes the response of the request,
+*               sets its bit in the completion mask and refills the freed channel with the next
+*               request of the batch. If another context takes the freed channel, the remaining
+*               requests are sent by HSE_BatchWait() once no request is in flight. A request
+*               that cannot be sent (HSE_SRV_RSP_HOST_CHANNEL_BUSY) is sent again later.
+*               Only one batch can be in progress at a time.
+*               The descriptors are copied into the channel descriptors when sent, so pDescs
+*               does not have to be placed in shared memory. The buffers the descriptors point
+*               to, pResponses and pu32CompletionMask must stay valid until the batch is no
+*               longer active (HSE_BatchIsActive(), HSE_BatchWait() or HSE_BatchAbort() returned).
+*               The RX interrupts of the service channels are enabled for the batch; those not
+*               enabled before are disabled again when the batch ends.
+*
+* @param[in]    pDescs              The service descriptors.
+*                                   Must stay valid until all requests were sent.
+* @param[in]    u32Count            Number of requests: 1 <= u32Count <= HSE_BATCH_MAX_REQUESTS.
+* @param[out]   pResponses          Response of each request, valid once its mask bit is set.
+* @param[out]   pu32CompletionMask  Bit i is set when request i completed (can be NULL).
+*
+* @return       HSE_SRV_RSP_OK if the batch was started,
+*               HSE_SRV_RSP_INVALID_PARAM if a parameter is invalid,
+*               HSE_SRV_RSP_NOT_ALLOWED if another batch is in progress,
+*               HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel was free (the batch is not started).
+*/
+hseSrvResponse_t HSE_SendBatch(const hseSrvDescriptor_t* pDescs, uint32_t u32Count,
+    hseSrvResponse_t* pResponses, volatile uint32_t* pu32CompletionMask);
+
+/**
+* @brief        Wait for the batch in progress to complete.
+* @details      Runs the deferred completions (HSE_EnableDeferredCompletions) and sends the
+*               requests left when no request is in flight. On timeout, the batch is aborted
+*               (HSE_BatchAbort).
+*
+* @param[in]    u32TimeoutUs        The timeout in microseconds, or HSE_WAIT_INFINITE.
+*
+* @return       HSE_SRV_RSP_OK if all requests completed with HSE_SRV_RSP_OK,
+*               the first error response of the batch otherwise,
+*               HSE_SRV_RSP_HOST_TIMEOUT if the batch did not complete in time (it is aborted).
+*/
+hseSrvResponse_t HSE_BatchWait(uint32_t u32TimeoutUs);
+
+/**
+* @brief        Abort the batch in progress.
+* @details      The requests not sent yet are dropped. The requests in flight are canceled
+*               (HSE_CancelAsync()) and their responses awaited, so on return the HSE no longer
+*               writes to the buffers of the batch and their channels are free. A response not
+*               received within HSE_WAIT_CANCEL_TIMEOUT_US is dropped when it arrives; its channel
+*               stays owned (and its RX interrupt enabled) until then.
+*               All requests without a response are reported HSE_SRV_RSP_CANCELED, and a new
+*               batch can be started. Nothing is done if no batch is in progress.
+*               Not to be called from a completion callback.
+*
+* @return       NULL
+*/
+void HSE_BatchAbort(void);
+
+/**
+* @brief        Check whether a batch is in progress.
+*
+* @return       TRUE if a batch has requests queued or in flight, FALSE otherwise.
+*/
+bool_t HSE_BatchIsActive(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_BATCH_H */
+
+/** @} */
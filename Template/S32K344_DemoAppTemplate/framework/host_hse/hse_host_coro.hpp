@@ -0,0 +1,787 @@
+/**
+*   @file    hse_host_coro.hpp
+*
+*   @version 1.0.0
+*   @brief   HSE HOST C++20 coroutine front-end.
+*   @details Optional header-only layer for C++ applications: each crypto helper becomes an awaitable
+*            (co_await hse::cmac_verify(key, msg, tag)) sent asynchronously on a free channel of MU0.
+*            A single-threaded executor resumes the coroutines whose response was received, so
+*            straight-line code keeps every channel of the MU busy.
+*
+*            - No heap: coroutine frames come from a fixed pool (HSE_CORO_FRAME_COUNT frames of
+*              HSE_CORO_FRAME_SIZE bytes); a coroutine that does not fit is not created.
+*            - The response callback only stores the status and sets a flag, so it may run from the
+*              MU RX interrupt or from HSE_PollCompletions() (deferred completions).
+*            - The executor, the frame pool and the key slot handles are used from one thread only.
+*            - Requires C++20 coroutines; exceptions and RTTI are not used.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_CORO_HPP
+#define HSE_HOST_CORO_HPP
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_coro.hpp
+*/
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <type_traits>
+
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_completion_ring.h"
+#include "host_compiler_api.h"
+#include "hse_keys_allocator.h"
+#include "hse_host_aead.h"
+#include "hse_host_cipher.h"
+#include "hse_host_hash.h"
+#include "hse_host_mac.h"
+#include "hse_host_rng.h"
+#include "hse_host_sign.h"
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Coroutine frames available (at most 32) */
+#ifndef HSE_CORO_FRAME_COUNT
+#define HSE_CORO_FRAME_COUNT            (8UL)
+#endif
+
+/* Size of one coroutine frame in bytes (locals and awaiters alive across co_await included) */
+#ifndef HSE_CORO_FRAME_SIZE
+#define HSE_CORO_FRAME_SIZE             (256UL)
+#endif
+
+namespace hse
+{
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+namespace detail
+{
+
+static_assert((HSE_CORO_FRAME_COUNT > 0UL) && (HSE_CORO_FRAME_COUNT <= 32UL), "frame bitmap is 32 bits wide");
+
+/*
+ * @brief   Fixed pool of coroutine frames (bit n of u32Used = frame n)
+ */
+struct frame_pool
+{
+    alignas(std::max_align_t) static inline uint8_t au8Frames[HSE_CORO_FRAME_COUNT][HSE_CORO_FRAME_SIZE];
+    static inline uint32_t u32Used = 0UL;
+
+    static void* alloc(std::size_t size) noexcept
+    {
+        if(size > HSE_CORO_FRAME_SIZE)
+        {
+            return nullptr;
+        }
+        for(uint32_t u32Frame = 0UL; u32Frame < HSE_CORO_FRAME_COUNT; u32Frame++)
+        {
+            if(0UL == (u32Used & (1UL << u32Frame)))
+            {
+                u32Used |= (1UL << u32Frame);
+                return au8Frames[u32Frame];
+            }
+        }
+        return nullptr;
+    }
+
+    static void free(void* pFrame) noexcept
+    {
+        uint32_t u32Frame = (uint32_t)(((uint8_t*)pFrame - &au8Frames[0][0]) / HSE_CORO_FRAME_SIZE);
+
+        u32Used &= ~(1UL << u32Frame);
+    }
+
+    static uint32_t available() noexcept
+    {
+        uint32_t u32Count = 0UL;
+
+        for(uint32_t u32Frame = 0UL; u32Frame < HSE_CORO_FRAME_COUNT; u32Frame++)
+        {
+            u32Count += (0UL == (u32Used & (1UL << u32Frame))) ? 1UL : 0UL;
+        }
+        return u32Count;
+    }
+};
+
+/*
+ * @brief   A request sent by an awaiting coroutine
+ */
+class request
+{
+public:
+    request() noexcept = default;
+    request(const request&) = delete;
+    request& operator=(const request&) = delete;
+
+    /* Send the request with txOptions; HSE_SRV_RSP_HOST_CHANNEL_BUSY when no channel is free */
+    virtual hseSrvResponse_t send(hseTxOptions_t txOptions) noexcept = 0;
+
+    /* Response callback (MU RX interrupt or HSE_PollCompletions) */
+    static void on_response(hseSrvResponse_t status, void* pArg) noexcept
+    {
+        request* pRequest = static_cast<request*>(pArg);
+
+        pRequest->status = status;
+        pRequest->bDone.store(true, std::memory_order_release);
+    }
+
+    request*                    pNext = nullptr;
+    std::coroutine_handle<>     hAwaiting;
+    std::atomic<bool>           bDone {false};
+    hseSrvResponse_t            status = HSE_SRV_RSP_GENERAL_ERROR;
+
+protected:
+    ~request() = default;
+};
+
+/*
+ * @brief   Promise state shared by all task types
+ */
+struct promise_base
+{
+    std::coroutine_handle<>     hContinuation;
+    bool                        bDetached = false;
+
+    static void* operator new(std::size_t size) noexcept
+    {
+        return frame_pool::alloc(size);
+    }
+
+    static void operator delete(void* pFrame) noexcept
+    {
+        frame_pool::free(pFrame);
+    }
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() const noexcept
+    {
+        std::terminate();
+    }
+};
+
+/* Resume the awaiting coroutine, or release the frame of a detached task */
+struct final_awaiter
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> hDone) noexcept
+    {
+        promise_base& promise = hDone.promise();
+
+        if(promise.hContinuation)
+        {
+            return promise.hContinuation;
+        }
+        if(promise.bDetached)
+        {
+            hDone.destroy();
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+} /* namespace detail */
+
+template <typename T = void>
+class task;
+
+namespace detail
+{
+
+template <typename T>
+struct promise : promise_base
+{
+    T value {};
+
+    task<T> get_return_object() noexcept;
+    static task<T> get_return_object_on_allocation_failure() noexcept;
+
+    final_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void return_value(T result) noexcept
+    {
+        value = result;
+    }
+};
+
+template <>
+struct promise<void> : promise_base
+{
+    task<void> get_return_object() noexcept;
+    static task<void> get_return_object_on_allocation_failure() noexcept;
+
+    final_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void return_void() const noexcept
+    {
+    }
+};
+
+} /* namespace detail */
+
+/*
+ * @brief   Lazily started coroutine, awaited by another coroutine or spawned on the executor.
+ * @details A task whose frame could not be allocated is empty (operator bool is false) and must
+ *          not be awaited or spawned.
+ */
+template <typename T>
+class task
+{
+public:
+    using promise_type = detail::promise<T>;
+
+    task() noexcept = default;
+
+    explicit task(std::coroutine_handle<promise_type> hCoro) noexcept : hCoro(hCoro)
+    {
+    }
+
+    task(task&& other) noexcept : hCoro(other.hCoro)
+    {
+        other.hCoro = nullptr;
+    }
+
+    task& operator=(task&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            hCoro = other.hCoro;
+            other.hCoro = nullptr;
+        }
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(hCoro);
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> hAwaiting) noexcept
+    {
+        hCoro.promise().hContinuation = hAwaiting;
+        return hCoro;
+    }
+
+    T await_resume() const noexcept
+    {
+        if constexpr(!std::is_void_v<T>)
+        {
+            return hCoro.promise().value;
+        }
+    }
+
+    /* Give up the ownership of the frame (released when the coroutine completes) */
+    std::coroutine_handle<promise_type> detach() noexcept
+    {
+        std::coroutine_handle<promise_type> hDetached = hCoro;
+
+        hCoro = nullptr;
+        if(hDetached)
+        {
+            hDetached.promise().bDetached = true;
+        }
+        return hDetached;
+    }
+
+private:
+    void reset() noexcept
+    {
+        if(hCoro)
+        {
+            hCoro.destroy();
+            hCoro = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> hCoro;
+};
+
+namespace detail
+{
+
+template <typename T>
+inline task<T> promise<T>::get_return_object() noexcept
+{
+    return task<T>(std::coroutine_handle<promise<T>>::from_promise(*this));
+}
+
+template <typename T>
+inline task<T> promise<T>::get_return_object_on_allocation_failure() noexcept
+{
+    return task<T>();
+}
+
+inline task<void> promise<void>::get_return_object() noexcept
+{
+    return task<void>(std::coroutine_handle<promise<void>>::from_promise(*this));
+}
+
+inline task<void> promise<void>::get_return_object_on_allocation_failure() noexcept
+{
+    return task<void>();
+}
+
+} /* namespace detail */
+
+/*
+ * @brief   Single-threaded executor of the coroutine front-end.
+ * @details Started tasks run until their first co_await; a request is sent at once on a free channel
+ *          of MU0, or queued (FIFO) until a channel is released. poll() resumes the coroutines whose
+ *          response was received and sends the queued requests.
+ */
+class executor
+{
+public:
+    static executor& instance() noexcept
+    {
+        static executor exec;
+
+        return exec;
+    }
+
+    /* Start a task; the frame is released when the task completes. False for an empty task. */
+    template <typename T>
+    bool spawn(task<T>&& work) noexcept
+    {
+        std::coroutine_handle<> hCoro = work.detach();
+
+        if(!hCoro)
+        {
+            return false;
+        }
+        hCoro.resume();
+        return true;
+    }
+
+    /* Send the request of an awaiting coroutine. False if it completed at once (send error). */
+    bool submit(detail::request& req, std::coroutine_handle<> hAwaiting) noexcept
+    {
+        req.hAwaiting = hAwaiting;
+
+        /* Keep the order of the requests waiting for a channel */
+        if(nullptr != pPendingHead)
+        {
+            enqueue_pending(req);
+            return true;
+        }
+
+        send(req);
+        if(HSE_SRV_RSP_HOST_CHANNEL_BUSY == req.status)
+        {
+            enqueue_pending(req);
+            return true;
+        }
+        return (HSE_SRV_RSP_OK == req.status);
+    }
+
+    /*
+     * Run the completed requests: drain the deferred completions, resume the coroutines whose
+     * response was received, then send the requests waiting for a channel.
+     * Returns the number of coroutines resumed.
+     */
+    uint32_t poll() noexcept
+    {
+        uint32_t u32Resumed = 0UL;
+        detail::request** ppLink = &pInFlight;
+
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        while(nullptr != *ppLink)
+        {
+            detail::request* pRequest = *ppLink;
+
+            if(pRequest->bDone.load(std::memory_order_acquire))
+            {
+                /* New requests are inserted at the head, ppLink stays valid */
+                *ppLink = pRequest->pNext;
+                pRequest->hAwaiting.resume();
+                u32Resumed++;
+            }
+            else
+            {
+                ppLink = &pRequest->pNext;
+            }
+        }
+
+        while(nullptr != pPendingHead)
+        {
+            detail::request* pRequest = pPendingHead;
+
+            send(*pRequest);
+            if(HSE_SRV_RSP_HOST_CHANNEL_BUSY == pRequest->status)
+            {
+                break;
+            }
+
+            pPendingHead = pRequest->pNext;
+            if(nullptr == pPendingHead)
+            {
+                pPendingTail = nullptr;
+            }
+            if(HSE_SRV_RSP_OK == pRequest->status)
+            {
+                pRequest->pNext = pInFlight;
+                pInFlight = pRequest;
+            }
+            else
+            {
+                pRequest->hAwaiting.resume();
+                u32Resumed++;
+            }
+        }
+        return u32Resumed;
+    }
+
+    /* Poll until no request is in flight or waiting; waits for the MU RX interrupt when idle */
+    void run() noexcept
+    {
+        while(busy())
+        {
+            /* Requests still waiting after poll() found every channel busy: they wait for a response too */
+            if((0UL == poll()) && !any_done())
+            {
+                /* A response received after the check sets the event register (SEVONPEND) */
+                HSE_WAIT_FOR_EVENT();
+            }
+        }
+    }
+
+    bool busy() const noexcept
+    {
+        return (nullptr != pInFlight) || (nullptr != pPendingHead);
+    }
+
+private:
+    executor() noexcept = default;
+
+    /* Send a request (status: HSE_SRV_RSP_OK once sent) and link it in flight if sent at once */
+    void send(detail::request& req) noexcept
+    {
+        const hseTxOptions_t txOptions = { HSE_TX_ASYNCHRONOUS, &detail::request::on_response, &req };
+
+        req.bDone.store(false, std::memory_order_relaxed);
+        req.status = req.send(txOptions);
+        if((HSE_SRV_RSP_OK == req.status) && (nullptr == pPendingHead))
+        {
+            /* The response may already be in (bDone set); poll() picks it up */
+            req.pNext = pInFlight;
+            pInFlight = &req;
+        }
+    }
+
+    void enqueue_pending(detail::request& req) noexcept
+    {
+        req.pNext = nullptr;
+        if(nullptr == pPendingTail)
+        {
+            pPendingHead = &req;
+        }
+        else
+        {
+            pPendingTail->pNext = &req;
+        }
+        pPendingTail = &req;
+    }
+
+    bool any_done() const noexcept
+    {
+        for(const detail::request* pRequest = pInFlight; nullptr != pRequest; pRequest = pRequest->pNext)
+        {
+            if(pRequest->bDone.load(std::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    detail::request*    pInFlight = nullptr;
+    detail::request*    pPendingHead = nullptr;
+    detail::request*    pPendingTail = nullptr;
+};
+
+/*
+ * @brief   Awaitable request built from the asynchronous form of a crypto helper.
+ * @details Send is called with the TX options of the request: hseSrvResponse_t(hseTxOptions_t).
+ *          The awaiter lives in the coroutine frame until the response, so values captured by Send
+ *          (e.g. a tag length passed by address) stay valid while the HSE uses them.
+ */
+template <typename Send>
+class service final : public detail::request
+{
+public:
+    explicit service(Send sendFn) noexcept : sendFn(sendFn)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> hAwaiting) noexcept
+    {
+        return executor::instance().submit(*this, hAwaiting);
+    }
+
+    hseSrvResponse_t await_resume() const noexcept
+    {
+        return status;
+    }
+
+private:
+    hseSrvResponse_t send(hseTxOptions_t txOptions) noexcept override
+    {
+        return sendFn(txOptions);
+    }
+
+    Send sendFn;
+};
+
+/*
+ * @brief   RAII handle of a key slot allocated with HKF_AllocKeySlot (released with HKF_FreeKeySlot).
+ * @details The key must not be used by a request in flight when the handle is destroyed.
+ */
+class key_slot
+{
+public:
+    key_slot() noexcept = default;
+
+    static key_slot alloc(bool_t isNvmKey, hseKeyType_t keyType, uint16_t maxKeyBitLength,
+                          hseSrvResponse_t* pStatus = nullptr) noexcept
+    {
+        key_slot slot;
+        hseSrvResponse_t status = HKF_AllocKeySlot(isNvmKey, keyType, maxKeyBitLength, &slot.keyHandle);
+
+        if(HSE_SRV_RSP_OK != status)
+        {
+            slot.keyHandle = HSE_INVALID_KEY_HANDLE;
+        }
+        if(nullptr != pStatus)
+        {
+            *pStatus = status;
+        }
+        return slot;
+    }
+
+    key_slot(key_slot&& other) noexcept : keyHandle(other.release())
+    {
+    }
+
+    key_slot& operator=(key_slot&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            keyHandle = other.release();
+        }
+        return *this;
+    }
+
+    key_slot(const key_slot&) = delete;
+    key_slot& operator=(const key_slot&) = delete;
+
+    ~key_slot()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return HSE_INVALID_KEY_HANDLE != keyHandle;
+    }
+
+    hseKeyHandle_t get() const noexcept
+    {
+        return keyHandle;
+    }
+
+    /* Keep the slot allocated and give up the handle */
+    hseKeyHandle_t release() noexcept
+    {
+        hseKeyHandle_t released = keyHandle;
+
+        keyHandle = HSE_INVALID_KEY_HANDLE;
+        return released;
+    }
+
+    void reset() noexcept
+    {
+        if(HSE_INVALID_KEY_HANDLE != keyHandle)
+        {
+            (void)HKF_FreeKeySlot(&keyHandle);
+            keyHandle = HSE_INVALID_KEY_HANDLE;
+        }
+    }
+
+private:
+    hseKeyHandle_t keyHandle = HSE_INVALID_KEY_HANDLE;
+};
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/* Awaitable of any asynchronous helper: co_await hse::call(AesEncryptAsync, key, ...) */
+template <typename... Args>
+inline auto call(hseSrvResponse_t (*pfAsync)(hseTxOptions_t, Args...), std::type_identity_t<Args>... args) noexcept
+{
+    auto sendFn = [=](hseTxOptions_t txOptions) noexcept { return pfAsync(txOptions, args...); };
+
+    return service<decltype(sendFn)>(sendFn);
+}
+
+/* Run a coroutine on the executor (see executor::spawn) */
+template <typename T>
+inline bool spawn(task<T>&& work) noexcept
+{
+    return executor::instance().spawn(static_cast<task<T>&&>(work));
+}
+
+/* Run the executor until all requests completed */
+inline void run() noexcept
+{
+    executor::instance().run();
+}
+
+inline auto cmac_generate(hseKeyHandle_t keyHandle, std::span<const uint8_t> msg, uint32_t& tagLength,
+                          uint8_t* pTag) noexcept
+{
+    return call(AesCmacGenerateAsync, keyHandle, (uint32_t)msg.size(), msg.data(), &tagLength, pTag,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto cmac_verify(hseKeyHandle_t keyHandle, std::span<const uint8_t> msg,
+                        std::span<const uint8_t> tag) noexcept
+{
+    const uint32_t u32TagLength = (uint32_t)tag.size();
+    const uint32_t u32MsgLength = (uint32_t)msg.size();
+    const uint8_t* pMsg = msg.data();
+    const uint8_t* pTag = tag.data();
+    /* The tag length is read by the HSE from the awaiter */
+    auto sendFn = [=](hseTxOptions_t txOptions) noexcept {
+        return AesCmacVerifyAsync(txOptions, keyHandle, u32MsgLength, pMsg, &u32TagLength, pTag,
+                                  HSE_SGT_OPTION_NONE);
+    };
+
+    return service<decltype(sendFn)>(sendFn);
+}
+
+inline auto hmac_generate(hseKeyHandle_t keyHandle, hseHashAlgo_t hashAlgo, std::span<const uint8_t> msg,
+                          uint32_t& tagLength, uint8_t* pTag) noexcept
+{
+    return call(HmacGenerateAsync, keyHandle, hashAlgo, (uint32_t)msg.size(), msg.data(), &tagLength, pTag,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto hash(hseHashAlgo_t hashAlgo, std::span<const uint8_t> msg, uint32_t& hashLength,
+                 uint8_t* pHash) noexcept
+{
+    return call(HashDataAsync, hashAlgo, (uint32_t)msg.size(), msg.data(), &hashLength, pHash,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto aes_encrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t blockMode, const uint8_t* pIV,
+                        std::span<const uint8_t> input, uint8_t* pOutput) noexcept
+{
+    return call(AesEncryptAsync, keyHandle, blockMode, pIV, (uint32_t)input.size(), input.data(), pOutput,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto aes_decrypt(hseKeyHandle_t keyHandle, hseCipherBlockMode_t blockMode, const uint8_t* pIV,
+                        std::span<const uint8_t> input, uint8_t* pOutput) noexcept
+{
+    return call(AesDecryptAsync, keyHandle, blockMode, pIV, (uint32_t)input.size(), input.data(), pOutput,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto gcm_encrypt(hseKeyHandle_t keyHandle, std::span<const uint8_t> iv, std::span<const uint8_t> aad,
+                        std::span<const uint8_t> plainText, std::span<uint8_t> tag, uint8_t* pCipherText) noexcept
+{
+    return call(AesGcmEncryptAsync, keyHandle, (uint32_t)iv.size(), iv.data(), (uint32_t)aad.size(), aad.data(),
+                (uint32_t)plainText.size(), plainText.data(), (uint32_t)tag.size(), tag.data(), pCipherText,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto gcm_decrypt(hseKeyHandle_t keyHandle, std::span<const uint8_t> iv, std::span<const uint8_t> aad,
+                        std::span<const uint8_t> cipherText, std::span<uint8_t> tag, uint8_t* pPlainText) noexcept
+{
+    return call(AesGcmDecryptAsync, keyHandle, (uint32_t)iv.size(), iv.data(), (uint32_t)aad.size(), aad.data(),
+                (uint32_t)cipherText.size(), cipherText.data(), (uint32_t)tag.size(), tag.data(), pPlainText,
+                HSE_SGT_OPTION_NONE);
+}
+
+inline auto random(hseRngClass_t rngClass, std::span<uint8_t> output) noexcept
+{
+    return call(GetRngNumAsync, output.data(), (uint32_t)output.size(), rngClass);
+}
+
+} /* namespace hse */
+
+#endif /* HSE_HOST_CORO_HPP */
+
+/** @} */
@@ -0,0 +1,248 @@
+/**
+*   @file    hse_host_ctx.c
+*
+*   @version 1.0.0
+*   @brief   HSE HOST request context.
+*   @details Channel selection and send of the requests built by the crypto helpers, and the
+*            channel held for each stream sent on a context claiming a channel per request.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_ctx.c
+*/
+#include "hse_host_ctx.h"
+#include "host_stm.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Channel held for each stream by the synchronous contexts claiming a channel per request
+ * (0: none - channel 0 is never claimed) */
+static volatile uint8_t ctxStreamChannel[HSE_NUM_OF_MU_INSTANCES][HSE_STREAM_COUNT];
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+const hseCtx_t gHseDefaultCtx = HSE_CTX_INIT(0U);
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Select the channel of the next request of a context.
+ ******************************************************************************/
+hseSrvDescriptor_t* HSE_CtxAcquire(const hseCtx_t* pCtx, uint8_t* pu8Channel)
+{
+    uint8_t u8Channel = pCtx->u8MuChannel;
+    uint32_t u32Start;
+
+    if(HSE_INVALID_CHANNEL == u8Channel)
+    {
+        /* Owned until the response is received */
+        u8Channel = HSE_ChannelClaim(pCtx->u8MuInstance);
+
+        /* A synchronous request waits for the requests in progress, up to its deadline */
+        if((HSE_INVALID_CHANNEL == u8Channel) && (HSE_TX_SYNCHRONOUS == pCtx->txOptions.txOp))
+        {
+            EnableStmTimebase();
+            u32Start = GetStmTimebaseUs();
+            do
+            {
+                u8Channel = HSE_ChannelClaim(pCtx->u8MuInstance);
+            } while((HSE_INVALID_CHANNEL == u8Channel) &&
+                    ((HSE_WAIT_INFINITE == pCtx->u32TimeoutUs) ||
+                     ((GetStmTimebaseUs() - u32Start) < pCtx->u32TimeoutUs)));
+        }
+
+        if(HSE_INVALID_CHANNEL == u8Channel)
+        {
+            return NULL;
+        }
+    }
+
+    *pu8Channel = u8Channel;
+    return &gHseSrvDesc[pCtx->u8MuInstance][u8Channel];
+}
+
+/*******************************************************************************
+ * Description   : Select the channel of a step of a stream.
+ ******************************************************************************/
+hseSrvDescriptor_t* HSE_CtxStreamAcquire(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+    uint8_t* pu8Channel, hseSrvResponse_t* pStatus)
+{
+    hseSrvDescriptor_t* pHseSrvDesc;
+    uint8_t u8Channel;
+
+    *pStatus = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    if((HSE_ACCESS_MODE_ONE_PASS == accessMode) || (HSE_INVALID_CHANNEL != pCtx->u8MuChannel))
+    {
+        return HSE_CtxAcquire(pCtx, pu8Channel);
+    }
+
+    /* The asynchronous steps need a stream context: the channel is held until the caller closes it */
+    if((HSE_TX_SYNCHRONOUS != pCtx->txOptions.txOp) || (streamId >= HSE_STREAM_COUNT))
+    {
+        *pStatus = HSE_SRV_RSP_INVALID_PARAM;
+        return NULL;
+    }
+
+    u8Channel = ctxStreamChannel[pCtx->u8MuInstance][streamId];
+    if(0U != u8Channel)
+    {
+        /* Restarted stream: the channel is still held */
+        *pu8Channel = u8Channel;
+        return &gHseSrvDesc[pCtx->u8MuInstance][u8Channel];
+    }
+
+    if(HSE_ACCESS_MODE_START != accessMode)
+    {
+        *pStatus = HSE_SRV_RSP_STREAMING_MODE_FAILURE;
+        return NULL;
+    }
+
+    pHseSrvDesc = HSE_CtxAcquire(pCtx, pu8Channel);
+    if(NULL != pHseSrvDesc)
+    {
+        HSE_ChannelHold(pCtx->u8MuInstance, *pu8Channel);
+        ctxStreamChannel[pCtx->u8MuInstance][streamId] = *pu8Channel;
+    }
+    return pHseSrvDesc;
+}
+
+/*******************************************************************************
+ * Description   : Send a request with the TX options and deadline of a context.
+ ******************************************************************************/
+hseSrvResponse_t HSE_CtxSend(const hseCtx_t* pCtx, uint8_t u8Channel, hseSrvDescriptor_t* pHseSrvDesc)
+{
+    /* The channel was claimed by HSE_CtxAcquire or is held for the stream context; a fixed channel is taken here */
+    if((HSE_INVALID_CHANNEL == pCtx->u8MuChannel) || pCtx->bHeldChannel)
+    {
+        return HSE_SendOnClaimed(pCtx->u8MuInstance, u8Channel, pCtx->txOptions, pHseSrvDesc, pCtx->u32TimeoutUs);
+    }
+    return HSE_SendWithTimeout(pCtx->u8MuInstance, u8Channel, pCtx->txOptions, pHseSrvDesc, pCtx->u32TimeoutUs);
+}
+
+/*******************************************************************************
+ * Description   : Send a step of a stream; release the stream channel after
+ *                 the FINISH or a failed step. After a timeout the canceled
+ *                 request may still be in progress: the channel stays held
+ *                 for the next START of the stream.
+ ******************************************************************************/
+hseSrvResponse_t HSE_CtxStreamSend(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+    uint8_t u8Channel, hseSrvDescriptor_t* pHseSrvDesc)
+{
+    hseSrvResponse_t srvResponse = HSE_CtxSend(pCtx, u8Channel, pHseSrvDesc);
+
+    if((HSE_ACCESS_MODE_ONE_PASS != accessMode) && (HSE_INVALID_CHANNEL == pCtx->u8MuChannel) &&
+       (HSE_SRV_RSP_HOST_TIMEOUT != srvResponse) &&
+       ((HSE_ACCESS_MODE_FINISH == accessMode) || (HSE_SRV_RSP_OK != srvResponse)))
+    {
+        ctxStreamChannel[pCtx->u8MuInstance][streamId] = 0U;
+        HSE_ChannelUnhold(pCtx->u8MuInstance, u8Channel);
+    }
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Claim and hold the channel of a stream context.
+ ******************************************************************************/
+hseSrvResponse_t HSE_CtxStreamOpen(const hseCtx_t* pCtx, hseCtx_t* pStreamCtx)
+{
+    uint8_t u8Channel;
+
+    *pStreamCtx = *pCtx;
+    pStreamCtx->bHeldChannel = FALSE;
+    if(HSE_INVALID_CHANNEL == pCtx->u8MuChannel)
+    {
+        if(NULL == HSE_CtxAcquire(pCtx, &u8Channel))
+        {
+            return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+        }
+        HSE_ChannelHold(pCtx->u8MuInstance, u8Channel);
+        pStreamCtx->u8MuChannel = u8Channel;
+        pStreamCtx->bHeldChannel = TRUE;
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Release the channel of a stream context.
+ ******************************************************************************/
+void HSE_CtxStreamClose(hseCtx_t* pStreamCtx)
+{
+    if(pStreamCtx->bHeldChannel)
+    {
+        HSE_ChannelUnhold(pStreamCtx->u8MuInstance, pStreamCtx->u8MuChannel);
+        pStreamCtx->u8MuChannel = HSE_INVALID_CHANNEL;
+        pStreamCtx->bHeldChannel = FALSE;
+    }
+}
+
+/*******************************************************************************
+ * Description   : Release a claimed channel no request was sent on.
+ ******************************************************************************/
+void HSE_CtxAbort(const hseCtx_t* pCtx, uint8_t u8Channel)
+{
+    /* A fixed channel belongs to the caller */
+    if(HSE_INVALID_CHANNEL == pCtx->u8MuChannel)
+    {
+        HSE_ChannelRelease(pCtx->u8MuInstance, u8Channel);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
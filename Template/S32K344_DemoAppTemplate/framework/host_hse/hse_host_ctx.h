@@ -0,0 +1,277 @@
+/**
+*   @file    hse_host_ctx.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST request context.
+*   @details A request context selects where and how the crypto helpers send their requests:
+*            the MU instance, the channel, the TX options and the deadline. With the channel left
+*            to HSE_INVALID_CHANNEL, every request claims a free channel of the MU for its own
+*            duration (see HSE_ChannelClaim), so the helpers can be called concurrently from several
+*            tasks/interrupts without two requests sharing a service descriptor.
+*            The HSE rejects the UPDATE/FINISH steps of a stream sent on another channel than its
+*            START (HSE_SRV_RSP_STREAMING_MODE_FAILURE): a stream is sent on a stream context
+*            (HSE_CtxStreamOpen), whose channel is held from the START to the FINISH. The
+*            synchronous helpers do it themselves when their context claims a channel per request.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_CTX_H
+#define HSE_HOST_CTX_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_ctx.h
+*/
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Synchronous context on a MU instance: channel claimed per request, default deadline */
+#define HSE_CTX_INIT(u8MuInstance)                                              \
+    { (uint8_t)(u8MuInstance), HSE_INVALID_CHANNEL,                             \
+      { HSE_TX_SYNCHRONOUS, NULL, NULL }, HSE_WAIT_DEFAULT_TIMEOUT_US, FALSE }
+
+/* Asynchronous context on a MU instance: channel claimed per request */
+#define HSE_CTX_INIT_ASYNC(u8MuInstance, pfCallback, pArg)                      \
+    { (uint8_t)(u8MuInstance), HSE_INVALID_CHANNEL,                             \
+      { HSE_TX_ASYNCHRONOUS, (pfCallback), (pArg) }, HSE_WAIT_DEFAULT_TIMEOUT_US, FALSE }
+
+/* Remove the parentheses around a parameter/argument list */
+#define HSE_CTX_LIST(...)               __VA_ARGS__
+
+/*
+ * Define the asynchronous form of a helper from its context form name##Ctx:
+ *   name##Async(txOptions, params)         - MU of gHseDefaultCtx, channel claimed per request, txOptions
+ * params is the parenthesized parameter list of name##Ctx without pCtx, args the parenthesized
+ * names of these parameters. With HSE_TX_ASYNCHRONOUS, name##Async returns HSE_SRV_RSP_OK once the
+ * request is sent (or HSE_SRV_RSP_HOST_CHANNEL_BUSY) and the response is passed to the callback;
+ * the buffers must stay valid until then.
+ */
+#define HSE_CTX_DEFINE_ASYNC(name, params, args)                                            \
+    hseSrvResponse_t name##Async(hseTxOptions_t txOptions, HSE_CTX_LIST params)             \
+    {                                                                                       \
+        const hseCtx_t ctx = HSE_CtxOnChannel(gHseDefaultCtx.u8MuInstance, HSE_INVALID_CHANNEL, txOptions); \
+        return name##Ctx(&ctx, HSE_CTX_LIST args);                                          \
+    }
+
+/*
+ * Define the asynchronous form of a streaming helper from its context form name##Ctx:
+ *   name##Async(pStreamCtx, txOptions, params) - MU and channel of pStreamCtx (HSE_CtxStreamOpen), txOptions
+ * All the steps of the stream must be sent with the same pStreamCtx.
+ */
+#define HSE_CTX_DEFINE_STREAM_ASYNC(name, params, args)                                     \
+    hseSrvResponse_t name##Async(const hseCtx_t* pStreamCtx, hseTxOptions_t txOptions, HSE_CTX_LIST params) \
+    {                                                                                       \
+        hseCtx_t ctx = HSE_CtxOnChannel(pStreamCtx->u8MuInstance, pStreamCtx->u8MuChannel, txOptions); \
+        ctx.bHeldChannel = pStreamCtx->bHeldChannel;                                        \
+        return name##Ctx(&ctx, HSE_CTX_LIST args);                                          \
+    }
+
+/* Define the synchronous form name(params) (gHseDefaultCtx) and the asynchronous form of a helper */
+#define HSE_CTX_DEFINE_SYNC_ASYNC(name, params, args)                                       \
+    hseSrvResponse_t name(HSE_CTX_LIST params)                                              \
+    {                                                                                       \
+        return name##Ctx(&gHseDefaultCtx, HSE_CTX_LIST args);                               \
+    }                                                                                       \
+    HSE_CTX_DEFINE_ASYNC(name, params, args)
+
+/* Define the synchronous form name(params) (gHseDefaultCtx) and the asynchronous form of a streaming helper */
+#define HSE_CTX_DEFINE_SYNC_STREAM_ASYNC(name, params, args)                                \
+    hseSrvResponse_t name(HSE_CTX_LIST params)                                              \
+    {                                                                                       \
+        return name##Ctx(&gHseDefaultCtx, HSE_CTX_LIST args);                               \
+    }                                                                                       \
+    HSE_CTX_DEFINE_STREAM_ASYNC(name, params, args)
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Request context of the crypto helpers
+ */
+typedef struct
+{
+    uint8_t         u8MuInstance;   /**< @brief    The MU instance the requests are sent on. */
+    uint8_t         u8MuChannel;    /**< @brief    The channel, or HSE_INVALID_CHANNEL to claim a free channel per request.
+                                                   A fixed channel must be free or owned by the caller (see HSE_Send). */
+    hseTxOptions_t  txOptions;      /**< @brief    Synchronous/asynchronous transmission. */
+    uint32_t        u32TimeoutUs;   /**< @brief    Deadline of the synchronous requests (microseconds), or HSE_WAIT_INFINITE.
+                                                   With a channel claimed per request, also the longest wait for a free
+                                                   channel of the synchronous requests. */
+    bool_t          bHeldChannel;   /**< @brief    The channel was claimed and held by HSE_CtxStreamOpen(). */
+} hseCtx_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/* Synchronous context on MU0, channel claimed per request (used by the helpers without context) */
+extern const hseCtx_t gHseDefaultCtx;
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Get the channel and the service descriptor of the next request of a context.
+* @details      With a claimed channel, the channel is owned by the caller from here on and is
+*               released when the response of the request is received (or by HSE_CtxAbort()).
+*               A synchronous context waits for a free channel up to its deadline, an asynchronous
+*               one does not wait.
+*
+* @param[in]    pCtx            The request context.
+* @param[out]   pu8Channel      The channel the request must be sent on.
+*
+* @return       The service descriptor of the channel, or NULL if no channel is free.
+*/
+hseSrvDescriptor_t* HSE_CtxAcquire(const hseCtx_t* pCtx, uint8_t* pu8Channel);
+
+/**
+* @brief        Send the request built in the descriptor returned by HSE_CtxAcquire().
+* @details      A channel claimed by HSE_CtxAcquire() or held for a stream context is sent with
+*               HSE_SendOnClaimed(); the fixed channel of a context is taken as in HSE_SendWithTimeout(),
+*               and HSE_SRV_RSP_HOST_CHANNEL_BUSY is returned while another context owns it.
+*
+* @param[in]    pCtx            The request context.
+* @param[in]    u8Channel       The channel returned by HSE_CtxAcquire().
+* @param[in]    pHseSrvDesc     The service descriptor.
+*
+* @return       hseSrvResponse_t  HSE available errors, or HSE_SRV_RSP_HOST_TIMEOUT if the deadline passed.
+*/
+hseSrvResponse_t HSE_CtxSend(const hseCtx_t* pCtx, uint8_t u8Channel, hseSrvDescriptor_t* pHseSrvDesc);
+
+/**
+* @brief        Give back a channel returned by HSE_CtxAcquire() without sending a request.
+*
+* @param[in]    pCtx            The request context.
+* @param[in]    u8Channel       The channel returned by HSE_CtxAcquire().
+*
+* @return       NULL
+*/
+void HSE_CtxAbort(const hseCtx_t* pCtx, uint8_t u8Channel);
+
+/**
+* @brief        Get the channel and the service descriptor of a step of a stream.
+* @details      Same as HSE_CtxAcquire() for HSE_ACCESS_MODE_ONE_PASS and for a context on a fixed channel.
+*               With a synchronous context claiming a channel per request, the START claims and holds a
+*               channel for the stream (streamId on the MU of the context), UPDATE/FINISH get it back;
+*               HSE_CtxStreamSend() releases it after the FINISH or a failed step (after
+*               HSE_SRV_RSP_HOST_TIMEOUT it stays held until the stream is started again).
+*
+* @param[in]    pCtx            The request context.
+* @param[in]    accessMode      The access mode of the request.
+* @param[in]    streamId        The stream (ignored for HSE_ACCESS_MODE_ONE_PASS).
+* @param[out]   pu8Channel      The channel the request must be sent on.
+* @param[out]   pStatus         Why no descriptor is returned: HSE_SRV_RSP_HOST_CHANNEL_BUSY (no free channel),
+*                               HSE_SRV_RSP_STREAMING_MODE_FAILURE (UPDATE/FINISH of a stream not started
+*                               on this context) or HSE_SRV_RSP_INVALID_PARAM (stream step on an asynchronous
+*                               context without channel, stream out of range).
+*
+* @return       The service descriptor of the channel, or NULL.
+*/
+hseSrvDescriptor_t* HSE_CtxStreamAcquire(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+    uint8_t* pu8Channel, hseSrvResponse_t* pStatus);
+
+/**
+* @brief        Send a request built in the descriptor returned by HSE_CtxStreamAcquire().
+*
+* @param[in]    pCtx            The request context.
+* @param[in]    accessMode      The access mode of the request.
+* @param[in]    streamId        The stream (ignored for HSE_ACCESS_MODE_ONE_PASS).
+* @param[in]    u8Channel       The channel returned by HSE_CtxStreamAcquire().
+* @param[in]    pHseSrvDesc     The service descriptor.
+*
+* @return       hseSrvResponse_t  HSE available errors, or HSE_SRV_RSP_HOST_TIMEOUT if the deadline passed.
+*/
+hseSrvResponse_t HSE_CtxStreamSend(const hseCtx_t* pCtx, hseAccessMode_t accessMode, uint32_t streamId,
+    uint8_t u8Channel, hseSrvDescriptor_t* pHseSrvDesc);
+
+/**
+* @brief        Open a stream context.
+* @details      Copies the context; with a channel claimed per request, claims a channel and holds it
+*               (see HSE_ChannelHold), so all the requests sent on the stream context use this channel.
+*               Required for the asynchronous streaming helpers (name##Async(pStreamCtx, txOptions, ...)).
+*
+* @param[in]    pCtx            The request context.
+* @param[out]   pStreamCtx      The stream context.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_HOST_CHANNEL_BUSY if no channel is free.
+*/
+hseSrvResponse_t HSE_CtxStreamOpen(const hseCtx_t* pCtx, hseCtx_t* pStreamCtx);
+
+/**
+* @brief        Close a stream context.
+* @details      Releases the channel held by HSE_CtxStreamOpen(). The last request sent on the stream
+*               context must have completed (response received or callback called).
+*
+* @param[in]    pStreamCtx      The stream context.
+*
+* @return       NULL
+*/
+void HSE_CtxStreamClose(hseCtx_t* pStreamCtx);
+
+/**
+* @brief        Build a context on a fixed channel.
+* @details      Used by the helpers that take the MU instance and the channel as parameters.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8MuChannel     The channel, or HSE_INVALID_CHANNEL.
+* @param[in]    txOptions       Tx options: synchronous or asynchronous.
+*
+* @return       The context (default deadline).
+*/
+static inline hseCtx_t HSE_CtxOnChannel(uint8_t u8MuInstance, uint8_t u8MuChannel, hseTxOptions_t txOptions)
+{
+    hseCtx_t ctx = { u8MuInstance, u8MuChannel, txOptions, HSE_WAIT_DEFAULT_TIMEOUT_US, FALSE };
+
+    return ctx;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_CTX_H */
+
+/** @} */
@@ -0,0 +1,314 @@
+/**
+*   @file    hse_host_dispatch.c
+*
+*   @brief   HSE HOST multi-channel request dispatcher.
+*   @details Queues HSE service requests and fans them out to all free channels of all MU instances.
+*            Completed channels are refilled from the MU RX interrupt.
+*
+*   @addtogroup hse_host_dispatch_c
+*   @{
+*/
+
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_dispatch.c
+*/
+#include <stdatomic.h>
+#include "hse_host_dispatch.h"
+#include "string.h"
+#include "sys_init.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_DISPATCH_QUEUE_MASK     (HSE_DISPATCH_QUEUE_SIZE - 1U)
+
+/* All service channels, except channel 0 (reserved for administration services) */
+#define HSE_DISPATCH_CHANNEL_MASK   ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Submission queue */
+static hseDispatchReq_t*    dispatchQueue[HSE_DISPATCH_QUEUE_SIZE];
+static volatile uint32_t    u32QueueHead = 0UL;
+static volatile uint32_t    u32QueueTail = 0UL;
+
+/* Number of requests sent to HSE and not completed yet */
+static volatile uint32_t    u32InFlight = 0UL;
+
+/* MU instances the requests are dispatched to */
+static hseMuMask_t          dispatchMuMask = 0U;
+
+/* Only one pump runs at a time (RX interrupt or any task); the others request another pass */
+static atomic_bool          bPumpActive;
+static atomic_bool          bPumpRequested;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static hseDispatchReq_t* HSE_DispatchDequeue(void);
+static void HSE_DispatchStart(uint8_t u8MuInstance, uint8_t u8MuChannel, hseDispatchReq_t* pReq);
+static void HSE_DispatchComplete(hseSrvResponse_t status, void* pArg);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Pop the oldest request from the submission queue.
+ ******************************************************************************/
+static hseDispatchReq_t* HSE_DispatchDequeue(void)
+{
+    hseDispatchReq_t* pReq = NULL;
+
+    sys_disableAllInterrupts();
+    if(u32QueueHead != u32QueueTail)
+    {
+        pReq = dispatchQueue[u32QueueHead & HSE_DISPATCH_QUEUE_MASK];
+        u32QueueHead++;
+        u32InFlight++;
+    }
+    sys_enableAllInterrupts();
+
+    return pReq;
+}
+
+/*******************************************************************************
+ * Description   : Copy the request in the channel descriptor and send it.
+ ******************************************************************************/
+static void HSE_DispatchStart(uint8_t u8MuInstance, uint8_t u8MuChannel, hseDispatchReq_t* pReq)
+{
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[u8MuInstance][u8MuChannel];
+    hseTxOptions_t txOptions;
+    hseSrvResponse_t srvResponse;
+
+    memcpy(pHseSrvDesc, &pReq->srvDesc, sizeof(hseSrvDescriptor_t));
+    pReq->u8MuInstance = u8MuInstance;
+    pReq->u8MuChannel  = u8MuChannel;
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HSE_DispatchComplete;
+    txOptions.pCallbackpArg   = (void*)pReq;
+
+    srvResponse = HSE_SendOnClaimed(u8MuInstance, u8MuChannel, txOptions, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        /* Busy in hardware (HSE_SRV_RSP_HOST_CHANNEL_BUSY): the claimed channel is not released by HSE_SendOnClaimed */
+        HSE_ChannelRelease(u8MuInstance, u8MuChannel);
+        HSE_DispatchComplete(srvResponse, (void*)pReq);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Completion callback (MU RX interrupt, HSE_PollCompletions or a failed send).
+ ******************************************************************************/
+static void HSE_DispatchComplete(hseSrvResponse_t status, void* pArg)
+{
+    hseDispatchReq_t* pReq = (hseDispatchReq_t*)pArg;
+    pfAsyncCallback_t pfCallback = pReq->pfCallback;
+    void* pCallbackArg = pReq->pCallbackArg;
+
+    sys_disableAllInterrupts();
+    u32InFlight--;
+    sys_enableAllInterrupts();
+
+    /* The request may be reused by the application as soon as bDone is set */
+    pReq->response = status;
+    pReq->bDone = TRUE;
+
+    if(NULL != pfCallback)
+    {
+        pfCallback(status, pCallbackArg);
+    }
+
+    /* Refill the channel that was just freed */
+    HSE_DispatchPump();
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Initialize the dispatcher.
+ ******************************************************************************/
+hseSrvResponse_t HSE_DispatchInit(hseMuMask_t muMask)
+{
+    uint8_t u8MuInstance;
+
+    if((0U == muMask) || (0U != (muMask >> HSE_NUM_OF_MU_INSTANCES)))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    dispatchMuMask = muMask;
+    u32QueueHead = 0UL;
+    u32QueueTail = 0UL;
+    u32InFlight = 0UL;
+    atomic_store(&bPumpActive, false);
+    atomic_store(&bPumpRequested, false);
+
+    /* Completions are driven by the RX interrupt of the dispatched MU instances only */
+    for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+    {
+        if(0U != (muMask & (1U << u8MuInstance)))
+        {
+            HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HSE_DISPATCH_CHANNEL_MASK);
+        }
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Add a request to the submission queue.
+ ******************************************************************************/
+hseSrvResponse_t HSE_DispatchSubmit(hseDispatchReq_t* pReq)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_OK;
+
+    if(NULL == pReq)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    pReq->bDone = FALSE;
+    pReq->response = HSE_SRV_RSP_GENERAL_ERROR;
+    pReq->u8MuInstance = HSE_INVALID_CHANNEL;
+    pReq->u8MuChannel = HSE_INVALID_CHANNEL;
+
+    sys_disableAllInterrupts();
+    if((u32QueueTail - u32QueueHead) >= HSE_DISPATCH_QUEUE_SIZE)
+    {
+        srvResponse = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+    else
+    {
+        dispatchQueue[u32QueueTail & HSE_DISPATCH_QUEUE_MASK] = pReq;
+        u32QueueTail++;
+    }
+    sys_enableAllInterrupts();
+
+    if(HSE_SRV_RSP_OK == srvResponse)
+    {
+        HSE_DispatchPump();
+    }
+
+    return srvResponse;
+}
+
+/*******************************************************************************
+ * Description   : Send queued requests on all free channels of all MUs.
+ ******************************************************************************/
+void HSE_DispatchPump(void)
+{
+    uint8_t u8MuInstance;
+    uint8_t u8MuChannel;
+    bool_t bScheduled;
+    hseDispatchReq_t* pReq;
+
+    /* Request a pass; if another pump is running (preempted task or RX interrupt), it makes it */
+    atomic_store(&bPumpRequested, true);
+    while(atomic_load(&bPumpRequested) && !atomic_exchange(&bPumpActive, true))
+    {
+        /* A completion arriving while scheduling requests another pass: a channel may have been freed */
+        while(atomic_exchange(&bPumpRequested, false))
+        {
+            /* Fill one channel per MU at a time, so the load is spread over all MU instances */
+            do
+            {
+                bScheduled = FALSE;
+                for(u8MuInstance = 0U; u8MuInstance < HSE_NUM_OF_MU_INSTANCES; u8MuInstance++)
+                {
+                    if(u32QueueHead == u32QueueTail)
+                    {
+                        break;
+                    }
+                    if(0U == (dispatchMuMask & (1U << u8MuInstance)))
+                    {
+                        continue;
+                    }
+
+                    u8MuChannel = HSE_ChannelClaim(u8MuInstance);
+                    if(HSE_INVALID_CHANNEL == u8MuChannel)
+                    {
+                        continue;
+                    }
+
+                    pReq = HSE_DispatchDequeue();
+                    if(NULL == pReq)
+                    {
+                        HSE_ChannelRelease(u8MuInstance, u8MuChannel);
+                        break;
+                    }
+
+                    HSE_DispatchStart(u8MuInstance, u8MuChannel, pReq);
+                    bScheduled = TRUE;
+                }
+            } while(bScheduled);
+        }
+
+        /* A pass requested after the last check is taken by the next iteration */
+        atomic_store(&bPumpActive, false);
+    }
+}
+
+/*******************************************************************************
+ * Description   : Number of requests queued or in flight.
+ ******************************************************************************/
+uint32_t HSE_DispatchGetPending(void)
+{
+    uint32_t u32Pending;
+
+    sys_disableAllInterrupts();
+    u32Pending = (u32QueueTail - u32QueueHead) + u32InFlight;
+    sys_enableAllInterrupts();
+
+    return u32Pending;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,148 @@
+/**
+*   @file    hse_host_dispatch.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST multi-channel request dispatcher.
+*   @details Queues HSE service requests and fans them out to all free channels of all MU instances.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_DISPATCH_H
+#define HSE_HOST_DISPATCH_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_dispatch.h
+*/
+#include "hse_host.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Maximum number of requests waiting in the submission queue (must be a power of 2) */
+#define HSE_DISPATCH_QUEUE_SIZE     16U
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Dispatcher request.
+ * @details The request is owned by the dispatcher from HSE_DispatchSubmit() until bDone is set.
+ *          srvDesc is copied into the descriptor of the channel the request is scheduled on,
+ *          so the caller does not have to keep it in shared memory.
+ */
+typedef struct
+{
+    hseSrvDescriptor_t          srvDesc;            /**< @brief    The service descriptor filled by the application. */
+    pfAsyncCallback_t           pfCallback;         /**< @brief    Completion callback, called from the MU RX interrupt or HSE_PollCompletions() (can be NULL). */
+    void*                       pCallbackArg;       /**< @brief    Parameter used to call the completion callback (can be NULL). */
+    volatile hseSrvResponse_t   response;           /**< @brief    The HSE response, valid after bDone is set. */
+    volatile bool_t             bDone;              /**< @brief    Set when the response was received. */
+    uint8_t                     u8MuInstance;       /**< @brief    The MU instance the request was scheduled on. */
+    uint8_t                     u8MuChannel;        /**< @brief    The channel the request was scheduled on. */
+} hseDispatchReq_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Initialize the dispatcher.
+* @details      Clears the submission queue and enables the RX interrupt of all
+*               service channels (except channel 0) on the dispatched MU instances.
+*
+* @param[in]    muMask      The MU instances the requests are dispatched to
+*                           (e.g. HSE_MU0_MASK | HSE_MU1_MASK).
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_INVALID_PARAM if muMask is empty or
+*               selects a MU instance that does not exist.
+*/
+hseSrvResponse_t HSE_DispatchInit(hseMuMask_t muMask);
+
+/**
+* @brief        Submit a request.
+* @details      Appends the request to the submission queue and schedules as many queued
+*               requests as there are free channels. The request is completed from
+*               HSE_ReceiveInterruptHandler(), which also refills the freed channel.
+*
+* @param[in]    pReq        The request. Must stay valid until pReq->bDone is set.
+*
+* @return       HSE_SRV_RSP_OK if the request was queued,
+*               HSE_SRV_RSP_INVALID_PARAM if pReq is NULL,
+*               HSE_SRV_RSP_NOT_ENOUGH_SPACE if the submission queue is full.
+*
+* @pre          HSE_DispatchInit() was called. The dispatcher claims its channels (HSE_ChannelClaim()),
+*               so the other helpers can share the dispatched MU instances.
+*/
+hseSrvResponse_t HSE_DispatchSubmit(hseDispatchReq_t* pReq);
+
+/**
+* @brief        Schedule queued requests.
+* @details      Sends queued requests on all free channels of the dispatched MU instances. Called
+*               internally on submit and on completion; it can also be called by the application
+*               (e.g. from a task loop). Safe to call concurrently from several tasks and the RX
+*               interrupt: only one caller schedules, the others make it run another pass.
+*
+* @return       NULL
+*/
+void HSE_DispatchPump(void);
+
+/**
+* @brief        Get the number of outstanding requests.
+* @details      Returns the number of requests either queued or in flight.
+*
+* @return       The number of outstanding requests.
+*/
+uint32_t HSE_DispatchGetPending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_DISPATCH_H */
+
+/** @} */
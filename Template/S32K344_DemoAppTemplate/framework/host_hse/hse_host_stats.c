@@ -0,0 +1,486 @@
+/**
+*   @file    hse_host_stats.c
+*
+*   @version 1.0.0
+*   @brief   HSE HOST per-service latency statistics.
+*   @details Service table and histogram counters are atomics: updates come from the MU RX
+*            interrupt and from the polling path of several channels and MU instances.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_stats.c
+*/
+#include <stdatomic.h>
+#include "hse_host_stats.h"
+#include "host_stm.h"
+
+#ifdef HSE_STATS
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Histogram of one service
+ */
+typedef struct
+{
+    atomic_uint_least32_t   u32SrvId;                           /**< @brief    0 = entry free. */
+    atomic_uint_least32_t   u32Count;
+    atomic_uint_least32_t   u32Errors;
+    atomic_uint_least32_t   u32MinUs;
+    atomic_uint_least32_t   u32MaxUs;
+    atomic_uint_least32_t   buckets[HSE_STATS_NUM_BUCKETS];
+} hseStatsEntry_t;
+
+/*
+ * @brief   Request in progress on a channel
+ */
+typedef struct
+{
+    hseSrvId_t  srvId;
+    uint32_t    u32SubmitUs;
+} hseStatsChannel_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseStatsEntry_t          statsEntries[HSE_STATS_MAX_SERVICES];
+static hseStatsChannel_t        statsChannels[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+
+/* Completions of services not tracked (table full) */
+static atomic_uint_least32_t    u32Untracked;
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static uint32_t HSE_StatsLog2(uint32_t u32Value);
+static uint32_t HSE_StatsBucketIndex(uint32_t u32LatencyUs);
+static hseStatsEntry_t* HSE_StatsFind(hseSrvId_t srvId, bool_t bAllocate);
+static void HSE_StatsUpdateMin(atomic_uint_least32_t* pu32Min, uint32_t u32Value);
+static void HSE_StatsUpdateMax(atomic_uint_least32_t* pu32Max, uint32_t u32Value);
+static uint32_t HSE_StatsPercentile(const uint32_t* pBuckets, uint32_t u32Total, uint32_t u32Percent);
+static uint8_t* HSE_StatsPut32(uint8_t* pOut, uint32_t u32Value);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Index of the most significant bit set (u32Value != 0).
+ ******************************************************************************/
+static uint32_t HSE_StatsLog2(uint32_t u32Value)
+{
+#if defined(__GNUC__)
+    return 31UL - (uint32_t)__builtin_clz(u32Value);
+#else
+    uint32_t u32Log2 = 0UL;
+
+    while(0UL != (u32Value >>= 1U))
+    {
+        u32Log2++;
+    }
+    return u32Log2;
+#endif
+}
+
+/*******************************************************************************
+ * Description   : Log-linear bucket of a latency.
+ ******************************************************************************/
+static uint32_t HSE_StatsBucketIndex(uint32_t u32LatencyUs)
+{
+    uint32_t u32Exp;
+    uint32_t u32Index;
+
+    if(u32LatencyUs < HSE_STATS_SUB_BUCKETS)
+    {
+        return u32LatencyUs;
+    }
+
+    u32Exp = HSE_StatsLog2(u32LatencyUs);
+    u32Index = HSE_STATS_SUB_BUCKETS + ((u32Exp - HSE_STATS_SUB_BUCKET_BITS) * HSE_STATS_SUB_BUCKETS) +
+               ((u32LatencyUs >> (u32Exp - HSE_STATS_SUB_BUCKET_BITS)) & (HSE_STATS_SUB_BUCKETS - 1UL));
+
+    return (u32Index < HSE_STATS_NUM_BUCKETS) ? u32Index : (HSE_STATS_NUM_BUCKETS - 1UL);
+}
+
+/*******************************************************************************
+ * Description   : Entry of a service, allocated on first use if requested.
+ ******************************************************************************/
+static hseStatsEntry_t* HSE_StatsFind(hseSrvId_t srvId, bool_t bAllocate)
+{
+    uint_least32_t u32Expected;
+    uint32_t u32Index;
+
+    for(u32Index = 0UL; u32Index < HSE_STATS_MAX_SERVICES; u32Index++)
+    {
+        u32Expected = atomic_load_explicit(&statsEntries[u32Index].u32SrvId, memory_order_acquire);
+        if((uint32_t)srvId == u32Expected)
+        {
+            return &statsEntries[u32Index];
+        }
+        if(0UL == u32Expected)
+        {
+            if(!bAllocate)
+            {
+                return NULL;
+            }
+            /* Entries are taken in order: a free entry ends the search */
+            if(atomic_compare_exchange_strong(&statsEntries[u32Index].u32SrvId, &u32Expected, (uint32_t)srvId) ||
+               ((uint32_t)srvId == u32Expected))
+            {
+                return &statsEntries[u32Index];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Description   : Lower the minimum.
+ ******************************************************************************/
+static void HSE_StatsUpdateMin(atomic_uint_least32_t* pu32Min, uint32_t u32Value)
+{
+    uint_least32_t u32Current = atomic_load_explicit(pu32Min, memory_order_relaxed);
+
+    while((u32Value < u32Current) && (!atomic_compare_exchange_weak(pu32Min, &u32Current, u32Value)))
+    {
+        /* u32Current reloaded by the failed exchange */
+    }
+}
+
+/*******************************************************************************
+ * Description   : Raise the maximum.
+ ******************************************************************************/
+static void HSE_StatsUpdateMax(atomic_uint_least32_t* pu32Max, uint32_t u32Value)
+{
+    uint_least32_t u32Current = atomic_load_explicit(pu32Max, memory_order_relaxed);
+
+    while((u32Value > u32Current) && (!atomic_compare_exchange_weak(pu32Max, &u32Current, u32Value)))
+    {
+        /* u32Current reloaded by the failed exchange */
+    }
+}
+
+/*******************************************************************************
+ * Description   : Upper bound of the bucket holding the percentile (nearest rank).
+ ******************************************************************************/
+static uint32_t HSE_StatsPercentile(const uint32_t* pBuckets, uint32_t u32Total, uint32_t u32Percent)
+{
+    uint32_t u32Rank = (uint32_t)((((uint64_t)u32Total * u32Percent) + 99ULL) / 100ULL);
+    uint32_t u32Seen = 0UL;
+    uint32_t u32Bucket;
+
+    for(u32Bucket = 0UL; u32Bucket < HSE_STATS_NUM_BUCKETS; u32Bucket++)
+    {
+        u32Seen += pBuckets[u32Bucket];
+        if((0UL != pBuckets[u32Bucket]) && (u32Seen >= u32Rank))
+        {
+            break;
+        }
+    }
+
+    return HSE_StatsBucketUpperUs((u32Bucket < HSE_STATS_NUM_BUCKETS) ? u32Bucket : (HSE_STATS_NUM_BUCKETS - 1UL));
+}
+
+/*******************************************************************************
+ * Description   : Write a big endian 32-bit value.
+ ******************************************************************************/
+static uint8_t* HSE_StatsPut32(uint8_t* pOut, uint32_t u32Value)
+{
+    pOut[0] = (uint8_t)(u32Value >> 24U);
+    pOut[1] = (uint8_t)(u32Value >> 16U);
+    pOut[2] = (uint8_t)(u32Value >> 8U);
+    pOut[3] = (uint8_t)u32Value;
+    return &pOut[4];
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Remember the service and the start time of a channel request.
+ ******************************************************************************/
+void HSE_StatsSubmit(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvId_t srvId)
+{
+    hseStatsChannel_t* pChannel = &statsChannels[u8MuInstance][u8Channel];
+
+    EnableStmTimebase();
+    pChannel->srvId = srvId;
+    pChannel->u32SubmitUs = GetStmTimebaseUs();
+}
+
+/*******************************************************************************
+ * Description   : Count the response in the histogram of the service.
+ ******************************************************************************/
+void HSE_StatsComplete(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvResponse_t srvResponse)
+{
+    const hseStatsChannel_t* pChannel = &statsChannels[u8MuInstance][u8Channel];
+    uint32_t u32LatencyUs = GetStmTimebaseUs() - pChannel->u32SubmitUs;
+    hseStatsEntry_t* pEntry = HSE_StatsFind(pChannel->srvId, TRUE);
+
+    if(NULL == pEntry)
+    {
+        (void)atomic_fetch_add_explicit(&u32Untracked, 1U, memory_order_relaxed);
+        return;
+    }
+
+    (void)atomic_fetch_add_explicit(&pEntry->buckets[HSE_StatsBucketIndex(u32LatencyUs)], 1U, memory_order_relaxed);
+    if(HSE_SRV_RSP_OK != srvResponse)
+    {
+        (void)atomic_fetch_add_explicit(&pEntry->u32Errors, 1U, memory_order_relaxed);
+    }
+    /* First completion: the minimum starts from 0 after reset */
+    if(0UL == atomic_fetch_add_explicit(&pEntry->u32Count, 1U, memory_order_relaxed))
+    {
+        atomic_store_explicit(&pEntry->u32MinUs, u32LatencyUs, memory_order_relaxed);
+    }
+    else
+    {
+        HSE_StatsUpdateMin(&pEntry->u32MinUs, u32LatencyUs);
+    }
+    HSE_StatsUpdateMax(&pEntry->u32MaxUs, u32LatencyUs);
+}
+
+/*******************************************************************************
+ * Description   : Summary of one service.
+ ******************************************************************************/
+hseSrvResponse_t HSE_StatsGet(hseSrvId_t srvId, hseStatsSummary_t* pSummary)
+{
+    hseStatsEntry_t* pEntry = HSE_StatsFind(srvId, FALSE);
+    uint32_t buckets[HSE_STATS_NUM_BUCKETS];
+    uint64_t u64Sum = 0ULL;
+    uint64_t u64Mid;
+    uint32_t u32Total = 0UL;
+    uint32_t u32Bucket;
+
+    if((NULL == pEntry) || (NULL == pSummary))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    /* Snapshot; the percentiles use the bucket total (consistent with the snapshot) */
+    for(u32Bucket = 0UL; u32Bucket < HSE_STATS_NUM_BUCKETS; u32Bucket++)
+    {
+        buckets[u32Bucket] = (uint32_t)atomic_load_explicit(&pEntry->buckets[u32Bucket], memory_order_relaxed);
+        u32Total += buckets[u32Bucket];
+        /* Midpoint of the bucket (lower bound for the open-ended last one) */
+        u64Mid = HSE_StatsBucketLowerUs(u32Bucket);
+        if(u32Bucket < (HSE_STATS_NUM_BUCKETS - 1UL))
+        {
+            u64Mid = (u64Mid + HSE_StatsBucketUpperUs(u32Bucket)) / 2ULL;
+        }
+        u64Sum += (uint64_t)buckets[u32Bucket] * u64Mid;
+    }
+
+    pSummary->u32Count = (uint32_t)atomic_load_explicit(&pEntry->u32Count, memory_order_relaxed);
+    pSummary->u32Errors = (uint32_t)atomic_load_explicit(&pEntry->u32Errors, memory_order_relaxed);
+    pSummary->u32MinUs = (uint32_t)atomic_load_explicit(&pEntry->u32MinUs, memory_order_relaxed);
+    pSummary->u32MaxUs = (uint32_t)atomic_load_explicit(&pEntry->u32MaxUs, memory_order_relaxed);
+    if(0UL == u32Total)
+    {
+        pSummary->u32MeanUs = 0UL;
+        pSummary->u32P50Us = 0UL;
+        pSummary->u32P90Us = 0UL;
+        pSummary->u32P99Us = 0UL;
+        return HSE_SRV_RSP_OK;
+    }
+
+    pSummary->u32MeanUs = (uint32_t)(u64Sum / u32Total);
+    pSummary->u32P50Us = HSE_StatsPercentile(buckets, u32Total, 50UL);
+    pSummary->u32P90Us = HSE_StatsPercentile(buckets, u32Total, 90UL);
+    pSummary->u32P99Us = HSE_StatsPercentile(buckets, u32Total, 99UL);
+
+    /* The bucket bounds are coarser than the exact extremes */
+    if(pSummary->u32P50Us > pSummary->u32MaxUs) { pSummary->u32P50Us = pSummary->u32MaxUs; }
+    if(pSummary->u32P90Us > pSummary->u32MaxUs) { pSummary->u32P90Us = pSummary->u32MaxUs; }
+    if(pSummary->u32P99Us > pSummary->u32MaxUs) { pSummary->u32P99Us = pSummary->u32MaxUs; }
+
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Clear all services (the entries are released).
+ ******************************************************************************/
+void HSE_StatsReset(void)
+{
+    uint32_t u32Index;
+    uint32_t u32Bucket;
+
+    for(u32Index = 0UL; u32Index < HSE_STATS_MAX_SERVICES; u32Index++)
+    {
+        atomic_store(&statsEntries[u32Index].u32Count, 0U);
+        atomic_store(&statsEntries[u32Index].u32Errors, 0U);
+        atomic_store(&statsEntries[u32Index].u32MinUs, 0U);
+        atomic_store(&statsEntries[u32Index].u32MaxUs, 0U);
+        for(u32Bucket = 0UL; u32Bucket < HSE_STATS_NUM_BUCKETS; u32Bucket++)
+        {
+            atomic_store(&statsEntries[u32Index].buckets[u32Bucket], 0U);
+        }
+    }
+    /* Service IDs last, from the end: entries stay allocated in order */
+    for(u32Index = HSE_STATS_MAX_SERVICES; u32Index > 0UL; u32Index--)
+    {
+        atomic_store(&statsEntries[u32Index - 1UL].u32SrvId, 0U);
+    }
+    atomic_store(&u32Untracked, 0U);
+}
+
+/*******************************************************************************
+ * Description   : Binary export of all services.
+ ******************************************************************************/
+hseSrvResponse_t HSE_StatsExport(uint8_t* pBuffer, uint32_t* pu32Length)
+{
+    uint32_t u32Needed = HSE_STATS_EXPORT_HEADER_SIZE;
+    uint32_t u32Services = 0UL;
+    uint32_t u32Index;
+    uint32_t u32Bucket;
+    uint32_t u32Value;
+    uint8_t* pOut;
+    uint8_t* pNonEmpty;
+
+    if(NULL == pu32Length)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    /* Size first, so a short buffer is left untouched */
+    for(u32Index = 0UL; u32Index < HSE_STATS_MAX_SERVICES; u32Index++)
+    {
+        if(0UL == atomic_load(&statsEntries[u32Index].u32SrvId))
+        {
+            break;
+        }
+        u32Services++;
+        u32Needed += HSE_STATS_EXPORT_SERVICE_SIZE;
+        for(u32Bucket = 0UL; u32Bucket < HSE_STATS_NUM_BUCKETS; u32Bucket++)
+        {
+            if(0UL != atomic_load_explicit(&statsEntries[u32Index].buckets[u32Bucket], memory_order_relaxed))
+            {
+                u32Needed += HSE_STATS_EXPORT_BUCKET_SIZE;
+            }
+        }
+    }
+
+    if((NULL == pBuffer) || (*pu32Length < u32Needed))
+    {
+        *pu32Length = u32Needed;
+        return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+    }
+
+    pOut = pBuffer;
+    *pOut++ = (uint8_t)HSE_STATS_EXPORT_VERSION;
+    *pOut++ = (uint8_t)HSE_STATS_SUB_BUCKET_BITS;
+    *pOut++ = (uint8_t)HSE_STATS_NUM_BUCKETS;
+    *pOut++ = (uint8_t)u32Services;
+    pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&u32Untracked));
+
+    for(u32Index = 0UL; u32Index < u32Services; u32Index++)
+    {
+        pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&statsEntries[u32Index].u32SrvId));
+        pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&statsEntries[u32Index].u32Count));
+        pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&statsEntries[u32Index].u32Errors));
+        pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&statsEntries[u32Index].u32MinUs));
+        pOut = HSE_StatsPut32(pOut, (uint32_t)atomic_load(&statsEntries[u32Index].u32MaxUs));
+        pNonEmpty = pOut++;
+        *pNonEmpty = 0U;
+        for(u32Bucket = 0UL; u32Bucket < HSE_STATS_NUM_BUCKETS; u32Bucket++)
+        {
+            u32Value = (uint32_t)atomic_load_explicit(&statsEntries[u32Index].buckets[u32Bucket], memory_order_relaxed);
+            if(0UL == u32Value)
+            {
+                continue;
+            }
+            if(((uint32_t)(pOut - pBuffer) + HSE_STATS_EXPORT_BUCKET_SIZE) > *pu32Length)
+            {
+                /* Buckets filled since sizing: report the size of the next export */
+                *pu32Length = u32Needed + HSE_STATS_EXPORT_BUCKET_SIZE;
+                return HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+            }
+            *pOut++ = (uint8_t)u32Bucket;
+            pOut = HSE_StatsPut32(pOut, u32Value);
+            (*pNonEmpty)++;
+        }
+    }
+
+    *pu32Length = (uint32_t)(pOut - pBuffer);
+    return HSE_SRV_RSP_OK;
+}
+
+/*******************************************************************************
+ * Description   : Bucket bounds.
+ ******************************************************************************/
+uint32_t HSE_StatsBucketLowerUs(uint32_t u32Bucket)
+{
+    uint32_t u32Exp;
+
+    if(u32Bucket < HSE_STATS_SUB_BUCKETS)
+    {
+        return u32Bucket;
+    }
+
+    u32Bucket -= HSE_STATS_SUB_BUCKETS;
+    u32Exp = (u32Bucket / HSE_STATS_SUB_BUCKETS) + HSE_STATS_SUB_BUCKET_BITS;
+    return (HSE_STATS_SUB_BUCKETS + (u32Bucket % HSE_STATS_SUB_BUCKETS)) << (u32Exp - HSE_STATS_SUB_BUCKET_BITS);
+}
+
+uint32_t HSE_StatsBucketUpperUs(uint32_t u32Bucket)
+{
+    if(u32Bucket >= (HSE_STATS_NUM_BUCKETS - 1UL))
+    {
+        return UINT32_MAX;
+    }
+    return HSE_StatsBucketLowerUs(u32Bucket + 1UL) - 1UL;
+}
+
+#endif /* HSE_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
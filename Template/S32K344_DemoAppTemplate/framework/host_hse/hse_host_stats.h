@@ -0,0 +1,209 @@
+/**
+*   @file    hse_host_stats.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST per-service latency statistics.
+*   @details Fixed-memory log-linear latency histogram per service ID, updated by the host driver
+*            when a response is received (sync and async, all MU instances).
+*
+*            Not active by default: the histograms take about 6 KB of RAM (HSE_STATS_MAX_SERVICES
+*            x (HSE_STATS_NUM_BUCKETS + 5) x 4 bytes) and each response is looked up and counted in
+*            the completion path (MU RX interrupt). Define HSE_STATS to use it.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_HOST_STATS_H
+#define HSE_HOST_STATS_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_host_stats.h
+*/
+#include "hse_interface.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* Activate/Deactivate the latency statistics (the driver hooks compile to nothing when not defined) */
+// #define HSE_STATS
+
+/* Number of service IDs tracked (the first ones completed) */
+#define HSE_STATS_MAX_SERVICES          (16U)
+
+/* Log-linear buckets: 2^HSE_STATS_SUB_BUCKET_BITS linear buckets per power of two (25% resolution) */
+#define HSE_STATS_SUB_BUCKET_BITS       (2U)
+#define HSE_STATS_SUB_BUCKETS           (1UL << HSE_STATS_SUB_BUCKET_BITS)
+/* Up to 2^24 us (~16.7 s); slower requests are counted in the last bucket */
+#define HSE_STATS_MAX_EXPONENT          (24U)
+#define HSE_STATS_NUM_BUCKETS           (HSE_STATS_SUB_BUCKETS + ((HSE_STATS_MAX_EXPONENT - HSE_STATS_SUB_BUCKET_BITS) * HSE_STATS_SUB_BUCKETS))
+
+/*
+ * Binary export (big endian, for diagnostic services such as UDS ReadDataByIdentifier):
+ *   header  : u8 format version, u8 sub-bucket bits, u8 number of buckets, u8 number of services,
+ *             u32 completions not tracked (table full)
+ *   service : u32 srvId, u32 count, u32 errors, u32 min us, u32 max us,
+ *             u8 number of non-empty buckets N, N x (u8 bucket index, u32 count)
+ * Bucket i covers [HSE_StatsBucketLowerUs(i), HSE_StatsBucketUpperUs(i)].
+ */
+#define HSE_STATS_EXPORT_VERSION        (1U)
+#define HSE_STATS_EXPORT_HEADER_SIZE    (8UL)
+#define HSE_STATS_EXPORT_SERVICE_SIZE   (21UL)
+#define HSE_STATS_EXPORT_BUCKET_SIZE    (5UL)
+/* Worst case size of the export */
+#define HSE_STATS_EXPORT_MAX_SIZE       (HSE_STATS_EXPORT_HEADER_SIZE + (HSE_STATS_MAX_SERVICES * \
+                                        (HSE_STATS_EXPORT_SERVICE_SIZE + (HSE_STATS_NUM_BUCKETS * HSE_STATS_EXPORT_BUCKET_SIZE))))
+
+#ifdef HSE_STATS
+/* Driver hooks */
+#define HSE_STATS_SUBMIT(u8MuInstance, u8Channel, srvId)    HSE_StatsSubmit((u8MuInstance), (u8Channel), (srvId))
+#define HSE_STATS_COMPLETE(u8MuInstance, u8Channel, rsp)    HSE_StatsComplete((u8MuInstance), (u8Channel), (rsp))
+#else
+#define HSE_STATS_SUBMIT(u8MuInstance, u8Channel, srvId)
+#define HSE_STATS_COMPLETE(u8MuInstance, u8Channel, rsp)
+#endif /* HSE_STATS */
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*
+ * @brief   Latency summary of one service
+ * @details Percentiles are the upper bound of the bucket holding the percentile (within 25%).
+ */
+typedef struct
+{
+    uint32_t    u32Count;           /**< @brief    Responses received. */
+    uint32_t    u32Errors;          /**< @brief    Responses other than HSE_SRV_RSP_OK (including host timeouts). */
+    uint32_t    u32MinUs;           /**< @brief    Lowest latency. */
+    uint32_t    u32MaxUs;           /**< @brief    Highest latency. */
+    uint32_t    u32MeanUs;          /**< @brief    Mean latency (from the bucket midpoints). */
+    uint32_t    u32P50Us;           /**< @brief    Median latency. */
+    uint32_t    u32P90Us;           /**< @brief    90th percentile. */
+    uint32_t    u32P99Us;           /**< @brief    99th percentile. */
+} hseStatsSummary_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+#ifdef HSE_STATS
+/**
+* @brief        Record the start of a request (called by the host driver before the MU write).
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+* @param[in]    srvId           The service ID.
+*
+* @return       NULL
+*/
+void HSE_StatsSubmit(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvId_t srvId);
+
+/**
+* @brief        Record the response of the request of a channel (called by the host driver).
+* @details      Lock-free; called from the MU RX interrupt or the polling path.
+*
+* @param[in]    u8MuInstance    The MU instance (MU): 0 <= MU < HSE_NUM_OF_MU_INSTANCES.
+* @param[in]    u8Channel       The service channel (ch): 0 <= ch < HSE_NUM_OF_CHANNELS_PER_MU.
+* @param[in]    srvResponse     The service response.
+*
+* @return       NULL
+*/
+void HSE_StatsComplete(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvResponse_t srvResponse);
+
+/**
+* @brief        Get the latency summary of a service.
+*
+* @param[in]    srvId           The service ID.
+* @param[out]   pSummary        The summary.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_INVALID_PARAM if the service is not tracked.
+*/
+hseSrvResponse_t HSE_StatsGet(hseSrvId_t srvId, hseStatsSummary_t* pSummary);
+
+/**
+* @brief        Clear the statistics of all services.
+* @details      Completions running at the same time may be lost or partly counted.
+*
+* @return       NULL
+*/
+void HSE_StatsReset(void);
+
+/**
+* @brief        Export the statistics in the binary format (see HSE_STATS_EXPORT_VERSION).
+*
+* @param[out]   pBuffer         The output buffer.
+* @param[in,out] pu32Length     In: the buffer size. Out: the bytes written, or the size needed.
+*
+* @return       HSE_SRV_RSP_OK, or HSE_SRV_RSP_NOT_ENOUGH_SPACE if the buffer is too small.
+*/
+hseSrvResponse_t HSE_StatsExport(uint8_t* pBuffer, uint32_t* pu32Length);
+
+/**
+* @brief        Lowest latency (us) counted in a bucket.
+*
+* @param[in]    u32Bucket       The bucket index: 0 <= index < HSE_STATS_NUM_BUCKETS.
+*
+* @return       The lower bound.
+*/
+uint32_t HSE_StatsBucketLowerUs(uint32_t u32Bucket);
+
+/**
+* @brief        Highest latency (us) counted in a bucket (UINT32_MAX for the last one).
+*
+* @param[in]    u32Bucket       The bucket index: 0 <= index < HSE_STATS_NUM_BUCKETS.
+*
+* @return       The upper bound.
+*/
+uint32_t HSE_StatsBucketUpperUs(uint32_t u32Bucket);
+#endif /* HSE_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_HOST_STATS_H */
+
+/** @} */
@@ -0,0 +1,335 @@
+/**
+*   @file    hse_srv_builders.h
+*
+*   @version 1.0.0
+*   @brief   HSE HOST typed service descriptor builders.
+*   @details Each builder writes the service ID, clears the metadata and assigns the whole request
+*            structure of one service (fields not passed, including the reserved ones, are zero).
+*            Only sizeof(service request) bytes are written instead of clearing the complete
+*            hseSrvDescriptor_t, whose size is set by its largest member.
+*
+*   @addtogroup HSE_HOST_APIs HSE HOST APIs
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_SRV_BUILDERS_H
+#define HSE_SRV_BUILDERS_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_srv_builders.h
+*/
+#include "hse_interface.h"
+
+/*==================================================================================================
+*                              SOURCE FILE VERSION INFORMATION
+==================================================================================================*/
+
+/*==================================================================================================
+*                                     FILE VERSION CHECKS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Write the descriptor header (service ID and cleared metadata).
+*
+* @param[out]   pHseSrvDesc     The service descriptor.
+* @param[in]    srvId           The service ID.
+*
+* @return       NULL
+*/
+static inline void HSE_BuildHeader(hseSrvDescriptor_t* pHseSrvDesc, hseSrvId_t srvId)
+{
+    pHseSrvDesc->srvId = srvId;
+    pHseSrvDesc->srvMetaData = (hseSrvMetaData_t){ { 0U } };
+}
+
+#ifdef HSE_SPT_HASH
+/**
+* @brief        Build a HASH request (see hseHashSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildHashReq(hseSrvDescriptor_t* pHseSrvDesc, hseAccessMode_t accessMode,
+                                    hseStreamId_t streamId, hseHashAlgo_t hashAlgo,
+                                    hseSGTOption_t sgtOption, uint32_t inputLength, const uint8_t* pInput,
+                                    uint32_t* pHashLength, uint8_t* pHash)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_HASH);
+    pHseSrvDesc->hseSrv.hashReq = (hseHashSrv_t){
+        .accessMode  = accessMode,
+        .streamId    = streamId,
+        .hashAlgo    = hashAlgo,
+        .sgtOption   = sgtOption,
+        .inputLength = inputLength,
+        .pInput      = HSE_PTR_TO_HOST_ADDR(pInput),
+        .pHashLength = HSE_PTR_TO_HOST_ADDR(pHashLength),
+        .pHash       = HSE_PTR_TO_HOST_ADDR(pHash),
+    };
+}
+#endif /* HSE_SPT_HASH */
+
+/**
+* @brief        Build a MAC generate/verify request (see hseMacSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildMacReq(hseSrvDescriptor_t* pHseSrvDesc, hseAccessMode_t accessMode,
+                                   hseStreamId_t streamId, hseAuthDir_t authDir,
+                                   hseSGTOption_t sgtOption, const hseMacScheme_t* pMacScheme,
+                                   hseKeyHandle_t keyHandle, uint32_t inputLength, const uint8_t* pInput,
+                                   const uint32_t* pTagLength, const uint8_t* pTag)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_MAC);
+    pHseSrvDesc->hseSrv.macReq = (hseMacSrv_t){
+        .accessMode  = accessMode,
+        .streamId    = streamId,
+        .authDir     = authDir,
+        .sgtOption   = sgtOption,
+        .macScheme   = *pMacScheme,
+        .keyHandle   = keyHandle,
+        .inputLength = inputLength,
+        .pInput      = HSE_PTR_TO_HOST_ADDR(pInput),
+        .pTagLength  = HSE_PTR_TO_HOST_ADDR(pTagLength),
+        .pTag        = HSE_PTR_TO_HOST_ADDR(pTag),
+    };
+}
+
+#ifdef HSE_SPT_FAST_CMAC
+/**
+* @brief        Build a FAST CMAC generate/verify request (see hseFastCMACSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildFastCmacReq(hseSrvDescriptor_t* pHseSrvDesc, hseAuthDir_t authDir,
+                                        hseKeyHandle_t keyHandle, uint32_t inputBitLength,
+                                        const uint8_t* pInput, uint8_t tagBitLength, const uint8_t* pTag)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_FAST_CMAC);
+    pHseSrvDesc->hseSrv.fastCmacReq = (hseFastCMACSrv_t){
+        .keyHandle      = keyHandle,
+        .pInput         = HSE_PTR_TO_HOST_ADDR(pInput),
+        .inputBitLength = inputBitLength,
+        .authDir        = authDir,
+        .tagBitLength   = tagBitLength,
+        .pTag           = HSE_PTR_TO_HOST_ADDR(pTag),
+    };
+}
+#endif /* HSE_SPT_FAST_CMAC */
+
+#ifdef HSE_SPT_CMAC_WITH_COUNTER
+/**
+* @brief        Build a CMAC with counter generate/verify request (see hseCmacWithCounterSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildCmacWithCounterReq(hseSrvDescriptor_t* pHseSrvDesc, hseAuthDir_t authDir,
+                                               hseKeyHandle_t keyHandle, uint32_t counterIdx, uint8_t rpOffset,
+                                               hseSGTOption_t sgtOption, uint32_t inputBitLength,
+                                               const uint8_t* pInput, uint8_t tagBitLength, const uint8_t* pTag,
+                                               const uint32_t* pVolatileCounter)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_CMAC_WITH_COUNTER);
+    pHseSrvDesc->hseSrv.cmacWithCounterReq = (hseCmacWithCounterSrv_t){
+        .authDir          = authDir,
+        .keyHandle        = keyHandle,
+        .counterIdx       = counterIdx,
+        .RPOffset         = rpOffset,
+        .sgtOption        = sgtOption,
+        .inputBitLength   = inputBitLength,
+        .pInput           = HSE_PTR_TO_HOST_ADDR(pInput),
+        .tagBitLength     = tagBitLength,
+        .pTag             = HSE_PTR_TO_HOST_ADDR(pTag),
+        .pVolatileCounter = HSE_PTR_TO_HOST_ADDR(pVolatileCounter),
+    };
+}
+#endif /* HSE_SPT_CMAC_WITH_COUNTER */
+
+/**
+* @brief        Build a symmetric cipher request (see hseSymCipherSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildSymCipherReq(hseSrvDescriptor_t* pHseSrvDesc, hseAccessMode_t accessMode,
+                                         hseStreamId_t streamId, hseCipherAlgo_t cipherAlgo,
+                                         hseCipherBlockMode_t cipherBlockMode, hseCipherDir_t cipherDir,
+                                         hseSGTOption_t sgtOption, hseKeyHandle_t keyHandle,
+                                         const uint8_t* pIV, uint32_t inputLength, const uint8_t* pInput,
+                                         uint8_t* pOutput)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_SYM_CIPHER);
+    pHseSrvDesc->hseSrv.symCipherReq = (hseSymCipherSrv_t){
+        .accessMode      = accessMode,
+        .streamId        = streamId,
+        .cipherAlgo      = cipherAlgo,
+        .cipherBlockMode = cipherBlockMode,
+        .cipherDir       = cipherDir,
+        .sgtOption       = sgtOption,
+        .keyHandle       = keyHandle,
+        .pIV             = HSE_PTR_TO_HOST_ADDR(pIV),
+        .inputLength     = inputLength,
+        .pInput          = HSE_PTR_TO_HOST_ADDR(pInput),
+        .pOutput         = HSE_PTR_TO_HOST_ADDR(pOutput),
+    };
+}
+
+#ifdef HSE_SPT_AEAD
+/**
+* @brief        Build an AEAD request (see hseAeadSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildAeadReq(hseSrvDescriptor_t* pHseSrvDesc, hseAccessMode_t accessMode,
+                                    hseStreamId_t streamId, hseAuthCipherMode_t authCipherMode,
+                                    hseCipherDir_t cipherDir, hseKeyHandle_t keyHandle,
+                                    uint32_t ivLength, const uint8_t* pIV,
+                                    uint32_t aadLength, const uint8_t* pAAD,
+                                    hseSGTOption_t sgtOption, uint32_t inputLength, const uint8_t* pInput,
+                                    uint32_t tagLength, const uint8_t* pTag, uint8_t* pOutput)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_AEAD);
+    pHseSrvDesc->hseSrv.aeadReq = (hseAeadSrv_t){
+        .accessMode     = accessMode,
+        .streamId       = streamId,
+        .authCipherMode = authCipherMode,
+        .cipherDir      = cipherDir,
+        .keyHandle      = keyHandle,
+        .ivLength       = ivLength,
+        .pIV            = HSE_PTR_TO_HOST_ADDR(pIV),
+        .aadLength      = aadLength,
+        .pAAD           = HSE_PTR_TO_HOST_ADDR(pAAD),
+        .sgtOption      = sgtOption,
+        .inputLength    = inputLength,
+        .pInput         = HSE_PTR_TO_HOST_ADDR(pInput),
+        .tagLength      = tagLength,
+        .pTag           = HSE_PTR_TO_HOST_ADDR(pTag),
+        .pOutput        = HSE_PTR_TO_HOST_ADDR(pOutput),
+    };
+}
+#endif /* HSE_SPT_AEAD */
+
+#ifdef HSE_SPT_RANDOM
+/**
+* @brief        Build a random number request (see hseGetRandomNumSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildGetRandomNumReq(hseSrvDescriptor_t* pHseSrvDesc, hseRngClass_t rngClass,
+                                            uint32_t randomNumLength, uint8_t* pRandomNum)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_GET_RANDOM_NUM);
+    pHseSrvDesc->hseSrv.getRandomNumReq = (hseGetRandomNumSrv_t){
+        .rngClass        = rngClass,
+        .randomNumLength = randomNumLength,
+        .pRandomNum      = HSE_PTR_TO_HOST_ADDR(pRandomNum),
+    };
+}
+#endif /* HSE_SPT_RANDOM */
+
+#ifdef HSE_SPT_STREAM_CTX_IMPORT_EXPORT
+/**
+* @brief        Build a streaming context import/export request (see hseImportExportStreamCtxSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildStreamCtxReq(hseSrvDescriptor_t* pHseSrvDesc, hseStreamContextOp_t operation,
+                                         hseStreamId_t streamId, const uint8_t* pStreamContext)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX);
+    pHseSrvDesc->hseSrv.importExportStreamCtx = (hseImportExportStreamCtxSrv_t){
+        .operation      = operation,
+        .streamId       = streamId,
+        .pStreamContext = HSE_PTR_TO_HOST_ADDR(pStreamContext),
+    };
+}
+#endif /* HSE_SPT_STREAM_CTX_IMPORT_EXPORT */
+
+#ifdef HSE_SPT_GET_KEY_INFO
+/**
+* @brief        Build a get key info request (see hseGetKeyInfoSrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildGetKeyInfoReq(hseSrvDescriptor_t* pHseSrvDesc, hseKeyHandle_t keyHandle,
+                                          hseKeyInfo_t* pKeyInfo)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_GET_KEY_INFO);
+    pHseSrvDesc->hseSrv.getKeyInfoReq = (hseGetKeyInfoSrv_t){
+        .keyHandle = keyHandle,
+        .pKeyInfo  = HSE_PTR_TO_HOST_ADDR(pKeyInfo),
+    };
+}
+#endif /* HSE_SPT_GET_KEY_INFO */
+
+#ifdef HSE_SPT_SHE
+/**
+* @brief        Build a SHE load key request (see hseSheLoadKeySrv_t).
+*
+* @return       NULL
+*/
+static inline void HSE_BuildSheLoadKeyReq(hseSrvDescriptor_t* pHseSrvDesc, hseKeyGroupIdx_t sheGroupIndex,
+                                          const uint8_t* pM1, const uint8_t* pM2, const uint8_t* pM3,
+                                          uint8_t* pM4, uint8_t* pM5)
+{
+    HSE_BuildHeader(pHseSrvDesc, HSE_SRV_ID_SHE_LOAD_KEY);
+    pHseSrvDesc->hseSrv.sheLoadKeyReq = (hseSheLoadKeySrv_t){
+        .sheGroupIndex = sheGroupIndex,
+        .pM1           = HSE_PTR_TO_HOST_ADDR(pM1),
+        .pM2           = HSE_PTR_TO_HOST_ADDR(pM2),
+        .pM3           = HSE_PTR_TO_HOST_ADDR(pM3),
+        .pM4           = HSE_PTR_TO_HOST_ADDR(pM4),
+        .pM5           = HSE_PTR_TO_HOST_ADDR(pM5),
+    };
+}
+#endif /* HSE_SPT_SHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_SRV_BUILDERS_H */
+
+/** @} */
@@ -0,0 +1,130 @@
+/**
+*   @file    hse_tracing.c
+*
+*   @version 1.0.0
+*   @brief   HSE HOST request tracing.
+*   @details Trace ring placed in standby RAM, kept across warm resets.
+*
+*   @addtogroup hse_tracing
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_tracing.c
+*/
+#include "string.h"
+#include "hse_tracing.h"
+
+#ifdef HSE_TRACING
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+
+/* Not zeroed at startup: validated by HSE_TraceInit */
+hseTraceRing_t gHseTraceRing HSE_TRACE_SECTION;
+
+uint32_t gHseTraceSlot[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Keep the ring of the previous run or clear it.
+ ******************************************************************************/
+void HSE_TraceInit(void)
+{
+    uint32_t u32Head = (uint32_t)atomic_load(&gHseTraceRing.u32Head);
+    uint32_t u32Index;
+
+    EnableStmTimebase();
+
+    if((HSE_TRACE_MAGIC != gHseTraceRing.u32Magic) || (HSE_TRACE_VERSION != gHseTraceRing.u32Version) ||
+       (NUMBER_OF_REQ != gHseTraceRing.u32Capacity) || (sizeof(hseTraceRecord_t) != gHseTraceRing.u32RecordSize))
+    {
+        HSE_TraceClear();
+        return;
+    }
+
+    /* Warm reset: the requests in progress never completed (records not written yet are skipped) */
+    for(u32Index = 0UL; (u32Index < NUMBER_OF_REQ) && (u32Index < u32Head); u32Index++)
+    {
+        if(HSE_TRACE_RSP_PENDING == gHseTraceRing.records[u32Index].u32Response)
+        {
+            gHseTraceRing.records[u32Index].u32Response = HSE_TRACE_RSP_RESET;
+        }
+    }
+    gHseTraceRing.u32Boots++;
+}
+
+/*******************************************************************************
+ * Description   : Clear the ring.
+ ******************************************************************************/
+void HSE_TraceClear(void)
+{
+    memset(gHseTraceRing.records, 0, sizeof(gHseTraceRing.records));
+    gHseTraceRing.u32Version = HSE_TRACE_VERSION;
+    gHseTraceRing.u32Capacity = NUMBER_OF_REQ;
+    gHseTraceRing.u32RecordSize = sizeof(hseTraceRecord_t);
+    gHseTraceRing.u32Boots = 0UL;
+    atomic_store(&gHseTraceRing.u32Head, 0U);
+    gHseTraceRing.u32Magic = HSE_TRACE_MAGIC;
+}
+
+#endif /* HSE_TRACING */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
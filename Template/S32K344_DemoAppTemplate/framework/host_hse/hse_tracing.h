@@ -3,6 +3,11 @@
  *
  *
  *   @brief   HSE-Host common variables for tracing
+ *   @details When HSE_TRACING is defined, every request sent with HSE_Send/HSE_SendWithTimeout is
+ *            logged (service ID, MU, channel, submit/response timestamps, response) into a ring
+ *            placed in standby RAM (.standby_ram), so the last NUMBER_OF_REQ requests survive a
+ *            warm reset. The ring can be dumped from the debugger and decoded on the host with
+ *            tools/hse_trace_decoder. Without HSE_TRACING the trace points compile to nothing.
  *
  *    @addtogroup hse_tracing
  *   @{
@@ -34,6 +39,12 @@ extern "C" {
  * 2) needed interfaces from external units
  * 3) internal and external interfaces from this unit
  *  ==============================================================================================*/
+#include <stdatomic.h>
+#include "std_typedefs.h"
+#ifdef HSE_TRACING
+#include "hse_interface.h"
+#include "host_stm.h"
+#endif /* HSE_TRACING */
 
 /*==================================================================================================
  *                              SOURCE FILE VERSION INFORMATION
@@ -54,8 +65,40 @@ extern "C" {
 /* Activate/Deactivate HSE tracing */
 // #define HSE_TRACING
 
-/* The number of requests to be traced */
-#define NUMBER_OF_REQ   2U
+/* The number of requests to be traced (trace ring capacity, power of two) */
+#define NUMBER_OF_REQ   64U
+
+#if (0U != (NUMBER_OF_REQ & (NUMBER_OF_REQ - 1U)))
+#error "NUMBER_OF_REQ must be a power of two"
+#endif
+
+/* Trace ring signature ("HSET") and layout version, checked by HSE_TraceInit and the decoder */
+#define HSE_TRACE_MAGIC             (0x54455348UL)
+#define HSE_TRACE_VERSION           (1UL)
+
+/* Response value of a request that did not complete yet */
+#define HSE_TRACE_RSP_PENDING       (0x00000000UL)
+/* Response value of a request interrupted by a reset */
+#define HSE_TRACE_RSP_RESET         (0xFFFFFFFFUL)
+
+#ifdef HSE_TRACING
+#ifdef HSE_VIRTUAL
+#define HSE_TRACE_SECTION
+#define HSE_TRACE_TIMESTAMP()       GetStmTimebaseUs()
+#else
+/* Not initialized by the startup code on warm reset (see the linker files) */
+#define HSE_TRACE_SECTION           __attribute__((section(".standby_ram")))
+/* STM_1 microseconds time base, read in place (no call) */
+#define HSE_TRACE_TIMESTAMP()       (*(volatile uint32_t*)STM_1_CNT_ADDRESS)
+#endif /* HSE_VIRTUAL */
+
+/* Trace points used by the host driver */
+#define HSE_TRACE_SUBMIT(u8MuInstance, u8Channel, srvId)    HSE_TraceSubmit((u8MuInstance), (u8Channel), (srvId))
+#define HSE_TRACE_COMPLETE(u8MuInstance, u8Channel, rsp)    HSE_TraceComplete((u8MuInstance), (u8Channel), (rsp))
+#else
+#define HSE_TRACE_SUBMIT(u8MuInstance, u8Channel, srvId)
+#define HSE_TRACE_COMPLETE(u8MuInstance, u8Channel, rsp)
+#endif /* HSE_TRACING */
 
 /*==================================================================================================
  *                                             ENUMS
@@ -65,15 +108,111 @@ extern "C" {
  *                                STRUCTURES AND OTHER TYPEDEFS
  *  ==============================================================================================*/
 
+/*
+ * @brief   Trace record of one request (20 bytes)
+ */
+typedef struct
+{
+    uint32_t    u32SrvId;           /**< @brief    Service ID of the request. */
+    uint32_t    u32SubmitUs;        /**< @brief    Time base value when the request was written to the MU. */
+    uint32_t    u32ResponseUs;      /**< @brief    Time base value when the response was received. */
+    uint32_t    u32Response;        /**< @brief    hseSrvResponse_t, or HSE_TRACE_RSP_PENDING/HSE_TRACE_RSP_RESET. */
+    uint8_t     u8MuInstance;       /**< @brief    MU instance. */
+    uint8_t     u8Channel;          /**< @brief    MU channel. */
+    uint16_t    u16Boot;            /**< @brief    Boot number (u32Boots) when the request was sent. */
+} hseTraceRecord_t;
+
+/*
+ * @brief   Trace ring (the layout read by the host decoder)
+ */
+typedef struct
+{
+    uint32_t                u32Magic;       /**< @brief    HSE_TRACE_MAGIC when the ring is valid. */
+    uint32_t                u32Version;     /**< @brief    HSE_TRACE_VERSION. */
+    uint32_t                u32Capacity;    /**< @brief    Number of records (NUMBER_OF_REQ). */
+    uint32_t                u32RecordSize;  /**< @brief    sizeof(hseTraceRecord_t). */
+    uint32_t                u32Boots;       /**< @brief    Number of HSE_TraceInit calls that kept the ring. */
+    atomic_uint_least32_t   u32Head;        /**< @brief    Records written so far (the next one goes to u32Head % u32Capacity). */
+    hseTraceRecord_t        records[NUMBER_OF_REQ];
+} hseTraceRing_t;
+
 /*==================================================================================================
  *                                GLOBAL VARIABLE DECLARATIONS
  *  ==============================================================================================*/
 
+#ifdef HSE_TRACING
+/* The trace ring (dump sizeof(hseTraceRing_t) bytes from its address for the decoder) */
+extern hseTraceRing_t gHseTraceRing;
+
+/* Sequence number (u32Head value) of the request in progress on each channel */
+extern uint32_t gHseTraceSlot[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+#endif /* HSE_TRACING */
 
 /*==================================================================================================
  *                                    FUNCTION PROTOTYPES
  *  ==============================================================================================*/
 
+#ifdef HSE_TRACING
+/**
+ * @brief        Initialize the trace ring.
+ * @details      Keeps the records of the previous run if the ring is valid (warm reset), marking
+ *               the requests left in progress with HSE_TRACE_RSP_RESET; otherwise clears it.
+ *               Starts the STM_1 time base. Must be called before the first request.
+ */
+void HSE_TraceInit(void);
+
+/**
+ * @brief        Clear the trace ring.
+ */
+void HSE_TraceClear(void);
+
+/*==================================================================================================
+ *                                    INLINE FUNCTIONS
+ *  ==============================================================================================*/
+
+/**
+ * @brief        Log a request (before it is written to the MU).
+ * @details      Reserves the next record (lock-free, safe from interrupts and from several cores).
+ *
+ * @param[in]    u8MuInstance        The MU instance.
+ * @param[in]    u8Channel           The MU channel.
+ * @param[in]    srvId               The service ID.
+ */
+static inline void HSE_TraceSubmit(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvId_t srvId)
+{
+    uint32_t u32Seq = (uint32_t)atomic_fetch_add_explicit(&gHseTraceRing.u32Head, 1U, memory_order_relaxed);
+    hseTraceRecord_t* pRecord = &gHseTraceRing.records[u32Seq & (NUMBER_OF_REQ - 1U)];
+
+    pRecord->u32SrvId = (uint32_t)srvId;
+    pRecord->u32Response = HSE_TRACE_RSP_PENDING;
+    pRecord->u8MuInstance = u8MuInstance;
+    pRecord->u8Channel = u8Channel;
+    pRecord->u16Boot = (uint16_t)gHseTraceRing.u32Boots;
+    gHseTraceSlot[u8MuInstance][u8Channel] = u32Seq;
+    pRecord->u32SubmitUs = HSE_TRACE_TIMESTAMP();
+}
+
+/**
+ * @brief        Log the response of the request in progress on a channel.
+ * @details      Nothing is logged if the record was already reused by newer requests.
+ *
+ * @param[in]    u8MuInstance        The MU instance.
+ * @param[in]    u8Channel           The MU channel.
+ * @param[in]    srvResponse         The service response.
+ */
+static inline void HSE_TraceComplete(uint8_t u8MuInstance, uint8_t u8Channel, hseSrvResponse_t srvResponse)
+{
+    uint32_t u32Seq = gHseTraceSlot[u8MuInstance][u8Channel];
+    hseTraceRecord_t* pRecord = &gHseTraceRing.records[u32Seq & (NUMBER_OF_REQ - 1U)];
+
+    if(((uint32_t)atomic_load_explicit(&gHseTraceRing.u32Head, memory_order_relaxed) - u32Seq) <= NUMBER_OF_REQ)
+    {
+        pRecord->u32ResponseUs = HSE_TRACE_TIMESTAMP();
+        pRecord->u32Response = (uint32_t)srvResponse;
+    }
+}
+#endif /* HSE_TRACING */
+
 
 #ifdef __cplusplus
 }
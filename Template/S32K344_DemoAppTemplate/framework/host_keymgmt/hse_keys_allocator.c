@@ -26,17 +26,18 @@ extern "C"
 /*==================================================================================================
  *                                        INCLUDE FILES
  ==================================================================================================*/
+#include <stdatomic.h>
 #include "hse_interface.h"
 #include "hse_keys_allocator.h"
+#include "hse_host.h"
+#include "hse_host_import_key.h"
+#include "hse_completion_ring.h"
+#include "host_stm.h"
+#include "string.h"
 
 /*==================================================================================================
  *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
  ==================================================================================================*/
-typedef struct
-{
-    bool_t             keyEmpty;
-} keySlotContext_t;
-
 typedef struct
 {
     hseMuMask_t        muMask;
@@ -44,24 +45,59 @@ typedef struct
     hseKeyType_t       keyType;
     uint8_t            numOfKeySlots;
     uint16_t           maxKeyBitLen;
-    keySlotContext_t   key[0x100];
+    uint8_t            mapOffset;       /* First word of the group in freeMap */
+    uint16_t           infoOffset;      /* Entry of slot 0 of the group in keyInfo */
 } groupContext_t;
 
 typedef struct
 {
-    uint8_t noOfGroups;
-    groupContext_t group[HSE_TOTAL_NUM_OF_KEY_GROUPS];
+    uint8_t            firstGroup;      /* Index of the first group of the catalog in group[] and lookup[] */
+    uint8_t            noOfGroups;
+    uint32_t           freeGroups;      /* Bit i set: group i of the catalog has a free slot */
 } catalogContext_t;
 
 typedef struct
 {
-    catalogContext_t ctx[3];
+    catalogContext_t   ctx[2];          /* NVM and RAM catalogs */
+    uint8_t            noOfGroups;      /* Groups of both catalogs */
+    uint8_t            noOfMapWords;    /* Words of freeMap used by both catalogs */
+    uint16_t           noOfSlots;       /* Key slots of both catalogs */
+    groupContext_t     group[HSE_TOTAL_NUM_OF_KEY_GROUPS];
+    /* Per catalog: group indexes sorted by (groupOwner, keyType, maxKeyBitLen, group index) */
+    hseKeyGroupIdx_t   lookup[HSE_TOTAL_NUM_OF_KEY_GROUPS];
+    uint32_t           freeMap[HKF_FREE_MAP_WORDS];    /* Bit set: key slot free */
+    /* Key info cache, same layout as freeMap */
+    uint32_t           infoMap[HKF_FREE_MAP_WORDS];    /* Bit set: keyInfo entry of the slot valid */
+    uint32_t           emptyMap[HKF_FREE_MAP_WORDS];   /* Bit set: the slot is empty on the device */
+    hseKeyInfo_t       keyInfo[HKF_KEY_INFO_CACHE_SLOTS];
 } allocatorContext_t;
+
+#ifdef HSE_SPT_GET_KEY_INFO
+typedef enum
+{
+    HKF_SYNC_REQ_FREE = 0U,
+    HKF_SYNC_REQ_BUSY,              /* GET_KEY_INFO in flight */
+    HKF_SYNC_REQ_DONE,              /* Response received, not applied yet */
+} hkfSyncReqState_t;
+
+/* GET_KEY_INFO request of HKF_SyncFromDevice() */
+typedef struct
+{
+    hseKeyHandle_t     keyHandle;
+    hseKeyInfo_t       keyInfo;
+    hseSrvResponse_t   status;
+    atomic_uint        state;           /* hkfSyncReqState_t */
+} hkfSyncReq_t;
+#endif /* HSE_SPT_GET_KEY_INFO */
 /*==================================================================================================
  *                                       LOCAL MACROS
  ==================================================================================================*/
-#define HSE_KEY_IS_EMPTY       ((bool_t) 1U)
-#define HSE_KEY_IS_NOT_EMPTY   ((bool_t) 0U)
+/* Words of the free map of a group */
+#define HKF_GROUP_MAP_WORDS(numOfKeySlots)  (((uint32_t)(numOfKeySlots) + 31UL) >> 5U)
+
+/* GET_KEY_INFO requests in flight: one per service channel (channel 0 is reserved for administration services) */
+#define HKF_SYNC_REQS                       (HSE_NUM_OF_CHANNELS_PER_MU - 1U)
+#define HKF_SYNC_CHANNEL_MASK               ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
 
 /*==================================================================================================
  *                                      LOCAL CONSTANTS
@@ -71,6 +107,9 @@ typedef struct
  *                                      LOCAL VARIABLES
  ==================================================================================================*/
 static allocatorContext_t allocatorCtx = { 0U };
+#ifdef HSE_SPT_GET_KEY_INFO
+static hkfSyncReq_t syncReq[HKF_SYNC_REQS];
+#endif /* HSE_SPT_GET_KEY_INFO */
 
 /*==================================================================================================
  *                                      GLOBAL CONSTANTS
@@ -84,6 +123,33 @@ static allocatorContext_t allocatorCtx = { 0U };
  ==================================================================================================*/
 static hseSrvResponse_t HKF_ParseCatalog(const hseKeyGroupCfgEntry_t *pCatalog, catalogContext_t *pCatalogCtx);
 
+static void HKF_FreeGroup(catalogContext_t *pCatalogCtx, hseKeyGroupIdx_t groupIdx, const groupContext_t *pGroupCtx);
+
+static bool_t HKF_GroupHasFreeSlot(const groupContext_t *pGroupCtx);
+
+static void HKF_SortCatalog(const catalogContext_t *pCatalogCtx);
+
+static int32_t HKF_CompareGroup(const groupContext_t *pGroupCtx, hseKeyGroupOwner_t groupOwner,
+                                hseKeyType_t keyType, uint16_t maxKeyBitLen);
+
+static catalogContext_t *HKF_GetCatalog(hseKeyCatalogId_t catId);
+
+static uint32_t *HKF_GetSlotWord(hseKeyHandle_t keyHandle, uint32_t *pBit);
+
+static hseKeyInfo_t *HKF_GetInfoEntry(hseKeyHandle_t keyHandle);
+
+static void HKF_DropKeyInfo(uint32_t word, uint32_t bit);
+
+static void HKF_CacheKeyInfo(hseKeyHandle_t keyHandle, hseSrvResponse_t status, const hseKeyInfo_t *pKeyInfo);
+
+#ifdef HSE_SPT_GET_KEY_INFO
+static void HKF_SyncReqDone(hseSrvResponse_t status, void* pArg);
+
+static hseSrvResponse_t HKF_SyncApply(hkfSyncReq_t *pReq);
+#endif /* HSE_SPT_GET_KEY_INFO */
+
+static uint32_t HKF_Ctz(uint32_t value);
+
 static bool_t verifyGroupMuFlags(hseMuMask_t reqMuMask, hseMuMask_t groupMuMask, bool_t strictMuMask);
 
 /*==================================================================================================
@@ -93,7 +159,11 @@ static hseSrvResponse_t HKF_ParseCatalog(const hseKeyGroupCfgEntry_t *pCatalog,
 {
     hseSrvResponse_t status = HSE_SRV_RSP_GENERAL_ERROR;
     hseKeyGroupIdx_t i;
-    hseKeySlotIdx_t j;
+    groupContext_t *pGroupCtx;
+    uint32_t noOfWords;
+
+    pCatalogCtx->firstGroup = allocatorCtx.noOfGroups;
+    pCatalogCtx->freeGroups = 0UL;
 
     for(i = 0U; i < HSE_TOTAL_NUM_OF_KEY_GROUPS; ++i)
     {
@@ -109,26 +179,231 @@ static hseSrvResponse_t HKF_ParseCatalog(const hseKeyGroupCfgEntry_t *pCatalog,
             break;
         }
 
+        /* The group and its free map must fit in the allocator */
+        noOfWords = HKF_GROUP_MAP_WORDS(pCatalog[i].numOfKeySlots);
+        if((allocatorCtx.noOfGroups >= HSE_TOTAL_NUM_OF_KEY_GROUPS) ||
+           ((allocatorCtx.noOfMapWords + noOfWords) > HKF_FREE_MAP_WORDS))
+        {
+            status = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+            break;
+        }
+
         /* Set group attributes */
-        pCatalogCtx->group[i].muMask        = pCatalog[i].muMask;
-        pCatalogCtx->group[i].groupOwner    = pCatalog[i].groupOwner;
-        pCatalogCtx->group[i].keyType       = pCatalog[i].keyType;
-        pCatalogCtx->group[i].numOfKeySlots = pCatalog[i].numOfKeySlots;
-        pCatalogCtx->group[i].maxKeyBitLen  = pCatalog[i].maxKeyBitLen;
+        pGroupCtx = &allocatorCtx.group[allocatorCtx.noOfGroups];
+        pGroupCtx->muMask        = pCatalog[i].muMask;
+        pGroupCtx->groupOwner    = pCatalog[i].groupOwner;
+        pGroupCtx->keyType       = pCatalog[i].keyType;
+        pGroupCtx->numOfKeySlots = pCatalog[i].numOfKeySlots;
+        pGroupCtx->maxKeyBitLen  = pCatalog[i].maxKeyBitLen;
+        pGroupCtx->mapOffset     = allocatorCtx.noOfMapWords;
+        pGroupCtx->infoOffset    = allocatorCtx.noOfSlots;
 
         /* Set keys as empty */
-        for(j = 0U; j < pCatalog[i].numOfKeySlots; ++j)
-        {
-            pCatalogCtx->group[i].key[j].keyEmpty = HSE_KEY_IS_EMPTY;
-        }
+        HKF_FreeGroup(pCatalogCtx, i, pGroupCtx);
+
+        allocatorCtx.lookup[allocatorCtx.noOfGroups] = i;
+        allocatorCtx.noOfGroups++;
+        allocatorCtx.noOfMapWords += (uint8_t)noOfWords;
+        allocatorCtx.noOfSlots    += pGroupCtx->numOfKeySlots;
     }
 
     /* Set total number of groups for catalog */
     pCatalogCtx->noOfGroups = i;
 
+    HKF_SortCatalog(pCatalogCtx);
+
     return status;
 }
 
+/* Mark all the key slots of a group as empty */
+static void HKF_FreeGroup(catalogContext_t *pCatalogCtx, hseKeyGroupIdx_t groupIdx, const groupContext_t *pGroupCtx)
+{
+    uint32_t noOfWords = HKF_GROUP_MAP_WORDS(pGroupCtx->numOfKeySlots);
+    uint32_t w;
+
+    for(w = 0UL; w < noOfWords; ++w)
+    {
+        allocatorCtx.freeMap[pGroupCtx->mapOffset + w] = 0xFFFFFFFFUL;
+    }
+    if(0U != (pGroupCtx->numOfKeySlots & 0x1FU))
+    {
+        allocatorCtx.freeMap[pGroupCtx->mapOffset + noOfWords - 1UL] =
+            (1UL << (pGroupCtx->numOfKeySlots & 0x1FU)) - 1UL;
+    }
+    if(0U != pGroupCtx->numOfKeySlots)
+    {
+        pCatalogCtx->freeGroups |= (1UL << groupIdx);
+    }
+}
+
+static bool_t HKF_GroupHasFreeSlot(const groupContext_t *pGroupCtx)
+{
+    uint32_t w;
+
+    for(w = 0UL; w < HKF_GROUP_MAP_WORDS(pGroupCtx->numOfKeySlots); ++w)
+    {
+        if(0UL != allocatorCtx.freeMap[pGroupCtx->mapOffset + w])
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Insertion sort of the lookup index of a catalog (a few tens of groups, at init) */
+static void HKF_SortCatalog(const catalogContext_t *pCatalogCtx)
+{
+    hseKeyGroupIdx_t *pLookup = &allocatorCtx.lookup[pCatalogCtx->firstGroup];
+    const groupContext_t *pGroups = &allocatorCtx.group[pCatalogCtx->firstGroup];
+    const groupContext_t *pGroupCtx;
+    hseKeyGroupIdx_t groupIdx;
+    uint32_t i;
+    uint32_t j;
+
+    for(i = 1UL; i < pCatalogCtx->noOfGroups; ++i)
+    {
+        groupIdx  = pLookup[i];
+        pGroupCtx = &pGroups[groupIdx];
+        /* Equal keys keep the catalog order */
+        for(j = i; (j > 0UL) &&
+            (HKF_CompareGroup(&pGroups[pLookup[j - 1UL]], pGroupCtx->groupOwner,
+                              pGroupCtx->keyType, pGroupCtx->maxKeyBitLen) > 0); --j)
+        {
+            pLookup[j] = pLookup[j - 1UL];
+        }
+        pLookup[j] = groupIdx;
+    }
+}
+
+/* Order of a group against the key (groupOwner, keyType, maxKeyBitLen) */
+static int32_t HKF_CompareGroup(const groupContext_t *pGroupCtx, hseKeyGroupOwner_t groupOwner,
+                                hseKeyType_t keyType, uint16_t maxKeyBitLen)
+{
+    if(pGroupCtx->groupOwner != groupOwner)
+    {
+        return (pGroupCtx->groupOwner < groupOwner) ? -1 : 1;
+    }
+    if(pGroupCtx->keyType != keyType)
+    {
+        return (pGroupCtx->keyType < keyType) ? -1 : 1;
+    }
+    if(pGroupCtx->maxKeyBitLen != maxKeyBitLen)
+    {
+        return (pGroupCtx->maxKeyBitLen < maxKeyBitLen) ? -1 : 1;
+    }
+    return 0;
+}
+
+static catalogContext_t *HKF_GetCatalog(hseKeyCatalogId_t catId)
+{
+    catalogContext_t *pCatalogCtx = NULL;
+
+    if(HSE_KEY_CATALOG_ID_NVM == catId)
+    {
+        pCatalogCtx = &allocatorCtx.ctx[0];
+    }
+    else if(HSE_KEY_CATALOG_ID_RAM == catId)
+    {
+        pCatalogCtx = &allocatorCtx.ctx[1];
+    }
+    else
+    {
+        /* ROM keys are not allocated */
+    }
+    return pCatalogCtx;
+}
+
+/* Word of the free map holding the slot of a key handle, or NULL if the slot is not in the catalogs */
+static uint32_t *HKF_GetSlotWord(hseKeyHandle_t keyHandle, uint32_t *pBit)
+{
+    const catalogContext_t *pCatalogCtx = HKF_GetCatalog(GET_CATALOG_ID(keyHandle));
+    hseKeyGroupIdx_t groupId = GET_GROUP_IDX(keyHandle);
+    hseKeySlotIdx_t slotId   = GET_SLOT_IDX(keyHandle);
+    const groupContext_t *pGroupCtx;
+
+    if((HSE_INVALID_KEY_HANDLE == keyHandle) || (NULL == pCatalogCtx) || (groupId >= pCatalogCtx->noOfGroups))
+    {
+        return NULL;
+    }
+
+    pGroupCtx = &allocatorCtx.group[pCatalogCtx->firstGroup + groupId];
+    if(slotId >= pGroupCtx->numOfKeySlots)
+    {
+        return NULL;
+    }
+
+    *pBit = 1UL << (slotId & 0x1FU);
+    return &allocatorCtx.freeMap[pGroupCtx->mapOffset + ((uint32_t)slotId >> 5U)];
+}
+
+/* Key info cache entry of a key handle, or NULL if the slot is not cached */
+static hseKeyInfo_t *HKF_GetInfoEntry(hseKeyHandle_t keyHandle)
+{
+    const catalogContext_t *pCatalogCtx = HKF_GetCatalog(GET_CATALOG_ID(keyHandle));
+    uint32_t entry;
+
+    /* The handle was checked by HKF_GetSlotWord() */
+    entry = (uint32_t)allocatorCtx.group[pCatalogCtx->firstGroup + GET_GROUP_IDX(keyHandle)].infoOffset +
+            GET_SLOT_IDX(keyHandle);
+    return (entry < HKF_KEY_INFO_CACHE_SLOTS) ? &allocatorCtx.keyInfo[entry] : NULL;
+}
+
+/* Drop the cached key info of the slot at bit of freeMap[word] */
+static void HKF_DropKeyInfo(uint32_t word, uint32_t bit)
+{
+    allocatorCtx.infoMap[word]  &= ~bit;
+    allocatorCtx.emptyMap[word] &= ~bit;
+}
+
+/* Record the GET_KEY_INFO response of a slot: the key info, or the slot empty */
+static void HKF_CacheKeyInfo(hseKeyHandle_t keyHandle, hseSrvResponse_t status, const hseKeyInfo_t *pKeyInfo)
+{
+    uint32_t bit = 0UL;
+    uint32_t *pWord = HKF_GetSlotWord(keyHandle, &bit);
+    uint32_t word;
+    hseKeyInfo_t *pEntry;
+
+    if(NULL == pWord)
+    {
+        return;
+    }
+
+    word   = (uint32_t)(pWord - allocatorCtx.freeMap);
+    pEntry = HKF_GetInfoEntry(keyHandle);
+    if((HSE_SRV_RSP_OK == status) && (NULL != pEntry))
+    {
+        *pEntry = *pKeyInfo;
+        allocatorCtx.infoMap[word]  |= bit;
+        allocatorCtx.emptyMap[word] &= ~bit;
+    }
+    else if(HSE_SRV_RSP_KEY_EMPTY == status)
+    {
+        allocatorCtx.infoMap[word]  &= ~bit;
+        allocatorCtx.emptyMap[word] |= bit;
+    }
+    else
+    {
+        /* Not cached */
+    }
+}
+
+/* Index of the least significant bit set (value != 0) */
+static uint32_t HKF_Ctz(uint32_t value)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(value);
+#else
+    uint32_t idx = 0UL;
+
+    while(0UL == (value & 1UL))
+    {
+        value >>= 1U;
+        idx++;
+    }
+    return idx;
+#endif
+}
+
 static bool_t verifyGroupMuFlags(hseMuMask_t reqMuMask, hseMuMask_t groupMuMask, bool_t strictMuMask)
 {
     bool_t result = FALSE;
@@ -160,15 +435,26 @@ hseSrvResponse_t HKF_Init(const hseKeyGroupCfgEntry_t *pNvmCatalog, const hseKey
     /* Avoid MISRA violation */
     (void)status;
 
+    /* The groups and free maps of both catalogs are laid out again */
+    allocatorCtx.noOfGroups   = 0U;
+    allocatorCtx.noOfMapWords = 0U;
+    allocatorCtx.noOfSlots    = 0U;
+    (void)memset(allocatorCtx.infoMap, 0, sizeof(allocatorCtx.infoMap));
+    (void)memset(allocatorCtx.emptyMap, 0, sizeof(allocatorCtx.emptyMap));
+    allocatorCtx.ctx[0].noOfGroups = 0U;
+    allocatorCtx.ctx[0].freeGroups = 0UL;
+    allocatorCtx.ctx[1].noOfGroups = 0U;
+    allocatorCtx.ctx[1].freeGroups = 0UL;
+
     /* Parse NVM catalog */
-    status = HKF_ParseCatalog(pNvmCatalog, &allocatorCtx.ctx[HSE_KEY_CATALOG_ID_NVM]);
+    status = HKF_ParseCatalog(pNvmCatalog, HKF_GetCatalog(HSE_KEY_CATALOG_ID_NVM));
     if(HSE_SRV_RSP_OK != status)
     {
         goto exit;
     }
 
     /* Parse RAM catalog */
-    status = HKF_ParseCatalog(pRamCatalog, &allocatorCtx.ctx[HSE_KEY_CATALOG_ID_RAM]);
+    status = HKF_ParseCatalog(pRamCatalog, HKF_GetCatalog(HSE_KEY_CATALOG_ID_RAM));
     if(HSE_SRV_RSP_OK != status)
     {
         goto exit;
@@ -190,7 +476,15 @@ hseSrvResponse_t HKF_AllocKeySlotAdvanced(
 {
     hseSrvResponse_t status = HSE_SRV_RSP_GENERAL_ERROR;
     hseKeyCatalogId_t catId = HSE_KEY_CATALOG_ID_RAM;
-    catalogContext_t *catalogCtx = &allocatorCtx.ctx[catId];
+    catalogContext_t *catalogCtx;
+    const hseKeyGroupIdx_t *pLookup;
+    groupContext_t *pGroupCtx;
+    uint32_t *pWord;
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint32_t k;
+    uint32_t w;
     hseKeyGroupIdx_t i;
     hseKeySlotIdx_t j;
 
@@ -205,52 +499,62 @@ hseSrvResponse_t HKF_AllocKeySlotAdvanced(
 
     if(NVM_KEY == isNvmKey)
     {
-        catId      = HSE_KEY_CATALOG_ID_NVM;
-        catalogCtx = &allocatorCtx.ctx[catId];
+        catId = HSE_KEY_CATALOG_ID_NVM;
     }
-
-    /* Search for a perfect match */
-    for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+    catalogCtx = HKF_GetCatalog(catId);
+    pLookup    = &allocatorCtx.lookup[catalogCtx->firstGroup];
+
+    /* First group of the owner and key type with maxKeyBitLen >= maxKeyBitLength: the perfect
+     * matches come first, then the bigger keys from the smallest one */
+    lo = 0UL;
+    hi = catalogCtx->noOfGroups;
+    while(lo < hi)
     {
-        if(groupOwner == catalogCtx->group[i].groupOwner &&
-           verifyGroupMuFlags(muMask, catalogCtx->group[i].muMask, strictMuMask) &&
-           keyType == catalogCtx->group[i].keyType && 
-           maxKeyBitLength == catalogCtx->group[i].maxKeyBitLen)
+        mid = (lo + hi) >> 1U;
+        if(HKF_CompareGroup(&allocatorCtx.group[catalogCtx->firstGroup + pLookup[mid]],
+                            groupOwner, keyType, maxKeyBitLength) < 0)
         {
-            groupContext_t *pGroupCtx = &catalogCtx->group[i];
-
-            for(j = 0U; j < pGroupCtx->numOfKeySlots; ++j)
-            {
-                if(HSE_KEY_IS_EMPTY == pGroupCtx->key[j].keyEmpty)
-                {
-                    status                     = HSE_SRV_RSP_OK;
-                    pGroupCtx->key[j].keyEmpty = HSE_KEY_IS_NOT_EMPTY;
-                    *pKeyHandle                = GET_KEY_HANDLE(catId, i, j);
-                    goto exit;
-                }
-            }
+            lo = mid + 1UL;
+        }
+        else
+        {
+            hi = mid;
         }
     }
 
-    /* Try again with bigger keys */
-    for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+    for(k = lo; k < catalogCtx->noOfGroups; ++k)
     {
-        if(groupOwner == catalogCtx->group[i].groupOwner &&
-           verifyGroupMuFlags(muMask, catalogCtx->group[i].muMask, strictMuMask) &&
-           keyType == catalogCtx->group[i].keyType && 
-           maxKeyBitLength <= catalogCtx->group[i].maxKeyBitLen)
+        i         = pLookup[k];
+        pGroupCtx = &allocatorCtx.group[catalogCtx->firstGroup + i];
+
+        if(groupOwner != pGroupCtx->groupOwner || keyType != pGroupCtx->keyType)
         {
-            groupContext_t *pGroupCtx = &catalogCtx->group[i];
+            break;
+        }
+
+        if((0UL == (catalogCtx->freeGroups & (1UL << i))) ||
+           !verifyGroupMuFlags(muMask, pGroupCtx->muMask, strictMuMask))
+        {
+            continue;
+        }
 
-            for(j = 0U; j < pGroupCtx->numOfKeySlots; ++j)
+        for(w = 0UL; w < HKF_GROUP_MAP_WORDS(pGroupCtx->numOfKeySlots); ++w)
+        {
+            pWord = &allocatorCtx.freeMap[pGroupCtx->mapOffset + w];
+            if(0UL != *pWord)
             {
-                if(HSE_KEY_IS_EMPTY == pGroupCtx->key[j].keyEmpty)
+                j       = (hseKeySlotIdx_t)((w << 5U) + HKF_Ctz(*pWord));
+                HKF_DropKeyInfo(pGroupCtx->mapOffset + w, *pWord & (0UL - *pWord));
+                *pWord &= *pWord - 1UL;
+                status      = HSE_SRV_RSP_OK;
+                *pKeyHandle = GET_KEY_HANDLE(catId, i, j);
+
+                /* Last free slot of the group taken */
+                if((0UL == *pWord) && !HKF_GroupHasFreeSlot(pGroupCtx))
                 {
-                    status                     = HSE_SRV_RSP_OK;
-                    pGroupCtx->key[j].keyEmpty = HSE_KEY_IS_NOT_EMPTY;
-                    *pKeyHandle                = GET_KEY_HANDLE(catId, i, j);
-                    goto exit;
+                    catalogCtx->freeGroups &= ~(1UL << i);
                 }
+                goto exit;
             }
         }
     }
@@ -277,10 +581,8 @@ hseSrvResponse_t HKF_AllocKeySlot(
 hseSrvResponse_t HKF_FreeKeySlot(hseKeyHandle_t *keyHandle)
 {
     hseSrvResponse_t status  = HSE_SRV_RSP_GENERAL_ERROR;
-    hseKeyCatalogId_t catId  = GET_CATALOG_ID(*keyHandle);
-    hseKeyGroupIdx_t groupId = GET_GROUP_IDX(*keyHandle);
-    hseKeySlotIdx_t slotId   = GET_SLOT_IDX(*keyHandle);
-    keySlotContext_t * pKeySlot = NULL;
+    uint32_t *pWord = NULL;
+    uint32_t bit = 0UL;
 
     if(HSE_INVALID_KEY_HANDLE == *keyHandle)
     {
@@ -288,11 +590,13 @@ hseSrvResponse_t HKF_FreeKeySlot(hseKeyHandle_t *keyHandle)
         goto exit;
     }
 
-    pKeySlot = &allocatorCtx.ctx[catId].group[groupId].key[slotId];
+    pWord = HKF_GetSlotWord(*keyHandle, &bit);
 
-    if(HSE_KEY_IS_NOT_EMPTY == pKeySlot->keyEmpty)
+    if((NULL != pWord) && (0UL == (*pWord & bit)))
     {
-        pKeySlot->keyEmpty = HSE_KEY_IS_EMPTY;
+        HKF_DropKeyInfo((uint32_t)(pWord - allocatorCtx.freeMap), bit);
+        *pWord |= bit;
+        HKF_GetCatalog(GET_CATALOG_ID(*keyHandle))->freeGroups |= (1UL << GET_GROUP_IDX(*keyHandle));
         *keyHandle = HSE_INVALID_KEY_HANDLE;
         status = HSE_SRV_RSP_OK;
     }
@@ -304,73 +608,282 @@ exit:
 hseSrvResponse_t HKF_IsKeyHandleAllocated(hseKeyHandle_t keyHandle)
 {
     hseSrvResponse_t status  = HSE_SRV_RSP_INVALID_PARAM;
-    hseKeyCatalogId_t catId  = GET_CATALOG_ID(keyHandle);
-    hseKeyGroupIdx_t groupId = GET_GROUP_IDX(keyHandle);
-    hseKeySlotIdx_t slotId   = GET_SLOT_IDX(keyHandle);
-    keySlotContext_t * pKeySlot = NULL;
+    uint32_t bit = 0UL;
+    const uint32_t *pWord = HKF_GetSlotWord(keyHandle, &bit);
 
-    if(HSE_INVALID_KEY_HANDLE == keyHandle)
+    if((NULL != pWord) && (0UL == (*pWord & bit)))
+    {
+        status = HSE_SRV_RSP_OK;
+    }
+
+    return status;
+}
+
+hseSrvResponse_t HKF_MarkAsAllocated(hseKeyHandle_t keyHandle)
+{
+    hseSrvResponse_t status  = HSE_SRV_RSP_INVALID_PARAM;
+    uint32_t bit = 0UL;
+    uint32_t *pWord = HKF_GetSlotWord(keyHandle, &bit);
+    catalogContext_t *catalogCtx;
+
+    if((NULL != pWord) && (0UL != (*pWord & bit)))
+    {
+        HKF_DropKeyInfo((uint32_t)(pWord - allocatorCtx.freeMap), bit);
+        *pWord &= ~bit;
+        status = HSE_SRV_RSP_OK;
+
+        /* Last free slot of the group taken */
+        catalogCtx = HKF_GetCatalog(GET_CATALOG_ID(keyHandle));
+        if(!HKF_GroupHasFreeSlot(&allocatorCtx.group[catalogCtx->firstGroup + GET_GROUP_IDX(keyHandle)]))
+        {
+            catalogCtx->freeGroups &= ~(1UL << GET_GROUP_IDX(keyHandle));
+        }
+    }
+
+    return status;
+}
+
+void HKF_FreeAllKeys(void)
+{
+    catalogContext_t *catalogCtx;
+    hseKeyCatalogId_t catId;
+    hseKeyGroupIdx_t i;
+
+    (void)memset(allocatorCtx.infoMap, 0, sizeof(allocatorCtx.infoMap));
+    (void)memset(allocatorCtx.emptyMap, 0, sizeof(allocatorCtx.emptyMap));
+
+    /* Free nvm and ram catalogs */
+    for(catId = HSE_KEY_CATALOG_ID_NVM; catId <= HSE_KEY_CATALOG_ID_RAM; ++catId)
+    {
+        catalogCtx = HKF_GetCatalog(catId);
+        for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+        {
+            HKF_FreeGroup(catalogCtx, i, &allocatorCtx.group[catalogCtx->firstGroup + i]);
+        }
+    }
+}
+
+void HKF_InvalidateKeyInfo(hseKeyHandle_t keyHandle)
+{
+    uint32_t bit = 0UL;
+    const uint32_t *pWord = HKF_GetSlotWord(keyHandle, &bit);
+
+    if(NULL != pWord)
+    {
+        HKF_DropKeyInfo((uint32_t)(pWord - allocatorCtx.freeMap), bit);
+    }
+}
+
+uint32_t HKF_GetRamUsage(uint32_t *pCacheBytes)
+{
+    if(NULL != pCacheBytes)
+    {
+        *pCacheBytes = (uint32_t)sizeof(allocatorCtx.keyInfo);
+    }
+    return (uint32_t)sizeof(allocatorCtx);
+}
+
+hseSrvResponse_t HKF_GetKeyInfo(hseKeyHandle_t keyHandle, hseKeyInfo_t *pKeyInfo)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_INVALID_PARAM;
+    uint32_t bit = 0UL;
+    const uint32_t *pWord = HKF_GetSlotWord(keyHandle, &bit);
+    uint32_t word;
+
+    if((NULL == pWord) || (NULL == pKeyInfo))
     {
         goto exit;
     }
 
-    pKeySlot = &allocatorCtx.ctx[catId].group[groupId].key[slotId];
-    if(HSE_KEY_IS_NOT_EMPTY == pKeySlot->keyEmpty)
+    word = (uint32_t)(pWord - allocatorCtx.freeMap);
+    if(0UL != (allocatorCtx.infoMap[word] & bit))
     {
+        *pKeyInfo = *HKF_GetInfoEntry(keyHandle);
         status = HSE_SRV_RSP_OK;
     }
+    else if(0UL != (allocatorCtx.emptyMap[word] & bit))
+    {
+        status = HSE_SRV_RSP_KEY_EMPTY;
+    }
+    else
+    {
+        /* Not cached yet */
+        status = GetKeyInfo(keyHandle, pKeyInfo);
+        HKF_CacheKeyInfo(keyHandle, status, pKeyInfo);
+    }
 
 exit:
     return status;
 }
 
-hseSrvResponse_t HKF_MarkAsAllocated(hseKeyHandle_t keyHandle)
+#ifdef HSE_SPT_GET_KEY_INFO
+/* GET_KEY_INFO completion (MU RX interrupt or HSE_PollCompletions) */
+static void HKF_SyncReqDone(hseSrvResponse_t status, void* pArg)
 {
-    hseSrvResponse_t status  = HSE_SRV_RSP_INVALID_PARAM;
-    hseKeyCatalogId_t catId  = GET_CATALOG_ID(keyHandle);
-    hseKeyGroupIdx_t groupId = GET_GROUP_IDX(keyHandle);
-    hseKeySlotIdx_t slotId   = GET_SLOT_IDX(keyHandle);
+    hkfSyncReq_t *pReq = (hkfSyncReq_t *)pArg;
+
+    pReq->status = status;
+    atomic_store(&pReq->state, HKF_SYNC_REQ_DONE);
+}
 
-    keySlotContext_t * pKeySlot = &allocatorCtx.ctx[catId].group[groupId].key[slotId];
+/* Apply the response of a slot to the allocation map and to the cache */
+static hseSrvResponse_t HKF_SyncApply(hkfSyncReq_t *pReq)
+{
+    hseSrvResponse_t status = pReq->status;
+    catalogContext_t *catalogCtx = HKF_GetCatalog(GET_CATALOG_ID(pReq->keyHandle));
+    hseKeyGroupIdx_t groupId = GET_GROUP_IDX(pReq->keyHandle);
+    uint32_t bit = 0UL;
+    uint32_t *pWord = HKF_GetSlotWord(pReq->keyHandle, &bit);
 
-    if(HSE_KEY_IS_EMPTY == pKeySlot->keyEmpty)
+    if(HSE_SRV_RSP_OK == status)
     {
-        pKeySlot->keyEmpty = HSE_KEY_IS_NOT_EMPTY;
+        /* Key present: slot allocated */
+        *pWord &= ~bit;
+    }
+    else if(HSE_SRV_RSP_KEY_EMPTY == status)
+    {
+        *pWord |= bit;
         status = HSE_SRV_RSP_OK;
     }
+    else
+    {
+        /* Slot left as it is */
+    }
+    HKF_CacheKeyInfo(pReq->keyHandle, pReq->status, &pReq->keyInfo);
 
+    if(HKF_GroupHasFreeSlot(&allocatorCtx.group[catalogCtx->firstGroup + groupId]))
+    {
+        catalogCtx->freeGroups |= (1UL << groupId);
+    }
+    else
+    {
+        catalogCtx->freeGroups &= ~(1UL << groupId);
+    }
+
+    atomic_store(&pReq->state, HKF_SYNC_REQ_FREE);
     return status;
 }
 
-void HKF_FreeAllKeys(void)
+hseSrvResponse_t HKF_SyncFromDevice(uint8_t u8MuInstance, uint32_t u32TimeoutUs)
 {
-    hseKeyCatalogId_t catId = HSE_KEY_CATALOG_ID_RAM;
-    catalogContext_t *catalogCtx = &allocatorCtx.ctx[catId];
-    hseKeyGroupIdx_t i;
-    hseKeySlotIdx_t j;
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    hseSrvResponse_t reqStatus;
+    hseTxOptions_t txOptions;
+    hseCtx_t ctx;
+    const catalogContext_t *catalogCtx = HKF_GetCatalog(HSE_KEY_CATALOG_ID_NVM);
+    hseKeyCatalogId_t catId = HSE_KEY_CATALOG_ID_NVM;
+    hseKeyGroupIdx_t groupId = 0U;
+    uint32_t slotId = 0UL;          /* Next slot to query */
+    uint32_t inFlight = 0UL;
+    uint32_t start;
+    uint32_t i;
+
+    if(u8MuInstance >= HSE_NUM_OF_MU_INSTANCES)
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
 
-    /* Free ram catalog */
-    for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+    /* Requests of a timed out pass may still be in flight */
+    for(i = 0UL; i < HKF_SYNC_REQS; i++)
     {
-        groupContext_t *pGroupCtx = &catalogCtx->group[i];
-        for(j = 0U; j < pGroupCtx->numOfKeySlots; ++j)
+        if(HKF_SYNC_REQ_BUSY == atomic_load(&syncReq[i].state))
         {
-            pGroupCtx->key[j].keyEmpty = HSE_KEY_IS_EMPTY;
+            return HSE_SRV_RSP_NOT_ALLOWED;
         }
     }
+    /* The responses they got since are read again by this pass */
+    for(i = 0UL; i < HKF_SYNC_REQS; i++)
+    {
+        atomic_store(&syncReq[i].state, HKF_SYNC_REQ_FREE);
+    }
 
-    catId      = HSE_KEY_CATALOG_ID_NVM;
-    catalogCtx = &allocatorCtx.ctx[catId];
-    /* Free nvm catalog */
-    for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+    /* Responses complete in the RX interrupt */
+    HSE_MU_EnableInterrupts(u8MuInstance, HSE_INT_RESPONSE, HKF_SYNC_CHANNEL_MASK);
+    EnableStmTimebase();
+    start = GetStmTimebaseUs();
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HKF_SyncReqDone;
+
+    while((HSE_KEY_CATALOG_ID_RAM >= catId) || (0UL != inFlight))
     {
-        groupContext_t *pGroupCtx = &catalogCtx->group[i];
-        for(j = 0U; j < pGroupCtx->numOfKeySlots; ++j)
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
         {
-            pGroupCtx->key[j].keyEmpty = HSE_KEY_IS_EMPTY;
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        for(i = 0UL; i < HKF_SYNC_REQS; i++)
+        {
+            /* Apply the responses */
+            if(HKF_SYNC_REQ_DONE == atomic_load(&syncReq[i].state))
+            {
+                reqStatus = HKF_SyncApply(&syncReq[i]);
+                if((HSE_SRV_RSP_OK == status) && (HSE_SRV_RSP_OK != reqStatus))
+                {
+                    status = reqStatus;
+                }
+                inFlight--;
+            }
+
+            /* Next empty group: next catalog */
+            while((HSE_KEY_CATALOG_ID_RAM >= catId) &&
+                  ((groupId >= catalogCtx->noOfGroups) ||
+                   (slotId >= allocatorCtx.group[catalogCtx->firstGroup + groupId].numOfKeySlots)))
+            {
+                slotId = 0UL;
+                if(groupId < catalogCtx->noOfGroups)
+                {
+                    groupId++;
+                }
+                else
+                {
+                    groupId = 0U;
+                    catId++;
+                    catalogCtx = HKF_GetCatalog(catId);
+                }
+            }
+
+            /* Query the next slot on a free channel */
+            if((HSE_KEY_CATALOG_ID_RAM >= catId) && (HKF_SYNC_REQ_FREE == atomic_load(&syncReq[i].state)))
+            {
+                syncReq[i].keyHandle    = GET_KEY_HANDLE(catId, groupId, slotId);
+                txOptions.pCallbackpArg = (void*)&syncReq[i];
+                ctx = HSE_CtxOnChannel(u8MuInstance, HSE_INVALID_CHANNEL, txOptions);
+                atomic_store(&syncReq[i].state, HKF_SYNC_REQ_BUSY);
+                reqStatus = GetKeyInfoCtx(&ctx, syncReq[i].keyHandle, &syncReq[i].keyInfo);
+                if(HSE_SRV_RSP_OK == reqStatus)
+                {
+                    inFlight++;
+                    slotId++;
+                }
+                else
+                {
+                    atomic_store(&syncReq[i].state, HKF_SYNC_REQ_FREE);
+                    if(HSE_SRV_RSP_HOST_CHANNEL_BUSY != reqStatus)
+                    {
+                        /* Slot left as it is */
+                        if(HSE_SRV_RSP_OK == status)
+                        {
+                            status = reqStatus;
+                        }
+                        slotId++;
+                    }
+                }
+            }
+        }
+
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && ((GetStmTimebaseUs() - start) >= u32TimeoutUs))
+        {
+            /* The requests in flight complete later; HKF_SyncFromDevice() returns NOT_ALLOWED until then */
+            status = HSE_SRV_RSP_HOST_TIMEOUT;
+            break;
         }
     }
+
+    return status;
 }
+#endif /* HSE_SPT_GET_KEY_INFO */
 
 #ifdef __cplusplus
 }
@@ -43,6 +43,17 @@ extern "C"{
 #define NVM_KEY 1U
 #define RAM_KEY 0U
 
+/* Words of the key slot free maps of both catalogs (one bit per slot, each group rounded up to
+ * 32 slots). HKF_Init() fails with HSE_SRV_RSP_NOT_ENOUGH_SPACE if the catalogs need more. */
+#ifndef HKF_FREE_MAP_WORDS
+#define HKF_FREE_MAP_WORDS (HSE_TOTAL_NUM_OF_KEY_GROUPS + 16U)
+#endif
+
+/* Key slots of both catalogs (in catalog order) whose key info HKF_GetKeyInfo() caches */
+#ifndef HKF_KEY_INFO_CACHE_SLOTS
+#define HKF_KEY_INFO_CACHE_SLOTS (128U)
+#endif
+
 /*==================================================================================================
  *                                             ENUMS
 ==================================================================================================*/
@@ -95,6 +106,38 @@ hseSrvResponse_t HKF_MarkAsAllocated(
     hseKeyHandle_t keyHandle       /* IN */
 );
 
+/* Static RAM of the allocator state in bytes (groups, lookup index, free maps and key info cache);
+ * *pCacheBytes (can be NULL) receives the part of the key info cache (HKF_KEY_INFO_CACHE_SLOTS) */
+uint32_t HKF_GetRamUsage(
+    uint32_t *pCacheBytes           /* OUT */
+);
+
+/* Key info of a slot: from the cache, or from the HSE (GetKeyInfo) and then cached.
+ * Returns HSE_SRV_RSP_KEY_EMPTY for a slot known empty. */
+hseSrvResponse_t HKF_GetKeyInfo(
+    hseKeyHandle_t keyHandle,       /* IN  */
+    hseKeyInfo_t *pKeyInfo          /* OUT */
+);
+
+/* Drop the cached key info of a slot. Allocating/freeing a slot does it; call it after
+ * writing or erasing any other key read through HKF_GetKeyInfo() (e.g. key update, fixed handle). */
+void HKF_InvalidateKeyInfo(
+    hseKeyHandle_t keyHandle       /* IN */
+);
+
+#ifdef HSE_SPT_GET_KEY_INFO
+/* Rebuild the allocation map from the keys present on the device (call after HKF_Init, before
+ * allocating): a slot is allocated if GET_KEY_INFO returns its key, free if it returns
+ * HSE_SRV_RSP_KEY_EMPTY, and left as it is on other errors (the first one is returned).
+ * The slots of both catalogs are queried asynchronously, one request per free channel, and the
+ * key infos are cached for HKF_GetKeyInfo(). On HSE_SRV_RSP_HOST_TIMEOUT, the requests in flight
+ * complete later and HKF_SyncFromDevice() returns HSE_SRV_RSP_NOT_ALLOWED until then. */
+hseSrvResponse_t HKF_SyncFromDevice(
+    uint8_t u8MuInstance,           /* IN: MU the requests are sent on */
+    uint32_t u32TimeoutUs           /* IN: microseconds, or HSE_WAIT_INFINITE */
+);
+#endif /* HSE_SPT_GET_KEY_INFO */
+
 #ifdef __cplusplus
 }
 #endif
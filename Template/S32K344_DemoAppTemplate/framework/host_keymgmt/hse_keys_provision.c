@@ -0,0 +1,523 @@
+/**
+ *   @file    hse_keys_provision.c
+ *
+ *   @brief   Function implementations for host bulk key provisioning
+ *   @details The entries of the table are sent asynchronously on the free channels of the MU
+ *            instances, an entry being sent once the entries it depends on are provisioned.
+ *
+ *   @addtogroup [KEYMGMT_FRAMEWORK]
+ *   @{
+ */
+/*==================================================================================================
+ *   (c) Copyright 2022 NXP.
+ *
+ *   This software is owned or controlled by NXP and may only be used strictly in accordance with
+ *   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+ *   activating and/or otherwise using the software, you are agreeing that you have read, and that
+ *   you agree to comply with and are bound by, such license terms. If you do not agree to
+ *   be bound by the applicable license terms, then you may not retain, install, activate or
+ *   otherwise use the software.
+ ==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*==================================================================================================
+ *                                        INCLUDE FILES
+ ==================================================================================================*/
+#include <stdatomic.h>
+#include "hse_interface.h"
+#include "hse_keys_provision.h"
+#include "hse_keys_allocator.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_mu.h"
+#include "hse_srv_builders.h"
+#include "hse_completion_ring.h"
+#include "host_compiler_api.h"
+#include "host_stm.h"
+#include "nvic.h"
+
+/*==================================================================================================
+ *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+ ==================================================================================================*/
+typedef enum
+{
+    HKF_PROV_ENTRY_PENDING = 0U,
+    HKF_PROV_ENTRY_SENT,
+    HKF_PROV_ENTRY_DONE,            /* Provisioned */
+    HKF_PROV_ENTRY_FAILED,
+} hkfProvEntryState_t;
+
+typedef enum
+{
+    HKF_PROV_REQ_FREE = 0U,
+    HKF_PROV_REQ_BUSY,              /* Request in flight */
+    HKF_PROV_REQ_DONE,              /* Response received, not applied yet */
+} hkfProvReqState_t;
+
+/* Request of HKF_ProvisionKeys() */
+typedef struct
+{
+    uint16_t           entryIdx;
+    hseSrvResponse_t   status;
+    uint32_t           doneUs;          /* Time base when the response was received */
+    atomic_uint        state;           /* hkfProvReqState_t */
+} hkfProvReq_t;
+
+/*==================================================================================================
+ *                                       LOCAL MACROS
+ ==================================================================================================*/
+/* Requests in flight: one per service channel (channel 0 is reserved for administration services) */
+#define HKF_PROV_REQS                       (HSE_NUM_OF_MU_INSTANCES * (HSE_NUM_OF_CHANNELS_PER_MU - 1U))
+#define HKF_PROV_CHANNEL_MASK               ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* dependsOn, target key, cipher key and authorization key */
+#define HKF_PROV_MAX_DEPS                   (4U)
+
+/* Key loaded by a SHE entry: not a key handle (bit 31 set) */
+#define HKF_PROV_SHE_KEY(groupIdx, keyId)   (0x80000000UL | ((uint32_t)(groupIdx) << 8U) | (uint32_t)(keyId))
+
+/*==================================================================================================
+ *                                      LOCAL CONSTANTS
+ ==================================================================================================*/
+
+/*==================================================================================================
+ *                                      LOCAL VARIABLES
+ ==================================================================================================*/
+static hkfProvReq_t provReq[HKF_PROV_REQS];
+static uint8_t provState[HKF_PROV_MAX_ENTRIES];         /* hkfProvEntryState_t */
+static uint16_t provDeps[HKF_PROV_MAX_ENTRIES][HKF_PROV_MAX_DEPS];
+
+/*==================================================================================================
+ *                                      GLOBAL CONSTANTS
+ ==================================================================================================*/
+
+/*==================================================================================================
+ *                                      GLOBAL VARIABLES
+ ==================================================================================================*/
+/*==================================================================================================
+ *                                   LOCAL FUNCTION PROTOTYPES
+ ==================================================================================================*/
+static uint32_t HKF_ProvTargetKey(const hkfProvEntry_t *pEntry);
+
+static uint16_t HKF_ProvLastWriter(const hkfProvEntry_t *pTable, uint16_t entryIdx, uint32_t key);
+
+static hseSrvResponse_t HKF_ProvBuildDeps(const hkfProvEntry_t *pTable, uint16_t noOfEntries);
+
+static hkfProvEntryState_t HKF_ProvDepsState(uint16_t entryIdx);
+
+static hseSrvResponse_t HKF_ProvSend(const hkfProvEntry_t *pEntry, uint8_t u8MuInstance, hkfProvReq_t *pReq);
+
+static void HKF_ProvReqDone(hseSrvResponse_t status, void* pArg);
+
+static void HKF_ProvWait(uint32_t u32RemainingUs);
+
+/*==================================================================================================
+ *                                       LOCAL FUNCTIONS
+ ==================================================================================================*/
+/* Key written by an entry: key handle, or SHE key ID in its group (M1 = UID | ID | AuthID) */
+static uint32_t HKF_ProvTargetKey(const hkfProvEntry_t *pEntry)
+{
+    if(HKF_PROV_SHE_LOAD_KEY == pEntry->kind)
+    {
+        return HKF_PROV_SHE_KEY(pEntry->sheKey.sheGroupIdx, pEntry->sheKey.pM1[15] >> 4U);
+    }
+    return pEntry->pImportParams->pKey->keyHandle;
+}
+
+/* Last entry before entryIdx writing the key, or HKF_PROV_NO_DEP */
+static uint16_t HKF_ProvLastWriter(const hkfProvEntry_t *pTable, uint16_t entryIdx, uint32_t key)
+{
+    uint16_t i = entryIdx;
+
+    while(i > 0U)
+    {
+        i--;
+        if(key == HKF_ProvTargetKey(&pTable[i]))
+        {
+            return i;
+        }
+    }
+    return HKF_PROV_NO_DEP;
+}
+
+static hseSrvResponse_t HKF_ProvBuildDeps(const hkfProvEntry_t *pTable, uint16_t noOfEntries)
+{
+    const hkfProvEntry_t *pEntry;
+    const hseKeyImportParams_t *pParams;
+    uint16_t i;
+
+    for(i = 0U; i < noOfEntries; i++)
+    {
+        pEntry  = &pTable[i];
+        pParams = pEntry->pImportParams;
+
+        if(((HKF_PROV_NO_DEP != pEntry->dependsOn) && (pEntry->dependsOn >= i)) ||
+           ((HKF_PROV_IMPORT_KEY == pEntry->kind) && ((NULL == pParams) || (NULL == pParams->pKey))) ||
+           ((HKF_PROV_SHE_LOAD_KEY == pEntry->kind) &&
+            ((NULL == pEntry->sheKey.pM1) || (NULL == pEntry->sheKey.pM2) || (NULL == pEntry->sheKey.pM3))) ||
+           (HKF_PROV_SHE_LOAD_KEY < pEntry->kind))
+        {
+            return HSE_SRV_RSP_INVALID_PARAM;
+        }
+
+        provDeps[i][0] = pEntry->dependsOn;
+        provDeps[i][1] = HKF_ProvLastWriter(pTable, i, HKF_ProvTargetKey(pEntry));
+        provDeps[i][2] = HKF_PROV_NO_DEP;
+        provDeps[i][3] = HKF_PROV_NO_DEP;
+        if(HKF_PROV_SHE_LOAD_KEY == pEntry->kind)
+        {
+            provDeps[i][2] = HKF_ProvLastWriter(pTable, i,
+                HKF_PROV_SHE_KEY(pEntry->sheKey.sheGroupIdx, pEntry->sheKey.pM1[15] & 0x0FU));
+        }
+        else
+        {
+            if((NULL != pParams->cipherParams.pKeyHandle) && (HSE_INVALID_KEY_HANDLE != *pParams->cipherParams.pKeyHandle))
+            {
+                provDeps[i][2] = HKF_ProvLastWriter(pTable, i, *pParams->cipherParams.pKeyHandle);
+            }
+            if((NULL != pParams->authParams.pKeyHandle) && (HSE_INVALID_KEY_HANDLE != *pParams->authParams.pKeyHandle))
+            {
+                provDeps[i][3] = HKF_ProvLastWriter(pTable, i, *pParams->authParams.pKeyHandle);
+            }
+        }
+    }
+    return HSE_SRV_RSP_OK;
+}
+
+/* DONE: the entry can be sent, FAILED: a dependency failed, PENDING: wait */
+static hkfProvEntryState_t HKF_ProvDepsState(uint16_t entryIdx)
+{
+    hkfProvEntryState_t state = HKF_PROV_ENTRY_DONE;
+    uint16_t dep;
+    uint32_t i;
+
+    for(i = 0UL; i < HKF_PROV_MAX_DEPS; i++)
+    {
+        dep = provDeps[entryIdx][i];
+        if(HKF_PROV_NO_DEP == dep)
+        {
+            continue;
+        }
+        if(HKF_PROV_ENTRY_FAILED == provState[dep])
+        {
+            return HKF_PROV_ENTRY_FAILED;
+        }
+        if(HKF_PROV_ENTRY_DONE != provState[dep])
+        {
+            state = HKF_PROV_ENTRY_PENDING;
+        }
+    }
+    return state;
+}
+
+/* Send an entry asynchronously on a free channel of the MU */
+static hseSrvResponse_t HKF_ProvSend(const hkfProvEntry_t *pEntry, uint8_t u8MuInstance, hkfProvReq_t *pReq)
+{
+    hseTxOptions_t txOptions;
+    hseCtx_t ctx;
+#ifdef HSE_SPT_SHE
+    hseSrvDescriptor_t *pHseSrvDesc;
+    uint8_t u8MuChannel;
+#endif
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = HKF_ProvReqDone;
+    txOptions.pCallbackpArg   = (void*)pReq;
+    ctx = HSE_CtxOnChannel(u8MuInstance, HSE_INVALID_CHANNEL, txOptions);
+
+    if(HKF_PROV_IMPORT_KEY == pEntry->kind)
+    {
+        return ImportKeyCtx(&ctx, pEntry->pImportParams);
+    }
+
+#ifdef HSE_SPT_SHE
+    pHseSrvDesc = HSE_CtxAcquire(&ctx, &u8MuChannel);
+    if(NULL == pHseSrvDesc)
+    {
+        return HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+    }
+    HSE_BuildSheLoadKeyReq(pHseSrvDesc, pEntry->sheKey.sheGroupIdx, pEntry->sheKey.pM1, pEntry->sheKey.pM2,
+                           pEntry->sheKey.pM3, pEntry->sheKey.pM4, pEntry->sheKey.pM5);
+    return HSE_CtxSend(&ctx, u8MuChannel, pHseSrvDesc);
+#else
+    return HSE_SRV_RSP_NOT_SUPPORTED;
+#endif
+}
+
+/* Request completion (MU RX interrupt or HSE_PollCompletions) */
+static void HKF_ProvReqDone(hseSrvResponse_t status, void* pArg)
+{
+    hkfProvReq_t *pReq = (hkfProvReq_t *)pArg;
+
+    pReq->status = status;
+    pReq->doneUs = GetStmTimebaseUs();
+    atomic_store(&pReq->state, HKF_PROV_REQ_DONE);
+}
+
+/* Low-power wait for the next response or the deadline (see HSE_WaitLowPower in hse_host.c) */
+static void HKF_ProvWait(uint32_t u32RemainingUs)
+{
+#ifndef HSE_VIRTUAL
+    S32_SCB->SCR |= S32_SCB_SCR_SEVONPEND_MASK;
+#endif /* HSE_VIRTUAL */
+
+    if(HSE_WAIT_INFINITE != u32RemainingUs)
+    {
+        NVIC_ClearPendingIRQ(STM_1_IRQ_ID);
+        SetStmTimebaseAlarm(u32RemainingUs);
+    }
+
+    /* A response received since the last check set the event register: WFE returns at once */
+    HSE_WAIT_FOR_EVENT();
+
+    if(HSE_WAIT_INFINITE != u32RemainingUs)
+    {
+        ClearStmTimebaseAlarm();
+        NVIC_ClearPendingIRQ(STM_1_IRQ_ID);
+    }
+}
+
+/*==================================================================================================
+ *                                       GLOBAL FUNCTIONS
+ ==================================================================================================*/
+hseSrvResponse_t HKF_ProvisionKeys(hkfProvEntry_t *pTable, uint16_t noOfEntries, uint8_t u8MuMask,
+                                   uint32_t u32TimeoutUs, hkfProvReport_t *pReport)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    hseSrvResponse_t reqStatus;
+    hkfProvReport_t report = { 0U };
+    hkfProvEntry_t *pEntry;
+    hkfProvEntryState_t depsState;
+    hkfProvReq_t *pReq = NULL;
+    bool_t bNvmUpdated = FALSE;
+    bool_t bChannelFree;
+    bool_t bProgress;
+    uint8_t firstMu = HSE_NUM_OF_MU_INSTANCES;
+    uint8_t nextMu = 0U;
+    uint8_t mu;
+    uint16_t firstPending = 0U;     /* Entries before it are sent or failed */
+    uint16_t noOfDone = 0U;         /* Entries provisioned or failed */
+    uint16_t noOfInFlight = 0U;
+    uint32_t start;
+    uint32_t elapsed;
+    uint32_t i;
+    uint32_t j;
+    uint16_t e;
+
+    if((NULL == pTable) || (0U == noOfEntries) || (noOfEntries > HKF_PROV_MAX_ENTRIES) ||
+       (0U == (u8MuMask & HKF_PROV_ALL_MU)))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    /* Requests of a timed out run may still be in flight */
+    for(i = 0UL; i < HKF_PROV_REQS; i++)
+    {
+        if(HKF_PROV_REQ_BUSY == atomic_load(&provReq[i].state))
+        {
+            return HSE_SRV_RSP_NOT_ALLOWED;
+        }
+    }
+    /* The responses they got since belong to the timed out run */
+    for(i = 0UL; i < HKF_PROV_REQS; i++)
+    {
+        atomic_store(&provReq[i].state, HKF_PROV_REQ_FREE);
+    }
+
+    report.publishStatus = HSE_SRV_RSP_OK;
+    status = HKF_ProvBuildDeps(pTable, noOfEntries);
+    if(HSE_SRV_RSP_OK != status)
+    {
+        return status;
+    }
+    for(e = 0U; e < noOfEntries; e++)
+    {
+        provState[e]             = HKF_PROV_ENTRY_PENDING;
+        pTable[e].status         = HSE_SRV_RSP_GENERAL_ERROR;
+        pTable[e].u32StartUs     = 0UL;
+        pTable[e].u32DurationUs  = 0UL;
+    }
+
+    /* Responses complete in the RX interrupt */
+    for(mu = 0U; mu < HSE_NUM_OF_MU_INSTANCES; mu++)
+    {
+        if(0U != (u8MuMask & (1U << mu)))
+        {
+            HSE_MU_EnableInterrupts(mu, HSE_INT_RESPONSE, HKF_PROV_CHANNEL_MASK);
+            firstMu = (HSE_NUM_OF_MU_INSTANCES == firstMu) ? mu : firstMu;
+        }
+    }
+    EnableStmTimebase();
+    start = GetStmTimebaseUs();
+
+    while(noOfDone < noOfEntries)
+    {
+        bProgress = FALSE;
+
+        /* The completions may be left to the application thread */
+        if(HSE_CompletionsDeferred())
+        {
+            (void)HSE_PollCompletions(0UL);
+        }
+
+        /* Apply the responses */
+        for(i = 0UL; i < HKF_PROV_REQS; i++)
+        {
+            if(HKF_PROV_REQ_DONE != atomic_load(&provReq[i].state))
+            {
+                continue;
+            }
+            e = provReq[i].entryIdx;
+            pEntry = &pTable[e];
+            pEntry->status        = provReq[i].status;
+            pEntry->u32DurationUs = provReq[i].doneUs - start - pEntry->u32StartUs;
+            if(HSE_SRV_RSP_OK == pEntry->status)
+            {
+                provState[e] = HKF_PROV_ENTRY_DONE;
+                report.noOfProvisioned++;
+                if(HKF_PROV_IMPORT_KEY == pEntry->kind)
+                {
+                    HKF_InvalidateKeyInfo(pEntry->pImportParams->pKey->keyHandle);
+                    bNvmUpdated = (HSE_KEY_CATALOG_ID_NVM == GET_CATALOG_ID(pEntry->pImportParams->pKey->keyHandle)) ? TRUE : bNvmUpdated;
+                }
+                else
+                {
+                    /* SHE keys other than RAM_KEY (0xE) are NVM keys */
+                    bNvmUpdated = (0x0EU != (pEntry->sheKey.pM1[15] >> 4U)) ? TRUE : bNvmUpdated;
+                }
+            }
+            else
+            {
+                provState[e] = HKF_PROV_ENTRY_FAILED;
+                report.noOfFailed++;
+                status = (HSE_SRV_RSP_OK == status) ? pEntry->status : status;
+            }
+            noOfDone++;
+            noOfInFlight--;
+            bProgress = TRUE;
+            atomic_store(&provReq[i].state, HKF_PROV_REQ_FREE);
+        }
+
+        /* Send the entries whose dependencies are provisioned, in table order */
+        bChannelFree = TRUE;
+        for(e = firstPending; (e < noOfEntries) && bChannelFree; e++)
+        {
+            if(HKF_PROV_ENTRY_PENDING != provState[e])
+            {
+                firstPending = (e == firstPending) ? (e + 1U) : firstPending;
+                continue;
+            }
+            depsState = HKF_ProvDepsState(e);
+            if(HKF_PROV_ENTRY_FAILED == depsState)
+            {
+                provState[e] = HKF_PROV_ENTRY_FAILED;
+                pTable[e].status = HSE_SRV_RSP_KEY_NOT_AVAILABLE;
+                report.noOfFailed++;
+                noOfDone++;
+                bProgress = TRUE;
+                continue;
+            }
+            if(HKF_PROV_ENTRY_PENDING == depsState)
+            {
+                continue;
+            }
+
+            for(i = 0UL, pReq = NULL; (i < HKF_PROV_REQS) && (NULL == pReq); i++)
+            {
+                pReq = (HKF_PROV_REQ_FREE == atomic_load(&provReq[i].state)) ? &provReq[i] : NULL;
+            }
+            if(NULL == pReq)
+            {
+                break;
+            }
+            pReq->entryIdx = e;
+            atomic_store(&pReq->state, HKF_PROV_REQ_BUSY);
+            pTable[e].u32StartUs = GetStmTimebaseUs() - start;
+
+            /* Spread the requests over the MU instances */
+            reqStatus = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+            for(j = 0UL; (j < HSE_NUM_OF_MU_INSTANCES) && (HSE_SRV_RSP_HOST_CHANNEL_BUSY == reqStatus); j++)
+            {
+                mu = (uint8_t)((nextMu + j) % HSE_NUM_OF_MU_INSTANCES);
+                if(0U != (u8MuMask & (1U << mu)))
+                {
+                    reqStatus = HKF_ProvSend(&pTable[e], mu, pReq);
+                }
+            }
+
+            if(HSE_SRV_RSP_OK == reqStatus)
+            {
+                provState[e] = HKF_PROV_ENTRY_SENT;
+                noOfInFlight++;
+                bProgress = TRUE;
+                nextMu = (uint8_t)((mu + 1U) % HSE_NUM_OF_MU_INSTANCES);
+            }
+            else
+            {
+                atomic_store(&pReq->state, HKF_PROV_REQ_FREE);
+                if(HSE_SRV_RSP_HOST_CHANNEL_BUSY == reqStatus)
+                {
+                    /* All the channels are busy: retried after the next response */
+                    bChannelFree = FALSE;
+                }
+                else
+                {
+                    provState[e] = HKF_PROV_ENTRY_FAILED;
+                    pTable[e].status = reqStatus;
+                    report.noOfFailed++;
+                    noOfDone++;
+                    bProgress = TRUE;
+                    status = (HSE_SRV_RSP_OK == status) ? reqStatus : status;
+                }
+            }
+        }
+
+        elapsed = GetStmTimebaseUs() - start;
+        if((HSE_WAIT_INFINITE != u32TimeoutUs) && (elapsed >= u32TimeoutUs))
+        {
+            /* The requests in flight complete later; HKF_ProvisionKeys() returns NOT_ALLOWED until then */
+            status = HSE_SRV_RSP_HOST_TIMEOUT;
+            break;
+        }
+
+        /* Nothing to do until a request in flight completes */
+        if((FALSE == bProgress) && (0U != noOfInFlight) && (noOfDone < noOfEntries))
+        {
+            HKF_ProvWait((HSE_WAIT_INFINITE == u32TimeoutUs) ? HSE_WAIT_INFINITE : (u32TimeoutUs - elapsed));
+        }
+    }
+
+#if defined(HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)
+    /* One flash write for all the NVM keys, if they were only updated in the RAM mirror */
+    if((HSE_SRV_RSP_HOST_TIMEOUT != status) && bNvmUpdated &&
+       (0U != (HSE_MU_GetHseStatus(firstMu) & HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)))
+    {
+        hseCtx_t ctx = HSE_CtxOnChannel(firstMu, HSE_INVALID_CHANNEL, gSyncTxOption);
+        uint32_t publishStart = GetStmTimebaseUs();
+
+        report.bPublished    = TRUE;
+        report.publishStatus = PublishNvmKeystoreCtx(&ctx);
+        report.u32PublishUs  = GetStmTimebaseUs() - publishStart;
+        status = (HSE_SRV_RSP_OK == status) ? report.publishStatus : status;
+    }
+#else
+    (void)bNvmUpdated;
+#endif
+
+    report.u32TotalUs = GetStmTimebaseUs() - start;
+    if(NULL != pReport)
+    {
+        *pReport = report;
+    }
+    return status;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
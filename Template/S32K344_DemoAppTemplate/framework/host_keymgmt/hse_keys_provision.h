@@ -0,0 +1,136 @@
+/**
+ *   @file    hse_keys_provision.h
+ *
+ *   @brief   Function definitions for host bulk key provisioning
+ *   @details Imports a table of keys (plain, encrypted, authenticated, SHE M1-M5) with one
+ *            asynchronous request per free channel of the MU instances, then publishes the
+ *            NVM keystore once.
+ *
+ *   @addtogroup [KEYMGMT_FRAMEWORK]
+ *   @{
+ */
+/*==================================================================================================
+ *   (c) Copyright 2022 NXP.
+ *
+ *   This software is owned or controlled by NXP and may only be used strictly in accordance with
+ *   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+ *   activating and/or otherwise using the software, you are agreeing that you have read, and that
+ *   you agree to comply with and are bound by, such license terms. If you do not agree to
+ *   be bound by the applicable license terms, then you may not retain, install, activate or
+ *   otherwise use the software.
+==================================================================================================*/
+/*==================================================================================================
+==================================================================================================*/
+
+
+#ifndef HSE_KEYS_PROVISION_H
+#define HSE_KEYS_PROVISION_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+ *                                        INCLUDE FILES
+==================================================================================================*/
+#include "hse_interface.h"
+#include "hse_host_import_key.h"
+
+/*==================================================================================================
+ *                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+ *                                      DEFINES AND MACROS
+==================================================================================================*/
+/* Maximum number of entries of a provisioning table */
+#ifndef HKF_PROV_MAX_ENTRIES
+#define HKF_PROV_MAX_ENTRIES        (64U)
+#endif
+
+/* No explicit dependency */
+#define HKF_PROV_NO_DEP             (0xFFFFU)
+
+/* All the MU instances */
+#define HKF_PROV_ALL_MU             ((uint8_t)((1UL << HSE_NUM_OF_MU_INSTANCES) - 1UL))
+
+/*==================================================================================================
+ *                                             ENUMS
+==================================================================================================*/
+typedef enum
+{
+    HKF_PROV_IMPORT_KEY = 0U,       /* HSE_SRV_ID_IMPORT_KEY: plain, encrypted or authenticated, sym/ECC/RSA */
+    HKF_PROV_SHE_LOAD_KEY,          /* HSE_SRV_ID_SHE_LOAD_KEY: SHE memory update protocol (M1-M5) */
+} hkfProvKind_t;
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+    hseKeyGroupIdx_t   sheGroupIdx;
+    const uint8_t     *pM1;
+    const uint8_t     *pM2;
+    const uint8_t     *pM3;
+    uint8_t           *pM4;             /* OUT: verification message (can be NULL) */
+    uint8_t           *pM5;             /* OUT: verification message (can be NULL) */
+} hkfProvSheKey_t;
+
+/* Entry of a provisioning table */
+typedef struct
+{
+    /* IN */
+    hkfProvKind_t          kind;
+    hseKeyImportParams_t  *pImportParams;   /* HKF_PROV_IMPORT_KEY (see ImportKeyCtx) */
+    hkfProvSheKey_t        sheKey;          /* HKF_PROV_SHE_LOAD_KEY */
+    uint16_t               dependsOn;       /* Earlier entry that must be provisioned first, or HKF_PROV_NO_DEP */
+    /* OUT */
+    hseSrvResponse_t       status;
+    uint32_t               u32StartUs;      /* Request sent, from the start of HKF_ProvisionKeys() */
+    uint32_t               u32DurationUs;   /* Request sent to response received */
+} hkfProvEntry_t;
+
+typedef struct
+{
+    uint16_t           noOfProvisioned;
+    uint16_t           noOfFailed;      /* Errors, and entries not sent because a dependency failed */
+    bool_t             bPublished;      /* HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH sent */
+    hseSrvResponse_t   publishStatus;
+    uint32_t           u32PublishUs;
+    uint32_t           u32TotalUs;
+} hkfProvReport_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+/* Provision a table of keys. The entries are sent asynchronously, one per free channel of the MU
+ * instances of u8MuMask (bit i: MU i), in table order as far as the dependencies allow. An entry
+ * is sent once these earlier entries are provisioned:
+ *  - dependsOn;
+ *  - IMPORT_KEY: the last entries importing its target key, its cipher key or its authorization key;
+ *  - SHE_LOAD_KEY: the last entries loading its key ID or its authorization key ID (M1) in the same group.
+ * An entry whose dependency failed is not sent (status HSE_SRV_RSP_KEY_NOT_AVAILABLE).
+ * The key slots are not erased and the key infos are sent as they are (keyCounter included).
+ * When all the entries are done, the NVM keystore is published once on u8MuMask's first MU
+ * if HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH is set (HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID).
+ * Returns the first error of an entry or of the publish. On HSE_SRV_RSP_HOST_TIMEOUT, the
+ * requests in flight complete later and HKF_ProvisionKeys() returns HSE_SRV_RSP_NOT_ALLOWED until then. */
+hseSrvResponse_t HKF_ProvisionKeys(
+    hkfProvEntry_t *pTable,         /* IN/OUT */
+    uint16_t noOfEntries,           /* IN */
+    uint8_t u8MuMask,               /* IN */
+    uint32_t u32TimeoutUs,          /* IN */
+    hkfProvReport_t *pReport        /* OUT (can be NULL) */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_KEYS_PROVISION_H */
+
+/** @} */
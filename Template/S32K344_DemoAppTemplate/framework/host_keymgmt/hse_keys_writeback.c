@@ -0,0 +1,294 @@
+/**
+ *   @file    hse_keys_writeback.c
+ *
+ *   @brief   Function implementations for the host NVM keystore write-back
+ *   @details The NVM key updates left in the HSE RAM mirror are counted and the updated slots
+ *            recorded; one HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH writes them all.
+ *            Not reentrant: call the HKF_Wb functions from one task.
+ *
+ *   @addtogroup [KEYMGMT_FRAMEWORK]
+ *   @{
+ */
+/*==================================================================================================
+ *   (c) Copyright 2022 NXP.
+ *
+ *   This software is owned or controlled by NXP and may only be used strictly in accordance with
+ *   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+ *   activating and/or otherwise using the software, you are agreeing that you have read, and that
+ *   you agree to comply with and are bound by, such license terms. If you do not agree to
+ *   be bound by the applicable license terms, then you may not retain, install, activate or
+ *   otherwise use the software.
+ ==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*==================================================================================================
+ *                                        INCLUDE FILES
+ ==================================================================================================*/
+#include "hse_interface.h"
+#include "hse_keys_writeback.h"
+#include "hse_keys_allocator.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_mu.h"
+#include "host_stm.h"
+#include <string.h>
+
+#if defined(HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)
+/*==================================================================================================
+ *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+ ==================================================================================================*/
+typedef enum
+{
+    HKF_WB_THRESHOLD = 0U,
+    HKF_WB_IDLE,
+    HKF_WB_FLUSH,
+    HKF_WB_FW_UPDATE,
+} hkfWbReason_t;
+
+/*==================================================================================================
+ *                                       LOCAL MACROS
+ ==================================================================================================*/
+
+/*==================================================================================================
+ *                                      LOCAL CONSTANTS
+ ==================================================================================================*/
+
+/*==================================================================================================
+ *                                      LOCAL VARIABLES
+ ==================================================================================================*/
+static hkfWbConfig_t wbConfig = { 0U, HKF_WB_DISABLED, HKF_WB_DISABLED };
+static hseKeyHandle_t wbDirty[HKF_WB_MAX_DIRTY];
+static uint32_t wbNoOfDirty = 0UL;
+static uint32_t wbPendingUpdates = 0UL;     /* Key updates since the last publish, repeated slots included */
+static uint32_t wbLastUpdateUs = 0UL;
+static hkfWbStats_t wbStats;
+
+/*==================================================================================================
+ *                                      GLOBAL CONSTANTS
+ ==================================================================================================*/
+
+/*==================================================================================================
+ *                                      GLOBAL VARIABLES
+ ==================================================================================================*/
+/*==================================================================================================
+ *                                   LOCAL FUNCTION PROTOTYPES
+ ==================================================================================================*/
+static hseSrvResponse_t HKF_WbPublish(hkfWbReason_t reason);
+
+/*==================================================================================================
+ *                                       LOCAL FUNCTIONS
+ ==================================================================================================*/
+/* Publish the keystore on the configured MU, then clear the dirty slots.
+ * On error the slots stay dirty and the next trigger retries. */
+static hseSrvResponse_t HKF_WbPublish(hkfWbReason_t reason)
+{
+    hseCtx_t ctx = HSE_CtxOnChannel(wbConfig.u8MuInstance, HSE_INVALID_CHANNEL, gSyncTxOption);
+    hseSrvResponse_t status;
+    uint32_t start = GetStmTimebaseUs();
+    uint32_t duration;
+
+    status = PublishNvmKeystoreCtx(&ctx);
+    duration = GetStmTimebaseUs() - start;
+    if(HSE_SRV_RSP_OK != status)
+    {
+        wbStats.u32PublishErrors++;
+        goto exit;
+    }
+
+    wbStats.u32Publishes++;
+    wbStats.u32TotalPublishUs += duration;
+    wbStats.u32MaxPublishUs = (duration > wbStats.u32MaxPublishUs) ? duration : wbStats.u32MaxPublishUs;
+    /* Without the write-back, every update would have been one flash write */
+    wbStats.u32WritesSaved += (wbPendingUpdates > 1UL) ? (wbPendingUpdates - 1UL) : 0UL;
+    switch(reason)
+    {
+        case HKF_WB_THRESHOLD:
+            wbStats.u32ThresholdPublishes++;
+            break;
+        case HKF_WB_IDLE:
+            wbStats.u32IdlePublishes++;
+            break;
+        case HKF_WB_FLUSH:
+            wbStats.u32FlushPublishes++;
+            break;
+        default:
+            wbStats.u32FwUpdatePublishes++;
+            break;
+    }
+    wbNoOfDirty = 0UL;
+    wbPendingUpdates = 0UL;
+exit:
+    return status;
+}
+
+/*==================================================================================================
+ *                                       GLOBAL FUNCTIONS
+ ==================================================================================================*/
+hseSrvResponse_t HKF_WbInit(const hkfWbConfig_t *pConfig, bool_t bEnableRamKeystore)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    hsePublishNvmKeystoreRamtToFlash_t enable = HSE_CFG_YES;
+    hseSrvDescriptor_t *pHseSrvDesc;
+    hseCtx_t ctx;
+    uint8_t u8MuChannel;
+
+    if((NULL != pConfig) && (pConfig->u8MuInstance >= HSE_NUM_OF_MU_INSTANCES))
+    {
+        status = HSE_SRV_RSP_INVALID_PARAM;
+        goto exit;
+    }
+
+    if(NULL != pConfig)
+    {
+        wbConfig = *pConfig;
+    }
+    else
+    {
+        wbConfig.u8MuInstance      = 0U;
+        wbConfig.u32BatchThreshold = HKF_WB_DISABLED;
+        wbConfig.u32IdleUs         = HKF_WB_DISABLED;
+    }
+    wbNoOfDirty = 0UL;
+    wbPendingUpdates = 0UL;
+    (void)memset(&wbStats, 0, sizeof(wbStats));
+    EnableStmTimebase();
+    wbLastUpdateUs = GetStmTimebaseUs();
+
+    if(bEnableRamKeystore)
+    {
+        ctx = HSE_CtxOnChannel(wbConfig.u8MuInstance, HSE_INVALID_CHANNEL, gSyncTxOption);
+        pHseSrvDesc = HSE_CtxAcquire(&ctx, &u8MuChannel);
+        if(NULL == pHseSrvDesc)
+        {
+            status = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
+            goto exit;
+        }
+        (void)memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+        pHseSrvDesc->srvId                     = HSE_SRV_ID_SET_ATTR;
+        pHseSrvDesc->hseSrv.setAttrReq.attrId  = HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID;
+        pHseSrvDesc->hseSrv.setAttrReq.attrLen = sizeof(enable);
+        pHseSrvDesc->hseSrv.setAttrReq.pAttr   = (HOST_ADDR)&enable;
+        status = HSE_CtxSend(&ctx, u8MuChannel, pHseSrvDesc);
+    }
+exit:
+    return status;
+}
+
+hseSrvResponse_t HKF_WbKeyUpdated(hseKeyHandle_t keyHandle)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    uint32_t i;
+
+    if((HSE_KEY_CATALOG_ID_NVM != GET_CATALOG_ID(keyHandle)) ||
+       (0U == (HSE_MU_GetHseStatus(wbConfig.u8MuInstance) & HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)))
+    {
+        goto exit;
+    }
+
+    wbPendingUpdates++;
+    wbStats.u32KeyUpdates++;
+    wbLastUpdateUs = GetStmTimebaseUs();
+    for(i = 0UL; (i < wbNoOfDirty) && (wbDirty[i] != keyHandle); i++)
+    {
+    }
+    if(i == wbNoOfDirty)
+    {
+        if(wbNoOfDirty >= HKF_WB_MAX_DIRTY)
+        {
+            /* No slot left (the last publish failed): the publish also writes this update,
+             * otherwise it stays pending for the next trigger without being recorded */
+            status = HKF_WbPublish(HKF_WB_THRESHOLD);
+            if(HSE_SRV_RSP_OK != status)
+            {
+                status = HSE_SRV_RSP_NOT_ENOUGH_SPACE;
+            }
+            goto exit;
+        }
+        wbDirty[wbNoOfDirty] = keyHandle;
+        wbNoOfDirty++;
+    }
+
+    if((wbNoOfDirty >= HKF_WB_MAX_DIRTY) || (wbPendingUpdates >= wbConfig.u32BatchThreshold))
+    {
+        status = HKF_WbPublish(HKF_WB_THRESHOLD);
+    }
+exit:
+    return status;
+}
+
+hseSrvResponse_t HKF_WbImportKey(uint8_t u8MuInstance, uint8_t u8MuChannel, hseKeyImportParams_t *pImportKeyParams)
+{
+    hseSrvResponse_t status;
+
+    status = ImportKeyReqMuChannel(u8MuInstance, u8MuChannel, pImportKeyParams);
+    if(HSE_SRV_RSP_OK == status)
+    {
+        HKF_InvalidateKeyInfo(pImportKeyParams->pKey->keyHandle);
+        status = HKF_WbKeyUpdated(pImportKeyParams->pKey->keyHandle);
+    }
+    return status;
+}
+
+hseSrvResponse_t HKF_WbPoll(void)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+
+    if((0UL != wbPendingUpdates) && (HKF_WB_DISABLED != wbConfig.u32IdleUs) &&
+       ((GetStmTimebaseUs() - wbLastUpdateUs) >= wbConfig.u32IdleUs))
+    {
+        status = HKF_WbPublish(HKF_WB_IDLE);
+    }
+    return status;
+}
+
+hseSrvResponse_t HKF_WbFlush(void)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+
+    if(0UL != wbPendingUpdates)
+    {
+        status = HKF_WbPublish(HKF_WB_FLUSH);
+    }
+    return status;
+}
+
+hseSrvResponse_t HKF_WbPrepareFwUpdate(void)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+
+    if((0UL != wbPendingUpdates) ||
+       (0U != (HSE_MU_GetHseStatus(wbConfig.u8MuInstance) & HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)))
+    {
+        status = HKF_WbPublish(HKF_WB_FW_UPDATE);
+    }
+    return status;
+}
+
+uint32_t HKF_WbDirtyCount(void)
+{
+    return wbNoOfDirty;
+}
+
+void HKF_WbGetStats(hkfWbStats_t *pStats)
+{
+    if(NULL != pStats)
+    {
+        *pStats = wbStats;
+    }
+}
+
+void HKF_WbResetStats(void)
+{
+    (void)memset(&wbStats, 0, sizeof(wbStats));
+}
+#endif /* HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH */
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,143 @@
+/**
+ *   @file    hse_keys_writeback.h
+ *
+ *   @brief   Function definitions for the host NVM keystore write-back
+ *   @details With HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID set, the NVM key updates are
+ *            only written to the HSE RAM mirror. This layer tracks the updated (dirty) NVM key
+ *            slots and publishes them to the data flash in one write: on a batch threshold, after
+ *            an idle period, on explicit flush and before a firmware update.
+ *
+ *   @addtogroup [KEYMGMT_FRAMEWORK]
+ *   @{
+ */
+/*==================================================================================================
+ *   (c) Copyright 2022 NXP.
+ *
+ *   This software is owned or controlled by NXP and may only be used strictly in accordance with
+ *   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+ *   activating and/or otherwise using the software, you are agreeing that you have read, and that
+ *   you agree to comply with and are bound by, such license terms. If you do not agree to
+ *   be bound by the applicable license terms, then you may not retain, install, activate or
+ *   otherwise use the software.
+==================================================================================================*/
+/*==================================================================================================
+==================================================================================================*/
+
+
+#ifndef HSE_KEYS_WRITEBACK_H
+#define HSE_KEYS_WRITEBACK_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+ *                                        INCLUDE FILES
+==================================================================================================*/
+#include "hse_interface.h"
+#include "hse_host_import_key.h"
+
+/*==================================================================================================
+ *                                          CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+ *                                      DEFINES AND MACROS
+==================================================================================================*/
+/* Maximum number of dirty NVM key slots: reaching it publishes the keystore */
+#ifndef HKF_WB_MAX_DIRTY
+#define HKF_WB_MAX_DIRTY            (32U)
+#endif
+
+/* No batch threshold / no idle publish */
+#define HKF_WB_DISABLED             (0xFFFFFFFFUL)
+
+/*==================================================================================================
+ *                                             ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+    uint8_t            u8MuInstance;        /* MU the publish requests are sent on */
+    uint32_t           u32BatchThreshold;   /* Publish when this many key updates are pending, or HKF_WB_DISABLED */
+    uint32_t           u32IdleUs;           /* Publish from HKF_WbPoll() after no key update for this long, or HKF_WB_DISABLED */
+} hkfWbConfig_t;
+
+typedef struct
+{
+    uint32_t           u32KeyUpdates;       /* NVM key updates left in the RAM mirror */
+    uint32_t           u32Publishes;        /* Successful publishes (data flash writes) */
+    uint32_t           u32WritesSaved;      /* Key updates published in the same flash write as another one */
+    uint32_t           u32PublishErrors;
+    uint32_t           u32ThresholdPublishes;
+    uint32_t           u32IdlePublishes;
+    uint32_t           u32FlushPublishes;
+    uint32_t           u32FwUpdatePublishes;
+    uint32_t           u32MaxPublishUs;
+    uint32_t           u32TotalPublishUs;
+} hkfWbStats_t;
+
+/*==================================================================================================
+                                 GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+#if defined(HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH)
+/* Set the configuration (NULL: MU0, publish only on flush and firmware update) and clear the
+ * dirty slots and the statistics. With bEnableRamKeystore, also sets
+ * HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID (RAM attribute: after every reset). */
+hseSrvResponse_t HKF_WbInit(
+    const hkfWbConfig_t *pConfig,   /* IN (can be NULL) */
+    bool_t bEnableRamKeystore       /* IN */
+);
+
+/* Record an update of an NVM key (import, SHE load, erase) sent by the application.
+ * Nothing is tracked if the HSE already wrote it to the data flash
+ * (HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH clear). Publishes on the batch threshold, and
+ * before recording a new slot when HKF_WB_MAX_DIRTY are dirty (a previous publish failed).
+ * Returns the publish status, HSE_SRV_RSP_NOT_ENOUGH_SPACE if no slot is left and the publish
+ * failed (the update is still published by the next HKF_WbPoll() or HKF_WbFlush()),
+ * HSE_SRV_RSP_OK otherwise. */
+hseSrvResponse_t HKF_WbKeyUpdated(
+    hseKeyHandle_t keyHandle        /* IN */
+);
+
+/* ImportKeyReqMuChannel() followed by HKF_InvalidateKeyInfo() and HKF_WbKeyUpdated() */
+hseSrvResponse_t HKF_WbImportKey(
+    uint8_t u8MuInstance,           /* IN */
+    uint8_t u8MuChannel,            /* IN */
+    hseKeyImportParams_t *pImportKeyParams  /* IN */
+);
+
+/* Publish if no key was updated for u32IdleUs. Call it periodically (e.g. from the idle task). */
+hseSrvResponse_t HKF_WbPoll(void);
+
+/* Publish the dirty NVM key slots now (nothing is sent if there are none) */
+hseSrvResponse_t HKF_WbFlush(void);
+
+/* Publish before HSE_SRV_ID_FIRMWARE_UPDATE: the HSE rejects it (HSE_SRV_RSP_NOT_ALLOWED) while
+ * HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH is set, including for updates not tracked here. */
+hseSrvResponse_t HKF_WbPrepareFwUpdate(void);
+
+/* Number of dirty NVM key slots */
+uint32_t HKF_WbDirtyCount(void);
+
+void HKF_WbGetStats(
+    hkfWbStats_t *pStats            /* OUT */
+);
+
+void HKF_WbResetStats(void);
+#endif /* HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSE_KEYS_WRITEBACK_H */
+
+/** @} */
@@ -55,6 +55,16 @@ extern "C"
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
 
+#ifdef HSE_VIRTUAL
+/* Host build: a failed assertion ends the program instead of hanging it (hse_virtual_target.c) */
+extern void HSE_VirtualAssert(const char* pCondition, const char* pFile, int line);
+#define ASSERT(condition) \
+    do                    \
+    {                     \
+        if (!(condition)) \
+            HSE_VirtualAssert(#condition, __FILE__, __LINE__); \
+    } while (0)
+#else
 #define ASSERT(condition) \
     do                    \
     {                     \
@@ -62,6 +72,7 @@ extern "C"
             while (1)     \
                 ;         \
     } while (0)
+#endif
 
 #define ASSERT_RETRY(condition) \
     while (!(condition))        \
@@ -73,8 +73,40 @@ extern "C"
                 uint8_t KeyNew[AES_BLOCK_SIZE];
         } MemoryUpdate_t;
 
+/* Batch of precomputed SHE key loads (tools/she_mup_generator), little-endian */
+#define MEMORY_UPDATE_BATCH_MAGIC   0x4D454853UL    /* "SHEM" */
+#define MEMORY_UPDATE_BATCH_VERSION 1U
+
+        typedef struct
+        {
+                uint32_t magic;
+                uint16_t version;
+                uint16_t recordSize;    /* sizeof(MemoryUpdateRecord_t) */
+                uint32_t count;         /* Records following the header */
+                uint32_t reserved;
+        } MemoryUpdateBatchHeader_t;
+
+        /* One SHE key load of one device: M1-M3 to send, M4/M5 expected from the HSE */
+        typedef struct
+        {
+                uint8_t uid[15];
+                uint8_t sheGroupId;
+                uint8_t M1[AES_BLOCK_SIZE];
+                uint8_t M2[AES_BLOCK_SIZE * 2];
+                uint8_t M3[AES_BLOCK_SIZE];
+                uint8_t M4[AES_BLOCK_SIZE * 2];
+                uint8_t M5[AES_BLOCK_SIZE];
+        } MemoryUpdateRecord_t;
+
         hseSrvResponse_t MemoryUpdateProtocol(MemoryUpdate_t *pMemUpdate);
 
+        /* Load a precomputed key and check the M4/M5 returned by the HSE */
+        hseSrvResponse_t MemoryUpdateReplay(const MemoryUpdateRecord_t *pRecord);
+
+        /* Replay, in file order, the records of a batch whose UID is pUid (15 bytes) */
+        hseSrvResponse_t MemoryUpdateReplayBatch(const uint8_t *pBatch, uint32_t batchLength,
+                                                 const uint8_t *pUid, uint32_t *pLoaded);
+
 #ifdef __cplusplus
 }
 #endif
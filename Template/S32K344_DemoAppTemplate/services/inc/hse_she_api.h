@@ -47,6 +47,16 @@ extern "C"
 /*==================================================================================================
 *                                          CONSTANTS
 ==================================================================================================*/
+#ifdef HSE_VIRTUAL
+/* Host build: a failed assertion ends the program instead of hanging it (hse_virtual_target.c) */
+extern void HSE_VirtualAssert(const char* pCondition, const char* pFile, int line);
+#define ASSERT(condition) \
+    do                    \
+    {                     \
+        if (!(condition)) \
+            HSE_VirtualAssert(#condition, __FILE__, __LINE__); \
+    } while (0)
+#else
 #define ASSERT(condition) \
     do                    \
     {                     \
@@ -54,6 +64,7 @@ extern "C"
             while (1)     \
                 ;         \
     } while (0)
+#endif
 
 /*==================================================================================================
 *                                      DEFINES AND MACROS
@@ -32,6 +32,9 @@ extern "C"{
 #include "hse_demo_app_services.h"
 #include "hse_global_variables.h"
 #include "hse_host.h"
+#include "hse_host_batch.h"
+#include "hse_srv_builders.h"
+#include "host_compiler_api.h"
 #include "hse_host_aead.h"
 #include "hse_host_cipher.h"
 #include "hse_host_kdf.h"
@@ -86,6 +89,9 @@ typedef struct
 #define BUFFER_SIZE                 (512U)
 #define NUMBER_OF_ASYNC_REQ         (3U)
 #define MAX_REQS_FOR_FAST_CMAC		(50U)
+#define NUMBER_OF_BATCH_REQ         (12U)
+#define HASH_BATCH_OUTPUT_SIZE      (64U)
+#define DESC_BUILD_BENCH_REQS       (1000U)
 #if !defined(CHAR_ARRAY_SIZE_WITHOUT_TRAILING_ZERO)
 #define CHAR_ARRAY_SIZE_WITHOUT_TRAILING_ZERO(x) (sizeof(x) / sizeof((x)[0]) - 1)
 #endif
@@ -431,6 +437,11 @@ uint8_t testoutput[BUFFER_SIZE] = {0};
 uint8_t hashTestOutput[NUMBER_OF_ASYNC_REQ][BUFFER_SIZE] = {0};
 uint32_t hashTestOutputLength[NUMBER_OF_ASYNC_REQ] = {BUFFER_SIZE,
         BUFFER_SIZE, BUFFER_SIZE};
+static hseSrvDescriptor_t hashBatchDescs[NUMBER_OF_BATCH_REQ];
+static hseSrvResponse_t hashBatchResponses[NUMBER_OF_BATCH_REQ];
+static volatile uint32_t hashBatchMask = 0UL;
+static uint8_t hashBatchOutput[NUMBER_OF_BATCH_REQ][HASH_BATCH_OUTPUT_SIZE] = {0};
+static uint32_t hashBatchOutputLength[NUMBER_OF_BATCH_REQ] = {0};
 hashCallbackParams_t callbackParams[HSE_NUM_OF_MU_INSTANCES]
                                     [HSE_NUM_OF_CHANNELS_PER_MU];
 uint8_t KdfNXP_KDF_Output[8] = {0U};
@@ -456,11 +467,21 @@ volatile CryptoServicesTestStartedStatus_t  gCryptoServicesStarted =  CRYPTO_SER
 static uint32_t numberOfResponses = 0;
 volatile hseSrvResponse_t asyncResponses[HSE_NUM_OF_MU_INSTANCES]
                                          [HSE_NUM_OF_CHANNELS_PER_MU] = {0};
+//variables for batch vs sequential hash throughput (in microseconds)
+volatile uint32_t HashSequentialTime = 0U;
+volatile uint32_t HashBatchTime = 0U;
 //variable for time calculation for Fast CMAC generate and verify keys
 volatile uint32_t FastCmacGenerateTime = 0U;
 volatile uint32_t FastCmacVerifyTime = 0U;
 volatile uint32_t TotalFastCmacGenerateTime = 0U;
 volatile uint32_t TotalFastCmacVerifyTime = 0U;
+//STM ticks (48 MHz) to prepare DESC_BUILD_BENCH_REQS descriptors: full memset vs typed builder
+volatile uint32_t CmacDescMemsetTicks = 0U;
+volatile uint32_t CmacDescTypedTicks = 0U;
+volatile uint32_t HashDescMemsetTicks = 0U;
+volatile uint32_t HashDescTypedTicks = 0U;
+volatile uint32_t AesDescMemsetTicks = 0U;
+volatile uint32_t AesDescTypedTicks = 0U;
 hseKeyHandle_t srcKey = HSE_INVALID_KEY_HANDLE;
 hseKeyHandle_t targetSharedSecretKey = HSE_INVALID_KEY_HANDLE;
 
@@ -531,6 +552,7 @@ hseKdfSP800_108Scheme_t KdfSP800_108_Scheme_1 =
  * ============================================================================
 */
 static void HSE_HashRequestCallback(hseSrvResponse_t srvResponse, void *pArg);
+static void HSE_DescBuild_Example(void);
 static void VerifyOutput( void );
 /* ============================================================================
  *                              LOCAL FUNCTIONS
@@ -894,6 +916,189 @@ static hseSrvResponse_t HSE_HashAsync_Example(void)
     return srvResponse;
 }
 
+/******************************************************************************
+ * Function:    HSE_HashBatch_Example
+ * Description: Compares the throughput of NUMBER_OF_BATCH_REQ hash requests
+ *              sent one after the other on MU0 channel 1 against the same
+ *              requests sent with HSE_SendBatch on all free channels.
+ *              Times are stored in HashSequentialTime and HashBatchTime.
+ *****************************************************************************/
+static hseSrvResponse_t HSE_HashBatch_Example(void)
+{
+    hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+    hseHashSrv_t *pHashSrv;
+    uint32_t u32Start;
+    uint8_t i;
+
+    /* Same requests for both runs: SHA-1, SHA2-256, SHA2-512 repeated */
+    memset(hashBatchDescs, 0, sizeof(hashBatchDescs));
+    for (i = 0U; i < NUMBER_OF_BATCH_REQ; i++)
+    {
+        pHashSrv = &(hashBatchDescs[i].hseSrv.hashReq);
+
+        hashBatchDescs[i].srvId = HSE_SRV_ID_HASH;
+        pHashSrv->accessMode    = HSE_ACCESS_MODE_ONE_PASS;
+        pHashSrv->hashAlgo      = hashAlgos[i % NUMBER_OF_ASYNC_REQ];
+        pHashSrv->inputLength   = hashMessagesLengths[i % NUMBER_OF_ASYNC_REQ];
+        pHashSrv->pInput        = PTR_TO_HOST_ADDR(hashMessages[i % NUMBER_OF_ASYNC_REQ]);
+        pHashSrv->pHash         = PTR_TO_HOST_ADDR(hashBatchOutput[i]);
+        pHashSrv->pHashLength   = PTR_TO_HOST_ADDR(&hashBatchOutputLength[i]);
+    }
+
+    EnableStmTimebase();
+
+    /* Sequential: one request at a time on the channel used by the crypto helpers */
+    u32Start = GetStmTimebaseUs();
+    for (i = 0U; i < NUMBER_OF_BATCH_REQ; i++)
+    {
+        hashBatchOutputLength[i] = HASH_BATCH_OUTPUT_SIZE;
+        memcpy(&gHseSrvDesc[MU0][1U], &hashBatchDescs[i], sizeof(hseSrvDescriptor_t));
+        srvResponse = HSE_Send(MU0, 1U, gSyncTxOption, &gHseSrvDesc[MU0][1U]);
+        if (HSE_SRV_RSP_OK != srvResponse)
+        {
+            goto exit;
+        }
+    }
+    HashSequentialTime = GetStmTimebaseUs() - u32Start;
+
+    /* Batch: all free channels of all MUs */
+    for (i = 0U; i < NUMBER_OF_BATCH_REQ; i++)
+    {
+        hashBatchOutputLength[i] = HASH_BATCH_OUTPUT_SIZE;
+    }
+    u32Start = GetStmTimebaseUs();
+    srvResponse = HSE_SendBatch(hashBatchDescs, NUMBER_OF_BATCH_REQ, hashBatchResponses, &hashBatchMask);
+    if (HSE_SRV_RSP_OK != srvResponse)
+    {
+        goto exit;
+    }
+    srvResponse = HSE_BatchWait(HSE_WAIT_DEFAULT_TIMEOUT_US);
+    HashBatchTime = GetStmTimebaseUs() - u32Start;
+    if (HSE_SRV_RSP_OK != srvResponse)
+    {
+        goto exit;
+    }
+    ASSERT(HSE_BATCH_FULL_MASK(NUMBER_OF_BATCH_REQ) == hashBatchMask);
+
+    /* Check the batch outputs */
+    for (i = 0U; i < NUMBER_OF_BATCH_REQ; i++)
+    {
+        if ((hashLength[i % NUMBER_OF_ASYNC_REQ] != hashBatchOutputLength[i]) ||
+            (0 != memcmp(hashBatchOutput[i], hashExpectedOutput[i % NUMBER_OF_ASYNC_REQ],
+                         hashLength[i % NUMBER_OF_ASYNC_REQ])))
+        {
+            srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
+            goto exit;
+        }
+    }
+
+exit:
+    return srvResponse;
+}
+
+/******************************************************************************
+ * Function:    HSE_DescBuild_Example
+ * Description: Host side cost of preparing CMAC, HASH and AES-CBC descriptors
+ *              (nothing is sent): clearing the whole hseSrvDescriptor_t and
+ *              filling the fields one by one, against the typed builders of
+ *              hse_srv_builders.h. Core cycles saved per request =
+ *              (MemsetTicks - TypedTicks) * (core MHz / 48) / DESC_BUILD_BENCH_REQS.
+ *****************************************************************************/
+static void HSE_DescBuild_Example(void)
+{
+    hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[MU0][1U];
+    const hseMacScheme_t macScheme = { .macAlgo = HSE_MAC_ALGO_CMAC, .sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES };
+    uint32_t tagLength = 16UL;
+    uint32_t i;
+
+    /* CMAC */
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+        pHseSrvDesc->srvId                              = HSE_SRV_ID_MAC;
+        pHseSrvDesc->hseSrv.macReq.accessMode           = HSE_ACCESS_MODE_ONE_PASS;
+        pHseSrvDesc->hseSrv.macReq.macScheme            = macScheme;
+        pHseSrvDesc->hseSrv.macReq.authDir              = HSE_AUTH_DIR_GENERATE;
+        pHseSrvDesc->hseSrv.macReq.keyHandle            = aesCmacKeyHandle;
+        pHseSrvDesc->hseSrv.macReq.inputLength          = aesEcbPlaintextLength;
+        pHseSrvDesc->hseSrv.macReq.pInput               = PTR_TO_HOST_ADDR(aesEcbPlaintext);
+        pHseSrvDesc->hseSrv.macReq.pTagLength           = PTR_TO_HOST_ADDR(&tagLength);
+        pHseSrvDesc->hseSrv.macReq.pTag                 = PTR_TO_HOST_ADDR(testoutput);
+        HSE_COMPILER_BARRIER();
+    }
+    CmacDescMemsetTicks = MeasureStm();
+    DisbleStm();
+
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        HSE_BuildMacReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_AUTH_DIR_GENERATE, HSE_SGT_OPTION_NONE,
+                        &macScheme, aesCmacKeyHandle, aesEcbPlaintextLength, aesEcbPlaintext, &tagLength, testoutput);
+        HSE_COMPILER_BARRIER();
+    }
+    CmacDescTypedTicks = MeasureStm();
+    DisbleStm();
+
+    /* HASH */
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+        pHseSrvDesc->srvId                              = HSE_SRV_ID_HASH;
+        pHseSrvDesc->hseSrv.hashReq.accessMode          = HSE_ACCESS_MODE_ONE_PASS;
+        pHseSrvDesc->hseSrv.hashReq.hashAlgo            = HSE_HASH_ALGO_SHA2_256;
+        pHseSrvDesc->hseSrv.hashReq.inputLength         = ARRAY_SIZE(sha256Message);
+        pHseSrvDesc->hseSrv.hashReq.pInput              = PTR_TO_HOST_ADDR(sha256Message);
+        pHseSrvDesc->hseSrv.hashReq.pHashLength         = PTR_TO_HOST_ADDR(&hashTestOutputLength[0]);
+        pHseSrvDesc->hseSrv.hashReq.pHash               = PTR_TO_HOST_ADDR(hashTestOutput[0]);
+        HSE_COMPILER_BARRIER();
+    }
+    HashDescMemsetTicks = MeasureStm();
+    DisbleStm();
+
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        HSE_BuildHashReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256, HSE_SGT_OPTION_NONE,
+                         ARRAY_SIZE(sha256Message), sha256Message, &hashTestOutputLength[0], hashTestOutput[0]);
+        HSE_COMPILER_BARRIER();
+    }
+    HashDescTypedTicks = MeasureStm();
+    DisbleStm();
+
+    /* AES-CBC */
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+        pHseSrvDesc->srvId                              = HSE_SRV_ID_SYM_CIPHER;
+        pHseSrvDesc->hseSrv.symCipherReq.accessMode     = HSE_ACCESS_MODE_ONE_PASS;
+        pHseSrvDesc->hseSrv.symCipherReq.cipherAlgo     = HSE_CIPHER_ALGO_AES;
+        pHseSrvDesc->hseSrv.symCipherReq.cipherBlockMode = HSE_CIPHER_BLOCK_MODE_CBC;
+        pHseSrvDesc->hseSrv.symCipherReq.cipherDir      = HSE_CIPHER_DIR_ENCRYPT;
+        pHseSrvDesc->hseSrv.symCipherReq.keyHandle      = AesNVMKeyHandle;
+        pHseSrvDesc->hseSrv.symCipherReq.pIV            = PTR_TO_HOST_ADDR(iv);
+        pHseSrvDesc->hseSrv.symCipherReq.inputLength    = aesEcbPlaintextLength;
+        pHseSrvDesc->hseSrv.symCipherReq.pInput         = PTR_TO_HOST_ADDR(aesEcbPlaintext);
+        pHseSrvDesc->hseSrv.symCipherReq.pOutput        = PTR_TO_HOST_ADDR(testoutput);
+        HSE_COMPILER_BARRIER();
+    }
+    AesDescMemsetTicks = MeasureStm();
+    DisbleStm();
+
+    EnableStm();
+    for (i = 0U; i < DESC_BUILD_BENCH_REQS; i++)
+    {
+        HSE_BuildSymCipherReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_CIPHER_ALGO_AES,
+                              HSE_CIPHER_BLOCK_MODE_CBC, HSE_CIPHER_DIR_ENCRYPT, HSE_SGT_OPTION_NONE,
+                              AesNVMKeyHandle, iv, aesEcbPlaintextLength, aesEcbPlaintext, testoutput);
+        HSE_COMPILER_BARRIER();
+    }
+    AesDescTypedTicks = MeasureStm();
+    DisbleStm();
+}
+
 /******************************************************************************
  * Function:    HSE_FastCmacwithCounter_Example
  * Description: Example of Fast CMAC with  sent Synchronously
@@ -908,6 +1113,7 @@ static hseSrvResponse_t HSE_FastCmacwithCounter_Example(void)
     uint32_t RxnodecntIdx       = HSE_NUM_OF_MONOTONIC_COUNTERS - 2UL;
     uint32_t volatileCnt       = 0xFFFFFFFFUL;
     uint32_t hseCounter        = 0UL;
+    uint64_t hseCounterValue   = 0ULL;
 
     /* Configure Node A */
     srvResponse = MonotonicCnt_Config(TxnodecntIdx, rpBitSize);
@@ -947,11 +1153,13 @@ static hseSrvResponse_t HSE_FastCmacwithCounter_Example(void)
     ASSERT(0x800001UL == (volatileCnt &0x00FFFFFF) );
 
     /* Read Counter & check for the expected value */
-    srvResponse = MonotonicCnt_Read(TxnodecntIdx, (uint32_t)&hseCounter);
+    /* The HSE writes the full 64-bit counter value */
+    srvResponse = MonotonicCnt_Read(TxnodecntIdx, PTR_TO_HOST_ADDR(&hseCounterValue));
     if(HSE_SRV_RSP_OK != srvResponse)
     {
         goto exit;
     }
+    hseCounter = (uint32_t)hseCounterValue;
     ASSERT(0x800001UL == hseCounter);
 
     /* Verify CMAC with Counter on Node B */
@@ -2110,10 +2318,16 @@ hseSrvResponse_t HSE_Crypto(void)
     gCryptoServicesStarted|=HASH_EXAMPLE_STARTED;
     srvResponse = HSE_HashAsync_Example();
     if( HSE_SRV_RSP_OK == srvResponse)
+    {
+        srvResponse = HSE_HashBatch_Example();
+    }
+    /* host side descriptor preparation cost (no request sent) */
+    HSE_DescBuild_Example();
+    if( HSE_SRV_RSP_OK == srvResponse)
     {
         gCryptoServicesExecuted |= HASH_EXAMPLES_SUCCESS;
     }
-    ASSERT( gCryptoServicesStarted == gCryptoServicesExecuted );
+    ASSERT( (uint32_t)gCryptoServicesStarted == (uint32_t)gCryptoServicesExecuted );
     testStatus |= CRYPTOGRAPHIC_SERVICES_SUCCESS;
     return srvResponse;
 }
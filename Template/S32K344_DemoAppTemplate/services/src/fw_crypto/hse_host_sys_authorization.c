@@ -83,7 +83,7 @@ extern "C"
         hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
 
         /* Get a free channel on MU0 */
-        u8MuChannel = HSE_MU_GetFreeChannel(MU0);
+        u8MuChannel = HSE_GetFreeChannel(MU0);
         if (HSE_INVALID_CHANNEL == u8MuChannel)
         {
             goto exit;
@@ -105,7 +105,7 @@ extern "C"
             memcpy(&pSysAuthReqSrv->authScheme, pAuthScheme, sizeof(hseAuthScheme_t));
         }
         /* Send the request synchronously */
-        srvResponse = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+        srvResponse = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
 
         return srvResponse;
     exit:
@@ -127,7 +127,7 @@ extern "C"
         hseSrvResponse_t srvResponse = HSE_SRV_RSP_GENERAL_ERROR;
 
         /* Get a free channel on MU0 */
-        u8MuChannel = HSE_MU_GetFreeChannel(MU0);
+        u8MuChannel = HSE_GetFreeChannel(MU0);
         if (HSE_INVALID_CHANNEL == u8MuChannel)
         {
             goto exit;
@@ -146,7 +146,7 @@ extern "C"
         pSysAuthRespSrv->authLen[1] = sign1Length;
 
         /* Send the request synchronously */
-        srvResponse = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+        srvResponse = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
 
     exit:
         return srvResponse;
@@ -40,6 +40,7 @@ extern "C"
 #include "hse_host_flashSrv.h"
 #include <string.h>
 #include "hse_host_flash.h"
+#include "hse_keys_writeback.h"
 
     /*=============================================================================
      *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
@@ -135,8 +136,8 @@ extern "C"
     /*=============================================================================
      *                                   LOCAL FUNCTION PROTOTYPES
      * ==========================================================================*/
-    static hseSrvResponse_t Host_SendFwUpdateReqOneShotMode(hseSrvDescriptor_t *pHseSrvDesc);
-    static hseSrvResponse_t Host_SendFwUpdateReqStreamingMode(hseSrvDescriptor_t *pHseSrvDesc);
+    static hseSrvResponse_t Host_SendFwUpdateReqOneShotMode(uint8_t u8MuChannel, hseSrvDescriptor_t *pHseSrvDesc);
+    static hseSrvResponse_t Host_SendFwUpdateReqStreamingMode(uint8_t u8MuChannel, hseSrvDescriptor_t *pHseSrvDesc);
     /*=============================================================================
      *                                       LOCAL FUNCTIONS
      * ==========================================================================*/
@@ -161,8 +162,17 @@ extern "C"
         /* Copy the header of the new pink image */
         (void)memcpy(&newhseFwHdr, (void *)newHseFwaddress, HSE_FW_HDR_SIZE);
 
-        /* Get a free channel on u8MuInstance */
-        u8MuChannel = HSE_MU_GetFreeChannel(MU0);
+#ifdef HSE_SPT_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH
+        /* The NVM keys left in the RAM mirror must be published first, or the update is not allowed */
+        hseStatus = HKF_WbPrepareFwUpdate();
+        if (HSE_SRV_RSP_OK != hseStatus)
+        {
+            goto exit;
+        }
+#endif
+
+        /* Claim a free channel on u8MuInstance: all the update requests are sent on it */
+        u8MuChannel = HSE_GetFreeChannel(MU0);
         if (HSE_INVALID_CHANNEL == u8MuChannel)
         {
             goto exit;
@@ -178,11 +188,11 @@ extern "C"
 
         if (ONE_SHOT == selected_mode)
         {
-            hseStatus = Host_SendFwUpdateReqOneShotMode(pHseSrvDesc);
+            hseStatus = Host_SendFwUpdateReqOneShotMode(u8MuChannel, pHseSrvDesc);
         }
         else
         {
-            hseStatus = Host_SendFwUpdateReqStreamingMode(pHseSrvDesc);
+            hseStatus = Host_SendFwUpdateReqStreamingMode(u8MuChannel, pHseSrvDesc);
         }
 
         /*check if fw install successful, if not then enter while(1) loop*/
@@ -211,29 +221,21 @@ extern "C"
     }
 
 #ifdef HSE_SPT_OTA_FIRMWARE_UPDATE
-    static hseSrvResponse_t Host_SendFwUpdateReqOneShotMode(hseSrvDescriptor_t *pHseSrvDesc)
+    static hseSrvResponse_t Host_SendFwUpdateReqOneShotMode(uint8_t u8MuChannel, hseSrvDescriptor_t *pHseSrvDesc)
     {
-        hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
         pHseSrvDesc->hseSrv.firmwareUpdateReq.accessMode = HSE_ACCESS_MODE_ONE_PASS;
-        /* Get a free channel on u8MuInstance */
-        uint8_t u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-        if (HSE_INVALID_CHANNEL == u8MuChannel)
-            goto exit;
-        hseStatus = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
-    exit:
-        return hseStatus;
+        return HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
     }
 #endif
 
 #ifdef HSE_SPT_OTA_FIRMWARE_UPDATE
-    static hseSrvResponse_t Host_SendFwUpdateReqStreamingMode(hseSrvDescriptor_t *pHseSrvDesc)
+    static hseSrvResponse_t Host_SendFwUpdateReqStreamingMode(uint8_t u8MuChannel, hseSrvDescriptor_t *pHseSrvDesc)
     {
         hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
         hseFWImageAAD_t *FwHeader = (hseFWImageAAD_t *)temporary_address;
         uint32_t chunk_size = 0UL;
         uint32_t total_no_of_chunks = 0UL;
         hseFirmwareUpdateSrv_t *pFwUpdateSrv = &(pHseSrvDesc->hseSrv.firmwareUpdateReq);
-        uint8_t u8MuChannel = 0U;
         uint32_t src_address = temporary_address;
         uint8_t chunkdata[1024U] = {0U};
         uint32_t pending_size = 0U;
@@ -258,16 +260,16 @@ extern "C"
             /* Copy Firmware Code to SRAM */
             memcpy((void *)chunkdata, (void *)src_address, GET_SIZE_IN_MULTIPLE_OF_64_BYTES(factor));
 
-            /* Get a free channel on u8MuInstance */
-            u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-            if (HSE_INVALID_CHANNEL == u8MuChannel)
+            /* The channel claimed for START is released with each response: take it back */
+            if ((0U != chunk_size) && (FALSE == HSE_ChannelTryAcquire(MU0, u8MuChannel)))
             {
                 error_type = INVALID_CHANNEL_ERROR;
                 goto exit;
             }
 
             /* Send Request */
-            if (HSE_SRV_RSP_OK != HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc))
+            if (HSE_SRV_RSP_OK !=
+                HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US))
             {
                 if (0U != chunk_size)
                     error_type = FW_UPDATE_RSP_COMMAND_UPDATE_ERROR;
@@ -306,15 +308,14 @@ extern "C"
         /* Step 3: Set mode to FINISH, last step in fw update */
         pFwUpdateSrv->accessMode = HSE_ACCESS_MODE_FINISH;
 
-        /* Get a free channel on u8MuInstance */
-        u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-        if (HSE_INVALID_CHANNEL == u8MuChannel)
+        /* The stream is finished on the channel it was started on */
+        if ((0U != chunk_size) && (FALSE == HSE_ChannelTryAcquire(MU0, u8MuChannel)))
         {
             error_type = INVALID_CHANNEL_ERROR;
             goto exit;
         }
 
-        hseStatus = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+        hseStatus = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
         if (HSE_SRV_RSP_OK != hseStatus)
             error_type = FW_UPDATE_RSP_COMMAND_FINISH_ERROR;
 
@@ -71,7 +71,7 @@ void CopyFlashToSRAMHseHost(void)
 
     /*Copying the UnsecureBAF Code from flash to RAM to avoid read while write
      *  violation */
-    for (i = 0U; i < (((uint32_t)FlashSrcEndAddr - (uint32_t)FlashSrcAddr) / 4U); i++)
+    for (i = 0U; i < (((uintptr_t)FlashSrcEndAddr - (uintptr_t)FlashSrcAddr) / 4U); i++)
     {
         FlashRamAddr[i] = FlashSrcAddr[i];
     }
@@ -103,7 +103,7 @@ hseSrvResponse_t Get_Attr(
     pHseSrvDesc->hseSrv.getAttrReq.attrId = attrId;
     pHseSrvDesc->hseSrv.getAttrReq.attrLen = attrLen;
     pHseSrvDesc->hseSrv.getAttrReq.pAttr = (HOST_ADDR)pAttr;
-    hseSrvResponse = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+    hseSrvResponse = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
     if (HSE_SRV_RSP_OK != hseSrvResponse)
     {
         goto failed;
@@ -83,16 +83,16 @@ hseSrvResponse_t MonotonicCnt_Increment(uint32_t CounterIndex,
     uint8_t u8MuChannel;
     hseSrvDescriptor_t *pHseSrvDesc = NULL;
 
-    /* Get a free channel on MU0 */
-    u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-    if (HSE_INVALID_CHANNEL == u8MuChannel)
+    if ((CounterIndex > 16U))
     {
         status = HSE_SRV_RSP_INVALID_PARAM;
         goto EXIT;
     }
-    if ((CounterIndex > 16U))
+    /* Claim a free channel on MU0 (owned until the response) */
+    u8MuChannel = HSE_GetFreeChannel(MU0);
+    if (HSE_INVALID_CHANNEL == u8MuChannel)
     {
-        status = HSE_SRV_RSP_INVALID_PARAM;
+        status = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
         goto EXIT;
     }
     pHseSrvDesc = (hseSrvDescriptor_t *)&gHseSrvDesc[MU0][u8MuChannel];
@@ -104,7 +104,7 @@ hseSrvResponse_t MonotonicCnt_Increment(uint32_t CounterIndex,
     pHseSrvDesc->hseSrv.incCounterReq.counterIndex = CounterIndex;
     pHseSrvDesc->hseSrv.incCounterReq.value = CounterNewValue;
 
-    status = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+    status = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
 EXIT:
     return status;
 }
@@ -122,16 +122,16 @@ hseSrvResponse_t MonotonicCnt_Read(uint32_t CounterIndex,
     uint8_t u8MuChannel;
     hseSrvDescriptor_t *pHseSrvDesc = NULL;
 
-    /* Get a free channel on MU0 */
-    u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-    if (HSE_INVALID_CHANNEL == u8MuChannel)
+    if ((CounterIndex > 16U))
     {
         status = HSE_SRV_RSP_INVALID_PARAM;
         goto EXIT;
     }
-    if ((CounterIndex > 16U))
+    /* Claim a free channel on MU0 (owned until the response) */
+    u8MuChannel = HSE_GetFreeChannel(MU0);
+    if (HSE_INVALID_CHANNEL == u8MuChannel)
     {
-        status = HSE_SRV_RSP_INVALID_PARAM;
+        status = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
         goto EXIT;
     }
     pHseSrvDesc = (hseSrvDescriptor_t *)&gHseSrvDesc[MU0][u8MuChannel];
@@ -142,7 +142,7 @@ hseSrvResponse_t MonotonicCnt_Read(uint32_t CounterIndex,
     pHseSrvDesc->hseSrv.readCounterReq.counterIndex = CounterIndex;
     pHseSrvDesc->hseSrv.readCounterReq.pCounterVal = CounterValue;
 
-    status = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+    status = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
 EXIT:
     return status;
 }
@@ -160,21 +160,21 @@ hseSrvResponse_t MonotonicCnt_Config(uint32_t CounterIndex,
     uint8_t u8MuChannel;
     hseSrvDescriptor_t *pHseSrvDesc = NULL;
 
-    /* Get a free channel on MU0 */
-    u8MuChannel = HSE_MU_GetFreeChannel(MU0);
-    if (HSE_INVALID_CHANNEL == u8MuChannel)
+    if ((CounterIndex > 16U))
     {
         status = HSE_SRV_RSP_INVALID_PARAM;
         goto EXIT;
     }
-    if ((CounterIndex > 16U))
+    if ((RPBitSize < 32U) || (RPBitSize > 64U) || (RPBitSize % 8U != 0U))
     {
         status = HSE_SRV_RSP_INVALID_PARAM;
         goto EXIT;
     }
-    if ((RPBitSize < 32U) || (RPBitSize > 64U) || (RPBitSize % 8U != 0U))
+    /* Claim a free channel on MU0 (owned until the response) */
+    u8MuChannel = HSE_GetFreeChannel(MU0);
+    if (HSE_INVALID_CHANNEL == u8MuChannel)
     {
-        status = HSE_SRV_RSP_INVALID_PARAM;
+        status = HSE_SRV_RSP_HOST_CHANNEL_BUSY;
         goto EXIT;
     }
     pHseSrvDesc = (hseSrvDescriptor_t *)&gHseSrvDesc[MU0][u8MuChannel];
@@ -185,7 +185,7 @@ hseSrvResponse_t MonotonicCnt_Config(uint32_t CounterIndex,
     pHseSrvDesc->hseSrv.configSecCounter.counterIndex = CounterIndex;
     pHseSrvDesc->hseSrv.configSecCounter.RPBitSize = RPBitSize;
 
-    status = HSE_Send(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc);
+    status = HSE_SendOnClaimed(MU0, u8MuChannel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
 EXIT:
     return status;
 }
@@ -214,7 +214,7 @@ hseSrvResponse_t monotonicCounterserviceSelect()
         MonotonicCntResponse = MonotonicCnt_Increment(MonotonicCntIndex, MonotonicCntIncrementValue);
         break;
     case MONOTONIC_CNT_READ:
-        MonotonicCntResponse = MonotonicCnt_Read(MonotonicCntIndex, (uint32_t)&MonotonicCntReadValue);
+        MonotonicCntResponse = MonotonicCnt_Read(MonotonicCntIndex, (HOST_ADDR)(uintptr_t)&MonotonicCntReadValue);
         break;
     default:
         MonotonicCntResponse = HSE_SRV_RSP_INVALID_PARAM;
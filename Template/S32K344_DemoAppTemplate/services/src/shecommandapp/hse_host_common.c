@@ -28,6 +28,7 @@ extern "C"
 #include "hse_she_api.h"
 #include "hse_interface.h"
 #include "hse_host.h"
+#include "hse_srv_builders.h"
 #include "hse_host_wrappers.h"
 #include "hse_she_commands.h"
 #include "hse_memory_update_protocol.h"
@@ -160,14 +161,8 @@ extern "C"
     {
         hseSrvResponse_t hseStatus = HSE_SRV_RSP_GENERAL_ERROR;
         hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-        hseGetRandomNumSrv_t *pGetRndSrv;
 
-        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-        pHseSrvDesc->srvId = HSE_SRV_ID_GET_RANDOM_NUM;
-        pGetRndSrv = &(pHseSrvDesc->hseSrv.getRandomNumReq);
-        pGetRndSrv->rngClass = rngClass;
-        pGetRndSrv->pRandomNum = (HOST_ADDR)rngNum;
-        pGetRndSrv->randomNumLength = rngNumSize;
+        HSE_BuildGetRandomNumReq(pHseSrvDesc, rngClass, rngNumSize, rngNum);
 
         hseStatus = HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
         return hseStatus;
@@ -192,23 +187,9 @@ extern "C"
         hseSGTOption_t inputSgtType)
     {
         hseSrvDescriptor_t *pHseSrvDesc = &gHseSrvDesc[muIf][muChannelIdx];
-        hseSymCipherSrv_t *pSymCipherReq;
-        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
-
-        pHseSrvDesc->srvId = HSE_SRV_ID_SYM_CIPHER;
-        pSymCipherReq = &pHseSrvDesc->hseSrv.symCipherReq;
-
-        pSymCipherReq->accessMode = accessMode;
-        pSymCipherReq->cipherAlgo = cipherAlgo;
-        pSymCipherReq->cipherBlockMode = cipherBlockMode;
-        pSymCipherReq->cipherDir = cipherDir;
-        pSymCipherReq->keyHandle = keyHandle;
 
-        pSymCipherReq->pIV = (HOST_ADDR)pIV;
-        pSymCipherReq->inputLength = inputLength;
-        pSymCipherReq->pInput = (HOST_ADDR)pInput;
-        pSymCipherReq->pOutput = (HOST_ADDR)pOutput;
-        pSymCipherReq->sgtOption = inputSgtType;
+        HSE_BuildSymCipherReq(pHseSrvDesc, accessMode, 0U, cipherAlgo, cipherBlockMode, cipherDir,
+                              inputSgtType, keyHandle, pIV, inputLength, pInput, pOutput);
 
         return HSE_Send(muIf, muChannelIdx, gSyncTxOption, pHseSrvDesc);
     }
@@ -256,7 +256,7 @@ extern "C"
     {
         // uint32_t sheLoadPlainKeyResult = 0UL;
         hseSrvResponse_t status;
-        hseSrvResponse_t hseResponse;
+        hseSrvResponse_t hseResponse = HSE_SRV_RSP_GENERAL_ERROR;
         uint32_t resp = 0;
         uint8_t ramKey[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x00C, 0x0D, 0x0E, 0x0F};
         /*
@@ -316,6 +316,73 @@ hseSrvResponse_t MemoryUpdateProtocol(MemoryUpdate_t *pMemUpdate)
 
 }
 
+/********************************************************************************
+ * Function:    MemoryUpdateReplay
+ * @brief       Load a key with M1-M3 computed off-target.
+ * @details     M4 and M5 returned by HSE are checked against the expected values of the record.
+ ******************************************************************************/
+hseSrvResponse_t MemoryUpdateReplay(const MemoryUpdateRecord_t *pRecord)
+{
+    hseSrvResponse_t status;
+    uint8_t M4_o[AES_BLOCK_SIZE * 2];
+    uint8_t M5_o[AES_BLOCK_SIZE];
+
+    status = cmd_load_key(pRecord->sheGroupId, (uint8_t *)pRecord->M1, (uint8_t *)pRecord->M2,
+                          (uint8_t *)pRecord->M3, M4_o, M5_o);
+    if(HSE_SRV_RSP_OK != status)
+    {
+        return status;
+    }
+    if((0 == memcmp(pRecord->M4, M4_o, ARRAY_SIZE(M4_o))) && (0 == memcmp(pRecord->M5, M5_o, ARRAY_SIZE(M5_o))))
+    {
+        return HSE_SRV_RSP_OK;
+    }
+    else
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+}
+
+/********************************************************************************
+ * Function:    MemoryUpdateReplayBatch
+ * @brief       Load the keys of this device from a batch file.
+ * @details     The records whose UID matches are replayed in file order (an authorizing key
+ *              comes before the keys it authorizes); stops at the first error.
+ ******************************************************************************/
+hseSrvResponse_t MemoryUpdateReplayBatch(const uint8_t *pBatch, uint32_t batchLength,
+                                         const uint8_t *pUid, uint32_t *pLoaded)
+{
+    hseSrvResponse_t status = HSE_SRV_RSP_OK;
+    MemoryUpdateBatchHeader_t header;
+    MemoryUpdateRecord_t record;
+    uint32_t i;
+
+    *pLoaded = 0UL;
+    if(batchLength < sizeof(header))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+    memcpy(&header, pBatch, sizeof(header));
+    if((MEMORY_UPDATE_BATCH_MAGIC != header.magic) || (MEMORY_UPDATE_BATCH_VERSION != header.version) ||
+       (sizeof(record) != header.recordSize) ||
+       (header.count > ((batchLength - sizeof(header)) / sizeof(record))))
+    {
+        return HSE_SRV_RSP_INVALID_PARAM;
+    }
+
+    for(i = 0UL; (i < header.count) && (HSE_SRV_RSP_OK == status); i++)
+    {
+        /* The batch may not be aligned */
+        memcpy(&record, &pBatch[sizeof(header) + (i * sizeof(record))], sizeof(record));
+        if(0 == memcmp(record.uid, pUid, sizeof(record.uid)))
+        {
+            status = MemoryUpdateReplay(&record);
+            *pLoaded += (HSE_SRV_RSP_OK == status) ? 1UL : 0UL;
+        }
+    }
+    return status;
+}
+
 #ifdef __cplusplus
 }
 #endif
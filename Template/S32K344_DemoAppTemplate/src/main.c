@@ -29,6 +29,7 @@
  */
 #include "S32K344.h"
 #include "hse_host.h"
+#include "hse_tracing.h"
 #include "hse_demo_app_services.h"
 
 /*==================================================================================================
@@ -63,6 +64,10 @@
 
 
 int main(void) {
+#ifdef HSE_TRACING
+	/*Keep the HSE requests traced before a warm reset*/
+	HSE_TraceInit();
+#endif
 	/*Check Fw Install Status*/
 	WaitForHSEFWInitToFinish();
 
@@ -0,0 +1,166 @@
+/**
+*   @file    bench_aead_pipe.c
+*
+*   @brief   Throughput of the AEAD pipeline per chunk size (virtual HSE).
+*   @details Encrypts one message with AES-GCM through staging buffers, chunk by chunk with the
+*            synchronous AesGcmStream() steps and with HSE_AeadPipeRun(), for chunk sizes from
+*            256 bytes to 64 KB, and prints the MB/s of both: the fastest pipeline chunk size is
+*            the one to configure. Usage: bench_aead_pipe [message bytes] [AEAD latency per step
+*            in us] [AEAD latency in ns per byte].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_aead.h"
+#include "hse_host_import_key.h"
+#include "hse_host_aead_pipe.h"
+
+#define HSE_BENCH_KEY               GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+#define HSE_BENCH_MAX_CHUNK_SIZE    (65536UL)
+#define HSE_BENCH_TAG_LENGTH        (16UL)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t iv[12] = { 0xCAU, 0xFEU, 0xBAU, 0xBEU, 0xFAU, 0xCEU, 0xDBU, 0xADU, 0xDEU, 0xCAU, 0xF8U, 0x88U };
+static const uint8_t aad[16] = { 0xFEU, 0xEDU, 0xFAU, 0xCEU, 0xDEU, 0xADU, 0xBEU, 0xEFU };
+
+static const uint32_t chunkSizes[] = { 256UL, 1024UL, 4096UL, 16384UL, 65536UL };
+
+static uint8_t* pPlainText;
+static uint8_t* pBlockingOut;
+static uint8_t* pPipeOut;
+static uint8_t* pStage[2];
+
+static double MegabytesPerSecond(uint32_t u32Length, uint64_t u64ElapsedUs)
+{
+    return (0ULL == u64ElapsedUs) ? 0.0 : (double)u32Length / (double)u64ElapsedUs;
+}
+
+/* One synchronous step per chunk: the next chunk is copied in once the previous one is done */
+static double RunBlocking(uint32_t u32Length, uint32_t u32ChunkSize, uint8_t* pTag)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t u32Offset = 0UL;
+    uint32_t u32Chunk;
+    hseAccessMode_t accessMode;
+
+    HSE_TEST_CHECK_RSP(AesGcmStream(HSE_ACCESS_MODE_START, 0UL, HSE_CIPHER_DIR_ENCRYPT, HSE_BENCH_KEY,
+                                    sizeof(iv), iv, sizeof(aad), aad, 0UL, NULL, 0UL, NULL, NULL), HSE_SRV_RSP_OK);
+    do
+    {
+        u32Chunk = ((u32Length - u32Offset) < u32ChunkSize) ? (u32Length - u32Offset) : u32ChunkSize;
+        accessMode = ((u32Offset + u32Chunk) == u32Length) ? HSE_ACCESS_MODE_FINISH : HSE_ACCESS_MODE_UPDATE;
+        memcpy(pStage[0], &pPlainText[u32Offset], u32Chunk);
+        HSE_TEST_CHECK_RSP(AesGcmStream(accessMode, 0UL, HSE_CIPHER_DIR_ENCRYPT, HSE_BENCH_KEY, 0UL, NULL, 0UL, NULL,
+                                        u32Chunk, pStage[0],
+                                        (HSE_ACCESS_MODE_FINISH == accessMode) ? HSE_BENCH_TAG_LENGTH : 0UL,
+                                        (HSE_ACCESS_MODE_FINISH == accessMode) ? pTag : NULL, pStage[0]),
+                           HSE_SRV_RSP_OK);
+        memcpy(&pBlockingOut[u32Offset], pStage[0], u32Chunk);
+        u32Offset += u32Chunk;
+    } while(u32Offset < u32Length);
+    return MegabytesPerSecond(u32Length, HSE_TestNowUs() - u64Start);
+}
+
+/* The pipeline: the next chunk is copied in while the HSE processes the current one */
+static double RunPipe(uint32_t u32Length, uint32_t u32ChunkSize, uint8_t* pTag)
+{
+    hseAeadPipeConfig_t config;
+    uint64_t u64Start;
+
+    memset(&config, 0, sizeof(config));
+    config.u8MuInstance   = 0U;
+    config.streamId       = 1U;
+    config.authCipherMode = HSE_AUTH_CIPHER_MODE_GCM;
+    config.cipherDir      = HSE_CIPHER_DIR_ENCRYPT;
+    config.keyHandle      = HSE_BENCH_KEY;
+    config.ivLength       = sizeof(iv);
+    config.pIV            = iv;
+    config.aadLength      = sizeof(aad);
+    config.pAAD           = aad;
+    config.u32ChunkSize   = u32ChunkSize;
+    config.pStage[0]      = pStage[0];
+    config.pStage[1]      = pStage[1];
+
+    u64Start = HSE_TestNowUs();
+    HSE_TEST_CHECK_RSP(HSE_AeadPipeRun(&config, u32Length, pPlainText, pPipeOut, HSE_BENCH_TAG_LENGTH, pTag,
+                                       HSE_WAIT_INFINITE), HSE_SRV_RSP_OK);
+    return MegabytesPerSecond(u32Length, HSE_TestNowUs() - u64Start);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Length = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : (1UL << 20);
+    uint32_t u32LatencyUs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 20UL;
+    uint32_t u32LatencyNsPerByte = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 4UL;
+    uint8_t blockingTag[HSE_BENCH_TAG_LENGTH];
+    uint8_t pipeTag[HSE_BENCH_TAG_LENGTH];
+    uint32_t i;
+
+    /* Whole blocks: every chunk size divides the message into UPDATE steps of whole blocks */
+    u32Length -= u32Length % HSE_AEAD_PIPE_BLOCK_LENGTH;
+    pPlainText = malloc(u32Length);
+    pBlockingOut = malloc(u32Length);
+    pPipeOut = malloc(u32Length);
+    pStage[0] = malloc(HSE_BENCH_MAX_CHUNK_SIZE);
+    pStage[1] = malloc(HSE_BENCH_MAX_CHUNK_SIZE);
+    if((0UL == u32Length) || (NULL == pPlainText) || (NULL == pBlockingOut) || (NULL == pPipeOut) ||
+       (NULL == pStage[0]) || (NULL == pStage[1]) || (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(i = 0UL; i < u32Length; i++)
+    {
+        pPlainText[i] = (uint8_t)(i * 7UL);
+    }
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_BENCH_KEY, HSE_KEY_TYPE_AES,
+                                            HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_AEAD, u32LatencyUs, u32LatencyNsPerByte), HSE_SRV_RSP_OK);
+
+    printf("AES-GCM encryption, %lu bytes, AEAD latency %lu us + %lu ns/byte\n",
+           (unsigned long)u32Length, (unsigned long)u32LatencyUs, (unsigned long)u32LatencyNsPerByte);
+    printf("%10s %16s %16s %8s\n", "chunk [B]", "blocking [MB/s]", "pipeline [MB/s]", "speedup");
+    for(i = 0UL; i < (sizeof(chunkSizes) / sizeof(chunkSizes[0])); i++)
+    {
+        double blocking;
+        double pipe;
+
+        blocking = RunBlocking(u32Length, chunkSizes[i], blockingTag);
+        pipe = RunPipe(u32Length, chunkSizes[i], pipeTag);
+        HSE_TEST_CHECK(0 == memcmp(pBlockingOut, pPipeOut, u32Length));
+        HSE_TEST_CHECK(0 == memcmp(blockingTag, pipeTag, sizeof(pipeTag)));
+        printf("%10lu %16.1f %16.1f %7.2fx\n", (unsigned long)chunkSizes[i], blocking, pipe,
+               (blocking > 0.0) ? (pipe / blocking) : 0.0);
+    }
+
+    HSE_VirtualDeinit();
+    free(pStage[1]);
+    free(pStage[0]);
+    free(pPipeOut);
+    free(pBlockingOut);
+    free(pPlainText);
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,149 @@
+/**
+*   @file    bench_batch.c
+*
+*   @brief   Request rate of HSE_SendBatch() against one synchronous request at a time (virtual HSE).
+*   @details Runs the same SHA-256 one pass requests of 64 and 1024 bytes one by one with HSE_SendOnClaimed()
+*            and as batches of HSE_BATCH_MAX_REQUESTS with HSE_SendBatch()/HSE_BatchWait(), and
+*            prints the requests per second of both. The virtual HSE runs one request at a time,
+*            like the firmware: the batch gains the host turnaround between two requests, not the
+*            service latency. Usage: bench_batch [requests per run] [hash latency in us].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_batch.h"
+#include "hse_srv_builders.h"
+
+#define HSE_BENCH_MAX_LENGTH        (1024UL)
+
+static const uint32_t inputLengths[] = { 64UL, 1024UL };
+
+/* Read and written by the HSE */
+static uint8_t input[HSE_BATCH_MAX_REQUESTS][HSE_BENCH_MAX_LENGTH];
+static uint8_t digest[HSE_BATCH_MAX_REQUESTS][32];
+static uint32_t digestLength[HSE_BATCH_MAX_REQUESTS];
+static hseSrvDescriptor_t descs[HSE_BATCH_MAX_REQUESTS];
+static hseSrvResponse_t responses[HSE_BATCH_MAX_REQUESTS];
+
+static void BuildRequests(uint32_t u32Length)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_BATCH_MAX_REQUESTS; i++)
+    {
+        memset(input[i], (int)i, u32Length);
+        digestLength[i] = sizeof(digest[i]);
+        HSE_BuildHashReq(&descs[i], HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256, HSE_SGT_OPTION_NONE,
+                         u32Length, input[i], &digestLength[i], digest[i]);
+    }
+}
+
+static bool_t DigestsOk(uint32_t u32Length)
+{
+    uint8_t expected[32];
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_BATCH_MAX_REQUESTS; i++)
+    {
+        (void)EVP_Digest(input[i], u32Length, expected, NULL, EVP_sha256(), NULL);
+        if(0 != memcmp(digest[i], expected, sizeof(expected)))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static double RequestsPerSecond(uint32_t u32Count, uint64_t u64ElapsedUs)
+{
+    return (0ULL == u64ElapsedUs) ? 0.0 : ((double)u32Count * 1000000.0) / (double)u64ElapsedUs;
+}
+
+/* One synchronous request at a time, on a free channel */
+static double RunSequential(uint32_t u32Count)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint8_t u8Channel;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        u8Channel = HSE_GetFreeChannel(0U);
+        memcpy(&gHseSrvDesc[0U][u8Channel], &descs[i % HSE_BATCH_MAX_REQUESTS], sizeof(hseSrvDescriptor_t));
+        HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, &gHseSrvDesc[0U][u8Channel],
+                                             HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    }
+    return RequestsPerSecond(u32Count, HSE_TestNowUs() - u64Start);
+}
+
+/* Batches of HSE_BATCH_MAX_REQUESTS on all channels */
+static double RunBatch(uint32_t u32Count)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t u32Batch;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i += u32Batch)
+    {
+        u32Batch = ((u32Count - i) < HSE_BATCH_MAX_REQUESTS) ? (u32Count - i) : HSE_BATCH_MAX_REQUESTS;
+        HSE_TEST_CHECK_RSP(HSE_SendBatch(descs, u32Batch, responses, NULL), HSE_SRV_RSP_OK);
+        HSE_TEST_CHECK_RSP(HSE_BatchWait(HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    }
+    return RequestsPerSecond(u32Count, HSE_TestNowUs() - u64Start);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Count = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 4096UL;
+    uint32_t u32LatencyUs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 20UL;
+    uint32_t i;
+
+    if((0UL == u32Count) || (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, u32LatencyUs, 0UL), HSE_SRV_RSP_OK);
+
+    printf("SHA2_256 one pass, %lu requests per run, hash latency %lu us\n", (unsigned long)u32Count,
+           (unsigned long)u32LatencyUs);
+    printf("%10s %16s %16s %8s\n", "length [B]", "sequential [/s]", "batch [/s]", "speedup");
+    for(i = 0UL; i < (sizeof(inputLengths) / sizeof(inputLengths[0])); i++)
+    {
+        double sequential;
+        double batch;
+
+        BuildRequests(inputLengths[i]);
+        memset(digest, 0, sizeof(digest));
+        sequential = RunSequential(u32Count);
+        HSE_TEST_CHECK(DigestsOk(inputLengths[i]));
+
+        memset(digest, 0, sizeof(digest));
+        batch = RunBatch(u32Count);
+        HSE_TEST_CHECK(DigestsOk(inputLengths[i]));
+
+        printf("%10lu %16.0f %16.0f %7.2fx\n", (unsigned long)inputLengths[i], sequential, batch,
+               (sequential > 0.0) ? (batch / sequential) : 0.0);
+    }
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
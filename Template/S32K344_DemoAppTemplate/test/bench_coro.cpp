@@ -0,0 +1,175 @@
+/**
+*   @file    bench_coro.cpp
+*
+*   @brief   Coroutine front-end vs blocking call chain (virtual HSE).
+*   @details Authenticates a set of messages with the same straight-line chain (CMAC generate, then
+*            CMAC verify of the tag), once with the blocking helpers and once with worker coroutines
+*            of hse_host_coro.hpp on the executor, for 1 to HSE_CORO_FRAME_COUNT workers, and prints
+*            the messages per second of both and the frames left in the pool. The virtual HSE runs
+*            one request at a time, like the firmware: the coroutines gain the host turnaround
+*            between two requests, not the service latency. Usage: bench_coro [messages]
+*            [CMAC latency in us].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+/* A worker frame (two awaiters, 64-bit pointers on the host) is larger than the default frame size */
+#define HSE_CORO_FRAME_SIZE         (512UL)
+
+#include <cstring>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host_coro.hpp"
+#include "hse_host_import_key.h"
+#include "hse_mu.h"
+
+#define HSE_BENCH_KEY               GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+#define HSE_BENCH_MAX_MESSAGES      (4096UL)
+#define HSE_BENCH_MSG_LENGTH        (64UL)
+#define HSE_BENCH_TAG_LENGTH        (16UL)
+/* The asynchronous requests use the channels of MU0 except channel 0 */
+#define HSE_BENCH_CHANNEL_MASK      ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+static uint8_t messages[HSE_BENCH_MAX_MESSAGES][HSE_BENCH_MSG_LENGTH];
+static uint8_t tags[HSE_BENCH_MAX_MESSAGES][HSE_BENCH_TAG_LENGTH];
+static hseSrvResponse_t results[HSE_BENCH_MAX_MESSAGES];
+
+static double MessagesPerSecond(uint32_t u32Messages, uint64_t u64ElapsedUs)
+{
+    return (0ULL == u64ElapsedUs) ? 0.0 : ((double)u32Messages * 1000000.0) / (double)u64ElapsedUs;
+}
+
+static bool_t ResultsOk(uint32_t u32Messages)
+{
+    for(uint32_t i = 0UL; i < u32Messages; i++)
+    {
+        if(HSE_SRV_RSP_OK != results[i])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* The chain with the blocking helpers: one request in flight */
+static double RunBlocking(uint32_t u32Messages)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+
+    for(uint32_t i = 0UL; i < u32Messages; i++)
+    {
+        uint32_t u32TagLength = HSE_BENCH_TAG_LENGTH;
+
+        results[i] = AesCmacGenerate(HSE_BENCH_KEY, HSE_BENCH_MSG_LENGTH, messages[i], &u32TagLength, tags[i],
+                                     HSE_SGT_OPTION_NONE);
+        if(HSE_SRV_RSP_OK == results[i])
+        {
+            results[i] = AesCmacVerify(HSE_BENCH_KEY, HSE_BENCH_MSG_LENGTH, messages[i], &u32TagLength, tags[i],
+                                       HSE_SGT_OPTION_NONE);
+        }
+    }
+    return MessagesPerSecond(u32Messages, HSE_TestNowUs() - u64Start);
+}
+
+/* The same chain in a coroutine: worker n takes the messages n, n + workers, ... */
+static hse::task<> Worker(uint32_t u32First, uint32_t u32Stride, uint32_t u32Messages)
+{
+    for(uint32_t i = u32First; i < u32Messages; i += u32Stride)
+    {
+        uint32_t u32TagLength = HSE_BENCH_TAG_LENGTH;
+        hseSrvResponse_t status;
+
+        status = co_await hse::cmac_generate(HSE_BENCH_KEY, messages[i], u32TagLength, tags[i]);
+        if(HSE_SRV_RSP_OK == status)
+        {
+            status = co_await hse::cmac_verify(HSE_BENCH_KEY, messages[i],
+                                               std::span<const uint8_t>(tags[i], u32TagLength));
+        }
+        results[i] = status;
+    }
+}
+
+static double RunCoro(uint32_t u32Messages, uint32_t u32Workers)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+
+    for(uint32_t u32Worker = 0UL; u32Worker < u32Workers; u32Worker++)
+    {
+        HSE_TEST_CHECK(hse::spawn(Worker(u32Worker, u32Workers, u32Messages)));
+    }
+    hse::run();
+    return MessagesPerSecond(u32Messages, HSE_TestNowUs() - u64Start);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Messages = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1024UL;
+    uint32_t u32LatencyUs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 50UL;
+
+    if(u32Messages > HSE_BENCH_MAX_MESSAGES)
+    {
+        u32Messages = HSE_BENCH_MAX_MESSAGES;
+    }
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(uint32_t i = 0UL; i < u32Messages; i++)
+    {
+        std::memset(messages[i], (int)i, HSE_BENCH_MSG_LENGTH);
+    }
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_BENCH_KEY, HSE_KEY_TYPE_AES, HSE_KF_USAGE_SIGN | HSE_KF_USAGE_VERIFY,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_MAC, u32LatencyUs, 0UL), HSE_SRV_RSP_OK);
+    /* The responses of the coroutines are received in the MU RX interrupt */
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, HSE_BENCH_CHANNEL_MASK);
+
+    printf("CMAC generate + verify of %lu messages of %lu bytes, CMAC latency %lu us\n",
+           (unsigned long)u32Messages, (unsigned long)HSE_BENCH_MSG_LENGTH, (unsigned long)u32LatencyUs);
+    printf("%8s %18s %18s %8s %8s\n", "workers", "blocking [msg/s]", "coroutine [msg/s]", "speedup", "frames");
+    for(uint32_t u32Workers = 1UL; u32Workers <= HSE_CORO_FRAME_COUNT; u32Workers *= 2UL)
+    {
+        double blocking;
+        double coro;
+
+        std::memset(results, 0xFF, sizeof(results));
+        blocking = RunBlocking(u32Messages);
+        HSE_TEST_CHECK(ResultsOk(u32Messages));
+
+        std::memset(results, 0xFF, sizeof(results));
+        std::memset(tags, 0, sizeof(tags));
+        coro = RunCoro(u32Messages, u32Workers);
+        HSE_TEST_CHECK(ResultsOk(u32Messages));
+        /* All the frames are back in the pool */
+        HSE_TEST_CHECK(HSE_CORO_FRAME_COUNT == hse::detail::frame_pool::available());
+
+        printf("%8lu %18.0f %18.0f %7.2fx %8lu\n", (unsigned long)u32Workers, blocking, coro,
+               (blocking > 0.0) ? (coro / blocking) : 0.0,
+               (unsigned long)hse::detail::frame_pool::available());
+    }
+
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, HSE_BENCH_CHANNEL_MASK);
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
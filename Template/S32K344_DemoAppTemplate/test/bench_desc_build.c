@@ -0,0 +1,175 @@
+/**
+*   @file    bench_desc_build.c
+*
+*   @brief   Host cost of preparing a service descriptor: full memset + field stores against the
+*            typed builders of hse_srv_builders.h.
+*   @details Host counterpart of HSE_DescBuild_Example() (hse_crypto.c). Prepares the same CMAC,
+*            HASH and AES-CBC descriptors both ways (nothing is sent), checks that both give the
+*            same header and request, and prints the ns per descriptor of both.
+*            Usage: bench_desc_build [descriptors per service].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_host.h"
+#include "hse_srv_builders.h"
+#include "host_compiler_api.h"
+
+#define HSE_BENCH_KEY_HANDLE    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 1U, 0U)
+
+typedef enum
+{
+    HSE_BENCH_CMAC = 0,
+    HSE_BENCH_HASH,
+    HSE_BENCH_AES_CBC,
+    HSE_BENCH_SERVICES
+} hseBenchService_t;
+
+static const char* const serviceNames[HSE_BENCH_SERVICES] = { "CMAC", "HASH", "AES-CBC" };
+static const hseMacScheme_t macScheme = { .macAlgo = HSE_MAC_ALGO_CMAC, .sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES };
+
+/* Referenced by the descriptors */
+static uint8_t input[64];
+static uint8_t output[64];
+static uint8_t iv[16];
+static uint32_t outputLength = sizeof(output);
+
+static hseSrvDescriptor_t memsetDesc;
+static hseSrvDescriptor_t typedDesc;
+
+static void BuildMemset(hseSrvDescriptor_t* pHseSrvDesc, hseBenchService_t service)
+{
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    switch(service)
+    {
+        case HSE_BENCH_CMAC:
+            pHseSrvDesc->srvId                               = HSE_SRV_ID_MAC;
+            pHseSrvDesc->hseSrv.macReq.accessMode            = HSE_ACCESS_MODE_ONE_PASS;
+            pHseSrvDesc->hseSrv.macReq.macScheme             = macScheme;
+            pHseSrvDesc->hseSrv.macReq.authDir               = HSE_AUTH_DIR_GENERATE;
+            pHseSrvDesc->hseSrv.macReq.keyHandle             = HSE_BENCH_KEY_HANDLE;
+            pHseSrvDesc->hseSrv.macReq.inputLength           = sizeof(input);
+            pHseSrvDesc->hseSrv.macReq.pInput                = HSE_PTR_TO_HOST_ADDR(input);
+            pHseSrvDesc->hseSrv.macReq.pTagLength            = HSE_PTR_TO_HOST_ADDR(&outputLength);
+            pHseSrvDesc->hseSrv.macReq.pTag                  = HSE_PTR_TO_HOST_ADDR(output);
+            break;
+        case HSE_BENCH_HASH:
+            pHseSrvDesc->srvId                               = HSE_SRV_ID_HASH;
+            pHseSrvDesc->hseSrv.hashReq.accessMode           = HSE_ACCESS_MODE_ONE_PASS;
+            pHseSrvDesc->hseSrv.hashReq.hashAlgo             = HSE_HASH_ALGO_SHA2_256;
+            pHseSrvDesc->hseSrv.hashReq.inputLength          = sizeof(input);
+            pHseSrvDesc->hseSrv.hashReq.pInput               = HSE_PTR_TO_HOST_ADDR(input);
+            pHseSrvDesc->hseSrv.hashReq.pHashLength          = HSE_PTR_TO_HOST_ADDR(&outputLength);
+            pHseSrvDesc->hseSrv.hashReq.pHash                = HSE_PTR_TO_HOST_ADDR(output);
+            break;
+        default:
+            pHseSrvDesc->srvId                               = HSE_SRV_ID_SYM_CIPHER;
+            pHseSrvDesc->hseSrv.symCipherReq.accessMode      = HSE_ACCESS_MODE_ONE_PASS;
+            pHseSrvDesc->hseSrv.symCipherReq.cipherAlgo      = HSE_CIPHER_ALGO_AES;
+            pHseSrvDesc->hseSrv.symCipherReq.cipherBlockMode = HSE_CIPHER_BLOCK_MODE_CBC;
+            pHseSrvDesc->hseSrv.symCipherReq.cipherDir       = HSE_CIPHER_DIR_ENCRYPT;
+            pHseSrvDesc->hseSrv.symCipherReq.keyHandle       = HSE_BENCH_KEY_HANDLE;
+            pHseSrvDesc->hseSrv.symCipherReq.pIV             = HSE_PTR_TO_HOST_ADDR(iv);
+            pHseSrvDesc->hseSrv.symCipherReq.inputLength     = sizeof(input);
+            pHseSrvDesc->hseSrv.symCipherReq.pInput          = HSE_PTR_TO_HOST_ADDR(input);
+            pHseSrvDesc->hseSrv.symCipherReq.pOutput         = HSE_PTR_TO_HOST_ADDR(output);
+            break;
+    }
+}
+
+static void BuildTyped(hseSrvDescriptor_t* pHseSrvDesc, hseBenchService_t service)
+{
+    switch(service)
+    {
+        case HSE_BENCH_CMAC:
+            HSE_BuildMacReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_AUTH_DIR_GENERATE, HSE_SGT_OPTION_NONE,
+                            &macScheme, HSE_BENCH_KEY_HANDLE, sizeof(input), input, &outputLength, output);
+            break;
+        case HSE_BENCH_HASH:
+            HSE_BuildHashReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256, HSE_SGT_OPTION_NONE,
+                             sizeof(input), input, &outputLength, output);
+            break;
+        default:
+            HSE_BuildSymCipherReq(pHseSrvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_CIPHER_ALGO_AES,
+                                  HSE_CIPHER_BLOCK_MODE_CBC, HSE_CIPHER_DIR_ENCRYPT, HSE_SGT_OPTION_NONE,
+                                  HSE_BENCH_KEY_HANDLE, iv, sizeof(input), input, output);
+            break;
+    }
+}
+
+/* The builder writes the header and the request only: the rest of the descriptor keeps the fill */
+static void CheckSame(hseBenchService_t service)
+{
+    static const uint32_t requestSizes[HSE_BENCH_SERVICES] =
+        { sizeof(hseMacSrv_t), sizeof(hseHashSrv_t), sizeof(hseSymCipherSrv_t) };
+
+    BuildMemset(&memsetDesc, service);
+    memset(&typedDesc, 0xA5, sizeof(typedDesc));
+    BuildTyped(&typedDesc, service);
+    HSE_TEST_CHECK(memsetDesc.srvId == typedDesc.srvId);
+    HSE_TEST_CHECK(0 == memcmp(&memsetDesc.srvMetaData, &typedDesc.srvMetaData, sizeof(hseSrvMetaData_t)));
+    HSE_TEST_CHECK(0 == memcmp(&memsetDesc.hseSrv, &typedDesc.hseSrv, requestSizes[service]));
+}
+
+static double BuildNs(bool_t bTyped, hseBenchService_t service, uint32_t u32Runs)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t i;
+
+    for(i = 0UL; i < u32Runs; i++)
+    {
+        if(bTyped)
+        {
+            BuildTyped(&typedDesc, service);
+        }
+        else
+        {
+            BuildMemset(&memsetDesc, service);
+        }
+        HSE_COMPILER_BARRIER();
+    }
+    return ((double)(HSE_TestNowUs() - u64Start) * 1000.0) / (double)u32Runs;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Runs = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 10000000UL;
+    double memsetNs;
+    double typedNs;
+    uint32_t service;
+
+    if(0UL == u32Runs)
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("Descriptor preparation, sizeof(hseSrvDescriptor_t) = %lu bytes, %lu descriptors per service\n",
+           (unsigned long)sizeof(hseSrvDescriptor_t), (unsigned long)u32Runs);
+    printf("%10s %14s %14s %10s\n", "", "memset [ns]", "builder [ns]", "speedup");
+    for(service = 0UL; service < (uint32_t)HSE_BENCH_SERVICES; service++)
+    {
+        CheckSame((hseBenchService_t)service);
+        memsetNs = BuildNs(FALSE, (hseBenchService_t)service, u32Runs);
+        typedNs = BuildNs(TRUE, (hseBenchService_t)service, u32Runs);
+        printf("%10s %14.2f %14.2f %9.2fx\n", serviceNames[service], memsetNs, typedNs,
+               (typedNs > 0.0) ? (memsetNs / typedNs) : 0.0);
+    }
+
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
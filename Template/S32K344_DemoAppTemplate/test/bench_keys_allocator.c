@@ -0,0 +1,276 @@
+/**
+*   @file    bench_keys_allocator.c
+*
+*   @brief   Alloc/free cost and static RAM of the key slot allocator (virtual HSE).
+*   @details Fills every group of the RAM catalog and frees the slots again in random order, with
+*            HKF_AllocKeySlotAdvanced()/HKF_FreeKeySlot() and with the previous allocator (256 slot
+*            flags per group and linear scans, kept here as the reference), on the demo catalogs
+*            and on a catalog with bigger groups. Prints the ns per alloc and per free and the
+*            static RAM of both. Usage: bench_keys_allocator [rounds per catalog].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_keys_allocator.h"
+#include "hse_b_catalog_formatting.h"
+
+#define HSE_BENCH_MAX_SLOTS     (HSE_TOTAL_NUM_OF_KEY_GROUPS * 0x100UL)
+
+/* Previous allocator: one flag per possible slot of every group of 3 catalog contexts */
+typedef struct
+{
+    bool_t             keyEmpty;
+} refKeySlotContext_t;
+
+typedef struct
+{
+    hseMuMask_t        muMask;
+    hseKeyGroupOwner_t groupOwner;
+    hseKeyType_t       keyType;
+    uint8_t            numOfKeySlots;
+    uint16_t           maxKeyBitLen;
+    refKeySlotContext_t key[0x100];
+} refGroupContext_t;
+
+typedef struct
+{
+    uint8_t            noOfGroups;
+    refGroupContext_t  group[HSE_TOTAL_NUM_OF_KEY_GROUPS];
+} refCatalogContext_t;
+
+typedef struct
+{
+    refCatalogContext_t ctx[3];
+} refAllocatorContext_t;
+
+typedef struct
+{
+    const char*                     pName;
+    const hseKeyGroupCfgEntry_t*    pNvmCatalog;
+    const hseKeyGroupCfgEntry_t*    pRamCatalog;
+} hseBenchCatalogs_t;
+
+static const hseKeyGroupCfgEntry_t demoNvmCatalog[] = {HSE_DEMO_NVM_KEY_CATALOG_CFG};
+static const hseKeyGroupCfgEntry_t demoRamCatalog[] = {HSE_DEMO_RAM_KEY_CATALOG_CFG};
+static const hseKeyGroupCfgEntry_t bigRamCatalog[] =
+{
+    {HSE_ALL_MU_MASK, HSE_KEY_OWNER_ANY, HSE_KEY_TYPE_SHE, 1U, HSE_KEY128_BITS},
+    {HSE_ALL_MU_MASK, HSE_KEY_OWNER_ANY, HSE_KEY_TYPE_AES, 200U, HSE_KEY128_BITS},
+    {HSE_ALL_MU_MASK, HSE_KEY_OWNER_ANY, HSE_KEY_TYPE_AES, 40U, HSE_KEY256_BITS},
+    {HSE_ALL_MU_MASK, HSE_KEY_OWNER_ANY, HSE_KEY_TYPE_HMAC, 33U, HSE_KEY1024_BITS},
+    {HSE_ALL_MU_MASK, HSE_KEY_OWNER_ANY, HSE_KEY_TYPE_SHARED_SECRET, 64U, HSE_KEY638_BITS},
+    {0U, 0U, 0U, 0U, 0U}
+};
+
+static const hseBenchCatalogs_t benchCatalogs[] =
+{
+    { "demo", demoNvmCatalog, demoRamCatalog },
+    { "big groups", demoNvmCatalog, bigRamCatalog },
+};
+
+static refAllocatorContext_t refCtx;
+static hseKeyHandle_t handles[HSE_BENCH_MAX_SLOTS];
+static uint32_t u32Random = 1UL;
+
+static uint32_t NextRandom(void)
+{
+    u32Random = (u32Random * 1103515245UL) + 12345UL;
+    return u32Random >> 8U;
+}
+
+static void RefInit(const hseKeyGroupCfgEntry_t *pCatalog, refCatalogContext_t *pCatalogCtx)
+{
+    hseKeyGroupIdx_t i;
+    hseKeySlotIdx_t j;
+
+    for(i = 0U; (i < HSE_TOTAL_NUM_OF_KEY_GROUPS) && (0U != pCatalog[i].numOfKeySlots); ++i)
+    {
+        pCatalogCtx->group[i].muMask        = pCatalog[i].muMask;
+        pCatalogCtx->group[i].groupOwner    = pCatalog[i].groupOwner;
+        pCatalogCtx->group[i].keyType       = pCatalog[i].keyType;
+        pCatalogCtx->group[i].numOfKeySlots = pCatalog[i].numOfKeySlots;
+        pCatalogCtx->group[i].maxKeyBitLen  = pCatalog[i].maxKeyBitLen;
+        for(j = 0U; j < pCatalog[i].numOfKeySlots; ++j)
+        {
+            pCatalogCtx->group[i].key[j].keyEmpty = TRUE;
+        }
+    }
+    pCatalogCtx->noOfGroups = i;
+}
+
+/* Perfect match first, then any group with bigger keys, in catalog order */
+static hseSrvResponse_t RefAlloc(hseKeyGroupOwner_t groupOwner, hseKeyType_t keyType, uint16_t maxKeyBitLength,
+                                 hseKeyHandle_t *pKeyHandle)
+{
+    refCatalogContext_t *catalogCtx = &refCtx.ctx[HSE_KEY_CATALOG_ID_RAM];
+    uint32_t pass;
+    hseKeyGroupIdx_t i;
+    hseKeySlotIdx_t j;
+
+    for(pass = 0UL; pass < 2UL; pass++)
+    {
+        for(i = 0U; i < catalogCtx->noOfGroups; ++i)
+        {
+            refGroupContext_t *pGroupCtx = &catalogCtx->group[i];
+
+            if((groupOwner == pGroupCtx->groupOwner) && (keyType == pGroupCtx->keyType) &&
+               ((0UL == pass) ? (maxKeyBitLength == pGroupCtx->maxKeyBitLen)
+                              : (maxKeyBitLength <= pGroupCtx->maxKeyBitLen)))
+            {
+                for(j = 0U; j < pGroupCtx->numOfKeySlots; ++j)
+                {
+                    if(pGroupCtx->key[j].keyEmpty)
+                    {
+                        pGroupCtx->key[j].keyEmpty = FALSE;
+                        *pKeyHandle = GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, i, j);
+                        return HSE_SRV_RSP_OK;
+                    }
+                }
+            }
+        }
+    }
+    return HSE_SRV_RSP_GENERAL_ERROR;
+}
+
+static hseSrvResponse_t RefFree(hseKeyHandle_t *pKeyHandle)
+{
+    refKeySlotContext_t *pKeySlot =
+        &refCtx.ctx[GET_CATALOG_ID(*pKeyHandle)].group[GET_GROUP_IDX(*pKeyHandle)].key[GET_SLOT_IDX(*pKeyHandle)];
+
+    if(pKeySlot->keyEmpty)
+    {
+        return HSE_SRV_RSP_GENERAL_ERROR;
+    }
+    pKeySlot->keyEmpty = TRUE;
+    *pKeyHandle = HSE_INVALID_KEY_HANDLE;
+    return HSE_SRV_RSP_OK;
+}
+
+static hseSrvResponse_t NewAlloc(hseKeyGroupOwner_t groupOwner, hseKeyType_t keyType, uint16_t maxKeyBitLength,
+                                 hseKeyHandle_t *pKeyHandle)
+{
+    return HKF_AllocKeySlotAdvanced(RAM_KEY, HSE_MU0_MASK, FALSE, groupOwner, keyType, maxKeyBitLength, pKeyHandle);
+}
+
+/* Fill every group of the RAM catalog with slots of its own size, then free all in random order */
+static void RunRounds(const hseKeyGroupCfgEntry_t *pRamCatalog, uint32_t u32Rounds, bool_t bRef,
+                      double *pAllocNs, double *pFreeNs)
+{
+    uint64_t u64AllocUs = 0ULL;
+    uint64_t u64FreeUs = 0ULL;
+    uint64_t u64Start;
+    uint32_t u32Ops = 0UL;
+    uint32_t u32Count;
+    uint32_t u32Round;
+    uint32_t i;
+    uint32_t j;
+    hseKeyHandle_t tmp;
+
+    for(u32Round = 0UL; u32Round < u32Rounds; u32Round++)
+    {
+        u32Count = 0UL;
+        u64Start = HSE_TestNowUs();
+        for(i = 0UL; 0U != pRamCatalog[i].numOfKeySlots; i++)
+        {
+            for(j = 0UL; j < pRamCatalog[i].numOfKeySlots; j++)
+            {
+                HSE_TEST_CHECK_RSP(bRef ? RefAlloc(pRamCatalog[i].groupOwner, pRamCatalog[i].keyType,
+                                                   pRamCatalog[i].maxKeyBitLen, &handles[u32Count])
+                                        : NewAlloc(pRamCatalog[i].groupOwner, pRamCatalog[i].keyType,
+                                                   pRamCatalog[i].maxKeyBitLen, &handles[u32Count]),
+                                   HSE_SRV_RSP_OK);
+                u32Count++;
+            }
+        }
+        u64AllocUs += HSE_TestNowUs() - u64Start;
+
+        /* Random order, outside of the measure */
+        for(i = u32Count - 1UL; i > 0UL; i--)
+        {
+            j = NextRandom() % (i + 1UL);
+            tmp = handles[i];
+            handles[i] = handles[j];
+            handles[j] = tmp;
+        }
+
+        u64Start = HSE_TestNowUs();
+        for(i = 0UL; i < u32Count; i++)
+        {
+            HSE_TEST_CHECK_RSP(bRef ? RefFree(&handles[i]) : HKF_FreeKeySlot(&handles[i]), HSE_SRV_RSP_OK);
+        }
+        u64FreeUs += HSE_TestNowUs() - u64Start;
+        u32Ops += u32Count;
+    }
+
+    *pAllocNs = (0UL == u32Ops) ? 0.0 : ((double)u64AllocUs * 1000.0) / (double)u32Ops;
+    *pFreeNs = (0UL == u32Ops) ? 0.0 : ((double)u64FreeUs * 1000.0) / (double)u32Ops;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000UL;
+    uint32_t u32CacheBytes = 0UL;
+    uint32_t u32RamBytes;
+    uint32_t i;
+
+    if((0UL == u32Rounds) || (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("Key slot allocator, %lu rounds (fill the RAM catalog, free in random order)\n",
+           (unsigned long)u32Rounds);
+    printf("%-12s %6s %16s %16s %16s %16s\n", "catalog", "slots", "prev alloc [ns]", "prev free [ns]",
+           "alloc [ns]", "free [ns]");
+    for(i = 0UL; i < (sizeof(benchCatalogs) / sizeof(benchCatalogs[0])); i++)
+    {
+        double refAllocNs;
+        double refFreeNs;
+        double allocNs;
+        double freeNs;
+        uint32_t u32Slots = 0UL;
+        uint32_t j;
+
+        for(j = 0UL; 0U != benchCatalogs[i].pRamCatalog[j].numOfKeySlots; j++)
+        {
+            u32Slots += benchCatalogs[i].pRamCatalog[j].numOfKeySlots;
+        }
+        memset(&refCtx, 0, sizeof(refCtx));
+        RefInit(benchCatalogs[i].pNvmCatalog, &refCtx.ctx[HSE_KEY_CATALOG_ID_NVM]);
+        RefInit(benchCatalogs[i].pRamCatalog, &refCtx.ctx[HSE_KEY_CATALOG_ID_RAM]);
+        HSE_TEST_CHECK_RSP(HKF_Init(benchCatalogs[i].pNvmCatalog, benchCatalogs[i].pRamCatalog), HSE_SRV_RSP_OK);
+
+        RunRounds(benchCatalogs[i].pRamCatalog, u32Rounds, TRUE, &refAllocNs, &refFreeNs);
+        RunRounds(benchCatalogs[i].pRamCatalog, u32Rounds, FALSE, &allocNs, &freeNs);
+        printf("%-12s %6lu %16.1f %16.1f %16.1f %16.1f\n", benchCatalogs[i].pName, (unsigned long)u32Slots,
+               refAllocNs, refFreeNs, allocNs, freeNs);
+    }
+
+    u32RamBytes = HKF_GetRamUsage(&u32CacheBytes);
+    printf("Static RAM: previous allocator %lu bytes, bitmap allocator %lu bytes "
+           "(%lu without the key info cache of %u slots)\n",
+           (unsigned long)sizeof(refAllocatorContext_t), (unsigned long)u32RamBytes,
+           (unsigned long)(u32RamBytes - u32CacheBytes), (unsigned int)HKF_KEY_INFO_CACHE_SLOTS);
+    HSE_TEST_CHECK(u32RamBytes < sizeof(refAllocatorContext_t));
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
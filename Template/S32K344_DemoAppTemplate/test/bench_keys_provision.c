@@ -0,0 +1,145 @@
+/**
+*   @file    bench_keys_provision.c
+*
+*   @brief   Provisioning time of a key table: one ImportKey at a time against HKF_ProvisionKeys().
+*   @details Imports the same table of independent AES-128 RAM keys with one synchronous
+*            ImportKeyCtx() per key and with HKF_ProvisionKeys() (asynchronous, one request per
+*            free channel), and prints the total time of both and the per-key times reported by
+*            HKF_ProvisionKeys(). The virtual HSE runs one request at a time, like the firmware:
+*            the pipeline gains the host turnaround between two requests, not the service latency.
+*            Usage: bench_keys_provision [keys per table] [runs] [import latency in us].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_keys_provision.h"
+
+#define HSE_BENCH_RAM_KEY(u8Slot)   GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 1U, (u8Slot))
+
+/* Read by the HSE */
+static uint8_t keyValues[HKF_PROV_MAX_ENTRIES][16];
+static hseKeyInfo_t keyInfos[HKF_PROV_MAX_ENTRIES];
+static hseKey_t keys[HKF_PROV_MAX_ENTRIES];
+static hseKeyImportParams_t importParams[HKF_PROV_MAX_ENTRIES];
+static hkfProvEntry_t table[HKF_PROV_MAX_ENTRIES];
+
+static void BuildTable(uint16_t u16Keys)
+{
+    uint16_t e;
+
+    for(e = 0U; e < u16Keys; e++)
+    {
+        memset(keyValues[e], (int)e, sizeof(keyValues[e]));
+        memset(&keyInfos[e], 0, sizeof(hseKeyInfo_t));
+        keyInfos[e].keyFlags = HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT;
+        keyInfos[e].keyBitLen = 128U;
+        keyInfos[e].keyCounter = HSE_RAM_KEY_COUNTER_VALUE;
+        keyInfos[e].keyType = HSE_KEY_TYPE_AES;
+
+        memset(&keys[e], 0, sizeof(hseKey_t));
+        keys[e].keyHandle = HSE_BENCH_RAM_KEY(e);
+        keys[e].pKeyInfo = &keyInfos[e];
+        keys[e].keyValue.pKey2 = keyValues[e];
+        keys[e].keyValue.keyLen2 = sizeof(keyValues[e]);
+
+        memset(&importParams[e], 0, sizeof(hseKeyImportParams_t));
+        importParams[e].pKey = &keys[e];
+
+        memset(&table[e], 0, sizeof(hkfProvEntry_t));
+        table[e].kind = HKF_PROV_IMPORT_KEY;
+        table[e].pImportParams = &importParams[e];
+        table[e].dependsOn = HKF_PROV_NO_DEP;
+    }
+}
+
+/* One synchronous ImportKey at a time */
+static uint64_t RunSequential(uint16_t u16Keys)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint16_t e;
+
+    for(e = 0U; e < u16Keys; e++)
+    {
+        HSE_TEST_CHECK_RSP(ImportKeyCtx(&gHseDefaultCtx, &importParams[e]), HSE_SRV_RSP_OK);
+    }
+    return HSE_TestNowUs() - u64Start;
+}
+
+/* The whole table with HKF_ProvisionKeys(); the per-key times are added to pu64KeyUs */
+static uint64_t RunPipelined(uint16_t u16Keys, uint64_t* pu64KeyUs, uint32_t* pu32MaxKeyUs)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint64_t u64Elapsed;
+    hkfProvReport_t report;
+    uint16_t e;
+
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, u16Keys, HKF_PROV_ALL_MU, HSE_WAIT_INFINITE, &report),
+                       HSE_SRV_RSP_OK);
+    u64Elapsed = HSE_TestNowUs() - u64Start;
+    HSE_TEST_CHECK(u16Keys == report.noOfProvisioned);
+    for(e = 0U; e < u16Keys; e++)
+    {
+        *pu64KeyUs += table[e].u32DurationUs;
+        *pu32MaxKeyUs = (table[e].u32DurationUs > *pu32MaxKeyUs) ? table[e].u32DurationUs : *pu32MaxKeyUs;
+    }
+    return u64Elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Keys = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : HKF_PROV_MAX_ENTRIES;
+    uint32_t u32Runs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 20UL;
+    uint32_t u32LatencyUs = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 20UL;
+    uint64_t u64SequentialUs = 0ULL;
+    uint64_t u64PipelinedUs = 0ULL;
+    uint64_t u64KeyUs = 0ULL;
+    uint32_t u32MaxKeyUs = 0UL;
+    uint32_t i;
+
+    if((0UL == u32Keys) || (u32Keys > HKF_PROV_MAX_ENTRIES) || (0UL == u32Runs) ||
+       (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_KEY, u32LatencyUs, 0UL), HSE_SRV_RSP_OK);
+    BuildTable((uint16_t)u32Keys);
+
+    for(i = 0UL; i < u32Runs; i++)
+    {
+        u64SequentialUs += RunSequential((uint16_t)u32Keys);
+        u64PipelinedUs += RunPipelined((uint16_t)u32Keys, &u64KeyUs, &u32MaxKeyUs);
+    }
+
+    printf("AES-128 RAM key import, %lu keys per table, %lu runs, import latency %lu us\n", (unsigned long)u32Keys,
+           (unsigned long)u32Runs, (unsigned long)u32LatencyUs);
+    printf("%22s %14s %14s\n", "", "table [us]", "per key [us]");
+    printf("%22s %14.1f %14.2f\n", "sequential ImportKey", (double)u64SequentialUs / (double)u32Runs,
+           (double)u64SequentialUs / (double)(u32Runs * u32Keys));
+    printf("%22s %14.1f %14.2f\n", "HKF_ProvisionKeys", (double)u64PipelinedUs / (double)u32Runs,
+           (double)u64PipelinedUs / (double)(u32Runs * u32Keys));
+    printf("Speedup %.2fx; per key request to response: avg %.1f us, max %lu us\n",
+           (u64PipelinedUs > 0ULL) ? ((double)u64SequentialUs / (double)u64PipelinedUs) : 0.0,
+           (double)u64KeyUs / (double)(u32Runs * u32Keys), (unsigned long)u32MaxKeyUs);
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
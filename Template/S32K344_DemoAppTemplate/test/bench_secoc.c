@@ -0,0 +1,144 @@
+/**
+*   @file    bench_secoc.c
+*
+*   @brief   PDU rate of the batched SecOC verification (virtual HSE).
+*   @details Verifies FAST CMAC PDUs of 8, 16 and 64 bytes one by one with AesFastCmacVerify()
+*            and as one batch with HSE_SecOcVerify(), and prints the PDUs per second of both.
+*            Usage: bench_secoc [PDUs per run] [FAST CMAC latency in us].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_mac.h"
+#include "hse_host_import_key.h"
+#include "hse_host_secoc.h"
+
+#define HSE_BENCH_KEY               GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+#define HSE_BENCH_MAX_PDU_LENGTH    (64UL)
+#define HSE_BENCH_TAG_LENGTH        (4UL)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+static const uint32_t pduLengths[] = { 8UL, 16UL, 64UL };
+
+static uint8_t (*pMsgs)[HSE_BENCH_MAX_PDU_LENGTH];
+static uint8_t (*pTags)[HSE_BENCH_TAG_LENGTH];
+static hseSecOcPdu_t* pPdus;
+static uint32_t* pPassMap;
+
+static void BuildPdus(uint32_t u32Count, uint32_t u32Length)
+{
+    uint8_t mac[16];
+    size_t macLength = 0U;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        memset(pMsgs[i], (int)i, u32Length);
+        (void)EVP_Q_mac(NULL, "CMAC", NULL, "AES-128-CBC", NULL, aes128Key, sizeof(aes128Key),
+                        pMsgs[i], u32Length, mac, sizeof(mac), &macLength);
+        memcpy(pTags[i], mac, HSE_BENCH_TAG_LENGTH);
+        pPdus[i].keyHandle       = HSE_BENCH_KEY;
+        pPdus[i].pMsg            = pMsgs[i];
+        pPdus[i].u32MsgBitLength = u32Length * 8UL;
+        pPdus[i].pTag            = pTags[i];
+        pPdus[i].u8TagBitLength  = (uint8_t)(HSE_BENCH_TAG_LENGTH * 8UL);
+        pPdus[i].u32CounterIdx   = HSE_SECOC_NO_COUNTER;
+    }
+}
+
+static double PdusPerSecond(uint32_t u32Count, uint64_t u64ElapsedUs)
+{
+    return (0ULL == u64ElapsedUs) ? 0.0 : ((double)u32Count * 1000000.0) / (double)u64ElapsedUs;
+}
+
+/* One blocking request per PDU */
+static double RunBlocking(uint32_t u32Count)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        HSE_TEST_CHECK_RSP(AesFastCmacVerify(pPdus[i].keyHandle, pPdus[i].u32MsgBitLength, pPdus[i].pMsg,
+                                             pPdus[i].u8TagBitLength, pPdus[i].pTag), HSE_SRV_RSP_OK);
+    }
+    return PdusPerSecond(u32Count, HSE_TestNowUs() - u64Start);
+}
+
+/* All PDUs in one batch on every free channel */
+static double RunBatched(uint32_t u32Count)
+{
+    uint32_t u32Failed = 0UL;
+    uint64_t u64Start = HSE_TestNowUs();
+
+    HSE_TEST_CHECK_RSP(HSE_SecOcVerify(pPdus, u32Count, pPassMap, HSE_WAIT_INFINITE, &u32Failed), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0UL == u32Failed);
+    return PdusPerSecond(u32Count, HSE_TestNowUs() - u64Start);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Count = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 4096UL;
+    uint32_t u32LatencyUs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 20UL;
+    uint32_t i;
+
+    pMsgs = calloc(u32Count, sizeof(*pMsgs));
+    pTags = calloc(u32Count, sizeof(*pTags));
+    pPdus = calloc(u32Count, sizeof(*pPdus));
+    pPassMap = calloc(HSE_SECOC_PASS_MAP_WORDS(u32Count), sizeof(*pPassMap));
+    if((0UL == u32Count) || (NULL == pMsgs) || (NULL == pTags) || (NULL == pPdus) || (NULL == pPassMap) ||
+       (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_BENCH_KEY, HSE_KEY_TYPE_AES, HSE_KF_USAGE_SIGN | HSE_KF_USAGE_VERIFY,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_FAST_CMAC, u32LatencyUs, 0UL), HSE_SRV_RSP_OK);
+
+    printf("SecOC verification, %lu PDUs, FAST CMAC latency %lu us\n",
+           (unsigned long)u32Count, (unsigned long)u32LatencyUs);
+    printf("%8s %14s %14s %8s\n", "PDU [B]", "blocking [/s]", "batched [/s]", "speedup");
+    for(i = 0UL; i < (sizeof(pduLengths) / sizeof(pduLengths[0])); i++)
+    {
+        double blocking;
+        double batched;
+
+        BuildPdus(u32Count, pduLengths[i]);
+        blocking = RunBlocking(u32Count);
+        batched = RunBatched(u32Count);
+        printf("%8lu %14.0f %14.0f %7.2fx\n", (unsigned long)pduLengths[i], blocking, batched,
+               (blocking > 0.0) ? (batched / blocking) : 0.0);
+    }
+
+    HSE_VirtualDeinit();
+    free(pPassMap);
+    free(pPdus);
+    free(pTags);
+    free(pMsgs);
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
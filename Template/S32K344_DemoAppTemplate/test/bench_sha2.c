@@ -0,0 +1,142 @@
+/**
+*   @file    bench_sha2.c
+*
+*   @brief   Crossover of the host and HSE hash paths of HashPublicData() (virtual HSE).
+*   @details Times one pass SHA-256 and SHA-512 digests of 16 bytes to HASH_HOST_CALIBRATION_MAX
+*            bytes on the host CPU (HostSha256/HostSha512) and on the HSE (HashDataCtx), prints the
+*            us per digest of both and the first length the host is slower, then the thresholds
+*            set by HashHostCalibrate() under the same latency. Usage: bench_sha2 [digests per
+*            length] [hash latency in us] [hash latency in ns per byte].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_hash.h"
+#include "hse_host_sha2.h"
+
+static const uint32_t lengths[] = { 16UL, 32UL, 64UL, 128UL, 256UL, 384UL, 512UL, 768UL, 1024UL, 1536UL, 2048UL };
+
+/* Read by the HSE */
+static uint8_t input[HASH_HOST_CALIBRATION_MAX];
+static uint8_t hostDigest[HOST_SHA512_DIGEST_LENGTH];
+static uint8_t hseDigest[HOST_SHA512_DIGEST_LENGTH];
+
+static double HostUs(bool_t bSha512, uint32_t u32Length, uint32_t u32Runs)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t i;
+
+    for(i = 0UL; i < u32Runs; i++)
+    {
+        if(bSha512)
+        {
+            HostSha512(input, u32Length, hostDigest);
+        }
+        else
+        {
+            HostSha256(input, u32Length, hostDigest);
+        }
+    }
+    return (double)(HSE_TestNowUs() - u64Start) / (double)u32Runs;
+}
+
+static double HseUs(bool_t bSha512, uint32_t u32Length, uint32_t u32Runs)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+    uint32_t u32HashLength;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Runs; i++)
+    {
+        u32HashLength = sizeof(hseDigest);
+        HSE_TEST_CHECK_RSP(HashDataCtx(&gHseDefaultCtx, bSha512 ? HSE_HASH_ALGO_SHA2_512 : HSE_HASH_ALGO_SHA2_256,
+                                       u32Length, input, &u32HashLength, hseDigest, HSE_SGT_OPTION_NONE),
+                           HSE_SRV_RSP_OK);
+    }
+    return (double)(HSE_TestNowUs() - u64Start) / (double)u32Runs;
+}
+
+static void RunAlgo(bool_t bSha512, uint32_t u32Runs)
+{
+    uint32_t u32DigestLength = bSha512 ? HOST_SHA512_DIGEST_LENGTH : HOST_SHA256_DIGEST_LENGTH;
+    uint32_t u32Crossover = 0UL;
+    uint32_t i;
+
+    printf("%s\n%10s %12s %12s %8s\n", bSha512 ? "SHA2_512" : "SHA2_256", "length [B]", "host [us]", "HSE [us]",
+           "speedup");
+    for(i = 0UL; i < (sizeof(lengths) / sizeof(lengths[0])); i++)
+    {
+        double host;
+        double hse;
+
+        if(lengths[i] > HASH_HOST_CALIBRATION_MAX)
+        {
+            break;
+        }
+        host = HostUs(bSha512, lengths[i], u32Runs);
+        hse = HseUs(bSha512, lengths[i], u32Runs);
+        HSE_TEST_CHECK(0 == memcmp(hostDigest, hseDigest, u32DigestLength));
+        if((0UL == u32Crossover) && (host > hse))
+        {
+            u32Crossover = lengths[i];
+        }
+        printf("%10lu %12.2f %12.2f %7.1fx\n", (unsigned long)lengths[i], host, hse, (host > 0.0) ? (hse / host) : 0.0);
+    }
+    if(0UL == u32Crossover)
+    {
+        printf("Host faster up to %lu bytes\n", (unsigned long)HASH_HOST_CALIBRATION_MAX);
+    }
+    else
+    {
+        printf("Host slower from %lu bytes\n", (unsigned long)u32Crossover);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Runs = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 200UL;
+    uint32_t u32LatencyUs = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 10UL;
+    uint32_t u32LatencyNsPerByte = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 4UL;
+    uint32_t i;
+
+    if((0UL == u32Runs) || (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+    for(i = 0UL; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)((i * 31UL) + 7UL);
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, u32LatencyUs, u32LatencyNsPerByte), HSE_SRV_RSP_OK);
+
+    printf("One pass digests, %lu per length, hash latency %lu us + %lu ns/byte\n", (unsigned long)u32Runs,
+           (unsigned long)u32LatencyUs, (unsigned long)u32LatencyNsPerByte);
+    RunAlgo(FALSE, u32Runs);
+    RunAlgo(TRUE, u32Runs);
+
+    HSE_TEST_CHECK_RSP(HashHostCalibrate(), HSE_SRV_RSP_OK);
+    printf("HashHostCalibrate() thresholds: SHA2_256 %lu bytes, SHA2_512 %lu bytes\n",
+           (unsigned long)HashHostGetThreshold(HSE_HASH_ALGO_SHA2_256),
+           (unsigned long)HashHostGetThreshold(HSE_HASH_ALGO_SHA2_512));
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
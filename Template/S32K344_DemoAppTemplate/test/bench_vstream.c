@@ -0,0 +1,266 @@
+/**
+*   @file    bench_vstream.c
+*
+*   @brief   Cost of the virtual streams: context swap vs stream restart (virtual HSE).
+*   @details Hashes one message per logical stream (SHA-256), one chunk per step, the logical
+*            streams taking turns on the HSE_STREAM_COUNT HSE streams. A stream that lost its HSE
+*            stream is either swapped back in by hse_host_vstream.c (export/import of the context)
+*            or restarted: START and the data hashed so far sent again. Prints the us per step of
+*            both, the swap rate and the cost of one context transfer, for 2 to 32 logical streams.
+*            Usage: bench_vstream [steps per stream] [chunk bytes] [hash latency in us]
+*            [hash latency in ns per byte] [context transfer latency in us].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_host_hash.h"
+#include "hse_host_vstream.h"
+
+#define HSE_BENCH_CHANNEL           (1U)
+#define HSE_BENCH_BLOCK_LENGTH      (64UL)
+#define HSE_BENCH_DIGEST_LENGTH     (32UL)
+
+static const uint32_t streamCounts[] = { 2UL, 4UL, 8UL, 16UL, HSE_VSTREAM_MAX_STREAMS };
+
+static uint8_t* pMessages[HSE_VSTREAM_MAX_STREAMS];
+static uint8_t digests[HSE_VSTREAM_MAX_STREAMS][HSE_BENCH_DIGEST_LENGTH];
+
+static bool_t DigestsOk(uint32_t u32Streams, uint32_t u32Length)
+{
+    uint8_t expected[HSE_BENCH_DIGEST_LENGTH];
+    uint32_t i;
+
+    for(i = 0UL; i < u32Streams; i++)
+    {
+        (void)EVP_Digest(pMessages[i], u32Length, expected, NULL, EVP_sha256(), NULL);
+        if(0 != memcmp(digests[i], expected, sizeof(expected)))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Without context transfers: the least recently used stream is dropped and restarted on its next step */
+static double RunRestart(uint32_t u32Streams, uint32_t u32Steps, uint32_t u32ChunkSize)
+{
+    const hseCtx_t ctx = HSE_CtxOnChannel(0U, HSE_BENCH_CHANNEL, gSyncTxOption);
+    uint32_t owner[HSE_STREAM_COUNT];
+    uint32_t lastUse[HSE_STREAM_COUNT];
+    uint32_t u32Clock = 0UL;
+    uint32_t u32DigestLength;
+    uint32_t u32Step;
+    uint32_t u32Offset;
+    uint32_t s;
+    uint32_t i;
+    hseStreamId_t streamId;
+    uint64_t u64Start;
+
+    for(i = 0UL; i < HSE_STREAM_COUNT; i++)
+    {
+        owner[i] = HSE_VSTREAM_MAX_STREAMS;
+        lastUse[i] = 0UL;
+    }
+
+    u64Start = HSE_TestNowUs();
+    for(u32Step = 0UL; u32Step < u32Steps; u32Step++)
+    {
+        u32Offset = u32Step * u32ChunkSize;
+        for(s = 0UL; s < u32Streams; s++)
+        {
+            streamId = 0U;
+            for(i = 0UL; i < HSE_STREAM_COUNT; i++)
+            {
+                if(owner[i] == s)
+                {
+                    streamId = (hseStreamId_t)i;
+                    break;
+                }
+                if(lastUse[i] < lastUse[streamId])
+                {
+                    streamId = (hseStreamId_t)i;
+                }
+            }
+            if(owner[streamId] != s)
+            {
+                owner[streamId] = s;
+                HSE_TEST_CHECK_RSP(HashDataStartStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId), HSE_SRV_RSP_OK);
+                if(0UL != u32Offset)
+                {
+                    HSE_TEST_CHECK_RSP(HashDataUpdateStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId,
+                                                               u32Offset, pMessages[s]), HSE_SRV_RSP_OK);
+                }
+            }
+            lastUse[streamId] = ++u32Clock;
+
+            if((u32Step + 1UL) < u32Steps)
+            {
+                HSE_TEST_CHECK_RSP(HashDataUpdateStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId, u32ChunkSize,
+                                                           &pMessages[s][u32Offset]), HSE_SRV_RSP_OK);
+            }
+            else
+            {
+                u32DigestLength = HSE_BENCH_DIGEST_LENGTH;
+                HSE_TEST_CHECK_RSP(HashDataFinishStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId, u32ChunkSize,
+                                                           &pMessages[s][u32Offset], &u32DigestLength,
+                                                           digests[s]), HSE_SRV_RSP_OK);
+                owner[streamId] = HSE_VSTREAM_MAX_STREAMS;
+                lastUse[streamId] = 0UL;
+            }
+        }
+    }
+    return (double)(HSE_TestNowUs() - u64Start) / (double)(u32Streams * u32Steps);
+}
+
+/* Virtual streams: the least recently used context is exported to the pool and imported back */
+static double RunVStream(uint32_t u32Streams, uint32_t u32Steps, uint32_t u32ChunkSize)
+{
+    hseVStreamHandle_t handles[HSE_VSTREAM_MAX_STREAMS];
+    hseCtx_t ctx;
+    hseStreamId_t streamId;
+    hseSrvResponse_t status;
+    uint32_t u32DigestLength;
+    uint32_t u32Step;
+    uint32_t u32Offset;
+    uint32_t s;
+    uint64_t u64Start;
+    uint64_t u64ElapsedUs;
+
+    HSE_TEST_CHECK_RSP(HSE_VStreamInit(0U, HSE_BENCH_CHANNEL), HSE_SRV_RSP_OK);
+    for(s = 0UL; s < u32Streams; s++)
+    {
+        HSE_TEST_CHECK_RSP(HSE_VStreamOpen(&handles[s]), HSE_SRV_RSP_OK);
+    }
+
+    u64Start = HSE_TestNowUs();
+    for(u32Step = 0UL; u32Step < u32Steps; u32Step++)
+    {
+        u32Offset = u32Step * u32ChunkSize;
+        for(s = 0UL; s < u32Streams; s++)
+        {
+            status = HSE_VStreamAcquire(handles[s], &ctx, &streamId);
+            HSE_TEST_CHECK_RSP(status, HSE_SRV_RSP_OK);
+            if(HSE_SRV_RSP_OK != status)
+            {
+                continue;
+            }
+            if(0UL == u32Step)
+            {
+                HSE_TEST_CHECK_RSP(HashDataStartStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId), HSE_SRV_RSP_OK);
+            }
+            if((u32Step + 1UL) < u32Steps)
+            {
+                HSE_TEST_CHECK_RSP(HashDataUpdateStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId, u32ChunkSize,
+                                                           &pMessages[s][u32Offset]), HSE_SRV_RSP_OK);
+                HSE_VStreamRelease(handles[s], FALSE);
+            }
+            else
+            {
+                u32DigestLength = HSE_BENCH_DIGEST_LENGTH;
+                HSE_TEST_CHECK_RSP(HashDataFinishStreamCtx(&ctx, HSE_HASH_ALGO_SHA2_256, streamId, u32ChunkSize,
+                                                           &pMessages[s][u32Offset], &u32DigestLength,
+                                                           digests[s]), HSE_SRV_RSP_OK);
+                HSE_VStreamRelease(handles[s], TRUE);
+            }
+        }
+    }
+    u64ElapsedUs = HSE_TestNowUs() - u64Start;
+
+    for(s = 0UL; s < u32Streams; s++)
+    {
+        HSE_TEST_CHECK_RSP(HSE_VStreamClose(handles[s]), HSE_SRV_RSP_OK);
+    }
+    return (double)u64ElapsedUs / (double)(u32Streams * u32Steps);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t u32Steps = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 16UL;
+    uint32_t u32ChunkSize = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 256UL;
+    uint32_t u32HashUs = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 5UL;
+    uint32_t u32HashNsPerByte = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : 10UL;
+    uint32_t u32TransferUs = (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 0) : 10UL;
+    hseVStreamStats_t stats;
+    uint32_t u32Length;
+    uint32_t i;
+    uint32_t j;
+
+    /* The UPDATE steps take whole blocks */
+    u32ChunkSize -= u32ChunkSize % HSE_BENCH_BLOCK_LENGTH;
+    u32Length = u32Steps * u32ChunkSize;
+    if((0UL == u32Length) || (HSE_SRV_RSP_OK != HSE_VirtualInit()))
+    {
+        return EXIT_FAILURE;
+    }
+    for(i = 0UL; i < HSE_VSTREAM_MAX_STREAMS; i++)
+    {
+        pMessages[i] = malloc(u32Length);
+        if(NULL == pMessages[i])
+        {
+            return EXIT_FAILURE;
+        }
+        for(j = 0UL; j < u32Length; j++)
+        {
+            pMessages[i][j] = (uint8_t)((j * 7UL) + i);
+        }
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, u32HashUs, u32HashNsPerByte), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_EXPORT_STREAM_CTX, u32TransferUs, 0UL),
+                       HSE_SRV_RSP_OK);
+
+    /* Warm-up run, not measured */
+    (void)RunRestart(streamCounts[0], u32Steps, u32ChunkSize);
+
+    printf("SHA-256, %lu steps of %lu bytes per stream, hash latency %lu us + %lu ns/byte, "
+           "context transfer latency %lu us\n", (unsigned long)u32Steps, (unsigned long)u32ChunkSize,
+           (unsigned long)u32HashUs, (unsigned long)u32HashNsPerByte, (unsigned long)u32TransferUs);
+    printf("%8s %14s %14s %10s %14s %8s\n", "streams", "restart [us]", "vstream [us]", "swap rate",
+           "transfer [us]", "speedup");
+    for(i = 0UL; i < (sizeof(streamCounts) / sizeof(streamCounts[0])); i++)
+    {
+        double restart;
+        double vstream;
+        uint32_t u32Transfers;
+
+        restart = RunRestart(streamCounts[i], u32Steps, u32ChunkSize);
+        HSE_TEST_CHECK(DigestsOk(streamCounts[i], u32Length));
+        memset(digests, 0, sizeof(digests));
+        vstream = RunVStream(streamCounts[i], u32Steps, u32ChunkSize);
+        HSE_TEST_CHECK(DigestsOk(streamCounts[i], u32Length));
+
+        HSE_VStreamGetStats(&stats);
+        HSE_TEST_CHECK(0UL == stats.u32SwapErrors);
+        u32Transfers = stats.u32SwapOuts + stats.u32SwapIns;
+        printf("%8lu %14.1f %14.1f %9.1f%% %14.1f %7.2fx\n", (unsigned long)streamCounts[i], restart, vstream,
+               (0UL == stats.u32Acquires) ? 0.0 : (100.0 * stats.u32SwapOuts) / (double)stats.u32Acquires,
+               (0UL == u32Transfers) ? 0.0 : (double)stats.u32SwapUs / (double)u32Transfers,
+               (vstream > 0.0) ? (restart / vstream) : 0.0);
+    }
+
+    HSE_VirtualDeinit();
+    for(i = 0UL; i < HSE_VSTREAM_MAX_STREAMS; i++)
+    {
+        free(pMessages[i]);
+    }
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,69 @@
+/**
+*   @file    hse_test.h
+*
+*   @brief   Checks of the host tests and benchmarks (virtual HSE).
+*   @details A failed check is reported with its location and counted; the test returns the
+*            number of failed checks from main() through HSE_TEST_RESULT().
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef HSE_TEST_H
+#define HSE_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hse_interface.h"
+
+static unsigned int hseTestFailures = 0U;
+
+#define HSE_TEST_CHECK(condition)                                                           \
+    do {                                                                                    \
+        if(!(condition))                                                                    \
+        {                                                                                   \
+            (void)fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            hseTestFailures++;                                                              \
+        }                                                                                   \
+    } while(0)
+
+/* Check a service response */
+#define HSE_TEST_CHECK_RSP(response, expected)                                              \
+    do {                                                                                    \
+        hseSrvResponse_t hseTestRsp = (response);                                           \
+        if((expected) != hseTestRsp)                                                        \
+        {                                                                                   \
+            (void)fprintf(stderr, "%s:%d: %s returned 0x%08lX, expected 0x%08lX\n",         \
+                          __FILE__, __LINE__, #response, (unsigned long)hseTestRsp,         \
+                          (unsigned long)(expected));                                       \
+            hseTestFailures++;                                                              \
+        }                                                                                   \
+    } while(0)
+
+#define HSE_TEST_RESULT()                                                                   \
+    ((0U == hseTestFailures) ? EXIT_SUCCESS : (printf("%u check(s) failed\n", hseTestFailures), EXIT_FAILURE))
+
+/* Monotonic wall clock of the benchmarks (microseconds) */
+static inline uint64_t HSE_TestNowUs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000ULL) + ((uint64_t)now.tv_nsec / 1000ULL);
+}
+
+#endif /* HSE_TEST_H */
+
+/** @} */
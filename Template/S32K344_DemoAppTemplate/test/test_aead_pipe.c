@@ -0,0 +1,182 @@
+/**
+*   @file    test_aead_pipe.c
+*
+*   @brief   Host test of the AEAD pipeline (virtual HSE).
+*   @details GCM encryption in place and decryption through staging buffers against OpenSSL, and a
+*            timeout: the step in flight is canceled, the channel and its RX interrupt are released.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_mu.h"
+#include "hse_host_import_key.h"
+#include "hse_host_aead_pipe.h"
+#include "hse_channel_mgr.h"
+
+#define HSE_TEST_KEY            GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+#define HSE_TEST_LENGTH         (4096UL + 40UL)
+#define HSE_TEST_CHUNK_SIZE     (1024UL)
+#define HSE_TEST_TAG_LENGTH     (16UL)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t iv[12] = { 0xCAU, 0xFEU, 0xBAU, 0xBEU, 0xFAU, 0xCEU, 0xDBU, 0xADU, 0xDEU, 0xCAU, 0xF8U, 0x88U };
+static const uint8_t aad[20] = { 0xFEU, 0xEDU, 0xFAU, 0xCEU, 0xDEU, 0xADU, 0xBEU, 0xEFU };
+
+static uint8_t plainText[HSE_TEST_LENGTH];
+static uint8_t expectedCipherText[HSE_TEST_LENGTH];
+static uint8_t expectedTag[HSE_TEST_TAG_LENGTH];
+static uint8_t buffer[HSE_TEST_LENGTH];
+static uint8_t stage[2][HSE_TEST_CHUNK_SIZE];
+
+static void ComputeExpected(void)
+{
+    EVP_CIPHER_CTX* pCtx = EVP_CIPHER_CTX_new();
+    int outLen = 0;
+    int finalLen = 0;
+
+    (void)EVP_EncryptInit_ex(pCtx, EVP_aes_128_gcm(), NULL, NULL, NULL);
+    (void)EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_SET_IVLEN, (int)sizeof(iv), NULL);
+    (void)EVP_EncryptInit_ex(pCtx, NULL, NULL, aes128Key, iv);
+    (void)EVP_EncryptUpdate(pCtx, NULL, &outLen, aad, (int)sizeof(aad));
+    (void)EVP_EncryptUpdate(pCtx, expectedCipherText, &outLen, plainText, (int)sizeof(plainText));
+    (void)EVP_EncryptFinal_ex(pCtx, &expectedCipherText[outLen], &finalLen);
+    (void)EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_AEAD_GET_TAG, (int)sizeof(expectedTag), expectedTag);
+    EVP_CIPHER_CTX_free(pCtx);
+}
+
+static void InitConfig(hseAeadPipeConfig_t* pConfig, hseCipherDir_t cipherDir, bool_t bStaged)
+{
+    memset(pConfig, 0, sizeof(*pConfig));
+    pConfig->u8MuInstance   = 0U;
+    pConfig->streamId       = 0U;
+    pConfig->authCipherMode = HSE_AUTH_CIPHER_MODE_GCM;
+    pConfig->cipherDir      = cipherDir;
+    pConfig->keyHandle      = HSE_TEST_KEY;
+    pConfig->ivLength       = sizeof(iv);
+    pConfig->pIV            = iv;
+    pConfig->aadLength      = sizeof(aad);
+    pConfig->pAAD           = aad;
+    pConfig->u32ChunkSize   = HSE_TEST_CHUNK_SIZE;
+    pConfig->pStage[0]      = bStaged ? stage[0] : NULL;
+    pConfig->pStage[1]      = bStaged ? stage[1] : NULL;
+}
+
+/* The RX interrupt is disabled again and no channel is held */
+static bool_t Released(void)
+{
+    uint8_t u8Channel;
+
+    for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+    {
+        if(HSE_ChannelIsHeld(0U, u8Channel) || HSE_ChannelIsBusy(0U, u8Channel))
+        {
+            return FALSE;
+        }
+    }
+    return (0UL == muRxEnabledInterruptMask[0U]) ? TRUE : FALSE;
+}
+
+/* Encryption in place (pInput == pOutput) */
+static void TestEncryptInPlace(void)
+{
+    hseAeadPipeConfig_t config;
+    uint8_t tag[HSE_TEST_TAG_LENGTH] = { 0U };
+
+    InitConfig(&config, HSE_CIPHER_DIR_ENCRYPT, FALSE);
+    memcpy(buffer, plainText, sizeof(buffer));
+    HSE_TEST_CHECK_RSP(HSE_AeadPipeRun(&config, sizeof(buffer), buffer, buffer, sizeof(tag), tag,
+                                       HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(buffer, expectedCipherText, sizeof(buffer)));
+    HSE_TEST_CHECK(0 == memcmp(tag, expectedTag, sizeof(tag)));
+    HSE_TEST_CHECK(Released());
+}
+
+/* Decryption through the staging buffers; a bad tag is reported */
+static void TestDecryptStaged(void)
+{
+    hseAeadPipeConfig_t config;
+    uint8_t tag[HSE_TEST_TAG_LENGTH];
+
+    InitConfig(&config, HSE_CIPHER_DIR_DECRYPT, TRUE);
+    memcpy(tag, expectedTag, sizeof(tag));
+    memset(buffer, 0, sizeof(buffer));
+    HSE_TEST_CHECK_RSP(HSE_AeadPipeRun(&config, sizeof(buffer), expectedCipherText, buffer, sizeof(tag), tag,
+                                       HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(buffer, plainText, sizeof(buffer)));
+
+    tag[0] ^= 0x01U;
+    HSE_TEST_CHECK_RSP(HSE_AeadPipeRun(&config, sizeof(buffer), expectedCipherText, buffer, sizeof(tag), tag,
+                                       HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_VERIFY_FAILED);
+    HSE_TEST_CHECK(Released());
+}
+
+/* Timeout during an UPDATE: the step is canceled instead of running to its end */
+static void TestTimeoutCancel(void)
+{
+    hseAeadPipeConfig_t config;
+    uint8_t tag[HSE_TEST_TAG_LENGTH];
+    uint64_t u64Start;
+
+    /* 50 us per byte: about 51 ms per chunk, START (no input) is immediate */
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_AEAD, 0UL, 50000UL), HSE_SRV_RSP_OK);
+    InitConfig(&config, HSE_CIPHER_DIR_ENCRYPT, TRUE);
+    u64Start = HSE_TestNowUs();
+    HSE_TEST_CHECK_RSP(HSE_AeadPipeRun(&config, sizeof(buffer), plainText, buffer, sizeof(tag), tag, 5000UL),
+                       HSE_SRV_RSP_HOST_TIMEOUT);
+    HSE_TEST_CHECK((HSE_TestNowUs() - u64Start) < 40000ULL);
+    HSE_TEST_CHECK(!HSE_AeadPipeBusy());
+    HSE_TEST_CHECK(Released());
+
+    /* The next pipeline runs normally */
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_AEAD, 0UL, 0UL), HSE_SRV_RSP_OK);
+    TestEncryptInPlace();
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(i = 0UL; i < HSE_TEST_LENGTH; i++)
+    {
+        plainText[i] = (uint8_t)(i * 7UL);
+    }
+    ComputeExpected();
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_TEST_KEY, HSE_KEY_TYPE_AES,
+                                            HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+
+    TestEncryptInPlace();
+    TestDecryptStaged();
+    TestTimeoutCancel();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
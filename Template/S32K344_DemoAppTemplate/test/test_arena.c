@@ -0,0 +1,217 @@
+/**
+*   @file    test_arena.c
+*
+*   @brief   Host test of the payload buffer arena (virtual HSE, built with HSE_ARENA).
+*   @details Buffers are allocated on an owned channel only; the buffers of a synchronous request
+*            survive the requests of the next owner of the channel until HSE_ArenaFree(), the
+*            buffers of an asynchronous request are released after its callback. HSE_ArenaFree()
+*            ignores the pointers that are not the start of a live buffer.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <stdatomic.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_mu.h"
+#include "hse_host_arena.h"
+#include "hse_channel_mgr.h"
+#include "hse_srv_builders.h"
+
+#define HSE_TEST_INPUT_LENGTH   (100UL)
+/* All service channels except channel 0 */
+#define HSE_TEST_CHANNEL_MASK   ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+typedef struct
+{
+    uint8_t*    pInput;
+    uint8_t*    pDigest;
+    uint32_t*   pDigestLength;
+} hseTestBuffers_t;
+
+static atomic_bool bCallbackDone;
+static atomic_bool bCallbackOk;
+
+/* Allocate the buffers of a SHA-256 request on an owned channel */
+static bool_t AllocBuffers(uint8_t u8Channel, hseTestBuffers_t* pBuffers)
+{
+    pBuffers->pInput = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, HSE_TEST_INPUT_LENGTH);
+    pBuffers->pDigest = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, 32UL);
+    pBuffers->pDigestLength = (uint32_t*)HSE_ArenaAlloc(0U, u8Channel, sizeof(uint32_t));
+    if((NULL == pBuffers->pInput) || (NULL == pBuffers->pDigest) || (NULL == pBuffers->pDigestLength))
+    {
+        return FALSE;
+    }
+    memset(pBuffers->pInput, 0xA5, HSE_TEST_INPUT_LENGTH);
+    *pBuffers->pDigestLength = 32UL;
+    HSE_BuildHashReq(&gHseSrvDesc[0U][u8Channel], HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256,
+                     HSE_SGT_OPTION_NONE, HSE_TEST_INPUT_LENGTH, pBuffers->pInput,
+                     pBuffers->pDigestLength, pBuffers->pDigest);
+    return TRUE;
+}
+
+static bool_t DigestOk(const hseTestBuffers_t* pBuffers)
+{
+    uint8_t expected[32];
+
+    (void)EVP_Digest(pBuffers->pInput, HSE_TEST_INPUT_LENGTH, expected, NULL, EVP_sha256(), NULL);
+    return (0 == memcmp(pBuffers->pDigest, expected, sizeof(expected))) ? TRUE : FALSE;
+}
+
+static void FreeBuffers(uint8_t u8Channel, const hseTestBuffers_t* pBuffers)
+{
+    HSE_ArenaFree(0U, u8Channel, pBuffers->pInput);
+    HSE_ArenaFree(0U, u8Channel, pBuffers->pDigest);
+    HSE_ArenaFree(0U, u8Channel, pBuffers->pDigestLength);
+}
+
+/* Only the owner of a channel allocates on it */
+static void TestOwnedChannelOnly(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+
+    HSE_TEST_CHECK(HSE_INVALID_CHANNEL != u8Channel);
+    HSE_ChannelRelease(0U, u8Channel);
+    HSE_TEST_CHECK(NULL == HSE_ArenaAlloc(0U, u8Channel, 16UL));
+    HSE_TEST_CHECK(HSE_ARENA_BLOCKS_PER_CHANNEL == HSE_ArenaFreeBlocks(0U, u8Channel));
+}
+
+/* The buffers of a synchronous request are released by their owner only */
+static void TestSyncExplicitRelease(void)
+{
+    hseTestBuffers_t first;
+    hseTestBuffers_t second;
+    uint32_t u32FreeBlocks;
+    uint8_t u8Channel;
+
+    u8Channel = HSE_ChannelClaim(0U);
+    HSE_TEST_CHECK(AllocBuffers(u8Channel, &first));
+    u32FreeBlocks = HSE_ArenaFreeBlocks(0U, u8Channel);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, &gHseSrvDesc[0U][u8Channel],
+                                         HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(DigestOk(&first));
+
+    /* The next owner of the channel sends its own request: the first buffers stay valid */
+    HSE_TEST_CHECK(HSE_ChannelTryAcquire(0U, u8Channel));
+    HSE_TEST_CHECK(AllocBuffers(u8Channel, &second));
+    HSE_TEST_CHECK(second.pInput != first.pInput);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, &gHseSrvDesc[0U][u8Channel],
+                                         HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(DigestOk(&second));
+    HSE_TEST_CHECK(u32FreeBlocks > HSE_ArenaFreeBlocks(0U, u8Channel));
+
+    FreeBuffers(u8Channel, &first);
+    HSE_TEST_CHECK(u32FreeBlocks == HSE_ArenaFreeBlocks(0U, u8Channel));
+    FreeBuffers(u8Channel, &second);
+    HSE_TEST_CHECK(HSE_ARENA_BLOCKS_PER_CHANNEL == HSE_ArenaFreeBlocks(0U, u8Channel));
+}
+
+/* An interior or already released pointer frees nothing */
+static void TestFreeStartOnly(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+    uint8_t* pFirst;
+    uint8_t* pSecond;
+    uint8_t* pBuffer;
+
+    HSE_TEST_CHECK(HSE_INVALID_CHANNEL != u8Channel);
+    if(HSE_INVALID_CHANNEL == u8Channel)
+    {
+        return;
+    }
+    /* Two one-block buffers, then one buffer of two blocks over them */
+    pFirst = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, HSE_ARENA_BLOCK_SIZE);
+    pSecond = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, HSE_ARENA_BLOCK_SIZE);
+    HSE_TEST_CHECK((NULL != pFirst) && (&pFirst[HSE_ARENA_BLOCK_SIZE] == pSecond));
+    HSE_ArenaFree(0U, u8Channel, pFirst);
+    HSE_ArenaFree(0U, u8Channel, pSecond);
+    pBuffer = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, 2UL * HSE_ARENA_BLOCK_SIZE);
+    HSE_TEST_CHECK(pBuffer == pFirst);
+    HSE_TEST_CHECK((HSE_ARENA_BLOCKS_PER_CHANNEL - 2UL) == HSE_ArenaFreeBlocks(0U, u8Channel));
+
+    /* The stale pointer of the second buffer is now inside the live one */
+    HSE_ArenaFree(0U, u8Channel, pSecond);
+    HSE_ArenaFree(0U, u8Channel, &pBuffer[1]);
+    HSE_TEST_CHECK((HSE_ARENA_BLOCKS_PER_CHANNEL - 2UL) == HSE_ArenaFreeBlocks(0U, u8Channel));
+
+    HSE_ArenaFree(0U, u8Channel, pBuffer);
+    HSE_TEST_CHECK(HSE_ARENA_BLOCKS_PER_CHANNEL == HSE_ArenaFreeBlocks(0U, u8Channel));
+    /* A stale pointer inside a newer buffer is ignored, and so is a second release */
+    pFirst = (uint8_t*)HSE_ArenaAlloc(0U, u8Channel, 3UL * HSE_ARENA_BLOCK_SIZE);
+    HSE_TEST_CHECK(pFirst == pBuffer);
+    HSE_ArenaFree(0U, u8Channel, pSecond);
+    HSE_TEST_CHECK((HSE_ARENA_BLOCKS_PER_CHANNEL - 3UL) == HSE_ArenaFreeBlocks(0U, u8Channel));
+    HSE_ArenaFree(0U, u8Channel, pFirst);
+    HSE_ArenaFree(0U, u8Channel, pFirst);
+    HSE_TEST_CHECK(HSE_ARENA_BLOCKS_PER_CHANNEL == HSE_ArenaFreeBlocks(0U, u8Channel));
+    HSE_ChannelRelease(0U, u8Channel);
+}
+
+static void AsyncCallback(hseSrvResponse_t status, void* pArg)
+{
+    const hseTestBuffers_t* pBuffers = (const hseTestBuffers_t*)pArg;
+
+    /* The buffers are still allocated while the callback runs */
+    if((HSE_SRV_RSP_OK == status) && DigestOk(pBuffers))
+    {
+        atomic_store(&bCallbackOk, true);
+    }
+    atomic_store(&bCallbackDone, true);
+}
+
+/* The buffers of an asynchronous request are released after its callback */
+static void TestAsyncRelease(void)
+{
+    hseTxOptions_t txOptions = { HSE_TX_ASYNCHRONOUS, AsyncCallback, NULL };
+    hseTestBuffers_t buffers;
+    uint8_t u8Channel;
+
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, HSE_TEST_CHANNEL_MASK);
+    u8Channel = HSE_ChannelClaim(0U);
+    HSE_TEST_CHECK(AllocBuffers(u8Channel, &buffers));
+    txOptions.pCallbackpArg = &buffers;
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, txOptions, &gHseSrvDesc[0U][u8Channel],
+                                         HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    /* Ignored while the request is in flight */
+    HSE_ArenaFree(0U, u8Channel, buffers.pInput);
+
+    while(!atomic_load(&bCallbackDone) || HSE_ChannelIsBusy(0U, u8Channel) ||
+          (HSE_ARENA_BLOCKS_PER_CHANNEL != HSE_ArenaFreeBlocks(0U, u8Channel)))
+    {
+    }
+    HSE_TEST_CHECK(atomic_load(&bCallbackOk));
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, HSE_TEST_CHANNEL_MASK);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestOwnedChannelOnly();
+    TestSyncExplicitRelease();
+    TestFreeStartOnly();
+    TestAsyncRelease();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,237 @@
+/**
+*   @file    test_batch.c
+*
+*   @brief   Host test of HSE_SendBatch() and HSE_BatchWait() (virtual HSE).
+*   @details A batch on all channels, a batch with no free channel, a refill that loses its
+*            channel to another context and a batch aborted on timeout (requests canceled,
+*            channels and RX interrupts given back).
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_batch.h"
+#include "hse_completion_ring.h"
+#include "hse_channel_mgr.h"
+#include "hse_srv_builders.h"
+#include "hse_mu.h"
+
+#define HSE_TEST_INPUT_LENGTH   (256U)
+
+static uint8_t input[HSE_BATCH_MAX_REQUESTS][HSE_TEST_INPUT_LENGTH];
+static uint8_t digest[HSE_BATCH_MAX_REQUESTS][32];
+static uint32_t digestLength[HSE_BATCH_MAX_REQUESTS];
+static hseSrvDescriptor_t descs[HSE_BATCH_MAX_REQUESTS];
+static hseSrvResponse_t responses[HSE_BATCH_MAX_REQUESTS];
+static volatile uint32_t completionMask;
+
+/* Claimed channels of each MU (released by ReleaseChannels) */
+static uint8_t claimed[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+static uint32_t noOfClaimed[HSE_NUM_OF_MU_INSTANCES];
+
+static void BuildBatch(uint32_t u32Count)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        memset(input[i], (int)i, HSE_TEST_INPUT_LENGTH);
+        memset(digest[i], 0, sizeof(digest[i]));
+        digestLength[i] = sizeof(digest[i]);
+        HSE_BuildHashReq(&descs[i], HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256, HSE_SGT_OPTION_NONE,
+                         HSE_TEST_INPUT_LENGTH, input[i], &digestLength[i], digest[i]);
+    }
+}
+
+static bool_t DigestsOk(uint32_t u32Count)
+{
+    uint8_t expected[32];
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        (void)EVP_Digest(input[i], HSE_TEST_INPUT_LENGTH, expected, NULL, EVP_sha256(), NULL);
+        if((HSE_SRV_RSP_OK != responses[i]) || (0 != memcmp(digest[i], expected, sizeof(expected))))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Claim all free channels, leaving u32Leave of MU0 free */
+static void ClaimChannels(uint32_t u32Leave)
+{
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        while(HSE_INVALID_CHANNEL != (u8Channel = HSE_ChannelClaim(u8Mu)))
+        {
+            claimed[u8Mu][noOfClaimed[u8Mu]++] = u8Channel;
+        }
+    }
+    while((0UL != u32Leave) && (0UL != noOfClaimed[0U]))
+    {
+        HSE_ChannelRelease(0U, claimed[0U][--noOfClaimed[0U]]);
+        u32Leave--;
+    }
+}
+
+static void ReleaseChannels(void)
+{
+    uint8_t u8Mu;
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        while(0UL != noOfClaimed[u8Mu])
+        {
+            HSE_ChannelRelease(u8Mu, claimed[u8Mu][--noOfClaimed[u8Mu]]);
+        }
+    }
+}
+
+/* No channel owned and the RX interrupts as before the batch */
+static bool_t ChannelsReleased(const uint32_t* pIrqMask)
+{
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        for(u8Channel = 1U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+        {
+            if(HSE_ChannelIsBusy(u8Mu, u8Channel))
+            {
+                return FALSE;
+            }
+        }
+        if(pIrqMask[u8Mu] != muRxEnabledInterruptMask[u8Mu])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* More requests than channels: every request completes */
+static void TestBatch(void)
+{
+    uint32_t irqMask[HSE_NUM_OF_MU_INSTANCES] = { muRxEnabledInterruptMask[0], muRxEnabledInterruptMask[1] };
+
+    BuildBatch(HSE_BATCH_MAX_REQUESTS);
+    HSE_TEST_CHECK_RSP(HSE_SendBatch(descs, HSE_BATCH_MAX_REQUESTS, responses, &completionMask), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_BatchWait(HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_BATCH_FULL_MASK(HSE_BATCH_MAX_REQUESTS) == completionMask);
+    HSE_TEST_CHECK(DigestsOk(HSE_BATCH_MAX_REQUESTS));
+    HSE_TEST_CHECK(!HSE_BatchIsActive());
+    /* The synchronous requests poll again after the batch */
+    HSE_TEST_CHECK(ChannelsReleased(irqMask));
+}
+
+/* No free channel: the batch is not started */
+static void TestNoChannel(void)
+{
+    BuildBatch(4UL);
+    ClaimChannels(0UL);
+    HSE_TEST_CHECK_RSP(HSE_SendBatch(descs, 4UL, responses, &completionMask), HSE_SRV_RSP_HOST_CHANNEL_BUSY);
+    HSE_TEST_CHECK(!HSE_BatchIsActive());
+    ReleaseChannels();
+}
+
+/* The channel freed by the first response is taken by another context before the refill */
+static void TestRefillLosesChannel(void)
+{
+    uint8_t u8Channel;
+
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+    BuildBatch(2UL);
+    ClaimChannels(1UL);
+    u8Channel = claimed[0U][noOfClaimed[0U]];
+    HSE_TEST_CHECK_RSP(HSE_SendBatch(descs, 2UL, responses, &completionMask), HSE_SRV_RSP_OK);
+
+    /* The RX interrupt frees the channel and queues the completion */
+    while(HSE_ChannelIsBusy(0U, u8Channel))
+    {
+    }
+    HSE_TEST_CHECK(u8Channel == HSE_ChannelClaim(0U));
+    claimed[0U][noOfClaimed[0U]++] = u8Channel;
+    HSE_TEST_CHECK(1UL == HSE_PollCompletions(0UL));
+    HSE_TEST_CHECK(1UL == completionMask);
+    HSE_TEST_CHECK(HSE_BatchIsActive());
+
+    /* Nothing is in flight: HSE_BatchWait sends the request left */
+    ReleaseChannels();
+    HSE_TEST_CHECK_RSP(HSE_BatchWait(HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(3UL == completionMask);
+    HSE_TEST_CHECK(DigestsOk(2UL));
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(FALSE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+}
+
+/* Timeout: the requests in flight are canceled and awaited before the abort returns */
+static void TestTimeoutAbort(void)
+{
+    static uint8_t snapshot[HSE_BATCH_MAX_REQUESTS][32];
+    uint32_t irqMask[HSE_NUM_OF_MU_INSTANCES] = { muRxEnabledInterruptMask[0], muRxEnabledInterruptMask[1] };
+    uint64_t u64Start;
+    uint32_t i;
+
+    /* More requests than channels: some are never sent */
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 200000UL, 0UL), HSE_SRV_RSP_OK);
+    BuildBatch(8UL);
+    u64Start = HSE_TestNowUs();
+    HSE_TEST_CHECK_RSP(HSE_SendBatch(descs, 8UL, responses, &completionMask), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_BatchWait(1000UL), HSE_SRV_RSP_HOST_TIMEOUT);
+    /* Returned long before the latency of the first request */
+    HSE_TEST_CHECK((HSE_TestNowUs() - u64Start) < 200000ULL);
+    HSE_TEST_CHECK(!HSE_BatchIsActive());
+    HSE_TEST_CHECK(ChannelsReleased(irqMask));
+    for(i = 0UL; i < 8UL; i++)
+    {
+        HSE_TEST_CHECK_RSP(responses[i], HSE_SRV_RSP_CANCELED);
+    }
+
+    /* No response left to come: the HSE no longer writes to the buffers of the batch */
+    memcpy(snapshot, digest, sizeof(snapshot));
+    (void)usleep(250000U);
+    HSE_TEST_CHECK(0 == memcmp(snapshot, digest, sizeof(snapshot)));
+
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 0UL, 0UL), HSE_SRV_RSP_OK);
+    TestBatch();
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestBatch();
+    TestNoChannel();
+    TestRefillLosesChannel();
+    TestTimeoutAbort();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
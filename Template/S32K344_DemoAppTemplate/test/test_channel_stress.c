@@ -0,0 +1,156 @@
+/**
+*   @file    test_channel_stress.c
+*
+*   @brief   Host stress test of the channel ownership (virtual HSE).
+*   @details HSE_TEST_THREADS threads send SHA-256 requests on both MU instances at the same time,
+*            on channels taken with HSE_GetFreeChannel(). A channel found in use by another thread
+*            between the claim and the send, a wrong digest, or a channel left owned at the end
+*            fails the test.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_channel_mgr.h"
+
+#define HSE_TEST_THREADS        (8U)
+#define HSE_TEST_ITERATIONS     (2000UL)
+#define HSE_TEST_INPUT_LENGTH   (256U)
+
+typedef struct
+{
+    uint32_t    u32Id;
+    uint32_t    u32Sent;
+    uint32_t    u32NoChannel;
+    uint32_t    u32Errors;
+} hseTestThread_t;
+
+/* Thread currently using each channel (0: none) */
+static atomic_uint channelUser[HSE_NUM_OF_MU_INSTANCES][HSE_NUM_OF_CHANNELS_PER_MU];
+static atomic_uint overlaps;
+
+static void* StressThread(void* pArg)
+{
+    hseTestThread_t* pThread = (hseTestThread_t*)pArg;
+    uint8_t input[HSE_TEST_INPUT_LENGTH];
+    uint8_t digest[32];
+    uint8_t expected[32];
+    uint32_t digestLength;
+    hseSrvDescriptor_t* pHseSrvDesc;
+    hseSrvResponse_t srvResponse;
+    unsigned int u32None;
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_ITERATIONS; i++)
+    {
+        u8Mu = (uint8_t)((pThread->u32Id + i) % HSE_NUM_OF_MU_INSTANCES);
+        u8Channel = HSE_GetFreeChannel(u8Mu);
+        if(HSE_INVALID_CHANNEL == u8Channel)
+        {
+            pThread->u32NoChannel++;
+            continue;
+        }
+
+        u32None = 0U;
+        if(!atomic_compare_exchange_strong(&channelUser[u8Mu][u8Channel], &u32None, pThread->u32Id + 1U))
+        {
+            atomic_fetch_add(&overlaps, 1U);
+        }
+
+        memset(input, (int)(pThread->u32Id ^ i), sizeof(input));
+        memcpy(input, &i, sizeof(i));
+        digestLength = sizeof(digest);
+        pHseSrvDesc = &gHseSrvDesc[u8Mu][u8Channel];
+        memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+        pHseSrvDesc->srvId = HSE_SRV_ID_HASH;
+        pHseSrvDesc->hseSrv.hashReq.accessMode = HSE_ACCESS_MODE_ONE_PASS;
+        pHseSrvDesc->hseSrv.hashReq.hashAlgo = HSE_HASH_ALGO_SHA2_256;
+        pHseSrvDesc->hseSrv.hashReq.inputLength = sizeof(input);
+        pHseSrvDesc->hseSrv.hashReq.pInput = HSE_PTR_TO_HOST_ADDR(input);
+        pHseSrvDesc->hseSrv.hashReq.pHashLength = HSE_PTR_TO_HOST_ADDR(&digestLength);
+        pHseSrvDesc->hseSrv.hashReq.pHash = HSE_PTR_TO_HOST_ADDR(digest);
+
+        /* The marker is cleared before the send (the channel is released with the response);
+         * a channel shared while the request runs shows as a wrong digest */
+        atomic_store(&channelUser[u8Mu][u8Channel], 0U);
+        srvResponse = HSE_SendOnClaimed(u8Mu, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
+        pThread->u32Sent++;
+        if((HSE_SRV_RSP_OK != srvResponse) ||
+           (1 != EVP_Digest(input, sizeof(input), expected, NULL, EVP_sha256(), NULL)) ||
+           (0 != memcmp(digest, expected, sizeof(digest))))
+        {
+            pThread->u32Errors++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t threads[HSE_TEST_THREADS];
+    hseTestThread_t thread[HSE_TEST_THREADS];
+    hseChannelStats_t stats;
+    uint32_t u32Sent = 0UL;
+    uint32_t u32NoChannel = 0UL;
+    uint32_t i;
+    uint8_t u8Mu;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    /* Long enough for the threads to compete for the channels */
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 20UL, 0UL);
+
+    for(i = 0UL; i < HSE_TEST_THREADS; i++)
+    {
+        memset(&thread[i], 0, sizeof(thread[i]));
+        thread[i].u32Id = i;
+        HSE_TEST_CHECK(0 == pthread_create(&threads[i], NULL, StressThread, &thread[i]));
+    }
+    for(i = 0UL; i < HSE_TEST_THREADS; i++)
+    {
+        (void)pthread_join(threads[i], NULL);
+        HSE_TEST_CHECK(0UL == thread[i].u32Errors);
+        u32Sent += thread[i].u32Sent;
+        u32NoChannel += thread[i].u32NoChannel;
+    }
+
+    HSE_TEST_CHECK(0U == atomic_load(&overlaps));
+    HSE_TEST_CHECK(0UL != u32Sent);
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        HSE_ChannelGetStats(u8Mu, &stats);
+        HSE_TEST_CHECK(0UL == stats.u32InUse);
+        printf("MU%u: %lu claims, %lu claim failures, peak %lu channels\n", (unsigned int)u8Mu,
+               (unsigned long)stats.u32Claims, (unsigned long)stats.u32ClaimFailures,
+               (unsigned long)stats.u32PeakInUse);
+    }
+    printf("%lu requests sent, %lu without a free channel\n", (unsigned long)u32Sent, (unsigned long)u32NoChannel);
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,269 @@
+/**
+*   @file    test_completion_ring.c
+*
+*   @brief   Host test of the deferred completion ring (virtual HSE).
+*   @details Overflow of the ring above the high-water mark (dropped completions are counted and
+*            their callback is never run), HSE_PollCompletions() called from a callback, and
+*            several tasks polling the ring at once: every callback runs exactly once and never
+*            concurrently with another one.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_channel_mgr.h"
+#include "hse_completion_ring.h"
+#include "hse_mu.h"
+
+#define HSE_TEST_POLLERS        (4U)
+#define HSE_TEST_REQUESTS       (2000UL)
+#define HSE_TEST_OVERFLOW       (4UL)
+#define HSE_TEST_HIGH_WATER     (2UL)
+#define HSE_TEST_DEADLINE_US    (10000000ULL)
+/* The asynchronous requests use the channels of MU0 except channel 0 */
+#define HSE_TEST_CHANNEL_MASK   ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* Written by the HSE */
+static uint8_t randomBuf[HSE_NUM_OF_CHANNELS_PER_MU][16];
+
+static atomic_uint callbackRuns[HSE_TEST_REQUESTS];
+static atomic_uint callbacksDone;
+static atomic_uint callbacksActive;
+static atomic_uint overlaps;
+static atomic_bool bStopPollers;
+static uint32_t nestedPolled;
+
+static void Callback(hseSrvResponse_t status, void* pArg)
+{
+    uint32_t u32Index = (uint32_t)(uintptr_t)pArg;
+
+    if(0U != atomic_fetch_add(&callbacksActive, 1U))
+    {
+        (void)atomic_fetch_add(&overlaps, 1U);
+    }
+    if((HSE_SRV_RSP_OK == status) && (u32Index < HSE_TEST_REQUESTS))
+    {
+        (void)atomic_fetch_add(&callbackRuns[u32Index], 1U);
+    }
+    (void)atomic_fetch_sub(&callbacksActive, 1U);
+    (void)atomic_fetch_add(&callbacksDone, 1U);
+}
+
+/* A callback polling the ring itself: the ring is already being drained */
+static void NestedCallback(hseSrvResponse_t status, void* pArg)
+{
+    nestedPolled += HSE_PollCompletions(0UL);
+    Callback(status, pArg);
+}
+
+/* Send GET_RANDOM_NUM on a free channel of MU0, the completion is queued by the RX interrupt */
+static uint8_t SendAsync(uint32_t u32Index, pfAsyncCallback_t pfCallback)
+{
+    hseSrvDescriptor_t* pHseSrvDesc;
+    hseTxOptions_t txOptions;
+    uint8_t u8Channel;
+
+    do
+    {
+        u8Channel = HSE_ChannelClaim(0U);
+    } while(HSE_INVALID_CHANNEL == u8Channel);
+
+    pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_GET_RANDOM_NUM;
+    pHseSrvDesc->hseSrv.getRandomNumReq.rngClass = HSE_RNG_CLASS_PTG3;
+    pHseSrvDesc->hseSrv.getRandomNumReq.randomNumLength = sizeof(randomBuf[u8Channel]);
+    pHseSrvDesc->hseSrv.getRandomNumReq.pRandomNum = HSE_PTR_TO_HOST_ADDR(randomBuf[u8Channel]);
+
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = pfCallback;
+    txOptions.pCallbackpArg   = (void*)(uintptr_t)u32Index;
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, txOptions, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US),
+                       HSE_SRV_RSP_OK);
+    return u8Channel;
+}
+
+static void ResetCallbacks(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_REQUESTS; i++)
+    {
+        atomic_store(&callbackRuns[i], 0U);
+    }
+    atomic_store(&callbacksDone, 0U);
+    atomic_store(&overlaps, 0U);
+}
+
+/* Above the high-water mark the completions are dropped: counted, callback never run */
+static void TestOverflow(void)
+{
+    hseCompletionStats_t stats;
+    uint8_t channels[HSE_TEST_OVERFLOW];
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, 0UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_COMPLETION_RING_SIZE + 1UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_TEST_HIGH_WATER), HSE_SRV_RSP_OK);
+    HSE_ResetCompletionStats();
+    ResetCallbacks();
+
+    /* All the channels are claimed first, so the requests are all answered before the poll */
+    for(i = 0UL; i < HSE_TEST_OVERFLOW; i++)
+    {
+        channels[i] = SendAsync(i, Callback);
+    }
+    for(i = 0UL; i < HSE_TEST_OVERFLOW; i++)
+    {
+        while(HSE_ChannelIsBusy(0U, channels[i]))
+        {
+        }
+    }
+
+    HSE_GetCompletionStats(&stats);
+    HSE_TEST_CHECK(HSE_TEST_HIGH_WATER == stats.u32Pending);
+    HSE_TEST_CHECK(HSE_TEST_HIGH_WATER == stats.u32Peak);
+    HSE_TEST_CHECK((HSE_TEST_OVERFLOW - HSE_TEST_HIGH_WATER) == stats.u32Dropped);
+    HSE_TEST_CHECK(0U == atomic_load(&callbacksDone));
+
+    /* Only the queued completions run, the dropped ones are lost */
+    HSE_TEST_CHECK(HSE_TEST_HIGH_WATER == HSE_PollCompletions(0UL));
+    HSE_TEST_CHECK(0UL == HSE_PollCompletions(0UL));
+    HSE_TEST_CHECK(HSE_TEST_HIGH_WATER == atomic_load(&callbacksDone));
+    HSE_GetCompletionStats(&stats);
+    HSE_TEST_CHECK(0UL == stats.u32Pending);
+    HSE_TEST_CHECK((HSE_TEST_OVERFLOW - HSE_TEST_HIGH_WATER) == stats.u32Dropped);
+
+    HSE_ResetCompletionStats();
+    HSE_GetCompletionStats(&stats);
+    HSE_TEST_CHECK((0UL == stats.u32Peak) && (0UL == stats.u32Dropped));
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(FALSE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+}
+
+/* A callback polling the ring gets nothing: the outer call runs the next completion */
+static void TestNestedPoll(void)
+{
+    uint8_t u8First;
+    uint8_t u8Second;
+
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+    ResetCallbacks();
+    nestedPolled = 0UL;
+
+    u8First = SendAsync(0UL, NestedCallback);
+    u8Second = SendAsync(1UL, NestedCallback);
+    while(HSE_ChannelIsBusy(0U, u8First) || HSE_ChannelIsBusy(0U, u8Second))
+    {
+    }
+    HSE_TEST_CHECK(2UL == HSE_PollCompletions(0UL));
+    HSE_TEST_CHECK(0UL == nestedPolled);
+    HSE_TEST_CHECK((1U == atomic_load(&callbackRuns[0])) && (1U == atomic_load(&callbackRuns[1])));
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(FALSE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+}
+
+static void* PollerThread(void* pArg)
+{
+    (void)pArg;
+    while(!atomic_load(&bStopPollers))
+    {
+        /* Let the other pollers and the device thread run on a single core */
+        if(0UL == HSE_PollCompletions(0UL))
+        {
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Several tasks poll at once: one of them drains the rings at a time */
+static void TestConcurrentPollers(void)
+{
+    pthread_t pollers[HSE_TEST_POLLERS];
+    hseCompletionStats_t stats;
+    uint64_t u64Start;
+    uint32_t u32Once = 0UL;
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+    HSE_ResetCompletionStats();
+    ResetCallbacks();
+    atomic_store(&bStopPollers, false);
+    for(i = 0UL; i < HSE_TEST_POLLERS; i++)
+    {
+        HSE_TEST_CHECK(0 == pthread_create(&pollers[i], NULL, PollerThread, NULL));
+    }
+
+    /* Fewer requests not run yet than ring entries: none is dropped. A lost callback ends the run at the deadline */
+    u64Start = HSE_TestNowUs();
+    for(i = 0UL; (i < HSE_TEST_REQUESTS) && ((HSE_TestNowUs() - u64Start) < HSE_TEST_DEADLINE_US); i++)
+    {
+        while(((i - atomic_load(&callbacksDone)) >= (HSE_NUM_OF_CHANNELS_PER_MU - 1UL)) &&
+              ((HSE_TestNowUs() - u64Start) < HSE_TEST_DEADLINE_US))
+        {
+            (void)sched_yield();
+        }
+        (void)SendAsync(i, Callback);
+    }
+    while((i != atomic_load(&callbacksDone)) && ((HSE_TestNowUs() - u64Start) < HSE_TEST_DEADLINE_US))
+    {
+        (void)sched_yield();
+    }
+
+    atomic_store(&bStopPollers, true);
+    for(i = 0UL; i < HSE_TEST_POLLERS; i++)
+    {
+        (void)pthread_join(pollers[i], NULL);
+    }
+
+    for(i = 0UL; i < HSE_TEST_REQUESTS; i++)
+    {
+        u32Once += (1U == atomic_load(&callbackRuns[i])) ? 1UL : 0UL;
+    }
+    HSE_TEST_CHECK(HSE_TEST_REQUESTS == u32Once);
+    HSE_TEST_CHECK(HSE_TEST_REQUESTS == atomic_load(&callbacksDone));
+    HSE_TEST_CHECK(0U == atomic_load(&overlaps));
+    HSE_GetCompletionStats(&stats);
+    HSE_TEST_CHECK((0UL == stats.u32Pending) && (0UL == stats.u32Dropped));
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(FALSE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+}
+
+int main(void)
+{
+    uint32_t u32IrqEnabled;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    /* The completions are queued by the MU RX interrupt */
+    u32IrqEnabled = HSE_TEST_CHANNEL_MASK & ~muRxEnabledInterruptMask[0];
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, u32IrqEnabled);
+
+    TestOverflow();
+    TestNestedPoll();
+    TestConcurrentPollers();
+
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, u32IrqEnabled);
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
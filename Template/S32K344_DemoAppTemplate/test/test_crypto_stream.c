@@ -0,0 +1,200 @@
+/**
+*   @file    test_crypto_stream.c
+*
+*   @brief   Host test of the cipher, MAC, AEAD and signature streams (virtual HSE).
+*   @details The stream helpers on gHseDefaultCtx pin the stream on the channel of its START,
+*            the asynchronous steps need a stream context (HSE_CtxStreamOpen).
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_host_cipher.h"
+#include "hse_host_mac.h"
+#include "hse_host_aead.h"
+#include "hse_host_sign.h"
+#include "hse_host_import_key.h"
+#include "hse_channel_mgr.h"
+#include "hse_srv_builders.h"
+
+#define HSE_TEST_STREAM     (1U)
+#define HSE_TEST_KEY        GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+static uint8_t input[64];
+static uint8_t output[64];
+
+/* Number of channels of MU0 owned and held */
+static uint32_t HeldChannels(void)
+{
+    uint32_t u32Held = 0UL;
+    uint8_t u8Channel;
+
+    for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+    {
+        if(HSE_ChannelIsHeld(0U, u8Channel) && HSE_ChannelIsBusy(0U, u8Channel))
+        {
+            u32Held++;
+        }
+    }
+    return u32Held;
+}
+
+/* UPDATE/FINISH of a stream not started on gHseDefaultCtx: no request is sent */
+static void TestNoStart(void)
+{
+    uint32_t tagLength = 16UL;
+    uint8_t tag[16];
+
+    HSE_TEST_CHECK_RSP(AesUpdateStreamEncrypt(0U, HSE_CIPHER_BLOCK_MODE_CBC, sizeof(input), input, output,
+                                              HSE_SGT_OPTION_NONE), HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamUpdate(HSE_TEST_STREAM, sizeof(input), input, HSE_SGT_OPTION_NONE),
+                       HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK_RSP(HmacGenerateFinishStream(HSE_HASH_ALGO_SHA2_256, HSE_TEST_STREAM, sizeof(input), input,
+                                                &tagLength, tag), HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK_RSP(AesGcmUpdateStreamEncrypt(HSE_TEST_STREAM, sizeof(input), input, output),
+                       HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK_RSP(RsaPssSignStreamUpdateSrv(sizeof(input), input), HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+}
+
+/* A START rejected by the HSE gives the channel back */
+static void TestFailedStart(void)
+{
+    HSE_TEST_CHECK(HSE_SRV_RSP_OK != AesCmacGenerateStreamStart(HSE_INVALID_KEY_HANDLE, HSE_TEST_STREAM,
+                                                                sizeof(input), input, HSE_SGT_OPTION_NONE));
+    HSE_TEST_CHECK(0UL == HeldChannels());
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamUpdate(HSE_TEST_STREAM, sizeof(input), input, HSE_SGT_OPTION_NONE),
+                       HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+}
+
+/* Asynchronous steps: a stream context is required */
+static void TestAsyncNeedsStreamCtx(void)
+{
+    const hseTxOptions_t txOptions = { HSE_TX_ASYNCHRONOUS, NULL, NULL };
+    hseCtx_t streamCtx;
+
+    HSE_TEST_CHECK_RSP(AesStartStreamEncryptAsync(&gHseDefaultCtx, txOptions, 0U, HSE_CIPHER_BLOCK_MODE_CBC,
+                                                  input, sizeof(input), input, output, HSE_SGT_OPTION_NONE),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamStartAsync(&gHseDefaultCtx, txOptions, 0U, HSE_TEST_STREAM,
+                                                       sizeof(input), input, HSE_SGT_OPTION_NONE),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(AesGcmStartStreamEncryptAsync(&gHseDefaultCtx, txOptions, HSE_TEST_STREAM, 0U,
+                                                     12UL, input, 0UL, NULL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(RsaPssSignStreamStartSrvAsync(&gHseDefaultCtx, txOptions, 0U, HSE_HASH_ALGO_SHA2_256, 0UL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+
+    /* The stream context holds its channel until it is closed */
+    HSE_TEST_CHECK_RSP(HSE_CtxStreamOpen(&gHseDefaultCtx, &streamCtx), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(1UL == HeldChannels());
+    HSE_TEST_CHECK(HSE_INVALID_CHANNEL != streamCtx.u8MuChannel);
+    HSE_CtxStreamClose(&streamCtx);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+}
+
+/* START/UPDATE/FINISH of a CMAC stream gives the one-shot CMAC of the whole message */
+static void TestCmacStream(void)
+{
+    uint8_t expected[16];
+    uint8_t tag[16];
+    uint32_t tagLength = sizeof(tag);
+    size_t expectedLength = 0U;
+
+    HSE_TEST_CHECK(NULL != EVP_Q_mac(NULL, "CMAC", NULL, "AES-128-CBC", NULL, aes128Key, sizeof(aes128Key),
+                                     input, sizeof(input), expected, sizeof(expected), &expectedLength));
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamStart(HSE_TEST_KEY, HSE_TEST_STREAM, 16UL, input,
+                                                  HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamUpdate(HSE_TEST_STREAM, 32UL, &input[16], HSE_SGT_OPTION_NONE),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(AesCmacGenerateStreamFinish(HSE_TEST_STREAM, 16UL, &input[48], &tagLength, tag,
+                                                   HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(sizeof(tag) == tagLength);
+    HSE_TEST_CHECK(0 == memcmp(tag, expected, sizeof(tag)));
+    HSE_TEST_CHECK(0UL == HeldChannels());
+}
+
+/* Send one step of a CMAC generate stream on a claimed channel of MU0 */
+static hseSrvResponse_t SendCmacStep(uint8_t u8Channel, hseAccessMode_t accessMode, uint32_t u32Len,
+                                     uint32_t* pTagLength, uint8_t* pTag)
+{
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    hseMacScheme_t macScheme;
+
+    macScheme.macAlgo = HSE_MAC_ALGO_CMAC;
+    macScheme.sch.cmac.cipherAlgo = HSE_CIPHER_ALGO_AES;
+    HSE_BuildMacReq(pHseSrvDesc, accessMode, HSE_TEST_STREAM, HSE_AUTH_DIR_GENERATE, HSE_SGT_OPTION_NONE,
+                    &macScheme, HSE_TEST_KEY, u32Len, input, pTagLength, pTag);
+    return HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US);
+}
+
+/* A step sent on another channel than the one of the START is rejected, the stream stays usable */
+static void TestStreamChannelPinned(void)
+{
+    uint8_t tag[16];
+    uint32_t tagLength = sizeof(tag);
+    uint8_t u8StartChannel;
+    uint8_t u8OtherChannel;
+
+    /* The stream keeps the channel of its START, as the stream helpers do */
+    u8StartChannel = HSE_GetFreeChannel(0U);
+    u8OtherChannel = HSE_GetFreeChannel(0U);
+    HSE_TEST_CHECK((HSE_INVALID_CHANNEL != u8StartChannel) && (HSE_INVALID_CHANNEL != u8OtherChannel));
+    HSE_ChannelHold(0U, u8StartChannel);
+    HSE_TEST_CHECK_RSP(SendCmacStep(u8StartChannel, HSE_ACCESS_MODE_START, 16UL, NULL, NULL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(SendCmacStep(u8OtherChannel, HSE_ACCESS_MODE_UPDATE, 16UL, NULL, NULL),
+                       HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK_RSP(SendCmacStep(u8StartChannel, HSE_ACCESS_MODE_FINISH, 16UL, &tagLength, tag),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(sizeof(tag) == tagLength);
+    HSE_ChannelUnhold(0U, u8StartChannel);
+    HSE_ChannelRelease(0U, u8StartChannel);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+    HSE_TEST_CHECK(!HSE_ChannelIsBusy(0U, u8OtherChannel));
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    memset(input, 0x5A, sizeof(input));
+
+    TestNoStart();
+    TestFailedStart();
+    TestAsyncNeedsStreamCtx();
+
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_TEST_KEY, HSE_KEY_TYPE_AES, HSE_KF_USAGE_SIGN,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    TestCmacStream();
+    TestStreamChannelPinned();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
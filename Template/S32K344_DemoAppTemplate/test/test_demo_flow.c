@@ -0,0 +1,58 @@
+/**
+*   @file    test_demo_flow.c
+*
+*   @brief   Host run of the demo application flow (virtual HSE).
+*   @details The demo services run unmodified, as on the target after the firmware is installed:
+*            key catalogs formatting and key provisioning (HSE_DemoAppConfigKeys), the crypto
+*            examples (HSE_Crypto) and the SHE command application (SHE_CommandApp_Service).
+*            A failed ASSERT of the demo aborts the test.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_mu.h"
+#include "hse_demo_app_services.h"
+
+extern volatile CryptoServicesTestStartedStatus_t gCryptoServicesStarted;
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    WaitForHSEFWInitToFinish();
+    HSE_DemoAppConfigKeys();
+    /* Installed keys are found by KEY_VERIFY: a second import is a no-op */
+    HSE_TEST_CHECK_RSP(ImportSymmetricKeys(), HSE_SRV_RSP_OK);
+
+    /* Every example started must succeed (HSE_Crypto asserts it as well) */
+    HSE_TEST_CHECK_RSP(HSE_Crypto(), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((uint32_t)gCryptoServicesStarted == (uint32_t)gCryptoServicesExecuted);
+
+    HSE_TEST_CHECK_RSP(SHE_CommandApp_Service(), HSE_SRV_RSP_OK);
+
+    /* The HSE is still initialized after the demo */
+    HSE_TEST_CHECK(0U != (HSE_MU_GetHseStatus(0U) & HSE_STATUS_INIT_OK));
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,218 @@
+/**
+*   @file    test_dispatch.c
+*
+*   @brief   Host test of the multi-channel request dispatcher (virtual HSE).
+*   @details The queued requests fill every service channel of the dispatched MU instances, the RX
+*            interrupt is enabled on those instances only, and several tasks can submit and pump
+*            concurrently.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_mu.h"
+#include "hse_host_dispatch.h"
+#include "hse_srv_builders.h"
+
+#define HSE_TEST_INPUT_LENGTH       (64U)
+#define HSE_TEST_THREADS            (4U)
+#define HSE_TEST_REQS_PER_THREAD    (64U)
+#define HSE_TEST_REQS               (HSE_TEST_THREADS * HSE_TEST_REQS_PER_THREAD)
+#define HSE_TEST_TIMEOUT_US         (10000000ULL)
+/* All service channels except channel 0 */
+#define HSE_TEST_CHANNEL_MASK       ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+#define HSE_TEST_SERVICE_CHANNELS   (HSE_NUM_OF_CHANNELS_PER_MU - 1U)
+
+typedef struct
+{
+    hseDispatchReq_t    req;
+    uint8_t             input[HSE_TEST_INPUT_LENGTH];
+    uint8_t             digest[32];
+    uint32_t            digestLength;
+} hseTestReq_t;
+
+static hseTestReq_t reqs[HSE_TEST_REQS];
+static atomic_uint callbackCount;
+
+static void Callback(hseSrvResponse_t status, void* pArg)
+{
+    (void)status;
+    (void)pArg;
+    atomic_fetch_add(&callbackCount, 1U);
+}
+
+static void BuildReq(hseTestReq_t* pTestReq, uint32_t u32Index)
+{
+    memset(pTestReq->input, (int)u32Index, HSE_TEST_INPUT_LENGTH);
+    memset(pTestReq->digest, 0, sizeof(pTestReq->digest));
+    pTestReq->digestLength = sizeof(pTestReq->digest);
+    HSE_BuildHashReq(&pTestReq->req.srvDesc, HSE_ACCESS_MODE_ONE_PASS, 0U, HSE_HASH_ALGO_SHA2_256,
+                     HSE_SGT_OPTION_NONE, HSE_TEST_INPUT_LENGTH, pTestReq->input,
+                     &pTestReq->digestLength, pTestReq->digest);
+    pTestReq->req.pfCallback = Callback;
+    pTestReq->req.pCallbackArg = NULL;
+}
+
+static bool_t ReqOk(const hseTestReq_t* pTestReq)
+{
+    uint8_t expected[32];
+
+    (void)EVP_Digest(pTestReq->input, HSE_TEST_INPUT_LENGTH, expected, NULL, EVP_sha256(), NULL);
+    return (pTestReq->req.bDone && (HSE_SRV_RSP_OK == pTestReq->req.response) &&
+            (0 == memcmp(pTestReq->digest, expected, sizeof(expected)))) ? TRUE : FALSE;
+}
+
+static bool_t WaitIdle(void)
+{
+    uint64_t u64Start = HSE_TestNowUs();
+
+    while(0UL != HSE_DispatchGetPending())
+    {
+        if((HSE_TestNowUs() - u64Start) > HSE_TEST_TIMEOUT_US)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* The queued requests are fanned out to every service channel of both MU instances */
+static void TestFanOut(void)
+{
+    uint32_t u32Scheduled = 0UL;
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_DispatchInit(HSE_MU0_MASK | HSE_MU1_MASK), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 20000UL, 0UL), HSE_SRV_RSP_OK);
+    atomic_store(&callbackCount, 0U);
+
+    for(i = 0UL; i < HSE_DISPATCH_QUEUE_SIZE; i++)
+    {
+        BuildReq(&reqs[i], i);
+        HSE_TEST_CHECK_RSP(HSE_DispatchSubmit(&reqs[i].req), HSE_SRV_RSP_OK);
+    }
+    for(i = 0UL; i < HSE_DISPATCH_QUEUE_SIZE; i++)
+    {
+        if(HSE_INVALID_CHANNEL != reqs[i].req.u8MuChannel)
+        {
+            u32Scheduled++;
+        }
+    }
+    /* The first request completes after 20 ms: all channels are still in use */
+    HSE_TEST_CHECK((HSE_NUM_OF_MU_INSTANCES * HSE_TEST_SERVICE_CHANNELS) == u32Scheduled);
+
+    HSE_TEST_CHECK(WaitIdle());
+    for(i = 0UL; i < HSE_DISPATCH_QUEUE_SIZE; i++)
+    {
+        HSE_TEST_CHECK(ReqOk(&reqs[i]));
+    }
+    HSE_TEST_CHECK(HSE_DISPATCH_QUEUE_SIZE == atomic_load(&callbackCount));
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 0UL, 0UL), HSE_SRV_RSP_OK);
+}
+
+/* Only the dispatched MU instances are used and get their RX interrupt enabled */
+static void TestMuMask(void)
+{
+    uint8_t u8Mu;
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_DispatchInit(0U), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_DispatchInit((hseMuMask_t)(1U << HSE_NUM_OF_MU_INSTANCES)), HSE_SRV_RSP_INVALID_PARAM);
+
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        HSE_MU_DisableInterrupts(u8Mu, HSE_INT_RESPONSE, HSE_TEST_CHANNEL_MASK);
+    }
+    HSE_TEST_CHECK_RSP(HSE_DispatchInit(HSE_MU1_MASK), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0UL == muRxEnabledInterruptMask[0U]);
+    HSE_TEST_CHECK(HSE_TEST_CHANNEL_MASK == muRxEnabledInterruptMask[1U]);
+
+    for(i = 0UL; i < HSE_DISPATCH_QUEUE_SIZE; i++)
+    {
+        BuildReq(&reqs[i], i);
+        HSE_TEST_CHECK_RSP(HSE_DispatchSubmit(&reqs[i].req), HSE_SRV_RSP_OK);
+    }
+    HSE_TEST_CHECK(WaitIdle());
+    for(i = 0UL; i < HSE_DISPATCH_QUEUE_SIZE; i++)
+    {
+        HSE_TEST_CHECK(ReqOk(&reqs[i]));
+        HSE_TEST_CHECK(1U == reqs[i].req.u8MuInstance);
+    }
+}
+
+static void* SubmitThread(void* pArg)
+{
+    uint32_t u32First = (uint32_t)(uintptr_t)pArg * HSE_TEST_REQS_PER_THREAD;
+    uint32_t i;
+
+    for(i = u32First; i < (u32First + HSE_TEST_REQS_PER_THREAD); i++)
+    {
+        BuildReq(&reqs[i], i);
+        /* Queue full: pump from this task as well and retry */
+        while(HSE_SRV_RSP_NOT_ENOUGH_SPACE == HSE_DispatchSubmit(&reqs[i].req))
+        {
+            HSE_DispatchPump();
+        }
+    }
+    return NULL;
+}
+
+/* Several tasks submit and pump while the RX interrupt completes and refills */
+static void TestConcurrentSubmit(void)
+{
+    pthread_t threads[HSE_TEST_THREADS];
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_DispatchInit(HSE_MU0_MASK | HSE_MU1_MASK), HSE_SRV_RSP_OK);
+    atomic_store(&callbackCount, 0U);
+    for(i = 0UL; i < HSE_TEST_THREADS; i++)
+    {
+        HSE_TEST_CHECK(0 == pthread_create(&threads[i], NULL, SubmitThread, (void*)(uintptr_t)i));
+    }
+    for(i = 0UL; i < HSE_TEST_THREADS; i++)
+    {
+        (void)pthread_join(threads[i], NULL);
+    }
+
+    HSE_TEST_CHECK(WaitIdle());
+    for(i = 0UL; i < HSE_TEST_REQS; i++)
+    {
+        HSE_TEST_CHECK(ReqOk(&reqs[i]));
+    }
+    HSE_TEST_CHECK(HSE_TEST_REQS == atomic_load(&callbackCount));
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestFanOut();
+    TestMuMask();
+    TestConcurrentSubmit();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
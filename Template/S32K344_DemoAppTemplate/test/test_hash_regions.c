@@ -0,0 +1,92 @@
+/**
+*   @file    test_hash_regions.c
+*
+*   @brief   Host test of HSE_HashRegions() (virtual HSE).
+*   @details More streamed regions than streams, mixed with one pass regions: the digests are
+*            checked against OpenSSL and no channel may stay held after the call.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_hash_regions.h"
+#include "hse_channel_mgr.h"
+
+/* Streamed regions span several chunks and outnumber the streams of all MU instances */
+#define HSE_TEST_REGIONS        (HSE_HASH_REGIONS_MAX)
+#define HSE_TEST_LONG_LENGTH    ((HSE_HASH_REGION_CHUNK_SIZE * 2UL) + 1000UL)
+#define HSE_TEST_SHORT_LENGTH   (1000UL)
+
+static uint8_t data[HSE_TEST_REGIONS][HSE_TEST_LONG_LENGTH];
+static uint8_t digest[HSE_TEST_REGIONS][64];
+
+int main(void)
+{
+    hseHashRegion_t regions[HSE_TEST_REGIONS];
+    uint8_t expected[64];
+    unsigned int expectedLength;
+    hseChannelStats_t stats;
+    uint32_t i;
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(i = 0UL; i < HSE_TEST_REGIONS; i++)
+    {
+        memset(data[i], (int)(0x11U * (i + 1UL)), HSE_TEST_LONG_LENGTH);
+        regions[i].pData = data[i];
+        /* One region in four is hashed in one pass */
+        regions[i].u32Length = (3UL == (i % 4UL)) ? HSE_TEST_SHORT_LENGTH : HSE_TEST_LONG_LENGTH;
+        regions[i].hashAlgo = (0UL == (i % 2UL)) ? HSE_HASH_ALGO_SHA2_256 : HSE_HASH_ALGO_SHA2_512;
+        regions[i].pHash = digest[i];
+        regions[i].u32HashLength = sizeof(digest[i]);
+    }
+
+    HSE_TEST_CHECK_RSP(HSE_HashRegions(regions, HSE_TEST_REGIONS, 10000000UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(FALSE == HSE_HashRegionsBusy());
+
+    for(i = 0UL; i < HSE_TEST_REGIONS; i++)
+    {
+        HSE_TEST_CHECK_RSP(regions[i].status, HSE_SRV_RSP_OK);
+        (void)EVP_Digest(data[i], regions[i].u32Length, expected, &expectedLength,
+                         (HSE_HASH_ALGO_SHA2_256 == regions[i].hashAlgo) ? EVP_sha256() : EVP_sha512(), NULL);
+        HSE_TEST_CHECK(expectedLength == regions[i].u32HashLength);
+        HSE_TEST_CHECK(0 == memcmp(expected, digest[i], expectedLength));
+    }
+
+    /* The channels held for the streams are given back */
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+        {
+            HSE_TEST_CHECK(FALSE == HSE_ChannelIsHeld(u8Mu, u8Channel));
+        }
+        HSE_ChannelGetStats(u8Mu, &stats);
+        HSE_TEST_CHECK(0UL == stats.u32InUse);
+    }
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
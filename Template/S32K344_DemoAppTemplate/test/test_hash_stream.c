@@ -0,0 +1,203 @@
+/**
+*   @file    test_hash_stream.c
+*
+*   @brief   Host test of the hash streams (virtual HSE).
+*   @details The steps of a stream must go out on the channel of its START: on gHseDefaultCtx the
+*            channel is held from the START to the FINISH, the asynchronous steps are sent on a
+*            stream context. Also checks the wait of the default context for a free channel.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_host_hash.h"
+#include "hse_channel_mgr.h"
+#include "hse_mu.h"
+
+#define HSE_TEST_CHUNK      (64U)
+#define HSE_TEST_CHUNKS     (8U)
+
+static uint8_t input[HSE_TEST_CHUNK * HSE_TEST_CHUNKS];
+static uint8_t expected[32];
+static volatile hseSrvResponse_t asyncStatus;
+static volatile bool_t bAsyncDone;
+
+/* Number of channels of MU0 owned and held */
+static uint32_t HeldChannels(void)
+{
+    uint32_t u32Held = 0UL;
+    uint8_t u8Channel;
+
+    for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+    {
+        if(HSE_ChannelIsHeld(0U, u8Channel) && HSE_ChannelIsBusy(0U, u8Channel))
+        {
+            u32Held++;
+        }
+    }
+    return u32Held;
+}
+
+static void TestDefaultCtxStream(void)
+{
+    uint8_t digest[32];
+    uint32_t digestLength = sizeof(digest);
+    uint32_t oneShotLength;
+    uint8_t oneShot[32];
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HashDataStartStreamDefSrv(HSE_HASH_ALGO_SHA2_256, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(1UL == HeldChannels());
+    for(i = 0UL; i < (HSE_TEST_CHUNKS - 1U); i++)
+    {
+        HSE_TEST_CHECK_RSP(HashDataUpdateStreamDefSrv(HSE_HASH_ALGO_SHA2_256, 0U, HSE_TEST_CHUNK,
+                                                      &input[i * HSE_TEST_CHUNK]), HSE_SRV_RSP_OK);
+        HSE_TEST_CHECK(1UL == HeldChannels());
+
+        /* Requests of other users meanwhile take the other channels */
+        oneShotLength = sizeof(oneShot);
+        HSE_TEST_CHECK_RSP(HashDataDefSrv(HSE_HASH_ALGO_SHA2_256, sizeof(input), input, &oneShotLength, oneShot,
+                                          HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+        HSE_TEST_CHECK(0 == memcmp(oneShot, expected, sizeof(expected)));
+    }
+    HSE_TEST_CHECK_RSP(HashDataFinishStreamDefSrv(HSE_HASH_ALGO_SHA2_256, 0U, HSE_TEST_CHUNK,
+                                                  &input[i * HSE_TEST_CHUNK], &digestLength, digest), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, sizeof(expected)));
+
+    /* No START on this context */
+    HSE_TEST_CHECK_RSP(HashDataUpdateStreamDefSrv(HSE_HASH_ALGO_SHA2_256, 1U, HSE_TEST_CHUNK, input),
+                       HSE_SRV_RSP_STREAMING_MODE_FAILURE);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+}
+
+static void AsyncCallback(hseSrvResponse_t status, void* pArg)
+{
+    (void)pArg;
+    asyncStatus = status;
+    bAsyncDone = TRUE;
+}
+
+static hseSrvResponse_t WaitAsync(hseSrvResponse_t sendStatus)
+{
+    if(HSE_SRV_RSP_OK != sendStatus)
+    {
+        return sendStatus;
+    }
+    while(!bAsyncDone)
+    {
+    }
+    bAsyncDone = FALSE;
+    return asyncStatus;
+}
+
+static void TestAsyncStream(void)
+{
+    const hseTxOptions_t txOptions = { HSE_TX_ASYNCHRONOUS, AsyncCallback, NULL };
+    hseCtx_t streamCtx;
+    uint8_t digest[32];
+    uint32_t digestLength = sizeof(digest);
+    uint32_t i;
+
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, 0xFFFFUL);
+
+    /* A stream step needs a stream context */
+    HSE_TEST_CHECK_RSP(HashDataStartStreamAsync(&gHseDefaultCtx, txOptions, HSE_HASH_ALGO_SHA2_256, 1U),
+                       HSE_SRV_RSP_INVALID_PARAM);
+
+    HSE_TEST_CHECK_RSP(HSE_CtxStreamOpen(&gHseDefaultCtx, &streamCtx), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(1UL == HeldChannels());
+    HSE_TEST_CHECK_RSP(WaitAsync(HashDataStartStreamAsync(&streamCtx, txOptions, HSE_HASH_ALGO_SHA2_256, 1U)),
+                       HSE_SRV_RSP_OK);
+    for(i = 0UL; i < (HSE_TEST_CHUNKS - 1U); i++)
+    {
+        HSE_TEST_CHECK_RSP(WaitAsync(HashDataUpdateStreamAsync(&streamCtx, txOptions, HSE_HASH_ALGO_SHA2_256, 1U,
+                                                               HSE_TEST_CHUNK, &input[i * HSE_TEST_CHUNK])),
+                           HSE_SRV_RSP_OK);
+        HSE_TEST_CHECK(1UL == HeldChannels());
+    }
+    HSE_TEST_CHECK_RSP(WaitAsync(HashDataFinishStreamAsync(&streamCtx, txOptions, HSE_HASH_ALGO_SHA2_256, 1U,
+                                                           HSE_TEST_CHUNK, &input[i * HSE_TEST_CHUNK],
+                                                           &digestLength, digest)), HSE_SRV_RSP_OK);
+    HSE_CtxStreamClose(&streamCtx);
+    HSE_TEST_CHECK(0UL == HeldChannels());
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, sizeof(expected)));
+
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, 0xFFFFUL);
+}
+
+static void* ReleaseLater(void* pArg)
+{
+    (void)usleep(20000U);
+    HSE_ChannelRelease(0U, (uint8_t)(uintptr_t)pArg);
+    return NULL;
+}
+
+/* All channels owned: the default context waits for one instead of failing */
+static void TestDefaultCtxWait(void)
+{
+    uint8_t channels[HSE_NUM_OF_CHANNELS_PER_MU];
+    uint8_t digest[32];
+    uint32_t digestLength = sizeof(digest);
+    uint32_t u32Claimed = 0UL;
+    pthread_t thread;
+
+    while(HSE_INVALID_CHANNEL != (channels[u32Claimed] = HSE_ChannelClaim(0U)))
+    {
+        u32Claimed++;
+    }
+    HSE_TEST_CHECK(0UL != u32Claimed);
+    HSE_TEST_CHECK(0 == pthread_create(&thread, NULL, ReleaseLater, (void*)(uintptr_t)channels[0]));
+    HSE_TEST_CHECK_RSP(HashDataDefSrv(HSE_HASH_ALGO_SHA2_256, sizeof(input), input, &digestLength, digest,
+                                      HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, sizeof(expected)));
+    (void)pthread_join(thread, NULL);
+    while(u32Claimed > 1UL)
+    {
+        u32Claimed--;
+        HSE_ChannelRelease(0U, channels[u32Claimed]);
+    }
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    for(i = 0UL; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)(i * 7UL);
+    }
+    (void)EVP_Digest(input, sizeof(input), expected, NULL, EVP_sha256(), NULL);
+
+    TestDefaultCtxStream();
+    TestAsyncStream();
+    TestDefaultCtxWait();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,161 @@
+/**
+*   @file    test_host_timeout.c
+*
+*   @brief   Host test of the request deadline: timeout, cancel on channel 0 and channel reuse.
+*   @details The virtual HSE answers GET_RANDOM_NUM after HSE_TEST_SLOW_US; the requests are
+*            sent with a shorter deadline in polling and in interrupt mode.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_channel_mgr.h"
+#include "hse_mu.h"
+
+/* Latency of the slow request and deadline it is sent with */
+#define HSE_TEST_SLOW_US        (300000UL)
+#define HSE_TEST_DEADLINE_US    (20000UL)
+
+static uint8_t randomBuf[32];
+
+static void BuildRandomReq(hseSrvDescriptor_t* pHseSrvDesc)
+{
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_GET_RANDOM_NUM;
+    pHseSrvDesc->hseSrv.getRandomNumReq.rngClass = HSE_RNG_CLASS_PTG3;
+    pHseSrvDesc->hseSrv.getRandomNumReq.randomNumLength = sizeof(randomBuf);
+    pHseSrvDesc->hseSrv.getRandomNumReq.pRandomNum = HSE_PTR_TO_HOST_ADDR(randomBuf);
+}
+
+/* Deadline passed, channel 0 free: the request is canceled and the channel can be reused */
+static void TestTimeoutCancel(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    uint64_t u64Start;
+
+    BuildRandomReq(pHseSrvDesc);
+    u64Start = HSE_TestNowUs();
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_HOST_TIMEOUT);
+    HSE_TEST_CHECK((HSE_TestNowUs() - u64Start) < (HSE_TEST_SLOW_US / 2U));
+    HSE_TEST_CHECK(FALSE == HSE_ChannelIsBusy(0U, u8Channel));
+    HSE_TEST_CHECK(FALSE == HSE_ChannelIsBusy(0U, 0U));
+    HSE_TEST_CHECK(MU_CHANNEL_FREE == HSE_MU_GetChannelStatus(0U, u8Channel));
+
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, 0UL, 0UL);
+    BuildRandomReq(pHseSrvDesc);
+    HSE_TEST_CHECK_RSP(HSE_Send(0U, u8Channel, gSyncTxOption, pHseSrvDesc), HSE_SRV_RSP_OK);
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_SLOW_US, 0UL);
+}
+
+/* Channel 0 owned by another context: no cancel, the channel stays busy until the response */
+static void TestTimeoutChannel0Owned(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    hseSrvDescriptor_t retryDesc;
+
+    HSE_TEST_CHECK(HSE_ChannelTryAcquire(0U, 0U));
+    BuildRandomReq(pHseSrvDesc);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_HOST_TIMEOUT);
+    HSE_TEST_CHECK(HSE_ChannelIsBusy(0U, 0U));
+    HSE_TEST_CHECK(MU_CHANNEL_BUSY == HSE_MU_GetChannelStatus(0U, u8Channel));
+
+    /* The request still in progress is not overwritten, the channel is not taken */
+    BuildRandomReq(&retryDesc);
+    HSE_TEST_CHECK_RSP(HSE_SendWithTimeout(0U, u8Channel, gSyncTxOption, &retryDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_HOST_CHANNEL_BUSY);
+    HSE_TEST_CHECK(FALSE == HSE_ChannelIsBusy(0U, u8Channel));
+
+    while(!HSE_MU_IsResponseReady(0U, u8Channel))
+    {
+    }
+    HSE_TEST_CHECK_RSP(HSE_MU_ReceiveResponse(0U, u8Channel), HSE_SRV_RSP_OK);
+    HSE_ChannelRelease(0U, 0U);
+}
+
+/* Interrupt mode: the handler releases the channel when the canceled response arrives */
+static void TestTimeoutIrq(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    uint64_t u64Start;
+
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, 0xFFFFUL);
+    BuildRandomReq(pHseSrvDesc);
+    u64Start = HSE_TestNowUs();
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_HOST_TIMEOUT);
+    while(HSE_ChannelIsBusy(0U, u8Channel) || HSE_ChannelIsBusy(0U, 0U))
+    {
+    }
+    HSE_TEST_CHECK((HSE_TestNowUs() - u64Start) < (HSE_TEST_SLOW_US / 2U));
+    HSE_TEST_CHECK(MU_CHANNEL_FREE == HSE_MU_GetChannelStatus(0U, u8Channel));
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, 0xFFFFUL);
+}
+
+/* A channel claimed by another context is not sent on by HSE_Send(), only by its owner with HSE_SendOnClaimed() */
+static void TestClaimedChannel(void)
+{
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+    hseSrvDescriptor_t* pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    hseSrvDescriptor_t otherDesc;
+
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, 0UL, 0UL);
+    BuildRandomReq(&otherDesc);
+    HSE_TEST_CHECK_RSP(HSE_Send(0U, u8Channel, gSyncTxOption, &otherDesc), HSE_SRV_RSP_HOST_CHANNEL_BUSY);
+    HSE_TEST_CHECK_RSP(HSE_SendWithTimeout(0U, u8Channel, gSyncTxOption, &otherDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_HOST_CHANNEL_BUSY);
+    /* Nothing was sent and the channel is still the claimer's */
+    HSE_TEST_CHECK(MU_CHANNEL_FREE == HSE_MU_GetChannelStatus(0U, u8Channel));
+    HSE_TEST_CHECK(HSE_ChannelIsBusy(0U, u8Channel));
+
+    BuildRandomReq(pHseSrvDesc);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(FALSE == HSE_ChannelIsBusy(0U, u8Channel));
+
+    /* A free channel is taken by both */
+    BuildRandomReq(pHseSrvDesc);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_TEST_DEADLINE_US),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_Send(0U, u8Channel, gSyncTxOption, pHseSrvDesc), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(FALSE == HSE_ChannelIsBusy(0U, u8Channel));
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_SLOW_US, 0UL);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    (void)HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_SLOW_US, 0UL);
+
+    TestTimeoutCancel();
+    TestTimeoutChannel0Owned();
+    TestTimeoutIrq();
+    TestClaimedChannel();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,189 @@
+/**
+*   @file    test_keys_allocator.c
+*
+*   @brief   Host test of HKF_SyncFromDevice() and of the key info cache of HKF_GetKeyInfo() (virtual HSE).
+*   @details Imports keys into a few slots of the demo catalogs, then HKF_Init() and
+*            HKF_SyncFromDevice() must rebuild the allocation map from the HSE. With every
+*            GET_KEY_INFO failing on the HSE, HKF_GetKeyInfo() must still answer the cached key
+*            infos and empty slots, and go to the HSE again for the slots taken by
+*            HKF_AllocKeySlot(), freed by HKF_FreeKeySlot() or dropped by HKF_InvalidateKeyInfo().
+*            Also the error of a slot, the timeout and the NOT_ALLOWED re-entry of the sync.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <unistd.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_import_key.h"
+#include "hse_keys_allocator.h"
+#include "hse_b_catalog_formatting.h"
+
+/* Group 1 of both demo catalogs: AES-128 keys (CUST owner in the NVM catalog) */
+#define HSE_TEST_NVM_AES(u8Slot)    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, 1U, (u8Slot))
+#define HSE_TEST_RAM_AES(u8Slot)    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 1U, (u8Slot))
+
+#define HSE_TEST_SLOW_KEY_INFO_US   (20000UL)
+
+static const hseKeyGroupCfgEntry_t nvmCatalog[] = {HSE_DEMO_NVM_KEY_CATALOG_CFG};
+static const hseKeyGroupCfgEntry_t ramCatalog[] = {HSE_DEMO_RAM_KEY_CATALOG_CFG};
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+/* The keys on the HSE before the sync */
+static const hseKeyHandle_t importedKeys[] =
+{
+    HSE_TEST_NVM_AES(0U), HSE_TEST_NVM_AES(2U), HSE_TEST_RAM_AES(1U)
+};
+
+static bool_t IsAllocated(hseKeyHandle_t keyHandle)
+{
+    return (HSE_SRV_RSP_OK == HKF_IsKeyHandleAllocated(keyHandle));
+}
+
+/* The allocation map rebuilt from the HSE */
+static void TestSync(void)
+{
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HKF_Init(nvmCatalog, ramCatalog), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_NVM_AES(0U)));
+    HSE_TEST_CHECK_RSP(HKF_SyncFromDevice(0U, HSE_WAIT_INFINITE), HSE_SRV_RSP_OK);
+
+    for(i = 0UL; i < (sizeof(importedKeys) / sizeof(importedKeys[0])); i++)
+    {
+        HSE_TEST_CHECK(IsAllocated(importedKeys[i]));
+    }
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_NVM_AES(1U)));
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_NVM_AES(3U)));
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_RAM_AES(0U)));
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_RAM_AES(2U)));
+}
+
+/* Cache hits answer without the HSE; the slots allocated, freed or invalidated go to the HSE again */
+static void TestKeyInfoCache(void)
+{
+    hseKeyHandle_t nvmHandle = HSE_INVALID_KEY_HANDLE;
+    hseKeyHandle_t ramHandle = HSE_INVALID_KEY_HANDLE;
+    hseKeyHandle_t freeHandle = HSE_TEST_NVM_AES(2U);
+    hseKeyInfo_t keyInfo;
+
+    /* From now on, GET_KEY_INFO fails on the HSE */
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_KEY_INFO, HSE_SRV_RSP_GENERAL_ERROR, 1000UL);
+
+    memset(&keyInfo, 0, sizeof(keyInfo));
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(0U), &keyInfo), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((HSE_KEY_TYPE_AES == keyInfo.keyType) && (128U == keyInfo.keyBitLen));
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_RAM_AES(1U), &keyInfo), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(1U), &keyInfo), HSE_SRV_RSP_KEY_EMPTY);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_RAM_AES(0U), &keyInfo), HSE_SRV_RSP_KEY_EMPTY);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_INVALID_KEY_HANDLE, &keyInfo), HSE_SRV_RSP_INVALID_PARAM);
+
+    /* The first free slots are taken: their KEY_EMPTY entries are dropped */
+    HSE_TEST_CHECK_RSP(HKF_AllocKeySlot(NVM_KEY, HSE_KEY_TYPE_AES, 128U, &nvmHandle), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_TEST_NVM_AES(1U) == nvmHandle);
+    HSE_TEST_CHECK_RSP(HKF_AllocKeySlot(RAM_KEY, HSE_KEY_TYPE_AES, 128U, &ramHandle), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_TEST_RAM_AES(0U) == ramHandle);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(nvmHandle, &keyInfo), HSE_SRV_RSP_GENERAL_ERROR);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(ramHandle, &keyInfo), HSE_SRV_RSP_GENERAL_ERROR);
+    /* An error is not cached */
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(nvmHandle, &keyInfo), HSE_SRV_RSP_GENERAL_ERROR);
+
+    /* A freed slot */
+    HSE_TEST_CHECK_RSP(HKF_FreeKeySlot(&freeHandle), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_INVALID_KEY_HANDLE == freeHandle);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(2U), &keyInfo), HSE_SRV_RSP_GENERAL_ERROR);
+
+    /* Read from the HSE again and cached, then dropped by HKF_InvalidateKeyInfo() */
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_KEY_INFO, HSE_SRV_RSP_OK, 0UL);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(nvmHandle, &keyInfo), HSE_SRV_RSP_KEY_EMPTY);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(2U), &keyInfo), HSE_SRV_RSP_OK);
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_KEY_INFO, HSE_SRV_RSP_GENERAL_ERROR, 1000UL);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(nvmHandle, &keyInfo), HSE_SRV_RSP_KEY_EMPTY);
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(2U), &keyInfo), HSE_SRV_RSP_OK);
+    HKF_InvalidateKeyInfo(HSE_TEST_NVM_AES(2U));
+    HSE_TEST_CHECK_RSP(HKF_GetKeyInfo(HSE_TEST_NVM_AES(2U), &keyInfo), HSE_SRV_RSP_GENERAL_ERROR);
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_KEY_INFO, HSE_SRV_RSP_OK, 0UL);
+
+    HSE_TEST_CHECK_RSP(HKF_FreeKeySlot(&nvmHandle), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_FreeKeySlot(&ramHandle), HSE_SRV_RSP_OK);
+}
+
+/* A slot whose GET_KEY_INFO fails is left as it is; the error is returned */
+static void TestSyncError(void)
+{
+    HSE_TEST_CHECK_RSP(HKF_Init(nvmCatalog, ramCatalog), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_MarkAsAllocated(GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, 0U, 0U)), HSE_SRV_RSP_OK);
+
+    /* The first slot queried is slot 0 of NVM group 0 */
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_KEY_INFO, HSE_SRV_RSP_GENERAL_ERROR, 1UL);
+    HSE_TEST_CHECK_RSP(HKF_SyncFromDevice(0U, HSE_WAIT_INFINITE), HSE_SRV_RSP_GENERAL_ERROR);
+    HSE_TEST_CHECK(IsAllocated(GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, 0U, 0U)));
+    HSE_TEST_CHECK(IsAllocated(HSE_TEST_NVM_AES(0U)));
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_NVM_AES(1U)));
+}
+
+/* A timed out sync: NOT_ALLOWED while its requests are in flight, then a new pass works */
+static void TestSyncTimeout(void)
+{
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HKF_Init(nvmCatalog, ramCatalog), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_KEY_INFO, HSE_TEST_SLOW_KEY_INFO_US, 0UL),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_SyncFromDevice(0U, HSE_TEST_SLOW_KEY_INFO_US / 10UL), HSE_SRV_RSP_HOST_TIMEOUT);
+    HSE_TEST_CHECK_RSP(HKF_SyncFromDevice(0U, HSE_WAIT_INFINITE), HSE_SRV_RSP_NOT_ALLOWED);
+
+    /* All the requests in flight completed */
+    (void)usleep(HSE_NUM_OF_CHANNELS_PER_MU * 2U * HSE_TEST_SLOW_KEY_INFO_US);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_KEY_INFO, 0UL, 0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_SyncFromDevice(0U, HSE_WAIT_INFINITE), HSE_SRV_RSP_OK);
+    for(i = 0UL; i < (sizeof(importedKeys) / sizeof(importedKeys[0])); i++)
+    {
+        HSE_TEST_CHECK(IsAllocated(importedKeys[i]));
+    }
+    HSE_TEST_CHECK(!IsAllocated(HSE_TEST_NVM_AES(1U)));
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    for(i = 0UL; i < (sizeof(importedKeys) / sizeof(importedKeys[0])); i++)
+    {
+        HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(importedKeys[i], HSE_KEY_TYPE_AES, HSE_KF_USAGE_ENCRYPT,
+                                                sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    }
+
+    TestSync();
+    TestKeyInfoCache();
+    TestSyncError();
+    TestSyncTimeout();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,289 @@
+/**
+*   @file    test_keys_provision.c
+*
+*   @brief   Host test of the key provisioning scheduler HKF_ProvisionKeys() (virtual HSE).
+*   @details A chained table: a key encrypted with a provision key of the same table, a parent
+*            failing on the HSE with a child encrypted with it and a grandchild depending on the
+*            child (both KEY_NOT_AVAILABLE, never sent), a key written twice and independent keys
+*            sent while the others are in flight. Checks the order of the requests, the report and
+*            the single publish of the NVM keystore, then the timeout and the NOT_ALLOWED re-entry
+*            while the requests of the timed out run are in flight.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_channel_mgr.h"
+#include "hse_host_cipher.h"
+#include "hse_keys_provision.h"
+
+#define HSE_TEST_NVM_KEY(u8Slot)    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, 1U, (u8Slot))
+#define HSE_TEST_RAM_KEY(u8Slot)    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 1U, (u8Slot))
+
+/* Entries of the chained table */
+#define HSE_TEST_PROV_KEY           (0U)    /* NVM provision key */
+#define HSE_TEST_WRAPPED_KEY        (1U)    /* Encrypted with HSE_TEST_PROV_KEY */
+#define HSE_TEST_BAD_PARENT         (2U)    /* Rejected by the HSE (no key info) */
+#define HSE_TEST_CHILD              (3U)    /* Encrypted with HSE_TEST_BAD_PARENT */
+#define HSE_TEST_GRANDCHILD         (4U)    /* dependsOn HSE_TEST_CHILD */
+#define HSE_TEST_PROV_KEY_AGAIN     (5U)    /* Writes HSE_TEST_PROV_KEY again */
+#define HSE_TEST_INDEPENDENT        (6U)
+#define HSE_TEST_ENTRIES            (7U)
+
+#define HSE_TEST_IMPORT_LATENCY_US  (2000UL)
+#define HSE_TEST_SLOW_IMPORT_US     (50000UL)
+
+static const uint8_t provKey[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+static const uint8_t wrappedKeyPlain[16] =
+{
+    0x00U, 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U,
+    0x88U, 0x99U, 0xAAU, 0xBBU, 0xCCU, 0xDDU, 0xEEU, 0xFFU
+};
+
+/* Read and written by the HSE */
+static uint8_t keyValues[HSE_TEST_ENTRIES][16];
+static hseKeyInfo_t keyInfos[HSE_TEST_ENTRIES];
+static hseKey_t keys[HSE_TEST_ENTRIES];
+static hseKeyHandle_t cipherHandles[HSE_TEST_ENTRIES];
+static hseCipherScheme_t ecbScheme;
+static hseKeyImportParams_t importParams[HSE_TEST_ENTRIES];
+static hkfProvEntry_t table[HSE_TEST_ENTRIES];
+static uint8_t plainBlock[16];
+static uint8_t cipherBlock[16];
+
+static bool_t PublishPending(void)
+{
+    return (0U != (HSE_VirtualGetStatus() & HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH));
+}
+
+/* The NVM keys stay in the RAM mirror of the keystore until they are published */
+static void EnableRamKeystore(void)
+{
+    static hsePublishNvmKeystoreRamtToFlash_t enable = HSE_CFG_YES;
+    hseSrvDescriptor_t* pHseSrvDesc;
+    uint8_t u8Channel = HSE_ChannelClaim(0U);
+
+    HSE_TEST_CHECK(HSE_INVALID_CHANNEL != u8Channel);
+    if(HSE_INVALID_CHANNEL == u8Channel)
+    {
+        return;
+    }
+    pHseSrvDesc = &gHseSrvDesc[0U][u8Channel];
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_SET_ATTR;
+    pHseSrvDesc->hseSrv.setAttrReq.attrId = HSE_ENABLE_PUBLISH_KEY_STORE_RAM_TO_FLASH_ATTR_ID;
+    pHseSrvDesc->hseSrv.setAttrReq.attrLen = sizeof(enable);
+    pHseSrvDesc->hseSrv.setAttrReq.pAttr = HSE_PTR_TO_HOST_ADDR(&enable);
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, pHseSrvDesc, HSE_WAIT_DEFAULT_TIMEOUT_US),
+                       HSE_SRV_RSP_OK);
+    HSE_ChannelRelease(0U, u8Channel);
+}
+
+/* AES-128 key import entry, encrypted (AES ECB) with the key of entry u16CipherEntry if given */
+static void SetEntry(uint16_t u16Entry, hseKeyHandle_t keyHandle, const uint8_t* pValue, uint16_t u16CipherEntry,
+                     uint16_t u16DependsOn)
+{
+    hseKeyImportParams_t* pParams = &importParams[u16Entry];
+
+    memset(&keyInfos[u16Entry], 0, sizeof(hseKeyInfo_t));
+    keyInfos[u16Entry].keyFlags = HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT;
+    keyInfos[u16Entry].keyBitLen = 128U;
+    keyInfos[u16Entry].keyCounter = HSE_RAM_KEY_COUNTER_VALUE;
+    keyInfos[u16Entry].keyType = HSE_KEY_TYPE_AES;
+    memcpy(keyValues[u16Entry], pValue, sizeof(keyValues[u16Entry]));
+
+    memset(&keys[u16Entry], 0, sizeof(hseKey_t));
+    keys[u16Entry].keyHandle = keyHandle;
+    keys[u16Entry].pKeyInfo = &keyInfos[u16Entry];
+    keys[u16Entry].keyValue.pKey2 = keyValues[u16Entry];
+    keys[u16Entry].keyValue.keyLen2 = sizeof(keyValues[u16Entry]);
+
+    memset(pParams, 0, sizeof(hseKeyImportParams_t));
+    pParams->pKey = &keys[u16Entry];
+    if(HKF_PROV_NO_DEP != u16CipherEntry)
+    {
+        int outLength = 0;
+        EVP_CIPHER_CTX* pCtx = EVP_CIPHER_CTX_new();
+
+        /* The value is sent encrypted with the cipher key */
+        (void)EVP_EncryptInit_ex(pCtx, EVP_aes_128_ecb(), NULL, keyValues[u16CipherEntry], NULL);
+        (void)EVP_CIPHER_CTX_set_padding(pCtx, 0);
+        (void)EVP_EncryptUpdate(pCtx, keyValues[u16Entry], &outLength, pValue, (int)sizeof(keyValues[u16Entry]));
+        EVP_CIPHER_CTX_free(pCtx);
+
+        cipherHandles[u16Entry] = keys[u16CipherEntry].keyHandle;
+        pParams->options = HSE_IMPORT_USE_CIPHER;
+        pParams->cipherParams.pKeyHandle = &cipherHandles[u16Entry];
+        pParams->cipherParams.pCipherScheme = &ecbScheme;
+    }
+
+    memset(&table[u16Entry], 0, sizeof(hkfProvEntry_t));
+    table[u16Entry].kind = HKF_PROV_IMPORT_KEY;
+    table[u16Entry].pImportParams = pParams;
+    table[u16Entry].dependsOn = u16DependsOn;
+}
+
+static void BuildChainedTable(void)
+{
+    static const uint8_t otherKey[16] = { 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U,
+                                          0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU, 0x10U };
+
+    SetEntry(HSE_TEST_PROV_KEY, HSE_TEST_NVM_KEY(0U), provKey, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+    SetEntry(HSE_TEST_WRAPPED_KEY, HSE_TEST_RAM_KEY(0U), wrappedKeyPlain, HSE_TEST_PROV_KEY, HKF_PROV_NO_DEP);
+    SetEntry(HSE_TEST_BAD_PARENT, HSE_TEST_RAM_KEY(1U), otherKey, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+    keys[HSE_TEST_BAD_PARENT].pKeyInfo = NULL;
+    SetEntry(HSE_TEST_CHILD, HSE_TEST_RAM_KEY(2U), otherKey, HSE_TEST_BAD_PARENT, HKF_PROV_NO_DEP);
+    SetEntry(HSE_TEST_GRANDCHILD, HSE_TEST_RAM_KEY(3U), otherKey, HKF_PROV_NO_DEP, HSE_TEST_CHILD);
+    SetEntry(HSE_TEST_PROV_KEY_AGAIN, HSE_TEST_NVM_KEY(0U), provKey, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+    SetEntry(HSE_TEST_INDEPENDENT, HSE_TEST_RAM_KEY(4U), otherKey, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+}
+
+static uint32_t EndUs(uint16_t u16Entry)
+{
+    return table[u16Entry].u32StartUs + table[u16Entry].u32DurationUs;
+}
+
+/* Dependencies, failure propagation and the single publish */
+static void TestChainedTable(void)
+{
+    static const hseSrvResponse_t expected[HSE_TEST_ENTRIES] =
+    {
+        HSE_SRV_RSP_OK, HSE_SRV_RSP_OK, HSE_SRV_RSP_INVALID_PARAM, HSE_SRV_RSP_KEY_NOT_AVAILABLE,
+        HSE_SRV_RSP_KEY_NOT_AVAILABLE, HSE_SRV_RSP_OK, HSE_SRV_RSP_OK
+    };
+    uint8_t expectedBlock[16];
+    hkfProvReport_t report;
+    int outLength = 0;
+    EVP_CIPHER_CTX* pCtx;
+    uint16_t e;
+
+    BuildChainedTable();
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_KEY, HSE_TEST_IMPORT_LATENCY_US, 0UL),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, HSE_TEST_ENTRIES, 0x01U, HSE_WAIT_INFINITE, &report),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_KEY, 0UL, 0UL), HSE_SRV_RSP_OK);
+
+    for(e = 0U; e < HSE_TEST_ENTRIES; e++)
+    {
+        HSE_TEST_CHECK_RSP(table[e].status, expected[e]);
+    }
+    HSE_TEST_CHECK((4U == report.noOfProvisioned) && (3U == report.noOfFailed));
+
+    /* The dependents of the failed parent were not sent */
+    HSE_TEST_CHECK((0UL == table[HSE_TEST_CHILD].u32StartUs) && (0UL == table[HSE_TEST_CHILD].u32DurationUs));
+    HSE_TEST_CHECK((0UL == table[HSE_TEST_GRANDCHILD].u32StartUs) &&
+                   (0UL == table[HSE_TEST_GRANDCHILD].u32DurationUs));
+
+    /* The wrapped key and the second write wait for the provision key; the others do not */
+    HSE_TEST_CHECK(table[HSE_TEST_PROV_KEY].u32DurationUs >= HSE_TEST_IMPORT_LATENCY_US);
+    HSE_TEST_CHECK(table[HSE_TEST_WRAPPED_KEY].u32StartUs >= EndUs(HSE_TEST_PROV_KEY));
+    HSE_TEST_CHECK(table[HSE_TEST_PROV_KEY_AGAIN].u32StartUs >= EndUs(HSE_TEST_PROV_KEY));
+    HSE_TEST_CHECK(table[HSE_TEST_BAD_PARENT].u32StartUs < EndUs(HSE_TEST_PROV_KEY));
+    HSE_TEST_CHECK(table[HSE_TEST_INDEPENDENT].u32StartUs < EndUs(HSE_TEST_PROV_KEY));
+    HSE_TEST_CHECK(report.u32TotalUs >= EndUs(HSE_TEST_WRAPPED_KEY));
+
+    /* One publish for both writes of the NVM key */
+    HSE_TEST_CHECK(report.bPublished);
+    HSE_TEST_CHECK_RSP(report.publishStatus, HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(!PublishPending());
+
+    /* The wrapped key was decrypted with the provision key */
+    memset(plainBlock, 0x5A, sizeof(plainBlock));
+    HSE_TEST_CHECK_RSP(AesEncrypt(HSE_TEST_RAM_KEY(0U), HSE_CIPHER_BLOCK_MODE_ECB, NULL, sizeof(plainBlock),
+                                  plainBlock, cipherBlock, HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    pCtx = EVP_CIPHER_CTX_new();
+    (void)EVP_EncryptInit_ex(pCtx, EVP_aes_128_ecb(), NULL, wrappedKeyPlain, NULL);
+    (void)EVP_CIPHER_CTX_set_padding(pCtx, 0);
+    (void)EVP_EncryptUpdate(pCtx, expectedBlock, &outLength, plainBlock, (int)sizeof(plainBlock));
+    EVP_CIPHER_CTX_free(pCtx);
+    HSE_TEST_CHECK(0 == memcmp(cipherBlock, expectedBlock, sizeof(expectedBlock)));
+
+    /* Nothing left to publish: RAM keys only */
+    SetEntry(0U, HSE_TEST_RAM_KEY(5U), provKey, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, 1U, 0x01U, HSE_WAIT_INFINITE, &report), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((1U == report.noOfProvisioned) && (0U == report.noOfFailed) && !report.bPublished);
+}
+
+static void TestParams(void)
+{
+    BuildChainedTable();
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(NULL, 1U, 0x01U, HSE_WAIT_INFINITE, NULL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, 0U, 0x01U, HSE_WAIT_INFINITE, NULL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, HSE_TEST_ENTRIES, 0U, HSE_WAIT_INFINITE, NULL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+
+    /* A dependency on itself or on a later entry */
+    table[HSE_TEST_WRAPPED_KEY].dependsOn = HSE_TEST_WRAPPED_KEY;
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, HSE_TEST_ENTRIES, 0x01U, HSE_WAIT_INFINITE, NULL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    table[HSE_TEST_WRAPPED_KEY].dependsOn = HSE_TEST_INDEPENDENT;
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, HSE_TEST_ENTRIES, 0x01U, HSE_WAIT_INFINITE, NULL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+}
+
+/* A timed out run: NOT_ALLOWED while its requests are in flight, then a new run works */
+static void TestTimeout(void)
+{
+    hkfProvReport_t report;
+    uint16_t e;
+
+    for(e = 0U; e < 2U; e++)
+    {
+        SetEntry(e, HSE_TEST_RAM_KEY(6U + e), wrappedKeyPlain, HKF_PROV_NO_DEP, HKF_PROV_NO_DEP);
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_KEY, HSE_TEST_SLOW_IMPORT_US, 0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, 2U, 0x01U, HSE_TEST_SLOW_IMPORT_US / 10UL, &report),
+                       HSE_SRV_RSP_HOST_TIMEOUT);
+    HSE_TEST_CHECK(0U == report.noOfProvisioned);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, 2U, 0x01U, HSE_WAIT_INFINITE, &report), HSE_SRV_RSP_NOT_ALLOWED);
+
+    /* The late responses are dropped by the next run */
+    (void)usleep(4U * HSE_TEST_SLOW_IMPORT_US);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_IMPORT_KEY, 0UL, 0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HKF_ProvisionKeys(table, 2U, 0x01U, HSE_WAIT_INFINITE, &report), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((2U == report.noOfProvisioned) && (0U == report.noOfFailed));
+    HSE_TEST_CHECK_RSP(table[0].status, HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(table[1].status, HSE_SRV_RSP_OK);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    ecbScheme.symCipher.cipherAlgo = HSE_CIPHER_ALGO_AES;
+    ecbScheme.symCipher.cipherBlockMode = HSE_CIPHER_BLOCK_MODE_ECB;
+    EnableRamKeystore();
+
+    TestParams();
+    TestChainedTable();
+    TestTimeout();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
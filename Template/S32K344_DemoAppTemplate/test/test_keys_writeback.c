@@ -0,0 +1,102 @@
+/**
+*   @file    test_keys_writeback.c
+*
+*   @brief   Host test of the NVM keystore write-back (virtual HSE).
+*   @details The publish is made to fail (HSE_VirtualInjectResponse) while the dirty slots fill up:
+*            the updates past HKF_WB_MAX_DIRTY are refused with HSE_SRV_RSP_NOT_ENOUGH_SPACE and
+*            written by the next successful publish.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_import_key.h"
+#include "hse_keys_writeback.h"
+
+#define HSE_TEST_NVM_KEY(u8Slot)    GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_NVM, 1U, (u8Slot))
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+static bool_t PublishPending(void)
+{
+    return (0U != (HSE_VirtualGetStatus() & HSE_STATUS_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH));
+}
+
+/* More dirty slots than HKF_WB_MAX_DIRTY while the publish fails */
+static void TestDirtyListFull(void)
+{
+    hkfWbStats_t stats;
+    uint32_t i;
+
+    HSE_VirtualInjectResponse(HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH, HSE_SRV_RSP_GENERAL_ERROR, 1000UL);
+    for(i = 0UL; i < (HKF_WB_MAX_DIRTY - 1UL); i++)
+    {
+        HSE_TEST_CHECK_RSP(HKF_WbKeyUpdated(HSE_TEST_NVM_KEY(i)), HSE_SRV_RSP_OK);
+    }
+    /* The last slot triggers the publish */
+    HSE_TEST_CHECK_RSP(HKF_WbKeyUpdated(HSE_TEST_NVM_KEY(i)), HSE_SRV_RSP_GENERAL_ERROR);
+    HSE_TEST_CHECK(HKF_WB_MAX_DIRTY == HKF_WbDirtyCount());
+
+    /* No slot left: refused, nothing written past the list */
+    for(i = HKF_WB_MAX_DIRTY; i < (HKF_WB_MAX_DIRTY + 8UL); i++)
+    {
+        HSE_TEST_CHECK_RSP(HKF_WbKeyUpdated(HSE_TEST_NVM_KEY(i)), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+        HSE_TEST_CHECK(HKF_WB_MAX_DIRTY == HKF_WbDirtyCount());
+    }
+    /* A slot already recorded retries the publish */
+    HSE_TEST_CHECK_RSP(HKF_WbKeyUpdated(HSE_TEST_NVM_KEY(0U)), HSE_SRV_RSP_GENERAL_ERROR);
+    HSE_TEST_CHECK(PublishPending());
+
+    /* The publish works again: the refused update is written with the others */
+    HSE_VirtualInjectResponse(HSE_SRV_ID_PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH, HSE_SRV_RSP_OK, 0UL);
+    HSE_TEST_CHECK_RSP(HKF_WbKeyUpdated(HSE_TEST_NVM_KEY(HKF_WB_MAX_DIRTY + 8UL)), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0UL == HKF_WbDirtyCount());
+    HSE_TEST_CHECK(!PublishPending());
+
+    HKF_WbGetStats(&stats);
+    HSE_TEST_CHECK(1UL == stats.u32Publishes);
+    HSE_TEST_CHECK((8UL + 2UL) == stats.u32PublishErrors);
+    HSE_TEST_CHECK((HKF_WB_MAX_DIRTY + 10UL) == stats.u32KeyUpdates);
+}
+
+int main(void)
+{
+    const hkfWbConfig_t config = { 0U, HKF_WB_DISABLED, HKF_WB_DISABLED };
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    HSE_TEST_CHECK_RSP(HKF_WbInit(&config, TRUE), HSE_SRV_RSP_OK);
+    /* The NVM key stays in the RAM mirror of the keystore */
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_TEST_NVM_KEY(0U), HSE_KEY_TYPE_AES, HSE_KF_USAGE_ENCRYPT,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(PublishPending());
+
+    TestDirtyListFull();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,267 @@
+/**
+*   @file    test_rng_pool.c
+*
+*   @brief   Host test of the DRG3/DRG4 random number pools (virtual HSE).
+*   @details Requests served from the pool across the block boundary, the low-water refill of the
+*            spare block, the fallback to GetRngNum() (spare block still being refilled, request
+*            longer than a block, class not cached), a failed refill, two tasks using the pool at
+*            once (the lock is not forced to be contended: only the counters are checked), and
+*            HSE_RngPoolDeinit() waiting for the refill in flight and restoring the RX interrupts.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_rng_pool.h"
+#include "hse_mu.h"
+
+/* Requests of 200 bytes: the third one of a block crosses the 512-byte boundary */
+#define HSE_TEST_REQ_SIZE           (200UL)
+#define HSE_TEST_REFILL_US          (50000UL)
+#define HSE_TEST_THREAD_REQUESTS    (500UL)
+#define HSE_TEST_DEADLINE_US        (10000000ULL)
+/* The pool uses the channels of MU0 except channel 0 */
+#define HSE_TEST_CHANNEL_MASK       ((0xFFFFFFFFUL >> (32UL - HSE_NUM_OF_CHANNELS_PER_MU)) & ~1UL)
+
+/* Written by the HSE (fallback to GetRngNum) */
+static uint8_t randomBuf[4][HSE_RNG_POOL_BLOCK_SIZE + 88UL];
+static uint8_t threadBuf[2][16];
+
+static uint32_t u32IrqBefore;
+
+static bool_t IsZero(const uint8_t* pBuf, uint32_t u32Length)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < u32Length; i++)
+    {
+        if(0U != pBuf[i])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void CheckStats(hseRngClass_t rngClass, uint32_t u32Hits, uint32_t u32Misses, uint32_t u32Refills,
+                       uint32_t u32RefillErrors)
+{
+    hseRngPoolStats_t stats;
+
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(rngClass, &stats), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(u32Hits == stats.u32Hits);
+    HSE_TEST_CHECK(u32Misses == stats.u32Misses);
+    HSE_TEST_CHECK(u32Refills == stats.u32Refills);
+    HSE_TEST_CHECK(u32RefillErrors == stats.u32RefillErrors);
+}
+
+/* Wait for the refill of the spare block to complete (in the RX interrupt) */
+static void WaitRefills(hseRngClass_t rngClass, uint32_t u32Refills, uint32_t u32RefillErrors)
+{
+    uint64_t u64Deadline = HSE_TestNowUs() + HSE_TEST_DEADLINE_US;
+    hseRngPoolStats_t stats;
+
+    do
+    {
+        (void)sched_yield();
+        HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(rngClass, &stats), HSE_SRV_RSP_OK);
+    } while(((stats.u32Refills != u32Refills) || (stats.u32RefillErrors != u32RefillErrors)) &&
+            (HSE_TestNowUs() < u64Deadline));
+    HSE_TEST_CHECK((u32Refills == stats.u32Refills) && (u32RefillErrors == stats.u32RefillErrors));
+}
+
+static void GetChecked(uint8_t* pBuf, uint32_t u32Length, hseRngClass_t rngClass)
+{
+    memset(pBuf, 0, u32Length);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGet(pBuf, u32Length, rngClass), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(!IsZero(pBuf, u32Length));
+}
+
+/* Init fills block 0 and starts the refill of block 1 */
+static void TestInit(void)
+{
+    u32IrqBefore = muRxEnabledInterruptMask[0];
+    HSE_TEST_CHECK_RSP(HSE_RngPoolInit(HSE_NUM_OF_MU_INSTANCES), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolInit(0U), HSE_SRV_RSP_OK);
+    WaitRefills(HSE_RNG_CLASS_DRG3, 1UL, 0UL);
+    WaitRefills(HSE_RNG_CLASS_DRG4, 1UL, 0UL);
+    CheckStats(HSE_RNG_CLASS_DRG3, 0UL, 0UL, 1UL, 0UL);
+
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGet(NULL, 1UL, HSE_RNG_CLASS_DRG3), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGet(randomBuf[0], 0UL, HSE_RNG_CLASS_DRG3), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_PTG3, NULL), HSE_SRV_RSP_INVALID_PARAM);
+}
+
+/* Offsets 0, 200, 400 -> 88 in the spare block (boundary), 88 -> 288 (low water: refill) */
+static void TestBlockSwitch(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < 4UL; i++)
+    {
+        GetChecked(randomBuf[i], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    }
+    HSE_TEST_CHECK(0 != memcmp(randomBuf[1], randomBuf[2], HSE_TEST_REQ_SIZE));
+    /* The request crossing the boundary takes 112 bytes of block 0 and 88 of block 1 */
+    HSE_TEST_CHECK(0 != memcmp(&randomBuf[2][0], &randomBuf[2][112], 88UL));
+    WaitRefills(HSE_RNG_CLASS_DRG3, 2UL, 0UL);
+    CheckStats(HSE_RNG_CLASS_DRG3, 4UL, 0UL, 2UL, 0UL);
+}
+
+/* Offsets 288 -> 488, 488 -> 176 (boundary), 176 -> 376 (refill sent, still running), 376: spare not ready */
+static void TestMiss(void)
+{
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_REFILL_US, 0UL), HSE_SRV_RSP_OK);
+    for(i = 0UL; i < 3UL; i++)
+    {
+        GetChecked(randomBuf[i], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    }
+    CheckStats(HSE_RNG_CLASS_DRG3, 7UL, 0UL, 2UL, 0UL);
+    GetChecked(randomBuf[3], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    /* The refill was ahead of the synchronous GetRngNum in the HSE */
+    WaitRefills(HSE_RNG_CLASS_DRG3, 3UL, 0UL);
+    CheckStats(HSE_RNG_CLASS_DRG3, 7UL, 1UL, 3UL, 0UL);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, 0UL, 0UL), HSE_SRV_RSP_OK);
+
+    /* 376 -> 384 */
+    GetChecked(randomBuf[0], 8UL, HSE_RNG_CLASS_DRG3);
+    CheckStats(HSE_RNG_CLASS_DRG3, 8UL, 1UL, 3UL, 0UL);
+
+    /* Longer than a block, and a class without pool */
+    GetChecked(randomBuf[0], HSE_RNG_POOL_BLOCK_SIZE + 88UL, HSE_RNG_CLASS_DRG3);
+    CheckStats(HSE_RNG_CLASS_DRG3, 8UL, 2UL, 3UL, 0UL);
+    GetChecked(randomBuf[1], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_PTG3);
+    CheckStats(HSE_RNG_CLASS_DRG3, 8UL, 2UL, 3UL, 0UL);
+}
+
+/* DRG4: offsets 0, 200, 400 -> 88 (boundary), 88 -> 288 (refill fails), 288 -> 296 (refill again) */
+static void TestRefillError(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < 3UL; i++)
+    {
+        GetChecked(randomBuf[i], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG4);
+    }
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_RANDOM_NUM, HSE_SRV_RSP_GENERAL_ERROR, 1UL);
+    GetChecked(randomBuf[3], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG4);
+    WaitRefills(HSE_RNG_CLASS_DRG4, 1UL, 1UL);
+    HSE_VirtualInjectResponse(HSE_SRV_ID_GET_RANDOM_NUM, HSE_SRV_RSP_OK, 0UL);
+
+    GetChecked(randomBuf[0], 8UL, HSE_RNG_CLASS_DRG4);
+    WaitRefills(HSE_RNG_CLASS_DRG4, 2UL, 1UL);
+    CheckStats(HSE_RNG_CLASS_DRG4, 5UL, 0UL, 2UL, 1UL);
+}
+
+static void* GetThread(void* pArg)
+{
+    uint8_t* pBuf = (uint8_t*)pArg;
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_THREAD_REQUESTS; i++)
+    {
+        HSE_TEST_CHECK_RSP(HSE_RngPoolGet(pBuf, 16UL, HSE_RNG_CLASS_DRG4), HSE_SRV_RSP_OK);
+        if(0UL == (i % 16UL))
+        {
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Two tasks: each request is counted once, as a hit or a miss */
+static void TestThreads(void)
+{
+    hseRngPoolStats_t before;
+    hseRngPoolStats_t after;
+    pthread_t threads[2];
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_DRG4, &before), HSE_SRV_RSP_OK);
+    for(i = 0UL; i < 2UL; i++)
+    {
+        HSE_TEST_CHECK(0 == pthread_create(&threads[i], NULL, GetThread, threadBuf[i]));
+    }
+    for(i = 0UL; i < 2UL; i++)
+    {
+        HSE_TEST_CHECK(0 == pthread_join(threads[i], NULL));
+    }
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_DRG4, &after), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((2UL * HSE_TEST_THREAD_REQUESTS) ==
+                   ((after.u32Hits - before.u32Hits) + (after.u32Misses - before.u32Misses)));
+    HSE_TEST_CHECK(after.u32Refills > before.u32Refills);
+    HSE_TEST_CHECK(after.u32RefillErrors == before.u32RefillErrors);
+}
+
+/* Deinit waits for the refill in flight and disables only the interrupts the pool enabled */
+static void TestDeinit(void)
+{
+    hseRngPoolStats_t before;
+    hseRngPoolStats_t after;
+
+    HSE_TEST_CHECK(HSE_TEST_CHANNEL_MASK == (muRxEnabledInterruptMask[0] & HSE_TEST_CHANNEL_MASK));
+    /* DRG3: offsets 384 -> 72 (boundary), 72 -> 272 (refill sent, still running) */
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_REFILL_US, 0UL), HSE_SRV_RSP_OK);
+    GetChecked(randomBuf[0], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    GetChecked(randomBuf[1], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_DRG3, &before), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((10UL == before.u32Hits) && (3UL == before.u32Refills));
+    HSE_TEST_CHECK_RSP(HSE_RngPoolDeinit(), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_DRG3, &after), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(4UL == after.u32Refills);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, 0UL, 0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(u32IrqBefore == muRxEnabledInterruptMask[0]);
+
+    /* After Deinit the requests go to the HSE and are not counted */
+    GetChecked(randomBuf[1], HSE_TEST_REQ_SIZE, HSE_RNG_CLASS_DRG3);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolGetStats(HSE_RNG_CLASS_DRG3, &before), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(&before, &after, sizeof(before)));
+
+    /* Interrupts enabled before Init are left enabled */
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, 1UL << 1U);
+    u32IrqBefore = muRxEnabledInterruptMask[0];
+    HSE_TEST_CHECK_RSP(HSE_RngPoolInit(0U), HSE_SRV_RSP_OK);
+    WaitRefills(HSE_RNG_CLASS_DRG3, 1UL, 0UL);
+    HSE_TEST_CHECK_RSP(HSE_RngPoolDeinit(), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(u32IrqBefore == muRxEnabledInterruptMask[0]);
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, 1UL << 1U);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestInit();
+    TestBlockSwitch();
+    TestMiss();
+    TestRefillError();
+    TestThreads();
+    TestDeinit();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
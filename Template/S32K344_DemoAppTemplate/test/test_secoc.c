@@ -0,0 +1,182 @@
+/**
+*   @file    test_secoc.c
+*
+*   @brief   Host test of the batched SecOC verification (virtual HSE).
+*   @details FAST CMAC PDUs with a bad tag on every odd PDU, verified from the RX interrupt and
+*            with deferred completions while another context sends its own FAST CMAC requests:
+*            the channels of the verification are held, so its prepared descriptors are never
+*            overwritten and the pass bitmap is exact.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_mac.h"
+#include "hse_host_import_key.h"
+#include "hse_host_secoc.h"
+#include "hse_completion_ring.h"
+#include "hse_channel_mgr.h"
+#include "hse_srv_builders.h"
+
+#define HSE_TEST_KEY            GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U)
+#define HSE_TEST_PDUS           (96UL)
+#define HSE_TEST_PDU_LENGTH     (16UL)
+#define HSE_TEST_TAG_LENGTH     (4UL)
+
+static const uint8_t aes128Key[16] =
+{
+    0x2BU, 0x7EU, 0x15U, 0x16U, 0x28U, 0xAEU, 0xD2U, 0xA6U,
+    0xABU, 0xF7U, 0x15U, 0x88U, 0x09U, 0xCFU, 0x4FU, 0x3CU
+};
+
+static uint8_t msg[HSE_TEST_PDUS][HSE_TEST_PDU_LENGTH];
+static uint8_t tag[HSE_TEST_PDUS][HSE_TEST_TAG_LENGTH];
+static hseSecOcPdu_t pdus[HSE_TEST_PDUS];
+static uint32_t passMap[HSE_SECOC_PASS_MAP_WORDS(HSE_TEST_PDUS)];
+
+/* Truncated AES-CMAC of a buffer */
+static void ComputeTag(const uint8_t* pMsg, uint32_t u32Length, uint8_t* pTag)
+{
+    uint8_t mac[16];
+    size_t macLength = 0U;
+
+    (void)EVP_Q_mac(NULL, "CMAC", NULL, "AES-128-CBC", NULL, aes128Key, sizeof(aes128Key),
+                    pMsg, u32Length, mac, sizeof(mac), &macLength);
+    memcpy(pTag, mac, HSE_TEST_TAG_LENGTH);
+}
+
+/* The odd PDUs carry a bad tag */
+static void BuildPdus(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_PDUS; i++)
+    {
+        memset(msg[i], (int)i, HSE_TEST_PDU_LENGTH);
+        ComputeTag(msg[i], HSE_TEST_PDU_LENGTH, tag[i]);
+        if(0UL != (i % 2UL))
+        {
+            tag[i][0] ^= 0x01U;
+        }
+        pdus[i].keyHandle       = HSE_TEST_KEY;
+        pdus[i].pMsg            = msg[i];
+        pdus[i].u32MsgBitLength = HSE_TEST_PDU_LENGTH * 8UL;
+        pdus[i].pTag            = tag[i];
+        pdus[i].u8TagBitLength  = (uint8_t)(HSE_TEST_TAG_LENGTH * 8UL);
+        pdus[i].u32CounterIdx   = HSE_SECOC_NO_COUNTER;
+    }
+}
+
+/* Exactly the even PDUs passed and no channel is left held */
+static bool_t ResultOk(void)
+{
+    uint8_t u8Mu;
+    uint8_t u8Channel;
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_PDUS; i++)
+    {
+        if(((passMap[i / 32UL] >> (i % 32UL)) & 1UL) != ((0UL == (i % 2UL)) ? 1UL : 0UL))
+        {
+            return FALSE;
+        }
+    }
+    for(u8Mu = 0U; u8Mu < HSE_NUM_OF_MU_INSTANCES; u8Mu++)
+    {
+        for(u8Channel = 0U; u8Channel < HSE_NUM_OF_CHANNELS_PER_MU; u8Channel++)
+        {
+            if(HSE_ChannelIsHeld(u8Mu, u8Channel))
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+/* Completions from the RX interrupt */
+static void TestVerify(void)
+{
+    uint32_t u32Failed = 0UL;
+
+    HSE_TEST_CHECK_RSP(HSE_SecOcVerify(pdus, HSE_TEST_PDUS, passMap, HSE_WAIT_DEFAULT_TIMEOUT_US, &u32Failed),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((HSE_TEST_PDUS / 2UL) == u32Failed);
+    HSE_TEST_CHECK(ResultOk());
+}
+
+/* Another context sends FAST CMAC GENERATE requests between the deferred completions */
+static void TestForeignRequests(void)
+{
+    uint8_t foreignMsg[HSE_TEST_PDU_LENGTH];
+    uint8_t foreignTag[HSE_TEST_TAG_LENGTH];
+    uint8_t expectedTag[HSE_TEST_TAG_LENGTH];
+    uint32_t u32Failed = 0UL;
+    uint8_t u8Channel;
+
+    memset(foreignMsg, 0xC3, sizeof(foreignMsg));
+    ComputeTag(foreignMsg, sizeof(foreignMsg), expectedTag);
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(TRUE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SecOcVerifyStart(pdus, HSE_TEST_PDUS, passMap), HSE_SRV_RSP_OK);
+
+    while(HSE_SecOcIsActive())
+    {
+        /* Takes any channel released since the last poll */
+        u8Channel = HSE_GetFreeChannel(0U);
+        if(HSE_INVALID_CHANNEL != u8Channel)
+        {
+            memset(foreignTag, 0, sizeof(foreignTag));
+            HSE_BuildFastCmacReq(&gHseSrvDesc[0U][u8Channel], HSE_AUTH_DIR_GENERATE, HSE_TEST_KEY,
+                                 sizeof(foreignMsg) * 8UL, foreignMsg, (uint8_t)(HSE_TEST_TAG_LENGTH * 8UL),
+                                 foreignTag);
+            HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, &gHseSrvDesc[0U][u8Channel],
+                                                 HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+            HSE_TEST_CHECK(0 == memcmp(foreignTag, expectedTag, sizeof(expectedTag)));
+        }
+        (void)HSE_PollCompletions(1UL);
+    }
+    HSE_TEST_CHECK_RSP(HSE_SecOcWait(HSE_WAIT_DEFAULT_TIMEOUT_US, &u32Failed), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((HSE_TEST_PDUS / 2UL) == u32Failed);
+    HSE_TEST_CHECK(ResultOk());
+    HSE_TEST_CHECK_RSP(HSE_EnableDeferredCompletions(FALSE, HSE_COMPLETION_RING_SIZE), HSE_SRV_RSP_OK);
+
+    /* The channels are free again */
+    HSE_TEST_CHECK_RSP(AesFastCmacGenerate(HSE_TEST_KEY, sizeof(foreignMsg) * 8UL, foreignMsg,
+                                           (uint8_t)(HSE_TEST_TAG_LENGTH * 8UL), foreignTag), HSE_SRV_RSP_OK);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(HSE_TEST_KEY, HSE_KEY_TYPE_AES, HSE_KF_USAGE_SIGN | HSE_KF_USAGE_VERIFY,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    BuildPdus();
+
+    TestVerify();
+    TestForeignRequests();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,272 @@
+/**
+*   @file    test_sgt.c
+*
+*   @brief   Host test of the scatter list builder (HSE_SgtInit/Append/AppendRing/Finalize).
+*   @details Contiguous fragments merged into one entry, fragments longer than
+*            HSE_SGT_MAX_CHUNK_LENGTH split, ring buffer spans with and without wrap-around, the
+*            capacity error kept until HSE_SgtInit(), the chunk alignment check, and one SHA-256
+*            over a finalized list on the virtual HSE compared with the one-shot hash of the
+*            same message.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_ctx.h"
+#include "hse_host_hash.h"
+#include "hse_host_utils.h"
+
+#define HSE_TEST_RING_SIZE      (256UL)
+#define HSE_TEST_RING_OFFSET    (200UL)
+#define HSE_TEST_RING_LENGTH    (120UL)
+#define HSE_TEST_FRAME_SIZE     (64UL)
+/* Address of the byte u32Offset of a fragment that is never read (longer than any buffer) */
+#define HSE_TEST_FAR(u32Offset) ((const void*)((uintptr_t)ring + (uintptr_t)(u32Offset)))
+
+/* Read by the HSE */
+static hseScatterList_t entries[HSE_MAX_NUM_OF_SGT_ENTRIES];
+static uint8_t ring[HSE_TEST_RING_SIZE];
+static uint8_t frames[3][HSE_TEST_FRAME_SIZE];
+static uint8_t message[HSE_TEST_RING_LENGTH + sizeof(frames)];
+/* Written by the HSE */
+static uint8_t sgtDigest[32];
+static uint8_t digest[32];
+
+/* Entry i of the builder: pointer, chunk length (final bit masked) and final bit */
+static bool_t EntryIs(const hseSgtBuilder_t* pBuilder, uint32_t i, const void* pData, uint32_t u32Length,
+                      bool_t bFinal)
+{
+    const hseScatterList_t* pEntry = &pBuilder->pEntries[i];
+
+    return (HSE_PTR_TO_HOST_ADDR(pData) == pEntry->pPtr) &&
+           (u32Length == (pEntry->length & ~HSE_SGT_FINAL_CHUNK_BIT_MASK)) &&
+           (bFinal == (0UL != (pEntry->length & HSE_SGT_FINAL_CHUNK_BIT_MASK)));
+}
+
+static void TestInit(void)
+{
+    hseSgtBuilder_t builder;
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, NULL, 1UL, 1UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, (hseScatterList_t*)&ring[1], 1UL, 1UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, 0UL, 1UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES + 1UL, 1UL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, 1UL, 0UL), HSE_SRV_RSP_INVALID_PARAM);
+    /* The error is kept */
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, ring, 16UL), HSE_SRV_RSP_INVALID_PARAM);
+
+    /* Nothing appended */
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, 1UL, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, ring, 0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, NULL), HSE_SRV_RSP_INVALID_PARAM);
+}
+
+/* Contiguous fragments extend the previous entry, empty ones are skipped */
+static void TestMerge(void)
+{
+    const hseSgtFragment_t fragments[] =
+    {
+        { &frames[1][0], 8UL }, { &frames[1][8], 0UL }, { &frames[1][8], 8UL }, { &frames[0][0], 16UL },
+    };
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, &frames[0][0], 10UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, &frames[0][10], 20UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(1UL == builder.u32NumEntries);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendFragments(&builder, fragments, 4UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(3UL == builder.u32NumEntries);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, NULL, 4UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_INVALID_PARAM);
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, &frames[0][0], 30UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendFragments(&builder, fragments, 4UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(62UL == u32Total);
+    HSE_TEST_CHECK((3UL == builder.u32NumEntries) &&
+                   EntryIs(&builder, 0UL, &frames[0][0], 30UL, FALSE) &&
+                   EntryIs(&builder, 1UL, &frames[1][0], 16UL, FALSE) &&
+                   EntryIs(&builder, 2UL, &frames[0][0], 16UL, TRUE));
+}
+
+/* The builder only records the pointers: the long fragments are never read */
+static void TestSplit(void)
+{
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, ring, HSE_SGT_MAX_CHUNK_LENGTH + 5UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((2UL == builder.u32NumEntries) &&
+                   EntryIs(&builder, 0UL, ring, HSE_SGT_MAX_CHUNK_LENGTH, FALSE) &&
+                   EntryIs(&builder, 1UL, HSE_TEST_FAR(HSE_SGT_MAX_CHUNK_LENGTH), 5UL, FALSE));
+    /* A contiguous fragment fills the last entry up to the maximum before a new one starts */
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, HSE_TEST_FAR(HSE_SGT_MAX_CHUNK_LENGTH + 5UL), HSE_SGT_MAX_CHUNK_LENGTH),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((3UL == builder.u32NumEntries) &&
+                   EntryIs(&builder, 1UL, HSE_TEST_FAR(HSE_SGT_MAX_CHUNK_LENGTH), HSE_SGT_MAX_CHUNK_LENGTH, FALSE) &&
+                   EntryIs(&builder, 2UL, HSE_TEST_FAR(2UL * HSE_SGT_MAX_CHUNK_LENGTH), 5UL, FALSE));
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(((2UL * HSE_SGT_MAX_CHUNK_LENGTH) + 5UL) == u32Total);
+    HSE_TEST_CHECK(EntryIs(&builder, 2UL, HSE_TEST_FAR(2UL * HSE_SGT_MAX_CHUNK_LENGTH), 5UL, TRUE));
+
+    /* The total length must fit in 32 bits */
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, ring, 0xFFFFFFF0UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames, 0x20UL), HSE_SRV_RSP_INVALID_PARAM);
+}
+
+static void TestRing(void)
+{
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+
+    /* No wrap-around: one entry */
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, 16UL, HSE_TEST_RING_SIZE - 16UL),
+                       HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((1UL == builder.u32NumEntries) && EntryIs(&builder, 0UL, &ring[16], HSE_TEST_RING_SIZE - 16UL, FALSE));
+
+    /* Wrap-around: the tail of the ring, then its head */
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, HSE_TEST_RING_OFFSET,
+                                         HSE_TEST_RING_LENGTH), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_TEST_RING_LENGTH == u32Total);
+    HSE_TEST_CHECK((2UL == builder.u32NumEntries) &&
+                   EntryIs(&builder, 0UL, &ring[HSE_TEST_RING_OFFSET], HSE_TEST_RING_SIZE - HSE_TEST_RING_OFFSET, FALSE) &&
+                   EntryIs(&builder, 1UL, ring, HSE_TEST_RING_LENGTH - (HSE_TEST_RING_SIZE - HSE_TEST_RING_OFFSET), TRUE));
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, HSE_TEST_RING_SIZE, 1UL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, 0UL, HSE_TEST_RING_SIZE + 1UL),
+                       HSE_SRV_RSP_INVALID_PARAM);
+}
+
+/* The first error is kept by all the calls until HSE_SgtInit() */
+static void TestCapacity(void)
+{
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, 2UL, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[0], 8UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[1], 8UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[2], 8UL), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    /* Would fit (contiguous with the last entry), but the list is already incomplete */
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, &frames[1][8], 8UL), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, 0UL, 8UL), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    HSE_TEST_CHECK((0UL == u32Total) && (2UL == builder.u32NumEntries) && EntryIs(&builder, 1UL, frames[1], 8UL, FALSE));
+
+    /* A wrapping ring span needs two entries */
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, 1UL, 1UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, HSE_TEST_RING_OFFSET,
+                                         HSE_TEST_RING_LENGTH), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+}
+
+/* All chunks but the last one must be a multiple of u32ChunkAlign */
+static void TestAlign(void)
+{
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 16UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[0], 20UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[1], 12UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK(0UL == (entries[1].length & HSE_SGT_FINAL_CHUNK_BIT_MASK));
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 16UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[0], 32UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[1], 16UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtAppend(&builder, frames[2], 5UL), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((53UL == u32Total) && EntryIs(&builder, 2UL, frames[2], 5UL, TRUE));
+}
+
+/* A wrapped ring span followed by three frames, hashed by the HSE from the list */
+static void TestHash(void)
+{
+    const hseSgtFragment_t fragments[] =
+    {
+        { frames[0], HSE_TEST_FRAME_SIZE }, { frames[1], HSE_TEST_FRAME_SIZE }, { frames[2], HSE_TEST_FRAME_SIZE },
+    };
+    uint32_t u32Head = HSE_TEST_RING_SIZE - HSE_TEST_RING_OFFSET;
+    hseSgtBuilder_t builder;
+    uint32_t u32Total = 0UL;
+    uint32_t u32SgtDigestLength = sizeof(sgtDigest);
+    uint32_t u32DigestLength = sizeof(digest);
+    uint32_t i;
+
+    for(i = 0UL; i < HSE_TEST_RING_SIZE; i++)
+    {
+        ring[i] = (uint8_t)(i * 7UL);
+    }
+    for(i = 0UL; i < sizeof(frames); i++)
+    {
+        frames[i / HSE_TEST_FRAME_SIZE][i % HSE_TEST_FRAME_SIZE] = (uint8_t)(0xA5UL ^ i);
+    }
+    memcpy(message, &ring[HSE_TEST_RING_OFFSET], u32Head);
+    memcpy(&message[u32Head], ring, HSE_TEST_RING_LENGTH - u32Head);
+    memcpy(&message[HSE_TEST_RING_LENGTH], frames, sizeof(frames));
+
+    HSE_TEST_CHECK_RSP(HSE_SgtInit(&builder, entries, HSE_MAX_NUM_OF_SGT_ENTRIES, 1UL), HSE_SRV_RSP_OK);
+    (void)HSE_SgtAppendRing(&builder, ring, HSE_TEST_RING_SIZE, HSE_TEST_RING_OFFSET, HSE_TEST_RING_LENGTH);
+    (void)HSE_SgtAppendFragments(&builder, fragments, 3UL);
+    HSE_TEST_CHECK_RSP(HSE_SgtFinalize(&builder, &u32Total), HSE_SRV_RSP_OK);
+    /* frames[] is one array: the three frames are merged */
+    HSE_TEST_CHECK((sizeof(message) == u32Total) && (3UL == builder.u32NumEntries));
+
+    HSE_TEST_CHECK_RSP(HashDataCtx(&gHseDefaultCtx, HSE_HASH_ALGO_SHA2_256, u32Total, HSE_SGT_LIST(&builder),
+                                   &u32SgtDigestLength, sgtDigest, HSE_SGT_OPTION_INPUT), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(HashDataCtx(&gHseDefaultCtx, HSE_HASH_ALGO_SHA2_256, sizeof(message), message,
+                                   &u32DigestLength, digest, HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((sizeof(digest) == u32SgtDigestLength) && (sizeof(digest) == u32DigestLength));
+    HSE_TEST_CHECK(0 == memcmp(sgtDigest, digest, sizeof(digest)));
+
+    /* The HSE checks the length against the list */
+    HSE_TEST_CHECK_RSP(HashDataCtx(&gHseDefaultCtx, HSE_HASH_ALGO_SHA2_256, u32Total - 1UL, HSE_SGT_LIST(&builder),
+                                   &u32SgtDigestLength, sgtDigest, HSE_SGT_OPTION_INPUT), HSE_SRV_RSP_INVALID_PARAM);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestInit();
+    TestMerge();
+    TestSplit();
+    TestRing();
+    TestCapacity();
+    TestAlign();
+    TestHash();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
@@ -0,0 +1,200 @@
+/**
+*   @file    test_sha2.c
+*
+*   @brief   Host test of the software SHA-256/SHA-512 and of HashPublicData() (virtual HSE).
+*   @details HostSha256() and HostSha512() against the FIPS 180-4 one million 'a' vectors and
+*            against OpenSSL for every length across the padding and block boundaries, also from
+*            unaligned buffers; HashPublicData() on the host and on the HSE path, and the
+*            threshold set by HashHostCalibrate().
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_hash.h"
+#include "hse_host_sha2.h"
+
+/* Every length up to 4 SHA-512 blocks (8 SHA-256 blocks) and a few more bytes */
+#define HSE_TEST_MAX_LENGTH     (4UL * 128UL + 24UL)
+#define HSE_TEST_MILLION        (1000000UL)
+
+/* FIPS 180-4 examples: one million repetitions of 'a' */
+static const uint8_t millionASha256[HOST_SHA256_DIGEST_LENGTH] =
+{
+    0xCDU, 0xC7U, 0x6EU, 0x5CU, 0x99U, 0x14U, 0xFBU, 0x92U, 0x81U, 0xA1U, 0xC7U, 0xE2U, 0x84U, 0xD7U, 0x3EU, 0x67U,
+    0xF1U, 0x80U, 0x9AU, 0x48U, 0xA4U, 0x97U, 0x20U, 0x0EU, 0x04U, 0x6DU, 0x39U, 0xCCU, 0xC7U, 0x11U, 0x2CU, 0xD0U
+};
+static const uint8_t millionASha512[HOST_SHA512_DIGEST_LENGTH] =
+{
+    0xE7U, 0x18U, 0x48U, 0x3DU, 0x0CU, 0xE7U, 0x69U, 0x64U, 0x4EU, 0x2EU, 0x42U, 0xC7U, 0xBCU, 0x15U, 0xB4U, 0x63U,
+    0x8EU, 0x1FU, 0x98U, 0xB1U, 0x3BU, 0x20U, 0x44U, 0x28U, 0x56U, 0x32U, 0xA8U, 0x03U, 0xAFU, 0xA9U, 0x73U, 0xEBU,
+    0xDEU, 0x0FU, 0xF2U, 0x44U, 0x87U, 0x7EU, 0xA6U, 0x0AU, 0x4CU, 0xB0U, 0x43U, 0x2CU, 0xE5U, 0x77U, 0xC3U, 0x1BU,
+    0xEBU, 0x00U, 0x9CU, 0x5CU, 0x2CU, 0x49U, 0xAAU, 0x2EU, 0x4EU, 0xADU, 0xB2U, 0x17U, 0xADU, 0x8CU, 0xC0U, 0x9BU
+};
+
+/* Read by the HSE: not on the stack of a test */
+static uint8_t input[HSE_TEST_MAX_LENGTH + 8UL];
+static uint8_t digest[HOST_SHA512_DIGEST_LENGTH];
+
+static void Expected(const EVP_MD* pMd, const uint8_t* pInput, uint32_t u32Length, uint8_t* pDigest)
+{
+    (void)EVP_Digest(pInput, u32Length, pDigest, NULL, pMd, NULL);
+}
+
+/* The known answer tests of the library and the long message vectors */
+static void TestVectors(void)
+{
+    uint8_t expected[HOST_SHA256_DIGEST_LENGTH];
+    uint8_t* pMillion = malloc(HSE_TEST_MILLION);
+
+    HSE_TEST_CHECK(HostSha2SelfTest());
+    HSE_TEST_CHECK(NULL != pMillion);
+    if(NULL != pMillion)
+    {
+        memset(pMillion, 'a', HSE_TEST_MILLION);
+        HostSha256(pMillion, HSE_TEST_MILLION, digest);
+        HSE_TEST_CHECK(0 == memcmp(digest, millionASha256, sizeof(millionASha256)));
+        HostSha512(pMillion, HSE_TEST_MILLION, digest);
+        HSE_TEST_CHECK(0 == memcmp(digest, millionASha512, sizeof(millionASha512)));
+        free(pMillion);
+    }
+
+    /* No input */
+    HostSha256(NULL, 0UL, digest);
+    Expected(EVP_sha256(), NULL, 0UL, expected);
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, HOST_SHA256_DIGEST_LENGTH));
+}
+
+/* Every length, so each padding case (length field in the last block or in an extra one) is hit */
+static void TestAllLengths(void)
+{
+    uint8_t expected[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t u32Length;
+    uint32_t u32Offset;
+
+    for(u32Length = 0UL; u32Length <= HSE_TEST_MAX_LENGTH; u32Length++)
+    {
+        /* Aligned and unaligned input */
+        for(u32Offset = 0UL; u32Offset < 4UL; u32Offset += 3UL)
+        {
+            Expected(EVP_sha256(), &input[u32Offset], u32Length, expected);
+            HostSha256(&input[u32Offset], u32Length, digest);
+            HSE_TEST_CHECK(0 == memcmp(digest, expected, HOST_SHA256_DIGEST_LENGTH));
+
+            Expected(EVP_sha512(), &input[u32Offset], u32Length, expected);
+            HostSha512(&input[u32Offset], u32Length, digest);
+            HSE_TEST_CHECK(0 == memcmp(digest, expected, HOST_SHA512_DIGEST_LENGTH));
+        }
+    }
+}
+
+/* Host and HSE paths of HashPublicData() give the same digest and truncation */
+static void TestPublicData(void)
+{
+    static const uint32_t lengths[] = { 0UL, 1UL, 55UL, 56UL, 64UL, 111UL, 112UL, 128UL, 300UL };
+    uint8_t expected[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t u32HashLength;
+    uint32_t u32Threshold;
+    uint32_t i;
+
+    for(u32Threshold = 0UL; u32Threshold <= 1024UL; u32Threshold += 1024UL)
+    {
+        HSE_TEST_CHECK_RSP(HashHostSetThreshold(HSE_HASH_ALGO_SHA2_256, u32Threshold), HSE_SRV_RSP_OK);
+        HSE_TEST_CHECK_RSP(HashHostSetThreshold(HSE_HASH_ALGO_SHA2_512, u32Threshold), HSE_SRV_RSP_OK);
+        for(i = 0UL; i < (sizeof(lengths) / sizeof(lengths[0])); i++)
+        {
+            Expected(EVP_sha256(), input, lengths[i], expected);
+            memset(digest, 0, sizeof(digest));
+            u32HashLength = HOST_SHA256_DIGEST_LENGTH;
+            HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA2_256, lengths[i], input, &u32HashLength, digest),
+                               HSE_SRV_RSP_OK);
+            HSE_TEST_CHECK(HOST_SHA256_DIGEST_LENGTH == u32HashLength);
+            HSE_TEST_CHECK(0 == memcmp(digest, expected, HOST_SHA256_DIGEST_LENGTH));
+
+            /* Truncated to the buffer */
+            Expected(EVP_sha512(), input, lengths[i], expected);
+            memset(digest, 0, sizeof(digest));
+            u32HashLength = 20UL;
+            HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA2_512, lengths[i], input, &u32HashLength, digest),
+                               HSE_SRV_RSP_OK);
+            HSE_TEST_CHECK(20UL == u32HashLength);
+            HSE_TEST_CHECK(0 == memcmp(digest, expected, 20UL));
+            HSE_TEST_CHECK(0U == digest[20]);
+        }
+    }
+
+    /* Host path parameter checks; the other algorithms always go to the HSE */
+    u32HashLength = 0UL;
+    HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA2_256, 16UL, input, &u32HashLength, digest),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    u32HashLength = HOST_SHA256_DIGEST_LENGTH;
+    HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA2_256, 16UL, NULL, &u32HashLength, digest),
+                       HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK_RSP(HashHostSetThreshold(HSE_HASH_ALGO_SHA_1, 64UL), HSE_SRV_RSP_INVALID_PARAM);
+    HSE_TEST_CHECK(0UL == HashHostGetThreshold(HSE_HASH_ALGO_SHA_1));
+    Expected(EVP_sha1(), input, 64UL, expected);
+    u32HashLength = 20UL;
+    HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA_1, 64UL, input, &u32HashLength, digest), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, 20UL));
+}
+
+/* The calibration sets a threshold within the timed lengths and keeps the digests right */
+static void TestCalibrate(void)
+{
+    uint8_t expected[HOST_SHA512_DIGEST_LENGTH];
+    uint32_t u32HashLength;
+    uint32_t u32Threshold;
+
+    HSE_TEST_CHECK_RSP(HashHostCalibrate(), HSE_SRV_RSP_OK);
+    u32Threshold = HashHostGetThreshold(HSE_HASH_ALGO_SHA2_256);
+    HSE_TEST_CHECK(u32Threshold <= (HASH_HOST_CALIBRATION_MAX + 1UL));
+    HSE_TEST_CHECK(HashHostGetThreshold(HSE_HASH_ALGO_SHA2_512) <= (HASH_HOST_CALIBRATION_MAX + 1UL));
+    printf("Calibrated thresholds: SHA2_256 %lu bytes, SHA2_512 %lu bytes\n", (unsigned long)u32Threshold,
+           (unsigned long)HashHostGetThreshold(HSE_HASH_ALGO_SHA2_512));
+
+    Expected(EVP_sha256(), input, 100UL, expected);
+    u32HashLength = HOST_SHA256_DIGEST_LENGTH;
+    HSE_TEST_CHECK_RSP(HashPublicData(HSE_HASH_ALGO_SHA2_256, 100UL, input, &u32HashLength, digest), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, HOST_SHA256_DIGEST_LENGTH));
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    for(i = 0UL; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)((i * 13UL) + 5UL);
+    }
+
+    TestVectors();
+    TestAllLengths();
+    TestPublicData();
+    TestCalibrate();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
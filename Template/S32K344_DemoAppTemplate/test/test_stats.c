@@ -0,0 +1,232 @@
+/**
+*   @file    test_stats.c
+*
+*   @brief   Host test of the per-service latency statistics (virtual HSE, HSE_STATS).
+*   @details The bucket bounds, HSE_StatsGet() after hash requests with a fixed latency and with
+*            injected errors, and the binary layout of HSE_StatsExport() (sizing, short buffer,
+*            header, services and buckets against the summary).
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_hash.h"
+#include "hse_host_stats.h"
+
+#define HSE_TEST_HASH_LATENCY_US    (2000UL)
+#define HSE_TEST_HASH_REQUESTS      (10UL)
+#define HSE_TEST_HASH_ERRORS        (3UL)
+
+/* Read by the HSE */
+static uint8_t input[64];
+static uint8_t digest[32];
+static uint8_t exportBuffer[HSE_STATS_EXPORT_MAX_SIZE];
+
+static uint32_t Get32(const uint8_t* pIn)
+{
+    return ((uint32_t)pIn[0] << 24U) | ((uint32_t)pIn[1] << 16U) | ((uint32_t)pIn[2] << 8U) | (uint32_t)pIn[3];
+}
+
+static hseSrvResponse_t Hash(void)
+{
+    uint32_t u32HashLength = sizeof(digest);
+
+    return HashDataCtx(&gHseDefaultCtx, HSE_HASH_ALGO_SHA2_256, sizeof(input), input, &u32HashLength, digest,
+                       HSE_SGT_OPTION_NONE);
+}
+
+/* Contiguous buckets: exact below HSE_STATS_SUB_BUCKETS, then 2^HSE_STATS_SUB_BUCKET_BITS per power of two */
+static void TestBuckets(void)
+{
+    uint32_t u32Bucket;
+    uint32_t u32Width;
+
+    HSE_TEST_CHECK(0UL == HSE_StatsBucketLowerUs(0UL));
+    for(u32Bucket = 0UL; u32Bucket < HSE_STATS_SUB_BUCKETS; u32Bucket++)
+    {
+        HSE_TEST_CHECK(u32Bucket == HSE_StatsBucketLowerUs(u32Bucket));
+        HSE_TEST_CHECK(u32Bucket == HSE_StatsBucketUpperUs(u32Bucket));
+    }
+    for(u32Bucket = 0UL; u32Bucket < (HSE_STATS_NUM_BUCKETS - 1UL); u32Bucket++)
+    {
+        HSE_TEST_CHECK((HSE_StatsBucketUpperUs(u32Bucket) + 1UL) == HSE_StatsBucketLowerUs(u32Bucket + 1UL));
+        /* Resolution: a bucket is at most 1/HSE_STATS_SUB_BUCKETS of its lower bound wide */
+        u32Width = HSE_StatsBucketUpperUs(u32Bucket) - HSE_StatsBucketLowerUs(u32Bucket) + 1UL;
+        HSE_TEST_CHECK((u32Bucket < HSE_STATS_SUB_BUCKETS) ||
+                       ((u32Width * HSE_STATS_SUB_BUCKETS) <= HSE_StatsBucketLowerUs(u32Bucket)));
+    }
+    /* The last bucket ends the power of two below 2^HSE_STATS_MAX_EXPONENT us and takes the slower requests */
+    HSE_TEST_CHECK(((1UL << HSE_STATS_MAX_EXPONENT) - (1UL << (HSE_STATS_MAX_EXPONENT - 1UL - HSE_STATS_SUB_BUCKET_BITS))) ==
+                   HSE_StatsBucketLowerUs(HSE_STATS_NUM_BUCKETS - 1UL));
+    HSE_TEST_CHECK(UINT32_MAX == HSE_StatsBucketUpperUs(HSE_STATS_NUM_BUCKETS - 1UL));
+}
+
+/* Count, errors and latencies of the hash requests */
+static void TestGet(void)
+{
+    hseStatsSummary_t summary;
+    uint32_t i;
+
+    HSE_StatsReset();
+    HSE_TEST_CHECK_RSP(HSE_StatsGet(HSE_SRV_ID_HASH, &summary), HSE_SRV_RSP_INVALID_PARAM);
+
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, HSE_TEST_HASH_LATENCY_US, 0UL), HSE_SRV_RSP_OK);
+    for(i = 0UL; i < HSE_TEST_HASH_REQUESTS; i++)
+    {
+        HSE_TEST_CHECK_RSP(Hash(), HSE_SRV_RSP_OK);
+    }
+    HSE_VirtualInjectResponse(HSE_SRV_ID_HASH, HSE_SRV_RSP_NOT_SUPPORTED, HSE_TEST_HASH_ERRORS);
+    for(i = 0UL; i < HSE_TEST_HASH_ERRORS; i++)
+    {
+        HSE_TEST_CHECK_RSP(Hash(), HSE_SRV_RSP_NOT_SUPPORTED);
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 0UL, 0UL), HSE_SRV_RSP_OK);
+
+    HSE_TEST_CHECK_RSP(HSE_StatsGet(HSE_SRV_ID_HASH, &summary), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK((HSE_TEST_HASH_REQUESTS + HSE_TEST_HASH_ERRORS) == summary.u32Count);
+    HSE_TEST_CHECK(HSE_TEST_HASH_ERRORS == summary.u32Errors);
+    HSE_TEST_CHECK(summary.u32MinUs >= HSE_TEST_HASH_LATENCY_US);
+    HSE_TEST_CHECK(summary.u32MaxUs >= summary.u32MinUs);
+    /* The percentiles are the upper bound of their bucket, capped to the maximum */
+    HSE_TEST_CHECK((summary.u32P50Us >= summary.u32MinUs) && (summary.u32P50Us <= summary.u32P90Us));
+    HSE_TEST_CHECK((summary.u32P90Us <= summary.u32P99Us) && (summary.u32P99Us <= summary.u32MaxUs));
+    /* The mean of the bucket midpoints is within one bucket (25%) of the exact range */
+    HSE_TEST_CHECK(((uint64_t)summary.u32MeanUs * 4ULL) >= ((uint64_t)summary.u32MinUs * 3ULL));
+    HSE_TEST_CHECK(summary.u32MeanUs <= summary.u32MaxUs);
+    printf("HASH: %lu requests, %lu errors, min %lu us, p50 %lu us, p99 %lu us, max %lu us, mean %lu us\n",
+           (unsigned long)summary.u32Count, (unsigned long)summary.u32Errors, (unsigned long)summary.u32MinUs,
+           (unsigned long)summary.u32P50Us, (unsigned long)summary.u32P99Us, (unsigned long)summary.u32MaxUs,
+           (unsigned long)summary.u32MeanUs);
+
+    HSE_TEST_CHECK_RSP(HSE_StatsGet(HSE_SRV_ID_HASH, NULL), HSE_SRV_RSP_INVALID_PARAM);
+}
+
+/* The export of the services recorded by TestGet */
+static void TestExport(void)
+{
+    hseStatsSummary_t summary;
+    const uint8_t* pIn;
+    uint32_t u32Length = 0UL;
+    uint32_t u32Needed;
+    uint32_t u32Services;
+    uint32_t u32Service;
+    uint32_t u32Buckets;
+    uint32_t u32Bucket;
+    uint32_t u32Previous;
+    uint32_t u32Count;
+    uint32_t u32Errors;
+    uint32_t u32Total;
+    uint32_t u32MinUs;
+    uint32_t u32MaxUs;
+    uint32_t u32SrvId;
+    bool_t bHashFound = FALSE;
+
+    /* Sizing, and a short buffer left untouched */
+    HSE_TEST_CHECK_RSP(HSE_StatsExport(NULL, &u32Length), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    u32Needed = u32Length;
+    HSE_TEST_CHECK((u32Needed > HSE_STATS_EXPORT_HEADER_SIZE) && (u32Needed <= HSE_STATS_EXPORT_MAX_SIZE));
+    memset(exportBuffer, 0xA5, sizeof(exportBuffer));
+    u32Length = u32Needed - 1UL;
+    HSE_TEST_CHECK_RSP(HSE_StatsExport(exportBuffer, &u32Length), HSE_SRV_RSP_NOT_ENOUGH_SPACE);
+    HSE_TEST_CHECK(u32Needed == u32Length);
+    HSE_TEST_CHECK(0xA5U == exportBuffer[0]);
+    HSE_TEST_CHECK_RSP(HSE_StatsExport(exportBuffer, NULL), HSE_SRV_RSP_INVALID_PARAM);
+
+    u32Length = sizeof(exportBuffer);
+    HSE_TEST_CHECK_RSP(HSE_StatsExport(exportBuffer, &u32Length), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(u32Needed == u32Length);
+
+    /* Header */
+    pIn = exportBuffer;
+    HSE_TEST_CHECK(HSE_STATS_EXPORT_VERSION == pIn[0]);
+    HSE_TEST_CHECK(HSE_STATS_SUB_BUCKET_BITS == pIn[1]);
+    HSE_TEST_CHECK(HSE_STATS_NUM_BUCKETS == pIn[2]);
+    u32Services = pIn[3];
+    HSE_TEST_CHECK((0UL != u32Services) && (u32Services <= HSE_STATS_MAX_SERVICES));
+    HSE_TEST_CHECK(0UL == Get32(&pIn[4]));
+    pIn += HSE_STATS_EXPORT_HEADER_SIZE;
+
+    for(u32Service = 0UL; u32Service < u32Services; u32Service++)
+    {
+        u32SrvId = Get32(&pIn[0]);
+        u32Count = Get32(&pIn[4]);
+        u32Errors = Get32(&pIn[8]);
+        u32MinUs = Get32(&pIn[12]);
+        u32MaxUs = Get32(&pIn[16]);
+        u32Buckets = pIn[20];
+        HSE_TEST_CHECK(0UL != u32Buckets);
+        pIn += HSE_STATS_EXPORT_SERVICE_SIZE;
+
+        /* Buckets in ascending order; the first holds the minimum, the last the maximum */
+        u32Total = 0UL;
+        u32Previous = 0UL;
+        for(u32Bucket = 0UL; u32Bucket < u32Buckets; u32Bucket++)
+        {
+            HSE_TEST_CHECK(pIn[0] < HSE_STATS_NUM_BUCKETS);
+            HSE_TEST_CHECK((0UL == u32Bucket) || (pIn[0] > u32Previous));
+            HSE_TEST_CHECK(0UL != Get32(&pIn[1]));
+            if(0UL == u32Bucket)
+            {
+                HSE_TEST_CHECK((HSE_StatsBucketLowerUs(pIn[0]) <= u32MinUs) && (u32MinUs <= HSE_StatsBucketUpperUs(pIn[0])));
+            }
+            if((u32Buckets - 1UL) == u32Bucket)
+            {
+                HSE_TEST_CHECK((HSE_StatsBucketLowerUs(pIn[0]) <= u32MaxUs) && (u32MaxUs <= HSE_StatsBucketUpperUs(pIn[0])));
+            }
+            u32Previous = pIn[0];
+            u32Total += Get32(&pIn[1]);
+            pIn += HSE_STATS_EXPORT_BUCKET_SIZE;
+        }
+        HSE_TEST_CHECK(u32Count == u32Total);
+
+        if((uint32_t)HSE_SRV_ID_HASH == u32SrvId)
+        {
+            bHashFound = TRUE;
+            HSE_TEST_CHECK_RSP(HSE_StatsGet(HSE_SRV_ID_HASH, &summary), HSE_SRV_RSP_OK);
+            HSE_TEST_CHECK(summary.u32Count == u32Count);
+            HSE_TEST_CHECK(summary.u32Errors == u32Errors);
+            HSE_TEST_CHECK((summary.u32MinUs == u32MinUs) && (summary.u32MaxUs == u32MaxUs));
+        }
+    }
+    HSE_TEST_CHECK(bHashFound);
+    HSE_TEST_CHECK((uint32_t)(pIn - exportBuffer) == u32Length);
+
+    /* Reset: no service left */
+    HSE_StatsReset();
+    u32Length = sizeof(exportBuffer);
+    HSE_TEST_CHECK_RSP(HSE_StatsExport(exportBuffer, &u32Length), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(HSE_STATS_EXPORT_HEADER_SIZE == u32Length);
+    HSE_TEST_CHECK(0U == exportBuffer[3]);
+}
+
+int main(void)
+{
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+
+    TestBuckets();
+    TestGet();
+    TestExport();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
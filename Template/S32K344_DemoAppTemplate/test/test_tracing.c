@@ -0,0 +1,216 @@
+/**
+*   @file    test_tracing.c
+*
+*   @brief   Host test of the request trace ring (HSE_TRACING, virtual HSE).
+*   @details Runs 8 SHA-256 requests and 4 GET_RANDOM_NUM requests (one failing) and checks the
+*            records, then two warm resets (HSE_TraceInit on a valid ring), the second one with an
+*            asynchronous request in progress that must be marked HSE_TRACE_RSP_RESET. The ring is
+*            written to the file given as argument for the hse_trace_decode test.
+*            Usage: test_tracing [dump file].
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_channel_mgr.h"
+#include "hse_host_hash.h"
+#include "hse_mu.h"
+#include "hse_tracing.h"
+
+#ifndef HSE_TRACING
+#error "test_tracing must be built with HSE_TRACING"
+#endif
+
+#define HSE_TEST_HASHES             (8UL)
+#define HSE_TEST_RANDOMS            (4UL)
+#define HSE_TEST_HASH_LATENCY_US    (100UL)
+/* Long enough for the ring to be dumped while the request is in progress */
+#define HSE_TEST_PENDING_US         (100000UL)
+#define HSE_TEST_DEADLINE_US        (10000000ULL)
+
+/* Read and written by the HSE */
+static uint8_t input[256];
+static uint8_t digest[32];
+static uint8_t randomBuf[32];
+static uint8_t asyncRandomBuf[32];
+
+static atomic_bool bAsyncDone;
+
+static void AsyncCallback(hseSrvResponse_t status, void* pArg)
+{
+    (void)status;
+    (void)pArg;
+    atomic_store(&bAsyncDone, TRUE);
+}
+
+static void BuildRandomReq(hseSrvDescriptor_t* pHseSrvDesc, uint8_t* pRandom, uint32_t u32Length)
+{
+    memset(pHseSrvDesc, 0, sizeof(hseSrvDescriptor_t));
+    pHseSrvDesc->srvId = HSE_SRV_ID_GET_RANDOM_NUM;
+    pHseSrvDesc->hseSrv.getRandomNumReq.rngClass = HSE_RNG_CLASS_PTG3;
+    pHseSrvDesc->hseSrv.getRandomNumReq.randomNumLength = u32Length;
+    pHseSrvDesc->hseSrv.getRandomNumReq.pRandomNum = HSE_PTR_TO_HOST_ADDR(pRandom);
+}
+
+/* Synchronous requests: one record each, in submission order */
+static void TestRecords(void)
+{
+    const hseTraceRecord_t* pRecord;
+    uint32_t u32HashLength;
+    uint8_t u8Channel;
+    uint32_t i;
+
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, HSE_TEST_HASH_LATENCY_US, 0UL), HSE_SRV_RSP_OK);
+    for(i = 0UL; i < HSE_TEST_HASHES; i++)
+    {
+        u32HashLength = sizeof(digest);
+        HSE_TEST_CHECK_RSP(HashDataCtx(&gHseDefaultCtx, HSE_HASH_ALGO_SHA2_256, sizeof(input), input, &u32HashLength,
+                                       digest, HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    }
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_HASH, 0UL, 0UL), HSE_SRV_RSP_OK);
+
+    /* The last random number request fails */
+    for(i = 0UL; i < HSE_TEST_RANDOMS; i++)
+    {
+        if((HSE_TEST_RANDOMS - 1UL) == i)
+        {
+            HSE_VirtualInjectResponse(HSE_SRV_ID_GET_RANDOM_NUM, HSE_SRV_RSP_NOT_ALLOWED, 1UL);
+        }
+        u8Channel = HSE_ChannelClaim(0U);
+        HSE_TEST_CHECK(HSE_INVALID_CHANNEL != u8Channel);
+        if(HSE_INVALID_CHANNEL == u8Channel)
+        {
+            return;
+        }
+        BuildRandomReq(&gHseSrvDesc[0U][u8Channel], randomBuf, sizeof(randomBuf));
+        HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, gSyncTxOption, &gHseSrvDesc[0U][u8Channel],
+                                             HSE_WAIT_DEFAULT_TIMEOUT_US),
+                           ((HSE_TEST_RANDOMS - 1UL) == i) ? HSE_SRV_RSP_NOT_ALLOWED : HSE_SRV_RSP_OK);
+        HSE_ChannelRelease(0U, u8Channel);
+    }
+
+    HSE_TEST_CHECK((HSE_TEST_HASHES + HSE_TEST_RANDOMS) == (uint32_t)atomic_load(&gHseTraceRing.u32Head));
+    for(i = 0UL; i < (HSE_TEST_HASHES + HSE_TEST_RANDOMS); i++)
+    {
+        pRecord = &gHseTraceRing.records[i];
+        HSE_TEST_CHECK((0U == pRecord->u8MuInstance) && (pRecord->u8Channel < HSE_NUM_OF_CHANNELS_PER_MU));
+        HSE_TEST_CHECK(0U == pRecord->u16Boot);
+        HSE_TEST_CHECK(pRecord->u32ResponseUs >= pRecord->u32SubmitUs);
+        if(i < HSE_TEST_HASHES)
+        {
+            HSE_TEST_CHECK((uint32_t)HSE_SRV_ID_HASH == pRecord->u32SrvId);
+            HSE_TEST_CHECK((uint32_t)HSE_SRV_RSP_OK == pRecord->u32Response);
+            HSE_TEST_CHECK((pRecord->u32ResponseUs - pRecord->u32SubmitUs) >= HSE_TEST_HASH_LATENCY_US);
+        }
+        else
+        {
+            HSE_TEST_CHECK((uint32_t)HSE_SRV_ID_GET_RANDOM_NUM == pRecord->u32SrvId);
+            HSE_TEST_CHECK((uint32_t)(((HSE_TEST_HASHES + HSE_TEST_RANDOMS - 1UL) == i) ?
+                           HSE_SRV_RSP_NOT_ALLOWED : HSE_SRV_RSP_OK) == pRecord->u32Response);
+        }
+    }
+}
+
+/* A warm reset keeps the records; the one in progress is marked as interrupted */
+static void TestWarmReset(const char* pDumpFile)
+{
+    uint32_t u32Records = HSE_TEST_HASHES + HSE_TEST_RANDOMS;
+    hseTxOptions_t txOptions;
+    uint32_t u32IrqEnabled;
+    uint64_t u64Deadline;
+    uint8_t u8Channel;
+    FILE* pFile;
+
+    /* Nothing in progress: only the boot count changes */
+    HSE_TraceInit();
+    HSE_TEST_CHECK(1UL == gHseTraceRing.u32Boots);
+    HSE_TEST_CHECK(u32Records == (uint32_t)atomic_load(&gHseTraceRing.u32Head));
+    HSE_TEST_CHECK((uint32_t)HSE_SRV_RSP_OK == gHseTraceRing.records[0].u32Response);
+
+    /* An asynchronous request still running at the reset */
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, HSE_TEST_PENDING_US, 0UL), HSE_SRV_RSP_OK);
+    u8Channel = HSE_ChannelClaim(0U);
+    HSE_TEST_CHECK(HSE_INVALID_CHANNEL != u8Channel);
+    if(HSE_INVALID_CHANNEL == u8Channel)
+    {
+        return;
+    }
+    u32IrqEnabled = (1UL << u8Channel) & ~muRxEnabledInterruptMask[0];
+    HSE_MU_EnableInterrupts(0U, HSE_INT_RESPONSE, u32IrqEnabled);
+    atomic_store(&bAsyncDone, FALSE);
+    BuildRandomReq(&gHseSrvDesc[0U][u8Channel], asyncRandomBuf, sizeof(asyncRandomBuf));
+    txOptions.txOp            = HSE_TX_ASYNCHRONOUS;
+    txOptions.pfAsyncCallback = AsyncCallback;
+    txOptions.pCallbackpArg   = NULL;
+    HSE_TEST_CHECK_RSP(HSE_SendOnClaimed(0U, u8Channel, txOptions, &gHseSrvDesc[0U][u8Channel],
+                                         HSE_WAIT_DEFAULT_TIMEOUT_US), HSE_SRV_RSP_OK);
+    HSE_TraceInit();
+    HSE_TEST_CHECK(!atomic_load(&bAsyncDone));
+    HSE_TEST_CHECK(2UL == gHseTraceRing.u32Boots);
+    HSE_TEST_CHECK((u32Records + 1UL) == (uint32_t)atomic_load(&gHseTraceRing.u32Head));
+    HSE_TEST_CHECK(HSE_TRACE_RSP_RESET == gHseTraceRing.records[u32Records].u32Response);
+    HSE_TEST_CHECK(1U == gHseTraceRing.records[u32Records].u16Boot);
+
+    /* The dump read by the decoder */
+    pFile = fopen(pDumpFile, "wb");
+    HSE_TEST_CHECK(NULL != pFile);
+    if(NULL != pFile)
+    {
+        HSE_TEST_CHECK(1U == fwrite(&gHseTraceRing, sizeof(gHseTraceRing), 1U, pFile));
+        HSE_TEST_CHECK(0 == fclose(pFile));
+    }
+
+    u64Deadline = HSE_TestNowUs() + HSE_TEST_DEADLINE_US;
+    while((!atomic_load(&bAsyncDone)) && (HSE_TestNowUs() < u64Deadline))
+    {
+        (void)sched_yield();
+    }
+    HSE_TEST_CHECK(atomic_load(&bAsyncDone));
+    HSE_MU_DisableInterrupts(0U, HSE_INT_RESPONSE, u32IrqEnabled);
+    HSE_TEST_CHECK_RSP(HSE_VirtualSetLatency(HSE_SRV_ID_GET_RANDOM_NUM, 0UL, 0UL), HSE_SRV_RSP_OK);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* pDumpFile = (argc > 1) ? argv[1] : "trace.bin";
+    uint32_t i;
+
+    if(HSE_SRV_RSP_OK != HSE_VirtualInit())
+    {
+        return EXIT_FAILURE;
+    }
+    for(i = 0UL; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)i;
+    }
+
+    /* Cold start: the ring is not valid yet */
+    HSE_TraceInit();
+    HSE_TEST_CHECK(HSE_TRACE_MAGIC == gHseTraceRing.u32Magic);
+    HSE_TEST_CHECK((0UL == gHseTraceRing.u32Boots) && (0U == atomic_load(&gHseTraceRing.u32Head)));
+
+    TestRecords();
+    TestWarmReset(pDumpFile);
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
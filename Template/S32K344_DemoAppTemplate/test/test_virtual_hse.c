@@ -0,0 +1,95 @@
+/**
+*   @file    test_virtual_hse.c
+*
+*   @brief   Host test of the virtual HSE: the framework helpers against known answers.
+*
+*   @addtogroup HSE_VIRTUAL HSE VIRTUAL
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#include <string.h>
+#include <openssl/evp.h>
+#include "hse_test.h"
+#include "hse_virtual.h"
+#include "hse_host.h"
+#include "hse_host_hash.h"
+#include "hse_host_cipher.h"
+#include "hse_host_import_key.h"
+#include "hse_host_rng.h"
+
+/* FIPS-197 C.1 */
+static const uint8_t aes128Key[16] =
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const uint8_t aes128Plain[16] =
+    { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+static const uint8_t aes128Cipher[16] =
+    { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+static void TestHash(void)
+{
+    uint8_t input[1000];
+    uint8_t digest[64];
+    uint8_t expected[64];
+    uint32_t digestLength = sizeof(digest);
+    uint32_t i;
+
+    for(i = 0UL; i < sizeof(input); i++)
+    {
+        input[i] = (uint8_t)i;
+    }
+    HSE_TEST_CHECK_RSP(HashDataDefSrv(HSE_HASH_ALGO_SHA2_256, sizeof(input), input, &digestLength, digest,
+                                      HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(1 == EVP_Digest(input, sizeof(input), expected, NULL, EVP_sha256(), NULL));
+    HSE_TEST_CHECK(32UL == digestLength);
+    HSE_TEST_CHECK(0 == memcmp(digest, expected, 32U));
+}
+
+static void TestAes(void)
+{
+    const hseKeyHandle_t keyHandle = GET_KEY_HANDLE(HSE_KEY_CATALOG_ID_RAM, 0U, 0U);
+    uint8_t output[16];
+
+    HSE_TEST_CHECK_RSP(ImportPlainSymKeyReq(keyHandle, HSE_KEY_TYPE_AES,
+                                            HSE_KF_USAGE_ENCRYPT | HSE_KF_USAGE_DECRYPT,
+                                            sizeof(aes128Key), aes128Key, 0U), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK_RSP(AesEncrypt(keyHandle, HSE_CIPHER_BLOCK_MODE_ECB, NULL, sizeof(aes128Plain), aes128Plain,
+                                  output, HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(output, aes128Cipher, sizeof(output)));
+    HSE_TEST_CHECK_RSP(AesDecrypt(keyHandle, HSE_CIPHER_BLOCK_MODE_ECB, NULL, sizeof(aes128Cipher), aes128Cipher,
+                                  output, HSE_SGT_OPTION_NONE), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 == memcmp(output, aes128Plain, sizeof(output)));
+}
+
+static void TestRng(void)
+{
+    uint8_t random[32] = { 0U };
+    uint8_t zero[32] = { 0U };
+
+    HSE_TEST_CHECK_RSP(GetRngNum(random, sizeof(random), HSE_RNG_CLASS_PTG3), HSE_SRV_RSP_OK);
+    HSE_TEST_CHECK(0 != memcmp(random, zero, sizeof(random)));
+}
+
+int main(void)
+{
+    HSE_TEST_CHECK_RSP(HSE_VirtualInit(), HSE_SRV_RSP_OK);
+
+    TestHash();
+    TestAes();
+    TestRng();
+
+    HSE_VirtualDeinit();
+    return HSE_TEST_RESULT();
+}
+
+/** @} */
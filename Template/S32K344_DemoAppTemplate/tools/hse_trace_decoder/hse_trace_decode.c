@@ -0,0 +1,341 @@
+/**
+*   @file    hse_trace_decode.c
+*
+*   @version 1.0.0
+*   @brief   Host decoder of the HSE trace ring (HSE_TRACING).
+*   @details Reads a binary memory dump of gHseTraceRing and prints per-service latency tables
+*            and, optionally, the records in submission order.
+*
+*            Dump (e.g. GDB):  dump binary memory trace.bin &gHseTraceRing (char*)&gHseTraceRing + sizeof(gHseTraceRing)
+*            Build (host):     target hse_trace_decode of the host CMake build (ctest decodes the dump
+*                              written by test/test_tracing), or gcc -std=gnu11 -I../../interface
+*                              -I../../interface/config -I../../interface/inc_common -I../../interface/inc_services
+*                              -I../../interface/inc_custom -I../../framework/host_hse -I../../drivers/mu
+*                              -o hse_trace_decode hse_trace_decode.c
+*            Run:              hse_trace_decode trace.bin [-v]
+*
+*   @addtogroup hse_tracing
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           hse_trace_decode.c
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hse_host.h"
+#include "hse_tracing.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Latencies of one service
+ */
+typedef struct
+{
+    uint32_t    u32SrvId;
+    uint32_t    u32Count;           /**< @brief    Completed requests (latency known). */
+    uint32_t    u32Errors;          /**< @brief    Completed with a response other than OK. */
+    uint32_t    u32Pending;         /**< @brief    Not completed (in progress when dumped). */
+    uint32_t    u32Reset;           /**< @brief    Interrupted by a reset. */
+    uint64_t    u64TotalUs;
+    uint32_t*   pLatencies;
+} hseTraceSrvStats_t;
+
+/*
+ * @brief   Service name
+ */
+typedef struct
+{
+    hseSrvId_t      srvId;
+    const char*     pName;
+} hseTraceSrvName_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define HSE_TRACE_SRV_NAME(name)    { HSE_SRV_ID_##name, #name }
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+static const hseTraceSrvName_t srvNames[] =
+{
+    HSE_TRACE_SRV_NAME(SET_ATTR),
+    HSE_TRACE_SRV_NAME(GET_ATTR),
+    HSE_TRACE_SRV_NAME(CANCEL),
+    HSE_TRACE_SRV_NAME(FIRMWARE_UPDATE),
+    HSE_TRACE_SRV_NAME(SYS_AUTH_REQ),
+    HSE_TRACE_SRV_NAME(SYS_AUTH_RESP),
+    HSE_TRACE_SRV_NAME(IMPORT_EXPORT_STREAM_CTX),
+    HSE_TRACE_SRV_NAME(ACTIVATE_PASSIVE_BLOCK),
+    HSE_TRACE_SRV_NAME(CONFIG_COUNTER),
+    HSE_TRACE_SRV_NAME(FW_INTEGRITY_CHECK),
+    HSE_TRACE_SRV_NAME(PUBLISH_NVM_KEYSTORE_RAM_TO_FLASH),
+    HSE_TRACE_SRV_NAME(LOAD_ECC_CURVE),
+    HSE_TRACE_SRV_NAME(FORMAT_KEY_CATALOGS),
+    HSE_TRACE_SRV_NAME(ERASE_KEY),
+    HSE_TRACE_SRV_NAME(GET_KEY_INFO),
+    HSE_TRACE_SRV_NAME(IMPORT_KEY),
+    HSE_TRACE_SRV_NAME(EXPORT_KEY),
+    HSE_TRACE_SRV_NAME(KEY_GENERATE),
+    HSE_TRACE_SRV_NAME(DH_COMPUTE_SHARED_SECRET),
+    HSE_TRACE_SRV_NAME(KEY_DERIVE),
+    HSE_TRACE_SRV_NAME(KEY_DERIVE_COPY),
+    HSE_TRACE_SRV_NAME(SHE_LOAD_KEY),
+    HSE_TRACE_SRV_NAME(SHE_LOAD_PLAIN_KEY),
+    HSE_TRACE_SRV_NAME(SHE_EXPORT_RAM_KEY),
+    HSE_TRACE_SRV_NAME(SHE_GET_ID),
+    HSE_TRACE_SRV_NAME(SHE_BOOT_OK),
+    HSE_TRACE_SRV_NAME(SHE_BOOT_FAILURE),
+    HSE_TRACE_SRV_NAME(HASH),
+    HSE_TRACE_SRV_NAME(MAC),
+    HSE_TRACE_SRV_NAME(FAST_CMAC),
+    HSE_TRACE_SRV_NAME(SYM_CIPHER),
+    HSE_TRACE_SRV_NAME(AEAD),
+    HSE_TRACE_SRV_NAME(SIGN),
+    HSE_TRACE_SRV_NAME(RSA_CIPHER),
+    HSE_TRACE_SRV_NAME(GET_RANDOM_NUM),
+    HSE_TRACE_SRV_NAME(INCREMENT_COUNTER),
+    HSE_TRACE_SRV_NAME(READ_COUNTER),
+    HSE_TRACE_SRV_NAME(SMR_ENTRY_INSTALL),
+    HSE_TRACE_SRV_NAME(SMR_VERIFY),
+    HSE_TRACE_SRV_NAME(CORE_RESET_ENTRY_INSTALL),
+};
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static hseTraceRing_t           traceRing;
+static hseTraceSrvStats_t       srvStats[NUMBER_OF_REQ];
+static uint32_t                 u32SrvCount;
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static const char* HSE_TraceSrvName(uint32_t u32SrvId);
+static const char* HSE_TraceRspName(uint32_t u32Response);
+static hseTraceSrvStats_t* HSE_TraceGetStats(uint32_t u32SrvId);
+static int HSE_TraceCompareU32(const void* pA, const void* pB);
+static uint32_t HSE_TracePercentile(const hseTraceSrvStats_t* pStats, uint32_t u32Percent);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static const char* HSE_TraceSrvName(uint32_t u32SrvId)
+{
+    uint32_t u32Index;
+
+    for(u32Index = 0UL; u32Index < (sizeof(srvNames) / sizeof(srvNames[0])); u32Index++)
+    {
+        if(u32SrvId == (uint32_t)srvNames[u32Index].srvId)
+        {
+            return srvNames[u32Index].pName;
+        }
+    }
+    return "?";
+}
+
+static const char* HSE_TraceRspName(uint32_t u32Response)
+{
+    switch(u32Response)
+    {
+        case HSE_TRACE_RSP_PENDING:                     return "PENDING";
+        case HSE_TRACE_RSP_RESET:                       return "RESET";
+        case (uint32_t)HSE_SRV_RSP_OK:                  return "OK";
+        case (uint32_t)HSE_SRV_RSP_VERIFY_FAILED:       return "VERIFY_FAILED";
+        case (uint32_t)HSE_SRV_RSP_INVALID_ADDR:        return "INVALID_ADDR";
+        case (uint32_t)HSE_SRV_RSP_INVALID_PARAM:       return "INVALID_PARAM";
+        case (uint32_t)HSE_SRV_RSP_NOT_SUPPORTED:       return "NOT_SUPPORTED";
+        case (uint32_t)HSE_SRV_RSP_NOT_ALLOWED:         return "NOT_ALLOWED";
+        case (uint32_t)HSE_SRV_RSP_NOT_ENOUGH_SPACE:    return "NOT_ENOUGH_SPACE";
+        case (uint32_t)HSE_SRV_RSP_KEY_NOT_AVAILABLE:   return "KEY_NOT_AVAILABLE";
+        case (uint32_t)HSE_SRV_RSP_KEY_INVALID:         return "KEY_INVALID";
+        case (uint32_t)HSE_SRV_RSP_KEY_EMPTY:           return "KEY_EMPTY";
+        case (uint32_t)HSE_SRV_RSP_CANCELED:            return "CANCELED";
+        case (uint32_t)HSE_SRV_RSP_HOST_TIMEOUT:        return "HOST_TIMEOUT";
+        case (uint32_t)HSE_SRV_RSP_GENERAL_ERROR:       return "GENERAL_ERROR";
+        default:                                        return "ERROR";
+    }
+}
+
+static hseTraceSrvStats_t* HSE_TraceGetStats(uint32_t u32SrvId)
+{
+    uint32_t u32Index;
+
+    for(u32Index = 0UL; u32Index < u32SrvCount; u32Index++)
+    {
+        if(u32SrvId == srvStats[u32Index].u32SrvId)
+        {
+            return &srvStats[u32Index];
+        }
+    }
+
+    srvStats[u32SrvCount].u32SrvId = u32SrvId;
+    srvStats[u32SrvCount].pLatencies = (uint32_t*)calloc(NUMBER_OF_REQ, sizeof(uint32_t));
+    return &srvStats[u32SrvCount++];
+}
+
+static int HSE_TraceCompareU32(const void* pA, const void* pB)
+{
+    uint32_t u32A = *(const uint32_t*)pA;
+    uint32_t u32B = *(const uint32_t*)pB;
+
+    return (u32A > u32B) - (u32A < u32B);
+}
+
+/* Nearest-rank percentile of the sorted latencies */
+static uint32_t HSE_TracePercentile(const hseTraceSrvStats_t* pStats, uint32_t u32Percent)
+{
+    uint32_t u32Rank = ((pStats->u32Count * u32Percent) + 99UL) / 100UL;
+
+    return pStats->pLatencies[(0UL == u32Rank) ? 0UL : (u32Rank - 1UL)];
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+int main(int argc, char* argv[])
+{
+    const hseTraceRecord_t* pRecord;
+    hseTraceSrvStats_t* pStats;
+    FILE* pFile;
+    uint32_t u32Head;
+    uint32_t u32Valid;
+    uint32_t u32Seq;
+    uint32_t u32LatencyUs;
+    uint32_t u32Index;
+    int verbose = ((argc > 2) && (0 == strcmp(argv[2], "-v")));
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s <gHseTraceRing dump> [-v]\n", argv[0]);
+        return 2;
+    }
+
+    pFile = fopen(argv[1], "rb");
+    if(NULL == pFile)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if(1U != fread(&traceRing, sizeof(traceRing), 1U, pFile))
+    {
+        fprintf(stderr, "%s: expected %u bytes\n", argv[1], (unsigned int)sizeof(traceRing));
+        fclose(pFile);
+        return 1;
+    }
+    fclose(pFile);
+
+    if((HSE_TRACE_MAGIC != traceRing.u32Magic) || (HSE_TRACE_VERSION != traceRing.u32Version) ||
+       (NUMBER_OF_REQ != traceRing.u32Capacity) || (sizeof(hseTraceRecord_t) != traceRing.u32RecordSize))
+    {
+        fprintf(stderr, "%s: not a trace ring (magic 0x%08x, version %u, capacity %u, record %u bytes)\n",
+                argv[1], traceRing.u32Magic, traceRing.u32Version, traceRing.u32Capacity, traceRing.u32RecordSize);
+        return 1;
+    }
+
+    u32Head = (uint32_t)atomic_load(&traceRing.u32Head);
+    u32Valid = (u32Head < NUMBER_OF_REQ) ? u32Head : NUMBER_OF_REQ;
+    printf("%u requests traced, last %u kept, %u warm reset(s)\n\n", u32Head, u32Valid, traceRing.u32Boots);
+
+    if(verbose)
+    {
+        printf("%10s %5s %3s %3s %-28s %10s %10s  %s\n", "seq", "boot", "mu", "ch", "service", "submit_us", "latency_us", "response");
+    }
+
+    /* Oldest to newest */
+    for(u32Seq = u32Head - u32Valid; u32Seq != u32Head; u32Seq++)
+    {
+        pRecord = &traceRing.records[u32Seq & (NUMBER_OF_REQ - 1U)];
+        pStats = HSE_TraceGetStats(pRecord->u32SrvId);
+        u32LatencyUs = pRecord->u32ResponseUs - pRecord->u32SubmitUs;
+
+        if(HSE_TRACE_RSP_PENDING == pRecord->u32Response)
+        {
+            pStats->u32Pending++;
+        }
+        else if(HSE_TRACE_RSP_RESET == pRecord->u32Response)
+        {
+            pStats->u32Reset++;
+        }
+        else
+        {
+            if((uint32_t)HSE_SRV_RSP_OK != pRecord->u32Response)
+            {
+                pStats->u32Errors++;
+            }
+            pStats->pLatencies[pStats->u32Count++] = u32LatencyUs;
+            pStats->u64TotalUs += u32LatencyUs;
+        }
+
+        if(verbose)
+        {
+            printf("%10u %5u %3u %3u %-28s %10u ", u32Seq, pRecord->u16Boot, pRecord->u8MuInstance, pRecord->u8Channel,
+                   HSE_TraceSrvName(pRecord->u32SrvId), pRecord->u32SubmitUs);
+            if((HSE_TRACE_RSP_PENDING == pRecord->u32Response) || (HSE_TRACE_RSP_RESET == pRecord->u32Response))
+            {
+                printf("%10s  %s\n", "-", HSE_TraceRspName(pRecord->u32Response));
+            }
+            else
+            {
+                printf("%10u  %s (0x%08x)\n", u32LatencyUs, HSE_TraceRspName(pRecord->u32Response), pRecord->u32Response);
+            }
+        }
+    }
+    if(verbose)
+    {
+        printf("\n");
+    }
+
+    printf("%-28s %10s %6s %6s %6s %6s %8s %8s %8s %8s %8s\n", "service", "srvId", "count", "errors", "pend",
+           "reset", "min_us", "avg_us", "p50_us", "p99_us", "max_us");
+    for(u32Index = 0UL; u32Index < u32SrvCount; u32Index++)
+    {
+        pStats = &srvStats[u32Index];
+        printf("%-28s 0x%08x %6u %6u %6u %6u ", HSE_TraceSrvName(pStats->u32SrvId), pStats->u32SrvId,
+               pStats->u32Count, pStats->u32Errors, pStats->u32Pending, pStats->u32Reset);
+        if(0UL == pStats->u32Count)
+        {
+            printf("%8s %8s %8s %8s %8s\n", "-", "-", "-", "-", "-");
+        }
+        else
+        {
+            qsort(pStats->pLatencies, pStats->u32Count, sizeof(uint32_t), HSE_TraceCompareU32);
+            printf("%8u %8u %8u %8u %8u\n", pStats->pLatencies[0], (uint32_t)(pStats->u64TotalUs / pStats->u32Count),
+                   HSE_TracePercentile(pStats, 50UL), HSE_TracePercentile(pStats, 99UL),
+                   pStats->pLatencies[pStats->u32Count - 1UL]);
+        }
+        free(pStats->pLatencies);
+    }
+
+    return 0;
+}
+
+/** @} */
@@ -0,0 +1,325 @@
+/**
+*   @file    she_mup.c
+*
+*   @version 1.0.0
+*   @brief   Host computation of the SHE memory update protocol messages.
+*   @details Same steps as MemoryUpdateProtocol() (hse_memory_update_protocol.c), without the HSE.
+*
+*   @addtogroup she_mup_generator
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           she_mup.c
+*/
+#include <string.h>
+#include "she_mup.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define SHE_MUP_AES_ROUNDS          (10U)
+
+/* Multiplication by x in GF(2^8) */
+#define SHE_MUP_XTIME(b)            ((uint8_t)(((b) << 1U) ^ ((0U != ((b) & 0x80U)) ? 0x1BU : 0x00U)))
+
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+
+static const uint8_t sheMupSbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const uint8_t sheMupRcon[SHE_MUP_AES_ROUNDS] =
+{
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
+};
+
+/* SHE key derivation constants (padding of the 256-bit KDF input included) */
+static const uint8_t KEY_UPDATE_ENC_C[AES_BLOCK_SIZE] =
+{ 0x01, 0x01, 0x53, 0x48, 0x45, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB0 };
+static const uint8_t KEY_UPDATE_MAC_C[AES_BLOCK_SIZE] =
+{ 0x01, 0x02, 0x53, 0x48, 0x45, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB0 };
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static void SheMup_Xor(uint8_t* pDst, const uint8_t* pSrc);
+static void SheMup_CmacSubkey(uint8_t* pKey);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static void SheMup_Xor(uint8_t* pDst, const uint8_t* pSrc)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < AES_BLOCK_SIZE; i++)
+    {
+        pDst[i] ^= pSrc[i];
+    }
+}
+
+/* CMAC subkey doubling: K << 1, xor 0x87 if the MSB was set */
+static void SheMup_CmacSubkey(uint8_t* pKey)
+{
+    uint8_t u8Msb = pKey[0] & 0x80U;
+    uint32_t i;
+
+    for(i = 0UL; i < (AES_BLOCK_SIZE - 1UL); i++)
+    {
+        pKey[i] = (uint8_t)((pKey[i] << 1U) | (pKey[i + 1UL] >> 7U));
+    }
+    pKey[AES_BLOCK_SIZE - 1UL] = (uint8_t)(pKey[AES_BLOCK_SIZE - 1UL] << 1U);
+    if(0U != u8Msb)
+    {
+        pKey[AES_BLOCK_SIZE - 1UL] ^= 0x87U;
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : AES-128 block encryption (FIPS-197).
+ ******************************************************************************/
+void SheMup_AesEncrypt(const uint8_t* pKey, const uint8_t* pIn, uint8_t* pOut)
+{
+    uint8_t roundKey[(SHE_MUP_AES_ROUNDS + 1U) * AES_BLOCK_SIZE];
+    uint8_t state[AES_BLOCK_SIZE];
+    uint8_t tmp[AES_BLOCK_SIZE];
+    uint8_t t;
+    uint32_t round;
+    uint32_t c;
+    uint32_t i;
+
+    /* Key expansion */
+    memcpy(roundKey, pKey, AES_BLOCK_SIZE);
+    for(i = AES_BLOCK_SIZE; i < sizeof(roundKey); i += 4UL)
+    {
+        tmp[0] = roundKey[i - 4UL];
+        tmp[1] = roundKey[i - 3UL];
+        tmp[2] = roundKey[i - 2UL];
+        tmp[3] = roundKey[i - 1UL];
+        if(0UL == (i % AES_BLOCK_SIZE))
+        {
+            /* RotWord, SubWord, Rcon */
+            t      = tmp[0];
+            tmp[0] = sheMupSbox[tmp[1]] ^ sheMupRcon[(i / AES_BLOCK_SIZE) - 1UL];
+            tmp[1] = sheMupSbox[tmp[2]];
+            tmp[2] = sheMupSbox[tmp[3]];
+            tmp[3] = sheMupSbox[t];
+        }
+        for(c = 0UL; c < 4UL; c++)
+        {
+            roundKey[i + c] = roundKey[i + c - AES_BLOCK_SIZE] ^ tmp[c];
+        }
+    }
+
+    memcpy(state, pIn, AES_BLOCK_SIZE);
+    SheMup_Xor(state, roundKey);
+    for(round = 1UL; round <= SHE_MUP_AES_ROUNDS; round++)
+    {
+        /* SubBytes and ShiftRows (state is column-major: byte r of column c at 4c + r) */
+        for(c = 0UL; c < 4UL; c++)
+        {
+            for(i = 0UL; i < 4UL; i++)
+            {
+                tmp[(4UL * c) + i] = sheMupSbox[state[(4UL * ((c + i) & 3UL)) + i]];
+            }
+        }
+        /* MixColumns, except in the last round */
+        if(SHE_MUP_AES_ROUNDS != round)
+        {
+            for(c = 0UL; c < 4UL; c++)
+            {
+                uint8_t* pCol = &tmp[4UL * c];
+                t = pCol[0] ^ pCol[1] ^ pCol[2] ^ pCol[3];
+                state[(4UL * c) + 0UL] = pCol[0] ^ t ^ SHE_MUP_XTIME(pCol[0] ^ pCol[1]);
+                state[(4UL * c) + 1UL] = pCol[1] ^ t ^ SHE_MUP_XTIME(pCol[1] ^ pCol[2]);
+                state[(4UL * c) + 2UL] = pCol[2] ^ t ^ SHE_MUP_XTIME(pCol[2] ^ pCol[3]);
+                state[(4UL * c) + 3UL] = pCol[3] ^ t ^ SHE_MUP_XTIME(pCol[3] ^ pCol[0]);
+            }
+        }
+        else
+        {
+            memcpy(state, tmp, AES_BLOCK_SIZE);
+        }
+        SheMup_Xor(state, &roundKey[round * AES_BLOCK_SIZE]);
+    }
+    memcpy(pOut, state, AES_BLOCK_SIZE);
+}
+
+/*******************************************************************************
+ * Description   : AES-128 CMAC (NIST SP 800-38B).
+ ******************************************************************************/
+void SheMup_Cmac(const uint8_t* pKey, const uint8_t* pMsg, uint32_t u32Length, uint8_t* pMac)
+{
+    uint8_t subkey[AES_BLOCK_SIZE] = { 0U };
+    uint8_t last[AES_BLOCK_SIZE] = { 0U };
+    uint8_t x[AES_BLOCK_SIZE] = { 0U };
+    uint32_t u32Blocks = (u32Length + AES_BLOCK_SIZE - 1UL) / AES_BLOCK_SIZE;
+    uint32_t u32LastLength;
+    uint32_t i;
+
+    /* K1, and K2 if the last block is incomplete */
+    SheMup_AesEncrypt(pKey, subkey, subkey);
+    SheMup_CmacSubkey(subkey);
+    if(0UL == u32Blocks)
+    {
+        u32Blocks = 1UL;
+    }
+    u32LastLength = u32Length - ((u32Blocks - 1UL) * AES_BLOCK_SIZE);
+    if(AES_BLOCK_SIZE != u32LastLength)
+    {
+        SheMup_CmacSubkey(subkey);
+        last[u32LastLength] = 0x80U;
+    }
+    if(0UL != u32LastLength)
+    {
+        memcpy(last, &pMsg[(u32Blocks - 1UL) * AES_BLOCK_SIZE], u32LastLength);
+    }
+    SheMup_Xor(last, subkey);
+
+    for(i = 0UL; i < (u32Blocks - 1UL); i++)
+    {
+        SheMup_Xor(x, &pMsg[i * AES_BLOCK_SIZE]);
+        SheMup_AesEncrypt(pKey, x, x);
+    }
+    SheMup_Xor(x, last);
+    SheMup_AesEncrypt(pKey, x, pMac);
+}
+
+/*******************************************************************************
+ * Description   : SHE KDF: Miyaguchi-Preneel over the two blocks pKey | pConstant.
+ *                 H0 = 0, Hi = AES(Hi-1, xi) ^ xi ^ Hi-1.
+ ******************************************************************************/
+void SheMup_Kdf(const uint8_t* pKey, const uint8_t* pConstant, uint8_t* pOut)
+{
+    uint8_t h[AES_BLOCK_SIZE] = { 0U };
+    uint8_t e[AES_BLOCK_SIZE];
+
+    SheMup_AesEncrypt(h, pKey, e);
+    SheMup_Xor(e, pKey);
+    SheMup_Xor(h, e);
+
+    SheMup_AesEncrypt(h, pConstant, e);
+    SheMup_Xor(e, pConstant);
+    SheMup_Xor(h, e);
+
+    memcpy(pOut, h, AES_BLOCK_SIZE);
+}
+
+/*******************************************************************************
+ * Description   : M1-M5 of a SHE key load (SHE memory update protocol).
+ ******************************************************************************/
+void SheMup_Generate(const MemoryUpdate_t* pMemUpdate, MemoryUpdateRecord_t* pRecord)
+{
+    uint8_t K1[AES_BLOCK_SIZE];
+    uint8_t K2[AES_BLOCK_SIZE];
+    uint8_t K3[AES_BLOCK_SIZE];
+    uint8_t K4[AES_BLOCK_SIZE];
+    uint8_t M2_t[AES_BLOCK_SIZE * 2];
+    uint8_t M3_t[AES_BLOCK_SIZE * 3];
+    uint8_t M4_t[AES_BLOCK_SIZE] = { 0U };
+    uint8_t u8Ids = (uint8_t)(((pMemUpdate->KeyId << 4U) & 0xF0U) | (pMemUpdate->AuthId & 0x0FU));
+
+    memset(pRecord, 0, sizeof(MemoryUpdateRecord_t));
+    memcpy(pRecord->uid, pMemUpdate->uid, sizeof(pRecord->uid));
+    pRecord->sheGroupId = pMemUpdate->sheGroupId;
+
+    /* K1 = KDF(KAuthID, KEY_UPDATE_ENC_C), K2 = KDF(KAuthID, KEY_UPDATE_MAC_C) */
+    SheMup_Kdf(pMemUpdate->AuthKey, KEY_UPDATE_ENC_C, K1);
+    SheMup_Kdf(pMemUpdate->AuthKey, KEY_UPDATE_MAC_C, K2);
+
+    /* M1 = UID'|ID|AuthID */
+    memcpy(pRecord->M1, pMemUpdate->uid, 15U);
+    pRecord->M1[15] = u8Ids;
+
+    /* M2 = ENC_CBC,K1,IV=0(CID'|FID'|"0...0"95|KID') */
+    memset(M2_t, 0, sizeof(M2_t));
+    M2_t[0] = (uint8_t)((pMemUpdate->count_val >> 20) & 0xFFU);
+    M2_t[1] = (uint8_t)((pMemUpdate->count_val >> 12) & 0xFFU);
+    M2_t[2] = (uint8_t)((pMemUpdate->count_val >> 4) & 0xFFU);
+    M2_t[3] = (uint8_t)(((pMemUpdate->count_val << 4) & 0xF0U) | ((pMemUpdate->flag_val >> 2) & 0x0FU));
+    M2_t[4] = (uint8_t)((pMemUpdate->flag_val << 6) & 0xC0U);
+    memcpy(&M2_t[AES_BLOCK_SIZE], pMemUpdate->KeyNew, AES_BLOCK_SIZE);
+    SheMup_AesEncrypt(K1, M2_t, pRecord->M2);
+    SheMup_Xor(&M2_t[AES_BLOCK_SIZE], pRecord->M2);
+    SheMup_AesEncrypt(K1, &M2_t[AES_BLOCK_SIZE], &pRecord->M2[AES_BLOCK_SIZE]);
+
+    /* M3 = CMAC,K2(M1|M2) */
+    memcpy(M3_t, pRecord->M1, AES_BLOCK_SIZE);
+    memcpy(&M3_t[AES_BLOCK_SIZE], pRecord->M2, AES_BLOCK_SIZE * 2U);
+    SheMup_Cmac(K2, M3_t, sizeof(M3_t), pRecord->M3);
+
+    /* K3 = KDF(KID, KEY_UPDATE_ENC_C), K4 = KDF(KID, KEY_UPDATE_MAC_C) */
+    SheMup_Kdf(pMemUpdate->KeyNew, KEY_UPDATE_ENC_C, K3);
+    SheMup_Kdf(pMemUpdate->KeyNew, KEY_UPDATE_MAC_C, K4);
+
+    /* M4 = UID|ID|AuthID|ENC_ECB,K3(CID|1|"0...0"99) */
+    M4_t[0] = (uint8_t)((pMemUpdate->count_val >> 20) & 0xFFU);
+    M4_t[1] = (uint8_t)((pMemUpdate->count_val >> 12) & 0xFFU);
+    M4_t[2] = (uint8_t)((pMemUpdate->count_val >> 4) & 0xFFU);
+    M4_t[3] = (uint8_t)(((pMemUpdate->count_val << 4) & 0xF0U) | (1U << 3U));
+    memcpy(pRecord->M4, pRecord->M1, AES_BLOCK_SIZE);
+    SheMup_AesEncrypt(K3, M4_t, &pRecord->M4[AES_BLOCK_SIZE]);
+
+    /* M5 = CMAC,K4(M4) */
+    SheMup_Cmac(K4, pRecord->M4, sizeof(pRecord->M4), pRecord->M5);
+
+    /* Derived keys are secrets */
+    memset(K1, 0, sizeof(K1));
+    memset(K2, 0, sizeof(K2));
+    memset(K3, 0, sizeof(K3));
+    memset(K4, 0, sizeof(K4));
+    memset(M2_t, 0, sizeof(M2_t));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
@@ -0,0 +1,106 @@
+/**
+*   @file    she_mup.h
+*
+*   @version 1.0.0
+*   @brief   Host computation of the SHE memory update protocol messages.
+*   @details Computes M1-M5 of a SHE key load from a MemoryUpdate_t (see hse_memory_update_protocol.h)
+*            in software: AES-128, Miyaguchi-Preneel KDF and CMAC, as the target does with
+*            HostKdf/she_cmd_enc_cbc/cmd_generate_mac. Thread safe (no global state).
+*
+*   @addtogroup she_mup_generator
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+#ifndef SHE_MUP_H
+#define SHE_MUP_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           she_mup.h
+*/
+#include "hse_memory_update_protocol.h"
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+* @brief        Encrypt one block with AES-128.
+*
+* @param[in]    pKey            The key (16 bytes).
+* @param[in]    pIn             The plaintext block.
+* @param[out]   pOut            The ciphertext block (can be pIn).
+*
+* @return       NULL
+*/
+void SheMup_AesEncrypt(const uint8_t* pKey, const uint8_t* pIn, uint8_t* pOut);
+
+/**
+* @brief        AES-128 CMAC.
+*
+* @param[in]    pKey            The key (16 bytes).
+* @param[in]    pMsg            The message.
+* @param[in]    u32Length       The message length in bytes.
+* @param[out]   pMac            The MAC (16 bytes).
+*
+* @return       NULL
+*/
+void SheMup_Cmac(const uint8_t* pKey, const uint8_t* pMsg, uint32_t u32Length, uint8_t* pMac);
+
+/**
+* @brief        SHE key derivation: Miyaguchi-Preneel compression of pKey | pConstant.
+*
+* @param[in]    pKey            The key (16 bytes).
+* @param[in]    pConstant       KEY_UPDATE_ENC_C or KEY_UPDATE_MAC_C (16 bytes, padding included).
+* @param[out]   pOut            The derived key (16 bytes).
+*
+* @return       NULL
+*/
+void SheMup_Kdf(const uint8_t* pKey, const uint8_t* pConstant, uint8_t* pOut);
+
+/**
+* @brief        Compute the messages of a SHE key load.
+* @details      M1-M3 are sent to the HSE (cmd_load_key), M4/M5 are the values it must return.
+*
+* @param[in]    pMemUpdate      The key load (same fields as for MemoryUpdateProtocol()).
+* @param[out]   pRecord         The record of the batch file.
+*
+* @return       NULL
+*/
+void SheMup_Generate(const MemoryUpdate_t* pMemUpdate, MemoryUpdateRecord_t* pRecord);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHE_MUP_H */
+
+/** @} */
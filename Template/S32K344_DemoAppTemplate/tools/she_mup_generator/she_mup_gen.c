@@ -0,0 +1,561 @@
+/**
+*   @file    she_mup_gen.c
+*
+*   @version 1.0.0
+*   @brief   Offline generator of SHE key load messages (M1-M5) for a batch of devices.
+*   @details Computes, for every device UID of a CSV file and every key given with -k, the M1-M3
+*            to send and the M4/M5 the HSE must return, and writes them to a batch file
+*            (MemoryUpdateBatchHeader_t + MemoryUpdateRecord_t[]). The target replays its records
+*            with MemoryUpdateReplayBatch() (cmd_load_key), without any KDF/AES/CMAC round trip.
+*
+*            Build (host):  target she_mup_gen of the host CMake build (CMakeLists.txt), or
+*                           gcc -O2 -std=gnu11 -pthread -I../../interface -I../../interface/config
+*                           -I../../interface/inc_common -I../../services/inc
+*                           -o she_mup_gen she_mup_gen.c she_mup.c
+*            Test:          she_mup_gen --selftest   (FIPS-197, RFC 4493 and SHE specification vectors),
+*                           run by ctest as she_mup_selftest
+*            Run:           she_mup_gen [-j threads] -o batch.bin -k <key> [-k <key> ...] devices.csv
+*
+*            <key> = group:keyId:authId:counter:flags:authKey:newKey (numbers in C notation, keys in hex)
+*              - authKey empty: the newKey of the previous -k loading authId in the same group
+*                (e.g. KEY_1 authorized by the MASTER_ECU_KEY provisioned in the same batch);
+*              - newKey empty: taken from the next column of the device line (device-unique keys).
+*            devices.csv: one device per line, "uid[,newKey...]", uid = 15 bytes in hex; empty lines,
+*              lines starting with '#' and a header line are ignored.
+*            The records of a device are written in -k order, which must be the load order.
+*
+*   @addtogroup she_mup_generator
+*   @{
+*/
+/*==================================================================================================
+*
+*   Copyright 2022 NXP.
+*
+*   This software is owned or controlled by NXP and may only be used strictly in accordance with
+*   the applicable license terms. By expressly accepting such terms or by downloading, installing,
+*   activating and/or otherwise using the software, you are agreeing that you have read, and that
+*   you agree to comply with and are bound by, such license terms. If you do not agree to
+*   be bound by the applicable license terms, then you may not retain, install, activate or
+*   otherwise use the software.
+==================================================================================================*/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/**
+* @file           she_mup_gen.c
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "she_mup.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/*
+ * @brief   Key given with -k
+ */
+typedef struct
+{
+    MemoryUpdate_t  params;             /**< @brief    uid and the empty keys are set per device. */
+    int32_t         s32AuthSpec;        /**< @brief    -k providing the authorizing key, or -1. */
+    int32_t         s32KeyColumn;       /**< @brief    CSV column of the new key (1..), or 0. */
+} sheMupSpec_t;
+
+/*
+ * @brief   Device line of the CSV file
+ */
+typedef struct
+{
+    uint8_t     uid[15];
+    uint8_t     (*pKeys)[AES_BLOCK_SIZE];   /**< @brief    CSV keys, one per column. */
+} sheMupDevice_t;
+
+/*
+ * @brief   Work of a thread: devices u32First, u32First + u32Step, ...
+ */
+typedef struct
+{
+    pthread_t   thread;
+    uint32_t    u32First;
+    uint32_t    u32Step;
+} sheMupWorker_t;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+#define SHE_MUP_MAX_SPECS           (32U)
+#define SHE_MUP_MAX_THREADS         (256U)
+#define SHE_MUP_LINE_LENGTH         (4096U)
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+static sheMupSpec_t             sheMupSpecs[SHE_MUP_MAX_SPECS];
+static uint32_t                 u32SheMupNoOfSpecs = 0UL;
+static uint32_t                 u32SheMupNoOfColumns = 0UL;
+static sheMupDevice_t*          pSheMupDevices = NULL;
+static uint32_t                 u32SheMupNoOfDevices = 0UL;
+static MemoryUpdateRecord_t*    pSheMupRecords = NULL;
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+
+static int SheMup_ParseHex(const char* pText, size_t length, uint8_t* pOut, size_t outLength);
+static int SheMup_ParseSpec(char* pText, sheMupSpec_t* pSpec, uint32_t u32Index);
+static int SheMup_ReadDevices(const char* pPath);
+static void* SheMup_Worker(void* pArg);
+static int SheMup_WriteBatch(const char* pPath);
+static int SheMup_Check(const char* pName, const uint8_t* pGot, const char* pExpected);
+static int SheMup_SelfTest(void);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*******************************************************************************
+ * Description   : Parse exactly outLength bytes of hex (optional 0x prefix).
+ ******************************************************************************/
+static int SheMup_ParseHex(const char* pText, size_t length, uint8_t* pOut, size_t outLength)
+{
+    char digits[3] = { 0 };
+    size_t i;
+
+    while((length > 0U) && isspace((unsigned char)*pText))
+    {
+        pText++;
+        length--;
+    }
+    while((length > 0U) && isspace((unsigned char)pText[length - 1U]))
+    {
+        length--;
+    }
+    if((length >= 2U) && ('0' == pText[0]) && ('x' == (pText[1] | 0x20)))
+    {
+        pText += 2;
+        length -= 2U;
+    }
+    if(length != (2U * outLength))
+    {
+        return -1;
+    }
+    for(i = 0U; i < outLength; i++)
+    {
+        if(!isxdigit((unsigned char)pText[2U * i]) || !isxdigit((unsigned char)pText[(2U * i) + 1U]))
+        {
+            return -1;
+        }
+        digits[0] = pText[2U * i];
+        digits[1] = pText[(2U * i) + 1U];
+        pOut[i] = (uint8_t)strtoul(digits, NULL, 16);
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Description   : Parse group:keyId:authId:counter:flags:authKey:newKey.
+ ******************************************************************************/
+static int SheMup_ParseSpec(char* pText, sheMupSpec_t* pSpec, uint32_t u32Index)
+{
+    char* pField[7];
+    uint32_t i;
+    int32_t j;
+
+    for(i = 0UL; i < 7UL; i++)
+    {
+        pField[i] = pText;
+        pText = strchr(pText, ':');
+        if(((i < 6UL) && (NULL == pText)) || ((6UL == i) && (NULL != pText)))
+        {
+            return -1;
+        }
+        if(NULL != pText)
+        {
+            *pText++ = '\0';
+        }
+    }
+
+    memset(pSpec, 0, sizeof(*pSpec));
+    pSpec->params.sheGroupId = (uint8_t)strtoul(pField[0], NULL, 0);
+    pSpec->params.KeyId      = (uint8_t)strtoul(pField[1], NULL, 0);
+    pSpec->params.AuthId     = (uint8_t)strtoul(pField[2], NULL, 0);
+    pSpec->params.count_val  = (uint32_t)strtoul(pField[3], NULL, 0);
+    pSpec->params.flag_val   = (uint8_t)strtoul(pField[4], NULL, 0);
+    pSpec->s32AuthSpec       = -1;
+    if((pSpec->params.KeyId > 0x0FU) || (pSpec->params.AuthId > 0x0FU) ||
+       (pSpec->params.count_val > 0x0FFFFFFFUL) || (pSpec->params.flag_val > 0x3FU))
+    {
+        return -1;
+    }
+
+    if('\0' == *pField[5])
+    {
+        /* Authorizing key loaded earlier in the batch */
+        for(j = (int32_t)u32Index - 1; (j >= 0) && (pSpec->s32AuthSpec < 0); j--)
+        {
+            if((sheMupSpecs[j].params.sheGroupId == pSpec->params.sheGroupId) &&
+               (sheMupSpecs[j].params.KeyId == pSpec->params.AuthId))
+            {
+                pSpec->s32AuthSpec = j;
+            }
+        }
+        if(pSpec->s32AuthSpec < 0)
+        {
+            return -1;
+        }
+    }
+    else if(0 != SheMup_ParseHex(pField[5], strlen(pField[5]), pSpec->params.AuthKey, AES_BLOCK_SIZE))
+    {
+        return -1;
+    }
+
+    if('\0' == *pField[6])
+    {
+        pSpec->s32KeyColumn = (int32_t)++u32SheMupNoOfColumns;
+    }
+    else if(0 != SheMup_ParseHex(pField[6], strlen(pField[6]), pSpec->params.KeyNew, AES_BLOCK_SIZE))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Description   : Read the device UIDs (and device keys) of the CSV file.
+ ******************************************************************************/
+static int SheMup_ReadDevices(const char* pPath)
+{
+    FILE* pFile = fopen(pPath, "r");
+    char line[SHE_MUP_LINE_LENGTH];
+    uint32_t u32Capacity = 0UL;
+    uint32_t u32Line = 0UL;
+    sheMupDevice_t* pDevice;
+    char* pField;
+    char* pNext;
+    size_t length;
+    uint32_t i;
+
+    if(NULL == pFile)
+    {
+        perror(pPath);
+        return -1;
+    }
+    while(NULL != fgets(line, sizeof(line), pFile))
+    {
+        u32Line++;
+        pField = line;
+        while(isspace((unsigned char)*pField))
+        {
+            pField++;
+        }
+        if(('\0' == *pField) || ('#' == *pField))
+        {
+            continue;
+        }
+
+        if(u32SheMupNoOfDevices == u32Capacity)
+        {
+            u32Capacity = (0UL == u32Capacity) ? 1024UL : (2UL * u32Capacity);
+            pSheMupDevices = (sheMupDevice_t*)realloc(pSheMupDevices, u32Capacity * sizeof(sheMupDevice_t));
+            if(NULL == pSheMupDevices)
+            {
+                fclose(pFile);
+                return -1;
+            }
+        }
+        pDevice = &pSheMupDevices[u32SheMupNoOfDevices];
+        pDevice->pKeys = NULL;
+
+        pNext  = strchr(pField, ',');
+        length = (NULL != pNext) ? (size_t)(pNext - pField) : strlen(pField);
+        if(0 != SheMup_ParseHex(pField, length, pDevice->uid, sizeof(pDevice->uid)))
+        {
+            if((0UL == u32SheMupNoOfDevices) && (1UL == u32Line))
+            {
+                /* Header line */
+                continue;
+            }
+            fprintf(stderr, "%s:%u: invalid UID\n", pPath, u32Line);
+            fclose(pFile);
+            return -1;
+        }
+
+        if(0UL != u32SheMupNoOfColumns)
+        {
+            pDevice->pKeys = calloc(u32SheMupNoOfColumns, AES_BLOCK_SIZE);
+            for(i = 0UL; (i < u32SheMupNoOfColumns) && (NULL != pDevice->pKeys); i++)
+            {
+                pField = (NULL != pNext) ? (pNext + 1) : NULL;
+                pNext  = (NULL != pField) ? strchr(pField, ',') : NULL;
+                length = (NULL != pNext) ? (size_t)(pNext - pField) : ((NULL != pField) ? strlen(pField) : 0U);
+                if((NULL == pField) || (0 != SheMup_ParseHex(pField, length, pDevice->pKeys[i], AES_BLOCK_SIZE)))
+                {
+                    fprintf(stderr, "%s:%u: invalid key in column %u\n", pPath, u32Line, i + 2U);
+                    free(pDevice->pKeys);
+                    fclose(pFile);
+                    return -1;
+                }
+            }
+            if(NULL == pDevice->pKeys)
+            {
+                fclose(pFile);
+                return -1;
+            }
+        }
+        u32SheMupNoOfDevices++;
+    }
+    fclose(pFile);
+    return 0;
+}
+
+/*******************************************************************************
+ * Description   : Compute the records of the devices of a thread.
+ ******************************************************************************/
+static void* SheMup_Worker(void* pArg)
+{
+    const sheMupWorker_t* pWorker = (const sheMupWorker_t*)pArg;
+    const sheMupDevice_t* pDevice;
+    MemoryUpdate_t params[SHE_MUP_MAX_SPECS];
+    uint32_t d;
+    uint32_t s;
+
+    for(d = pWorker->u32First; d < u32SheMupNoOfDevices; d += pWorker->u32Step)
+    {
+        pDevice = &pSheMupDevices[d];
+        for(s = 0UL; s < u32SheMupNoOfSpecs; s++)
+        {
+            params[s] = sheMupSpecs[s].params;
+            memcpy(params[s].uid, pDevice->uid, sizeof(params[s].uid));
+            if(0 != sheMupSpecs[s].s32KeyColumn)
+            {
+                memcpy(params[s].KeyNew, pDevice->pKeys[sheMupSpecs[s].s32KeyColumn - 1], AES_BLOCK_SIZE);
+            }
+            if(sheMupSpecs[s].s32AuthSpec >= 0)
+            {
+                memcpy(params[s].AuthKey, params[sheMupSpecs[s].s32AuthSpec].KeyNew, AES_BLOCK_SIZE);
+            }
+            SheMup_Generate(&params[s], &pSheMupRecords[(d * u32SheMupNoOfSpecs) + s]);
+        }
+    }
+    memset(params, 0, sizeof(params));
+    return NULL;
+}
+
+/*******************************************************************************
+ * Description   : Write the batch file (little-endian header, then the records).
+ ******************************************************************************/
+static int SheMup_WriteBatch(const char* pPath)
+{
+    uint32_t u32Count = u32SheMupNoOfDevices * u32SheMupNoOfSpecs;
+    uint8_t header[sizeof(MemoryUpdateBatchHeader_t)] = { 0U };
+    FILE* pFile = fopen(pPath, "wb");
+    int result = 0;
+
+    if(NULL == pFile)
+    {
+        perror(pPath);
+        return -1;
+    }
+    header[0]  = (uint8_t)(MEMORY_UPDATE_BATCH_MAGIC);
+    header[1]  = (uint8_t)(MEMORY_UPDATE_BATCH_MAGIC >> 8);
+    header[2]  = (uint8_t)(MEMORY_UPDATE_BATCH_MAGIC >> 16);
+    header[3]  = (uint8_t)(MEMORY_UPDATE_BATCH_MAGIC >> 24);
+    header[4]  = (uint8_t)(MEMORY_UPDATE_BATCH_VERSION);
+    header[6]  = (uint8_t)(sizeof(MemoryUpdateRecord_t));
+    header[7]  = (uint8_t)(sizeof(MemoryUpdateRecord_t) >> 8);
+    header[8]  = (uint8_t)(u32Count);
+    header[9]  = (uint8_t)(u32Count >> 8);
+    header[10] = (uint8_t)(u32Count >> 16);
+    header[11] = (uint8_t)(u32Count >> 24);
+
+    if((1U != fwrite(header, sizeof(header), 1U, pFile)) ||
+       (u32Count != fwrite(pSheMupRecords, sizeof(MemoryUpdateRecord_t), u32Count, pFile)))
+    {
+        perror(pPath);
+        result = -1;
+    }
+    if(0 != fclose(pFile))
+    {
+        result = -1;
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * Description   : Compare with the expected value (hex), print the result.
+ ******************************************************************************/
+static int SheMup_Check(const char* pName, const uint8_t* pGot, const char* pExpected)
+{
+    uint8_t expected[64];
+    size_t length = strlen(pExpected) / 2U;
+    int ok = (0 == SheMup_ParseHex(pExpected, strlen(pExpected), expected, length)) &&
+             (0 == memcmp(pGot, expected, length));
+
+    printf("%-28s %s\n", pName, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/*******************************************************************************
+ * Description   : Known answer tests.
+ ******************************************************************************/
+static int SheMup_SelfTest(void)
+{
+    static const uint8_t fipsKey[AES_BLOCK_SIZE] =
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+    static const uint8_t fipsPlain[AES_BLOCK_SIZE] =
+    { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
+    static const uint8_t rfcKey[AES_BLOCK_SIZE] =
+    { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+    static const uint8_t rfcMsg[AES_BLOCK_SIZE] =
+    { 0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A };
+    MemoryUpdate_t memUpdate;
+    MemoryUpdateRecord_t record;
+    uint8_t out[AES_BLOCK_SIZE];
+    int failed = 0;
+    uint32_t i;
+
+    /* FIPS-197 appendix C.1 */
+    SheMup_AesEncrypt(fipsKey, fipsPlain, out);
+    failed += SheMup_Check("AES-128 (FIPS-197)", out, "69c4e0d86a7b0430d8cdb78070b4c55a");
+
+    /* RFC 4493 examples 1 and 2 */
+    SheMup_Cmac(rfcKey, NULL, 0UL, out);
+    failed += SheMup_Check("CMAC empty (RFC 4493)", out, "bb1d6929e95937287fa37d129b756746");
+    SheMup_Cmac(rfcKey, rfcMsg, sizeof(rfcMsg), out);
+    failed += SheMup_Check("CMAC 16 bytes (RFC 4493)", out, "070a16b46b4d4144f79bdd9dd04a287c");
+
+    /* SHE specification: KEY_1 authorized by MASTER_ECU_KEY */
+    memset(&memUpdate, 0, sizeof(memUpdate));
+    memUpdate.uid[14]   = 0x01U;
+    memUpdate.KeyId     = 0x04U;
+    memUpdate.AuthId    = 0x01U;
+    memUpdate.count_val = 1UL;
+    memUpdate.flag_val  = 0U;
+    for(i = 0UL; i < AES_BLOCK_SIZE; i++)
+    {
+        memUpdate.AuthKey[i] = (uint8_t)i;
+        memUpdate.KeyNew[i]  = (uint8_t)(0x0FUL - i);
+    }
+    SheMup_Generate(&memUpdate, &record);
+    failed += SheMup_Check("SHE M1", record.M1, "00000000000000000000000000000141");
+    failed += SheMup_Check("SHE M2", record.M2, "2b111e2d93f486566bcbba1d7f7a9797c94643b050fc5d4d7de14cff682203c3");
+    failed += SheMup_Check("SHE M3", record.M3, "b9d745e5ace7d41860bc63c2b9f5bb46");
+    failed += SheMup_Check("SHE M4", record.M4, "00000000000000000000000000000141b472e8d8727d70d57295e74849a27917");
+    failed += SheMup_Check("SHE M5", record.M5, "820d8d95dc11b4668878160cb2a4e23e");
+
+    return (0 == failed) ? 0 : 1;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+int main(int argc, char* argv[])
+{
+    static sheMupWorker_t workers[SHE_MUP_MAX_THREADS];
+    const char* pOutput = NULL;
+    long s32Threads = sysconf(_SC_NPROCESSORS_ONLN);
+    struct timespec start;
+    struct timespec end;
+    int opt;
+    uint32_t i;
+
+    if((2 == argc) && (0 == strcmp(argv[1], "--selftest")))
+    {
+        return SheMup_SelfTest();
+    }
+
+    while(-1 != (opt = getopt(argc, argv, "j:o:k:")))
+    {
+        switch(opt)
+        {
+        case 'j':
+            s32Threads = strtol(optarg, NULL, 0);
+            break;
+        case 'o':
+            pOutput = optarg;
+            break;
+        case 'k':
+            if((u32SheMupNoOfSpecs == SHE_MUP_MAX_SPECS) ||
+               (0 != SheMup_ParseSpec(optarg, &sheMupSpecs[u32SheMupNoOfSpecs], u32SheMupNoOfSpecs)))
+            {
+                fprintf(stderr, "invalid key #%u\n", u32SheMupNoOfSpecs + 1U);
+                return 2;
+            }
+            u32SheMupNoOfSpecs++;
+            break;
+        default:
+            return 2;
+        }
+    }
+    if((NULL == pOutput) || (0UL == u32SheMupNoOfSpecs) || ((optind + 1) != argc))
+    {
+        fprintf(stderr, "usage: %s [-j threads] -o batch.bin -k group:keyId:authId:counter:flags:authKey:newKey"
+                        " [-k ...] devices.csv\n       %s --selftest\n", argv[0], argv[0]);
+        return 2;
+    }
+    if(0 != SheMup_ReadDevices(argv[optind]))
+    {
+        return 1;
+    }
+
+    pSheMupRecords = (MemoryUpdateRecord_t*)calloc((size_t)u32SheMupNoOfDevices * u32SheMupNoOfSpecs,
+                                                   sizeof(MemoryUpdateRecord_t));
+    if((NULL == pSheMupRecords) && (0UL != u32SheMupNoOfDevices))
+    {
+        return 1;
+    }
+    s32Threads = (s32Threads < 1) ? 1 : ((s32Threads > (long)SHE_MUP_MAX_THREADS) ? (long)SHE_MUP_MAX_THREADS : s32Threads);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0UL; i < (uint32_t)s32Threads; i++)
+    {
+        workers[i].u32First = i;
+        workers[i].u32Step  = (uint32_t)s32Threads;
+        if(0 != pthread_create(&workers[i].thread, NULL, SheMup_Worker, &workers[i]))
+        {
+            return 1;
+        }
+    }
+    for(i = 0UL; i < (uint32_t)s32Threads; i++)
+    {
+        (void)pthread_join(workers[i].thread, NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if(0 != SheMup_WriteBatch(pOutput))
+    {
+        return 1;
+    }
+    printf("%u devices, %u records, %ld threads, %.3f ms\n", u32SheMupNoOfDevices,
+           u32SheMupNoOfDevices * u32SheMupNoOfSpecs, s32Threads,
+           ((double)(end.tv_sec - start.tv_sec) * 1e3) + ((double)(end.tv_nsec - start.tv_nsec) / 1e6));
+
+    /* Keys are secrets */
+    memset(sheMupSpecs, 0, sizeof(sheMupSpecs));
+    for(i = 0UL; i < u32SheMupNoOfDevices; i++)
+    {
+        if(NULL != pSheMupDevices[i].pKeys)
+        {
+            memset(pSheMupDevices[i].pKeys, 0, (size_t)u32SheMupNoOfColumns * AES_BLOCK_SIZE);
+            free(pSheMupDevices[i].pKeys);
+        }
+    }
+    free(pSheMupDevices);
+    free(pSheMupRecords);
+    return 0;
+}
+
+/** @} */